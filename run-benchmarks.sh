@@ -0,0 +1,95 @@
+#!/bin/bash
+#
+# Run the benchmark suites and collect their results
+#
+# This script runs the benchmark suites, kept out of the regular test runs by
+# their slow tag, and collects the BENCH result line of every benchmark case
+# into a JSON Lines file, tagged with the platform it ran on. Given a baseline
+# result file, the mean time of every case is compared against it.
+#
+# Usage:
+#   ./run-benchmarks.sh [baseline.jsonl] [test-path]
+#
+# Examples:
+#   ./run-benchmarks.sh                                        # Run all benchmarks
+#   ./run-benchmarks.sh baseline.jsonl                         # Compare against a baseline
+#   ./run-benchmarks.sh "" tests/benchmarks/datastore          # Run specific benchmark directory
+#
+
+set -e
+
+# Change to the embedded-services directory (script is at repo root)
+PROJECT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+cd "$PROJECT_DIR"
+
+BASELINE="${1:-}"
+TEST_PATH="${2:-tests/benchmarks}"
+OUT_DIR="twister-out"
+RESULTS="$OUT_DIR/benchmarks.jsonl"
+
+echo "=== Running Benchmarks ==="
+echo "Test path: $TEST_PATH"
+echo ""
+
+# Clean previous results
+rm -rf twister-out twister-out.*
+
+# Run the benchmarks, slow suites included
+west twister -T "$TEST_PATH" --enable-slow -v
+
+echo ""
+echo "=== Collecting Results ==="
+
+# Every handler log lives under <out>/<platform>/..., the platform tags its lines
+: > "$RESULTS"
+find "$OUT_DIR" -name handler.log | sort | while read -r LOG; do
+    PLATFORM="$(echo "${LOG#$OUT_DIR/}" | cut -d/ -f1)"
+    grep -o 'BENCH {.*}' "$LOG" | sed "s/^BENCH {/{\"platform\":\"$PLATFORM\",/" >> "$RESULTS" || true
+done
+
+echo "Benchmark cases: $(wc -l < "$RESULTS")"
+echo "Results (JSONL): $RESULTS"
+
+if [ -z "$BASELINE" ]; then
+    exit 0
+fi
+
+if [ ! -f "$BASELINE" ]; then
+    echo "Error: baseline $BASELINE not found"
+    exit 1
+fi
+
+echo ""
+echo "=== Comparison Against $BASELINE ==="
+
+# Cases are matched on every field except the measurements
+python3 - "$BASELINE" "$RESULTS" <<'PYEOF'
+import json
+import sys
+
+MEASURES = {"samples", "ops", "min_ns", "mean_ns", "max_ns", "ops_per_s"}
+
+def load(path):
+    cases = {}
+    with open(path) as f:
+        for line in f:
+            if line.strip():
+                entry = json.loads(line)
+                key = tuple(sorted((k, str(v)) for k, v in entry.items() if k not in MEASURES))
+                cases[key] = entry
+    return cases
+
+baseline = load(sys.argv[1])
+current = load(sys.argv[2])
+
+for key in sorted(current):
+    fields = dict(key)
+    name = f"{fields.pop('suite')}.{fields.pop('case')} " + " ".join(f"{k}={v}" for k, v in fields.items())
+    if key not in baseline:
+        print(f"{name}: {current[key]['mean_ns']} ns (new)")
+        continue
+    base = baseline[key]["mean_ns"]
+    mean = current[key]["mean_ns"]
+    delta = (mean - base) * 100.0 / base if base else 0.0
+    print(f"{name}: {base} -> {mean} ns ({delta:+.1f}%)")
+PYEOF
@@ -16,6 +16,8 @@
 
 #include "adcAcquisition.h"
 #include "adcAcquisitionFilter.h"
+#include "adcAcquisitionCapture.h"
+#include "adcAcquisitionWindow.h"
 #include "adcAcquisitionUtil.h"
 #include "serviceCommon.h"
 #include "serviceManager.h"
@@ -44,6 +46,11 @@ K_MSGQ_DEFINE(adcAcqCtrlQueue, sizeof(ServiceCtrlMsg_t), 4, 4);
  */
 static struct k_thread thread;
 
+/**
+ * @brief   The service manager handle of the ADC service.
+ */
+static ServiceHandle_t serviceHandle;
+
 /**
  * @brief   The ADC acquisition thread.
  *
@@ -55,11 +62,17 @@ void run(void *p1, void *p2, void *p3)
 {
   int err;
   uint32_t notificationRate = (uint32_t)(uintptr_t)p1;
+  uint32_t voltMask;
+  uint32_t milliVoltMask;
   ServiceCtrlMsg_t ctrlMsg;
 
   LOG_INF("ADC acquisition thread started, notification rate: %d ms",
           notificationRate);
 
+  err = serviceManagerConfirmState(serviceHandle, SVC_STATE_RUNNING);
+  if (err < 0)
+    LOG_ERR("ERROR %d: unable to confirm service state", err);
+
 #ifdef CONFIG_ZTEST
   for (size_t i = 0; i < ADC_ACQ_RUN_ITERATIONS; ++i)
 #else
@@ -72,13 +85,13 @@ void run(void *p1, void *p2, void *p3)
         err = adcAcqUtilStopTrigger();
         if (err < 0)
           LOG_ERR("ERROR %d: unable to stop ADC trigger", err);
-        serviceManagerConfirmState(k_current_get(), SVC_STATE_STOPPED);
+        serviceManagerConfirmState(serviceHandle, SVC_STATE_STOPPED);
         return;
       case SVC_CTRL_SUSPEND:
         err = adcAcqUtilStopTrigger();
         if (err < 0)
           LOG_ERR("ERROR %d: unable to stop ADC trigger", err);
-        serviceManagerConfirmState(k_current_get(), SVC_STATE_SUSPENDED);
+        serviceManagerConfirmState(serviceHandle, SVC_STATE_SUSPENDED);
         k_thread_suspend(k_current_get());
         break;
       default:
@@ -87,7 +100,11 @@ void run(void *p1, void *p2, void *p3)
       }
     }
 
-    err = adcAcqUtilProcessData();
+    /* Only convert the channels of the subscribers due now */
+    voltMask = adcAcqUtilGetDueChanMask(ADC_ACQ_FORMAT_VOLT);
+    milliVoltMask = adcAcqUtilGetDueChanMask(ADC_ACQ_FORMAT_MILLIVOLT);
+
+    err = adcAcqUtilProcessData(voltMask, milliVoltMask);
     if (err < 0)
       LOG_ERR("ERROR %d: unable to process ADC data", err);
 
@@ -95,7 +112,7 @@ void run(void *p1, void *p2, void *p3)
     if (err < 0)
       LOG_ERR("ERROR %d: unable to notify ADC subscribers", err);
 
-    serviceManagerUpdateHeartbeat(k_current_get());
+    serviceManagerUpdateHeartbeat(serviceHandle);
   }
 }
 
@@ -169,13 +186,65 @@ static int onResume(void)
   return err;
 }
 
-int adcAcqInit(void)
+/**
+ * @brief   Create the ADC thread, started by the service manager.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int createThread(void)
 {
   int err;
   k_tid_t threadId;
+
+  threadId = k_thread_create(
+      &thread, adcStack, CONFIG_ENYA_ADC_ACQUISITION_STACK_SIZE, run,
+      (void *)(uintptr_t)CONFIG_ENYA_ADC_ACQUISITION_NOTIFICATION_RATE_MS, NULL,
+      NULL, K_PRIO_PREEMPT(CONFIG_ENYA_ADC_ACQUISITION_THREAD_PRIORITY), 0,
+      K_FOREVER);
+
+  err = k_thread_name_set(threadId, STRINGIFY(ADC_AQC_SERVICE_NAME));
+  if (err < 0)
+    LOG_ERR("ERROR %d: unable to set ADC acquisition thread name", err);
+
+  return err;
+}
+
+/**
+ * @brief   Restart callback: re-creates the ADC thread after missed heartbeats.
+ *
+ * @note    The trigger keeps converting into the filters, the subscriptions
+ *          being kept. The new thread has the same ID, the registry entry
+ *          staying valid.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int onRestart(void)
+{
+  int err;
+
+  k_thread_abort(&thread);
+
+  err = createThread();
+  if (err < 0)
+    return err;
+
+  k_thread_start(&thread);
+
+  return 0;
+}
+
+BUILD_ASSERT(CONFIG_ENYA_ADC_ACQUISITION_SERVICE_PRIORITY != SVC_PRIORITY_CRITICAL ||
+                 CONFIG_ENYA_ADC_ACQUISITION_MAX_RESTARTS == 0,
+             "a critical ADC acquisition service keeps the SoC reset recovery");
+
+int adcAcqInit(void)
+{
+  int err;
   AdcConfig_t adcConfig = {
       .samplingRate = CONFIG_ENYA_ADC_ACQUISITION_SAMPLING_RATE_US,
       .filterTau = CONFIG_ENYA_ADC_ACQUISITION_FILTER_TAU,
+      .filterOrder = CONFIG_ENYA_ADC_ACQUISITION_FILTER_ORDER,
+      .blockScanCount = CONFIG_ENYA_ADC_ACQUISITION_BLOCK_SCAN_COUNT,
   };
   AdcSubConfig_t adcSubConfig = {
       .maxSubCount = CONFIG_ENYA_ADC_ACQUISITION_MAX_SUB_COUNT,
@@ -189,6 +258,8 @@ int adcAcqInit(void)
       .stop = onStop,
       .suspend = onSuspend,
       .resume = onResume,
+      .restart = onRestart,
+      .maxRestarts = CONFIG_ENYA_ADC_ACQUISITION_MAX_RESTARTS,
   };
 
   err = adcAcqUtilInitAdc(&adcConfig);
@@ -203,21 +274,34 @@ int adcAcqInit(void)
   if (err < 0)
     return err;
 
-  threadId = k_thread_create(
-      &thread, adcStack, CONFIG_ENYA_ADC_ACQUISITION_STACK_SIZE, run,
-      (void *)(uintptr_t)CONFIG_ENYA_ADC_ACQUISITION_NOTIFICATION_RATE_MS, NULL,
-      NULL, K_PRIO_PREEMPT(CONFIG_ENYA_ADC_ACQUISITION_THREAD_PRIORITY), 0,
-      K_FOREVER);
-
-  err = k_thread_name_set(threadId, STRINGIFY(ADC_AQC_SERVICE_NAME));
-  if (err < 0) {
-    LOG_ERR("ERROR %d: unable to set ADC acquisition thread name", err);
+  err = adcAcqUtilConfigFilter();
+  if (err < 0)
     return err;
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_CAPTURE
+  /* The capture records whole scans, of a single controller sequence */
+  if (adcAcqUtilGetGroupCount() > 1) {
+    LOG_WRN("raw capture unavailable with multiple ADC controllers");
+  } else {
+    err = adcAcqCaptureInit(adcAcqUtilGetChanCount());
+    if (err < 0)
+      return err;
   }
+#endif
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_WINDOW
+  err = adcAcqWindowInit(adcAcqUtilGetChanCount());
+  if (err < 0)
+    return err;
+#endif
+
+  err = createThread();
+  if (err < 0)
+    return err;
 
-  descriptor.threadId = threadId;
+  descriptor.threadId = &thread;
 
-  err = serviceManagerRegisterSrv(&descriptor);
+  err = serviceManagerRegisterSrv(&descriptor, &serviceHandle);
   if (err < 0)
     LOG_ERR("ERROR %d: unable to register ADC acquisition service", err);
 
@@ -226,7 +310,20 @@ int adcAcqInit(void)
 
 int adcAcqSubscribe(AdcSubCallback_t callback)
 {
-  return adcAcqUtilAddSubscription(callback);
+  return adcAcqUtilAddSubscription(callback, NULL);
+}
+
+int adcAcqSubscribeWithOptions(AdcSubCallback_t callback, const AdcSubOptions_t *options)
+{
+  int err;
+
+  if (!options) {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid subscription options", err);
+    return err;
+  }
+
+  return adcAcqUtilAddSubscription(callback, options);
 }
 
 int adcAcqUnsubscribe(AdcSubCallback_t callback)
@@ -234,6 +331,11 @@ int adcAcqUnsubscribe(AdcSubCallback_t callback)
   return adcAcqUtilRemoveSubscription(callback);
 }
 
+void adcAcqReleaseData(SrvMsgPayload_t *data)
+{
+  adcAcqUtilReleaseData(data);
+}
+
 int adcAcqPauseSubscription(AdcSubCallback_t callback)
 {
   return adcAcqUtilSetSubPauseState(callback, true);
@@ -244,4 +346,46 @@ int adcAcqUnpauseSubscription(AdcSubCallback_t callback)
   return adcAcqUtilSetSubPauseState(callback, false);
 }
 
+int adcAcqGetStats(AdcAcqStats_t *stats)
+{
+  return adcAcqUtilGetStats(stats);
+}
+
+void adcAcqResetStats(void)
+{
+  adcAcqUtilResetStats();
+}
+
+int adcAcqSetWindow(size_t chanId, const AdcWindow_t *window)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_WINDOW
+  return adcAcqWindowSet(chanId, window);
+#else
+  ARG_UNUSED(chanId);
+  ARG_UNUSED(window);
+  return -ENOTSUP;
+#endif
+}
+
+int adcAcqClearWindow(size_t chanId)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_WINDOW
+  return adcAcqWindowClear(chanId);
+#else
+  ARG_UNUSED(chanId);
+  return -ENOTSUP;
+#endif
+}
+
+int adcAcqGetWindowZone(size_t chanId, AdcWindowZone_t *zone)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_WINDOW
+  return adcAcqWindowGetZone(chanId, zone);
+#else
+  ARG_UNUSED(chanId);
+  ARG_UNUSED(zone);
+  return -ENOTSUP;
+#endif
+}
+
 /** @} */
@@ -21,13 +21,14 @@
 #include <zephyr/portability/cmsis_os2.h>
 
 #include "serviceCommon.h"
+#include "adcAcquisitionWindow.h"
 
 /**
  * @brief   The ADC subscription callback type.
  *
  *          Called with @p data pointing to the ADC data buffer (must be freed
- *          by the subscriber). The buffer contains float values (cast to
- *          float*).
+ *          by the subscriber). The buffer contains the float values (cast to
+ *          float*) of the subscribed channels, in channel order.
  *
  * @return  0 if successful, the error code otherwise.
  */
@@ -40,7 +41,8 @@ typedef int (*AdcSubCallback_t)(SrvMsgPayload_t *data);
  *          property. The trigger timer is obtained from the adc-trigger
  *          devicetree alias. The sampling rate is in microseconds and will be
  *          used to set the timer period. The timer will trigger the ADC
- *          conversion.
+ *          conversion of a block of blockScanCount scans, the scans being
+ *          paced by the ADC driver at the sampling rate.
  *
  *          Filter Description:
  *          The filter is a 3rd-order cascaded RC low-pass filter implemented in
@@ -65,13 +67,47 @@ typedef int (*AdcSubCallback_t)(SrvMsgPayload_t *data);
  *
  *          Note: Each RC stage has cutoff fc_1st, but cascading three stages
  *          results in: fc_3rd = fc_1st × 0.5098
+ *
+ *          The filter tau and order are the defaults of the channels missing
+ *          from the devicetree filter-taus and filter-orders properties.
  */
 typedef struct
 {
-  uint32_t samplingRate; /**< The ADC sampling rate [usec]. */
-  int32_t filterTau;     /**< The ADC filter tau value (1-511). */
+  uint32_t samplingRate;   /**< The ADC sampling rate [usec]. */
+  int32_t filterTau;       /**< The default ADC filter tau value (1-511). */
+  uint32_t filterOrder;    /**< The default ADC filter order (0-3). */
+  uint32_t blockScanCount; /**< The scan count acquired per trigger. */
 } AdcConfig_t;
 
+/**
+ * @brief   The channel mask subscribing to all the channels.
+ */
+#define ADC_ACQ_ALL_CHANNELS                                    (UINT32_MAX)
+
+/**
+ * @brief   The ADC subscription data formats.
+ */
+typedef enum
+{
+  ADC_ACQ_FORMAT_VOLT = 0,  /**< float values [V]. */
+  ADC_ACQ_FORMAT_MILLIVOLT, /**< int32_t values [mV], converted in fixed-point. */
+  ADC_ACQ_FORMAT_COUNT,
+} AdcDataFormat_t;
+
+/**
+ * @brief   The ADC subscription options structure.
+ *
+ *          The output period is rounded up to a multiple of the notification
+ *          rate, the filter output of the subscribed channels being sampled at
+ *          that period. Only the first 32 channels can be subscribed.
+ */
+typedef struct
+{
+  uint32_t chanMask;      /**< The subscribed channel mask (bit n for channel n). */
+  uint32_t periodMs;      /**< The output period [msec], 0 for each notification. */
+  AdcDataFormat_t format; /**< The payload data format. */
+} AdcSubOptions_t;
+
 /**
  * @brief   The ADC subscriptions configuration structure.
  */
@@ -82,6 +118,30 @@ typedef struct
   uint32_t notificationRate; /**< The subscription notification rate [msec]. */
 } AdcSubConfig_t;
 
+/**
+ * @brief   The ADC acquisition statistics.
+ *
+ *          The counters are updated from the trigger timer and ADC interrupts.
+ *          The timings are measured with the cycle counter from the trigger
+ *          timer interrupt and are only gathered with
+ *          CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING, they stay 0 otherwise.
+ *          The latency runs until the first scan callback and the conversion
+ *          time until the last one, both match for single scan blocks.
+ */
+typedef struct
+{
+  int64_t elapsedMs;         /**< The time since the last reset [ms]. */
+  uint32_t triggerCount;     /**< The trigger timer interrupt count. */
+  uint32_t overrunCount;     /**< The triggers skipped, the previous block still converting. */
+  uint32_t startErrorCount;  /**< The conversions failing to start. */
+  uint32_t filterErrorCount; /**< The blocks rejected by the filter. */
+  uint32_t blockCount;       /**< The timed block count. */
+  uint32_t convTimeMinUs;    /**< The shortest block conversion time [us]. */
+  uint32_t convTimeMaxUs;    /**< The longest block conversion time [us]. */
+  uint32_t latencyMinUs;     /**< The shortest trigger to callback latency [us]. */
+  uint32_t latencyMaxUs;     /**< The longest trigger to callback latency [us]. */
+} AdcAcqStats_t;
+
 /**
  * @brief   Initialize the ADC acquisition service.
  *
@@ -96,12 +156,26 @@ int adcAcqInit(void);
 /**
  * @brief   Subscribe to the ADC service.
  *
+ * @note    The subscription receives all the channels at each notification.
+ *
  * @param[in]   callback: The subscription callback.
  *
  * @return  0 if successful, -ENOSPC if the maximum subscription count is reached.
  */
 int adcAcqSubscribe(AdcSubCallback_t callback);
 
+/**
+ * @brief   Subscribe to the ADC service with options.
+ *
+ * @param[in]   callback: The subscription callback.
+ * @param[in]   options: The subscription channel mask and output period.
+ *
+ * @return  0 if successful, -ENOSPC if the maximum subscription count is reached,
+ *          -EINVAL if options is NULL, its channel mask holds no valid channel
+ *          or its format is unknown.
+ */
+int adcAcqSubscribeWithOptions(AdcSubCallback_t callback, const AdcSubOptions_t *options);
+
 /**
  * @brief   Unsubscribe from the ADC service.
  *
@@ -111,6 +185,19 @@ int adcAcqSubscribe(AdcSubCallback_t callback);
  */
 int adcAcqUnsubscribe(AdcSubCallback_t callback);
 
+/**
+ * @brief   Release the payload received by a subscription callback.
+ *
+ * @note    With CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD, the payload is
+ *          shared between the subscribers of the same channels and must be
+ *          treated as read-only. It is freed once every subscriber released
+ *          it. This function works in both modes and can be called from
+ *          any thread.
+ *
+ * @param[in]   data: The subscription payload.
+ */
+void adcAcqReleaseData(SrvMsgPayload_t *data);
+
 /**
  * @brief   Pause a subscription.
  *
@@ -129,6 +216,59 @@ int adcAcqPauseSubscription(AdcSubCallback_t callback);
  */
 int adcAcqUnpauseSubscription(AdcSubCallback_t callback);
 
+/**
+ * @brief   Get the ADC acquisition statistics.
+ *
+ * @note    The counters are gathered since the last reset, or the init.
+ *
+ * @param[out]  stats: The ADC acquisition statistics.
+ *
+ * @return  0 if successful, -EINVAL if stats is NULL.
+ */
+int adcAcqGetStats(AdcAcqStats_t *stats);
+
+/**
+ * @brief   Reset the ADC acquisition statistics.
+ */
+void adcAcqResetStats(void);
+
+/**
+ * @brief   Set the window comparator of a channel.
+ *
+ * @note    The window is compared to the filtered data after each block, its
+ *          callback firing from the ADC interrupt context on each zone change.
+ *          Requires CONFIG_ENYA_ADC_ACQUISITION_WINDOW.
+ *
+ * @param[in]   chanId: The channel ID.
+ * @param[in]   window: The window thresholds, hysteresis and callback.
+ *
+ * @return  0 if successful, -ENOTSUP if the window comparator is disabled,
+ *          -EINVAL if chanId is out of range or the window is invalid.
+ */
+int adcAcqSetWindow(size_t chanId, const AdcWindow_t *window);
+
+/**
+ * @brief   Clear the window comparator of a channel.
+ *
+ * @param[in]   chanId: The channel ID.
+ *
+ * @return  0 if successful, -ENOTSUP if the window comparator is disabled,
+ *          -EINVAL if chanId is out of range.
+ */
+int adcAcqClearWindow(size_t chanId);
+
+/**
+ * @brief   Get the window zone of a channel.
+ *
+ * @param[in]   chanId: The channel ID.
+ * @param[out]  zone: The current zone of the channel.
+ *
+ * @return  0 if successful, -ENOTSUP if the window comparator is disabled,
+ *          -EINVAL if zone is NULL or chanId is out of range, -ENOENT if the
+ *          channel has no window.
+ */
+int adcAcqGetWindowZone(size_t chanId, AdcWindowZone_t *zone);
+
 #endif /* ADC_ACQUISITION */
 
 /** @} */
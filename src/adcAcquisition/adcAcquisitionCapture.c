@@ -0,0 +1,205 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      adcAcquisitionCapture.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     ADC Acquisition Raw Capture
+ *
+ *            ADC acquisition raw capture implementation. The scans are copied
+ *            from the ADC sequence callback into a preallocated buffer, the
+ *            capture state hands the buffer over to the readers once full.
+ *
+ * @ingroup   adc-acquisition
+ * @{
+ */
+
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <string.h>
+
+#include "adcAcquisitionCapture.h"
+#include "adcAcquisitionUtil.h"
+
+/* Setting module logging */
+LOG_MODULE_DECLARE(ADC_AQC_SERVICE_NAME);
+
+/**
+ * @brief   The capture buffer.
+ */
+static uint16_t *captureBuf = NULL;
+
+/**
+ * @brief   The capture channel count.
+ */
+static size_t captureChanCount = 0;
+
+/**
+ * @brief   The captured scan count.
+ */
+static size_t capturedCount = 0;
+
+/**
+ * @brief   The capture trigger.
+ */
+static AdcCaptureTrigger_t captureTrigger;
+
+/**
+ * @brief   The previous trigger channel sample.
+ */
+static uint16_t prevSample;
+
+/**
+ * @brief   The previous trigger channel sample valid flag.
+ */
+static bool isPrevSampleValid;
+
+/**
+ * @brief   The capture state.
+ */
+static atomic_t captureState = ATOMIC_INIT(ADC_CAPTURE_IDLE);
+
+/**
+ * @brief   Check if a scan fires the capture trigger.
+ *
+ * @param[in]   scan: The scan raw data.
+ *
+ * @return  true if the trigger fires, false otherwise.
+ */
+static bool isTriggered(const uint16_t *scan)
+{
+  bool isFired = false;
+  uint16_t sample = scan[captureTrigger.chanId];
+
+  switch(captureTrigger.mode)
+  {
+    case ADC_CAPTURE_TRIG_NOW:
+      isFired = true;
+      break;
+    case ADC_CAPTURE_TRIG_ABOVE:
+      isFired = sample >= captureTrigger.level;
+      break;
+    case ADC_CAPTURE_TRIG_BELOW:
+      isFired = sample < captureTrigger.level;
+      break;
+    case ADC_CAPTURE_TRIG_RISING:
+      isFired = isPrevSampleValid && prevSample < captureTrigger.level && sample >= captureTrigger.level;
+      break;
+    case ADC_CAPTURE_TRIG_FALLING:
+      isFired = isPrevSampleValid && prevSample >= captureTrigger.level && sample < captureTrigger.level;
+      break;
+    default:
+      break;
+  }
+
+  prevSample = sample;
+  isPrevSampleValid = true;
+
+  return isFired;
+}
+
+int adcAcqCaptureInit(size_t chanCount)
+{
+  int err;
+
+  captureChanCount = chanCount;
+
+  captureBuf = k_malloc(CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT * captureChanCount * sizeof(uint16_t));
+  if(!captureBuf)
+  {
+    err = -ENOSPC;
+    LOG_ERR("ERROR %d: unable to allocate the capture buffer", err);
+    return err;
+  }
+
+  capturedCount = 0;
+  atomic_set(&captureState, ADC_CAPTURE_IDLE);
+
+  return 0;
+}
+
+int adcAcqCaptureArm(const AdcCaptureTrigger_t *trigger)
+{
+  if(!captureBuf)
+    return -ENODEV;
+
+  if(!trigger || trigger->mode >= ADC_CAPTURE_TRIG_COUNT || trigger->chanId >= captureChanCount)
+    return -EINVAL;
+
+  /* The sequence callback ignores the capture until it is armed again */
+  atomic_set(&captureState, ADC_CAPTURE_IDLE);
+
+  captureTrigger = *trigger;
+  capturedCount = 0;
+  isPrevSampleValid = false;
+
+  atomic_set(&captureState, ADC_CAPTURE_ARMED);
+
+  return 0;
+}
+
+void adcAcqCaptureAbort(void)
+{
+  atomic_set(&captureState, ADC_CAPTURE_IDLE);
+}
+
+AdcCaptureState_t adcAcqCaptureGetState(void)
+{
+  return (AdcCaptureState_t)atomic_get(&captureState);
+}
+
+size_t adcAcqCaptureGetScanCount(void)
+{
+  return capturedCount;
+}
+
+int adcAcqCaptureGetData(const uint16_t **data, size_t *scanCount)
+{
+  if(!data || !scanCount)
+    return -EINVAL;
+
+  if(atomic_get(&captureState) != ADC_CAPTURE_DONE)
+    return -ENODATA;
+
+  *data = captureBuf;
+  *scanCount = capturedCount;
+
+  return 0;
+}
+
+int adcAcqCapturePushBlock(const uint16_t *block, size_t scanCount)
+{
+  const uint16_t *scan;
+  AdcCaptureState_t state;
+
+  if(!block)
+    return -EINVAL;
+
+  state = (AdcCaptureState_t)atomic_get(&captureState);
+  if(state != ADC_CAPTURE_ARMED && state != ADC_CAPTURE_RUNNING)
+    return 0;
+
+  for(size_t i = 0; i < scanCount && state != ADC_CAPTURE_DONE; ++i)
+  {
+    scan = block + i * captureChanCount;
+
+    if(state == ADC_CAPTURE_ARMED)
+    {
+      if(!isTriggered(scan))
+        continue;
+
+      state = ADC_CAPTURE_RUNNING;
+    }
+
+    memcpy(captureBuf + capturedCount * captureChanCount, scan, captureChanCount * sizeof(uint16_t));
+
+    if(++capturedCount == CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT)
+      state = ADC_CAPTURE_DONE;
+  }
+
+  atomic_set(&captureState, state);
+
+  return 0;
+}
+
+/** @} */
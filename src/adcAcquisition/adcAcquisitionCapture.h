@@ -0,0 +1,132 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      adcAcquisitionCapture.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     ADC Acquisition Service Raw Capture.
+ *
+ *            ADC acquisition raw capture API. Once armed, the capture waits
+ *            for its trigger and records the following raw scans at the full
+ *            sampling rate, alongside the filter pipeline, until its buffer
+ *            is full.
+ *
+ * @ingroup   adc-acquisition
+ *
+ * @{
+ */
+
+#ifndef ADC_ACQ_CAPTURE
+#define ADC_ACQ_CAPTURE
+
+#include <zephyr/kernel.h>
+
+/**
+ * @brief   The capture trigger modes.
+ */
+typedef enum
+{
+  ADC_CAPTURE_TRIG_NOW = 0,             /**< Start at the next scan. */
+  ADC_CAPTURE_TRIG_ABOVE,               /**< Start at the first scan at or above the level. */
+  ADC_CAPTURE_TRIG_BELOW,               /**< Start at the first scan below the level. */
+  ADC_CAPTURE_TRIG_RISING,              /**< Start when crossing the level upward. */
+  ADC_CAPTURE_TRIG_FALLING,             /**< Start when crossing the level downward. */
+  ADC_CAPTURE_TRIG_COUNT,
+} AdcCaptureTrigMode_t;
+
+/**
+ * @brief   The capture states.
+ */
+typedef enum
+{
+  ADC_CAPTURE_IDLE = 0,                 /**< No capture armed. */
+  ADC_CAPTURE_ARMED,                    /**< Waiting for the trigger. */
+  ADC_CAPTURE_RUNNING,                  /**< Recording the scans. */
+  ADC_CAPTURE_DONE,                     /**< The capture buffer is full. */
+} AdcCaptureState_t;
+
+/**
+ * @brief   The capture trigger.
+ */
+typedef struct
+{
+  AdcCaptureTrigMode_t mode;            /**< The trigger mode. */
+  size_t chanId;                        /**< The trigger channel ID. */
+  uint16_t level;                       /**< The trigger raw level. */
+} AdcCaptureTrigger_t;
+
+/**
+ * @brief   Initialize the raw capture.
+ *
+ * @note    The capture buffer holds CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT
+ *          scans of all channels.
+ *
+ * @param[in]   chanCount: The channel count.
+ *
+ * @return  0 if successful, -ENOSPC if the capture buffer allocation fails.
+ */
+int adcAcqCaptureInit(size_t chanCount);
+
+/**
+ * @brief   Arm a new capture.
+ *
+ * @note    The previous capture is discarded.
+ *
+ * @param[in]   trigger: The capture trigger.
+ *
+ * @return  0 if successful, -ENODEV if the capture is not initialized,
+ *          -EINVAL if the trigger is NULL or its mode or channel is out of
+ *          range.
+ */
+int adcAcqCaptureArm(const AdcCaptureTrigger_t *trigger);
+
+/**
+ * @brief   Abort the ongoing capture.
+ */
+void adcAcqCaptureAbort(void);
+
+/**
+ * @brief   Get the capture state.
+ *
+ * @return  The capture state.
+ */
+AdcCaptureState_t adcAcqCaptureGetState(void);
+
+/**
+ * @brief   Get the captured scan count.
+ *
+ * @return  The captured scan count.
+ */
+size_t adcAcqCaptureGetScanCount(void);
+
+/**
+ * @brief   Get the completed capture.
+ *
+ * @note    The scans of all channels are stored one after the other, as
+ *          stored by the ADC sequence. The data stays valid until the next
+ *          capture is armed.
+ *
+ * @param[out]  data: The captured raw data.
+ * @param[out]  scanCount: The captured scan count.
+ *
+ * @return  0 if successful, -EINVAL if data or scanCount is NULL, -ENODATA
+ *          if the capture is not done.
+ */
+int adcAcqCaptureGetData(const uint16_t **data, size_t *scanCount);
+
+/**
+ * @brief   Push a block of raw data scans to the capture.
+ *
+ * @note    Called from the ADC sequence callback, it only copies the scans
+ *          while a capture is armed or running.
+ *
+ * @param[in]   block: The raw data block.
+ * @param[in]   scanCount: The scan count of the block.
+ *
+ * @return  0 if successful, -EINVAL if block is NULL.
+ */
+int adcAcqCapturePushBlock(const uint16_t *block, size_t scanCount);
+
+#endif    /* ADC_ACQ_CAPTURE */
+
+/** @} */
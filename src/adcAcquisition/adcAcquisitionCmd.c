@@ -13,15 +13,28 @@
  */
 
 #include <zephyr/shell/shell.h>
+#include <zephyr/sys/base64.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "adcAcquisitionUtil.h"
+#include "adcAcquisitionCapture.h"
 
 /**
  * @brief   The maximum length of the value string.
  */
 #define MAX_VAL_STR_LEN                                         (10)
 
+/**
+ * @brief   The raw capture byte count per dump line.
+ */
+#define CAPTURE_DUMP_CHUNK_LEN                                  (48)
+
+/**
+ * @brief   The base64 length of a dump line, with its terminator.
+ */
+#define CAPTURE_DUMP_LINE_LEN                                   (((CAPTURE_DUMP_CHUNK_LEN + 2) / 3) * 4 + 1)
+
 /**
  * @brief   Execute the get channel count command.
  *
@@ -114,10 +127,222 @@ static int execGetVolt(const struct shell *shell, size_t argc, char **argv)
   return 0;
 }
 
+/**
+ * @brief   Execute the statistics command.
+ *
+ * @param[in]   shell: The shell handle.
+ * @param[in]   argc: The count of argument.
+ * @param[in]   argv: The vector of argument (argv[1] is the optional reset).
+ *
+ * @return  0 if successful the error code otherwise.
+ */
+static int execStats(const struct shell *shell, size_t argc, char **argv)
+{
+  int err;
+  AdcAcqStats_t stats;
+
+  if(argc >= 2)
+  {
+    if(strcmp(argv[1], "reset") != 0)
+    {
+      shell_error(shell, "FAIL %d: unknown option '%s'", -EINVAL, argv[1]);
+      return -EINVAL;
+    }
+
+    adcAcqUtilResetStats();
+    shell_info(shell, "SUCCESS: statistics reset");
+    return 0;
+  }
+
+  err = adcAcqUtilGetStats(&stats);
+  if(err < 0)
+  {
+    shell_error(shell, "FAIL %d: unable to get the statistics", err);
+    return err;
+  }
+
+  shell_print(shell, "Statistics over %lld ms", (long long)stats.elapsedMs);
+  shell_print(shell, "Triggers: %u, overruns: %u", stats.triggerCount, stats.overrunCount);
+  shell_print(shell, "Start errors: %u, filter errors: %u", stats.startErrorCount, stats.filterErrorCount);
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING
+  shell_print(shell, "Timed blocks: %u", stats.blockCount);
+  shell_print(shell, "Conversion time: min %u us, max %u us", stats.convTimeMinUs, stats.convTimeMaxUs);
+  shell_print(shell, "Trigger latency: min %u us, max %u us", stats.latencyMinUs, stats.latencyMaxUs);
+#endif
+
+  return 0;
+}
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_CAPTURE
+/**
+ * @brief   The capture trigger mode names.
+ */
+static const char *const captureModeNames[ADC_CAPTURE_TRIG_COUNT] = {
+  "now",
+  "above",
+  "below",
+  "rising",
+  "falling",
+};
+
+/**
+ * @brief   The capture state names.
+ */
+static const char *const captureStateNames[] = {
+  "idle",
+  "armed",
+  "running",
+  "done",
+};
+
+/**
+ * @brief   Execute the capture arm command.
+ *
+ * @param[in]   shell: The shell handle.
+ * @param[in]   argc: The count of argument.
+ * @param[in]   argv: The vector of argument.
+ *
+ * @return  0 if successful the error code otherwise.
+ */
+static int execCaptureArm(const struct shell *shell, size_t argc, char **argv)
+{
+  int err = 0;
+  AdcCaptureTrigger_t trigger = {.mode = ADC_CAPTURE_TRIG_COUNT};
+
+  for(size_t i = 0; i < ADC_CAPTURE_TRIG_COUNT; ++i)
+  {
+    if(strcmp(argv[1], captureModeNames[i]) == 0)
+      trigger.mode = i;
+  }
+
+  if(trigger.mode == ADC_CAPTURE_TRIG_COUNT || (trigger.mode != ADC_CAPTURE_TRIG_NOW && argc < 4))
+  {
+    err = -EINVAL;
+    shell_error(shell, "FAIL %d: invalid trigger arguments", err);
+    shell_help(shell);
+    return err;
+  }
+
+  if(argc > 2)
+  {
+    trigger.chanId = shell_strtoul(argv[2], 10, &err);
+    if(err < 0)
+    {
+      shell_error(shell, "FAIL %d: invalid channel ID argument", err);
+      shell_help(shell);
+      return err;
+    }
+  }
+
+  if(argc > 3)
+  {
+    trigger.level = shell_strtoul(argv[3], 10, &err);
+    if(err < 0)
+    {
+      shell_error(shell, "FAIL %d: invalid level argument", err);
+      shell_help(shell);
+      return err;
+    }
+  }
+
+  err = adcAcqCaptureArm(&trigger);
+  if(err < 0)
+  {
+    shell_error(shell, "FAIL %d: unable to arm the capture", err);
+    return err;
+  }
+
+  shell_info(shell, "SUCCESS: capture armed on %s", captureModeNames[trigger.mode]);
+
+  return 0;
+}
+
+/**
+ * @brief   Execute the capture status command.
+ *
+ * @param[in]   shell: The shell handle.
+ * @param[in]   argc: The count of argument.
+ * @param[in]   argv: The vector of argument.
+ *
+ * @return  Always returns 0.
+ */
+static int execCaptureStatus(const struct shell *shell, size_t argc, char **argv)
+{
+  AdcCaptureState_t state;
+
+  state = adcAcqCaptureGetState();
+
+  shell_info(shell, "SUCCESS: capture %s, %d scans of %d", captureStateNames[state], adcAcqCaptureGetScanCount(),
+             CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT);
+
+  return 0;
+}
+
+/**
+ * @brief   Execute the capture dump command.
+ *
+ * @note    The raw samples are dumped as little-endian 16-bit values, scan
+ *          after scan, in base64 lines of CAPTURE_DUMP_CHUNK_LEN bytes.
+ *
+ * @param[in]   shell: The shell handle.
+ * @param[in]   argc: The count of argument.
+ * @param[in]   argv: The vector of argument.
+ *
+ * @return  0 if successful the error code otherwise.
+ */
+static int execCaptureDump(const struct shell *shell, size_t argc, char **argv)
+{
+  int err;
+  const uint16_t *data;
+  const uint8_t *bytes;
+  size_t scanCount;
+  size_t byteCount;
+  size_t chunkLen;
+  size_t lineLen;
+  char line[CAPTURE_DUMP_LINE_LEN];
+
+  err = adcAcqCaptureGetData(&data, &scanCount);
+  if(err < 0)
+  {
+    shell_error(shell, "FAIL %d: no capture done", err);
+    return err;
+  }
+
+  bytes = (const uint8_t *)data;
+  byteCount = scanCount * adcAcqUtilGetChanCount() * sizeof(uint16_t);
+
+  for(size_t offset = 0; offset < byteCount; offset += chunkLen)
+  {
+    chunkLen = MIN(CAPTURE_DUMP_CHUNK_LEN, byteCount - offset);
+
+    err = base64_encode((uint8_t *)line, sizeof(line), &lineLen, bytes + offset, chunkLen);
+    if(err < 0)
+    {
+      shell_error(shell, "FAIL %d: unable to encode the capture", err);
+      return err;
+    }
+
+    shell_print(shell, "%s", line);
+  }
+
+  shell_info(shell, "SUCCESS: %d scans of %d channels dumped", scanCount, adcAcqUtilGetChanCount());
+
+  return 0;
+}
+#endif
+
 SHELL_STATIC_SUBCMD_SET_CREATE(adcAqc_sub,
   SHELL_CMD(get_chan_count, NULL, "Get the channel count.\n\tUsage: adc_acq get_chan_count", execGetChanCount),
   SHELL_CMD_ARG(get_raw, NULL, "Get a channel raw value.\n\tUsage: adc_acq get_raw <chan ID>", execGetRaw, 2, 0),
   SHELL_CMD_ARG(get_volt, NULL, "Get a channel volt value.\n\tUsage: adc_acq get_volt <chan ID>", execGetVolt, 2, 0),
+  SHELL_CMD_ARG(stats, NULL, "Get the acquisition statistics.\n\tUsage: adc_acq stats [reset]", execStats, 1, 1),
+  SHELL_COND_CMD_ARG(CONFIG_ENYA_ADC_ACQUISITION_CAPTURE, capture_arm, NULL,
+    "Arm a raw capture.\n\tUsage: adc_acq capture_arm <now|above|below|rising|falling> [chan ID] [raw level]",
+    execCaptureArm, 2, 2),
+  SHELL_COND_CMD(CONFIG_ENYA_ADC_ACQUISITION_CAPTURE, capture_status, NULL,
+    "Get the raw capture state.\n\tUsage: adc_acq capture_status", execCaptureStatus),
+  SHELL_COND_CMD(CONFIG_ENYA_ADC_ACQUISITION_CAPTURE, capture_dump, NULL,
+    "Dump the raw capture in base64.\n\tUsage: adc_acq capture_dump", execCaptureDump),
   SHELL_SUBCMD_SET_END);
 SHELL_CMD_REGISTER(adc_acq, &adcAqc_sub, "ADC acquisition commands.",	NULL);
 
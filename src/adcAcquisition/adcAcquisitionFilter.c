@@ -23,6 +23,11 @@
 /* Setting module logging */
 LOG_MODULE_DECLARE(ADC_AQC_SERVICE_NAME);
 
+/**
+ * @brief   The filter raw data index.
+ */
+#define FILTER_RAW_IDX                                                (0)
+
 /**
  * @brief   The filter first order index.
  */
@@ -43,6 +48,21 @@ LOG_MODULE_DECLARE(ADC_AQC_SERVICE_NAME);
  */
 #define FILTER_MAX_ORDER                                              (3)
 
+/**
+ * @brief   The filter tau plane index.
+ */
+#define FILTER_TAU_IDX                                                (FILTER_MAX_ORDER + 1)
+
+/**
+ * @brief   The filter order plane index.
+ */
+#define FILTER_ORDER_IDX                                              (FILTER_MAX_ORDER + 2)
+
+/**
+ * @brief   The filter buffer plane count.
+ */
+#define FILTER_PLANE_COUNT                                            (FILTER_MAX_ORDER + 3)
+
 /**
  * @brief   The filter prescale value.
  */
@@ -58,6 +78,15 @@ LOG_MODULE_DECLARE(ADC_AQC_SERVICE_NAME);
  */
 #define FILTER_MAX_TAU                                                (511)
 
+/**
+ * @brief   Get the filter buffer index of a channel stage.
+ *
+ * @note    The buffer holds one plane of filterCount values per stage, so the
+ *          channel loop of each stage runs over contiguous memory. The tau and
+ *          order planes hold the configuration of each channel.
+ */
+#define FILTER_IDX(stage, chanId)                                     ((stage) * filterCount + (chanId))
+
 /**
  * @brief   The filter buffer
  */
@@ -68,13 +97,31 @@ int32_t *filterBuf = NULL;
  */
 size_t filterCount = 0;
 
+/**
+ * @brief   Clamp the tau value to its valid range.
+ *
+ * @param[in]   tau: The filter tau value.
+ *
+ * @return  The clamped tau value.
+ */
+static inline int32_t clampTau(int32_t tau)
+{
+  if(tau < FILTER_MIN_TAU)
+    return FILTER_MIN_TAU;
+
+  if(tau > FILTER_MAX_TAU)
+    return FILTER_MAX_TAU;
+
+  return tau;
+}
+
 int adcAcqFilterInit(size_t chanCount)
 {
   int err;
 
   filterCount = chanCount;
 
-  filterBuf = k_malloc(filterCount * (FILTER_MAX_ORDER + 1) * sizeof(int32_t));
+  filterBuf = k_malloc(filterCount * FILTER_PLANE_COUNT * sizeof(int32_t));
   if(!filterBuf)
   {
     err = -ENOSPC;
@@ -84,13 +131,72 @@ int adcAcqFilterInit(size_t chanCount)
 
   memset(filterBuf, 0, filterCount * (FILTER_MAX_ORDER + 1) * sizeof(int32_t));
 
+  for(size_t i = 0; i < filterCount; ++i)
+  {
+    filterBuf[FILTER_IDX(FILTER_TAU_IDX, i)] = FILTER_MAX_TAU;
+    filterBuf[FILTER_IDX(FILTER_ORDER_IDX, i)] = FILTER_MAX_ORDER;
+  }
+
   return 0;
 }
 
+int adcAcqFilterConfigChannel(size_t chanId, int32_t tau, uint32_t order)
+{
+  int err;
+
+  if(chanId >= filterCount)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid channel ID %d", err, chanId);
+    return err;
+  }
+
+  if(order > FILTER_MAX_ORDER)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid filter order %d", err, order);
+    return err;
+  }
+
+  filterBuf[FILTER_IDX(FILTER_TAU_IDX, chanId)] = clampTau(tau);
+  filterBuf[FILTER_IDX(FILTER_ORDER_IDX, chanId)] = (int32_t)order;
+
+  return 0;
+}
+
+/**
+ * @brief   Run the filter cascade on one scan of a channel range.
+ *
+ * @note    The stages above the order of a channel follow the last filtered
+ *          stage without being computed.
+ *
+ * @param[in]   scan: The raw data of each channel of the range.
+ * @param[in]   firstChan: The ID of the first channel of the range.
+ * @param[in]   rangeCount: The channel count of the range.
+ */
+static inline void filterScan(const uint16_t *scan, size_t firstChan, size_t rangeCount)
+{
+  int32_t *raw = filterBuf + FILTER_IDX(FILTER_RAW_IDX, firstChan);
+  const int32_t *taus = filterBuf + FILTER_IDX(FILTER_TAU_IDX, firstChan);
+  const int32_t *orders = filterBuf + FILTER_IDX(FILTER_ORDER_IDX, firstChan);
+
+  for(size_t i = 0; i < rangeCount; ++i)
+    raw[i] = (int32_t)scan[i] << FILTER_PRESCALE;
+
+  for(int32_t stage = FILTER_FIRST_ORDER_IDX; stage <= FILTER_MAX_ORDER; ++stage)
+  {
+    const int32_t *in = filterBuf + FILTER_IDX(stage - 1, firstChan);
+    int32_t *out = filterBuf + FILTER_IDX(stage, firstChan);
+
+    for(size_t i = 0; i < rangeCount; ++i)
+      out[i] = orders[i] >= stage ? out[i] + (((in[i] - out[i]) * taus[i]) >> FILTER_PRESCALE) : in[i];
+  }
+}
+
 int adcAcqFilterPushData(size_t chanId, int32_t rawData, int32_t tau)
 {
   int err;
-  size_t chanBaseIdx = chanId * (FILTER_MAX_ORDER + 1);
+  int32_t order;
 
   if(chanId >= filterCount)
   {
@@ -99,16 +205,47 @@ int adcAcqFilterPushData(size_t chanId, int32_t rawData, int32_t tau)
     return err;
   }
 
-  if(tau < FILTER_MIN_TAU)
-    tau = FILTER_MIN_TAU;
-  else if(tau > FILTER_MAX_TAU)
-    tau = FILTER_MAX_TAU;
+  tau = clampTau(tau);
+  order = filterBuf[FILTER_IDX(FILTER_ORDER_IDX, chanId)];
+
+  filterBuf[FILTER_IDX(FILTER_RAW_IDX, chanId)] = rawData << FILTER_PRESCALE;
+
+  for(int32_t stage = FILTER_FIRST_ORDER_IDX; stage <= FILTER_MAX_ORDER; ++stage)
+  {
+    int32_t in = filterBuf[FILTER_IDX(stage - 1, chanId)];
+    int32_t *out = filterBuf + FILTER_IDX(stage, chanId);
+
+    *out = order >= stage ? *out + (((in - *out) * tau) >> FILTER_PRESCALE) : in;
+  }
+
+  return 0;
+}
+
+int adcAcqFilterPushBlock(const uint16_t *block, size_t scanCount)
+{
+  return adcAcqFilterPushRangeBlock(block, scanCount, 0, filterCount);
+}
+
+int adcAcqFilterPushRangeBlock(const uint16_t *block, size_t scanCount, size_t firstChan, size_t rangeCount)
+{
+  int err;
+
+  if(!block)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: NULL pointer for the data block", err);
+    return err;
+  }
+
+  if(firstChan + rangeCount > filterCount)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid channel range %d-%d", err, firstChan, firstChan + rangeCount);
+    return err;
+  }
 
-  rawData <<= FILTER_PRESCALE;
-  filterBuf[chanBaseIdx] = rawData;
-  filterBuf[chanBaseIdx + 1] += (((rawData - filterBuf[chanBaseIdx + 1]) * tau) >> FILTER_PRESCALE);
-  filterBuf[chanBaseIdx + 2] += (((filterBuf[chanBaseIdx + 1] - filterBuf[chanBaseIdx + 2]) * tau) >> FILTER_PRESCALE);
-  filterBuf[chanBaseIdx + 3] += (((filterBuf[chanBaseIdx + 2] - filterBuf[chanBaseIdx + 3]) * tau) >> FILTER_PRESCALE);
+  for(size_t scan = 0; scan < scanCount; ++scan, block += rangeCount)
+    filterScan(block, firstChan, rangeCount);
 
   return 0;
 }
@@ -116,7 +253,7 @@ int adcAcqFilterPushData(size_t chanId, int32_t rawData, int32_t tau)
 int adcAcqFilterGetRawData(size_t chanId, int32_t *rawData)
 {
   int err;
-  size_t dataIdx = chanId * (FILTER_MAX_ORDER + 1);
+  size_t dataIdx = FILTER_IDX(FILTER_RAW_IDX, chanId);
 
   if(chanId >= filterCount)
   {
@@ -140,7 +277,7 @@ int adcAcqFilterGetRawData(size_t chanId, int32_t *rawData)
 int adcAcqFilterGetFirstOrderData(size_t chanId, int32_t *filtData)
 {
   int err;
-  size_t dataIdx = chanId * (FILTER_MAX_ORDER + 1) + FILTER_FIRST_ORDER_IDX;
+  size_t dataIdx = FILTER_IDX(FILTER_FIRST_ORDER_IDX, chanId);
 
   if(chanId >= filterCount)
   {
@@ -164,7 +301,7 @@ int adcAcqFilterGetFirstOrderData(size_t chanId, int32_t *filtData)
 int adcAcqFilterGetSecondOrderData(size_t chanId, int32_t *filtData)
 {
   int err;
-  size_t dataIdx = chanId * (FILTER_MAX_ORDER + 1) + FILTER_SECOND_ORDER_IDX;
+  size_t dataIdx = FILTER_IDX(FILTER_SECOND_ORDER_IDX, chanId);
 
   if(chanId >= filterCount)
   {
@@ -188,7 +325,7 @@ int adcAcqFilterGetSecondOrderData(size_t chanId, int32_t *filtData)
 int adcAcqFilterGetThirdOrderData(size_t chanId, int32_t *filtData)
 {
   int err;
-  size_t dataIdx = chanId * (FILTER_MAX_ORDER + 1) + 3;
+  size_t dataIdx = FILTER_IDX(FILTER_THIRD_ORDER_IDX, chanId);
 
   if(chanId >= filterCount)
   {
@@ -64,9 +64,28 @@
  */
 int adcAcqFilterInit(size_t chanCount);
 
+/**
+ * @brief   Configure the filter of a channel.
+ *
+ * @note    A channel filters through its first order stages only, the stages
+ *          above its order follow the last filtered stage. Order 0 bypasses
+ *          the filter. The channels default to the maximum tau and order.
+ *
+ * @param[in]   chanId: The channel ID.
+ * @param[in]   tau: The filter tau value (valid range 1–511; out-of-range values
+ *                   are clamped, no error is returned).
+ * @param[in]   order: The filter order (0–3).
+ *
+ * @return  0 if successful, -EINVAL if chanId or order is out of range.
+ */
+int adcAcqFilterConfigChannel(size_t chanId, int32_t tau, uint32_t order);
+
 /**
  * @brief   Push a new raw data to the filter stage.
  *
+ * @note    The channel configured order applies, the tau value given here
+ *          overrides the configured one.
+ *
  * @param[in]   chanId: The channel ID.
  * @param[in]   rawData: The raw data to push.
  * @param[in]   tau: The filter tau value (valid range 1–511; out-of-range values
@@ -76,6 +95,38 @@ int adcAcqFilterInit(size_t chanCount);
  */
 int adcAcqFilterPushData(size_t chanId, int32_t rawData, int32_t tau);
 
+/**
+ * @brief   Push a block of raw data scans to the filter stage.
+ *
+ * @note    The block holds scanCount scans of all channels, one after the
+ *          other, as stored by the ADC sequence. Each channel is filtered
+ *          with its configured tau and order.
+ *
+ * @param[in]   block: The raw data block.
+ * @param[in]   scanCount: The scan count of the block.
+ *
+ * @return  0 if successful, -EINVAL if block is NULL.
+ */
+int adcAcqFilterPushBlock(const uint16_t *block, size_t scanCount);
+
+/**
+ * @brief   Push a block of raw data scans of a channel range to the filter stage.
+ *
+ * @note    The block holds scanCount scans of the channels of the range only,
+ *          one after the other, as stored by the sequence of one ADC
+ *          controller. The ranges of different controllers can be pushed
+ *          concurrently.
+ *
+ * @param[in]   block: The raw data block.
+ * @param[in]   scanCount: The scan count of the block.
+ * @param[in]   firstChan: The ID of the first channel of the range.
+ * @param[in]   rangeCount: The channel count of the range.
+ *
+ * @return  0 if successful, -EINVAL if block is NULL or the range is out of
+ *          bounds.
+ */
+int adcAcqFilterPushRangeBlock(const uint16_t *block, size_t scanCount, size_t firstChan, size_t rangeCount);
+
 /**
  * @brief   Get the unfiltered data.
  *
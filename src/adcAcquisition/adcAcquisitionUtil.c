@@ -15,12 +15,16 @@
 #include <zephyr/drivers/counter.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/devicetree.h>
+#include <zephyr/sys/atomic.h>
 #include <string.h>
 #include <soc.h>
 
 #include "adcAcquisitionUtil.h"
 #include "adcAcquisitionVref.h"
 #include "adcAcquisitionFilter.h"
+#include "adcAcquisitionCapture.h"
+#include "adcAcquisitionWindow.h"
+#include "srvTrace.h"
 
 /* Setting module logging */
 LOG_MODULE_DECLARE(ADC_AQC_SERVICE_NAME);
@@ -35,11 +39,6 @@ LOG_MODULE_DECLARE(ADC_AQC_SERVICE_NAME);
  */
 #define OVERSAMPLING_RESOLUTION                                         (12)
 
-/**
- * @brief   The extra sampling setting.
- */
-#define EXTRA_SAMPLINGS_SETTING                                         (0)
-
 /**
  * @brief   The in between channel interval.
  */
@@ -50,11 +49,26 @@ LOG_MODULE_DECLARE(ADC_AQC_SERVICE_NAME);
  */
 #define VREFINT_CAL_VOLTAGE                                             (3.0f)
 
+/**
+ * @brief   Calibration done at 3.0V, in millivolts.
+ */
+#define VREFINT_CAL_MILLIVOLT                                           (3000)
+
 /**
  * @brief   The ADC full range value.
  */
 #define ADC_FULL_RANGE_VALUE                                            (4095.0f)
 
+/**
+ * @brief   The ADC full range value, in fixed-point.
+ */
+#define ADC_FULL_RANGE                                                  (4095)
+
+/**
+ * @brief   The millivolt scale fractional bit count.
+ */
+#define MILLIVOLT_SCALE_SHIFT                                           (16)
+
 /**
  * @brief   The user node from devicetree.
  */
@@ -75,11 +89,6 @@ LOG_MODULE_DECLARE(ADC_AQC_SERVICE_NAME);
  */
 static struct counter_top_cfg triggerConfig;
 
-/**
- * @brief   The ADC device.
- */
-static const struct device *adc;
-
 /**
  * @brief   The ADC channel count.
  */
@@ -111,19 +120,52 @@ static uint16_t *buffer = NULL;
 static float *voltValues = NULL;
 
 /**
- * @brief   The ADC conversion sequence.
+ * @brief   The average of the ADC value in millivolts.
  */
-static struct adc_sequence sequence;
+static int32_t *milliVoltValues = NULL;
 
 /**
- * @brief   The ADC sequence options.
+ * @brief   The VREFINT calibration in millivolts times its raw value,
+ *          precomputed at init.
  */
-static struct adc_sequence_options seqOptions;
+static uint32_t vrefCalMilliVolt;
 
 /**
- * @brief   ADC conversion in progress flag.
+ * @brief   The Vref reading of the millivolt scale, 0 when not computed yet.
  */
-static volatile bool adcBusy = false;
+static int32_t scaleVref = 0;
+
+/**
+ * @brief   The millivolt per LSB scale, in Q16.
+ */
+static uint32_t milliVoltScale;
+
+/**
+ * @brief   The ADC acquisition statistics counters.
+ * @note    The trigger timer and ADC interrupts update the counters, the
+ *          threads only read and reset them.
+ */
+typedef struct
+{
+  atomic_t triggerCount;
+  atomic_t overrunCount;
+  atomic_t startErrorCount;
+  atomic_t filterErrorCount;
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING
+  atomic_t blockCount;
+  atomic_t convTimeMinUs;
+  atomic_t convTimeMaxUs;
+  atomic_t latencyMinUs;
+  atomic_t latencyMaxUs;
+#endif
+  int64_t resetMs;
+}
+AdcStatsCounters_t;
+
+/**
+ * @brief   The ADC acquisition statistics.
+ */
+static AdcStatsCounters_t adcStats;
 
 /**
  * @brief   The subscription entry.
@@ -132,9 +174,27 @@ typedef struct
 {
   AdcSubCallback_t callback;
   bool isPaused;
+  uint32_t chanMask;      /**< The subscribed channels. */
+  uint32_t decimation;    /**< The notification period [notification ticks]. */
+  uint32_t countdown;     /**< The ticks left until the next notification. */
+  AdcDataFormat_t format; /**< The payload data format. */
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+  SrvMsgPayload_t *tickPayload; /**< The payload delivered at this notification. */
+#endif
 }
 AdcSubEntry_t;
 
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+/**
+ * @brief   The shared payload header, placed right before the payload.
+ */
+typedef struct
+{
+  atomic_t refCount;      /**< The payload reference count. */
+}
+AdcPayloadHeader_t;
+#endif
+
 /**
  * @brief   The subscriptions.
  */
@@ -153,6 +213,96 @@ static const struct adc_dt_spec adcChannels[] = {
   DT_FOREACH_PROP_ELEM(USER_NODE, io_channels, ADC_DT_SPEC_AND_COMMA)
 };
 
+/**
+ * @brief   The ADC controller group.
+ *
+ * @note    The channels of a controller are converted by their own sequence
+ *          into their own slice of the ADC buffer, the groups being started
+ *          together from the trigger timer.
+ */
+typedef struct
+{
+  const struct device *dev;             /**< The ADC controller. */
+  size_t firstChan;                     /**< The ID of the first channel of the group. */
+  size_t chanCount;                     /**< The channel count of the group. */
+  uint32_t divider;                     /**< The trigger count per group block. */
+  uint32_t countdown;                   /**< The triggers left until the next block. */
+  volatile bool isBusy;                 /**< The conversion in progress flag. */
+  struct adc_sequence sequence;         /**< The group conversion sequence. */
+  struct adc_sequence_options options;  /**< The group sequence options. */
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING
+  uint32_t triggerCycle;                /**< The cycle count of the ongoing block trigger. */
+#endif
+}
+AdcGroup_t;
+
+/**
+ * @brief   The ADC controller groups, at most one per channel.
+ */
+static AdcGroup_t groups[ARRAY_SIZE(adcChannels)];
+
+/**
+ * @brief   The ADC controller group count.
+ */
+static size_t groupCount = 0;
+
+/**
+ * @brief   Helper macro for DT_FOREACH_PROP_ELEM to get the group rate
+ *          dividers with commas.
+ */
+#define RATE_DIVIDER_AND_COMMA(node_id, prop, idx) \
+  DT_PROP_BY_IDX(node_id, prop, idx),
+
+/**
+ * @brief   The group rate dividers from devicetree adc-rate-dividers property,
+ *          in controller order. The groups without one run at the sampling rate.
+ */
+static const uint32_t rateDividers[] = {
+  COND_CODE_1(DT_NODE_HAS_PROP(USER_NODE, adc_rate_dividers),
+              (DT_FOREACH_PROP_ELEM(USER_NODE, adc_rate_dividers, RATE_DIVIDER_AND_COMMA)),
+              (1))
+};
+
+/**
+ * @brief   The channel filter setting using the configured default.
+ */
+#define FILTER_SETTING_DEFAULT                                          (-1)
+
+/**
+ * @brief   Helper macro for DT_FOREACH_PROP_ELEM to get a channel filter
+ *          setting with commas, or the default when the channel has none.
+ */
+#define FILTER_SETTING_AND_COMMA(node_id, setting, idx) \
+  COND_CODE_1(DT_PROP_HAS_IDX(node_id, setting, idx), \
+              (DT_PROP_BY_IDX(node_id, setting, idx)), \
+              (FILTER_SETTING_DEFAULT)),
+
+/**
+ * @brief   Helper macro for DT_FOREACH_PROP_ELEM to get channel filter taus.
+ */
+#define FILTER_TAU_AND_COMMA(node_id, prop, idx) \
+  FILTER_SETTING_AND_COMMA(node_id, filter_taus, idx)
+
+/**
+ * @brief   Helper macro for DT_FOREACH_PROP_ELEM to get channel filter orders.
+ */
+#define FILTER_ORDER_AND_COMMA(node_id, prop, idx) \
+  FILTER_SETTING_AND_COMMA(node_id, filter_orders, idx)
+
+/**
+ * @brief   The channel filter tau values from devicetree filter-taus property.
+ */
+static const int32_t filterTaus[] = {
+  DT_FOREACH_PROP_ELEM(USER_NODE, io_channels, FILTER_TAU_AND_COMMA)
+};
+
+/**
+ * @brief   The channel filter orders from devicetree filter-orders property.
+ */
+static const int32_t filterOrders[] = {
+  DT_FOREACH_PROP_ELEM(USER_NODE, io_channels, FILTER_ORDER_AND_COMMA)
+};
+
 /**
  * @brief   Enable the internal voltage reference (VREFINT).
  *
@@ -193,7 +343,10 @@ static inline uint16_t getVrefintCal(void)
 /**
  * @brief   Allocate the ADC buffers.
  *
- * @param[in]   chanCount: The size of the buffer.
+ * @note    The ADC buffer holds a block of config.blockScanCount scans per
+ *          group, one group slice after the other.
+ *
+ * @param[in]   chanCount: The channel count.
  *
  * @return  0 if successful, the error code otherwise.
  */
@@ -201,7 +354,7 @@ static inline int allocateBuffers(size_t chanCount)
 {
   int err = 0;
 
-  buffer = k_malloc(chanCount * sizeof(uint16_t));
+  buffer = k_malloc(config.blockScanCount * chanCount * sizeof(uint16_t));
   if(!buffer)
   {
     err = -ENOSPC;
@@ -209,13 +362,17 @@ static inline int allocateBuffers(size_t chanCount)
     return err;
   }
 
-  voltValues = k_malloc(chanCount * sizeof(float));
+  /* The millivolt values follow the volt values */
+  voltValues = k_malloc(chanCount * (sizeof(float) + sizeof(int32_t)));
   if(!voltValues)
   {
     err = -ENOSPC;
     LOG_ERR("ERROR %d: unable to allocate the volt average array", err);
+    return err;
   }
 
+  milliVoltValues = (int32_t *)(voltValues + chanCount);
+
   return err;
 }
 
@@ -243,15 +400,62 @@ static inline int allocateSubscription(size_t maxCount)
 }
 
 /**
- * @brief   Configure the ADC channels and setup the sequence.
+ * @brief   Open the controller group of a channel.
+ *
+ * @param[in]   chanId: The ID of the first channel of the group.
+ *
+ * @return  0 if successful, -EINVAL if the controller already has a group or
+ *          its rate divider is 0.
+ */
+static inline int openGroup(size_t chanId)
+{
+  int err;
+  AdcGroup_t *group = groups + groupCount;
+  const struct device *dev = adcChannels[chanId].dev;
+
+  for(size_t i = 0; i < groupCount; ++i)
+  {
+    if(groups[i].dev == dev)
+    {
+      err = -EINVAL;
+      LOG_ERR("ERROR %d: the channels of ADC controller %s are not contiguous", err, dev->name);
+      return err;
+    }
+  }
+
+  group->divider = groupCount < ARRAY_SIZE(rateDividers) ? rateDividers[groupCount] : 1;
+  if(group->divider == 0)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid rate divider of ADC controller %s", err, dev->name);
+    return err;
+  }
+
+  group->dev = dev;
+  group->firstChan = chanId;
+  group->chanCount = 0;
+  group->countdown = 1;
+  group->isBusy = false;
+  group->sequence.channels = 0;
+  ++groupCount;
+
+  return 0;
+}
+
+/**
+ * @brief   Configure the ADC channels and group them per controller.
+ *
+ * @note    The channels of a controller must follow each other in the
+ *          io-channels property.
  *
  * @return  0 if successful, the error code otherwise.
  */
 static inline int configureChannels(void)
 {
   int err;
+  AdcGroup_t *group = NULL;
 
-  sequence.channels = 0;
+  groupCount = 0;
 
   for(size_t i = 0; i < ARRAY_SIZE(adcChannels); ++i)
   {
@@ -269,41 +473,152 @@ static inline int configureChannels(void)
       return err;
     }
 
-    sequence.channels |= BIT(adcChannels[i].channel_id);
+    if(!group || group->dev != adcChannels[i].dev)
+    {
+      err = openGroup(i);
+      if(err < 0)
+        return err;
+
+      group = groups + groupCount - 1;
+    }
+
+    group->sequence.channels |= BIT(adcChannels[i].channel_id);
+    ++group->chanCount;
   }
 
   return 0;
 }
 
 /**
- * @brief   The timer interrupt function.
+ * @brief   Record the cycle count of a group block trigger.
  *
- * @param[in]   dev: The timer device.
- * @param[in]   user_data: The user data.
+ * @param[in,out] group: The controller group.
  */
-static void triggerConversion(const struct device *dev, void *user_data)
+static inline void recordTriggerCycle(AdcGroup_t *group)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING
+  group->triggerCycle = k_cycle_get_32();
+#else
+  ARG_UNUSED(group);
+#endif
+}
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING
+/**
+ * @brief   Record the time elapsed since the group block trigger.
+ *
+ * @note    Only called from the ADC interrupts. An update preempted by the
+ *          interrupt of another controller can be lost, the minimum and
+ *          maximum are statistics only.
+ *
+ * @param[in]     group: The controller group.
+ * @param[in,out] min: The minimum time [us].
+ * @param[in,out] max: The maximum time [us].
+ */
+static inline void recordTriggerElapsed(const AdcGroup_t *group, atomic_t *min, atomic_t *max)
+{
+  uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - group->triggerCycle);
+
+  if(us < (uint32_t)atomic_get(min))
+    atomic_set(min, us);
+
+  if(us > (uint32_t)atomic_get(max))
+    atomic_set(max, us);
+}
+#endif
+
+/**
+ * @brief   Record the latency from the block trigger to its first scan callback.
+ *
+ * @param[in]   group: The controller group.
+ */
+static inline void recordLatency(const AdcGroup_t *group)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING
+  recordTriggerElapsed(group, &adcStats.latencyMinUs, &adcStats.latencyMaxUs);
+#else
+  ARG_UNUSED(group);
+#endif
+}
+
+/**
+ * @brief   Record the conversion time of a complete block.
+ *
+ * @param[in]   group: The controller group.
+ */
+static inline void recordConvTime(const AdcGroup_t *group)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING
+  recordTriggerElapsed(group, &adcStats.convTimeMinUs, &adcStats.convTimeMaxUs);
+  atomic_inc(&adcStats.blockCount);
+#else
+  ARG_UNUSED(group);
+#endif
+}
+
+/**
+ * @brief   Start the block conversion of a group when due.
+ *
+ * @param[in,out] group: The controller group.
+ */
+static inline void triggerGroup(AdcGroup_t *group)
 {
   int err;
 
+  if(group->countdown > 1)
+  {
+    --group->countdown;
+    return;
+  }
+
+  group->countdown = group->divider;
+
   /* Skip if previous conversion still in progress */
-  if(adcBusy)
+  if(group->isBusy)
   {
-    LOG_WRN("ADC conversion still in progress, skipping trigger");
+    atomic_inc(&adcStats.overrunCount);
     return;
   }
 
-  adcBusy = true;
-  err = adc_read_async(adc, &sequence, NULL);
+  recordTriggerCycle(group);
+
+  group->isBusy = true;
+  err = adc_read_async(group->dev, &group->sequence, NULL);
   if(err < 0)
   {
-    LOG_ERR("ERROR %d: unable to start the ADC conversion", err);
-    adcBusy = false;  /* Clear flag on error */
+    atomic_inc(&adcStats.startErrorCount);
+    group->isBusy = false;  /* Clear flag on error */
   }
 }
 
+/**
+ * @brief   The timer interrupt function.
+ *
+ * @note    No logging from the interrupt, the failures are counted in the
+ *          statistics instead. The due groups are started one after the
+ *          other, their controllers then convert in parallel.
+ *
+ * @param[in]   dev: The timer device.
+ * @param[in]   user_data: The user data.
+ */
+static void triggerConversion(const struct device *dev, void *user_data)
+{
+  SRV_TRACE_BEGIN(ADC_TRIGGER, groupCount);
+
+  atomic_inc(&adcStats.triggerCount);
+
+  for(size_t i = 0; i < groupCount; ++i)
+    triggerGroup(groups + i);
+
+  SRV_TRACE_END(ADC_TRIGGER, groupCount);
+}
+
 /**
  * @brief  Configure the trigger timer.
  *
+ * @note    The timer triggers one block of config.blockScanCount scans per
+ *          period.
+ *
  * @return int
  */
 static int configureTimer(void)
@@ -318,7 +633,7 @@ static int configureTimer(void)
   }
 
   triggerConfig.flags = 0;
-  triggerConfig.ticks = counter_us_to_ticks(ADC_TRIGGER_TIMER, config.samplingRate);
+  triggerConfig.ticks = counter_us_to_ticks(ADC_TRIGGER_TIMER, config.samplingRate * config.blockScanCount);
   triggerConfig.callback = triggerConversion;
   triggerConfig.user_data = NULL;
 
@@ -328,44 +643,83 @@ static int configureTimer(void)
 /**
  * @brief   The sequence callback.
  *
+ * @note    The driver stores each scan of the block after the previous one,
+ *          the whole block is pushed into the filter channels of its group
+ *          after its last scan, their windows being compared right after.
+ *          The group comes from the sequence options user data, the driver
+ *          calling back with its own sequence copy.
+ *
  * @param[in]   dev: The ADC device.
  * @param[in]   sequence: The ADC conversion sequence.
  * @param[in]   samplingIndex: The sample index.
  *
- * @return  ADC_ACTION_FINISH to stop the conversion cycle.
+ * @return  ADC_ACTION_CONTINUE until the block is complete, ADC_ACTION_FINISH
+ *          to stop the conversion cycle.
  */
 static enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex)
 {
   int err;
+  AdcGroup_t *group = sequence->options->user_data;
+  const uint16_t *block = group->sequence.buffer;
 
-  for(size_t i = 0; i < chanCount; ++i)
-  {
-    err = adcAcqFilterPushData(i, (int32_t)buffer[i], config.filterTau);
-    if(err < 0)
-      LOG_ERR("ERROR %d: unable to push data to the filter", err);
-  }
+  if(samplingIndex == 0)
+    recordLatency(group);
+
+  if(samplingIndex + 1 < config.blockScanCount)
+    return ADC_ACTION_CONTINUE;
+
+  /* Only the block completion is traced, the other scans return right away */
+  SRV_TRACE_BEGIN(ADC_SEQ_CALLBACK, group->firstChan);
+
+  recordConvTime(group);
+
+  err = adcAcqFilterPushRangeBlock(block, config.blockScanCount, group->firstChan, group->chanCount);
+  if(err < 0)
+    atomic_inc(&adcStats.filterErrorCount);
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_WINDOW
+  else
+    adcAcqWindowCheckRange(group->firstChan, group->chanCount);
+#endif
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_CAPTURE
+  /* Only initialized with a single group, holding all the channels */
+  adcAcqCapturePushBlock(block, config.blockScanCount);
+#endif
 
   /* Clear busy flag - conversion complete */
-  adcBusy = false;
+  group->isBusy = false;
+
+  SRV_TRACE_END(ADC_SEQ_CALLBACK, group->firstChan);
 
   return ADC_ACTION_FINISH;
 }
 
 /**
- * @brief   Setup the ADC sequence.
+ * @brief   Setup the ADC sequence of each group.
+ *
+ * @note    Each group converts into its own slice of the ADC buffer, with the
+ *          resolution and oversampling of its first channel.
  */
 static inline void setupSequence(void)
 {
-  sequence.oversampling = adcChannels[0].oversampling;
-  sequence.resolution = adcChannels[0].resolution;
-  sequence.calibrate = false;
-  sequence.options = &seqOptions;
-  sequence.buffer = buffer;
-  sequence.buffer_size = chanCount * sizeof(uint16_t);
-
-  seqOptions.extra_samplings = EXTRA_SAMPLINGS_SETTING;
-  seqOptions.interval_us = CHANNEL_INTERVAL;
-  seqOptions.callback = adcSeqCallback;
+  for(size_t i = 0; i < groupCount; ++i)
+  {
+    AdcGroup_t *group = groups + i;
+    const struct adc_dt_spec *spec = adcChannels + group->firstChan;
+
+    group->sequence.oversampling = spec->oversampling;
+    group->sequence.resolution = spec->resolution;
+    group->sequence.calibrate = false;
+    group->sequence.options = &group->options;
+    group->sequence.buffer = buffer + config.blockScanCount * group->firstChan;
+    group->sequence.buffer_size = config.blockScanCount * group->chanCount * sizeof(uint16_t);
+
+    /* The scans after the first one are paced by the driver over the group period */
+    group->options.extra_samplings = config.blockScanCount - 1;
+    group->options.interval_us = config.blockScanCount > 1 ? config.samplingRate * group->divider : CHANNEL_INTERVAL;
+    group->options.callback = adcSeqCallback;
+    group->options.user_data = group;
+  }
 }
 
 /**
@@ -382,14 +736,156 @@ static inline float calculateVdd(int32_t vrefVal)
   return VREFINT_CAL_VOLTAGE * (float)vrefCal / (float)vrefVal;
 }
 
+/**
+ * @brief   Get the filtered internal Vref.
+ *
+ * @param[out]  rawVref: The filtered internal Vref.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static inline int getRawVref(int32_t *rawVref)
+{
+  int err;
+
+  /* Read Vref from the configured vref channel index */
+  err = adcAcqFilterGetThirdOrderData(VREF_CHANNEL_INDEX, rawVref);
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to get vref data from ADC", err);
+
+  return err;
+}
+
+/**
+ * @brief   Get the real VDD from the filtered internal Vref.
+ *
+ * @param[out]  vdd: The real VDD.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static inline int getVdd(float *vdd)
+{
+  int err;
+  int32_t rawVref;
+
+  err = getRawVref(&rawVref);
+  if(err < 0)
+    return err;
+
+  *vdd = calculateVdd(rawVref);
+
+  return 0;
+}
+
+/**
+ * @brief   Update the millivolt scale from the filtered internal Vref.
+ *
+ * @note    The scale is only computed again when the Vref reading moves.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static inline int updateMilliVoltScale(void)
+{
+  int err;
+  int32_t rawVref;
+
+  err = getRawVref(&rawVref);
+  if(err < 0)
+    return err;
+
+  if(rawVref <= 0)
+  {
+    err = -EIO;
+    LOG_ERR("ERROR %d: invalid vref reading %d", err, rawVref);
+    return err;
+  }
+
+  if(rawVref != scaleVref)
+  {
+    milliVoltScale = (uint32_t)(((uint64_t)vrefCalMilliVolt << MILLIVOLT_SCALE_SHIFT) /
+                                ((uint32_t)rawVref * ADC_FULL_RANGE));
+    scaleVref = rawVref;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief   Convert the filtered data of a channel to volts.
+ *
+ * @param[in]   chanId: The channel ID.
+ * @param[in]   vdd: The real VDD.
+ * @param[out]  voltVal: The volt value.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static inline int convertChannel(size_t chanId, float vdd, float *voltVal)
+{
+  int err;
+  int32_t rawData;
+
+  err = adcAcqFilterGetThirdOrderData(chanId, &rawData);
+  if(err < 0)
+    return err;
+
+  *voltVal = ((float)rawData * vdd) / ADC_FULL_RANGE_VALUE;
+
+  return 0;
+}
+
+/**
+ * @brief   Convert the filtered data of a channel to millivolts.
+ *
+ * @param[in]   chanId: The channel ID.
+ * @param[out]  milliVoltVal: The millivolt value.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static inline int convertChannelMilliVolt(size_t chanId, int32_t *milliVoltVal)
+{
+  int err;
+  int32_t rawData;
+
+  err = adcAcqFilterGetThirdOrderData(chanId, &rawData);
+  if(err < 0)
+    return err;
+
+  *milliVoltVal = (int32_t)(((int64_t)rawData * milliVoltScale + BIT(MILLIVOLT_SCALE_SHIFT - 1)) >>
+                            MILLIVOLT_SCALE_SHIFT);
+
+  return 0;
+}
+
+/**
+ * @brief   Get the mask of all the channels.
+ *
+ * @return  The mask of all the channels.
+ */
+static inline uint32_t getAllChanMask(void)
+{
+  return chanCount >= 32 ? UINT32_MAX : (uint32_t)BIT_MASK(chanCount);
+}
+
 int adcAcqUtilInitAdc(AdcConfig_t *adcConfig)
 {
   int err;
 
-  adc = adcChannels[0].dev;
+  if(adcConfig->blockScanCount == 0)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid block scan count", err);
+    return err;
+  }
+
   chanCount = ARRAY_SIZE(adcChannels);
   config.samplingRate = adcConfig->samplingRate;
   config.filterTau = adcConfig->filterTau;
+  config.filterOrder = adcConfig->filterOrder;
+  config.blockScanCount = adcConfig->blockScanCount;
+
+  vrefCalMilliVolt = VREFINT_CAL_MILLIVOLT * getVrefintCal();
+  scaleVref = 0;
+
+  adcAcqUtilResetStats();
 
   err = allocateBuffers(chanCount);
   if(err < 0)
@@ -416,6 +912,188 @@ int adcAcqUtilInitAdc(AdcConfig_t *adcConfig)
   return err;
 }
 
+int adcAcqUtilConfigFilter(void)
+{
+  int err;
+  int32_t tau;
+  int32_t order;
+
+  for(size_t i = 0; i < chanCount; ++i)
+  {
+    tau = filterTaus[i] == FILTER_SETTING_DEFAULT ? config.filterTau : filterTaus[i];
+    order = filterOrders[i] == FILTER_SETTING_DEFAULT ? (int32_t)config.filterOrder : filterOrders[i];
+
+    err = adcAcqFilterConfigChannel(i, tau, order);
+    if(err < 0)
+    {
+      LOG_ERR("ERROR %d: unable to configure the channel %d filter", err, i);
+      return err;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief   Get the size of a subscription data pool block.
+ *
+ * @return  The block size.
+ */
+static inline size_t getPayloadBlockSize(void)
+{
+  size_t blockSize = sizeof(SrvMsgPayload_t) + (chanCount * sizeof(float));
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+  blockSize += sizeof(AdcPayloadHeader_t);
+#endif
+
+  return blockSize;
+}
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+/**
+ * @brief   Get the header of a shared payload.
+ *
+ * @param[in]   payload: The payload.
+ *
+ * @return  The payload header.
+ */
+static inline AdcPayloadHeader_t *getPayloadHeader(SrvMsgPayload_t *payload)
+{
+  return (AdcPayloadHeader_t *)payload - 1;
+}
+#endif
+
+/**
+ * @brief   Allocate a subscription payload.
+ *
+ * @note    A shared payload starts with the notifier reference, released once
+ *          all the subscribers of the notification are called. Its pool ID is
+ *          NULL so it can only be released with adcAcqUtilReleaseData().
+ *
+ * @return  The payload if successful, NULL otherwise.
+ */
+static SrvMsgPayload_t *allocPayload(void)
+{
+  SrvMsgPayload_t *payload;
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+  AdcPayloadHeader_t *header;
+
+  header = (AdcPayloadHeader_t *)osMemoryPoolAlloc(subDataPool, 0);
+  if(!header)
+    return NULL;
+
+  atomic_set(&header->refCount, 1);
+  payload = (SrvMsgPayload_t *)(header + 1);
+  payload->poolId = NULL;
+#else
+  payload = (SrvMsgPayload_t *)osMemoryPoolAlloc(subDataPool, 0);
+  if(!payload)
+    return NULL;
+
+  payload->poolId = subDataPool;
+#endif
+
+  return payload;
+}
+
+/**
+ * @brief   Fill a payload with the values of the channels of a mask.
+ *
+ * @param[out]  payload: The payload.
+ * @param[in]   chanMask: The channel mask.
+ * @param[in]   format: The payload data format.
+ */
+static inline void fillPayload(SrvMsgPayload_t *payload, uint32_t chanMask, AdcDataFormat_t format)
+{
+  size_t valueCount = 0;
+  float *values = (float *)payload->data;
+  int32_t *milliVolts = (int32_t *)payload->data;
+
+  for(size_t i = 0; i < chanCount; ++i)
+  {
+    if(!(chanMask & BIT(i)))
+      continue;
+
+    if(format == ADC_ACQ_FORMAT_MILLIVOLT)
+      milliVolts[valueCount++] = milliVoltValues[i];
+    else
+      values[valueCount++] = voltValues[i];
+  }
+
+  /* Both formats hold 32-bit values */
+  payload->dataLen = valueCount * sizeof(float);
+}
+
+/**
+ * @brief   Clear the payloads delivered at the previous notification.
+ */
+static inline void clearTickPayloads(void)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+  for(size_t i = 0; i < subConfig.activeSubCount; ++i)
+    subscriptions[i].tickPayload = NULL;
+#endif
+}
+
+/**
+ * @brief   Get the payload already filled at this notification for the
+ *          channels of a subscription.
+ *
+ * @param[in]   subIdx: The subscription index.
+ *
+ * @return  The shared payload if any, NULL otherwise.
+ */
+static inline SrvMsgPayload_t *getTickPayload(size_t subIdx)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+  for(size_t i = 0; i < subIdx; ++i)
+  {
+    if(subscriptions[i].tickPayload && subscriptions[i].chanMask == subscriptions[subIdx].chanMask &&
+       subscriptions[i].format == subscriptions[subIdx].format)
+      return subscriptions[i].tickPayload;
+  }
+#else
+  ARG_UNUSED(subIdx);
+#endif
+
+  return NULL;
+}
+
+/**
+ * @brief   Take the subscriber reference of a payload.
+ *
+ * @param[in]   subIdx: The subscription index.
+ * @param[in]   payload: The payload delivered to the subscription.
+ */
+static inline void holdTickPayload(size_t subIdx, SrvMsgPayload_t *payload)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+  subscriptions[subIdx].tickPayload = payload;
+  atomic_inc(&getPayloadHeader(payload)->refCount);
+#else
+  ARG_UNUSED(subIdx);
+  ARG_UNUSED(payload);
+#endif
+}
+
+/**
+ * @brief   Release the notifier reference of the payloads allocated at this
+ *          notification.
+ */
+static inline void releaseTickPayloads(void)
+{
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+  for(size_t i = 0; i < subConfig.activeSubCount; ++i)
+  {
+    /* The first subscription holding a payload allocated it */
+    if(subscriptions[i].tickPayload && !getTickPayload(i))
+      adcAcqUtilReleaseData(subscriptions[i].tickPayload);
+  }
+#endif
+}
+
 int adcAcqUtilInitSubscriptions(AdcSubConfig_t *adcSubConfig)
 {
   int err;
@@ -434,7 +1112,7 @@ int adcAcqUtilInitSubscriptions(AdcSubConfig_t *adcSubConfig)
   subConfig.activeSubCount = 0;
 
   /* Calculate memory pool parameters */
-  blockSize = sizeof(SrvMsgPayload_t) + (chanCount * sizeof(float));
+  blockSize = getPayloadBlockSize();
   blockCount = 2 * subConfig.maxSubCount;
 
   LOG_INF("attempting to create pool: chanCount=%zu, blockSize=%zu, blockCount=%zu",
@@ -483,77 +1161,178 @@ int adcAcqUtilStopTrigger(void)
   return err;
 }
 
-int adcAcqUtilProcessData(void)
+uint32_t adcAcqUtilGetDueChanMask(AdcDataFormat_t format)
+{
+  uint32_t chanMask = 0;
+
+  for(size_t i = 0; i < subConfig.activeSubCount; ++i)
+  {
+    if(!subscriptions[i].isPaused && subscriptions[i].countdown <= 1 && subscriptions[i].format == format)
+      chanMask |= subscriptions[i].chanMask;
+  }
+
+  return chanMask;
+}
+
+/**
+ * @brief   Convert the channels of a mask to volts.
+ *
+ * @param[in]   chanMask: The mask of the channels to convert.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int processVolt(uint32_t chanMask)
 {
   int err;
-  int32_t rawData;
-  int32_t rawVref;
   float vdd;
 
-  /* Read Vref from the configured vref channel index */
-  err = adcAcqFilterGetThirdOrderData(VREF_CHANNEL_INDEX, &rawVref);
+  /* Calculate real VDD from internal Vref reading */
+  err = getVdd(&vdd);
   if(err < 0)
-  {
-    LOG_ERR("ERROR %d: unable to get vref data from ADC", err);
     return err;
+
+  /* Convert the requested channels to voltage */
+  for(size_t i = 0; i < chanCount; ++i)
+  {
+    if(!(chanMask & BIT(i)))
+      continue;
+
+    err = convertChannel(i, vdd, voltValues + i);
+    if(err < 0)
+      return err;
   }
 
-  /* Calculate real VDD from internal Vref reading */
-  vdd = calculateVdd(rawVref);
+  return 0;
+}
 
-  /* Convert all channels to voltage */
-  for(size_t i = 0; i < ARRAY_SIZE(adcChannels); ++i)
+/**
+ * @brief   Convert the channels of a mask to millivolts.
+ *
+ * @param[in]   chanMask: The mask of the channels to convert.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int processMilliVolt(uint32_t chanMask)
+{
+  int err;
+
+  err = updateMilliVoltScale();
+  if(err < 0)
+    return err;
+
+  for(size_t i = 0; i < chanCount; ++i)
   {
-    err = adcAcqFilterGetThirdOrderData(i, &rawData);
+    if(!(chanMask & BIT(i)))
+      continue;
+
+    err = convertChannelMilliVolt(i, milliVoltValues + i);
     if(err < 0)
       return err;
-
-    voltValues[i] = ((float)rawData * vdd) / ADC_FULL_RANGE_VALUE;
   }
 
   return 0;
 }
 
+int adcAcqUtilProcessData(uint32_t voltMask, uint32_t milliVoltMask)
+{
+  int err = 0;
+
+  voltMask &= getAllChanMask();
+  milliVoltMask &= getAllChanMask();
+
+  SRV_TRACE_BEGIN(ADC_PROCESS, voltMask | milliVoltMask);
+
+  if(voltMask)
+    err = processVolt(voltMask);
+
+  if(err == 0 && milliVoltMask)
+    err = processMilliVolt(milliVoltMask);
+
+  SRV_TRACE_END(ADC_PROCESS, voltMask | milliVoltMask);
+
+  return err;
+}
+
 int adcAcqUtilNotifySubscribers(void)
 {
   int err;
   SrvMsgPayload_t *payload;
 
+  SRV_TRACE_BEGIN(ADC_NOTIFY, subConfig.activeSubCount);
+
+  clearTickPayloads();
+
   for(size_t i = 0; i < subConfig.activeSubCount; ++i)
   {
     if(!subscriptions[i].isPaused)
     {
-      /* Allocate buffer from pool */
-      payload = (SrvMsgPayload_t *)osMemoryPoolAlloc(subDataPool, 0);
-      if(payload == NULL)
+      /* Wait for the subscription output period */
+      if(subscriptions[i].countdown > 1)
       {
-        err = -ENOSPC;
-        LOG_ERR("ERROR %d: pool allocation failed for subscription %d", err, i);
+        --subscriptions[i].countdown;
         continue;
       }
 
-      /* Fill in data */
-      payload->poolId = subDataPool;
-      payload->dataLen = chanCount * sizeof(float);
-      memcpy(payload->data, voltValues, chanCount * sizeof(float));
+      subscriptions[i].countdown = subscriptions[i].decimation;
+
+      /* Share the payload of a previous subscription with the same channels */
+      payload = getTickPayload(i);
+      if(!payload)
+      {
+        /* Allocate buffer from pool */
+        payload = allocPayload();
+        if(payload == NULL)
+        {
+          err = -ENOSPC;
+          LOG_ERR("ERROR %d: pool allocation failed for subscription %d", err, i);
+          continue;
+        }
+
+        /* Fill in the subscribed channels only */
+        fillPayload(payload, subscriptions[i].chanMask, subscriptions[i].format);
+      }
+
+      holdTickPayload(i, payload);
 
       /* Call subscriber callback */
       err = subscriptions[i].callback(payload);
       if(err < 0)
       {
         LOG_ERR("ERROR %d: callback failed for subscription %d", err, i);
-        /* Free the buffer since callback failed */
-        osMemoryPoolFree(subDataPool, payload);
+        /* Release the buffer since callback failed */
+        adcAcqUtilReleaseData(payload);
       }
     }
   }
 
+  releaseTickPayloads();
+
+  SRV_TRACE_END(ADC_NOTIFY, subConfig.activeSubCount);
+
   return 0;
 }
 
-int adcAcqUtilAddSubscription(AdcSubCallback_t callback)
+void adcAcqUtilReleaseData(SrvMsgPayload_t *data)
+{
+  if(!data)
+    return;
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD
+  AdcPayloadHeader_t *header = getPayloadHeader(data);
+
+  if(atomic_dec(&header->refCount) == 1)
+    osMemoryPoolFree(subDataPool, header);
+#else
+  osMemoryPoolFree(data->poolId, data);
+#endif
+}
+
+int adcAcqUtilAddSubscription(AdcSubCallback_t callback, const AdcSubOptions_t *options)
 {
   int err;
+  uint32_t chanMask = getAllChanMask();
+  uint32_t decimation = 1;
+  AdcDataFormat_t format = ADC_ACQ_FORMAT_VOLT;
 
   if(subConfig.activeSubCount + 1 >= subConfig.maxSubCount)
   {
@@ -562,8 +1341,35 @@ int adcAcqUtilAddSubscription(AdcSubCallback_t callback)
     return err;
   }
 
+  if(options)
+  {
+    chanMask &= options->chanMask;
+    if(chanMask == 0)
+    {
+      err = -EINVAL;
+      LOG_ERR("ERROR %d: no valid channel in the subscription mask 0x%08x", err, options->chanMask);
+      return err;
+    }
+
+    if(options->format >= ADC_ACQ_FORMAT_COUNT)
+    {
+      err = -EINVAL;
+      LOG_ERR("ERROR %d: invalid subscription format %d", err, options->format);
+      return err;
+    }
+
+    if(subConfig.notificationRate > 0)
+      decimation = MAX(1, DIV_ROUND_UP(options->periodMs, subConfig.notificationRate));
+
+    format = options->format;
+  }
+
   subscriptions[subConfig.activeSubCount].callback = callback;
   subscriptions[subConfig.activeSubCount].isPaused = false;
+  subscriptions[subConfig.activeSubCount].chanMask = chanMask;
+  subscriptions[subConfig.activeSubCount].decimation = decimation;
+  subscriptions[subConfig.activeSubCount].countdown = 1;
+  subscriptions[subConfig.activeSubCount].format = format;
 
   ++subConfig.activeSubCount;
 
@@ -624,6 +1430,11 @@ size_t adcAcqUtilGetChanCount(void)
   return chanCount;
 }
 
+size_t adcAcqUtilGetGroupCount(void)
+{
+  return groupCount;
+}
+
 int adcAcqUtilGetRaw(size_t chanId, uint32_t *rawVal)
 {
   int err = 0;
@@ -652,6 +1463,7 @@ int adcAcqUtilGetRaw(size_t chanId, uint32_t *rawVal)
 int adcAcqUtilGetVolt(size_t chanId, float *voltVal)
 {
   int err = 0;
+  float vdd;
 
   if(chanId >= chanCount)
   {
@@ -667,9 +1479,68 @@ int adcAcqUtilGetVolt(size_t chanId, float *voltVal)
     return err;
   }
 
-  *voltVal = voltValues[chanId];
+  err = getVdd(&vdd);
+  if(err < 0)
+    return err;
+
+  err = convertChannel(chanId, vdd, voltVal);
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to get the volt value of channel %d", err, chanId);
 
   return err;
 }
 
+int adcAcqUtilGetStats(AdcAcqStats_t *stats)
+{
+  int err;
+
+  if(!stats)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid statistics buffer", err);
+    return err;
+  }
+
+  memset(stats, 0, sizeof(*stats));
+
+  stats->elapsedMs = k_uptime_get() - adcStats.resetMs;
+  stats->triggerCount = (uint32_t)atomic_get(&adcStats.triggerCount);
+  stats->overrunCount = (uint32_t)atomic_get(&adcStats.overrunCount);
+  stats->startErrorCount = (uint32_t)atomic_get(&adcStats.startErrorCount);
+  stats->filterErrorCount = (uint32_t)atomic_get(&adcStats.filterErrorCount);
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING
+  stats->blockCount = (uint32_t)atomic_get(&adcStats.blockCount);
+  stats->convTimeMaxUs = (uint32_t)atomic_get(&adcStats.convTimeMaxUs);
+  stats->latencyMaxUs = (uint32_t)atomic_get(&adcStats.latencyMaxUs);
+
+  /* The minimums hold their reset value until the first timed block */
+  if(stats->blockCount > 0)
+  {
+    stats->convTimeMinUs = (uint32_t)atomic_get(&adcStats.convTimeMinUs);
+    stats->latencyMinUs = (uint32_t)atomic_get(&adcStats.latencyMinUs);
+  }
+#endif
+
+  return 0;
+}
+
+void adcAcqUtilResetStats(void)
+{
+  atomic_clear(&adcStats.triggerCount);
+  atomic_clear(&adcStats.overrunCount);
+  atomic_clear(&adcStats.startErrorCount);
+  atomic_clear(&adcStats.filterErrorCount);
+
+#ifdef CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING
+  atomic_clear(&adcStats.blockCount);
+  atomic_set(&adcStats.convTimeMinUs, (atomic_val_t)UINT32_MAX);
+  atomic_clear(&adcStats.convTimeMaxUs);
+  atomic_set(&adcStats.latencyMinUs, (atomic_val_t)UINT32_MAX);
+  atomic_clear(&adcStats.latencyMaxUs);
+#endif
+
+  adcStats.resetMs = k_uptime_get();
+}
+
 /** @} */
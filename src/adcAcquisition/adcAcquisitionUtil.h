@@ -35,6 +35,18 @@
  */
 int adcAcqUtilInitAdc(AdcConfig_t *adcConfig);
 
+/**
+ * @brief   Configure the filter of each channel.
+ *
+ * @note    The tau and order of each channel come from the devicetree
+ *          filter-taus and filter-orders properties, indexed as io-channels.
+ *          A channel missing from these properties uses the configured
+ *          default. The filter must be initialized first.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int adcAcqUtilConfigFilter(void);
+
 /**
  * @brief   Initialize the ADC subscriptions.
  *
@@ -58,31 +70,63 @@ int adcAcqUtilStartTrigger(void);
  */
 int adcAcqUtilStopTrigger(void);
 
+/**
+ * @brief   Get the channels of the subscriptions due at this notification.
+ *
+ * @param[in]   format: The subscription data format.
+ *
+ * @return  The mask of the channels to process in this format.
+ */
+uint32_t adcAcqUtilGetDueChanMask(AdcDataFormat_t format);
+
 /**
  * @brief   Process the acquired data.
  *
+ * @note    Only the channels of the masks are converted, nothing is done for
+ *          empty masks. The millivolt conversion is done in fixed-point, the
+ *          VDD scale being refreshed only when the Vref reading moves.
+ *
+ * @param[in]   voltMask: The mask of the channels to convert to volts.
+ * @param[in]   milliVoltMask: The mask of the channels to convert to millivolts.
+ *
  * @return  0 if successful, the error code otherwise.
  */
-int adcAcqUtilProcessData(void);
+int adcAcqUtilProcessData(uint32_t voltMask, uint32_t milliVoltMask);
 
 /**
  * @brief   Notify the active subscribers.
  *
- *          Errors from pool allocation or subscriber callbacks are logged and
- *          skipped; notification continues for remaining subscribers.
+ *          Only the subscribers due at this notification are notified, each
+ *          with its subscribed channels. Errors from pool allocation or
+ *          subscriber callbacks are logged and skipped; notification continues
+ *          for remaining subscribers.
  *
  * @return  Always returns 0.
  */
 int adcAcqUtilNotifySubscribers(void);
 
+/**
+ * @brief   Release a subscription payload.
+ *
+ * @note    With CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD, the payload is
+ *          freed once its last reference is released.
+ *
+ * @param[in]   data: The subscription payload.
+ */
+void adcAcqUtilReleaseData(SrvMsgPayload_t *data);
+
 /**
  * @brief   Add a new subscription.
  *
  * @param[in]   callback: The subscription callback.
+ * @param[in]   options: The subscription options, NULL for all the channels at
+ *                       each notification.
  *
- * @return  0 if successful, -ENOSPC if the maximum subscription count is reached.
+ * @return  0 if successful, -ENOSPC if the maximum subscription count is reached,
+ *          -EINVAL if the channel mask holds no valid channel or the format is
+ *          unknown.
  */
-int adcAcqUtilAddSubscription(AdcSubCallback_t callback);
+int adcAcqUtilAddSubscription(AdcSubCallback_t callback, const AdcSubOptions_t *options);
 
 /**
  * @brief   Remove a subscription.
@@ -110,6 +154,16 @@ int adcAcqUtilSetSubPauseState(AdcSubCallback_t callback, bool isPaused);
  */
 size_t adcAcqUtilGetChanCount(void);
 
+/**
+ * @brief   Get the ADC controller group count.
+ *
+ * @note    The channels are grouped per ADC controller, each group running
+ *          its own sequence.
+ *
+ * @return  The ADC controller group count.
+ */
+size_t adcAcqUtilGetGroupCount(void);
+
 /**
  * @brief   Get the raw value of a channel.
  *
@@ -126,10 +180,27 @@ int adcAcqUtilGetRaw(size_t chanId, uint32_t *rawVal);
  * @param[in]   chanId: The channel ID.
  * @param[out]  voltVal: The volt value pointer.
  *
- * @return  0 if successful, -EINVAL if chanId is out of range or voltVal is NULL.
+ * @note    The value is converted from the current filter output.
+ *
+ * @return  0 if successful, -EINVAL if chanId is out of range or voltVal is NULL,
+ *          the filter error code otherwise.
  */
 int adcAcqUtilGetVolt(size_t chanId, float *voltVal);
 
+/**
+ * @brief   Get the ADC acquisition statistics.
+ *
+ * @param[out]  stats: The ADC acquisition statistics.
+ *
+ * @return  0 if successful, -EINVAL if stats is NULL.
+ */
+int adcAcqUtilGetStats(AdcAcqStats_t *stats);
+
+/**
+ * @brief   Reset the ADC acquisition statistics.
+ */
+void adcAcqUtilResetStats(void);
+
 #endif    /* ADC_ACQUISITION_UTIL */
 
 /** @} */
@@ -0,0 +1,196 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      adcAcquisitionWindow.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     ADC Acquisition Window Comparator
+ *
+ *            ADC acquisition window comparator implementation. The windows
+ *            are compared from the ADC sequence callback, a channel window
+ *            being disabled while the thread updates it.
+ *
+ * @ingroup   adc-acquisition
+ * @{
+ */
+
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+
+#include "adcAcquisitionWindow.h"
+#include "adcAcquisitionFilter.h"
+#include "adcAcquisitionUtil.h"
+
+/* Setting module logging */
+LOG_MODULE_DECLARE(ADC_AQC_SERVICE_NAME);
+
+/**
+ * @brief   The channel window state.
+ */
+typedef struct
+{
+  AdcWindow_t config;                   /**< The window configuration. */
+  AdcWindowZone_t zone;                 /**< The current zone. */
+  atomic_t isEnabled;                   /**< The window enabled flag. */
+}
+AdcWindowState_t;
+
+/**
+ * @brief   The channel windows.
+ */
+static AdcWindowState_t *windows = NULL;
+
+/**
+ * @brief   The window channel count.
+ */
+static size_t windowCount = 0;
+
+/**
+ * @brief   Get the next zone of a channel.
+ *
+ * @note    A channel out of the window must come back hysteresis counts
+ *          inside to reenter it, but can cross to the other side directly.
+ *
+ * @param[in]   window: The channel window state.
+ * @param[in]   value: The channel filtered value.
+ *
+ * @return  The next zone of the channel.
+ */
+static inline AdcWindowZone_t getNextZone(const AdcWindowState_t *window, int32_t value)
+{
+  const AdcWindow_t *config = &window->config;
+
+  if(value < config->lowThreshold)
+    return ADC_WINDOW_BELOW;
+
+  if(value > config->highThreshold)
+    return ADC_WINDOW_ABOVE;
+
+  if(window->zone == ADC_WINDOW_BELOW && value < config->lowThreshold + config->hysteresis)
+    return ADC_WINDOW_BELOW;
+
+  if(window->zone == ADC_WINDOW_ABOVE && value > config->highThreshold - config->hysteresis)
+    return ADC_WINDOW_ABOVE;
+
+  return ADC_WINDOW_INSIDE;
+}
+
+int adcAcqWindowInit(size_t chanCount)
+{
+  int err;
+
+  windowCount = chanCount;
+
+  windows = k_malloc(windowCount * sizeof(AdcWindowState_t));
+  if(!windows)
+  {
+    err = -ENOSPC;
+    LOG_ERR("ERROR %d: unable to allocate the window buffer", err);
+    return err;
+  }
+
+  for(size_t i = 0; i < windowCount; ++i)
+    atomic_clear(&windows[i].isEnabled);
+
+  return 0;
+}
+
+int adcAcqWindowSet(size_t chanId, const AdcWindow_t *window)
+{
+  int err;
+
+  if(!windows)
+    return -ENODEV;
+
+  if(chanId >= windowCount)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid channel ID %d", err, chanId);
+    return err;
+  }
+
+  if(!window || !window->callback || window->lowThreshold > window->highThreshold ||
+     window->hysteresis < 0)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid window of channel %d", err, chanId);
+    return err;
+  }
+
+  /* The sequence callback skips the channel until it is enabled again */
+  atomic_clear(&windows[chanId].isEnabled);
+
+  windows[chanId].config = *window;
+  windows[chanId].zone = ADC_WINDOW_INSIDE;
+
+  atomic_set(&windows[chanId].isEnabled, 1);
+
+  return 0;
+}
+
+int adcAcqWindowClear(size_t chanId)
+{
+  int err;
+
+  if(!windows)
+    return -ENODEV;
+
+  if(chanId >= windowCount)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid channel ID %d", err, chanId);
+    return err;
+  }
+
+  atomic_clear(&windows[chanId].isEnabled);
+
+  return 0;
+}
+
+int adcAcqWindowGetZone(size_t chanId, AdcWindowZone_t *zone)
+{
+  int err;
+
+  if(!windows)
+    return -ENODEV;
+
+  if(chanId >= windowCount || !zone)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid channel ID %d or NULL zone", err, chanId);
+    return err;
+  }
+
+  if(!atomic_get(&windows[chanId].isEnabled))
+    return -ENOENT;
+
+  *zone = windows[chanId].zone;
+
+  return 0;
+}
+
+void adcAcqWindowCheckRange(size_t firstChan, size_t rangeCount)
+{
+  int32_t value;
+  AdcWindowZone_t zone;
+
+  if(!windows || firstChan + rangeCount > windowCount)
+    return;
+
+  for(size_t i = firstChan; i < firstChan + rangeCount; ++i)
+  {
+    AdcWindowState_t *window = windows + i;
+
+    if(!atomic_get(&window->isEnabled) || adcAcqFilterGetThirdOrderData(i, &value) < 0)
+      continue;
+
+    zone = getNextZone(window, value);
+    if(zone != window->zone)
+    {
+      window->zone = zone;
+      window->config.callback(i, zone, value);
+    }
+  }
+}
+
+/** @} */
@@ -0,0 +1,123 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      adcAcquisitionWindow.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     ADC Acquisition Service Window Comparator.
+ *
+ *            ADC acquisition window comparator API. The filtered data of the
+ *            channels with a window are compared to their thresholds after
+ *            each block, a zone change firing the window callback right away
+ *            instead of waiting for the subscription notification.
+ *
+ * @ingroup   adc-acquisition
+ *
+ * @{
+ */
+
+#ifndef ADC_ACQ_WINDOW
+#define ADC_ACQ_WINDOW
+
+#include <zephyr/kernel.h>
+
+/**
+ * @brief   The window zones.
+ */
+typedef enum
+{
+  ADC_WINDOW_INSIDE = 0,                /**< Between the low and high thresholds. */
+  ADC_WINDOW_BELOW,                     /**< Below the low threshold. */
+  ADC_WINDOW_ABOVE,                     /**< Above the high threshold. */
+} AdcWindowZone_t;
+
+/**
+ * @brief   The window callback type.
+ *
+ * @note    Called from the ADC interrupt context on each zone change, it must
+ *          not block; signal a thread (semaphore, event, work) for anything
+ *          longer than a few instructions.
+ *
+ * @param[in]   chanId: The channel ID.
+ * @param[in]   zone: The new zone of the channel.
+ * @param[in]   value: The filtered value crossing the threshold [raw counts].
+ */
+typedef void (*AdcWindowCallback_t)(size_t chanId, AdcWindowZone_t zone, int32_t value);
+
+/**
+ * @brief   The window configuration.
+ *
+ * @note    The thresholds are compared to the filtered data in raw counts. A
+ *          channel leaves the window below lowThreshold or above
+ *          highThreshold, and comes back once hysteresis counts inside.
+ */
+typedef struct
+{
+  int32_t lowThreshold;                 /**< The low threshold [raw counts]. */
+  int32_t highThreshold;                /**< The high threshold [raw counts]. */
+  int32_t hysteresis;                   /**< The hysteresis to reenter the window [raw counts]. */
+  AdcWindowCallback_t callback;         /**< The zone change callback. */
+} AdcWindow_t;
+
+/**
+ * @brief   Initialize the window comparator.
+ *
+ * @note    Every channel starts without window.
+ *
+ * @param[in]   chanCount: The channel count.
+ *
+ * @return  0 if successful, -ENOSPC if the window buffer allocation fails.
+ */
+int adcAcqWindowInit(size_t chanCount);
+
+/**
+ * @brief   Set the window of a channel.
+ *
+ * @note    The channel restarts inside the window, a channel already out of
+ *          it fires its callback after the next block.
+ *
+ * @param[in]   chanId: The channel ID.
+ * @param[in]   window: The window configuration.
+ *
+ * @return  0 if successful, -ENODEV if the comparator is not initialized,
+ *          -EINVAL if window is NULL, has no callback, its thresholds are
+ *          inverted, its hysteresis is negative or chanId is out of range.
+ */
+int adcAcqWindowSet(size_t chanId, const AdcWindow_t *window);
+
+/**
+ * @brief   Clear the window of a channel.
+ *
+ * @param[in]   chanId: The channel ID.
+ *
+ * @return  0 if successful, -ENODEV if the comparator is not initialized,
+ *          -EINVAL if chanId is out of range.
+ */
+int adcAcqWindowClear(size_t chanId);
+
+/**
+ * @brief   Get the window zone of a channel.
+ *
+ * @param[in]   chanId: The channel ID.
+ * @param[out]  zone: The current zone of the channel.
+ *
+ * @return  0 if successful, -ENODEV if the comparator is not initialized,
+ *          -EINVAL if zone is NULL or chanId is out of range, -ENOENT if the
+ *          channel has no window.
+ */
+int adcAcqWindowGetZone(size_t chanId, AdcWindowZone_t *zone);
+
+/**
+ * @brief   Compare the filtered data of a channel range to their windows.
+ *
+ * @note    Called from the ADC sequence callback once the block of the range
+ *          is filtered, only the channels with a window are compared.
+ *
+ * @param[in]   firstChan: The ID of the first channel of the range.
+ * @param[in]   rangeCount: The channel count of the range.
+ */
+void adcAcqWindowCheckRange(size_t firstChan, size_t rangeCount);
+
+#endif    /* ADC_ACQ_WINDOW */
+
+/** @} */
@@ -18,6 +18,23 @@
 #include "datastore.h"
 #include "datastoreUtil.h"
 #include "serviceManager.h"
+#include "srvTrace.h"
+
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+#include "datastoreNvm.h"
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_ADC_BRIDGE
+#include "datastoreAdcBridge.h"
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_HISTORY
+#include "datastoreHistory.h"
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_REPLICATION
+#include "datastoreReplication.h"
+#endif
 
 /* Setting module logging */
 LOG_MODULE_REGISTER(DATASTORE_LOGGER_NAME, CONFIG_ENYA_DATASTORE_LOG_LEVEL);
@@ -34,9 +51,63 @@ LOG_MODULE_REGISTER(DATASTORE_LOGGER_NAME, CONFIG_ENYA_DATASTORE_LOG_LEVEL);
 #define DATASTORE_RESPONSE_TIMEOUT                              (5)
 
 /**
- * @brief   The datastore buffer count.
+ * @brief   The datastore request buffer size of a value count.
+ */
+#define DATASTORE_BUFFER_SIZE(valCount)                         (sizeof(DatastoreRequestBuffer_t) + \
+                                                                 (valCount) * sizeof(Data_t))
+
+/**
+ * @brief   The datastore notification buffer pool.
+ */
+#define DATASTORE_NOTIFY_POOL                                   (bufferPools[DATASTORE_POOL_NOTIFY].id)
+
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+/**
+ * @brief   The reads require a response queue.
+ * @note    The direct read does not use it, a collided read without one is
+ *          left to its caller.
+ */
+#define DATASTORE_READ_RESPONSE_REQUIRED                        (false)
+#else
+/**
+ * @brief   The reads require a response queue.
+ */
+#define DATASTORE_READ_RESPONSE_REQUIRED                        (true)
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+/**
+ * @brief   The datastore batch buffer count.
+ */
+#define DATASTORE_BATCH_BUFFER_COUNT                            (2)
+
+/**
+ * @brief   The datastore batch buffer size.
+ */
+#define DATASTORE_BATCH_BUFFER_SIZE                             (sizeof(DatastoreRequestBuffer_t) + \
+                                                                 CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS * \
+                                                                 sizeof(DatastoreBatchOpHeader_t) + \
+                                                                 CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES * \
+                                                                 sizeof(Data_t))
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+/**
+ * @brief   The datastore control message count.
+ * @note    A stop and a suspend message.
+ */
+#define DATASTORE_CTRL_MSG_COUNT                                (2)
+
+/**
+ * @brief   The datastore control queue.
  */
-#define DATASTORE_BUFFER_COUNT                                  (10)
+#define DATASTORE_CONTROL_QUEUE                                 (&datastoreCtrlQueue)
+#else
+/**
+ * @brief   The datastore control queue.
+ */
+#define DATASTORE_CONTROL_QUEUE                                 (&datastoreQueue)
+#endif
 
 /**
  * @brief The thread stack.
@@ -50,6 +121,9 @@ typedef enum
 {
   DATASTORE_READ = 0,
   DATASTORE_WRITE,
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+  DATASTORE_BATCH,
+#endif
   DATASTORE_STOP,
   DATASTORE_SUSPEND,
   DATASTORE_MSG_TYPE_COUNT,
@@ -66,23 +140,462 @@ typedef struct
   size_t valCount;
   SrvMsgPayload_t *payload;
   struct k_msgq *response;
+#ifdef CONFIG_ENYA_DATASTORE_ASYNC
+  Data_t *values;
+  DatastoreDoneCb_t done;
+  void *userData;
+#endif
 } DatastoreMsg_t;
 
+/**
+ * @brief   The request buffer state.
+ */
+typedef enum
+{
+  DATASTORE_REQUEST_PENDING = 0,
+  DATASTORE_REQUEST_DONE,
+  DATASTORE_REQUEST_ABANDONED,
+} DatastoreRequestState_t;
+
+/**
+ * @brief   The request buffer.
+ * @note    The state decides who frees a buffer waited on by its caller. The
+ *          caller frees it once the request is done, the datastore thread
+ *          frees it when the caller gave up waiting.
+ */
+typedef struct
+{
+  atomic_t state;
+  SrvMsgPayload_t payload;
+} DatastoreRequestBuffer_t;
+
 /**
  * @brief   The service thread.
  */
 static struct k_thread thread;
 
+/**
+ * @brief   The service manager handle of the datastore service.
+ */
+static ServiceHandle_t serviceHandle;
+
 /**
  * @brief   The datastore buffer pool.
  */
-static osMemoryPoolId_t bufferPool = NULL;
+typedef struct
+{
+  osMemoryPoolId_t id;
+  uint32_t blockCount;
+  size_t blockSize;
+  size_t valCount;
+  atomic_t highWater;
+} DatastoreBufferPool_t;
+
+/**
+ * @brief   The datastore buffer pools.
+ * @note    The request pools are ordered by size, the large and notification
+ *          blocks are sized at init for the largest datapoint range.
+ */
+static DatastoreBufferPool_t bufferPools[DATASTORE_POOL_COUNT] = {
+  [DATASTORE_POOL_SMALL] = {.id = NULL, .blockCount = CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT,
+                            .blockSize = DATASTORE_BUFFER_SIZE(CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES),
+                            .valCount = CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES},
+  [DATASTORE_POOL_MEDIUM] = {.id = NULL, .blockCount = CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_COUNT,
+                             .blockSize = DATASTORE_BUFFER_SIZE(CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES),
+                             .valCount = CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES},
+  [DATASTORE_POOL_LARGE] = {.id = NULL, .blockCount = CONFIG_ENYA_DATASTORE_LARGE_BUFFER_COUNT,
+                            .blockSize = 0, .valCount = SIZE_MAX},
+  [DATASTORE_POOL_NOTIFY] = {.id = NULL, .blockCount = CONFIG_ENYA_DATASTORE_NOTIFY_BUFFER_COUNT,
+                             .blockSize = 0, .valCount = SIZE_MAX},
+};
+
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+/**
+ * @brief   The datastore batch buffer pool.
+ */
+static osMemoryPoolId_t batchPool = NULL;
+#endif
 
 /**
  * @brief   The datastore message queue.
+ * @note    The real-time lane when the priority lanes are enabled.
  */
 K_MSGQ_DEFINE(datastoreQueue, sizeof(DatastoreMsg_t), DATASTORE_MSG_COUNT, 4);
 
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+/**
+ * @brief   The datastore queue lane.
+ */
+typedef enum
+{
+  DATASTORE_LANE_CONTROL = 0,
+  DATASTORE_LANE_REALTIME,
+  DATASTORE_LANE_BACKGROUND,
+  DATASTORE_LANE_COUNT,
+} DatastoreLane_t;
+
+/**
+ * @brief   The datastore background request queue.
+ */
+K_MSGQ_DEFINE(datastoreBgQueue, sizeof(DatastoreMsg_t), CONFIG_ENYA_DATASTORE_BACKGROUND_MSG_COUNT, 4);
+
+/**
+ * @brief   The datastore control queue.
+ */
+K_MSGQ_DEFINE(datastoreCtrlQueue, sizeof(DatastoreMsg_t), DATASTORE_CTRL_MSG_COUNT, 4);
+
+/**
+ * @brief   The datastore queue of each lane, in service order.
+ */
+static struct k_msgq *const laneQueues[DATASTORE_LANE_COUNT] = {
+  [DATASTORE_LANE_CONTROL] = &datastoreCtrlQueue,
+  [DATASTORE_LANE_REALTIME] = &datastoreQueue,
+  [DATASTORE_LANE_BACKGROUND] = &datastoreBgQueue,
+};
+
+/**
+ * @brief   The poll event of each lane, waking the datastore thread.
+ */
+static struct k_poll_event laneEvents[DATASTORE_LANE_COUNT] = {
+  [DATASTORE_LANE_CONTROL] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+                                                             &datastoreCtrlQueue, 0),
+  [DATASTORE_LANE_REALTIME] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+                                                              &datastoreQueue, 0),
+  [DATASTORE_LANE_BACKGROUND] = K_POLL_EVENT_STATIC_INITIALIZER(K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+                                                                K_POLL_MODE_NOTIFY_ONLY, &datastoreBgQueue, 0),
+};
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+/**
+ * @brief   The datastore statistics counters.
+ * @note    Only the datastore thread updates the queue high water and the
+ *          service time, the response timeouts are counted by the callers.
+ */
+typedef struct
+{
+  atomic_t queueHighWater;
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+  atomic_t bgQueueHighWater;
+#endif
+  atomic_t opCount;
+  atomic_t serviceTimeMaxUs;
+  atomic_t serviceTimeHist[DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT];
+  atomic_t responseTimeouts;
+  int64_t resetMs;
+} DatastoreStatsCounters_t;
+
+/**
+ * @brief   The datastore statistics.
+ */
+static DatastoreStatsCounters_t datastoreStats;
+#endif
+
+/**
+ * @brief   Record the request queue depth of a dequeued request.
+ *
+ * @note    The depth only drops when the datastore thread dequeues, so the
+ *          depth seen right before a dequeue is the peak since the previous one.
+ *
+ * @param[in]   queue: The queue of the request.
+ */
+static inline void recordQueueDepth(struct k_msgq *queue)
+{
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+  atomic_t *highWater = &datastoreStats.queueHighWater;
+  atomic_val_t depth = k_msgq_num_used_get(queue) + 1;
+
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+  if(queue == &datastoreCtrlQueue)
+    return;
+
+  if(queue == &datastoreBgQueue)
+    highWater = &datastoreStats.bgQueueHighWater;
+#endif
+
+  if(depth > atomic_get(highWater))
+    atomic_set(highWater, depth);
+#else
+  ARG_UNUSED(queue);
+#endif
+}
+
+/**
+ * @brief   Get the start of an operation service time.
+ *
+ * @return  The cycle count.
+ */
+static inline uint32_t getServiceStart(void)
+{
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+  return k_cycle_get_32();
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief   Record an operation service time.
+ *
+ * @param[in]   start: The service start cycle count.
+ */
+static inline void recordServiceTime(uint32_t start)
+{
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+  uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+  uint32_t bucket = MIN(find_msb_set(us), DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT - 1);
+
+  atomic_inc(datastoreStats.serviceTimeHist + bucket);
+  atomic_inc(&datastoreStats.opCount);
+
+  if(us > (uint32_t)atomic_get(&datastoreStats.serviceTimeMaxUs))
+    atomic_set(&datastoreStats.serviceTimeMaxUs, us);
+#else
+  ARG_UNUSED(start);
+#endif
+}
+
+/**
+ * @brief   Record a request response timeout.
+ */
+static inline void recordResponseTimeout(void)
+{
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+  atomic_inc(&datastoreStats.responseTimeouts);
+#endif
+}
+
+/**
+ * @brief   Update the high water of a buffer pool.
+ *
+ * @param[in,out] pool: The buffer pool.
+ */
+static inline void updatePoolHighWater(DatastoreBufferPool_t *pool)
+{
+  atomic_val_t usedCount;
+  atomic_val_t highWater;
+
+  if(!pool->id)
+    return;
+
+  usedCount = osMemoryPoolGetCount(pool->id);
+
+  do
+  {
+    highWater = atomic_get(&pool->highWater);
+    if(usedCount <= highWater)
+      return;
+  } while(!atomic_cas(&pool->highWater, highWater, usedCount));
+}
+
+/**
+ * @brief   Allocate a request buffer from the smallest fitting pool.
+ *
+ * @note    A larger pool is used when the fitting ones are exhausted, only the
+ *          large pool allocation waits for a free block.
+ *
+ * @param[in]   valCount: The request value count.
+ *
+ * @return  The request buffer if successful, NULL otherwise.
+ */
+static SrvMsgPayload_t *allocRequestBuffer(size_t valCount)
+{
+  DatastoreRequestBuffer_t *request;
+  DatastoreBufferPool_t *pool;
+
+  for(uint32_t i = DATASTORE_POOL_SMALL; i <= DATASTORE_POOL_LARGE; ++i)
+  {
+    pool = bufferPools + i;
+    if(!pool->id || valCount > pool->valCount)
+      continue;
+
+    request = osMemoryPoolAlloc(pool->id, i == DATASTORE_POOL_LARGE ? DATASTORE_BUFFER_ALLOC_TIMEOUT : 0);
+    if(request)
+    {
+      atomic_set(&request->state, DATASTORE_REQUEST_PENDING);
+      request->payload.poolId = pool->id;
+      request->payload.dataLen = valCount * sizeof(Data_t);
+      updatePoolHighWater(pool);
+      return &request->payload;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Free a request buffer.
+ *
+ * @param[in]   payload: The request payload.
+ */
+static inline void freeRequestBuffer(SrvMsgPayload_t *payload)
+{
+  osMemoryPoolFree(payload->poolId, CONTAINER_OF(payload, DatastoreRequestBuffer_t, payload));
+}
+
+/**
+ * @brief   Mark a request waited on by its caller as done.
+ *
+ * @note    The buffer is freed here when the caller gave up waiting. Otherwise
+ *          it belongs to the caller from now on and must not be touched.
+ *
+ * @param[in]   payload: The request payload.
+ *
+ * @return  True if the caller is still waiting, false otherwise.
+ */
+static bool completeWaitedRequest(SrvMsgPayload_t *payload)
+{
+  DatastoreRequestBuffer_t *request = CONTAINER_OF(payload, DatastoreRequestBuffer_t, payload);
+
+  if(atomic_cas(&request->state, DATASTORE_REQUEST_PENDING, DATASTORE_REQUEST_DONE))
+    return true;
+
+  freeRequestBuffer(payload);
+  return false;
+}
+
+/**
+ * @brief   Wait for the response of a request.
+ *
+ * @note    On success, the caller owns the request buffer and must free it.
+ *          On failure, the buffer is already freed or left to the datastore
+ *          thread, which frees it once the request is processed.
+ *
+ * @param[in]   response: The response queue.
+ * @param[in]   payload: The request payload.
+ * @param[out]  resStatus: The request status.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int waitRequestResponse(struct k_msgq *response, SrvMsgPayload_t *payload, int *resStatus)
+{
+  int err;
+  DatastoreRequestBuffer_t *request = CONTAINER_OF(payload, DatastoreRequestBuffer_t, payload);
+
+  err = k_msgq_get(response, resStatus, K_MSEC(DATASTORE_RESPONSE_TIMEOUT));
+  if(err == 0)
+    return 0;
+
+  recordResponseTimeout();
+
+  if(atomic_cas(&request->state, DATASTORE_REQUEST_PENDING, DATASTORE_REQUEST_ABANDONED))
+  {
+    LOG_WRN("request timed out, leaving its buffer to the datastore thread");
+    return err;
+  }
+
+  /* The request is done and its response is on the way */
+  err = k_msgq_get(response, resStatus, K_MSEC(DATASTORE_RESPONSE_TIMEOUT));
+  if(err < 0)
+    freeRequestBuffer(payload);
+
+  return err;
+}
+
+/**
+ * @brief   Get the default request queue of the calling thread.
+ *
+ * @note    The *Background requests take the background lane explicitly.
+ *
+ * @return  The background lane for the threads of a priority value of at
+ *          least CONFIG_ENYA_DATASTORE_BACKGROUND_PRIORITY, the real-time
+ *          lane otherwise.
+ */
+static inline struct k_msgq *getRequestQueue(void)
+{
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+  if(!k_is_in_isr() && k_thread_priority_get(k_current_get()) >= CONFIG_ENYA_DATASTORE_BACKGROUND_PRIORITY)
+    return &datastoreBgQueue;
+#endif
+
+  return &datastoreQueue;
+}
+
+/**
+ * @brief   Submit a request to a request queue.
+ *
+ * @param[in]   queue: The request queue.
+ * @param[in]   msg: The request message.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static inline int submitRequest(struct k_msgq *queue, const DatastoreMsg_t *msg)
+{
+  SRV_TRACE_EVENT(DATASTORE_ENQUEUE, msg->msgType);
+
+  return k_msgq_put(queue, msg, K_NO_WAIT);
+}
+
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+/**
+ * @brief   Take the message of the highest priority lane not empty.
+ *
+ * @param[out]  msg: The message.
+ *
+ * @return  The queue of the message, NULL if every lane is empty.
+ */
+static struct k_msgq *takeLaneMessage(DatastoreMsg_t *msg)
+{
+  for(uint32_t i = 0; i < DATASTORE_LANE_COUNT; ++i)
+  {
+    if(k_msgq_get(laneQueues[i], msg, K_NO_WAIT) == 0)
+      return laneQueues[i];
+  }
+
+  return NULL;
+}
+#endif
+
+/**
+ * @brief   Wait for the next datastore message.
+ *
+ * @note    With the priority lanes, the control queue is served first, then
+ *          the real-time lane and the background lane last.
+ *
+ * @param[out]  msg: The message.
+ *
+ * @return  The queue of the message, NULL if none came before the timeout.
+ */
+static struct k_msgq *getNextMessage(DatastoreMsg_t *msg)
+{
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+  struct k_msgq *queue = takeLaneMessage(msg);
+
+  if(queue)
+    return queue;
+
+  for(uint32_t i = 0; i < DATASTORE_LANE_COUNT; ++i)
+    laneEvents[i].state = K_POLL_STATE_NOT_READY;
+
+  if(k_poll(laneEvents, DATASTORE_LANE_COUNT, K_MSEC(CONFIG_ENYA_DATASTORE_MSGQ_TIMEOUT)) < 0)
+    return NULL;
+
+  return takeLaneMessage(msg);
+#else
+  if(k_msgq_get(&datastoreQueue, msg, K_MSEC(CONFIG_ENYA_DATASTORE_MSGQ_TIMEOUT)) < 0)
+    return NULL;
+
+  return &datastoreQueue;
+#endif
+}
+
+/**
+ * @brief   Flush the NVM journal before the thread stops or suspends.
+ *
+ * @note    The flush completes before the state is confirmed, the latest
+ *          changes being saved even while a periodic save is ongoing.
+ */
+static inline void flushNvmJournal(void)
+{
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+  int err;
+
+  err = datastoreNvmFlush(k_uptime_get());
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to flush the NVM journal", err);
+#endif
+}
+
 /**
  * @brief   The datastore service thread function.
  *
@@ -94,11 +607,22 @@ static void run(void *p1, void *p2, void *p3)
 {
   int err;
   int errOp = 0;
+  uint32_t serviceStart;
   DatastoreMsg_t msg;
+  struct k_msgq *queue;
 
   LOG_INF("starting thread");
 
-  // TODO: Initialize the datapoints from the NVM.
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+  err = datastoreNvmRestore();
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to restore the datapoints from the NVM", err);
+#endif
+
+  /* The dependent services start once the datapoints are restored */
+  err = serviceManagerConfirmState(serviceHandle, SVC_STATE_RUNNING);
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to confirm service state", err);
 
 #ifdef CONFIG_ZTEST
   for(size_t i = 0; i < DATASTORE_RUN_ITERATIONS; ++i)
@@ -106,30 +630,66 @@ static void run(void *p1, void *p2, void *p3)
   for(;;)
 #endif
   {
-    if(k_msgq_get(&datastoreQueue, &msg, K_MSEC(CONFIG_ENYA_DATASTORE_MSGQ_TIMEOUT)) == 0)
+    queue = getNextMessage(&msg);
+    if(queue)
     {
+      SRV_TRACE_EVENT(DATASTORE_DEQUEUE, msg.msgType);
+      recordQueueDepth(queue);
+      serviceStart = getServiceStart();
+
+      SRV_TRACE_BEGIN(DATASTORE_DISPATCH, msg.msgType);
       switch(msg.msgType)
       {
         case DATASTORE_READ:
+#ifdef CONFIG_ENYA_DATASTORE_ASYNC
+          /* An asynchronous read goes straight to the caller buffer */
+          if(!msg.payload)
+          {
+            errOp = datastoreUtilRead(msg.datapointType, msg.datapointId, msg.valCount, msg.values);
+            break;
+          }
+#endif
           errOp = datastoreUtilRead(msg.datapointType, msg.datapointId, msg.valCount, msg.payload->data);
         break;
         case DATASTORE_WRITE:
-          errOp = datastoreUtilWrite(msg.datapointType, msg.datapointId, msg.payload->data, msg.valCount, bufferPool);
-          osMemoryPoolFree(msg.payload->poolId, msg.payload);
+          errOp = datastoreUtilWrite(msg.datapointType, msg.datapointId, msg.payload->data, msg.valCount, DATASTORE_NOTIFY_POOL);
+          if(!msg.response)
+            freeRequestBuffer(msg.payload);
         break;
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+        case DATASTORE_BATCH:
+          /* The value count is the operation count for a batch */
+          errOp = datastoreUtilApplyBatch(msg.payload->data, msg.valCount, DATASTORE_NOTIFY_POOL);
+          if(!msg.response)
+            freeRequestBuffer(msg.payload);
+        break;
+#endif
         case DATASTORE_STOP:
-          serviceManagerConfirmState(k_current_get(), SVC_STATE_STOPPED);
+          flushNvmJournal();
+          SRV_TRACE_END(DATASTORE_DISPATCH, msg.msgType);
+          serviceManagerConfirmState(serviceHandle, SVC_STATE_STOPPED);
           return;
         case DATASTORE_SUSPEND:
-          serviceManagerConfirmState(k_current_get(), SVC_STATE_SUSPENDED);
+          flushNvmJournal();
+          serviceManagerConfirmState(serviceHandle, SVC_STATE_SUSPENDED);
           k_thread_suspend(k_current_get());
         break;
         default:
           LOG_WRN("unsupported message type %d", msg.msgType);
         break;
       }
+      SRV_TRACE_END(DATASTORE_DISPATCH, msg.msgType);
+
+      /* Only the datapoint operations are timed */
+      if(msg.msgType < DATASTORE_STOP)
+        recordServiceTime(serviceStart);
+
+#ifdef CONFIG_ENYA_DATASTORE_ASYNC
+      if(msg.done)
+        msg.done(errOp, msg.userData);
+#endif
 
-      if(msg.response)
+      if(msg.response && completeWaitedRequest(msg.payload))
       {
         err = k_msgq_put(msg.response, &errOp, K_NO_WAIT);
         if(err < 0)
@@ -138,23 +698,49 @@ static void run(void *p1, void *p2, void *p3)
       }
     }
 
-    serviceManagerUpdateHeartbeat(k_current_get());
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+    err = datastoreUtilFlushNotify(k_uptime_get(), DATASTORE_NOTIFY_POOL);
+    if(err < 0)
+      LOG_ERR("ERROR %d: unable to flush the subscriber notifications", err);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+    err = datastoreNvmProcess(k_uptime_get());
+    if(err < 0)
+      LOG_ERR("ERROR %d: unable to process the NVM journal", err);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_REPLICATION
+    err = datastoreReplicationProcess(k_uptime_get());
+    if(err < 0)
+      LOG_ERR("ERROR %d: unable to send the replication frames", err);
+#endif
+
+    updatePoolHighWater(bufferPools + DATASTORE_POOL_NOTIFY);
+
+    serviceManagerUpdateHeartbeat(serviceHandle);
   }
 }
 
 /**
- * @brief   Start callback: starts the datastore thread.
+ * @brief   Start callback: starts the datastore thread and the ADC bridge.
  *
  * @return  0 if successful, the error code otherwise.
  */
 static int onStart(void)
 {
   k_thread_start(&thread);
+
+#ifdef CONFIG_ENYA_DATASTORE_ADC_BRIDGE
+  return datastoreAdcBridgeStart();
+#else
   return 0;
+#endif
 }
 
 /**
- * @brief   Stop callback: enqueues a stop message to the datastore queue.
+ * @brief   Stop callback: stops the ADC bridge and enqueues a stop message
+ *          to the datastore queue.
  *
  * @return  0 if successful, the error code otherwise.
  */
@@ -163,7 +749,11 @@ static int onStop(void)
   int err;
   DatastoreMsg_t msg = { .msgType = DATASTORE_STOP };
 
-  err = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+#ifdef CONFIG_ENYA_DATASTORE_ADC_BRIDGE
+  datastoreAdcBridgeStop();
+#endif
+
+  err = k_msgq_put(DATASTORE_CONTROL_QUEUE, &msg, K_NO_WAIT);
   if(err < 0)
     LOG_ERR("ERROR %d: unable to enqueue datastore stop message", err);
 
@@ -171,7 +761,8 @@ static int onStop(void)
 }
 
 /**
- * @brief   Suspend callback: enqueues a suspend message to the datastore queue.
+ * @brief   Suspend callback: pauses the ADC bridge and enqueues a suspend
+ *          message to the datastore queue.
  *
  * @return  0 if successful, the error code otherwise.
  */
@@ -180,7 +771,11 @@ static int onSuspend(void)
   int err;
   DatastoreMsg_t msg = { .msgType = DATASTORE_SUSPEND };
 
-  err = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+#ifdef CONFIG_ENYA_DATASTORE_ADC_BRIDGE
+  datastoreAdcBridgeSetPaused(true);
+#endif
+
+  err = k_msgq_put(DATASTORE_CONTROL_QUEUE, &msg, K_NO_WAIT);
   if(err < 0)
     LOG_ERR("ERROR %d: unable to enqueue datastore suspend message", err);
 
@@ -188,14 +783,19 @@ static int onSuspend(void)
 }
 
 /**
- * @brief   Resume callback: resumes the datastore thread.
+ * @brief   Resume callback: resumes the datastore thread and the ADC bridge.
  *
  * @return  0 if successful, the error code otherwise.
  */
 static int onResume(void)
 {
   k_thread_resume(&thread);
+
+#ifdef CONFIG_ENYA_DATASTORE_ADC_BRIDGE
+  return datastoreAdcBridgeSetPaused(false);
+#else
   return 0;
+#endif
 }
 
 int datastoreInit(void)
@@ -213,33 +813,54 @@ int datastoreInit(void)
     .resume              = onResume,
   };
 
-  err = datastoreUtilAllocateBinarySubs(CONFIG_ENYA_DATASTORE_MAX_BINARY_SUBS);
-  if(err < 0)
-    return err;
+#ifdef CONFIG_ENYA_DATASTORE_COMPACT_STORAGE
+  datastoreUtilInitDatapoints();
+#endif
 
-  err = datastoreUtilAllocateButtonSubs(CONFIG_ENYA_DATASTORE_MAX_BUTTON_SUBS);
+#ifdef CONFIG_ENYA_DATASTORE_COMPUTED
+  err = datastoreUtilInitComputed();
   if(err < 0)
     return err;
+#endif
 
-  err = datastoreUtilAllocateFloatSubs(CONFIG_ENYA_DATASTORE_MAX_FLOAT_SUBS);
-  if(err < 0)
+#define X(Name, name, TYPE, label, valueType)                                 \
+  err = datastoreUtilAllocate##Name##Subs(CONFIG_ENYA_DATASTORE_MAX_##TYPE##_SUBS); \
+  if(err < 0)                                                                 \
     return err;
+  DATASTORE_VALUE_TYPES
+#undef X
 
-  err = datastoreUtilAllocateIntSubs(CONFIG_ENYA_DATASTORE_MAX_INT_SUBS);
+#ifdef CONFIG_ENYA_DATASTORE_HISTORY
+  err = datastoreHistoryInit();
   if(err < 0)
     return err;
+#endif
 
-  err = datastoreUtilAllocateMultiStateSubs(CONFIG_ENYA_DATASTORE_MAX_MULTI_STATE_SUBS);
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+  err = datastoreNvmInit();
   if(err < 0)
     return err;
+#endif
 
-  err = datastoreUtilAllocateUintSubs(CONFIG_ENYA_DATASTORE_MAX_UINT_SUBS);
-  if(err < 0)
-    return err;
+  bufferPools[DATASTORE_POOL_NOTIFY].blockSize = datastoreUtilCalculateBufferSize(datapointCounts);
+  bufferPools[DATASTORE_POOL_LARGE].blockSize = offsetof(DatastoreRequestBuffer_t, payload) +
+                                                bufferPools[DATASTORE_POOL_NOTIFY].blockSize;
+
+  for(uint32_t i = 0; i < DATASTORE_POOL_COUNT; ++i)
+  {
+    if(bufferPools[i].blockCount == 0)
+      continue;
+
+    bufferPools[i].id = osMemoryPoolNew(bufferPools[i].blockCount, bufferPools[i].blockSize, NULL);
+    if(!bufferPools[i].id)
+      return -ENOSPC;
+  }
 
-  bufferPool = osMemoryPoolNew(DATASTORE_BUFFER_COUNT, datastoreUtilCalculateBufferSize(datapointCounts), NULL);
-  if(!bufferPool)
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+  batchPool = osMemoryPoolNew(DATASTORE_BATCH_BUFFER_COUNT, DATASTORE_BATCH_BUFFER_SIZE, NULL);
+  if(!batchPool)
     return -ENOSPC;
+#endif
 
   threadId = k_thread_create(&thread, datastoreStack, CONFIG_ENYA_DATASTORE_STACK_SIZE, run,
                              NULL, NULL, NULL, K_PRIO_PREEMPT(CONFIG_ENYA_DATASTORE_THREAD_PRIORITY), 0, K_FOREVER);
@@ -253,22 +874,66 @@ int datastoreInit(void)
 
   descriptor.threadId = threadId;
 
-  err = serviceManagerRegisterSrv(&descriptor);
+  err = serviceManagerRegisterSrv(&descriptor, &serviceHandle);
   if(err < 0)
     LOG_ERR("ERROR %d: unable to register datastore service", err);
 
   return err;
 }
 
-int datastoreRead(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
-                  struct k_msgq *response, Data_t values[])
+/**
+ * @brief   Read a datapoint directly from the calling thread.
+ *
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The count of value to read.
+ * @param[out]  values: The output buffer.
+ *
+ * @return  0 if successful, -EAGAIN if the read must go through the queue,
+ *          the error code otherwise.
+ */
+static inline int readDirect(DatapointType_t datapointType, uint32_t datapointId, size_t valCount, Data_t values[])
+{
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+  int err;
+
+  err = datastoreUtilDirectRead(datapointType, datapointId, valCount, values);
+  if(err == -EAGAIN)
+    LOG_DBG("direct read of datapoint type %d with ID %d collided with writes, using the queue",
+            datapointType, datapointId);
+
+  return err;
+#else
+  ARG_UNUSED(datapointType);
+  ARG_UNUSED(datapointId);
+  ARG_UNUSED(valCount);
+  ARG_UNUSED(values);
+
+  return -EAGAIN;
+#endif
+}
+
+/**
+ * @brief   Read a datapoint through a request queue.
+ *
+ * @param[in]   queue: The request queue.
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The count of value to read.
+ * @param[in]   response: The response queue.
+ * @param[out]  values: The output buffer.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int queueRead(struct k_msgq *queue, DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                     struct k_msgq *response, Data_t values[])
 {
   int err;
   int resStatus = 0;
   DatastoreMsg_t msg = {.msgType = DATASTORE_READ, .datapointType = datapointType, .datapointId = datapointId,
                         .valCount = valCount, .payload = NULL, .response = response };
 
-  msg.payload = osMemoryPoolAlloc(bufferPool, DATASTORE_BUFFER_ALLOC_TIMEOUT);
+  msg.payload = allocRequestBuffer(msg.valCount);
   if(!msg.payload)
   {
     err = -ENOSPC;
@@ -276,40 +941,46 @@ int datastoreRead(DatapointType_t datapointType, uint32_t datapointId, size_t va
     return err;
   }
 
-  msg.payload->poolId = bufferPool;
-  msg.payload->dataLen = msg.valCount * sizeof(Data_t);
-
-  err = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  err = submitRequest(queue, &msg);
   if(err < 0)
   {
-    osMemoryPoolFree(bufferPool, msg.payload);
+    freeRequestBuffer(msg.payload);
     return err;
   }
 
-  err = k_msgq_get(response, &resStatus, K_MSEC(DATASTORE_RESPONSE_TIMEOUT));
+  err = waitRequestResponse(response, msg.payload, &resStatus);
   if(err < 0)
-  {
-    osMemoryPoolFree(bufferPool, msg.payload);
     return err;
-  }
 
   if(resStatus == 0)
     memcpy(values, msg.payload->data, msg.payload->dataLen);
 
-  osMemoryPoolFree(bufferPool, msg.payload);
+  freeRequestBuffer(msg.payload);
 
   return resStatus;
 }
 
-int datastoreWrite(DatapointType_t datapointType, uint32_t datapointId,
-                   Data_t values[], size_t valCount, struct k_msgq *response)
+/**
+ * @brief   Write a datapoint through a request queue.
+ *
+ * @param[in]   queue: The request queue.
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   values: The values to write.
+ * @param[in]   valCount: The count of values to write.
+ * @param[in]   response: The response queue (NULL, if not needed).
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int queueWrite(struct k_msgq *queue, DatapointType_t datapointType, uint32_t datapointId,
+                      Data_t values[], size_t valCount, struct k_msgq *response)
 {
   int err;
   int resStatus = 0;
   DatastoreMsg_t msg = {.msgType = DATASTORE_WRITE, .datapointType = datapointType, .datapointId = datapointId,
                         .valCount = valCount, .payload = NULL, .response = response };
 
-  msg.payload = osMemoryPoolAlloc(bufferPool, DATASTORE_BUFFER_ALLOC_TIMEOUT);
+  msg.payload = allocRequestBuffer(msg.valCount);
   if(!msg.payload)
   {
     err = -ENOSPC;
@@ -317,365 +988,489 @@ int datastoreWrite(DatapointType_t datapointType, uint32_t datapointId,
     return err;
   }
 
-  msg.payload->poolId = bufferPool;
-  msg.payload->dataLen = msg.valCount * sizeof(Data_t);
-
   memcpy(msg.payload->data, values, msg.payload->dataLen);
 
-  err = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  err = submitRequest(queue, &msg);
   if(err < 0)
   {
-    osMemoryPoolFree(bufferPool, msg.payload);
+    freeRequestBuffer(msg.payload);
     return err;
   }
 
-  if(response)
-  {
-    err = k_msgq_get(response, &resStatus, K_MSEC(DATASTORE_RESPONSE_TIMEOUT));
-    if(err < 0)
-    {
-      osMemoryPoolFree(bufferPool, msg.payload);
-      return err;
-    }
-  }
+  if(!response)
+    return 0;
 
-  return resStatus;
-}
-
-int datastoreSubscribeBinary(DatastoreSubEntry_t *sub)
-{
-  return datastoreUtilAddBinarySub(sub, bufferPool);
-}
-
-int datastoreUnsubscribeBinary(DatastoreSubCb_t callback)
-{
-  return datastoreUtilRemoveBinarySub(callback);
-}
+  err = waitRequestResponse(response, msg.payload, &resStatus);
+  if(err < 0)
+    return err;
 
-int datastorePauseSubBinary(DatastoreSubCb_t callback)
-{
-  return datastoreUtilSetBinarySubPauseState(callback, true, bufferPool);
-}
+  freeRequestBuffer(msg.payload);
 
-int datastoreUnpauseSubBinary(DatastoreSubCb_t callback)
-{
-  return datastoreUtilSetBinarySubPauseState(callback, false, bufferPool);
+  return resStatus;
 }
 
-int datastoreReadBinary(uint32_t datapointId, size_t valCount, struct k_msgq *response, bool values[])
+/**
+ * @brief   Read a datapoint directly, through a request queue on a collision.
+ *
+ * @param[in]   queue: The request queue.
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The count of value to read.
+ * @param[in]   response: The response queue, NULL to only read directly.
+ * @param[out]  values: The output buffer.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int readDirectFirst(struct k_msgq *queue, DatapointType_t datapointType, uint32_t datapointId,
+                           size_t valCount, struct k_msgq *response, Data_t values[])
 {
   int err;
 
-  if(!values || valCount == 0 || !response)
-  {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
+  err = readDirect(datapointType, datapointId, valCount, values);
+  if(err != -EAGAIN)
     return err;
-  }
 
-  err = datastoreRead(DATAPOINT_BINARY, datapointId, valCount, response, (Data_t *)values);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to read binary datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+  /* Without a response queue, the caller retries the collided read */
+  if(!DATASTORE_READ_RESPONSE_REQUIRED && !response)
+    return err;
 
-  return err;
+  return queueRead(queue, datapointType, datapointId, valCount, response, values);
 }
 
-int datastoreWriteBinary(uint32_t datapointId, bool values[], size_t valCount, struct k_msgq *response)
+int datastoreRead(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                  struct k_msgq *response, Data_t values[])
 {
-  int err;
-
-  if(!values || valCount == 0)
-  {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
-    return err;
-  }
-
-  err = datastoreWrite(DATAPOINT_BINARY, datapointId, (Data_t *)values, valCount, response);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to write binary datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+  return readDirectFirst(getRequestQueue(), datapointType, datapointId, valCount, response, values);
+}
 
-  return err;
+int datastoreReadOrdered(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                         struct k_msgq *response, Data_t values[])
+{
+  return queueRead(getRequestQueue(), datapointType, datapointId, valCount, response, values);
 }
 
-int datastoreSubscribeButton(DatastoreSubEntry_t *sub)
+int datastoreWrite(DatapointType_t datapointType, uint32_t datapointId,
+                   Data_t values[], size_t valCount, struct k_msgq *response)
 {
-  return datastoreUtilAddButtonSub(sub, bufferPool);
+  return queueWrite(getRequestQueue(), datapointType, datapointId, values, valCount, response);
 }
 
-int datastoreUnsubscribeButton(DatastoreSubCb_t callback)
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+int datastoreReadBackground(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                            struct k_msgq *response, Data_t values[])
 {
-  return datastoreUtilRemoveButtonSub(callback);
+  return readDirectFirst(&datastoreBgQueue, datapointType, datapointId, valCount, response, values);
 }
 
-int datastorePauseSubButton(DatastoreSubCb_t callback)
+int datastoreReadOrderedBackground(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                                   struct k_msgq *response, Data_t values[])
 {
-  return datastoreUtilSetButtonSubPauseState(callback, true, bufferPool);
+  return queueRead(&datastoreBgQueue, datapointType, datapointId, valCount, response, values);
 }
 
-int datastoreUnpauseSubButton(DatastoreSubCb_t callback)
+int datastoreWriteBackground(DatapointType_t datapointType, uint32_t datapointId,
+                             Data_t values[], size_t valCount, struct k_msgq *response)
 {
-  return datastoreUtilSetButtonSubPauseState(callback, false, bufferPool);
+  return queueWrite(&datastoreBgQueue, datapointType, datapointId, values, valCount, response);
 }
+#endif
 
-int datastoreReadButton(uint32_t datapointId, size_t valCount, struct k_msgq *response, ButtonState_t values[])
+#ifdef CONFIG_ENYA_DATASTORE_ASYNC
+/**
+ * @brief   Submit a datapoint read to a request queue without waiting for its completion.
+ *
+ * @param[in]   queue: The request queue.
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The count of value to read.
+ * @param[out]  values: The output buffer.
+ * @param[in]   done: The completion callback.
+ * @param[in]   userData: The completion callback user data.
+ *
+ * @return  0 if the read is submitted, the error code otherwise.
+ */
+static int queueReadAsync(struct k_msgq *queue, DatapointType_t datapointType, uint32_t datapointId,
+                          size_t valCount, Data_t values[], DatastoreDoneCb_t done, void *userData)
 {
   int err;
+  DatastoreMsg_t msg = {.msgType = DATASTORE_READ, .datapointType = datapointType, .datapointId = datapointId,
+                        .valCount = valCount, .payload = NULL, .response = NULL, .values = values,
+                        .done = done, .userData = userData};
 
-  if(!values || valCount == 0 || !response)
+  if(!values || !done)
   {
     err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
+    LOG_ERR("ERROR %d: invalid asynchronous read parameters", err);
     return err;
   }
 
-  err = datastoreRead(DATAPOINT_BUTTON, datapointId, valCount, response, (Data_t *)values);
+  err = submitRequest(queue, &msg);
   if(err < 0)
-    LOG_ERR("ERROR %d: unable to read button datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+    LOG_ERR("ERROR %d: unable to submit the read of datapoint type %d with ID %d", err, datapointType, datapointId);
 
   return err;
 }
 
-int datastoreWriteButton(uint32_t datapointId, ButtonState_t values[], size_t valCount, struct k_msgq *response)
+/**
+ * @brief   Submit a datapoint write to a request queue without waiting for its completion.
+ *
+ * @param[in]   queue: The request queue.
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   values: The values to write.
+ * @param[in]   valCount: The count of values to write.
+ * @param[in]   done: The completion callback (NULL, if not needed).
+ * @param[in]   userData: The completion callback user data.
+ *
+ * @return  0 if the write is submitted, the error code otherwise.
+ */
+static int queueWriteAsync(struct k_msgq *queue, DatapointType_t datapointType, uint32_t datapointId,
+                           Data_t values[], size_t valCount, DatastoreDoneCb_t done, void *userData)
 {
   int err;
+  DatastoreMsg_t msg = {.msgType = DATASTORE_WRITE, .datapointType = datapointType, .datapointId = datapointId,
+                        .valCount = valCount, .payload = NULL, .response = NULL, .values = NULL,
+                        .done = done, .userData = userData};
 
-  if(!values || valCount == 0)
+  if(!values)
   {
     err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
+    LOG_ERR("ERROR %d: invalid asynchronous write parameters", err);
+    return err;
+  }
+
+  msg.payload = allocRequestBuffer(msg.valCount);
+  if(!msg.payload)
+  {
+    err = -ENOSPC;
+    LOG_ERR("ERROR %d: unable to allocate a buffer for operation", err);
     return err;
   }
 
-  err = datastoreWrite(DATAPOINT_BUTTON, datapointId, (Data_t *)values, valCount, response);
+  memcpy(msg.payload->data, values, msg.payload->dataLen);
+
+  err = submitRequest(queue, &msg);
   if(err < 0)
-    LOG_ERR("ERROR %d: unable to write button datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+  {
+    LOG_ERR("ERROR %d: unable to submit the write of datapoint type %d with ID %d", err, datapointType, datapointId);
+    freeRequestBuffer(msg.payload);
+  }
 
   return err;
 }
 
-int datastoreSubscribeFloat(DatastoreSubEntry_t *sub)
+int datastoreReadAsync(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                       Data_t values[], DatastoreDoneCb_t done, void *userData)
 {
-  return datastoreUtilAddFloatSub(sub, bufferPool);
+  return queueReadAsync(getRequestQueue(), datapointType, datapointId, valCount, values, done, userData);
 }
 
-int datastoreUnsubscribeFloat(DatastoreSubCb_t callback)
+int datastoreWriteAsync(DatapointType_t datapointType, uint32_t datapointId, Data_t values[], size_t valCount,
+                        DatastoreDoneCb_t done, void *userData)
 {
-  return datastoreUtilRemoveFloatSub(callback);
+  return queueWriteAsync(getRequestQueue(), datapointType, datapointId, values, valCount, done, userData);
 }
 
-int datastorePauseSubFloat(DatastoreSubCb_t callback)
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+int datastoreReadAsyncBackground(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                                 Data_t values[], DatastoreDoneCb_t done, void *userData)
 {
-  return datastoreUtilSetFloatSubPauseState(callback, true, bufferPool);
+  return queueReadAsync(&datastoreBgQueue, datapointType, datapointId, valCount, values, done, userData);
 }
 
-int datastoreUnpauseSubFloat(DatastoreSubCb_t callback)
+int datastoreWriteAsyncBackground(DatapointType_t datapointType, uint32_t datapointId, Data_t values[],
+                                  size_t valCount, DatastoreDoneCb_t done, void *userData)
 {
-  return datastoreUtilSetFloatSubPauseState(callback, false, bufferPool);
+  return queueWriteAsync(&datastoreBgQueue, datapointType, datapointId, values, valCount, done, userData);
 }
+#endif
 
-int datastoreReadFloat(uint32_t datapointId, size_t valCount, struct k_msgq *response, float values[])
+#ifdef CONFIG_POLL
+void datastoreSignalDone(int status, void *userData)
+{
+  k_poll_signal_raise((struct k_poll_signal *)userData, status);
+}
+#endif
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+/**
+ * @brief   Execute a batch of operations through a request queue.
+ *
+ * @param[in]       queue: The request queue.
+ * @param[in,out]   ops: The operations.
+ * @param[in]       opCount: The operation count.
+ * @param[in]       response: The response queue, can be NULL for write only batches.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int queueBatch(struct k_msgq *queue, DatastoreBatchOp_t ops[], size_t opCount, struct k_msgq *response)
 {
   int err;
+  int resStatus = 0;
+  size_t cursor = 0;
+  size_t totalValCount = 0;
+  DatastoreBatchOpHeader_t header;
+  DatastoreRequestBuffer_t *request;
+  DatastoreMsg_t msg = {.msgType = DATASTORE_BATCH, .valCount = opCount, .payload = NULL, .response = response};
 
-  if(!values || valCount == 0 || !response)
+  if(!ops || opCount == 0 || opCount > CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS)
   {
     err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
+    LOG_ERR("ERROR %d: invalid batch operation count %d", err, opCount);
     return err;
   }
 
-  err = datastoreRead(DATAPOINT_FLOAT, datapointId, valCount, response, (Data_t *)values);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to read float datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
-
-  return err;
-}
+  for(size_t i = 0; i < opCount; ++i)
+  {
+    if(!ops[i].values || ops[i].valCount == 0 || ops[i].opType >= DATASTORE_BATCH_OP_TYPE_COUNT ||
+       (ops[i].opType == DATASTORE_BATCH_READ && !response))
+    {
+      err = -EINVAL;
+      LOG_ERR("ERROR %d: invalid batch operation %d parameters", err, i);
+      return err;
+    }
 
-int datastoreWriteFloat(uint32_t datapointId, float values[], size_t valCount, struct k_msgq *response)
-{
-  int err;
+    totalValCount += ops[i].valCount;
+  }
 
-  if(!values || valCount == 0)
+  if(totalValCount > CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES)
   {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
+    err = -E2BIG;
+    LOG_ERR("ERROR %d: batch value count %d exceeds the maximum", err, totalValCount);
     return err;
   }
 
-  err = datastoreWrite(DATAPOINT_FLOAT, datapointId, (Data_t *)values, valCount, response);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to write float datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+  request = osMemoryPoolAlloc(batchPool, DATASTORE_BUFFER_ALLOC_TIMEOUT);
+  if(!request)
+  {
+    err = -ENOSPC;
+    LOG_ERR("ERROR %d: unable to allocate a buffer for batch", err);
+    return err;
+  }
 
-  return err;
-}
+  atomic_set(&request->state, DATASTORE_REQUEST_PENDING);
+  msg.payload = &request->payload;
+  msg.payload->poolId = batchPool;
 
-int datastoreSubscribeInt(DatastoreSubEntry_t *sub)
-{
-  return datastoreUtilAddIntSub(sub, bufferPool);
-}
+  for(size_t i = 0; i < opCount; ++i)
+  {
+    header.opType = ops[i].opType;
+    header.datapointType = ops[i].datapointType;
+    header.valCount = ops[i].valCount;
+    header.datapointId = ops[i].datapointId;
 
-int datastoreUnsubscribeInt(DatastoreSubCb_t callback)
-{
-  return datastoreUtilRemoveIntSub(callback);
-}
+    memcpy(msg.payload->data + cursor, &header, sizeof(header));
+    cursor += DATASTORE_BATCH_OP_HEADER_LEN;
 
-int datastorePauseSubInt(DatastoreSubCb_t callback)
-{
-  return datastoreUtilSetIntSubPauseState(callback, true, bufferPool);
-}
+    if(ops[i].opType == DATASTORE_BATCH_WRITE)
+      memcpy(msg.payload->data + cursor, ops[i].values, ops[i].valCount * sizeof(Data_t));
 
-int datastoreUnpauseSubInt(DatastoreSubCb_t callback)
-{
-  return datastoreUtilSetIntSubPauseState(callback, false, bufferPool);
-}
+    cursor += ops[i].valCount;
+  }
 
-int datastoreReadInt(uint32_t datapointId, size_t valCount, struct k_msgq *response, int32_t values[])
-{
-  int err;
+  msg.payload->dataLen = cursor * sizeof(Data_t);
 
-  if(!values || valCount == 0 || !response)
+  err = submitRequest(queue, &msg);
+  if(err < 0)
   {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
+    freeRequestBuffer(msg.payload);
     return err;
   }
 
-  err = datastoreRead(DATAPOINT_INT, datapointId, valCount, response, (Data_t *)values);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to read signed integer datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+  if(!response)
+    return 0;
 
-  return err;
-}
-
-int datastoreWriteInt(uint32_t datapointId, int32_t values[], size_t valCount, struct k_msgq *response)
-{
-  int err;
+  err = waitRequestResponse(response, msg.payload, &resStatus);
+  if(err < 0)
+    return err;
 
-  if(!values || valCount == 0)
+  cursor = 0;
+  for(size_t i = 0; i < opCount && resStatus == 0; ++i)
   {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
-    return err;
-  }
+    cursor += DATASTORE_BATCH_OP_HEADER_LEN;
 
-  err = datastoreWrite(DATAPOINT_INT, datapointId, (Data_t *)values, valCount, response);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to write signed integer datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+    if(ops[i].opType == DATASTORE_BATCH_READ)
+      memcpy(ops[i].values, msg.payload->data + cursor, ops[i].valCount * sizeof(Data_t));
 
-  return err;
-}
+    cursor += ops[i].valCount;
+  }
 
-int datastoreSubscribeMultiState(DatastoreSubEntry_t *sub)
-{
-  return datastoreUtilAddMultiStateSub(sub, bufferPool);
-}
+  freeRequestBuffer(msg.payload);
 
-int datastoreUnsubscribeMultiState(DatastoreSubCb_t callback)
-{
-  return datastoreUtilRemoveMultiStateSub(callback);
+  return resStatus;
 }
 
-int datastorePauseSubMultiState(DatastoreSubCb_t callback)
+int datastoreBatch(DatastoreBatchOp_t ops[], size_t opCount, struct k_msgq *response)
 {
-  return datastoreUtilSetMultiStateSubPauseState(callback, true, bufferPool);
+  return queueBatch(getRequestQueue(), ops, opCount, response);
 }
 
-int datastoreUnpauseSubMultiState(DatastoreSubCb_t callback)
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+int datastoreBatchBackground(DatastoreBatchOp_t ops[], size_t opCount, struct k_msgq *response)
 {
-  return datastoreUtilSetMultiStateSubPauseState(callback, false, bufferPool);
+  return queueBatch(&datastoreBgQueue, ops, opCount, response);
 }
+#endif
+#endif
 
-int datastoreReadMultiState(uint32_t datapointId, size_t valCount, struct k_msgq *response, uint32_t values[])
+int datastoreGetPoolStats(DatastorePool_t pool, DatastorePoolStats_t *stats)
 {
   int err;
 
-  if(!values || valCount == 0 || !response)
+  if(pool >= DATASTORE_POOL_COUNT || !stats)
   {
     err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
+    LOG_ERR("ERROR %d: invalid buffer pool %d", err, pool);
     return err;
   }
 
-  err = datastoreRead(DATAPOINT_MULTI_STATE, datapointId, valCount, response, (Data_t *)values);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to read multi-state datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+  stats->blockSize = bufferPools[pool].blockSize;
+  stats->blockCount = bufferPools[pool].id ? bufferPools[pool].blockCount : 0;
+  stats->usedCount = bufferPools[pool].id ? osMemoryPoolGetCount(bufferPools[pool].id) : 0;
+  stats->highWater = atomic_get(&bufferPools[pool].highWater);
 
-  return err;
+  return 0;
 }
 
-int datastoreWriteMultiState(uint32_t datapointId, uint32_t values[], size_t valCount, struct k_msgq *response)
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+int datastoreGetStats(DatastoreStats_t *stats)
 {
   int err;
 
-  if(!values || valCount == 0)
+  if(!stats)
   {
     err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
+    LOG_ERR("ERROR %d: invalid statistics buffer", err);
     return err;
   }
 
-  err = datastoreWrite(DATAPOINT_MULTI_STATE, datapointId, (Data_t *)values, valCount, response);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to write multi-state datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+  stats->elapsedMs = k_uptime_get() - datastoreStats.resetMs;
+  stats->queueHighWater = (uint32_t)atomic_get(&datastoreStats.queueHighWater);
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+  stats->bgQueueHighWater = (uint32_t)atomic_get(&datastoreStats.bgQueueHighWater);
+#endif
+  stats->opCount = (uint32_t)atomic_get(&datastoreStats.opCount);
+  stats->serviceTimeMaxUs = (uint32_t)atomic_get(&datastoreStats.serviceTimeMaxUs);
 
-  return err;
-}
+  for(size_t i = 0; i < DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT; ++i)
+    stats->serviceTimeHist[i] = (uint32_t)atomic_get(datastoreStats.serviceTimeHist + i);
 
-int datastoreSubscribeUint(DatastoreSubEntry_t *sub)
-{
-  return datastoreUtilAddUintSub(sub, bufferPool);
-}
+  stats->responseTimeouts = (uint32_t)atomic_get(&datastoreStats.responseTimeouts);
+  datastoreUtilGetNotifyStats(stats);
 
-int datastoreUnsubscribeUint(DatastoreSubCb_t callback)
-{
-  return datastoreUtilRemoveUintSub(callback);
-}
-
-int datastorePauseSubUint(DatastoreSubCb_t callback)
-{
-  return datastoreUtilSetUintSubPauseState(callback, true, bufferPool);
-}
-
-int datastoreUnpauseSubUint(DatastoreSubCb_t callback)
-{
-  return datastoreUtilSetUintSubPauseState(callback, false, bufferPool);
+  return 0;
 }
 
-int datastoreReadUint(uint32_t datapointId, size_t valCount, struct k_msgq *response, uint32_t values[])
+void datastoreResetStats(void)
 {
-  int err;
-
-  if(!values || valCount == 0 || !response)
-  {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
-    return err;
-  }
+  atomic_clear(&datastoreStats.queueHighWater);
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+  atomic_clear(&datastoreStats.bgQueueHighWater);
+#endif
+  atomic_clear(&datastoreStats.opCount);
+  atomic_clear(&datastoreStats.serviceTimeMaxUs);
 
-  err = datastoreRead(DATAPOINT_UINT, datapointId, valCount, response, (Data_t *)values);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to read unsigned integer datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
+  for(size_t i = 0; i < DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT; ++i)
+    atomic_clear(datastoreStats.serviceTimeHist + i);
 
-  return err;
+  atomic_clear(&datastoreStats.responseTimeouts);
+  datastoreUtilResetNotifyStats();
+  datastoreStats.resetMs = k_uptime_get();
 }
+#endif
 
-int datastoreWriteUint(uint32_t datapointId, uint32_t values[], size_t valCount, struct k_msgq *response)
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+void datastoreRequestNvmFlush(void)
 {
-  int err;
+  datastoreNvmRequestFlush();
+}
+#endif
 
-  if(!values || valCount == 0)
-  {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid operation parameters", err);
-    return err;
+/**
+ * @brief   Define the public API of a value type.
+ *
+ * @note    Generates the datastoreSubscribe<Name>(),
+ *          datastoreUnsubscribe<Name>(), datastorePauseSub<Name>(),
+ *          datastoreUnpauseSub<Name>(), datastoreRead<Name>() and
+ *          datastoreWrite<Name>() functions declared in datastore.h. A type
+ *          without datapoint or subscription rejects the subscriptions
+ *          without reaching the subscription handlers.
+ *
+ * @param[in]   Name: The type function name infix.
+ * @param[in]   TYPE: The type datapoint and Kconfig name infix.
+ * @param[in]   label: The type log label.
+ * @param[in]   valueType: The type value C type.
+ */
+#define DATASTORE_TYPE_API_DEFINE(Name, TYPE, label, valueType)                                         \
+  int datastoreSubscribe##Name(DatastoreSubEntry_t *sub)                                                \
+  {                                                                                                     \
+    if(TYPE##_DATAPOINT_COUNT == 0 || CONFIG_ENYA_DATASTORE_MAX_##TYPE##_SUBS == 0)                     \
+    {                                                                                                   \
+      LOG_ERR("ERROR %d: " label " subscriptions disabled", -ENOBUFS);                                  \
+      return -ENOBUFS;                                                                                  \
+    }                                                                                                   \
+                                                                                                        \
+    return datastoreUtilAdd##Name##Sub(sub, DATASTORE_NOTIFY_POOL);                                     \
+  }                                                                                                     \
+                                                                                                        \
+  int datastoreUnsubscribe##Name(DatastoreSubCb_t callback)                                             \
+  {                                                                                                     \
+    return datastoreUtilRemove##Name##Sub(callback);                                                    \
+  }                                                                                                     \
+                                                                                                        \
+  int datastorePauseSub##Name(DatastoreSubCb_t callback)                                                \
+  {                                                                                                     \
+    return datastoreUtilSet##Name##SubPauseState(callback, true, DATASTORE_NOTIFY_POOL);                \
+  }                                                                                                     \
+                                                                                                        \
+  int datastoreUnpauseSub##Name(DatastoreSubCb_t callback)                                              \
+  {                                                                                                     \
+    return datastoreUtilSet##Name##SubPauseState(callback, false, DATASTORE_NOTIFY_POOL);               \
+  }                                                                                                     \
+                                                                                                        \
+  int datastoreRead##Name(uint32_t datapointId, size_t valCount, struct k_msgq *response,               \
+                          valueType values[])                                                           \
+  {                                                                                                     \
+    int err;                                                                                            \
+                                                                                                        \
+    if(!values || valCount == 0 || (DATASTORE_READ_RESPONSE_REQUIRED && !response))                     \
+    {                                                                                                   \
+      err = -EINVAL;                                                                                    \
+      LOG_ERR("ERROR %d: invalid operation parameters", err);                                           \
+      return err;                                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    err = datastoreRead(DATAPOINT_##TYPE, datapointId, valCount, response, (Data_t *)values);           \
+    if(err < 0)                                                                                         \
+      LOG_ERR("ERROR %d: unable to read " label " datapoint %d up to datapoint %d", err, datapointId,   \
+              datapointId + valCount);                                                                  \
+                                                                                                        \
+    return err;                                                                                         \
+  }                                                                                                     \
+                                                                                                        \
+  int datastoreWrite##Name(uint32_t datapointId, valueType values[], size_t valCount,                   \
+                           struct k_msgq *response)                                                     \
+  {                                                                                                     \
+    int err;                                                                                            \
+                                                                                                        \
+    if(!values || valCount == 0)                                                                        \
+    {                                                                                                   \
+      err = -EINVAL;                                                                                    \
+      LOG_ERR("ERROR %d: invalid operation parameters", err);                                           \
+      return err;                                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    err = datastoreWrite(DATAPOINT_##TYPE, datapointId, (Data_t *)values, valCount, response);          \
+    if(err < 0)                                                                                         \
+      LOG_ERR("ERROR %d: unable to write " label " datapoint %d up to datapoint %d", err, datapointId,  \
+              datapointId + valCount);                                                                  \
+                                                                                                        \
+    return err;                                                                                         \
   }
 
-  err = datastoreWrite(DATAPOINT_UINT, datapointId, (Data_t *)values, valCount, response);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to write unsigned integer datapoint %d up to datapoint %d", err, datapointId, datapointId + valCount);
-
-  return err;
-}
+#define X(Name, name, TYPE, label, valueType) DATASTORE_TYPE_API_DEFINE(Name, TYPE, label, valueType)
+DATASTORE_VALUE_TYPES
+#undef X
 
 /** @} */
@@ -109,8 +109,135 @@ typedef struct
   size_t valCount;                      /**< The datapoint count */
   bool isPaused;                        /**< The paused subscription flag */
   DatastoreSubCb_t callback;            /**< The subscription callback */
+#ifdef CONFIG_ENYA_DATASTORE_DELTA_NOTIFY
+  bool isDelta;                         /**< The delta payload flag, only the changed values are sent */
+#endif
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+  uint32_t minIntervalMs;               /**< The minimum notification interval [ms], 0 for none */
+  Data_t deadband;                      /**< The minimum value change to notify, in the datapoint type, 0 for any */
+  int64_t lastNotifyMs;                 /**< The last notification uptime [ms], managed by the datastore */
+  bool isPending;                       /**< The pending notification flag, managed by the datastore */
+  Data_t *refValues;                    /**< The last notified values, managed by the datastore */
+#endif
 } DatastoreSubEntry_t;
 
+#ifdef CONFIG_ENYA_DATASTORE_DELTA_NOTIFY
+/**
+ * @brief   The delta notification header.
+ * @note    The header is the first element of a delta payload, followed by
+ *          the changed values. The callback value count is the changed count.
+ */
+typedef struct
+{
+  uint32_t datapointId;                 /**< The first changed datapoint ID */
+  uint32_t valCount;                    /**< The changed datapoint count */
+} DatastoreDeltaHeader_t;
+
+/**
+ * @brief   The delta notification header length in Data_t elements.
+ */
+#define DATASTORE_DELTA_HEADER_LEN      (sizeof(DatastoreDeltaHeader_t) / sizeof(Data_t))
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+/**
+ * @brief   The batch operation type.
+ */
+typedef enum
+{
+  DATASTORE_BATCH_READ = 0,             /**< Read the datapoint values */
+  DATASTORE_BATCH_WRITE,                /**< Write the datapoint values */
+  DATASTORE_BATCH_OP_TYPE_COUNT,
+} DatastoreBatchOpType_t;
+
+/**
+ * @brief   The batch operation.
+ */
+typedef struct
+{
+  DatastoreBatchOpType_t opType;        /**< The operation type */
+  DatapointType_t datapointType;        /**< The datapoint type */
+  uint32_t datapointId;                 /**< The first datapoint ID */
+  size_t valCount;                      /**< The datapoint count */
+  Data_t *values;                       /**< The values to write or the read output buffer */
+} DatastoreBatchOp_t;
+
+/**
+ * @brief   The batch operation header as packed in the batch buffer.
+ * @note    Each header is followed by the operation values.
+ */
+typedef struct
+{
+  uint8_t opType;                       /**< The operation type */
+  uint8_t datapointType;                /**< The datapoint type */
+  uint16_t valCount;                    /**< The datapoint count */
+  uint32_t datapointId;                 /**< The first datapoint ID */
+} DatastoreBatchOpHeader_t;
+
+/**
+ * @brief   The batch operation header length in Data_t elements.
+ */
+#define DATASTORE_BATCH_OP_HEADER_LEN   (sizeof(DatastoreBatchOpHeader_t) / sizeof(Data_t))
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_ASYNC
+/**
+ * @brief   The asynchronous request completion callback.
+ * @note    The callback runs in the datastore thread and must not block.
+ */
+typedef void (*DatastoreDoneCb_t)(int status, void *userData);
+#endif
+
+/**
+ * @brief   The datastore buffer pools.
+ */
+typedef enum
+{
+  DATASTORE_POOL_SMALL = 0,             /**< The small request buffers */
+  DATASTORE_POOL_MEDIUM,                /**< The medium request buffers */
+  DATASTORE_POOL_LARGE,                 /**< The large request buffers, fitting any datapoint range */
+  DATASTORE_POOL_NOTIFY,                /**< The subscription notification buffers */
+  DATASTORE_POOL_COUNT,
+} DatastorePool_t;
+
+/**
+ * @brief   The datastore buffer pool statistics.
+ */
+typedef struct
+{
+  uint32_t blockSize;                   /**< The block size in bytes */
+  uint32_t blockCount;                  /**< The block count */
+  uint32_t usedCount;                   /**< The blocks currently in use */
+  uint32_t highWater;                   /**< The highest in use block count seen */
+} DatastorePoolStats_t;
+
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+/**
+ * @brief   The service time histogram bucket count.
+ * @note    Bucket 0 counts the operations under 1 us, bucket i the ones from
+ *          2^(i - 1) to 2^i - 1 us and the last bucket all the longer ones.
+ */
+#define DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT               (12)
+
+/**
+ * @brief   The datastore statistics.
+ */
+typedef struct
+{
+  int64_t elapsedMs;                    /**< The time since the last reset [ms] */
+  uint32_t queueHighWater;              /**< The highest request queue depth seen */
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+  uint32_t bgQueueHighWater;            /**< The highest background request queue depth seen */
+#endif
+  uint32_t opCount;                     /**< The processed operation count */
+  uint32_t serviceTimeMaxUs;            /**< The longest operation service time [us] */
+  uint32_t serviceTimeHist[DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT]; /**< The service time histogram */
+  uint32_t notifyCounts[DATAPOINT_TYPE_COUNT]; /**< The notification count of each type */
+  uint32_t notifyAllocFailures;         /**< The notification buffer allocation failures */
+  uint32_t responseTimeouts;            /**< The request response timeouts */
+} DatastoreStats_t;
+#endif
+
 /**
  * @brief   Initialize the datastore service.
  *
@@ -125,10 +252,16 @@ int datastoreInit(void);
 /**
  * @brief   Read a datapoint.
  *
+ * @note    When CONFIG_ENYA_DATASTORE_DIRECT_READ is enabled, the datapoint
+ *          storage is read directly from the calling thread and the message
+ *          queue path is only used as a fallback. The response queue can then
+ *          be NULL: a read still colliding with writes is not queued and
+ *          returns -EAGAIN, for the caller to retry.
+ *
  * @param[in]   datapointType: The datapoint type.
  * @param[in]   datapointId: The datapoint ID.
  * @param[in]   valCount: The count of value to read.
- * @param[in]   response: The response queue.
+ * @param[in]   response: The response queue, can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
  * @param[out]  values: The output buffer.
  *
  * @return  0 if successful, the error code otherwise.
@@ -136,6 +269,151 @@ int datastoreInit(void);
 int datastoreRead(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
                   struct k_msgq *response, Data_t values[]);
 
+/**
+ * @brief   Read a datapoint through the datastore thread.
+ *
+ * @note    The read is always processed by the datastore thread, so it is
+ *          ordered after any operation already queued.
+ *
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The count of value to read.
+ * @param[in]   response: The response queue.
+ * @param[out]  values: The output buffer.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreReadOrdered(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                         struct k_msgq *response, Data_t values[]);
+
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+/**
+ * @brief   Read a datapoint, queued on the background lane.
+ *
+ * @note    Same as datastoreRead(), the direct read being tried first when
+ *          CONFIG_ENYA_DATASTORE_DIRECT_READ is enabled.
+ *
+ * @note    The request takes the background lane whatever the calling thread
+ *          priority. A background thread cannot take the real-time lane, the
+ *          lane being kept for the real-time threads.
+ *
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The count of value to read.
+ * @param[in]   response: The response queue, can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
+ * @param[out]  values: The output buffer.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreReadBackground(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                            struct k_msgq *response, Data_t values[]);
+
+/**
+ * @brief   Read a datapoint through the datastore thread, queued on the background lane.
+ *
+ * @note    The read is ordered after the operations already queued on the
+ *          background lane.
+ *
+ * @note    The request takes the background lane whatever the calling thread
+ *          priority. A background thread cannot take the real-time lane, the
+ *          lane being kept for the real-time threads.
+ *
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The count of value to read.
+ * @param[in]   response: The response queue.
+ * @param[out]  values: The output buffer.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreReadOrderedBackground(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                                   struct k_msgq *response, Data_t values[]);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+/**
+ * @brief   Execute a batch of operations.
+ *
+ *          All the operations are applied atomically by the datastore thread
+ *          in a single loop iteration. Either all operations are applied or
+ *          none are. Subscribers are notified at most once per batch.
+ *
+ * @note    A response queue is required when the batch contains read
+ *          operations. The read values are copied to each operation values
+ *          buffer once the batch succeeded.
+ *
+ * @param[in,out]   ops: The operations.
+ * @param[in]       opCount: The operation count.
+ * @param[in]       response: The response queue, can be NULL for write only batches.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreBatch(DatastoreBatchOp_t ops[], size_t opCount, struct k_msgq *response);
+
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+/**
+ * @brief   Execute a batch of operations, queued on the background lane.
+ *
+ * @note    Same as datastoreBatch().
+ *
+ * @note    The request takes the background lane whatever the calling thread
+ *          priority. A background thread cannot take the real-time lane, the
+ *          lane being kept for the real-time threads.
+ *
+ * @param[in,out]   ops: The operations.
+ * @param[in]       opCount: The operation count.
+ * @param[in]       response: The response queue, can be NULL for write only batches.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreBatchBackground(DatastoreBatchOp_t ops[], size_t opCount, struct k_msgq *response);
+#endif
+#endif
+
+/**
+ * @brief   Get the statistics of a buffer pool.
+ *
+ * @note    The high water of the request pools is updated on each allocation,
+ *          the one of the notification pool after each datastore operation.
+ *
+ * @param[in]   pool: The buffer pool.
+ * @param[out]  stats: The buffer pool statistics.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreGetPoolStats(DatastorePool_t pool, DatastorePoolStats_t *stats);
+
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+/**
+ * @brief   Get the datastore statistics.
+ *
+ * @note    The counters are gathered since the last reset, or the boot.
+ *
+ * @param[out]  stats: The datastore statistics.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreGetStats(DatastoreStats_t *stats);
+
+/**
+ * @brief   Reset the datastore statistics.
+ *
+ * @note    The buffer pool high waters are left untouched.
+ */
+void datastoreResetStats(void);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+/**
+ * @brief   Request the flush of the changed persisted datapoints to the NVM.
+ *
+ * @note    The flush is started by the datastore thread at its next loop
+ *          iteration and completes in the system work queue. Call it before
+ *          entering a low-power state or powering down.
+ */
+void datastoreRequestNvmFlush(void);
+#endif
+
 /**
  * @brief   Write a datapoint
  *
@@ -150,6 +428,121 @@ int datastoreRead(DatapointType_t datapointType, uint32_t datapointId, size_t va
 int datastoreWrite(DatapointType_t datapointType, uint32_t datapointId,
                    Data_t values[], size_t valCount, struct k_msgq *response);
 
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+/**
+ * @brief   Write a datapoint, queued on the background lane.
+ *
+ * @note    The request takes the background lane whatever the calling thread
+ *          priority. A background thread cannot take the real-time lane, the
+ *          lane being kept for the real-time threads.
+ *
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   values: The values to write.
+ * @param[in]   valCount: The count of values to write.
+ * @param[in]   response: The response queue (NULL, if not needed).
+ *
+ * @return  0 if successful, the error code.
+ */
+int datastoreWriteBackground(DatapointType_t datapointType, uint32_t datapointId,
+                             Data_t values[], size_t valCount, struct k_msgq *response);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_ASYNC
+/**
+ * @brief   Submit a datapoint read without waiting for its completion.
+ *
+ * @note    The datastore thread reads straight into the values buffer, which
+ *          must stay valid until the completion callback is called.
+ *
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The count of value to read.
+ * @param[out]  values: The output buffer.
+ * @param[in]   done: The completion callback.
+ * @param[in]   userData: The completion callback user data.
+ *
+ * @return  0 if the read is submitted, the error code otherwise.
+ */
+int datastoreReadAsync(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                       Data_t values[], DatastoreDoneCb_t done, void *userData);
+
+/**
+ * @brief   Submit a datapoint write without waiting for its completion.
+ *
+ * @note    The values are copied at submission, the values buffer can be
+ *          reused right away.
+ *
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   values: The values to write.
+ * @param[in]   valCount: The count of values to write.
+ * @param[in]   done: The completion callback (NULL, if not needed).
+ * @param[in]   userData: The completion callback user data.
+ *
+ * @return  0 if the write is submitted, the error code otherwise.
+ */
+int datastoreWriteAsync(DatapointType_t datapointType, uint32_t datapointId, Data_t values[], size_t valCount,
+                        DatastoreDoneCb_t done, void *userData);
+
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+/**
+ * @brief   Submit a datapoint read on the background lane without waiting for its completion.
+ *
+ * @note    Same as datastoreReadAsync().
+ *
+ * @note    The request takes the background lane whatever the calling thread
+ *          priority. A background thread cannot take the real-time lane, the
+ *          lane being kept for the real-time threads.
+ *
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The count of value to read.
+ * @param[out]  values: The output buffer.
+ * @param[in]   done: The completion callback.
+ * @param[in]   userData: The completion callback user data.
+ *
+ * @return  0 if the read is submitted, the error code otherwise.
+ */
+int datastoreReadAsyncBackground(DatapointType_t datapointType, uint32_t datapointId, size_t valCount,
+                                 Data_t values[], DatastoreDoneCb_t done, void *userData);
+
+/**
+ * @brief   Submit a datapoint write on the background lane without waiting for its completion.
+ *
+ * @note    Same as datastoreWriteAsync().
+ *
+ * @note    The request takes the background lane whatever the calling thread
+ *          priority. A background thread cannot take the real-time lane, the
+ *          lane being kept for the real-time threads.
+ *
+ * @param[in]   datapointType: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   values: The values to write.
+ * @param[in]   valCount: The count of values to write.
+ * @param[in]   done: The completion callback (NULL, if not needed).
+ * @param[in]   userData: The completion callback user data.
+ *
+ * @return  0 if the write is submitted, the error code otherwise.
+ */
+int datastoreWriteAsyncBackground(DatapointType_t datapointType, uint32_t datapointId, Data_t values[],
+                                  size_t valCount, DatastoreDoneCb_t done, void *userData);
+#endif
+
+#ifdef CONFIG_POLL
+/**
+ * @brief   Completion callback raising a poll signal with the request status.
+ *
+ * @note    Pass the struct k_poll_signal as user data to wait for a request
+ *          with k_poll(), along with other events.
+ *
+ * @param[in]   status: The request status.
+ * @param[in]   userData: The poll signal.
+ */
+void datastoreSignalDone(int status, void *userData);
+#endif
+#endif
+
 /**
  * @brief   Subscribe to binary datapoint.
  *
@@ -189,9 +582,12 @@ int datastoreUnpauseSubBinary(DatastoreSubCb_t callback);
 /**
  * @brief   Read a binary datapoint.
  *
+ * @note    The read goes through datastoreRead(), the response queue
+ *          can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
+ *
  * @param[in]   datapointId: The datapoint ID.
  * @param[in]   valCount: The count of value to read.
- * @param[in]   response: The response queue.
+ * @param[in]   response: The response queue, can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
  * @param[out]  values: The output buffer.
  *
  * @return  0 if successful, the error code otherwise.
@@ -249,9 +645,12 @@ int datastoreUnpauseSubButton(DatastoreSubCb_t callback);
 /**
  * @brief   Read a button datapoint.
  *
+ * @note    The read goes through datastoreRead(), the response queue
+ *          can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
+ *
  * @param[in]   datapointId: The datapoint ID.
  * @param[in]   valCount: The count of value to read.
- * @param[in]   response: The response queue.
+ * @param[in]   response: The response queue, can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
  * @param[out]  values: The output buffer.
  *
  * @return  0 if successful, the error code otherwise.
@@ -309,9 +708,12 @@ int datastoreUnpauseSubFloat(DatastoreSubCb_t callback);
 /**
  * @brief   Read a float datapoint.
  *
+ * @note    The read goes through datastoreRead(), the response queue
+ *          can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
+ *
  * @param[in]   datapointId: The datapoint ID.
  * @param[in]   valCount: The count of value to read.
- * @param[in]   response: The response queue.
+ * @param[in]   response: The response queue, can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
  * @param[out]  values: The output buffer.
  *
  * @return  0 if successful, the error code otherwise.
@@ -369,9 +771,12 @@ int datastoreUnpauseSubInt(DatastoreSubCb_t callback);
 /**
  * @brief   Read a integer datapoint.
  *
+ * @note    The read goes through datastoreRead(), the response queue
+ *          can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
+ *
  * @param[in]   datapointId: The datapoint ID.
  * @param[in]   valCount: The count of value to read.
- * @param[in]   response: The response queue.
+ * @param[in]   response: The response queue, can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
  * @param[out]  values: The output buffer.
  *
  * @return  0 if successful, the error code otherwise.
@@ -429,9 +834,12 @@ int datastoreUnpauseSubMultiState(DatastoreSubCb_t callback);
 /**
  * @brief   Read a multi-state datapoint.
  *
+ * @note    The read goes through datastoreRead(), the response queue
+ *          can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
+ *
  * @param[in]   datapointId: The datapoint ID.
  * @param[in]   valCount: The count of value to read.
- * @param[in]   response: The response queue.
+ * @param[in]   response: The response queue, can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
  * @param[out]  values: The output buffer.
  *
  * @return  0 if successful, the error code otherwise.
@@ -489,9 +897,12 @@ int datastoreUnpauseSubUint(DatastoreSubCb_t callback);
 /**
  * @brief   Read an unsigned integer datapoint.
  *
+ * @note    The read goes through datastoreRead(), the response queue
+ *          can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
+ *
  * @param[in]   datapointId: The datapoint ID.
  * @param[in]   valCount: The count of value to read.
- * @param[in]   response: The response queue.
+ * @param[in]   response: The response queue, can be NULL with CONFIG_ENYA_DATASTORE_DIRECT_READ.
  * @param[out]  values: The output buffer.
  *
  * @return  0 if successful, the error code otherwise.
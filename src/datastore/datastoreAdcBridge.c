@@ -0,0 +1,237 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreAdcBridge.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore ADC Bridge Implementation
+ *
+ *            Datastore ADC bridge implementation. The subscription callback
+ *            runs in the ADC thread, filters each snapshot through the
+ *            channel deadbands and queues the changed values as a single
+ *            write-only batch, the consecutive datapoints sharing an
+ *            operation.
+ *
+ * @ingroup   datastore
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "datastoreAdcBridge.h"
+#include "adcAcquisition.h"
+
+/* Setting module logging */
+LOG_MODULE_DECLARE(DATASTORE_LOGGER_NAME);
+
+/**
+ * @brief   The ADC bridge channel mapping.
+ */
+typedef struct
+{
+  uint32_t chanId;                      /**< The ADC channel ID. */
+  uint32_t datapointId;                 /**< The float datapoint ID. */
+  float deadband;                       /**< The change not worth a write [V]. */
+} DatastoreAdcBridgeMap_t;
+
+/**
+ * @brief   The ADC bridge channel mappings.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+static const DatastoreAdcBridgeMap_t bridgeMaps[] = {
+#define X(chanId, datapointId, deadband) {chanId, datapointId, deadband},
+  DATASTORE_ADC_BRIDGE_CHANNELS
+#undef X
+};
+
+/**
+ * @brief   The ADC bridge channel mapping count.
+ */
+#define BRIDGE_MAP_COUNT                ARRAY_SIZE(bridgeMaps)
+
+BUILD_ASSERT(BRIDGE_MAP_COUNT <= CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS &&
+             BRIDGE_MAP_COUNT <= CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES,
+             "the ADC bridge snapshot must fit a single batch");
+
+BUILD_ASSERT(BRIDGE_MAP_COUNT <= 32, "the ADC bridge masks hold at most 32 mappings");
+
+#define X(chanId, datapointId, deadband)                                      \
+  BUILD_ASSERT((chanId) < 32, "only the first 32 ADC channels can be bridged"); \
+  BUILD_ASSERT((datapointId) < FLOAT_DATAPOINT_COUNT, "the ADC bridge only writes float datapoints");
+DATASTORE_ADC_BRIDGE_CHANNELS
+#undef X
+
+/**
+ * @brief   The subscribed ADC channel count.
+ */
+static size_t bridgeChanCount;
+
+/**
+ * @brief   The snapshot value index of each mapping.
+ */
+static uint8_t valueIndexes[BRIDGE_MAP_COUNT];
+
+/**
+ * @brief   The last written value of each mapping.
+ */
+static float lastValues[BRIDGE_MAP_COUNT];
+
+/**
+ * @brief   The mappings holding a written value.
+ */
+static uint32_t writtenMask;
+
+/**
+ * @brief   Check if a value moved beyond the deadband of its mapping.
+ *
+ * @param[in]   mapIdx: The mapping index.
+ * @param[in]   value: The new value [V].
+ *
+ * @return  true if the value must be written, false otherwise.
+ */
+static inline bool isBeyondDeadband(size_t mapIdx, float value)
+{
+  float delta = value - lastValues[mapIdx];
+
+  if(!(writtenMask & BIT(mapIdx)))
+    return true;
+
+  return delta > bridgeMaps[mapIdx].deadband || -delta > bridgeMaps[mapIdx].deadband;
+}
+
+/**
+ * @brief   The ADC subscription callback, writing the snapshot changes.
+ *
+ * @note    The snapshot is always released here, its failures being logged
+ *          only: an error returned to the notifier would release it again.
+ *
+ * @param[in]   data: The ADC snapshot, in volts.
+ *
+ * @return  0, the snapshot being taken.
+ */
+static int onAdcData(SrvMsgPayload_t *data)
+{
+  int err;
+  size_t opCount = 0;
+  size_t valCount = 0;
+  uint32_t changedMask = 0;
+  float newValues[BRIDGE_MAP_COUNT];
+  Data_t values[BRIDGE_MAP_COUNT];
+  DatastoreBatchOp_t ops[BRIDGE_MAP_COUNT];
+  const float *volts = (const float *)data->data;
+
+  if(data->dataLen != bridgeChanCount * sizeof(float))
+  {
+    adcAcqReleaseData(data);
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: ADC bridge snapshot not matching the subscribed channels", err);
+    return 0;
+  }
+
+  for(size_t i = 0; i < BRIDGE_MAP_COUNT; ++i)
+  {
+    newValues[i] = volts[valueIndexes[i]];
+    if(!isBeyondDeadband(i, newValues[i]))
+      continue;
+
+    values[valCount].floatVal = newValues[i];
+    changedMask |= BIT(i);
+
+    /* The values being appended in order, a consecutive datapoint extends the last operation */
+    if(opCount > 0 && ops[opCount - 1].datapointId + ops[opCount - 1].valCount == bridgeMaps[i].datapointId)
+    {
+      ++ops[opCount - 1].valCount;
+    }
+    else
+    {
+      ops[opCount].opType = DATASTORE_BATCH_WRITE;
+      ops[opCount].datapointType = DATAPOINT_FLOAT;
+      ops[opCount].datapointId = bridgeMaps[i].datapointId;
+      ops[opCount].valCount = 1;
+      ops[opCount].values = values + valCount;
+      ++opCount;
+    }
+
+    ++valCount;
+  }
+
+  adcAcqReleaseData(data);
+
+  if(opCount == 0)
+    return 0;
+
+  err = datastoreBatch(ops, opCount, NULL);
+  if(err < 0)
+  {
+    /* Not becoming the deadband references, the values are written again on the next snapshot */
+    LOG_ERR("ERROR %d: unable to write the ADC bridge snapshot", err);
+    return 0;
+  }
+
+  /* Only the queued values become the deadband references */
+  for(size_t i = 0; i < BRIDGE_MAP_COUNT; ++i)
+  {
+    if(changedMask & BIT(i))
+      lastValues[i] = newValues[i];
+  }
+
+  writtenMask |= changedMask;
+
+  return 0;
+}
+
+int datastoreAdcBridgeStart(void)
+{
+  int err;
+  AdcSubOptions_t options = {
+    .chanMask = 0,
+    .periodMs = CONFIG_ENYA_DATASTORE_ADC_BRIDGE_PERIOD_MS,
+    .format = ADC_ACQ_FORMAT_VOLT,
+  };
+
+  for(size_t i = 0; i < BRIDGE_MAP_COUNT; ++i)
+    options.chanMask |= BIT(bridgeMaps[i].chanId);
+
+  /* The snapshot packs the subscribed channels in channel order */
+  for(size_t i = 0; i < BRIDGE_MAP_COUNT; ++i)
+    valueIndexes[i] = __builtin_popcount(options.chanMask & BIT_MASK(bridgeMaps[i].chanId));
+
+  bridgeChanCount = __builtin_popcount(options.chanMask);
+  writtenMask = 0;
+
+  err = adcAcqSubscribeWithOptions(onAdcData, &options);
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to subscribe the ADC bridge to channels 0x%08x", err, options.chanMask);
+
+  return err;
+}
+
+int datastoreAdcBridgeStop(void)
+{
+  int err;
+
+  err = adcAcqUnsubscribe(onAdcData);
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to unsubscribe the ADC bridge", err);
+
+  return err;
+}
+
+int datastoreAdcBridgeSetPaused(bool isPaused)
+{
+  int err;
+
+  if(isPaused)
+    err = adcAcqPauseSubscription(onAdcData);
+  else
+    err = adcAcqUnpauseSubscription(onAdcData);
+
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to set the ADC bridge pause state", err);
+
+  return err;
+}
+
+/** @} */
@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreAdcBridge.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore ADC Bridge
+ *
+ *            Datastore ADC bridge functions, writing the filtered ADC
+ *            channels straight to float datapoints.
+ *
+ * @ingroup   datastore
+ *
+ * @{
+ */
+
+#ifndef DATASTORE_SRV_ADC_BRIDGE
+#define DATASTORE_SRV_ADC_BRIDGE
+
+#include "datastore.h"
+
+#ifndef DATASTORE_ADC_BRIDGE_CHANNELS
+#error "DATASTORE_ADC_BRIDGE_CHANNELS must be defined in datastoreMeta.h to use the ADC bridge"
+#endif
+
+/**
+ * @brief   Start the ADC bridge.
+ *
+ * @note    Subscribes to the channels of the DATASTORE_ADC_BRIDGE_CHANNELS
+ *          X-macro, the ADC acquisition service must be initialized. The
+ *          first snapshot writes every mapped datapoint.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreAdcBridgeStart(void);
+
+/**
+ * @brief   Stop the ADC bridge.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreAdcBridgeStop(void);
+
+/**
+ * @brief   Pause or unpause the ADC bridge.
+ *
+ * @note    The datastore pauses the bridge while suspended, the snapshots
+ *          being skipped instead of filling its queue.
+ *
+ * @param[in]   isPaused: The pause state.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreAdcBridgeSetPaused(bool isPaused);
+
+#endif    /* DATASTORE_SRV_ADC_BRIDGE */
+
+/** @} */
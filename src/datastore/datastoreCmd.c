@@ -27,9 +27,76 @@
  */
 K_MSGQ_DEFINE(datastoreCmdResQueue, sizeof(int), DATASTORE_MSG_COUNT, 4);
 
+/**
+ * @brief   Get the count of the registry entries forming a datapoint range.
+ *
+ * @note    The registry holds the datapoints of each type in ID order.
+ *
+ * @param[in]   registry: The datapoint registry.
+ * @param[in]   registrySize: The registry size.
+ * @param[in]   start: The first entry index.
+ * @param[in]   maxCount: The maximum range count.
+ *
+ * @return  The range count.
+ */
+static size_t getRangeCount(const DatapointEntry_t *registry, size_t registrySize, size_t start, size_t maxCount)
+{
+  size_t count = 1;
+
+  while(start + count < registrySize && count < maxCount && registry[start + count].type == registry[start].type &&
+        registry[start + count].id == registry[start].id + count)
+    ++count;
+
+  return count;
+}
+
+/**
+ * @brief   Print a datapoint table line.
+ *
+ * @param[in]   shell: The shell handle.
+ * @param[in]   entry: The datapoint entry.
+ * @param[in]   value: The datapoint value.
+ */
+static void printListLine(const struct shell *shell, const DatapointEntry_t *entry, Data_t value)
+{
+  switch(entry->type)
+  {
+    case DATAPOINT_BINARY:
+      printBinaryLine(shell, entry->id, entry->name, value.uintVal != 0);
+      break;
+
+    case DATAPOINT_BUTTON:
+      printButtonLine(shell, entry->id, entry->name, (ButtonState_t)value.uintVal);
+      break;
+
+    case DATAPOINT_FLOAT:
+      printFloatLine(shell, entry->id, entry->name, value.floatVal);
+      break;
+
+    case DATAPOINT_INT:
+      printIntLine(shell, entry->id, entry->name, value.intVal);
+      break;
+
+    case DATAPOINT_MULTI_STATE:
+      printMultiStateLine(shell, entry->id, entry->name, value.uintVal);
+      break;
+
+    case DATAPOINT_UINT:
+      printUintLine(shell, entry->id, entry->name, value.uintVal);
+      break;
+
+    default:
+      shell_print(shell, "%-3u %-40s %-15s %s", entry->id, entry->name, getTypeName(entry->type), "UNKNOWN TYPE");
+      break;
+  }
+}
+
 /**
  * @brief   Execute the list command.
  *
+ * @note    The datapoints are read one range at a time, each range holding
+ *          up to CONFIG_ENYA_DATASTORE_BUFFER_SIZE datapoints of a type.
+ *
  * @param[in]   shell: The shell handle.
  * @param[in]   argc: Argument count.
  * @param[in]   argv: Argument vector.
@@ -39,57 +106,97 @@ K_MSGQ_DEFINE(datastoreCmdResQueue, sizeof(int), DATASTORE_MSG_COUNT, 4);
 static int execList(const struct shell *shell, size_t argc, char **argv)
 {
   int err;
-  Data_t value;
+  size_t valCount;
+  Data_t values[CONFIG_ENYA_DATASTORE_BUFFER_SIZE];
   const DatapointEntry_t *registry = getDatapointRegistry();
   size_t registrySize              = getDatapointRegistrySize();
 
   printTableHeader(shell);
 
-  for(size_t i = 0; i < registrySize; i++)
+  for(size_t i = 0; i < registrySize; i += valCount)
   {
-    const DatapointEntry_t *entry = &registry[i];
+    valCount = getRangeCount(registry, registrySize, i, CONFIG_ENYA_DATASTORE_BUFFER_SIZE);
 
-    err = datastoreRead(entry->type, entry->id, 1, &datastoreCmdResQueue, &value);
-    if(err < 0)
-    {
-      shell_print(shell, "%-3u %-40s %-15s %s", entry->id, entry->name, getTypeName(entry->type), "ERROR");
-      continue;
-    }
+    err = datastoreRead(registry[i].type, registry[i].id, valCount, &datastoreCmdResQueue, values);
 
-    switch(entry->type)
+    for(size_t j = 0; j < valCount; ++j)
     {
-      case DATAPOINT_BINARY:
-        printBinaryLine(shell, entry->id, entry->name, ((uint8_t *)&value)[0]);
-        break;
+      const DatapointEntry_t *entry = &registry[i + j];
 
-      case DATAPOINT_BUTTON:
-        printButtonLine(shell, entry->id, entry->name, ((ButtonState_t *)&value)[0]);
-        break;
+      if(err < 0)
+        shell_print(shell, "%-3u %-40s %-15s %s", entry->id, entry->name, getTypeName(entry->type), "ERROR");
+      else
+        printListLine(shell, entry, values[j]);
+    }
+  }
 
-      case DATAPOINT_FLOAT:
-        printFloatLine(shell, entry->id, entry->name, ((float *)&value)[0]);
-        break;
+  return 0;
+}
 
-      case DATAPOINT_INT:
-        printIntLine(shell, entry->id, entry->name, ((int32_t *)&value)[0]);
-        break;
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+/**
+ * @brief   Execute the dump command.
+ *
+ * @note    The datapoints are read in batches of up to
+ *          CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS ranges and
+ *          CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES values, each batch being
+ *          printed before the next one is read. Each batch is a coherent
+ *          snapshot of its datapoints.
+ *
+ * @param[in]   shell: The shell handle.
+ * @param[in]   argc: Argument count.
+ * @param[in]   argv: Argument vector.
+ *
+ * @return  0 if successful, error code otherwise.
+ */
+static int execDump(const struct shell *shell, size_t argc, char **argv)
+{
+  int err;
+  size_t first;
+  size_t next = 0;
+  size_t opCount;
+  size_t valTotal;
+  Data_t values[CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES];
+  DatastoreBatchOp_t ops[CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS];
+  const DatapointEntry_t *registry = getDatapointRegistry();
+  size_t registrySize              = getDatapointRegistrySize();
 
-      case DATAPOINT_MULTI_STATE:
-        printMultiStateLine(shell, entry->id, entry->name, ((uint32_t *)&value)[0]);
-        break;
+  while(next < registrySize)
+  {
+    first = next;
+    opCount = 0;
+    valTotal = 0;
 
-      case DATAPOINT_UINT:
-        printUintLine(shell, entry->id, entry->name, ((uint32_t *)&value)[0]);
-        break;
+    while(next < registrySize && opCount < CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS &&
+          valTotal < CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES)
+    {
+      ops[opCount].opType = DATASTORE_BATCH_READ;
+      ops[opCount].datapointType = registry[next].type;
+      ops[opCount].datapointId = registry[next].id;
+      ops[opCount].valCount = getRangeCount(registry, registrySize, next,
+                                            CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES - valTotal);
+      ops[opCount].values = values + valTotal;
+
+      valTotal += ops[opCount].valCount;
+      next += ops[opCount].valCount;
+      ++opCount;
+    }
 
-      default:
-        shell_print(shell, "%-3u %-40s %-15s %s", entry->id, entry->name, getTypeName(entry->type), "UNKNOWN TYPE");
-        break;
+    err = datastoreBatch(ops, opCount, &datastoreCmdResQueue);
+    if(err < 0)
+    {
+      shell_error(shell, "FAIL %d: batch read failed at %s", err, registry[first].name);
+      return err;
     }
+
+    for(size_t i = 0; i < valTotal; ++i)
+      printDatapointValue(shell, registry + first + i, values[i]);
   }
 
+  shell_info(shell, "SUCCESS: dumped %zu datapoint(s)", registrySize);
   return 0;
 }
+#endif
 
 /**
  * @brief   Execute the read command.
@@ -276,6 +383,95 @@ static int execWrite(const struct shell *shell, size_t argc, char **argv)
   return 0;
 }
 
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+/**
+ * @brief   The buffer pool names.
+ */
+static const char *const poolNames[DATASTORE_POOL_COUNT] = {"small", "medium", "large", "notify"};
+
+/**
+ * @brief   Print the operation service time histogram.
+ *
+ * @param[in]   shell: The shell handle.
+ * @param[in]   stats: The datastore statistics.
+ */
+static void printServiceTimeHist(const struct shell *shell, const DatastoreStats_t *stats)
+{
+  shell_print(shell, "  %-16s %u", "< 1 us", stats->serviceTimeHist[0]);
+
+  for(uint32_t i = 1; i < DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT - 1; ++i)
+    shell_print(shell, "  %5u - %-5u us %u", (uint32_t)BIT(i - 1), (uint32_t)BIT(i) - 1, stats->serviceTimeHist[i]);
+
+  shell_print(shell, "  >= %-5u us      %u", (uint32_t)BIT(DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT - 2),
+              stats->serviceTimeHist[DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT - 1]);
+}
+
+/**
+ * @brief   Execute the statistics command.
+ *
+ * @param[in]   shell: The shell handle.
+ * @param[in]   argc: Argument count.
+ * @param[in]   argv: Argument vector (argv[1] is the optional reset).
+ *
+ * @return  0 if successful, error code otherwise.
+ */
+static int execStats(const struct shell *shell, size_t argc, char **argv)
+{
+  int err;
+  DatastoreStats_t stats;
+  DatastorePoolStats_t poolStats;
+
+  if(argc >= 2)
+  {
+    if(strcmp(argv[1], "reset") != 0)
+    {
+      shell_error(shell, "FAIL %d: unknown option '%s'", -EINVAL, argv[1]);
+      return -EINVAL;
+    }
+
+    datastoreResetStats();
+    shell_info(shell, "SUCCESS: statistics reset");
+    return 0;
+  }
+
+  err = datastoreGetStats(&stats);
+  if(err < 0)
+  {
+    shell_error(shell, "FAIL %d: unable to get the statistics", err);
+    return err;
+  }
+
+  shell_print(shell, "Statistics over %lld ms", (long long)stats.elapsedMs);
+  shell_print(shell, "Queue high water: %u/%u", stats.queueHighWater, DATASTORE_MSG_COUNT);
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+  shell_print(shell, "Background queue high water: %u/%u", stats.bgQueueHighWater,
+              CONFIG_ENYA_DATASTORE_BACKGROUND_MSG_COUNT);
+#endif
+  shell_print(shell, "Operations: %u, max service time: %u us", stats.opCount, stats.serviceTimeMaxUs);
+  printServiceTimeHist(shell, &stats);
+
+  shell_print(shell, "Notifications:");
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+    shell_print(shell, "  %-15s %u (%u/s)", getTypeName(type), stats.notifyCounts[type],
+                stats.elapsedMs > 0 ? (uint32_t)(stats.notifyCounts[type] * 1000LL / stats.elapsedMs) : 0);
+
+  shell_print(shell, "Notification allocation failures: %u", stats.notifyAllocFailures);
+  shell_print(shell, "Response timeouts: %u", stats.responseTimeouts);
+
+  shell_print(shell, "Buffer pools:");
+  for(uint32_t pool = 0; pool < DATASTORE_POOL_COUNT; ++pool)
+  {
+    if(datastoreGetPoolStats(pool, &poolStats) < 0)
+      continue;
+
+    shell_print(shell, "  %-6s %u/%u used, high water %u", poolNames[pool], poolStats.usedCount,
+                poolStats.blockCount, poolStats.highWater);
+  }
+
+  return 0;
+}
+#endif
+
 /* Generate read subcommands using X-macros */
 #define X(name, flags, defaultVal) SHELL_CMD_ARG(name, NULL, "Read " STRINGIFY(name) " [count]", execRead, 1, 1),
 
@@ -297,8 +493,13 @@ SHELL_STATIC_SUBCMD_SET_CREATE(write_sub, DATASTORE_BINARY_DATAPOINTS DATASTORE_
 
 /* Main datastore command */
 SHELL_STATIC_SUBCMD_SET_CREATE(datastore_sub, SHELL_CMD(ls, NULL, "List all datapoints", execList),
+                               SHELL_COND_CMD(CONFIG_ENYA_DATASTORE_BATCH, dump, NULL,
+                                              "Dump all datapoint values in batched reads", execDump),
                                SHELL_CMD(read, &read_sub, "Read datapoint value(s)", NULL),
-                               SHELL_CMD(write, &write_sub, "Write datapoint value(s)", NULL), SHELL_SUBCMD_SET_END);
+                               SHELL_CMD(write, &write_sub, "Write datapoint value(s)", NULL),
+                               SHELL_COND_CMD_ARG(CONFIG_ENYA_DATASTORE_STATS, stats, NULL,
+                                                  "Show the datastore statistics [reset]", execStats, 1, 1),
+                               SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_REGISTER(ds, &datastore_sub, "Datastore commands.", NULL);
 
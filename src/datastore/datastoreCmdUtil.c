@@ -75,6 +75,48 @@ static const DatapointEntry_t datapointRegistry[] = {
 
 #define DATAPOINT_REGISTRY_SIZE ARRAY_SIZE(datapointRegistry)
 
+BUILD_ASSERT(DATAPOINT_REGISTRY_SIZE <= UINT16_MAX, "the datapoint name index holds 16-bit registry indexes");
+
+/**
+ * @brief   The registry indexes sorted by datapoint name.
+ * @note    Built on the first lookup, the preprocessor not being able to sort
+ *          the names.
+ */
+static uint16_t nameIndex[DATAPOINT_REGISTRY_SIZE];
+
+/**
+ * @brief   The name index built flag.
+ */
+static bool isNameIndexBuilt = false;
+
+/**
+ * @brief   Compare two registry indexes by datapoint name.
+ *
+ * @param[in]   a: The first registry index.
+ * @param[in]   b: The second registry index.
+ *
+ * @return  The name comparison result.
+ */
+static int compareNameIndexes(const void *a, const void *b)
+{
+  return strcmp(datapointRegistry[*(const uint16_t *)a].name, datapointRegistry[*(const uint16_t *)b].name);
+}
+
+/**
+ * @brief   Build the name index once.
+ */
+static void buildNameIndex(void)
+{
+  if(isNameIndexBuilt)
+    return;
+
+  for(size_t i = 0; i < DATAPOINT_REGISTRY_SIZE; ++i)
+    nameIndex[i] = (uint16_t)i;
+
+  qsort(nameIndex, DATAPOINT_REGISTRY_SIZE, sizeof(nameIndex[0]), compareNameIndexes);
+  isNameIndexBuilt = true;
+}
+
 const DatapointEntry_t *getDatapointRegistry(void)
 {
   return datapointRegistry;
@@ -342,16 +384,57 @@ int parseUintValues(char **valStrings, size_t valCount, Data_t *values)
   return 0;
 }
 
+void printDatapointValue(const struct shell *shell, const DatapointEntry_t *entry, Data_t value)
+{
+  char buffer[VALUE_STRING_MAX_LENGTH];
+
+  switch (entry->type)
+  {
+    case DATAPOINT_BINARY:
+      shell_print(shell, "%s = %s", entry->name, value.uintVal ? TRUE_STR : FALSE_STR);
+      break;
+    case DATAPOINT_BUTTON:
+      shell_print(shell, "%s = %s", entry->name, getButtonValueString((ButtonState_t)value.uintVal));
+      break;
+    case DATAPOINT_FLOAT:
+      snprintf(buffer, sizeof(buffer), "%.6f", (double)value.floatVal);
+      shell_print(shell, "%s = %s", entry->name, buffer);
+      break;
+    case DATAPOINT_INT:
+      shell_print(shell, "%s = %d", entry->name, value.intVal);
+      break;
+    default:
+      shell_print(shell, "%s = %u", entry->name, value.uintVal);
+      break;
+  }
+}
+
 int findDatapointByName(const char *name, const DatapointEntry_t **entry)
 {
-  for (size_t i = 0; i < DATAPOINT_REGISTRY_SIZE; i++)
+  int cmp;
+  size_t low = 0;
+  size_t high = DATAPOINT_REGISTRY_SIZE;
+  size_t middle;
+
+  buildNameIndex();
+
+  /* Binary search of the sorted name index */
+  while (low < high)
   {
-    if (strcmp(datapointRegistry[i].name, name) == 0)
+    middle = low + (high - low) / 2;
+    cmp = strcmp(datapointRegistry[nameIndex[middle]].name, name);
+    if (cmp == 0)
     {
-      *entry = &datapointRegistry[i];
+      *entry = &datapointRegistry[nameIndex[middle]];
       return 0;
     }
+
+    if (cmp < 0)
+      low = middle + 1;
+    else
+      high = middle;
   }
+
   return -ENOENT;
 }
 
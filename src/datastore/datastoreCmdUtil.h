@@ -298,9 +298,20 @@ int parseMultiStateValues(char **valStrings, size_t valCount, Data_t *values);
  */
 int parseUintValues(char **valStrings, size_t valCount, Data_t *values);
 
+/**
+ * @brief   Print a datapoint value as NAME = value.
+ *
+ * @param[in]   shell: The shell instance.
+ * @param[in]   entry: The datapoint entry.
+ * @param[in]   value: The datapoint value.
+ */
+void printDatapointValue(const struct shell *shell, const DatapointEntry_t *entry, Data_t value);
+
 /**
  * @brief   Find datapoint entry by name.
  *
+ * @note    Binary search of a name index sorted on the first call.
+ *
  * @param[in]   name: The datapoint name to search for.
  * @param[out]  entry: Pointer to store the found entry.
  *
@@ -0,0 +1,463 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreHistory.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore History Implementation
+ *
+ *            Datastore history implementation. Each datapoint with history
+ *            owns a sample ring along with two monotonic queues of its
+ *            minimum and maximum candidates, so the aggregates are updated
+ *            in amortized constant time on each record.
+ *
+ * @ingroup   datastore
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "datastoreHistory.h"
+
+/* Setting module logging */
+LOG_MODULE_DECLARE(DATASTORE_LOGGER_NAME);
+
+/**
+ * @brief   The history index of a datapoint without history.
+ */
+#define HISTORY_NONE                    UINT16_MAX
+
+/**
+ * @brief   Get the depth field of datapoint flags.
+ */
+#define HISTORY_DEPTH_FIELD(optFlags)   (((uint32_t)(optFlags) >> DATAPOINT_HISTORY_DEPTH_SHIFT) & 0xFFFF)
+
+/**
+ * @brief   Get the history depth of datapoint flags, 0 without history.
+ */
+#define HISTORY_DEPTH(optFlags)                                                                 \
+  (((optFlags) & DATAPOINT_FLAG_HISTORY_MASK) == 0 ? 0 :                                        \
+   HISTORY_DEPTH_FIELD(optFlags) != 0 ? HISTORY_DEPTH_FIELD(optFlags) :                         \
+   CONFIG_ENYA_DATASTORE_HISTORY_DEFAULT_DEPTH)
+
+/**
+ * @brief   All the datapoints of the X-macro datapoint lists.
+ */
+#define HISTORY_ALL_DATAPOINTS                                                                  \
+  DATASTORE_BINARY_DATAPOINTS DATASTORE_BUTTON_DATAPOINTS DATASTORE_FLOAT_DATAPOINTS           \
+  DATASTORE_INT_DATAPOINTS DATASTORE_MULTI_STATE_DATAPOINTS DATASTORE_UINT_DATAPOINTS
+
+/**
+ * @brief   The history of a datapoint.
+ * @note    The queues hold sample slots, oldest first, the front of each
+ *          one being the slot of the minimum or maximum sample.
+ */
+typedef struct
+{
+  DatastoreHistorySample_t *samples;    /**< The sample ring. */
+  uint16_t *minQueue;                   /**< The ascending minimum candidate slots. */
+  uint16_t *maxQueue;                   /**< The descending maximum candidate slots. */
+  double sum;                           /**< The value sum. */
+  uint16_t depth;                       /**< The ring depth. */
+  uint16_t head;                        /**< The oldest sample slot. */
+  uint16_t count;                       /**< The sample count. */
+  uint16_t minHead;                     /**< The minimum queue front. */
+  uint16_t minCount;                    /**< The minimum queue count. */
+  uint16_t maxHead;                     /**< The maximum queue front. */
+  uint16_t maxCount;                    /**< The maximum queue count. */
+} DatastoreHistory_t;
+
+/**
+ * @brief   The history depth of the datapoints of each value type.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+#define X(id, optFlags, defaultVal) HISTORY_DEPTH(optFlags),
+static const uint16_t binaryDepths[] = {DATASTORE_BINARY_DATAPOINTS};
+static const uint16_t buttonDepths[] = {DATASTORE_BUTTON_DATAPOINTS};
+static const uint16_t floatDepths[] = {DATASTORE_FLOAT_DATAPOINTS};
+static const uint16_t intDepths[] = {DATASTORE_INT_DATAPOINTS};
+static const uint16_t multiStateDepths[] = {DATASTORE_MULTI_STATE_DATAPOINTS};
+static const uint16_t uintDepths[] = {DATASTORE_UINT_DATAPOINTS};
+#undef X
+
+/**
+ * @brief   The depth table of each value type.
+ */
+static const uint16_t *const historyDepths[DATAPOINT_TYPE_COUNT] = {binaryDepths, buttonDepths, floatDepths,
+                                                                   intDepths, multiStateDepths, uintDepths};
+
+/**
+ * @brief   The history index of the datapoints of each value type.
+ */
+#define X(Name, name, TYPE, label, valueType) static uint16_t name##HistoryIndexes[TYPE##_DATAPOINT_COUNT];
+DATASTORE_VALUE_TYPES
+#undef X
+
+/**
+ * @brief   The history index table of each value type.
+ */
+static uint16_t *const historyIndexes[DATAPOINT_TYPE_COUNT] = {
+#define X(Name, name, TYPE, label, valueType) name##HistoryIndexes,
+  DATASTORE_VALUE_TYPES
+#undef X
+};
+
+/**
+ * @brief   The datapoint count of each value type.
+ */
+static const size_t datapointCounts[DATAPOINT_TYPE_COUNT] = {
+#define X(Name, name, TYPE, label, valueType) TYPE##_DATAPOINT_COUNT,
+  DATASTORE_VALUE_TYPES
+#undef X
+};
+
+/**
+ * @brief   The sample and queue pools, sized from the history depths.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+#define X(id, optFlags, defaultVal) + HISTORY_DEPTH(optFlags)
+static DatastoreHistorySample_t samplePool[0 HISTORY_ALL_DATAPOINTS];
+static uint16_t minQueuePool[0 HISTORY_ALL_DATAPOINTS];
+static uint16_t maxQueuePool[0 HISTORY_ALL_DATAPOINTS];
+#undef X
+
+/**
+ * @brief   The datapoint histories.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+#define X(id, optFlags, defaultVal) + (HISTORY_DEPTH(optFlags) > 0 ? 1 : 0)
+static DatastoreHistory_t histories[0 HISTORY_ALL_DATAPOINTS];
+#undef X
+
+BUILD_ASSERT(ARRAY_SIZE(histories) > 0, "no datapoint is flagged with DATAPOINT_FLAG_HISTORY_MASK");
+
+/**
+ * @brief   The history lock, guarding the records against the queries.
+ */
+static struct k_spinlock historyLock;
+
+/**
+ * @brief   Compare two values of a datapoint type.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   a: The first value.
+ * @param[in]   b: The second value.
+ *
+ * @return  A negative value if a < b, 0 if a == b, a positive value otherwise.
+ */
+static inline int compareValues(DatapointType_t type, Data_t a, Data_t b)
+{
+  switch(type)
+  {
+    case DATAPOINT_FLOAT:
+      return (a.floatVal > b.floatVal) - (a.floatVal < b.floatVal);
+    case DATAPOINT_INT:
+      return (a.intVal > b.intVal) - (a.intVal < b.intVal);
+    default:
+      return (a.uintVal > b.uintVal) - (a.uintVal < b.uintVal);
+  }
+}
+
+/**
+ * @brief   Convert a value of a datapoint type to a sum term.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   value: The value.
+ *
+ * @return  The sum term.
+ */
+static inline double toSumTerm(DatapointType_t type, Data_t value)
+{
+  switch(type)
+  {
+    case DATAPOINT_FLOAT:
+      return (double)value.floatVal;
+    case DATAPOINT_INT:
+      return (double)value.intVal;
+    default:
+      return (double)value.uintVal;
+  }
+}
+
+/**
+ * @brief   Get the history of a datapoint.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ *
+ * @return  The history, NULL if the datapoint has none.
+ */
+static inline DatastoreHistory_t *getHistory(DatapointType_t type, uint32_t datapointId)
+{
+  uint16_t index;
+
+  if(type >= DATAPOINT_TYPE_COUNT || datapointId >= datapointCounts[type])
+    return NULL;
+
+  index = historyIndexes[type][datapointId];
+
+  return index == HISTORY_NONE ? NULL : histories + index;
+}
+
+/**
+ * @brief   Push a sample slot to the back of a monotonic queue.
+ *
+ * @note    The candidates the new sample outlives and beats, or equals, are
+ *          dropped first.
+ *
+ * @param[in]       type: The datapoint type.
+ * @param[in,out]   history: The history.
+ * @param[in,out]   queue: The queue.
+ * @param[in]       queueHead: The queue front.
+ * @param[in,out]   queueCount: The queue count.
+ * @param[in]       slot: The new sample slot.
+ * @param[in]       order: 1 for the minimum queue, -1 for the maximum one.
+ */
+static void pushCandidate(DatapointType_t type, DatastoreHistory_t *history, uint16_t *queue, uint16_t queueHead,
+                          uint16_t *queueCount, uint16_t slot, int order)
+{
+  uint16_t back;
+
+  while(*queueCount > 0)
+  {
+    back = queue[(queueHead + *queueCount - 1) % history->depth];
+    if(compareValues(type, history->samples[back].value, history->samples[slot].value) * order < 0)
+      break;
+
+    --*queueCount;
+  }
+
+  queue[(queueHead + *queueCount) % history->depth] = slot;
+  ++*queueCount;
+}
+
+/**
+ * @brief   Drop the oldest sample of a full history.
+ *
+ * @param[in]       type: The datapoint type.
+ * @param[in,out]   history: The history.
+ *
+ * @return  The freed sample slot.
+ */
+static uint16_t dropOldest(DatapointType_t type, DatastoreHistory_t *history)
+{
+  uint16_t slot = history->head;
+
+  history->sum -= toSumTerm(type, history->samples[slot].value);
+
+  /* The oldest sample can only be the front candidate */
+  if(history->minCount > 0 && history->minQueue[history->minHead] == slot)
+  {
+    history->minHead = (history->minHead + 1) % history->depth;
+    --history->minCount;
+  }
+
+  if(history->maxCount > 0 && history->maxQueue[history->maxHead] == slot)
+  {
+    history->maxHead = (history->maxHead + 1) % history->depth;
+    --history->maxCount;
+  }
+
+  history->head = (history->head + 1) % history->depth;
+  --history->count;
+
+  return slot;
+}
+
+/**
+ * @brief   Compute the value sum of a history from its samples.
+ *
+ * @note    Bounds the float rounding drift of the running sum.
+ *
+ * @param[in]       type: The datapoint type.
+ * @param[in,out]   history: The history.
+ */
+static void resumHistory(DatapointType_t type, DatastoreHistory_t *history)
+{
+  history->sum = 0;
+
+  for(uint16_t i = 0; i < history->count; ++i)
+    history->sum += toSumTerm(type, history->samples[(history->head + i) % history->depth].value);
+}
+
+/**
+ * @brief   Check if a sample timestamp is in a time range.
+ *
+ * @note    Compares the uptime differences, robust to the uptime wrap.
+ *
+ * @param[in]   timestampMs: The sample timestamp [ms].
+ * @param[in]   fromMs: The range start [ms].
+ * @param[in]   toMs: The range end [ms], included.
+ *
+ * @return  true if the sample is in the range, false otherwise.
+ */
+static inline bool isInTimeRange(uint32_t timestampMs, uint32_t fromMs, uint32_t toMs)
+{
+  return (int32_t)(timestampMs - fromMs) >= 0 && (int32_t)(toMs - timestampMs) >= 0;
+}
+
+int datastoreHistoryInit(void)
+{
+  size_t sampleOffset = 0;
+  uint16_t historyCount = 0;
+  DatastoreHistory_t *history;
+
+  for(size_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    for(size_t i = 0; i < datapointCounts[type]; ++i)
+    {
+      historyIndexes[type][i] = HISTORY_NONE;
+      if(historyDepths[type][i] == 0)
+        continue;
+
+      history = histories + historyCount;
+      history->samples = samplePool + sampleOffset;
+      history->minQueue = minQueuePool + sampleOffset;
+      history->maxQueue = maxQueuePool + sampleOffset;
+      history->depth = historyDepths[type][i];
+      history->sum = 0;
+      history->head = 0;
+      history->count = 0;
+      history->minHead = 0;
+      history->minCount = 0;
+      history->maxHead = 0;
+      history->maxCount = 0;
+
+      historyIndexes[type][i] = historyCount++;
+      sampleOffset += history->depth;
+    }
+  }
+
+  LOG_INF("created %d datapoint histories of %zu samples", historyCount, sampleOffset);
+
+  return 0;
+}
+
+void datastoreHistoryRecord(DatapointType_t type, uint32_t datapointId, Data_t value, uint32_t timestampMs)
+{
+  uint16_t slot;
+  k_spinlock_key_t key;
+  DatastoreHistory_t *history = getHistory(type, datapointId);
+
+  if(!history)
+    return;
+
+  key = k_spin_lock(&historyLock);
+
+  if(history->count == history->depth)
+    slot = dropOldest(type, history);
+  else
+    slot = (history->head + history->count) % history->depth;
+
+  history->samples[slot].timestampMs = timestampMs;
+  history->samples[slot].value = value;
+  ++history->count;
+
+  pushCandidate(type, history, history->minQueue, history->minHead, &history->minCount, slot, 1);
+  pushCandidate(type, history, history->maxQueue, history->maxHead, &history->maxCount, slot, -1);
+
+  /* A float ring recomputes its sum once per lap */
+  if(type == DATAPOINT_FLOAT && slot == history->depth - 1)
+    resumHistory(type, history);
+  else
+    history->sum += toSumTerm(type, value);
+
+  k_spin_unlock(&historyLock, key);
+}
+
+int datastoreHistoryRead(DatapointType_t type, uint32_t datapointId, uint32_t fromMs, uint32_t toMs,
+                         DatastoreHistorySample_t samples[], size_t maxCount)
+{
+  int err;
+  size_t skipCount;
+  size_t copyCount = 0;
+  size_t rangeCount = 0;
+  k_spinlock_key_t key;
+  DatastoreHistorySample_t *sample;
+  DatastoreHistory_t *history;
+
+  if(!samples || maxCount == 0)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid history read parameters", err);
+    return err;
+  }
+
+  history = getHistory(type, datapointId);
+  if(!history)
+  {
+    err = -ENOENT;
+    LOG_ERR("ERROR %d: no history for datapoint %d of type %d", err, datapointId, type);
+    return err;
+  }
+
+  key = k_spin_lock(&historyLock);
+
+  for(uint16_t i = 0; i < history->count; ++i)
+  {
+    if(isInTimeRange(history->samples[(history->head + i) % history->depth].timestampMs, fromMs, toMs))
+      ++rangeCount;
+  }
+
+  /* Only the newest samples fit */
+  skipCount = rangeCount > maxCount ? rangeCount - maxCount : 0;
+
+  for(uint16_t i = 0; i < history->count && copyCount < maxCount; ++i)
+  {
+    sample = history->samples + (history->head + i) % history->depth;
+    if(!isInTimeRange(sample->timestampMs, fromMs, toMs))
+      continue;
+
+    if(skipCount > 0)
+      --skipCount;
+    else
+      samples[copyCount++] = *sample;
+  }
+
+  k_spin_unlock(&historyLock, key);
+
+  return (int)copyCount;
+}
+
+int datastoreHistoryGetStats(DatapointType_t type, uint32_t datapointId, DatastoreHistoryStats_t *stats)
+{
+  int err = 0;
+  k_spinlock_key_t key;
+  DatastoreHistory_t *history;
+
+  if(!stats)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid history stats buffer", err);
+    return err;
+  }
+
+  history = getHistory(type, datapointId);
+  if(!history)
+  {
+    err = -ENOENT;
+    LOG_ERR("ERROR %d: no history for datapoint %d of type %d", err, datapointId, type);
+    return err;
+  }
+
+  key = k_spin_lock(&historyLock);
+
+  if(history->count == 0)
+  {
+    err = -ENODATA;
+  }
+  else
+  {
+    stats->count = history->count;
+    stats->min = history->samples[history->minQueue[history->minHead]].value;
+    stats->max = history->samples[history->maxQueue[history->maxHead]].value;
+    stats->sum = history->sum;
+  }
+
+  k_spin_unlock(&historyLock, key);
+
+  return err;
+}
+
+/** @} */
@@ -0,0 +1,107 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreHistory.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore History
+ *
+ *            Datastore history functions, recording the written values of
+ *            the datapoints flagged with DATAPOINT_FLAG_HISTORY_MASK into
+ *            ring buffers.
+ *
+ * @ingroup   datastore
+ *
+ * @{
+ */
+
+#ifndef DATASTORE_SRV_HISTORY
+#define DATASTORE_SRV_HISTORY
+
+#include "datastore.h"
+
+/**
+ * @brief   The history sample.
+ */
+typedef struct
+{
+  uint32_t timestampMs;                 /**< The write uptime [ms]. */
+  Data_t value;                         /**< The written value. */
+} DatastoreHistorySample_t;
+
+/**
+ * @brief   The history aggregates.
+ * @note    The values follow the datapoint type, the binaries and buttons
+ *          comparing as unsigned integers.
+ */
+typedef struct
+{
+  size_t count;                         /**< The sample count. */
+  Data_t min;                           /**< The minimum value. */
+  Data_t max;                           /**< The maximum value. */
+  double sum;                           /**< The value sum. */
+} DatastoreHistoryStats_t;
+
+/**
+ * @brief   Initialize the histories.
+ *
+ * @note    The sample ring of each datapoint with history is carved from a
+ *          static pool sized from datastoreMeta.h.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreHistoryInit(void);
+
+/**
+ * @brief   Record a written value in the history of its datapoint.
+ *
+ * @note    Called by the datastore thread for each written value, a
+ *          datapoint without history being ignored. The oldest sample is
+ *          dropped once the ring is full.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   value: The written value.
+ * @param[in]   timestampMs: The write uptime [ms].
+ */
+void datastoreHistoryRecord(DatapointType_t type, uint32_t datapointId, Data_t value, uint32_t timestampMs);
+
+/**
+ * @brief   Read the history samples of a datapoint recorded in a time range.
+ *
+ * @note    The samples are copied oldest first. When the range holds more
+ *          than maxCount samples, the newest ones are copied. This function
+ *          can be called from any thread.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   fromMs: The range start uptime [ms].
+ * @param[in]   toMs: The range end uptime [ms], included.
+ * @param[out]  samples: The samples.
+ * @param[in]   maxCount: The maximum sample count.
+ *
+ * @return  The copied sample count if successful, -EINVAL if an argument is
+ *          invalid, -ENOENT if the datapoint has no history.
+ */
+int datastoreHistoryRead(DatapointType_t type, uint32_t datapointId, uint32_t fromMs, uint32_t toMs,
+                         DatastoreHistorySample_t samples[], size_t maxCount);
+
+/**
+ * @brief   Get the aggregates of the history of a datapoint.
+ *
+ * @note    The aggregates are maintained on each record, so this function
+ *          does not scan the samples. This function can be called from any
+ *          thread.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[out]  stats: The history aggregates.
+ *
+ * @return  0 if successful, -EINVAL if an argument is invalid, -ENOENT if
+ *          the datapoint has no history, -ENODATA if its history is empty.
+ */
+int datastoreHistoryGetStats(DatapointType_t type, uint32_t datapointId, DatastoreHistoryStats_t *stats);
+
+#endif    /* DATASTORE_SRV_HISTORY */
+
+/** @} */
@@ -0,0 +1,322 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreNvm.c
+ * @author    jbacon
+ * @date      2026-03-23
+ * @brief     Datastore NVM Persistence Implementation
+ *
+ *            Datastore NVM persistence implementation. The persisted values
+ *            of each type are journaled in RAM and written behind as one
+ *            settings record per type.
+ *
+ * @ingroup   datastore
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/atomic.h>
+#include <string.h>
+
+#include "datastoreNvm.h"
+#include "datastoreUtil.h"
+
+/* Setting module logging */
+LOG_MODULE_DECLARE(DATASTORE_LOGGER_NAME);
+
+/**
+ * @brief   The settings key of each value type.
+ */
+static const char *const nvmKeys[DATAPOINT_TYPE_COUNT] = {
+  DATASTORE_NVM_SUBTREE "/binary",
+  DATASTORE_NVM_SUBTREE "/button",
+  DATASTORE_NVM_SUBTREE "/float",
+  DATASTORE_NVM_SUBTREE "/int",
+  DATASTORE_NVM_SUBTREE "/multiState",
+  DATASTORE_NVM_SUBTREE "/uint",
+};
+
+/**
+ * @brief   The journal of the persisted values of all types.
+ */
+static Data_t *journal = NULL;
+
+/**
+ * @brief   The journal offset of each value type.
+ */
+static size_t journalOffsets[DATAPOINT_TYPE_COUNT];
+
+/**
+ * @brief   The persisted datapoint count of each value type.
+ */
+static size_t nvmCounts[DATAPOINT_TYPE_COUNT];
+
+/**
+ * @brief   The value types staged in the journal for the ongoing flush.
+ */
+static uint32_t stagedTypes = 0;
+
+/**
+ * @brief   The value types to flush again after a failed save.
+ */
+static atomic_t retryTypes = ATOMIC_INIT(0);
+
+/**
+ * @brief   The ongoing flush flag.
+ */
+static atomic_t isFlushing = ATOMIC_INIT(0);
+
+/**
+ * @brief   The flush request flag.
+ */
+static atomic_t isFlushRequested = ATOMIC_INIT(0);
+
+/**
+ * @brief   The last flush uptime [ms].
+ */
+static int64_t lastFlushMs = 0;
+
+/**
+ * @brief   Save the staged journal records and end the flush.
+ *
+ * @return  0 if successful, the last save error code otherwise.
+ */
+static int saveStagedRecords(void)
+{
+  int err;
+  int result = 0;
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    if(!(stagedTypes & BIT(type)))
+      continue;
+
+    err = settings_save_one(nvmKeys[type], journal + journalOffsets[type], nvmCounts[type] * sizeof(Data_t));
+    if(err < 0)
+    {
+      LOG_ERR("ERROR %d: unable to save the datapoint type %d record", err, type);
+      atomic_or(&retryTypes, BIT(type));
+      result = err;
+    }
+  }
+
+  atomic_clear(&isFlushing);
+
+  return result;
+}
+
+/**
+ * @brief   Save the staged journal records.
+ *
+ * @note    Runs in the system work queue, off the datastore thread.
+ *
+ * @param[in]   work: The work item.
+ */
+static void saveJournal(struct k_work *work)
+{
+  ARG_UNUSED(work);
+
+  saveStagedRecords();
+}
+
+/**
+ * @brief   Stage the snapshot of the changed persisted datapoints.
+ *
+ * @param[in]   now: The current uptime [ms].
+ *
+ * @return  The staged types.
+ */
+static uint32_t stageJournal(int64_t now)
+{
+  uint32_t types;
+
+  types = datastoreUtilGetNvmDirtyTypes() | (uint32_t)atomic_clear(&retryTypes);
+  if(types == 0)
+    return 0;
+
+  lastFlushMs = now;
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    if(types & BIT(type))
+      datastoreUtilSnapshotNvm(type, journal + journalOffsets[type]);
+  }
+
+  stagedTypes = types;
+  atomic_set(&isFlushing, 1);
+
+  return types;
+}
+
+/**
+ * @brief   The journal save work.
+ */
+static K_WORK_DEFINE(saveWork, saveJournal);
+
+/**
+ * @brief   Get the value type of a settings key.
+ *
+ * @param[in]   key: The settings key, relative to the datastore subtree.
+ *
+ * @return  The value type if found, DATAPOINT_TYPE_COUNT otherwise.
+ */
+static DatapointType_t getKeyType(const char *key)
+{
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    /* Skip the subtree and its separator */
+    if(strcmp(key, nvmKeys[type] + sizeof(DATASTORE_NVM_SUBTREE)) == 0)
+      return type;
+  }
+
+  return DATAPOINT_TYPE_COUNT;
+}
+
+/**
+ * @brief   Restore a settings record in its value type.
+ *
+ * @param[in]   key: The settings key, relative to the datastore subtree.
+ * @param[in]   len: The record length.
+ * @param[in]   readCb: The record read callback.
+ * @param[in]   cbArg: The read callback argument.
+ * @param[in]   param: The load parameter.
+ *
+ * @return  0 to continue the loading, the error code otherwise.
+ */
+static int restoreRecord(const char *key, size_t len, settings_read_cb readCb, void *cbArg, void *param)
+{
+  ssize_t readLen;
+  DatapointType_t type;
+
+  ARG_UNUSED(param);
+
+  type = getKeyType(key);
+  if(type == DATAPOINT_TYPE_COUNT)
+  {
+    LOG_WRN("unknown datastore record %s", key);
+    return 0;
+  }
+
+  if(len != nvmCounts[type] * sizeof(Data_t))
+  {
+    LOG_WRN("datapoint type %d record length %d does not match, using the defaults", type, len);
+    return 0;
+  }
+
+  readLen = readCb(cbArg, journal + journalOffsets[type], len);
+  if(readLen != (ssize_t)len)
+  {
+    LOG_ERR("ERROR %d: unable to read the datapoint type %d record", readLen, type);
+    return 0;
+  }
+
+  return datastoreUtilRestoreNvm(type, journal + journalOffsets[type], nvmCounts[type]);
+}
+
+int datastoreNvmInit(void)
+{
+  int err;
+  size_t journalLen = 0;
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    nvmCounts[type] = datastoreUtilGetNvmCount(type);
+    journalOffsets[type] = journalLen;
+    journalLen += nvmCounts[type];
+  }
+
+  if(journalLen == 0)
+    return 0;
+
+  journal = k_malloc(journalLen * sizeof(Data_t));
+  if(!journal)
+  {
+    err = -ENOMEM;
+    LOG_ERR("ERROR %d: unable to allocate the NVM journal", err);
+    return err;
+  }
+
+  err = settings_subsys_init();
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to initialize the settings", err);
+
+  return err;
+}
+
+int datastoreNvmRestore(void)
+{
+  int err;
+
+  if(!journal)
+    return 0;
+
+  err = settings_load_subtree_direct(DATASTORE_NVM_SUBTREE, restoreRecord, NULL);
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to restore the persisted datapoints", err);
+
+  return err;
+}
+
+int datastoreNvmProcess(int64_t now)
+{
+  int err;
+  uint32_t types;
+  bool isRequested;
+
+  if(!journal)
+    return 0;
+
+  isRequested = atomic_clear(&isFlushRequested) != 0;
+  if(!isRequested && now - lastFlushMs < CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS)
+    return 0;
+
+  /* The journal is owned by the save work until it completes */
+  if(atomic_get(&isFlushing))
+  {
+    if(isRequested)
+      atomic_set(&isFlushRequested, 1);
+
+    return 0;
+  }
+
+  types = stageJournal(now);
+  if(types == 0)
+    return 0;
+
+  err = k_work_submit(&saveWork);
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: unable to submit the NVM journal save", err);
+    atomic_clear(&isFlushing);
+    atomic_or(&retryTypes, types);
+    return err;
+  }
+
+  return 0;
+}
+
+int datastoreNvmFlush(int64_t now)
+{
+  struct k_work_sync sync;
+
+  if(!journal)
+    return 0;
+
+  /* The ongoing save may predate the latest changes, the journal is staged again once it is done */
+  k_work_flush(&saveWork, &sync);
+  atomic_clear(&isFlushRequested);
+
+  if(stageJournal(now) == 0)
+    return 0;
+
+  return saveStagedRecords();
+}
+
+void datastoreNvmRequestFlush(void)
+{
+  atomic_set(&isFlushRequested, 1);
+}
+
+/** @} */
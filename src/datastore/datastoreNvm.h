@@ -0,0 +1,84 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreNvm.h
+ * @author    jbacon
+ * @date      2026-03-23
+ * @brief     Datastore NVM Persistence
+ *
+ *            Datastore NVM persistence functions.
+ *
+ * @ingroup   datastore
+ *
+ * @{
+ */
+
+#ifndef DATASTORE_SRV_NVM
+#define DATASTORE_SRV_NVM
+
+#include "datastore.h"
+
+/**
+ * @brief   The settings subtree of the persisted datapoints.
+ */
+#define DATASTORE_NVM_SUBTREE                                   "datastore"
+
+/**
+ * @brief   Initialize the NVM persistence.
+ *
+ * @note    The journal holding the persisted values of each type is allocated
+ *          here.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreNvmInit(void);
+
+/**
+ * @brief   Restore the persisted datapoints.
+ *
+ * @note    Each type is stored as a single record, restored in one pass. A
+ *          record not matching the datastoreMeta.h layout is ignored and its
+ *          datapoints keep their default values.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreNvmRestore(void);
+
+/**
+ * @brief   Flush the journal of the changed persisted datapoints when due.
+ *
+ * @note    The journal is flushed once CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS
+ *          elapsed since the last flush, or right away when requested. The
+ *          records are saved by the system work queue, so the caller never
+ *          waits for the flash.
+ *
+ * @param[in]   now: The current uptime [ms].
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreNvmProcess(int64_t now);
+
+/**
+ * @brief   Flush the journal of the changed persisted datapoints right away.
+ *
+ * @note    Waits for the ongoing save, then saves the changed persisted
+ *          datapoints from the calling thread, to be called before the
+ *          datastore thread stops or suspends. It must not be called from
+ *          the system work queue.
+ *
+ * @param[in]   now: The current uptime [ms].
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreNvmFlush(int64_t now);
+
+/**
+ * @brief   Request a flush of the journal at the next process.
+ *
+ * @note    This function can be called from any context.
+ */
+void datastoreNvmRequestFlush(void);
+
+#endif    /* DATASTORE_SRV_NVM */
+
+/** @} */
@@ -0,0 +1,649 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreReplication.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Replication Implementation
+ *
+ *            Datastore replication implementation. The delta notifications
+ *            of the replicated ranges update a mirror of their values and a
+ *            dirty bitmap, and the process packs the dirty values in frames
+ *            of records, a record holding a run of values of one type in
+ *            little endian, the binaries and buttons on 1 byte and the other
+ *            types on 4 bytes.
+ *
+ * @ingroup   datastore
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+
+#include "datastoreReplication.h"
+
+/* Setting module logging */
+LOG_MODULE_DECLARE(DATASTORE_LOGGER_NAME);
+
+/**
+ * @brief   The largest packed value length [byte].
+ */
+#define MAX_PACKED_VALUE_LEN                                    4
+
+#define X(Name, name, TYPE, label, valueType) && TYPE##_DATAPOINT_COUNT <= UINT16_MAX + 1
+BUILD_ASSERT(1 DATASTORE_VALUE_TYPES, "the replication records hold 16-bit datapoint IDs");
+#undef X
+
+BUILD_ASSERT(CONFIG_ENYA_DATASTORE_REPLICATION_FRAME_SIZE >= DATASTORE_REPLICATION_FRAME_HEADER_LEN +
+             DATASTORE_REPLICATION_RECORD_HEADER_LEN + MAX_PACKED_VALUE_LEN,
+             "the replication frame must fit a record of one value");
+
+/**
+ * @brief   The replicated range.
+ */
+typedef struct
+{
+  DatapointType_t type;                 /**< The datapoint type */
+  uint32_t firstId;                     /**< The first datapoint ID */
+  size_t count;                         /**< The datapoint count */
+} ReplicatedRange_t;
+
+/**
+ * @brief   The replicated ranges.
+ */
+static const ReplicatedRange_t ranges[] = {
+#define X(type, firstId, count) {type, firstId, count},
+  DATASTORE_REPLICATION_RANGES
+#undef X
+};
+
+/**
+ * @brief   The replicated range count.
+ */
+#define REPLICATED_RANGE_COUNT                                  ARRAY_SIZE(ranges)
+
+BUILD_ASSERT(REPLICATED_RANGE_COUNT > 0, "at least one datapoint range must be replicated");
+
+/**
+ * @brief   The mirror of the replicated values.
+ */
+#define X(type, firstId, count) + (count)
+static Data_t mirror[0 DATASTORE_REPLICATION_RANGES];
+#undef X
+
+/**
+ * @brief   The replicated value count.
+ */
+#define REPLICATED_VALUE_COUNT                                  ARRAY_SIZE(mirror)
+
+/**
+ * @brief   The dirty bitmap of the mirror.
+ */
+static uint32_t dirty[DIV_ROUND_UP(REPLICATED_VALUE_COUNT, 32)];
+
+/**
+ * @brief   The mirror offset of each range.
+ */
+static size_t rangeOffsets[REPLICATED_RANGE_COUNT];
+
+/**
+ * @brief   The datapoint count of each type.
+ */
+static const size_t datapointCounts[DATAPOINT_TYPE_COUNT] = {
+#define X(Name, name, TYPE, label, valueType) TYPE##_DATAPOINT_COUNT,
+  DATASTORE_VALUE_TYPES
+#undef X
+};
+
+/**
+ * @brief   The packed value length of each type [byte].
+ */
+static const uint8_t packedLens[DATAPOINT_TYPE_COUNT] = {1, 1, 4, 4, 4, 4};
+
+/**
+ * @brief   The frame send callback, NULL while stopped.
+ */
+static DatastoreReplicationSendCb_t sendCallback = NULL;
+
+/**
+ * @brief   The send callback argument.
+ */
+static void *sendCbArg = NULL;
+
+/**
+ * @brief   The next sent sequence number.
+ */
+static uint16_t txSequence = 0;
+
+/**
+ * @brief   The next expected received sequence number.
+ */
+static uint16_t rxSequence = 0;
+
+/**
+ * @brief   The received sequence synchronization flag.
+ */
+static bool isRxSynced = false;
+
+/**
+ * @brief   The last frame uptime [ms].
+ */
+static int64_t lastSendMs = 0;
+
+/**
+ * @brief   The last resync uptime [ms].
+ */
+static int64_t lastResyncMs = 0;
+
+/**
+ * @brief   The resync request flag.
+ */
+static atomic_t isResyncRequested = ATOMIC_INIT(0);
+
+/**
+ * @brief   The replication statistics.
+ */
+static DatastoreReplicationStats_t stats;
+
+/**
+ * @brief   Check if a mirror value is dirty.
+ *
+ * @param[in]   index: The mirror index.
+ *
+ * @return  true if the value is dirty, false otherwise.
+ */
+static inline bool isDirty(size_t index)
+{
+  return (dirty[index / 32] & BIT(index % 32)) != 0;
+}
+
+/**
+ * @brief   Set the dirty state of a mirror value range.
+ *
+ * @param[in]   index: The first mirror index.
+ * @param[in]   count: The value count.
+ * @param[in]   isSet: The dirty state.
+ */
+static void setDirty(size_t index, size_t count, bool isSet)
+{
+  for(size_t i = index; i < index + count; ++i)
+  {
+    if(isSet)
+      dirty[i / 32] |= BIT(i % 32);
+    else
+      dirty[i / 32] &= ~BIT(i % 32);
+  }
+}
+
+/**
+ * @brief   Check if any mirror value is dirty.
+ *
+ * @return  true if a value is dirty, false otherwise.
+ */
+static bool hasDirty(void)
+{
+  for(size_t i = 0; i < ARRAY_SIZE(dirty); ++i)
+  {
+    if(dirty[i] != 0)
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Update the mirror with a delta notification.
+ *
+ * @note    Runs in the datastore thread. The ranges of a type share its
+ *          callback, the changed values being matched to each range.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   payload: The delta payload.
+ *
+ * @return  0.
+ */
+static int mirrorDelta(DatapointType_t type, SrvMsgPayload_t *payload)
+{
+  uint32_t startId;
+  uint32_t endId;
+  DatastoreDeltaHeader_t header;
+
+  memcpy(&header, payload->data, sizeof(header));
+
+  for(size_t i = 0; i < REPLICATED_RANGE_COUNT; ++i)
+  {
+    if(ranges[i].type != type)
+      continue;
+
+    startId = MAX(header.datapointId, ranges[i].firstId);
+    endId = MIN(header.datapointId + header.valCount, ranges[i].firstId + ranges[i].count);
+
+    for(uint32_t id = startId; id < endId; ++id)
+      mirror[rangeOffsets[i] + id - ranges[i].firstId] = payload->data[DATASTORE_DELTA_HEADER_LEN + id -
+                                                                       header.datapointId];
+
+    if(startId < endId)
+      setDirty(rangeOffsets[i] + startId - ranges[i].firstId, endId - startId, true);
+  }
+
+  osMemoryPoolFree(payload->poolId, payload);
+
+  return 0;
+}
+
+/**
+ * @brief   Define the delta callback of a value type.
+ *
+ * @param[in]   Name: The type function name infix.
+ * @param[in]   TYPE: The type datapoint name infix.
+ */
+#define X(Name, name, TYPE, label, valueType)                                                           \
+  static int on##Name##Delta(SrvMsgPayload_t *payload, size_t valCount)                                 \
+  {                                                                                                     \
+    ARG_UNUSED(valCount);                                                                               \
+    return mirrorDelta(DATAPOINT_##TYPE, payload);                                                      \
+  }
+DATASTORE_VALUE_TYPES
+#undef X
+
+/**
+ * @brief   The delta callback of each type.
+ */
+static const DatastoreSubCb_t deltaCallbacks[DATAPOINT_TYPE_COUNT] = {
+#define X(Name, name, TYPE, label, valueType) on##Name##Delta,
+  DATASTORE_VALUE_TYPES
+#undef X
+};
+
+/**
+ * @brief   The subscribe function of each type.
+ */
+static int (*const subscribeFuncs[DATAPOINT_TYPE_COUNT])(DatastoreSubEntry_t *sub) = {
+#define X(Name, name, TYPE, label, valueType) datastoreSubscribe##Name,
+  DATASTORE_VALUE_TYPES
+#undef X
+};
+
+/**
+ * @brief   The unsubscribe function of each type.
+ */
+static int (*const unsubscribeFuncs[DATAPOINT_TYPE_COUNT])(DatastoreSubCb_t callback) = {
+#define X(Name, name, TYPE, label, valueType) datastoreUnsubscribe##Name,
+  DATASTORE_VALUE_TYPES
+#undef X
+};
+
+/**
+ * @brief   Validate the replicated ranges and compute their mirror offset.
+ *
+ * @return  0 if successful, -EINVAL if a range is invalid or overlaps another.
+ */
+static int initRanges(void)
+{
+  size_t offset = 0;
+
+  for(uint32_t i = 0; i < REPLICATED_RANGE_COUNT; ++i)
+  {
+    if(ranges[i].type >= DATAPOINT_TYPE_COUNT || ranges[i].count == 0 ||
+       ranges[i].firstId + ranges[i].count > datapointCounts[ranges[i].type])
+    {
+      LOG_ERR("ERROR %d: invalid replicated range %d", -EINVAL, i);
+      return -EINVAL;
+    }
+
+    for(uint32_t j = 0; j < i; ++j)
+    {
+      if(ranges[j].type == ranges[i].type && ranges[j].firstId < ranges[i].firstId + ranges[i].count &&
+         ranges[i].firstId < ranges[j].firstId + ranges[j].count)
+      {
+        LOG_ERR("ERROR %d: replicated range %d overlaps range %d", -EINVAL, i, j);
+        return -EINVAL;
+      }
+    }
+
+    rangeOffsets[i] = offset;
+    offset += ranges[i].count;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief   Get the length of the run of values to send from a dirty value.
+ *
+ * @note    A clean gap cheaper to send than a record header is included in
+ *          the run, the run always ending on a dirty value.
+ *
+ * @param[in]   start: The mirror index of the dirty value.
+ * @param[in]   end: The mirror index ending the range.
+ * @param[in]   maxRun: The maximum run length.
+ * @param[in]   packedLen: The packed value length [byte].
+ *
+ * @return  The run length.
+ */
+static size_t getRunLength(size_t start, size_t end, size_t maxRun, uint8_t packedLen)
+{
+  size_t run = 1;
+  size_t gap = 0;
+
+  for(size_t i = start + 1; i < end && run + gap < maxRun; ++i)
+  {
+    if(isDirty(i))
+    {
+      run += gap + 1;
+      gap = 0;
+    }
+    else if(++gap * packedLen >= DATASTORE_REPLICATION_RECORD_HEADER_LEN)
+    {
+      break;
+    }
+  }
+
+  return run;
+}
+
+/**
+ * @brief   Pack the dirty values in a frame and send it.
+ *
+ * @note    The values are dirty again when the send fails.
+ *
+ * @return  0 if successful, -EAGAIN if the link is busy, the error code
+ *          otherwise.
+ */
+static int sendFrame(void)
+{
+  int err;
+  size_t len = DATASTORE_REPLICATION_FRAME_HEADER_LEN;
+  size_t maxRun;
+  size_t run;
+  size_t valueCount = 0;
+  uint8_t recordCount = 0;
+  uint8_t packedLen;
+  uint32_t savedDirty[ARRAY_SIZE(dirty)];
+  uint8_t frame[CONFIG_ENYA_DATASTORE_REPLICATION_FRAME_SIZE];
+
+  memcpy(savedDirty, dirty, sizeof(dirty));
+
+  for(size_t i = 0; i < REPLICATED_RANGE_COUNT && recordCount < UINT8_MAX; ++i)
+  {
+    packedLen = packedLens[ranges[i].type];
+
+    for(size_t j = 0; j < ranges[i].count && recordCount < UINT8_MAX; ++j)
+    {
+      if(!isDirty(rangeOffsets[i] + j))
+        continue;
+
+      if(len + DATASTORE_REPLICATION_RECORD_HEADER_LEN + packedLen > sizeof(frame))
+        break;
+
+      maxRun = MIN((sizeof(frame) - len - DATASTORE_REPLICATION_RECORD_HEADER_LEN) / packedLen, UINT8_MAX);
+      run = getRunLength(rangeOffsets[i] + j, rangeOffsets[i] + ranges[i].count, maxRun, packedLen);
+
+      frame[len] = ranges[i].type;
+      frame[len + 1] = run;
+      sys_put_le16(ranges[i].firstId + j, frame + len + 2);
+      len += DATASTORE_REPLICATION_RECORD_HEADER_LEN;
+
+      for(size_t k = 0; k < run; ++k)
+      {
+        if(packedLen == 1)
+          frame[len] = (uint8_t)mirror[rangeOffsets[i] + j + k].uintVal;
+        else
+          sys_put_le32(mirror[rangeOffsets[i] + j + k].uintVal, frame + len);
+
+        len += packedLen;
+      }
+
+      setDirty(rangeOffsets[i] + j, run, false);
+      valueCount += run;
+      ++recordCount;
+      j += run - 1;
+    }
+  }
+
+  frame[0] = DATASTORE_REPLICATION_VERSION;
+  frame[1] = recordCount;
+  sys_put_le16(txSequence, frame + 2);
+
+  err = sendCallback(sendCbArg, frame, len);
+  if(err < 0)
+  {
+    if(err != -EAGAIN)
+      LOG_ERR("ERROR %d: unable to send the replication frame %d", err, txSequence);
+
+    memcpy(dirty, savedDirty, sizeof(dirty));
+    return err;
+  }
+
+  ++txSequence;
+  ++stats.txFrames;
+  stats.txValues += valueCount;
+
+  return 0;
+}
+
+/**
+ * @brief   Validate a received frame.
+ *
+ * @param[in]   frame: The frame.
+ * @param[in]   len: The frame length [byte].
+ *
+ * @return  0 if the frame is valid, -EBADMSG otherwise.
+ */
+static int validateFrame(const uint8_t *frame, size_t len)
+{
+  size_t cursor = DATASTORE_REPLICATION_FRAME_HEADER_LEN;
+  uint8_t type;
+  uint8_t count;
+
+  if(len < DATASTORE_REPLICATION_FRAME_HEADER_LEN || frame[0] != DATASTORE_REPLICATION_VERSION)
+    return -EBADMSG;
+
+  for(uint8_t i = 0; i < frame[1]; ++i)
+  {
+    if(cursor + DATASTORE_REPLICATION_RECORD_HEADER_LEN > len)
+      return -EBADMSG;
+
+    type = frame[cursor];
+    count = frame[cursor + 1];
+    if(type >= DATAPOINT_TYPE_COUNT || count == 0 ||
+       sys_get_le16(frame + cursor + 2) + count > datapointCounts[type])
+      return -EBADMSG;
+
+    cursor += DATASTORE_REPLICATION_RECORD_HEADER_LEN + count * packedLens[type];
+    if(cursor > len)
+      return -EBADMSG;
+  }
+
+  return cursor == len ? 0 : -EBADMSG;
+}
+
+int datastoreReplicationStart(DatastoreReplicationSendCb_t sendCb, void *cbArg)
+{
+  int err;
+  DatastoreSubEntry_t sub = {.isPaused = false, .isDelta = true};
+
+  if(!sendCb)
+    return -EINVAL;
+
+  err = initRanges();
+  if(err < 0)
+    return err;
+
+  memset(dirty, 0, sizeof(dirty));
+  sendCbArg = cbArg;
+  sendCallback = sendCb;
+
+  /* The first notification of each range marks it dirty */
+  for(uint32_t i = 0; i < REPLICATED_RANGE_COUNT; ++i)
+  {
+    sub.datapointId = ranges[i].firstId;
+    sub.valCount = ranges[i].count;
+    sub.callback = deltaCallbacks[ranges[i].type];
+
+    err = subscribeFuncs[ranges[i].type](&sub);
+    if(err < 0)
+    {
+      LOG_ERR("ERROR %d: unable to subscribe to the replicated range %d", err, i);
+      return err;
+    }
+  }
+
+  return 0;
+}
+
+int datastoreReplicationStop(void)
+{
+  int err;
+  int errStop = 0;
+
+  sendCallback = NULL;
+
+  for(uint32_t i = 0; i < REPLICATED_RANGE_COUNT; ++i)
+  {
+    err = unsubscribeFuncs[ranges[i].type](deltaCallbacks[ranges[i].type]);
+    if(err < 0 && err != -ESRCH)
+    {
+      LOG_ERR("ERROR %d: unable to unsubscribe from the replicated range %d", err, i);
+      errStop = err;
+    }
+  }
+
+  return errStop;
+}
+
+void datastoreReplicationRequestResync(void)
+{
+  atomic_set(&isResyncRequested, 1);
+}
+
+int datastoreReplicationProcess(int64_t now)
+{
+  int err;
+  bool isResyncDue;
+
+  if(!sendCallback)
+    return 0;
+
+  isResyncDue = CONFIG_ENYA_DATASTORE_REPLICATION_RESYNC_PERIOD_MS > 0 &&
+                now - lastResyncMs >= CONFIG_ENYA_DATASTORE_REPLICATION_RESYNC_PERIOD_MS;
+  if(atomic_clear(&isResyncRequested) || isResyncDue)
+  {
+    setDirty(0, REPLICATED_VALUE_COUNT, true);
+    lastResyncMs = now;
+    ++stats.resyncCount;
+  }
+
+  if(now - lastSendMs < CONFIG_ENYA_DATASTORE_REPLICATION_PERIOD_MS || !hasDirty())
+    return 0;
+
+  lastSendMs = now;
+
+  do
+  {
+    err = sendFrame();
+  }
+  while(err == 0 && hasDirty());
+
+  /* A busy link is retried at the next period */
+  return err == -EAGAIN ? 0 : err;
+}
+
+int datastoreReplicationReceive(const uint8_t *frame, size_t len)
+{
+  int err = 0;
+  size_t cursor = DATASTORE_REPLICATION_FRAME_HEADER_LEN;
+  size_t opCount = 0;
+  size_t valueCount = 0;
+  size_t chunkCount;
+  uint8_t type;
+  uint8_t count;
+  uint16_t sequence;
+  uint32_t datapointId;
+  DatastoreBatchOp_t ops[CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS];
+  Data_t values[CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES];
+
+  if(!frame || validateFrame(frame, len) < 0)
+  {
+    LOG_ERR("ERROR %d: invalid replication frame", -EBADMSG);
+    return -EBADMSG;
+  }
+
+  sequence = sys_get_le16(frame + 2);
+  if(isRxSynced && sequence != rxSequence)
+  {
+    LOG_WRN("replication frame %d received, %d expected", sequence, rxSequence);
+    stats.rxLostFrames += (uint16_t)(sequence - rxSequence);
+  }
+
+  rxSequence = sequence + 1;
+  isRxSynced = true;
+
+  for(uint8_t i = 0; i < frame[1] && err == 0; ++i)
+  {
+    type = frame[cursor];
+    count = frame[cursor + 1];
+    datapointId = sys_get_le16(frame + cursor + 2);
+    cursor += DATASTORE_REPLICATION_RECORD_HEADER_LEN;
+
+    /* A record is split across the batches when needed */
+    while(count > 0 && err == 0)
+    {
+      if(opCount == ARRAY_SIZE(ops) || valueCount == ARRAY_SIZE(values))
+      {
+        err = datastoreBatch(ops, opCount, NULL);
+        opCount = 0;
+        valueCount = 0;
+        continue;
+      }
+
+      chunkCount = MIN(count, ARRAY_SIZE(values) - valueCount);
+      ops[opCount] = (DatastoreBatchOp_t){.opType = DATASTORE_BATCH_WRITE, .datapointType = type,
+                                          .datapointId = datapointId, .valCount = chunkCount,
+                                          .values = values + valueCount};
+
+      for(size_t j = 0; j < chunkCount; ++j)
+      {
+        if(packedLens[type] == 1)
+          values[valueCount + j].uintVal = type == DATAPOINT_BINARY ? frame[cursor] != 0 : frame[cursor];
+        else
+          values[valueCount + j].uintVal = sys_get_le32(frame + cursor);
+
+        cursor += packedLens[type];
+      }
+
+      ++opCount;
+      valueCount += chunkCount;
+      datapointId += chunkCount;
+      count -= chunkCount;
+    }
+  }
+
+  if(err == 0 && opCount > 0)
+    err = datastoreBatch(ops, opCount, NULL);
+
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: unable to apply the replication frame %d", err, sequence);
+    return err;
+  }
+
+  ++stats.rxFrames;
+
+  return 0;
+}
+
+int datastoreReplicationGetStats(DatastoreReplicationStats_t *replicationStats)
+{
+  if(!replicationStats)
+    return -EINVAL;
+
+  *replicationStats = stats;
+
+  return 0;
+}
+
+/** @} */
@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreReplication.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Replication
+ *
+ *            Datastore replication functions, sending the changed values of
+ *            the DATASTORE_REPLICATION_RANGES datapoints to a peer node in
+ *            sequence-numbered delta frames, and applying the frames of the
+ *            peer.
+ *
+ * @ingroup   datastore
+ *
+ * @{
+ */
+
+#ifndef DATASTORE_SRV_REPLICATION
+#define DATASTORE_SRV_REPLICATION
+
+#include "datastore.h"
+
+#ifndef DATASTORE_REPLICATION_RANGES
+#error "DATASTORE_REPLICATION_RANGES must be defined in datastoreMeta.h to use the replication"
+#endif
+
+/**
+ * @brief   The replication frame format version.
+ */
+#define DATASTORE_REPLICATION_VERSION                           1
+
+/**
+ * @brief   The replication frame header length [byte].
+ *
+ * @note    The version, the record count and the sequence number.
+ */
+#define DATASTORE_REPLICATION_FRAME_HEADER_LEN                  4
+
+/**
+ * @brief   The replication record header length [byte].
+ *
+ * @note    The datapoint type, the value count and the first datapoint ID,
+ *          followed by the packed values.
+ */
+#define DATASTORE_REPLICATION_RECORD_HEADER_LEN                 4
+
+/**
+ * @brief   The replication frame send callback.
+ *
+ * @note    Called by the datastore thread, it must not block. Return
+ *          -EAGAIN when the link is busy, the values of a failed frame being
+ *          sent again at the next period.
+ *
+ * @param[in]   cbArg: The callback argument.
+ * @param[in]   frame: The frame.
+ * @param[in]   len: The frame length [byte].
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+typedef int (*DatastoreReplicationSendCb_t)(void *cbArg, const uint8_t *frame, size_t len);
+
+/**
+ * @brief   The replication statistics.
+ */
+typedef struct
+{
+  uint32_t txFrames;                    /**< The sent frame count */
+  uint32_t txValues;                    /**< The sent value count */
+  uint32_t rxFrames;                    /**< The applied frame count */
+  uint32_t rxLostFrames;                /**< The frame count missing from the received sequence */
+  uint32_t resyncCount;                 /**< The full-state resync count */
+} DatastoreReplicationStats_t;
+
+/**
+ * @brief   Start the replication.
+ *
+ * @note    Subscribes in delta mode to each range of the
+ *          DATASTORE_REPLICATION_RANGES X-macro, each range taking a
+ *          subscription of its type. The first notification of each range
+ *          queues its whole state. The datastore must be initialized.
+ *
+ * @param[in]   sendCb: The frame send callback.
+ * @param[in]   cbArg: The send callback argument.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreReplicationStart(DatastoreReplicationSendCb_t sendCb, void *cbArg);
+
+/**
+ * @brief   Stop the replication.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreReplicationStop(void);
+
+/**
+ * @brief   Request a full-state resync at the next process.
+ *
+ * @note    This function can be called from any context, typically when
+ *          the peer reports lost frames or reboots.
+ */
+void datastoreReplicationRequestResync(void);
+
+/**
+ * @brief   Send the changed values when due.
+ *
+ * @note    Called by the datastore thread. The changes are coalesced for
+ *          CONFIG_ENYA_DATASTORE_REPLICATION_PERIOD_MS, then sent in frames
+ *          of at most CONFIG_ENYA_DATASTORE_REPLICATION_FRAME_SIZE bytes.
+ *          Every value is queued again each
+ *          CONFIG_ENYA_DATASTORE_REPLICATION_RESYNC_PERIOD_MS.
+ *
+ * @param[in]   now: The current uptime [ms].
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreReplicationProcess(int64_t now);
+
+/**
+ * @brief   Apply a frame received from the peer.
+ *
+ * @note    The frame is validated before being applied as write-only
+ *          batches, the subscribers being notified of the changed values.
+ *          A sequence gap is counted in the statistics, the missing values
+ *          being repaired by the next resync. This function cannot be
+ *          called from the datastore thread.
+ *
+ * @param[in]   frame: The frame.
+ * @param[in]   len: The frame length [byte].
+ *
+ * @return  0 if successful, -EBADMSG if the frame is malformed, the error
+ *          code otherwise.
+ */
+int datastoreReplicationReceive(const uint8_t *frame, size_t len);
+
+/**
+ * @brief   Get the replication statistics.
+ *
+ * @param[out]  stats: The replication statistics.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreReplicationGetStats(DatastoreReplicationStats_t *stats);
+
+#endif    /* DATASTORE_SRV_REPLICATION */
+
+/** @} */
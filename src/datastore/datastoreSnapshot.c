@@ -0,0 +1,368 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreSnapshot.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Snapshot Implementation
+ *
+ *            Datastore snapshot implementation. The snapshot is a header
+ *            holding the schema of each type, followed by a block per type
+ *            packing its values in little endian, the binaries and buttons
+ *            on 1 byte and the other types on 4 bytes.
+ *
+ * @ingroup   datastore
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <string.h>
+
+#include "datastoreSnapshot.h"
+
+/* Setting module logging */
+LOG_MODULE_DECLARE(DATASTORE_LOGGER_NAME);
+
+/**
+ * @brief   The FNV-1a hash offset basis.
+ */
+#define FNV_OFFSET_BASIS                                        2166136261u
+
+/**
+ * @brief   The FNV-1a hash prime.
+ */
+#define FNV_PRIME                                               16777619u
+
+/**
+ * @brief   The header offset of the type table.
+ */
+#define HEADER_TYPE_TABLE_OFFSET                                12
+
+/**
+ * @brief   The largest packed value length [byte].
+ */
+#define MAX_PACKED_VALUE_LEN                                    4
+
+/**
+ * @brief   The datapoint names of all types, in type order.
+ */
+static const char *const datapointNames[] = {
+#define X(name, flags, defaultVal) STRINGIFY(name),
+  DATASTORE_BINARY_DATAPOINTS
+  DATASTORE_BUTTON_DATAPOINTS
+  DATASTORE_FLOAT_DATAPOINTS
+  DATASTORE_INT_DATAPOINTS
+  DATASTORE_MULTI_STATE_DATAPOINTS
+  DATASTORE_UINT_DATAPOINTS
+#undef X
+};
+
+/**
+ * @brief   The datapoint count of each type.
+ */
+static const size_t datapointCounts[DATAPOINT_TYPE_COUNT] = {
+  BINARY_DATAPOINT_COUNT,
+  BUTTON_DATAPOINT_COUNT,
+  FLOAT_DATAPOINT_COUNT,
+  INT_DATAPOINT_COUNT,
+  MULTI_STATE_DATAPOINT_COUNT,
+  UINT_DATAPOINT_COUNT,
+};
+
+/**
+ * @brief   The packed value length of each type [byte].
+ */
+static const uint8_t packedLens[DATAPOINT_TYPE_COUNT] = {1, 1, 4, 4, 4, 4};
+
+/**
+ * @brief   Hash a byte buffer with FNV-1a.
+ *
+ * @param[in]   hash: The running hash.
+ * @param[in]   data: The data.
+ * @param[in]   len: The data length [byte].
+ *
+ * @return  The updated hash.
+ */
+static uint32_t hashBytes(uint32_t hash, const uint8_t *data, size_t len)
+{
+  for(size_t i = 0; i < len; ++i)
+  {
+    hash ^= data[i];
+    hash *= FNV_PRIME;
+  }
+
+  return hash;
+}
+
+/**
+ * @brief   Get the name offset of a type.
+ *
+ * @param[in]   type: The datapoint type.
+ *
+ * @return  The offset of the first datapoint name of the type.
+ */
+static size_t getNameOffset(DatapointType_t type)
+{
+  size_t offset = 0;
+
+  for(uint32_t i = 0; i < type; ++i)
+    offset += datapointCounts[i];
+
+  return offset;
+}
+
+/**
+ * @brief   Hash the names of the first datapoints of a type.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   count: The datapoint count to hash.
+ *
+ * @return  The type schema hash.
+ */
+static uint32_t hashTypeNames(DatapointType_t type, size_t count)
+{
+  uint32_t hash = FNV_OFFSET_BASIS;
+  const char *const *names = datapointNames + getNameOffset(type);
+
+  /* The terminator separates the names */
+  for(size_t i = 0; i < count; ++i)
+    hash = hashBytes(hash, (const uint8_t *)names[i], strlen(names[i]) + 1);
+
+  return hash;
+}
+
+/**
+ * @brief   Build the snapshot header of the datastoreMeta.h schema.
+ *
+ * @param[out]  header: The header.
+ */
+static void buildHeader(uint8_t header[DATASTORE_SNAPSHOT_HEADER_LEN])
+{
+  uint8_t *typeEntry = header + HEADER_TYPE_TABLE_OFFSET;
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    sys_put_le32(datapointCounts[type], typeEntry);
+    sys_put_le32(hashTypeNames(type, datapointCounts[type]), typeEntry + 4);
+    typeEntry += 8;
+  }
+
+  sys_put_le32(DATASTORE_SNAPSHOT_MAGIC, header);
+  sys_put_le16(DATASTORE_SNAPSHOT_VERSION, header + 4);
+  sys_put_le16(DATAPOINT_TYPE_COUNT, header + 6);
+  sys_put_le32(hashBytes(FNV_OFFSET_BASIS, header + HEADER_TYPE_TABLE_OFFSET,
+                         DATASTORE_SNAPSHOT_HEADER_LEN - HEADER_TYPE_TABLE_OFFSET), header + 8);
+}
+
+/**
+ * @brief   Get the restored datapoint count of each type of a snapshot.
+ *
+ * @param[in]   header: The snapshot header.
+ * @param[out]  restoreCounts: The restored datapoint count of each type.
+ *
+ * @return  0 if successful, -EBADMSG if the header is malformed, -EPROTO if
+ *          its schema cannot be migrated.
+ */
+static int parseHeader(const uint8_t header[DATASTORE_SNAPSHOT_HEADER_LEN],
+                       size_t restoreCounts[DATAPOINT_TYPE_COUNT])
+{
+  uint32_t count;
+  uint32_t hash;
+  const uint8_t *typeEntry = header + HEADER_TYPE_TABLE_OFFSET;
+
+  if(sys_get_le32(header) != DATASTORE_SNAPSHOT_MAGIC || sys_get_le16(header + 4) != DATASTORE_SNAPSHOT_VERSION ||
+     sys_get_le16(header + 6) != DATAPOINT_TYPE_COUNT)
+  {
+    LOG_ERR("ERROR %d: invalid snapshot header", -EBADMSG);
+    return -EBADMSG;
+  }
+
+  if(sys_get_le32(header + 8) != hashBytes(FNV_OFFSET_BASIS, typeEntry,
+                                           DATASTORE_SNAPSHOT_HEADER_LEN - HEADER_TYPE_TABLE_OFFSET))
+  {
+    LOG_ERR("ERROR %d: corrupted snapshot type table", -EBADMSG);
+    return -EBADMSG;
+  }
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    count = sys_get_le32(typeEntry);
+    hash = sys_get_le32(typeEntry + 4);
+    typeEntry += 8;
+
+    /* A snapshot of the first datapoints migrates by restoring them alone */
+    if(count > datapointCounts[type] || hash != hashTypeNames(type, count))
+    {
+      LOG_ERR("ERROR %d: the snapshot datapoint type %d schema does not match", -EPROTO, type);
+      return -EPROTO;
+    }
+
+    if(count < datapointCounts[type])
+      LOG_WRN("migrating the snapshot datapoint type %d, %zu datapoint(s) keeping their value", type,
+              datapointCounts[type] - count);
+
+    restoreCounts[type] = count;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief   Pack the values of a type.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   values: The values.
+ * @param[in]   valCount: The value count.
+ * @param[out]  data: The packed values.
+ */
+static void packValues(DatapointType_t type, const Data_t values[], size_t valCount, uint8_t *data)
+{
+  for(size_t i = 0; i < valCount; ++i)
+  {
+    if(packedLens[type] == 1)
+      data[i] = (uint8_t)values[i].uintVal;
+    else
+      sys_put_le32(values[i].uintVal, data + i * MAX_PACKED_VALUE_LEN);
+  }
+}
+
+/**
+ * @brief   Unpack the values of a type.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   data: The packed values.
+ * @param[in]   valCount: The value count.
+ * @param[out]  values: The values.
+ */
+static void unpackValues(DatapointType_t type, const uint8_t *data, size_t valCount, Data_t values[])
+{
+  for(size_t i = 0; i < valCount; ++i)
+  {
+    if(type == DATAPOINT_BINARY)
+      values[i].uintVal = data[i] != 0;
+    else if(packedLens[type] == 1)
+      values[i].uintVal = data[i];
+    else
+      values[i].uintVal = sys_get_le32(data + i * MAX_PACKED_VALUE_LEN);
+  }
+}
+
+uint32_t datastoreSnapshotGetSchemaHash(void)
+{
+  uint8_t header[DATASTORE_SNAPSHOT_HEADER_LEN];
+
+  buildHeader(header);
+
+  return sys_get_le32(header + 8);
+}
+
+size_t datastoreSnapshotGetSize(void)
+{
+  size_t size = DATASTORE_SNAPSHOT_HEADER_LEN;
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+    size += datapointCounts[type] * packedLens[type];
+
+  return size;
+}
+
+int datastoreSnapshotSave(DatastoreSnapshotWriteCb_t writeCb, void *cbArg, struct k_msgq *response)
+{
+  int err;
+  size_t chunkCount;
+  uint8_t header[DATASTORE_SNAPSHOT_HEADER_LEN];
+  Data_t values[CONFIG_ENYA_DATASTORE_SNAPSHOT_CHUNK_VALUES];
+  uint8_t data[CONFIG_ENYA_DATASTORE_SNAPSHOT_CHUNK_VALUES * MAX_PACKED_VALUE_LEN];
+
+  if(!writeCb || !response)
+    return -EINVAL;
+
+  buildHeader(header);
+
+  err = writeCb(cbArg, header, sizeof(header));
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: unable to write the snapshot header", err);
+    return err;
+  }
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    for(uint32_t id = 0; id < datapointCounts[type]; id += chunkCount)
+    {
+      chunkCount = MIN(datapointCounts[type] - id, ARRAY_SIZE(values));
+
+      err = datastoreRead(type, id, chunkCount, response, values);
+      if(err < 0)
+      {
+        LOG_ERR("ERROR %d: unable to read the datapoint type %d from ID %d", err, type, id);
+        return err;
+      }
+
+      packValues(type, values, chunkCount, data);
+
+      err = writeCb(cbArg, data, chunkCount * packedLens[type]);
+      if(err < 0)
+      {
+        LOG_ERR("ERROR %d: unable to write the datapoint type %d snapshot block", err, type);
+        return err;
+      }
+    }
+  }
+
+  return 0;
+}
+
+int datastoreSnapshotRestore(DatastoreSnapshotReadCb_t readCb, void *cbArg, struct k_msgq *response)
+{
+  int err;
+  size_t chunkCount;
+  size_t restoreCounts[DATAPOINT_TYPE_COUNT];
+  uint8_t header[DATASTORE_SNAPSHOT_HEADER_LEN];
+  Data_t values[CONFIG_ENYA_DATASTORE_SNAPSHOT_CHUNK_VALUES];
+  uint8_t data[CONFIG_ENYA_DATASTORE_SNAPSHOT_CHUNK_VALUES * MAX_PACKED_VALUE_LEN];
+
+  if(!readCb || !response)
+    return -EINVAL;
+
+  err = readCb(cbArg, header, sizeof(header));
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: unable to read the snapshot header", err);
+    return err;
+  }
+
+  err = parseHeader(header, restoreCounts);
+  if(err < 0)
+    return err;
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    for(uint32_t id = 0; id < restoreCounts[type]; id += chunkCount)
+    {
+      chunkCount = MIN(restoreCounts[type] - id, ARRAY_SIZE(values));
+
+      err = readCb(cbArg, data, chunkCount * packedLens[type]);
+      if(err < 0)
+      {
+        LOG_ERR("ERROR %d: unable to read the datapoint type %d snapshot block", err, type);
+        return err;
+      }
+
+      unpackValues(type, data, chunkCount, values);
+
+      err = datastoreWrite(type, id, values, chunkCount, response);
+      if(err < 0)
+      {
+        LOG_ERR("ERROR %d: unable to write the datapoint type %d from ID %d", err, type, id);
+        return err;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/** @} */
@@ -0,0 +1,116 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreSnapshot.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Snapshot
+ *
+ *            Datastore snapshot functions, serializing the values of all the
+ *            datapoints in a versioned binary format streamed in chunks.
+ *
+ * @ingroup   datastore
+ *
+ * @{
+ */
+
+#ifndef DATASTORE_SRV_SNAPSHOT
+#define DATASTORE_SRV_SNAPSHOT
+
+#include "datastore.h"
+
+/**
+ * @brief   The snapshot magic, "DSSN" in little endian.
+ */
+#define DATASTORE_SNAPSHOT_MAGIC                                0x4e535344
+
+/**
+ * @brief   The snapshot format version.
+ */
+#define DATASTORE_SNAPSHOT_VERSION                              1
+
+/**
+ * @brief   The snapshot header length [byte].
+ *
+ * @note    The magic, the version, the type count and the schema hash,
+ *          followed by the datapoint count and the schema hash of each type.
+ */
+#define DATASTORE_SNAPSHOT_HEADER_LEN                           (12 + DATAPOINT_TYPE_COUNT * 8)
+
+/**
+ * @brief   The snapshot write callback.
+ *
+ * @param[in]   cbArg: The callback argument.
+ * @param[in]   data: The snapshot chunk.
+ * @param[in]   len: The chunk length [byte].
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+typedef int (*DatastoreSnapshotWriteCb_t)(void *cbArg, const uint8_t *data, size_t len);
+
+/**
+ * @brief   The snapshot read callback.
+ *
+ * @param[in]   cbArg: The callback argument.
+ * @param[out]  data: The snapshot chunk.
+ * @param[in]   len: The chunk length [byte], to read entirely.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+typedef int (*DatastoreSnapshotReadCb_t)(void *cbArg, uint8_t *data, size_t len);
+
+/**
+ * @brief   Get the schema hash of the datastoreMeta.h datapoints.
+ *
+ * @note    The hash covers the name and the type of each datapoint, so a
+ *          snapshot with the same hash restores as is.
+ *
+ * @return  The schema hash.
+ */
+uint32_t datastoreSnapshotGetSchemaHash(void);
+
+/**
+ * @brief   Get the snapshot length.
+ *
+ * @return  The snapshot length [byte].
+ */
+size_t datastoreSnapshotGetSize(void);
+
+/**
+ * @brief   Serialize the datastore in a snapshot.
+ *
+ * @note    The values are read and written in chunks of
+ *          CONFIG_ENYA_DATASTORE_SNAPSHOT_CHUNK_VALUES, each type being read
+ *          in separate requests, so the snapshot is not atomic. This
+ *          function cannot be called from the datastore thread.
+ *
+ * @param[in]   writeCb: The snapshot write callback.
+ * @param[in]   cbArg: The write callback argument.
+ * @param[in]   response: The response queue of the datastore reads.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreSnapshotSave(DatastoreSnapshotWriteCb_t writeCb, void *cbArg, struct k_msgq *response);
+
+/**
+ * @brief   Restore the datastore from a snapshot.
+ *
+ * @note    The header is validated before any write. A type whose schema
+ *          differs is migrated when the snapshot holds a prefix of its
+ *          datapoints, the datapoints appended since keeping their value.
+ *          The values are written in chunks, the subscribers being notified
+ *          of each chunk. This function cannot be called from the datastore
+ *          thread.
+ *
+ * @param[in]   readCb: The snapshot read callback.
+ * @param[in]   cbArg: The read callback argument.
+ * @param[in]   response: The response queue of the datastore writes.
+ *
+ * @return  0 if successful, -EBADMSG if the snapshot is malformed, -EPROTO
+ *          if its schema cannot be migrated, the error code otherwise.
+ */
+int datastoreSnapshotRestore(DatastoreSnapshotReadCb_t readCb, void *cbArg, struct k_msgq *response);
+
+#endif    /* DATASTORE_SRV_SNAPSHOT */
+
+/** @} */
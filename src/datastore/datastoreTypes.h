@@ -22,10 +22,17 @@
 
 #define DATASTORE_LOGGER_NAME datastore
 
+#ifdef CONFIG_ENYA_DATASTORE_PRIORITY_LANES
+/**
+ * @brief   The message count in the datastore real-time lane.
+ */
+#define DATASTORE_MSG_COUNT                                       (CONFIG_ENYA_DATASTORE_REALTIME_MSG_COUNT)
+#else
 /**
  * @brief   The message count in the datastore queue.
  */
 #define DATASTORE_MSG_COUNT                                       (10)
+#endif
 
 /**
  * @brief   Datapoint no option flags.
@@ -37,6 +44,26 @@
  */
 #define DATAPOINT_FLAG_NVM_MASK                                   (1 << 0)
 
+/**
+ * @brief   Datapoint with history flag mask.
+ * @note    The history depth is CONFIG_ENYA_DATASTORE_HISTORY_DEFAULT_DEPTH,
+ *          use DATAPOINT_FLAG_HISTORY() to set it.
+ */
+#define DATAPOINT_FLAG_HISTORY_MASK                               (1 << 1)
+
+/**
+ * @brief   Datapoint history depth bit shift in the flags.
+ */
+#define DATAPOINT_HISTORY_DEPTH_SHIFT                             (16)
+
+/**
+ * @brief   Datapoint with history flags, keeping the last depth samples.
+ *
+ * @param[in]   depth: The history depth (1-65535).
+ */
+#define DATAPOINT_FLAG_HISTORY(depth) \
+  (DATAPOINT_FLAG_HISTORY_MASK | ((uint32_t)(depth) << DATAPOINT_HISTORY_DEPTH_SHIFT))
+
 /**
  * @brief   Button state enumeration.
  */
@@ -62,6 +89,31 @@ typedef enum
   DATAPOINT_TYPE_COUNT,
 } DatapointType_t;
 
+/**
+ * @brief   The datapoint value types.
+ * @note    X(Name, name, TYPE, label, valueType), Name and name being the
+ *          type in the function and variable names, TYPE the type in the
+ *          datapoint type and count names, label the type in the log
+ *          messages and valueType the C type of the values.
+ */
+#define DATASTORE_VALUE_TYPES                                                 \
+  X(Binary, binary, BINARY, "binary", bool)                                 \
+  X(Button, button, BUTTON, "button", ButtonState_t)                        \
+  X(Float, float, FLOAT, "float", float)                                    \
+  X(Int, int, INT, "signed integer", int32_t)                               \
+  X(MultiState, multiState, MULTI_STATE, "multi-state", uint32_t)           \
+  X(Uint, uint, UINT, "unsigned integer", uint32_t)
+
+/**
+ * @brief   The computed datapoint evaluator.
+ *
+ * @param[in]   inputs: The input values, in datapoint ID order.
+ * @param[in]   inputCount: The input count.
+ *
+ * @return  The computed value.
+ */
+typedef Data_t (*DatastoreEvaluator_t)(const Data_t inputs[], size_t inputCount);
+
 /**
  * @brief   Datastore datapoint.
  */
@@ -13,12 +13,132 @@
  */
 
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/math_extras.h>
 
 #include "datastoreUtil.h"
+#include "srvTrace.h"
+
+#ifdef CONFIG_ENYA_DATASTORE_HISTORY
+#include "datastoreHistory.h"
+#endif
 
 /* Setting module logging */
 LOG_MODULE_DECLARE(DATASTORE_LOGGER_NAME);
 
+#ifdef CONFIG_ENYA_DATASTORE_COMPACT_STORAGE
+/**
+ * @brief   The packed word count of a datapoint count.
+ */
+#define PACKED_WORD_COUNT(count, bitCount)                      (((count) * (bitCount)) / 32 + 1)
+
+/**
+ * @brief   The binary value bit count.
+ */
+#define BINARY_VALUE_BIT_COUNT                                  1
+
+/**
+ * @brief   The button value bit count.
+ */
+#define BUTTON_VALUE_BIT_COUNT                                  2
+
+/**
+ * @brief   Binary datapoints, packed one bit each.
+ * @note    Initialized from binaryDefaults by datastoreUtilInitDatapoints.
+ */
+static uint32_t binaryWords[PACKED_WORD_COUNT(BINARY_DATAPOINT_COUNT, BINARY_VALUE_BIT_COUNT)];
+
+/**
+ * @brief   Button datapoints, packed two bits each.
+ * @note    Initialized from buttonDefaults by datastoreUtilInitDatapoints.
+ */
+static uint32_t buttonWords[PACKED_WORD_COUNT(BUTTON_DATAPOINT_COUNT, BUTTON_VALUE_BIT_COUNT)];
+
+/**
+ * @brief   Binary datapoint default values.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+static const uint8_t binaryDefaults[] = {
+#define X(id, optFlags, defaultVal) defaultVal,
+  DATASTORE_BINARY_DATAPOINTS
+#undef X
+};
+
+/**
+ * @brief   Button datapoint default values.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+static const uint8_t buttonDefaults[] = {
+#define X(id, optFlags, defaultVal) defaultVal,
+  DATASTORE_BUTTON_DATAPOINTS
+#undef X
+};
+
+/**
+ * @brief   Float datapoints.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+static Data_t floats[] = {
+#define X(id, optFlags, defaultVal) {.floatVal = defaultVal},
+  DATASTORE_FLOAT_DATAPOINTS
+#undef X
+};
+
+/**
+ * @brief   Signed integer datapoints.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+static Data_t ints[] = {
+#define X(id, optFlags, defaultVal) {.intVal = defaultVal},
+  DATASTORE_INT_DATAPOINTS
+#undef X
+};
+
+/**
+ * @brief   Multi-state datapoints.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+static Data_t multiStates[] = {
+#define X(id, optFlags, defaultVal) {.uintVal = defaultVal},
+  DATASTORE_MULTI_STATE_DATAPOINTS
+#undef X
+};
+
+/**
+ * @brief   Unsigned integer datapoints.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+static Data_t uints[] = {
+#define X(id, optFlags, defaultVal) {.uintVal = defaultVal},
+  DATASTORE_UINT_DATAPOINTS
+#undef X
+};
+
+/**
+ * @brief   The word values of each value type, NULL for the packed types.
+ */
+static Data_t *datapointValues[DATAPOINT_TYPE_COUNT] = {NULL, NULL, floats, ints, multiStates, uints};
+
+/**
+ * @brief   Datapoint flags of each value type.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+#define X(id, optFlags, defaultVal) (uint8_t)(optFlags),
+static const uint8_t binaryFlags[] = {DATASTORE_BINARY_DATAPOINTS};
+static const uint8_t buttonFlags[] = {DATASTORE_BUTTON_DATAPOINTS};
+static const uint8_t floatFlags[] = {DATASTORE_FLOAT_DATAPOINTS};
+static const uint8_t intFlags[] = {DATASTORE_INT_DATAPOINTS};
+static const uint8_t multiStateFlags[] = {DATASTORE_MULTI_STATE_DATAPOINTS};
+static const uint8_t uintFlags[] = {DATASTORE_UINT_DATAPOINTS};
+#undef X
+
+/**
+ * @brief   The flag table of each value type.
+ */
+static const uint8_t *const datapointFlags[DATAPOINT_TYPE_COUNT] = {binaryFlags, buttonFlags, floatFlags,
+                                                                   intFlags, multiStateFlags, uintFlags};
+#else
 /**
  * @brief   Binary datapoints.
  * @note    Data is coming from X-macros in datastoreMeta.h
@@ -83,6 +203,7 @@ static Datapoint_t uints[] = {
  * @brief   The list of datapoint for each value type.
  */
 static Datapoint_t *datapoints[DATAPOINT_TYPE_COUNT] = {binaries, buttons, floats, ints, multiStates, uints};
+#endif
 
 /**
  * @brief   The datapoint count of each value type.
@@ -91,1186 +212,1873 @@ static size_t datapointCounts[DATAPOINT_TYPE_COUNT] = {BINARY_DATAPOINT_COUNT, B
                                                        FLOAT_DATAPOINT_COUNT, INT_DATAPOINT_COUNT,
                                                        MULTI_STATE_DATAPOINT_COUNT, UINT_DATAPOINT_COUNT};
 
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
 /**
- * @brief   The binary subscription structure.
+ * @brief   The write sequence counter of each value type.
+ * @note    The counter is odd while a write is in progress.
  */
-struct DatastoreSubs
+static atomic_t writeSequences[DATAPOINT_TYPE_COUNT];
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+/**
+ * @brief   The notification count of each value type.
+ */
+static atomic_t notifyCounts[DATAPOINT_TYPE_COUNT];
+
+/**
+ * @brief   The notification buffer allocation failure count.
+ */
+static atomic_t notifyAllocFailures = ATOMIC_INIT(0);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+/**
+ * @brief   The dirty bitmap word count of a datapoint count.
+ */
+#define DIRTY_BITMAP_WORD_COUNT(count)                          ((count) / 32 + 1)
+
+/**
+ * @brief   The binary dirty datapoints.
+ */
+static uint32_t binaryDirty[DIRTY_BITMAP_WORD_COUNT(BINARY_DATAPOINT_COUNT)];
+
+/**
+ * @brief   The button dirty datapoints.
+ */
+static uint32_t buttonDirty[DIRTY_BITMAP_WORD_COUNT(BUTTON_DATAPOINT_COUNT)];
+
+/**
+ * @brief   The float dirty datapoints.
+ */
+static uint32_t floatDirty[DIRTY_BITMAP_WORD_COUNT(FLOAT_DATAPOINT_COUNT)];
+
+/**
+ * @brief   The signed integer dirty datapoints.
+ */
+static uint32_t intDirty[DIRTY_BITMAP_WORD_COUNT(INT_DATAPOINT_COUNT)];
+
+/**
+ * @brief   The multi-state dirty datapoints.
+ */
+static uint32_t multiStateDirty[DIRTY_BITMAP_WORD_COUNT(MULTI_STATE_DATAPOINT_COUNT)];
+
+/**
+ * @brief   The unsigned integer dirty datapoints.
+ */
+static uint32_t uintDirty[DIRTY_BITMAP_WORD_COUNT(UINT_DATAPOINT_COUNT)];
+
+/**
+ * @brief   The dirty bitmap of each value type.
+ */
+static uint32_t *dirtyBitmaps[DATAPOINT_TYPE_COUNT] = {binaryDirty, buttonDirty, floatDirty,
+                                                       intDirty, multiStateDirty, uintDirty};
+
+/**
+ * @brief   The value types having dirty datapoints.
+ */
+static uint32_t dirtyTypes = 0;
+
+/**
+ * @brief   The changing write count since the last flush.
+ */
+static size_t dirtyWriteCount = 0;
+
+/**
+ * @brief   The flag of subscriptions left pending by their minimum interval.
+ */
+static bool hasPendingSubs = false;
+
+/**
+ * @brief   The last notification flush uptime [ms].
+ */
+static int64_t lastFlushMs = 0;
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+/**
+ * @brief   Count the persisted datapoints of a X-macro datapoint list.
+ */
+#define X(id, optFlags, defaultVal) + (((optFlags) & DATAPOINT_FLAG_NVM_MASK) ? 1 : 0)
+#define NVM_DATAPOINT_COUNT(datapointList)                      (0 datapointList)
+
+/**
+ * @brief   The persisted datapoint count of each value type.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+static const size_t nvmDatapointCounts[DATAPOINT_TYPE_COUNT] = {
+  NVM_DATAPOINT_COUNT(DATASTORE_BINARY_DATAPOINTS),
+  NVM_DATAPOINT_COUNT(DATASTORE_BUTTON_DATAPOINTS),
+  NVM_DATAPOINT_COUNT(DATASTORE_FLOAT_DATAPOINTS),
+  NVM_DATAPOINT_COUNT(DATASTORE_INT_DATAPOINTS),
+  NVM_DATAPOINT_COUNT(DATASTORE_MULTI_STATE_DATAPOINTS),
+  NVM_DATAPOINT_COUNT(DATASTORE_UINT_DATAPOINTS),
+};
+#undef X
+
+/**
+ * @brief   The value types having persisted datapoints changed since the last snapshot.
+ */
+static uint32_t nvmDirtyTypes = 0;
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_COMPUTED
+#ifndef DATASTORE_COMPUTED_DATAPOINTS
+#error "DATASTORE_COMPUTED_DATAPOINTS must be defined in datastoreMeta.h to use the computed datapoints"
+#endif
+
+/**
+ * @brief   The computed datapoint.
+ */
+typedef struct
 {
-  DatastoreSubEntry_t *entries;
-  size_t maxCount;
-  size_t activeCount;
+  DatapointType_t type;                 /**< The datapoint type. */
+  uint32_t datapointId;                 /**< The datapoint ID. */
+  DatastoreEvaluator_t evaluator;       /**< The evaluator. */
+  DatapointType_t inputType;            /**< The input datapoint type. */
+  uint32_t firstInputId;                /**< The first input datapoint ID. */
+  size_t inputCount;                    /**< The input count. */
+} DatastoreComputed_t;
+
+/**
+ * @brief   The computed datapoints, in evaluation order.
+ * @note    Data is coming from X-macros in datastoreMeta.h
+ */
+static const DatastoreComputed_t computedPoints[] = {
+#define X(type, datapointId, evaluator, inputType, firstInputId, inputCount) \
+  {type, datapointId, evaluator, inputType, firstInputId, inputCount},
+  DATASTORE_COMPUTED_DATAPOINTS
+#undef X
 };
 
 /**
- * @brief   The binary subscriptions.
+ * @brief   The computed datapoint count.
+ */
+#define COMPUTED_COUNT                                          ARRAY_SIZE(computedPoints)
+
+BUILD_ASSERT(COMPUTED_COUNT > 0 && COMPUTED_COUNT <= 32, "1 to 32 datapoints can be computed");
+
+#define X(type, datapointId, evaluator, inputType, firstInputId, inputCount)                      \
+  BUILD_ASSERT((inputCount) > 0 && (inputCount) <= CONFIG_ENYA_DATASTORE_COMPUTED_MAX_INPUTS,   \
+               "the computed datapoint input count must be 1 to ENYA_DATASTORE_COMPUTED_MAX_INPUTS");
+DATASTORE_COMPUTED_DATAPOINTS
+#undef X
+
+/**
+ * @brief   The computed datapoints having an input changed since their last evaluation.
+ */
+static uint32_t computedDirty = 0;
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+/**
+ * @brief   The binary subscription index.
+ * @note    Each datapoint holds the mask of the subscription slots covering it.
+ */
+static uint64_t binarySubIndex[BINARY_DATAPOINT_COUNT];
+
+/**
+ * @brief   The button subscription index.
+ * @note    Each datapoint holds the mask of the subscription slots covering it.
+ */
+static uint64_t buttonSubIndex[BUTTON_DATAPOINT_COUNT];
+
+/**
+ * @brief   The float subscription index.
+ * @note    Each datapoint holds the mask of the subscription slots covering it.
+ */
+static uint64_t floatSubIndex[FLOAT_DATAPOINT_COUNT];
+
+/**
+ * @brief   The signed integer subscription index.
+ * @note    Each datapoint holds the mask of the subscription slots covering it.
+ */
+static uint64_t intSubIndex[INT_DATAPOINT_COUNT];
+
+/**
+ * @brief   The multi-state subscription index.
+ * @note    Each datapoint holds the mask of the subscription slots covering it.
+ */
+static uint64_t multiStateSubIndex[MULTI_STATE_DATAPOINT_COUNT];
+
+/**
+ * @brief   The unsigned integer subscription index.
+ * @note    Each datapoint holds the mask of the subscription slots covering it.
  */
-static struct DatastoreSubs binarySubs  = {.entries = NULL, .maxCount = 0, .activeCount = 0};
+static uint64_t uintSubIndex[UINT_DATAPOINT_COUNT];
 
 /**
- * @brief   The button subscriptions.
+ * @brief   The subscription index of each value type.
  */
-static struct DatastoreSubs buttonSubs  = {.entries = NULL, .maxCount = 0, .activeCount = 0};
+static uint64_t *subIndexes[DATAPOINT_TYPE_COUNT] = {binarySubIndex, buttonSubIndex, floatSubIndex,
+                                                     intSubIndex, multiStateSubIndex, uintSubIndex};
+#endif
 
 /**
- * @brief   The float subscriptions.
+ * @brief   The binary subscription structure.
  */
-static struct DatastoreSubs floatSubs  = {.entries = NULL, .maxCount = 0, .activeCount = 0};
+struct DatastoreSubs
+{
+  DatastoreSubEntry_t *entries;
+  size_t maxCount;
+  size_t activeCount;
+};
 
 /**
- * @brief   The signed integer subscriptions.
+ * @brief   The changed datapoint span of a write.
  */
-static struct DatastoreSubs intSubs  = {.entries = NULL, .maxCount = 0, .activeCount = 0};
+typedef struct
+{
+  uint32_t datapointId;
+  size_t valCount;
+} DatapointSpan_t;
 
 /**
- * @brief   The multi-state subscriptions.
+ * @brief   Define the subscriptions of a value type.
+ *
+ * @param[in]   name: The type variable name prefix.
  */
-static struct DatastoreSubs multiStateSubs  = {.entries = NULL, .maxCount = 0, .activeCount = 0};
+#define DATASTORE_SUBS_DEFINE(name)                                           \
+  static struct DatastoreSubs name##Subs = {.entries = NULL, .maxCount = 0, .activeCount = 0};
 
 /**
- * @brief   The unsigned integer subscriptions.
+ * @brief   The subscriptions of each value type.
  */
-static struct DatastoreSubs uintSubs  = {.entries = NULL, .maxCount = 0, .activeCount = 0};
+#define X(Name, name, TYPE, label, valueType) DATASTORE_SUBS_DEFINE(name)
+DATASTORE_VALUE_TYPES
+#undef X
 
+#ifdef CONFIG_ENYA_DATASTORE_COMPACT_STORAGE
 /**
- * @brief   Check if the binary datapoint is in range of the subscription.
+ * @brief   Get a packed value.
  *
- * @param[in]   datapointId: The datapoint ID.
- * @param[in]   sub: The subscription.
+ * @param[in]   words: The packed words.
+ * @param[in]   bitCount: The value bit count.
+ * @param[in]   index: The value index.
  *
- * @return  true if the datapoint is in range, false otherwise.
+ * @return  The packed value.
  */
-static inline bool isBinaryDatapointInSubRange(uint32_t datapointId, DatastoreSubEntry_t *sub)
+static inline uint32_t getPackedValue(const uint32_t words[], uint32_t bitCount, uint32_t index)
 {
-  return datapointId >= sub->datapointId && datapointId < (sub->datapointId + sub->valCount);
+  uint32_t bitIndex = index * bitCount;
+
+  return (words[bitIndex / 32] >> (bitIndex % 32)) & BIT_MASK(bitCount);
 }
 
 /**
- * @brief   Notify a single binary subscription.
+ * @brief   Set a packed value.
  *
- * @param[in]   sub: The subscription to notify.
- * @param[in]   pool: The buffer pool.
+ * @note    Only the datastore thread writes the datapoints, the direct
+ *          readers are protected by the write sequence.
  *
- * @return  0 if successful, the error code otherwise.
+ * @param[in,out] words: The packed words.
+ * @param[in]     bitCount: The value bit count.
+ * @param[in]     index: The value index.
+ * @param[in]     value: The value.
  */
-static inline int notifyBinarySub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+static inline void setPackedValue(uint32_t words[], uint32_t bitCount, uint32_t index, uint32_t value)
 {
-  int err;
-  SrvMsgPayload_t *payload;
-
-  payload = osMemoryPoolAlloc(pool, DATASTORE_BUFFER_ALLOC_TIMEOUT);
-  if(!payload)
-  {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate a buffer for binary notification", err);
-    return err;
-  }
-
-  payload->poolId = pool;
-  payload->dataLen = sub->valCount * sizeof(Data_t);
-
-  for(size_t i = 0; i < sub->valCount; ++i)
-    payload->data[i].uintVal = binaries[sub->datapointId + i].value.uintVal;
+  uint32_t bitIndex = index * bitCount;
+  uint32_t shift = bitIndex % 32;
 
-  return sub->callback(payload, sub->valCount);
+  words[bitIndex / 32] = (words[bitIndex / 32] & ~(BIT_MASK(bitCount) << shift)) |
+                         ((value & BIT_MASK(bitCount)) << shift);
 }
+#endif
 
 /**
- * @brief   Notify binary subscriptions.
+ * @brief   Get the value of a datapoint.
  *
+ * @param[in]   type: The datapoint type.
  * @param[in]   datapointId: The datapoint ID.
- * @param[in]   pool: The buffer pool.
  *
- * @return  0 if successful, the error code otherwise.
+ * @return  The datapoint value.
  */
-static inline int notifyBinarySubs(uint32_t datapointId, osMemoryPoolId_t pool)
+static inline Data_t getDatapointValue(DatapointType_t type, uint32_t datapointId)
 {
-  int err = 0;
+#ifdef CONFIG_ENYA_DATASTORE_COMPACT_STORAGE
+  Data_t value;
 
-  for(size_t i = 0; i < binarySubs.activeCount && err == 0; ++i)
+  switch(type)
   {
-    if(isBinaryDatapointInSubRange(datapointId, binarySubs.entries + i) && !binarySubs.entries[i].isPaused)
-    {
-      err = notifyBinarySub(binarySubs.entries + i, pool);
-      if(err < 0)
-        LOG_ERR("ERROR %d: unable to notify for binary entry %d", err, i);
-    }
+    case DATAPOINT_BINARY:
+      value.uintVal = getPackedValue(binaryWords, BINARY_VALUE_BIT_COUNT, datapointId);
+      return value;
+    case DATAPOINT_BUTTON:
+      value.uintVal = getPackedValue(buttonWords, BUTTON_VALUE_BIT_COUNT, datapointId);
+      return value;
+    default:
+      return datapointValues[type][datapointId];
   }
-
-  return err;
+#else
+  return datapoints[type][datapointId].value;
+#endif
 }
 
 /**
- * @brief   Check if the button datapoint is in range of the subscription.
+ * @brief   Set the value of a datapoint.
  *
+ * @param[in]   type: The datapoint type.
  * @param[in]   datapointId: The datapoint ID.
- * @param[in]   sub: The subscription.
- *
- * @return  true if the datapoint is in range, false otherwise.
+ * @param[in]   value: The datapoint value.
  */
-static inline bool isButtonDatapointInSubRange(uint32_t datapointId, DatastoreSubEntry_t *sub)
+static inline void setDatapointValue(DatapointType_t type, uint32_t datapointId, Data_t value)
 {
-  return datapointId >= sub->datapointId && datapointId < (sub->datapointId + sub->valCount);
+#ifdef CONFIG_ENYA_DATASTORE_COMPACT_STORAGE
+  switch(type)
+  {
+    case DATAPOINT_BINARY:
+      setPackedValue(binaryWords, BINARY_VALUE_BIT_COUNT, datapointId, value.uintVal);
+    break;
+    case DATAPOINT_BUTTON:
+      setPackedValue(buttonWords, BUTTON_VALUE_BIT_COUNT, datapointId, value.uintVal);
+    break;
+    default:
+      datapointValues[type][datapointId] = value;
+    break;
+  }
+#else
+  datapoints[type][datapointId].value = value;
+#endif
 }
 
 /**
- * @brief   Notify a single button subscription.
+ * @brief   Get the value as stored in a datapoint of its type.
  *
- * @param[in]   sub: The subscription.
- * @param[in]   pool: The buffer pool.
+ * @note    With the compact storage, a binary value is stored as 0 or 1 and a
+ *          button value keeps its packed bits.
  *
- * @return  0 if successful, the error code otherwise.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   value: The value.
+ *
+ * @return  The stored value.
  */
-static inline int notifyButtonSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+static inline Data_t getStoredValue(DatapointType_t type, Data_t value)
 {
-  int err;
-  SrvMsgPayload_t *payload;
-
-  payload = osMemoryPoolAlloc(pool, DATASTORE_BUFFER_ALLOC_TIMEOUT);
-  if(!payload)
-  {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate a buffer for button notification", err);
-    return err;
-  }
-
-  payload->poolId = pool;
-  payload->dataLen = sub->valCount * sizeof(Data_t);
-
-  for(size_t i = 0; i < sub->valCount; ++i)
-    payload->data[i].uintVal = buttons[sub->datapointId + i].value.uintVal;
-
-  return sub->callback(payload, sub->valCount);
+#ifdef CONFIG_ENYA_DATASTORE_COMPACT_STORAGE
+  if(type == DATAPOINT_BINARY)
+    value.uintVal = value.uintVal != 0;
+  else if(type == DATAPOINT_BUTTON)
+    value.uintVal &= BIT_MASK(BUTTON_VALUE_BIT_COUNT);
+#else
+  ARG_UNUSED(type);
+#endif
+
+  return value;
 }
 
 /**
- * @brief   Notify button subscription.
+ * @brief   Get the flags of a datapoint.
  *
+ * @param[in]   type: The datapoint type.
  * @param[in]   datapointId: The datapoint ID.
- * @param[in]   pool: The buffer pool.
  *
- * @return  0 if successful, the error code otherwise.
+ * @return  The datapoint flags.
  */
-static inline int notifyButtonSubs(uint32_t datapointId, osMemoryPoolId_t pool)
+static inline uint32_t getDatapointFlags(DatapointType_t type, uint32_t datapointId)
 {
-  int err = 0;
-
-  for(size_t i = 0; i < buttonSubs.activeCount && err == 0; ++i)
-  {
-    if(isButtonDatapointInSubRange(datapointId, buttonSubs.entries + i) && !buttonSubs.entries[i].isPaused)
-    {
-      err = notifyButtonSub(buttonSubs.entries + i, pool);
-      if(err < 0)
-        LOG_ERR("ERROR %d: unable to notify for button entry %d", err, i);
-    }
-  }
-
-  return err;
+#ifdef CONFIG_ENYA_DATASTORE_COMPACT_STORAGE
+  return datapointFlags[type][datapointId];
+#else
+  return datapoints[type][datapointId].flags;
+#endif
 }
 
 /**
- * @brief   Check if the float datapoint is in range of the subscription.
+ * @brief   Check if the subscription is notified with a delta payload.
  *
- * @param[in]   datapointId: The datapoint ID.
  * @param[in]   sub: The subscription.
  *
- * @return  true if the datapoint is in range, false otherwise.
+ * @return  true if the subscription is in delta mode, false otherwise.
  */
-static inline bool isFloatDatapointInSubRange(uint32_t datapointId, DatastoreSubEntry_t *sub)
+static inline bool isDeltaSub(DatastoreSubEntry_t *sub)
 {
-  return datapointId >= sub->datapointId && datapointId < (sub->datapointId + sub->valCount);
+#ifdef CONFIG_ENYA_DATASTORE_DELTA_NOTIFY
+  return sub->isDelta;
+#else
+  ARG_UNUSED(sub);
+  return false;
+#endif
 }
 
 /**
- * @brief   Notify a single float subscription.
+ * @brief   Record a notification buffer allocation in the statistics.
  *
- * @param[in]   sub: The subscription.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   payload: The allocated payload, NULL if the allocation failed.
+ */
+static inline void recordNotifyStats(DatapointType_t type, SrvMsgPayload_t *payload)
+{
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+  if(payload)
+    atomic_inc(notifyCounts + type);
+  else
+    atomic_inc(&notifyAllocFailures);
+#else
+  ARG_UNUSED(type);
+  ARG_UNUSED(payload);
+#endif
+}
+
+/**
+ * @brief   Notify a subscription with a delta payload.
+ *
+ * @note    The changed range is clamped to the subscription range. The
+ *          payload starts with a DatastoreDeltaHeader_t followed by the
+ *          changed values only.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   sub: The subscription to notify.
+ * @param[in]   datapointId: The first changed datapoint ID.
+ * @param[in]   valCount: The changed datapoint count.
  * @param[in]   pool: The buffer pool.
  *
  * @return  0 if successful, the error code otherwise.
  */
-static inline int notifyFloatSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+static int notifySubDelta(DatapointType_t type, DatastoreSubEntry_t *sub, uint32_t datapointId, size_t valCount,
+                          osMemoryPoolId_t pool)
 {
+#ifdef CONFIG_ENYA_DATASTORE_DELTA_NOTIFY
   int err;
+  uint32_t endId;
+  DatastoreDeltaHeader_t header;
   SrvMsgPayload_t *payload;
 
+  header.datapointId = MAX(datapointId, sub->datapointId);
+  endId = MIN(datapointId + valCount, sub->datapointId + sub->valCount);
+  if(header.datapointId >= endId)
+    return 0;
+
+  header.valCount = endId - header.datapointId;
+
   payload = osMemoryPoolAlloc(pool, DATASTORE_BUFFER_ALLOC_TIMEOUT);
+  recordNotifyStats(type, payload);
   if(!payload)
   {
     err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate a buffer for float notification", err);
+    LOG_ERR("ERROR %d: unable to allocate a buffer for delta notification", err);
     return err;
   }
 
   payload->poolId = pool;
-  payload->dataLen = sub->valCount * sizeof(Data_t);
-
-  for(size_t i = 0; i < sub->valCount; ++i)
-    payload->data[i].floatVal = floats[sub->datapointId + i].value.floatVal;
-
-  return sub->callback(payload, sub->valCount);
+  payload->dataLen = (DATASTORE_DELTA_HEADER_LEN + header.valCount) * sizeof(Data_t);
+  memcpy(payload->data, &header, sizeof(header));
+
+  for(size_t i = 0; i < header.valCount; ++i)
+    payload->data[DATASTORE_DELTA_HEADER_LEN + i] = getDatapointValue(type, header.datapointId + i);
+
+  return sub->callback(payload, header.valCount);
+#else
+  ARG_UNUSED(type);
+  ARG_UNUSED(sub);
+  ARG_UNUSED(datapointId);
+  ARG_UNUSED(valCount);
+  ARG_UNUSED(pool);
+  return -ENOTSUP;
+#endif
 }
 
 /**
- * @brief   Notify float subscriptions.
+ * @brief   Define the notifiers of a value type.
  *
- * @param[in]   datapointId: The datapoint ID.
- * @param[in]   pool: The buffer pool.
+ * @note    Generates is<Name>RangeInSubRange(), checking if a datapoint
+ *          range overlaps the subscription range, notify<Name>Sub(),
+ *          notifying a single subscription, and notify<Name>Subs(), notifying
+ *          the subscriptions of a changed datapoint range. A type without
+ *          datapoint has nothing to notify, its notifiers compiling out.
  *
- * @return  0 if successful, the error code otherwise.
+ * @param[in]   Name: The type function name infix.
+ * @param[in]   name: The type variable name prefix.
+ * @param[in]   TYPE: The type datapoint name infix.
+ * @param[in]   label: The type log label.
  */
-static inline int notifyFloatSubs(uint32_t datapointId, osMemoryPoolId_t pool)
-{
-  int err = 0;
-
-  for(size_t i = 0; i < floatSubs.activeCount && err == 0; ++i)
-  {
-    if(isFloatDatapointInSubRange(datapointId, floatSubs.entries + i) && !floatSubs.entries[i].isPaused)
-    {
-      err = notifyFloatSub(floatSubs.entries + i, pool);
-      if(err < 0)
-        LOG_ERR("ERROR %d: unable to notify for float entry %d", err, i);
-    }
+#define DATASTORE_NOTIFIERS_DEFINE(Name, name, TYPE, label)                                             \
+  static inline bool is##Name##RangeInSubRange(uint32_t datapointId, size_t valCount,                   \
+                                               DatastoreSubEntry_t *sub)                                \
+  {                                                                                                     \
+    return datapointId < (sub->datapointId + sub->valCount) && sub->datapointId < (datapointId + valCount); \
+  }                                                                                                     \
+                                                                                                        \
+  static inline int notify##Name##Sub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)                  \
+  {                                                                                                     \
+    int err;                                                                                            \
+    SrvMsgPayload_t *payload;                                                                           \
+                                                                                                        \
+    if(TYPE##_DATAPOINT_COUNT == 0)                                                                     \
+      return 0;                                                                                         \
+                                                                                                        \
+    if(isDeltaSub(sub))                                                                                 \
+      return notifySubDelta(DATAPOINT_##TYPE, sub, sub->datapointId, sub->valCount, pool);              \
+                                                                                                        \
+    payload = osMemoryPoolAlloc(pool, DATASTORE_BUFFER_ALLOC_TIMEOUT);                                  \
+    recordNotifyStats(DATAPOINT_##TYPE, payload);                                                       \
+    if(!payload)                                                                                        \
+    {                                                                                                   \
+      err = -ENOSPC;                                                                                    \
+      LOG_ERR("ERROR %d: unable to allocate a buffer for " label " notification", err);                 \
+      return err;                                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    payload->poolId = pool;                                                                             \
+    payload->dataLen = sub->valCount * sizeof(Data_t);                                                  \
+                                                                                                        \
+    for(size_t i = 0; i < sub->valCount; ++i)                                                           \
+      payload->data[i] = getDatapointValue(DATAPOINT_##TYPE, sub->datapointId + i);                     \
+                                                                                                        \
+    return sub->callback(payload, sub->valCount);                                                       \
+  }                                                                                                     \
+                                                                                                        \
+  static inline int notify##Name##Subs(uint32_t datapointId, size_t valCount, osMemoryPoolId_t pool)    \
+  {                                                                                                     \
+    int err = 0;                                                                                        \
+                                                                                                        \
+    if(TYPE##_DATAPOINT_COUNT == 0)                                                                     \
+      return 0;                                                                                         \
+                                                                                                        \
+    for(size_t i = 0; i < name##Subs.activeCount && err == 0; ++i)                                      \
+    {                                                                                                   \
+      if(is##Name##RangeInSubRange(datapointId, valCount, name##Subs.entries + i) &&                    \
+         !name##Subs.entries[i].isPaused)                                                               \
+      {                                                                                                 \
+        if(isDeltaSub(name##Subs.entries + i))                                                          \
+          err = notifySubDelta(DATAPOINT_##TYPE, name##Subs.entries + i, datapointId, valCount, pool);  \
+        else                                                                                            \
+          err = notify##Name##Sub(name##Subs.entries + i, pool);                                        \
+                                                                                                        \
+        if(err < 0)                                                                                     \
+          LOG_ERR("ERROR %d: unable to notify for " label " entry %d", err, i);                         \
+      }                                                                                                 \
+    }                                                                                                   \
+                                                                                                        \
+    return err;                                                                                         \
   }
 
-  return err;
+/**
+ * @brief   The notifiers of each value type.
+ */
+#define X(Name, name, TYPE, label, valueType) DATASTORE_NOTIFIERS_DEFINE(Name, name, TYPE, label)
+DATASTORE_VALUE_TYPES
+#undef X
+
+/**
+ * @brief   Mark the beginning of a write to the datapoints of a type.
+ *
+ * @param[in]   type: The datapoint type.
+ */
+static inline void beginDatapointWrite(DatapointType_t type)
+{
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+  atomic_inc(writeSequences + type);
+#else
+  ARG_UNUSED(type);
+#endif
 }
 
 /**
- * @brief   Check if the signed integer datapoint is in range of the subscription.
+ * @brief   Mark the end of a write to the datapoints of a type.
  *
+ * @param[in]   type: The datapoint type.
+ */
+static inline void endDatapointWrite(DatapointType_t type)
+{
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+  atomic_inc(writeSequences + type);
+#else
+  ARG_UNUSED(type);
+#endif
+}
+
+/**
+ * @brief   Mark a datapoint dirty.
+ *
+ * @param[in]   type: The datapoint type.
  * @param[in]   datapointId: The datapoint ID.
- * @param[in]   sub: The subscription.
+ */
+static inline void markDatapointDirty(DatapointType_t type, uint32_t datapointId)
+{
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+  dirtyBitmaps[type][datapointId / 32] |= BIT(datapointId % 32);
+  dirtyTypes |= BIT(type);
+#else
+  ARG_UNUSED(type);
+  ARG_UNUSED(datapointId);
+#endif
+}
+
+/**
+ * @brief   Mark the value type dirty in the NVM journal when the datapoint is persisted.
  *
- * @return  true if the datapoint is in range, false otherwise.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
  */
-static inline bool isIntDatapointInSubRange(uint32_t datapointId, DatastoreSubEntry_t *sub)
+static inline void markNvmDirty(DatapointType_t type, uint32_t datapointId)
 {
-  return datapointId >= sub->datapointId && datapointId < (sub->datapointId + sub->valCount);
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+  if(getDatapointFlags(type, datapointId) & DATAPOINT_FLAG_NVM_MASK)
+    nvmDirtyTypes |= BIT(type);
+#else
+  ARG_UNUSED(type);
+  ARG_UNUSED(datapointId);
+#endif
 }
 
 /**
- * @brief   Notify a single signed integer subscription.
+ * @brief   Record a written value in the history of its datapoint.
  *
- * @param[in]   sub: The subscription.
- * @param[in]   pool: The buffer pool.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   value: The written value.
+ */
+static inline void recordHistory(DatapointType_t type, uint32_t datapointId, Data_t value)
+{
+#ifdef CONFIG_ENYA_DATASTORE_HISTORY
+  datastoreHistoryRecord(type, datapointId, value, k_uptime_get_32());
+#else
+  ARG_UNUSED(type);
+  ARG_UNUSED(datapointId);
+  ARG_UNUSED(value);
+#endif
+}
+
+/**
+ * @brief   Mark dirty the computed datapoints having an input in a changed range.
  *
- * @return  0 if successful, the error code otherwise.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The first changed datapoint ID.
+ * @param[in]   valCount: The changed value count.
  */
-static inline int notifyIntSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+static inline void markComputedDirty(DatapointType_t type, uint32_t datapointId, size_t valCount)
 {
-  int err;
-  SrvMsgPayload_t *payload;
+#ifdef CONFIG_ENYA_DATASTORE_COMPUTED
+  const DatastoreComputed_t *computed;
 
-  payload = osMemoryPoolAlloc(pool, DATASTORE_BUFFER_ALLOC_TIMEOUT);
-  if(!payload)
+  for(size_t i = 0; i < COMPUTED_COUNT; ++i)
   {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate a buffer for signed integer notification", err);
-    return err;
+    computed = computedPoints + i;
+    if(computed->inputType == type && datapointId < computed->firstInputId + computed->inputCount &&
+       computed->firstInputId < datapointId + valCount)
+      computedDirty |= BIT(i);
   }
+#else
+  ARG_UNUSED(type);
+  ARG_UNUSED(datapointId);
+  ARG_UNUSED(valCount);
+#endif
+}
 
-  payload->poolId = pool;
-  payload->dataLen = sub->valCount * sizeof(Data_t);
-
-  for(size_t i = 0; i < sub->valCount; ++i)
-    payload->data[i].intVal = ints[sub->datapointId + i].value.intVal;
+/**
+ * @brief   Save the notification state of a notified subscription.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   sub: The subscription.
+ */
+static inline void markSubNotified(DatapointType_t type, DatastoreSubEntry_t *sub)
+{
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+  sub->lastNotifyMs = k_uptime_get();
+  sub->isPending = false;
 
-  return sub->callback(payload, sub->valCount);
+  if(sub->refValues)
+  {
+    for(size_t i = 0; i < sub->valCount; ++i)
+      sub->refValues[i] = getDatapointValue(type, sub->datapointId + i);
+  }
+#else
+  ARG_UNUSED(type);
+  ARG_UNUSED(sub);
+#endif
 }
 
 /**
- * @brief   Notify signed integer subscription.
+ * @brief   Initialize the notification state of a new subscription.
  *
- * @param[in]   datapointId: The datapoint ID.
- * @param[in]   pool: The buffer pool.
+ * @note    The deadband reference values are only allocated when the
+ *          subscription has a deadband.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   sub: The subscription.
  *
  * @return  0 if successful, the error code otherwise.
  */
-static inline int notifyIntSubs(uint32_t datapointId, osMemoryPoolId_t pool)
+static inline int initSubNotifyState(DatapointType_t type, DatastoreSubEntry_t *sub)
 {
-  int err = 0;
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+  int err;
+
+  sub->refValues = NULL;
 
-  for(size_t i = 0; i < intSubs.activeCount && err == 0; ++i)
+  if(sub->deadband.uintVal != 0)
   {
-    if(isIntDatapointInSubRange(datapointId, intSubs.entries + i) && !intSubs.entries[i].isPaused)
+    sub->refValues = k_malloc(sub->valCount * sizeof(Data_t));
+    if(!sub->refValues)
     {
-      err = notifyIntSub(intSubs.entries + i, pool);
-      if(err < 0)
-        LOG_ERR("ERROR %d: unable to notify for signed integer entry %d", err, i);
+      err = -ENOMEM;
+      LOG_ERR("ERROR %d: unable to allocate the subscription deadband reference", err);
+      return err;
     }
   }
 
-  return err;
+  markSubNotified(type, sub);
+#else
+  ARG_UNUSED(type);
+  ARG_UNUSED(sub);
+#endif
+
+  return 0;
 }
 
 /**
- * @brief   Check if the multi-state datapoint is in range of the subscription.
+ * @brief   Release the notification state of a removed subscription.
  *
- * @param[in]   datapointId: The datapoint ID.
  * @param[in]   sub: The subscription.
+ */
+static inline void releaseSubNotifyState(DatastoreSubEntry_t *sub)
+{
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+  if(sub->refValues)
+    k_free(sub->refValues);
+
+  sub->refValues = NULL;
+#else
+  ARG_UNUSED(sub);
+#endif
+}
+
+/**
+ * @brief   Check if the datapoint ID and the value count are valid.
  *
- * @return  true if the datapoint is in range, false otherwise.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The value count.
+ * @param[in]   datapointCount: The datapoint count.
+ *
+ * @return  true if the datapoint ID and value count are valid, false otherwise.
  */
-static inline bool isMultiStateDatapointInSubRange(uint32_t datapointId, DatastoreSubEntry_t *sub)
+static inline bool isDatapointIdAndValCountValid(uint32_t datapointId, size_t valCount, size_t datapointCount)
 {
-  return datapointId >= sub->datapointId && datapointId < (sub->datapointId + sub->valCount);
+  return datapointId < datapointCount && datapointId + valCount <= datapointCount;
 }
 
 /**
- * @brief   Notify a single multi-state subscription.
+ * @brief   Write values to a datapoint range.
  *
- * @param[in]   sub: The subscription.
- * @param[in]   pool: The buffer pool.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The first datapoint ID.
+ * @param[in]   values: The values to write.
+ * @param[in]   valCount: The value count.
+ * @param[out]  changed: The span from the first to the last changed datapoint.
  *
- * @return  0 if successful, the error code otherwise.
+ * @return  true if at least one value changed, false otherwise.
  */
-static inline int notifyMultiStateSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+static inline bool writeDatapoints(DatapointType_t type, uint32_t datapointId, Data_t values[], size_t valCount,
+                                   DatapointSpan_t *changed)
 {
-  int err;
-  SrvMsgPayload_t *payload;
+  Data_t value;
 
-  payload = osMemoryPoolAlloc(pool, DATASTORE_BUFFER_ALLOC_TIMEOUT);
-  if(!payload)
+  changed->valCount = 0;
+
+  for(size_t i = 0; i < valCount; ++i)
   {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate a buffer for multi-state notification", err);
-    return err;
-  }
+    value = getStoredValue(type, values[i]);
+    if(value.uintVal != getDatapointValue(type, datapointId + i).uintVal)
+    {
+      if(changed->valCount == 0)
+        changed->datapointId = datapointId + i;
 
-  payload->poolId = pool;
-  payload->dataLen = sub->valCount * sizeof(Data_t);
+      changed->valCount = datapointId + i + 1 - changed->datapointId;
+      markDatapointDirty(type, datapointId + i);
+      markNvmDirty(type, datapointId + i);
+    }
 
-  for(size_t i = 0; i < sub->valCount; ++i)
-    payload->data[i].uintVal = multiStates[sub->datapointId + i].value.uintVal;
+    setDatapointValue(type, datapointId + i, value);
+    recordHistory(type, datapointId + i, value);
+  }
+
+  if(changed->valCount > 0)
+    markComputedDirty(type, changed->datapointId, changed->valCount);
 
-  return sub->callback(payload, sub->valCount);
+  return changed->valCount > 0;
 }
 
 /**
- * @brief   Notify multi-state subscriptions.
+ * @brief   Evaluate the dirty computed datapoints.
  *
- * @param[in]   datapointId: The datapoint ID.
- * @param[in]   pool: The buffer pool.
+ * @note    Called once per write message, after all its values are applied,
+ *          so a computed datapoint is evaluated once however many of its
+ *          inputs changed. The datapoints are evaluated in declaration
+ *          order, a computed input being evaluated before its dependents.
+ *
+ * @param[in]   pool: The notification pool, NULL to skip the notifications.
  *
  * @return  0 if successful, the error code otherwise.
  */
-static inline int notifyMultiStateSubs(uint32_t datapointId, osMemoryPoolId_t pool)
+static int evaluateComputed(osMemoryPoolId_t pool)
 {
   int err = 0;
-
-  for(size_t i = 0; i < multiStateSubs.activeCount && err == 0; ++i)
+#ifdef CONFIG_ENYA_DATASTORE_COMPUTED
+#ifndef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+  int errNotify;
+#endif
+  bool isChanged;
+  Data_t value;
+  Data_t inputs[CONFIG_ENYA_DATASTORE_COMPUTED_MAX_INPUTS];
+  DatapointSpan_t changed;
+  const DatastoreComputed_t *computed;
+
+  for(size_t i = 0; i < COMPUTED_COUNT && computedDirty != 0; ++i)
   {
-    if(isMultiStateDatapointInSubRange(datapointId, multiStateSubs.entries + i) && !multiStateSubs.entries[i].isPaused)
+    if(!(computedDirty & BIT(i)))
+      continue;
+
+    computedDirty &= ~BIT(i);
+    computed = computedPoints + i;
+
+    for(size_t j = 0; j < computed->inputCount; ++j)
+      inputs[j] = getDatapointValue(computed->inputType, computed->firstInputId + j);
+
+    value = computed->evaluator(inputs, computed->inputCount);
+
+    beginDatapointWrite(computed->type);
+    isChanged = writeDatapoints(computed->type, computed->datapointId, &value, 1, &changed);
+    endDatapointWrite(computed->type);
+
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+    /* The dirty bitmaps carry the change to the next notification flush */
+    ARG_UNUSED(isChanged);
+    ARG_UNUSED(pool);
+#else
+    if(isChanged && pool)
     {
-      err = notifyMultiStateSub(multiStateSubs.entries + i, pool);
-      if(err < 0)
-        LOG_ERR("ERROR %d: unable to notify for multi-state entry %d", err, i);
+      errNotify = datastoreUtilNotify(computed->type, computed->datapointId, 1, pool);
+      err = err < 0 ? err : errNotify;
     }
+#endif
   }
 
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to notify the computed datapoints", err);
+#else
+  ARG_UNUSED(pool);
+#endif
+
   return err;
 }
 
+#if defined(CONFIG_ENYA_DATASTORE_BATCH) || defined(CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY) || \
+    defined(CONFIG_ENYA_DATASTORE_SUB_INDEX)
+/**
+ * @brief   The subscriptions of each value type.
+ */
+static struct DatastoreSubs *subscriptions[DATAPOINT_TYPE_COUNT] = {
+#define X(Name, name, TYPE, label, valueType) &name##Subs,
+  DATASTORE_VALUE_TYPES
+#undef X
+};
+
 /**
- * @brief   Check if the unsigned integer datapoint is in range of the subscription.
+ * @brief   The single subscription notifier of each value type.
+ */
+static int (*const subNotifiers[DATAPOINT_TYPE_COUNT])(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool) = {
+#define X(Name, name, TYPE, label, valueType) notify##Name##Sub,
+  DATASTORE_VALUE_TYPES
+#undef X
+};
+
+/**
+ * @brief   Notify a subscription of a changed datapoint range.
  *
- * @param[in]   datapointId: The datapoint ID.
- * @param[in]   sub: The subscription.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   sub: The subscription to notify.
+ * @param[in]   datapointId: The first changed datapoint ID.
+ * @param[in]   valCount: The changed datapoint count.
+ * @param[in]   pool: The buffer pool.
  *
- * @return  true if the datapoint is in range, false otherwise.
+ * @return  0 if successful, the error code otherwise.
  */
-static inline bool isUintDatapointInSubRange(uint32_t datapointId, DatastoreSubEntry_t *sub)
+static inline int notifySubChange(DatapointType_t type, DatastoreSubEntry_t *sub, uint32_t datapointId,
+                                  size_t valCount, osMemoryPoolId_t pool)
 {
-  return datapointId >= sub->datapointId && datapointId < (sub->datapointId + sub->valCount);
+  if(isDeltaSub(sub))
+    return notifySubDelta(type, sub, datapointId, valCount, pool);
+
+  return subNotifiers[type](sub, pool);
 }
+#endif
 
 /**
- * @brief   Notify a single unsigned integer subscription.
+ * @brief   Add a subscription slot to the subscription index.
  *
- * @param[in]   sub: The subscription.
- * @param[in]   pool: The buffer pool.
+ * @note    The datapoints out of the datapoint range are not indexed.
  *
- * @return  0 if successful, the error code otherwise.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   slot: The subscription slot.
  */
-static inline int notifyUintSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+static inline void indexSub(DatapointType_t type, size_t slot)
 {
-  int err;
-  SrvMsgPayload_t *payload;
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+  DatastoreSubEntry_t *sub = subscriptions[type]->entries + slot;
+
+  for(uint32_t id = sub->datapointId; id < sub->datapointId + sub->valCount && id < datapointCounts[type]; ++id)
+    subIndexes[type][id] |= BIT64(slot);
+#else
+  ARG_UNUSED(type);
+  ARG_UNUSED(slot);
+#endif
+}
 
-  payload = osMemoryPoolAlloc(pool, DATASTORE_BUFFER_ALLOC_TIMEOUT);
-  if(!payload)
-  {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate a buffer for unsigned integer notification", err);
-    return err;
-  }
+/**
+ * @brief   Rebuild the subscription index of a value type.
+ *
+ * @note    Removing a subscription shifts the following slots down, so the
+ *          whole index is rebuilt.
+ *
+ * @param[in]   type: The datapoint type.
+ */
+static inline void rebuildSubIndex(DatapointType_t type)
+{
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+  memset(subIndexes[type], 0, datapointCounts[type] * sizeof(uint64_t));
+
+  for(size_t i = 0; i < subscriptions[type]->activeCount; ++i)
+    indexSub(type, i);
+#else
+  ARG_UNUSED(type);
+#endif
+}
 
-  payload->poolId = pool;
-  payload->dataLen = sub->valCount * sizeof(Data_t);
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+/**
+ * @brief   Get the mask of the subscriptions covering a datapoint range.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The first datapoint ID of the range.
+ * @param[in]   valCount: The datapoint count of the range.
+ *
+ * @return  The subscription slot mask.
+ */
+static inline uint64_t getRangeSubMask(DatapointType_t type, uint32_t datapointId, size_t valCount)
+{
+  uint64_t mask = 0;
 
-  for(size_t i = 0; i < sub->valCount; ++i)
-    payload->data[i].uintVal = uints[sub->datapointId + i].value.uintVal;
+  for(size_t i = 0; i < valCount; ++i)
+    mask |= subIndexes[type][datapointId + i];
 
-  return sub->callback(payload, sub->valCount);
+  return mask;
 }
 
 /**
- * @brief   Notify unsigned integer subscriptions.
+ * @brief   Notify the subscriptions covering a datapoint range using the subscription index.
  *
- * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The first changed datapoint ID.
+ * @param[in]   valCount: The changed datapoint count.
  * @param[in]   pool: The buffer pool.
  *
  * @return  0 if successful, the error code otherwise.
  */
-static inline int notifyUintSubs(uint32_t datapointId, osMemoryPoolId_t pool)
+static int notifyIndexedSubs(DatapointType_t type, uint32_t datapointId, size_t valCount, osMemoryPoolId_t pool)
 {
   int err = 0;
+  size_t slot;
+  uint64_t mask;
+  struct DatastoreSubs *subs = subscriptions[type];
 
-  for(size_t i = 0; i < uintSubs.activeCount && err == 0; ++i)
+  if(!isDatapointIdAndValCountValid(datapointId, valCount, datapointCounts[type]))
+    return 0;
+
+  mask = getRangeSubMask(type, datapointId, valCount);
+
+  while(mask != 0 && err == 0)
   {
-    if(isUintDatapointInSubRange(datapointId, uintSubs.entries + i) && !uintSubs.entries[i].isPaused)
+    slot = u64_count_trailing_zeros(mask);
+    mask &= mask - 1;
+
+    if(!subs->entries[slot].isPaused)
     {
-      err = notifyUintSub(uintSubs.entries + i, pool);
+      err = notifySubChange(type, subs->entries + slot, datapointId, valCount, pool);
       if(err < 0)
-        LOG_ERR("ERROR %d: unable to notify for unsigned integer entry %d", err, i);
+        LOG_ERR("ERROR %d: unable to notify for datapoint type %d entry %d", err, type, slot);
     }
   }
 
   return err;
 }
+#endif
 
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
 /**
- * @brief   Check if the datapoint ID and the value count are valid.
+ * @brief   Check if a datapoint of the subscription range is dirty.
  *
- * @param[in]   datapointId: The datapoint ID.
- * @param[in]   valCount: The value count.
- * @param[in]   datapointCount: The datapoint count.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   sub: The subscription.
  *
- * @return  true if the datapoint ID and value count are valid, false otherwise.
+ * @return  true if a datapoint is dirty, false otherwise.
  */
-static inline bool isDatapointIdAndValCountValid(uint32_t datapointId, size_t valCount, size_t datapointCount)
-{
-  return datapointId < datapointCount && datapointId + valCount <= datapointCount;
-}
-
-int datastoreUtilAllocateBinarySubs(size_t maxSubCount)
+static inline bool isSubRangeDirty(DatapointType_t type, DatastoreSubEntry_t *sub)
 {
-  int err;
+  uint32_t datapointId;
 
-  binarySubs.entries = k_malloc(maxSubCount * sizeof(DatastoreSubEntry_t));
-  if(!binarySubs.entries)
+  for(size_t i = 0; i < sub->valCount; ++i)
   {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate memory for binary subscriptions", err);
-    return err;
+    datapointId = sub->datapointId + i;
+    if(dirtyBitmaps[type][datapointId / 32] & BIT(datapointId % 32))
+      return true;
   }
 
-  binarySubs.maxCount = maxSubCount;
-
-  return 0;
+  return false;
 }
 
-int datastoreUtilAllocateButtonSubs(size_t maxSubCount)
+/**
+ * @brief   Get the span from the first to the last dirty datapoint of the subscription range.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   sub: The subscription.
+ * @param[out]  span: The dirty span, left untouched when the range is clean.
+ */
+static inline void getSubDirtySpan(DatapointType_t type, DatastoreSubEntry_t *sub, DatapointSpan_t *span)
 {
-  int err;
+  uint32_t datapointId;
+  bool isFirst = true;
 
-  buttonSubs.entries = k_malloc(maxSubCount * sizeof(DatastoreSubEntry_t));
-  if(!buttonSubs.entries)
+  for(size_t i = 0; i < sub->valCount; ++i)
   {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate memory for button subscriptions", err);
-    return err;
-  }
-
-  buttonSubs.maxCount = maxSubCount;
-
-  return 0;
-}
+    datapointId = sub->datapointId + i;
+    if(!(dirtyBitmaps[type][datapointId / 32] & BIT(datapointId % 32)))
+      continue;
 
-int datastoreUtilAllocateFloatSubs(size_t maxSubCount)
-{
-  int err;
+    if(isFirst)
+    {
+      span->datapointId = datapointId;
+      isFirst = false;
+    }
 
-  floatSubs.entries = k_malloc(maxSubCount * sizeof(DatastoreSubEntry_t));
-  if(!floatSubs.entries)
-  {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate memory for float subscriptions", err);
-    return err;
+    span->valCount = datapointId + 1 - span->datapointId;
   }
-
-  floatSubs.maxCount = maxSubCount;
-
-  return 0;
 }
 
-int datastoreUtilAllocateIntSubs(size_t maxSubCount)
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+/**
+ * @brief   Get the mask of the subscriptions covering a dirty datapoint.
+ *
+ * @param[in]   type: The datapoint type.
+ *
+ * @return  The subscription slot mask.
+ */
+static inline uint64_t getDirtySubMask(DatapointType_t type)
 {
-  int err;
+  uint32_t word;
+  uint64_t mask = 0;
 
-  intSubs.entries = k_malloc(maxSubCount * sizeof(DatastoreSubEntry_t));
-  if(!intSubs.entries)
+  for(size_t i = 0; i < DIRTY_BITMAP_WORD_COUNT(datapointCounts[type]); ++i)
   {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate memory for signed integer subscriptions", err);
-    return err;
-  }
+    word = dirtyBitmaps[type][i];
 
-  intSubs.maxCount = maxSubCount;
-
-  return 0;
-}
-
-int datastoreUtilAllocateMultiStateSubs(size_t maxSubCount)
-{
-  int err;
-
-  multiStateSubs.entries = k_malloc(maxSubCount * sizeof(DatastoreSubEntry_t));
-  if(!multiStateSubs.entries)
-  {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate memory for multi-state subscriptions", err);
-    return err;
+    while(word != 0)
+    {
+      mask |= subIndexes[type][i * 32 + u32_count_trailing_zeros(word)];
+      word &= word - 1;
+    }
   }
 
-  multiStateSubs.maxCount = maxSubCount;
-
-  return 0;
+  return mask;
 }
+#endif
 
-int datastoreUtilAllocateUintSubs(size_t maxSubCount)
+/**
+ * @brief   Check if a value of the subscription range moved beyond its deadband.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   sub: The subscription.
+ *
+ * @return  true if the deadband is exceeded or the subscription has none, false otherwise.
+ */
+static inline bool isSubDeadbandExceeded(DatapointType_t type, DatastoreSubEntry_t *sub)
 {
-  int err;
+  Data_t value;
+  Data_t ref;
+  float floatDelta;
+  int64_t delta;
 
-  uintSubs.entries = k_malloc(maxSubCount * sizeof(DatastoreSubEntry_t));
-  if(!uintSubs.entries)
-  {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to allocate memory for unsigned integer subscriptions", err);
-    return err;
-  }
+  if(!sub->refValues)
+    return true;
 
-  uintSubs.maxCount = maxSubCount;
-
-  return 0;
-}
-
-size_t datastoreUtilCalculateBufferSize(size_t datapointCounts[DATAPOINT_TYPE_COUNT])
-{
-  size_t bufferSize = 0;
-
-  for(uint32_t i = 0; i < DATAPOINT_TYPE_COUNT; ++i)
+  for(size_t i = 0; i < sub->valCount; ++i)
   {
-    bufferSize = bufferSize < datapointCounts[i] ? datapointCounts[i] : bufferSize;
-  }
-
-  return bufferSize * sizeof(Datapoint_t);
-}
+    value = getDatapointValue(type, sub->datapointId + i);
+    ref = sub->refValues[i];
 
-int datastoreUtilAddBinarySub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
-{
-  int err;
+    if(type == DATAPOINT_FLOAT)
+    {
+      floatDelta = value.floatVal - ref.floatVal;
+      if(floatDelta > sub->deadband.floatVal || -floatDelta > sub->deadband.floatVal)
+        return true;
+    }
+    else
+    {
+      if(type == DATAPOINT_INT)
+        delta = (int64_t)value.intVal - ref.intVal;
+      else
+        delta = (int64_t)value.uintVal - ref.uintVal;
 
-  if(binarySubs.activeCount + 1 >= binarySubs.maxCount)
-  {
-    err = -ENOBUFS;
-    LOG_ERR("ERROR %d: unable to add new binary subscription, entries full", err);
-    return err;
+      if(delta > sub->deadband.uintVal || -delta > sub->deadband.uintVal)
+        return true;
+    }
   }
 
-  memcpy(binarySubs.entries + binarySubs.activeCount, sub, sizeof(DatastoreSubEntry_t));
-  ++binarySubs.activeCount;
+  return false;
+}
+#endif
 
-  err = notifyBinarySub(sub, pool);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to notify for new binary entry", err);
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
 
-  return err;
+#ifndef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+/**
+ * @brief   Check if a datapoint range overlaps the subscription range.
+ *
+ * @param[in]   datapointId: The first datapoint ID of the range.
+ * @param[in]   valCount: The datapoint count of the range.
+ * @param[in]   sub: The subscription.
+ *
+ * @return  true if the ranges overlap, false otherwise.
+ */
+static inline bool isRangeOverlappingSub(uint32_t datapointId, size_t valCount, DatastoreSubEntry_t *sub)
+{
+  return datapointId < (sub->datapointId + sub->valCount) && sub->datapointId < (datapointId + valCount);
 }
+#endif
 
-int datastoreUtilRemoveBinarySub(DatastoreSubCb_t callback)
+/**
+ * @brief   Get the next operation from a batch buffer.
+ *
+ * @param[in]       buffer: The batch buffer.
+ * @param[in,out]   cursor: The buffer cursor, moved to the next operation.
+ * @param[out]      header: The operation header.
+ *
+ * @return  The operation values.
+ */
+static inline Data_t *getNextBatchOp(Data_t buffer[], size_t *cursor, DatastoreBatchOpHeader_t *header)
 {
-  int err = -ESRCH;
+  Data_t *values;
 
-  for(size_t i = 0; i < binarySubs.activeCount; ++i)
-  {
-    if(binarySubs.entries[i].callback == callback)
-    {
-      /* Shift remaining subscriptions down */
-      for(size_t j = i; j < binarySubs.activeCount - 1; ++j)
-      {
-        binarySubs.entries[j] = binarySubs.entries[j + 1];
-      }
-
-      --binarySubs.activeCount;
-      err = 0;
+  memcpy(header, buffer + *cursor, sizeof(DatastoreBatchOpHeader_t));
+  values = buffer + *cursor + DATASTORE_BATCH_OP_HEADER_LEN;
+  *cursor += DATASTORE_BATCH_OP_HEADER_LEN + header->valCount;
 
-      LOG_INF("removed subscription %d", i);
-      break;
-    }
-  }
-
-  if(err < 0)
-    LOG_ERR("ERROR %d: subscription not found", err);
-
-  return err;
+  return values;
 }
 
-int datastoreUtilSetBinarySubPauseState(DatastoreSubCb_t callback, bool isPaused, osMemoryPoolId_t pool)
+#ifndef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+/**
+ * @brief   Get the changed span of a batch overlapping the subscription range.
+ *
+ * @param[in]   buffer: The batch buffer.
+ * @param[in]   opCount: The operation count.
+ * @param[in]   changedSpans: The changed span of each operation.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   sub: The subscription.
+ * @param[out]  span: The span covering the overlapping changed spans.
+ *
+ * @return  true if a changed span overlaps the subscription, false otherwise.
+ */
+static bool getBatchSubSpan(Data_t buffer[], size_t opCount, DatapointSpan_t changedSpans[], DatapointType_t type,
+                            DatastoreSubEntry_t *sub, DatapointSpan_t *span)
 {
-  int err = -ESRCH;
+  size_t cursor = 0;
+  uint32_t endId = 0;
+  DatastoreBatchOpHeader_t header;
 
-  if(!callback)
-  {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid subscription callback", err);
-    return err;
-  }
+  span->valCount = 0;
 
-  for(size_t i = 0; i < binarySubs.activeCount && err < 0; ++i)
+  for(size_t i = 0; i < opCount; ++i)
   {
-    if(binarySubs.entries[i].callback == callback)
-    {
-      binarySubs.entries[i].isPaused = isPaused;
+    getNextBatchOp(buffer, &cursor, &header);
 
-      if(isPaused)
-      {
-        LOG_INF("binary subscription entry %d paused", i);
-        err = 0;
-      }
-      else
-      {
-        LOG_INF("binary subscription entry %d unpaused", i);
-        err = notifyBinarySub(binarySubs.entries + i, pool);
-        if(err < 0)
-          LOG_ERR("ERROR %d: unable to notify for binary entry", err);
-      }
-    }
-  }
+    if(changedSpans[i].valCount == 0 || header.datapointType != type ||
+       !isRangeOverlappingSub(changedSpans[i].datapointId, changedSpans[i].valCount, sub))
+      continue;
+
+    if(span->valCount == 0 || changedSpans[i].datapointId < span->datapointId)
+      span->datapointId = changedSpans[i].datapointId;
 
-  if(err == -ESRCH)
-    LOG_WRN("ERROR %d: unable to find binary subscription %p", err, callback);
+    endId = MAX(endId, changedSpans[i].datapointId + changedSpans[i].valCount);
+    span->valCount = endId - span->datapointId;
+  }
 
-  return err;
+  return span->valCount > 0;
 }
 
-int datastoreUtilAddButtonSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+/**
+ * @brief   Notify a subscription of the batch changes overlapping its range.
+ *
+ * @param[in]   buffer: The batch buffer.
+ * @param[in]   opCount: The operation count.
+ * @param[in]   changedSpans: The changed span of each operation.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   slot: The subscription slot.
+ * @param[in]   pool: The buffer pool.
+ *
+ * @return  0 if successful or not overlapping, the error code otherwise.
+ */
+static int notifyBatchSub(Data_t buffer[], size_t opCount, DatapointSpan_t changedSpans[], DatapointType_t type,
+                          size_t slot, osMemoryPoolId_t pool)
 {
   int err;
+  DatapointSpan_t span;
+  DatastoreSubEntry_t *sub = subscriptions[type]->entries + slot;
 
-  if(buttonSubs.activeCount + 1 >= buttonSubs.maxCount)
-  {
-    err = -ENOBUFS;
-    LOG_ERR("ERROR %d: unable to add new button subscription, entries full", err);
-    return err;
-  }
-
-  memcpy(buttonSubs.entries + buttonSubs.activeCount, sub, sizeof(DatastoreSubEntry_t));
-  ++buttonSubs.activeCount;
+  if(sub->isPaused || !getBatchSubSpan(buffer, opCount, changedSpans, type, sub, &span))
+    return 0;
 
-  err = notifyButtonSub(sub, pool);
+  err = notifySubChange(type, sub, span.datapointId, span.valCount, pool);
   if(err < 0)
-    LOG_ERR("ERROR %d: unable to notify for new button entry", err);
+    LOG_ERR("ERROR %d: unable to notify for datapoint type %d entry %d", err, type, slot);
 
   return err;
 }
 
-int datastoreUtilRemoveButtonSub(DatastoreSubCb_t callback)
+/**
+ * @brief   Notify once every subscription overlapping a changed batch operation.
+ *
+ * @param[in]   buffer: The batch buffer.
+ * @param[in]   opCount: The operation count.
+ * @param[in]   changedSpans: The changed span of each operation.
+ * @param[in]   type: The datapoint type.
+ * @param[in]   pool: The buffer pool.
+ *
+ * @return  0 if successful, the first error code otherwise.
+ */
+static int notifyBatchSubs(Data_t buffer[], size_t opCount, DatapointSpan_t changedSpans[], DatapointType_t type,
+                           osMemoryPoolId_t pool)
 {
-  int err = -ESRCH;
-
-  for(size_t i = 0; i < buttonSubs.activeCount; ++i)
+  int err = 0;
+  int errNotify;
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+  size_t slot;
+  size_t cursor = 0;
+  uint64_t mask = 0;
+  DatastoreBatchOpHeader_t header;
+
+  for(size_t i = 0; i < opCount; ++i)
   {
-    if(buttonSubs.entries[i].callback == callback)
-    {
-      /* Shift remaining subscriptions down */
-      for(size_t j = i; j < buttonSubs.activeCount - 1; ++j)
-      {
-        buttonSubs.entries[j] = buttonSubs.entries[j + 1];
-      }
+    getNextBatchOp(buffer, &cursor, &header);
+    if(changedSpans[i].valCount > 0 && header.datapointType == type)
+      mask |= getRangeSubMask(type, changedSpans[i].datapointId, changedSpans[i].valCount);
+  }
 
-      --buttonSubs.activeCount;
-      err = 0;
+  while(mask != 0)
+  {
+    slot = u64_count_trailing_zeros(mask);
+    mask &= mask - 1;
 
-      LOG_INF("removed subscription %d", i);
-      break;
-    }
+    errNotify = notifyBatchSub(buffer, opCount, changedSpans, type, slot, pool);
+    err = err < 0 ? err : errNotify;
   }
-
-  if(err < 0)
-    LOG_ERR("ERROR %d: subscription not found", err);
+#else
+  for(size_t i = 0; i < subscriptions[type]->activeCount; ++i)
+  {
+    errNotify = notifyBatchSub(buffer, opCount, changedSpans, type, i, pool);
+    err = err < 0 ? err : errNotify;
+  }
+#endif
 
   return err;
 }
+#endif
+#endif
 
-int datastoreUtilSetButtonSubPauseState(DatastoreSubCb_t callback, bool isPaused, osMemoryPoolId_t pool)
+#ifdef CONFIG_ENYA_DATASTORE_COMPACT_STORAGE
+void datastoreUtilInitDatapoints(void)
 {
-  int err = -ESRCH;
-
-  if(!callback)
-  {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid subscription callback", err);
-    return err;
-  }
+  for(size_t i = 0; i < BINARY_DATAPOINT_COUNT; ++i)
+    setPackedValue(binaryWords, BINARY_VALUE_BIT_COUNT, i, binaryDefaults[i]);
 
-  for(size_t i = 0; i < buttonSubs.activeCount && err < 0; ++i)
-  {
-    if(buttonSubs.entries[i].callback == callback)
-    {
-      buttonSubs.entries[i].isPaused = isPaused;
+  for(size_t i = 0; i < BUTTON_DATAPOINT_COUNT; ++i)
+    setPackedValue(buttonWords, BUTTON_VALUE_BIT_COUNT, i, buttonDefaults[i]);
+}
+#endif
 
-      if(isPaused)
-      {
-        LOG_INF("button subscription entry %d paused", i);
-        err = 0;
-      }
-      else
-      {
-        LOG_INF("button subscription entry %d unpaused", i);
-        err = notifyButtonSub(buttonSubs.entries + i, pool);
-        if(err < 0)
-          LOG_ERR("ERROR %d: unable to notify for button entry", err);
-      }
-    }
+/**
+ * @brief   Define the subscription handlers of a value type.
+ *
+ * @note    Generates the datastoreUtilAllocate<Name>Subs(),
+ *          datastoreUtilAdd<Name>Sub(), datastoreUtilRemove<Name>Sub() and
+ *          datastoreUtilSet<Name>SubPauseState() functions declared in
+ *          datastoreUtil.h. A type without datapoint or subscription
+ *          allocates no subscription entry and rejects the subscriptions,
+ *          the handlers of a type without datapoint compiling out.
+ *
+ * @param[in]   Name: The type function name infix.
+ * @param[in]   name: The type variable name prefix.
+ * @param[in]   TYPE: The type datapoint name infix.
+ * @param[in]   label: The type log label.
+ */
+#define DATASTORE_SUB_HANDLERS_DEFINE(Name, name, TYPE, label)                                          \
+  int datastoreUtilAllocate##Name##Subs(size_t maxSubCount)                                             \
+  {                                                                                                     \
+    int err;                                                                                            \
+                                                                                                        \
+    if(TYPE##_DATAPOINT_COUNT == 0 || maxSubCount == 0)                                                 \
+      return 0;                                                                                         \
+                                                                                                        \
+    name##Subs.entries = k_malloc(maxSubCount * sizeof(DatastoreSubEntry_t));                           \
+    if(!name##Subs.entries)                                                                             \
+    {                                                                                                   \
+      err = -ENOSPC;                                                                                    \
+      LOG_ERR("ERROR %d: unable to allocate memory for " label " subscriptions", err);                  \
+      return err;                                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    name##Subs.maxCount = maxSubCount;                                                                  \
+                                                                                                        \
+    return 0;                                                                                           \
+  }                                                                                                     \
+                                                                                                        \
+  int datastoreUtilAdd##Name##Sub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)                      \
+  {                                                                                                     \
+    int err;                                                                                            \
+                                                                                                        \
+    if(TYPE##_DATAPOINT_COUNT == 0 || name##Subs.activeCount + 1 >= name##Subs.maxCount)                \
+    {                                                                                                   \
+      err = -ENOBUFS;                                                                                   \
+      LOG_ERR("ERROR %d: unable to add new " label " subscription, entries full", err);                 \
+      return err;                                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    memcpy(name##Subs.entries + name##Subs.activeCount, sub, sizeof(DatastoreSubEntry_t));              \
+                                                                                                        \
+    err = initSubNotifyState(DATAPOINT_##TYPE, name##Subs.entries + name##Subs.activeCount);            \
+    if(err < 0)                                                                                         \
+      return err;                                                                                       \
+                                                                                                        \
+    indexSub(DATAPOINT_##TYPE, name##Subs.activeCount);                                                 \
+    ++name##Subs.activeCount;                                                                           \
+                                                                                                        \
+    err = notify##Name##Sub(sub, pool);                                                                 \
+    if(err < 0)                                                                                         \
+      LOG_ERR("ERROR %d: unable to notify for new " label " entry", err);                               \
+                                                                                                        \
+    return err;                                                                                         \
+  }                                                                                                     \
+                                                                                                        \
+  int datastoreUtilRemove##Name##Sub(DatastoreSubCb_t callback)                                         \
+  {                                                                                                     \
+    int err = -ESRCH;                                                                                   \
+                                                                                                        \
+    for(size_t i = 0; TYPE##_DATAPOINT_COUNT > 0 && i < name##Subs.activeCount; ++i)                    \
+    {                                                                                                   \
+      if(name##Subs.entries[i].callback == callback)                                                    \
+      {                                                                                                 \
+        releaseSubNotifyState(name##Subs.entries + i);                                                  \
+                                                                                                        \
+        /* Shift remaining subscriptions down */                                                        \
+        for(size_t j = i; j < name##Subs.activeCount - 1; ++j)                                          \
+        {                                                                                               \
+          name##Subs.entries[j] = name##Subs.entries[j + 1];                                            \
+        }                                                                                               \
+                                                                                                        \
+        --name##Subs.activeCount;                                                                       \
+        rebuildSubIndex(DATAPOINT_##TYPE);                                                              \
+        err = 0;                                                                                        \
+                                                                                                        \
+        LOG_INF("removed subscription %d", i);                                                          \
+        break;                                                                                          \
+      }                                                                                                 \
+    }                                                                                                   \
+                                                                                                        \
+    if(err < 0)                                                                                         \
+      LOG_ERR("ERROR %d: subscription not found", err);                                                 \
+                                                                                                        \
+    return err;                                                                                         \
+  }                                                                                                     \
+                                                                                                        \
+  int datastoreUtilSet##Name##SubPauseState(DatastoreSubCb_t callback, bool isPaused,                   \
+                                            osMemoryPoolId_t pool)                                      \
+  {                                                                                                     \
+    int err = -ESRCH;                                                                                   \
+                                                                                                        \
+    if(!callback)                                                                                       \
+    {                                                                                                   \
+      err = -EINVAL;                                                                                    \
+      LOG_ERR("ERROR %d: invalid subscription callback", err);                                          \
+      return err;                                                                                       \
+    }                                                                                                   \
+                                                                                                        \
+    for(size_t i = 0; TYPE##_DATAPOINT_COUNT > 0 && i < name##Subs.activeCount && err < 0; ++i)         \
+    {                                                                                                   \
+      if(name##Subs.entries[i].callback == callback)                                                    \
+      {                                                                                                 \
+        name##Subs.entries[i].isPaused = isPaused;                                                      \
+                                                                                                        \
+        if(isPaused)                                                                                    \
+        {                                                                                               \
+          LOG_INF(label " subscription entry %d paused", i);                                            \
+          err = 0;                                                                                      \
+        }                                                                                               \
+        else                                                                                            \
+        {                                                                                               \
+          LOG_INF(label " subscription entry %d unpaused", i);                                          \
+          err = notify##Name##Sub(name##Subs.entries + i, pool);                                        \
+          if(err < 0)                                                                                   \
+            LOG_ERR("ERROR %d: unable to notify for " label " entry", err);                             \
+          else                                                                                          \
+            markSubNotified(DATAPOINT_##TYPE, name##Subs.entries + i);                                  \
+        }                                                                                               \
+      }                                                                                                 \
+    }                                                                                                   \
+                                                                                                        \
+    if(err == -ESRCH)                                                                                   \
+      LOG_WRN("ERROR %d: unable to find " label " subscription %p", err, callback);                     \
+                                                                                                        \
+    return err;                                                                                         \
   }
 
-  if(err == -ESRCH)
-    LOG_WRN("ERROR %d: unable to find button subscription %p", err, callback);
-
-  return err;
-}
+#define X(Name, name, TYPE, label, valueType) DATASTORE_SUB_HANDLERS_DEFINE(Name, name, TYPE, label)
+DATASTORE_VALUE_TYPES
+#undef X
 
-int datastoreUtilAddFloatSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+#ifdef CONFIG_ENYA_DATASTORE_COMPUTED
+int datastoreUtilInitComputed(void)
 {
   int err;
+  const DatastoreComputed_t *computed;
 
-  if(floatSubs.activeCount + 1 >= floatSubs.maxCount)
+  for(size_t i = 0; i < COMPUTED_COUNT; ++i)
   {
-    err = -ENOBUFS;
-    LOG_ERR("ERROR %d: unable to add new float subscription, entries full", err);
-    return err;
+    computed = computedPoints + i;
+    if(computed->type >= DATAPOINT_TYPE_COUNT || computed->datapointId >= datapointCounts[computed->type] ||
+       computed->inputType >= DATAPOINT_TYPE_COUNT || !computed->evaluator ||
+       !isDatapointIdAndValCountValid(computed->firstInputId, computed->inputCount,
+                                      datapointCounts[computed->inputType]))
+    {
+      err = -EINVAL;
+      LOG_ERR("ERROR %d: invalid computed datapoint %d", err, i);
+      return err;
+    }
   }
 
-  memcpy(floatSubs.entries + floatSubs.activeCount, sub, sizeof(DatastoreSubEntry_t));
-  ++floatSubs.activeCount;
-
-  err = notifyFloatSub(sub, pool);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to notify for new float entry", err);
+  /* Evaluate from the default values, before any subscription */
+  computedDirty = UINT32_MAX >> (32 - COMPUTED_COUNT);
 
-  return err;
+  return evaluateComputed(NULL);
 }
+#endif
 
-int datastoreUtilRemoveFloatSub(DatastoreSubCb_t callback)
+size_t datastoreUtilCalculateBufferSize(size_t datapointCounts[DATAPOINT_TYPE_COUNT])
 {
-  int err = -ESRCH;
+  size_t bufferSize = 0;
 
-  for(size_t i = 0; i < floatSubs.activeCount; ++i)
+  for(uint32_t i = 0; i < DATAPOINT_TYPE_COUNT; ++i)
   {
-    if(floatSubs.entries[i].callback == callback)
-    {
-      /* Shift remaining subscriptions down */
-      for(size_t j = i; j < floatSubs.activeCount - 1; ++j)
-      {
-        floatSubs.entries[j] = floatSubs.entries[j + 1];
-      }
-
-      --floatSubs.activeCount;
-      err = 0;
-
-      LOG_INF("removed subscription %d", i);
-      break;
-    }
+    bufferSize = bufferSize < datapointCounts[i] ? datapointCounts[i] : bufferSize;
   }
 
-  if(err < 0)
-    LOG_ERR("ERROR %d: subscription not found", err);
+#ifdef CONFIG_ENYA_DATASTORE_DELTA_NOTIFY
+  /* Room for the delta header of a full range notification */
+  bufferSize += DATASTORE_DELTA_HEADER_LEN;
+#endif
 
-  return err;
+  return sizeof(SrvMsgPayload_t) + bufferSize * sizeof(Data_t);
 }
 
-int datastoreUtilSetFloatSubPauseState(DatastoreSubCb_t callback, bool isPaused, osMemoryPoolId_t pool)
+int datastoreUtilRead(DatapointType_t type, uint32_t datapointId, size_t valCount, Data_t values[])
 {
-  int err = -ESRCH;
+  int err;
 
-  if(!callback)
+  if(!isDatapointIdAndValCountValid(datapointId, valCount, datapointCounts[type]))
   {
     err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid subscription callback", err);
+    LOG_ERR("ERROR %d: invalid datapoint ID %d or value count %d", err, datapointId, valCount);
     return err;
   }
 
-  for(size_t i = 0; i < floatSubs.activeCount && err < 0; ++i)
-  {
-    if(floatSubs.entries[i].callback == callback)
-    {
-      floatSubs.entries[i].isPaused = isPaused;
-
-      if(isPaused)
-      {
-        LOG_INF("float subscription entry %d paused", i);
-        err = 0;
-      }
-      else
-      {
-        LOG_INF("float subscription entry %d unpaused", i);
-        err = notifyFloatSub(floatSubs.entries + i, pool);
-        if(err < 0)
-          LOG_ERR("ERROR %d: unable to notify for float entry", err);
-      }
-    }
-  }
-
-  if(err == -ESRCH)
-    LOG_WRN("ERROR %d: unable to find float subscription %p", err, callback);
+  for(size_t i = 0; i < valCount; ++i)
+    values[i] = getDatapointValue(type, datapointId + i);
 
-  return err;
+  return 0;
 }
 
-int datastoreUtilAddIntSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+int datastoreUtilDirectRead(DatapointType_t type, uint32_t datapointId, size_t valCount, Data_t values[])
 {
   int err;
+  atomic_val_t sequence;
 
-  if(intSubs.activeCount + 1 >= intSubs.maxCount)
+  if(type >= DATAPOINT_TYPE_COUNT || !isDatapointIdAndValCountValid(datapointId, valCount, datapointCounts[type]))
   {
-    err = -ENOBUFS;
-    LOG_ERR("ERROR %d: unable to add new signed integer subscription, entries full", err);
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid datapoint type %d, ID %d or value count %d", err, type, datapointId, valCount);
     return err;
   }
 
-  memcpy(intSubs.entries + intSubs.activeCount, sub, sizeof(DatastoreSubEntry_t));
-  ++intSubs.activeCount;
-
-  err = notifyIntSub(sub, pool);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to notify for new signed integer entry", err);
-
-  return err;
-}
+  for(size_t retry = 0; retry <= CONFIG_ENYA_DATASTORE_DIRECT_READ_MAX_RETRIES; ++retry)
+  {
+    sequence = atomic_get(writeSequences + type);
 
-int datastoreUtilRemoveIntSub(DatastoreSubCb_t callback)
-{
-  int err = -ESRCH;
+    /* Odd sequence: a write is in progress */
+    if(sequence & 1)
+      continue;
 
-  for(size_t i = 0; i < intSubs.activeCount; ++i)
-  {
-    if(intSubs.entries[i].callback == callback)
-    {
-      /* Shift remaining subscriptions down */
-      for(size_t j = i; j < intSubs.activeCount - 1; ++j)
-      {
-        intSubs.entries[j] = intSubs.entries[j + 1];
-      }
+    for(size_t i = 0; i < valCount; ++i)
+      values[i] = getDatapointValue(type, datapointId + i);
 
-      --intSubs.activeCount;
-      err = 0;
+    barrier_dmem_fence_full();
 
-      LOG_INF("removed subscription %d", i);
-      break;
-    }
+    if(atomic_get(writeSequences + type) == sequence)
+      return 0;
   }
 
-  if(err < 0)
-    LOG_ERR("ERROR %d: subscription not found", err);
-
-  return err;
+  return -EAGAIN;
 }
+#endif
 
-int datastoreUtilSetIntSubPauseState(DatastoreSubCb_t callback, bool isPaused, osMemoryPoolId_t pool)
+int datastoreUtilWrite(DatapointType_t type, uint32_t datapointId, Data_t values[],
+                       size_t valCount, osMemoryPoolId_t pool)
 {
-  int err = -ESRCH;
+  int err = 0;
+#ifndef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+  int errNotify;
+#endif
+  bool needToNotify = false;
+  DatapointSpan_t changed;
 
-  if(!callback)
+  if(!isDatapointIdAndValCountValid(datapointId, valCount, datapointCounts[type]))
   {
     err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid subscription callback", err);
-    return err;
+    LOG_ERR("ERROR %d: invalid datapoint ID %d or value count %d", err, datapointId, valCount);
+  }
+  else
+  {
+    beginDatapointWrite(type);
+    needToNotify = writeDatapoints(type, datapointId, values, valCount, &changed);
+    endDatapointWrite(type);
   }
 
-  for(size_t i = 0; i < intSubs.activeCount && err < 0; ++i)
+  if(needToNotify)
   {
-    if(intSubs.entries[i].callback == callback)
+    /* The computed datapoints follow their inputs before any notification */
+    err = evaluateComputed(pool);
+
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+    /* The subscribers are notified by the next notification flush */
+    ++dirtyWriteCount;
+#else
+    errNotify = datastoreUtilNotify(type, changed.datapointId, changed.valCount, pool);
+    if(errNotify)
     {
-      intSubs.entries[i].isPaused = isPaused;
-
-      if(isPaused)
-      {
-        LOG_INF("signed integer subscription entry %d paused", i);
-        err = 0;
-      }
-      else
-      {
-        LOG_INF("signed integer subscription entry %d unpaused", i);
-        err = notifyIntSub(intSubs.entries + i, pool);
-        if(err < 0)
-          LOG_ERR("ERROR %d: unable to notify for signed integer entry", err);
-      }
+      err = errNotify;
+      LOG_ERR("ERROR %d: unable to notify", err);
     }
+#endif
   }
 
-  if(err == -ESRCH)
-    LOG_WRN("ERROR %d: unable to find signed integer subscription %p", err, callback);
-
   return err;
 }
 
-int datastoreUtilAddMultiStateSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+int datastoreUtilApplyBatch(Data_t buffer[], size_t opCount, osMemoryPoolId_t pool)
 {
-  int err;
-
-  if(multiStateSubs.activeCount + 1 >= multiStateSubs.maxCount)
+  int err = 0;
+#ifndef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+  int errNotify;
+#endif
+  size_t cursor = 0;
+  uint32_t writtenTypes = 0;
+  uint32_t changedTypes = 0;
+  DatapointSpan_t changedSpans[CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS] = {0};
+  DatastoreBatchOpHeader_t header;
+  Data_t *values;
+
+  if(opCount == 0 || opCount > CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS)
   {
-    err = -ENOBUFS;
-    LOG_ERR("ERROR %d: unable to add new multi-state subscription, entries full", err);
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid batch operation count %d", err, opCount);
     return err;
   }
 
-  memcpy(multiStateSubs.entries + multiStateSubs.activeCount, sub, sizeof(DatastoreSubEntry_t));
-  ++multiStateSubs.activeCount;
+  /* Validate every operation before applying any */
+  for(size_t i = 0; i < opCount; ++i)
+  {
+    getNextBatchOp(buffer, &cursor, &header);
 
-  err = notifyMultiStateSub(sub, pool);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to notify for new multi-state entry", err);
+    if(header.opType >= DATASTORE_BATCH_OP_TYPE_COUNT || header.datapointType >= DATAPOINT_TYPE_COUNT ||
+       header.valCount == 0 ||
+       !isDatapointIdAndValCountValid(header.datapointId, header.valCount, datapointCounts[header.datapointType]))
+    {
+      err = -EINVAL;
+      LOG_ERR("ERROR %d: invalid batch operation %d", err, i);
+      return err;
+    }
 
-  return err;
-}
+    if(header.opType == DATASTORE_BATCH_WRITE)
+      writtenTypes |= BIT(header.datapointType);
+  }
 
-int datastoreUtilRemoveMultiStateSub(DatastoreSubCb_t callback)
-{
-  int err = -ESRCH;
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    if(writtenTypes & BIT(type))
+      beginDatapointWrite(type);
+  }
 
-  for(size_t i = 0; i < multiStateSubs.activeCount; ++i)
+  cursor = 0;
+  for(size_t i = 0; i < opCount; ++i)
   {
-    if(multiStateSubs.entries[i].callback == callback)
+    values = getNextBatchOp(buffer, &cursor, &header);
+
+    if(header.opType == DATASTORE_BATCH_READ)
     {
-      /* Shift remaining subscriptions down */
-      for(size_t j = i; j < multiStateSubs.activeCount - 1; ++j)
-      {
-        multiStateSubs.entries[j] = multiStateSubs.entries[j + 1];
-      }
+      for(size_t j = 0; j < header.valCount; ++j)
+        values[j] = getDatapointValue(header.datapointType, header.datapointId + j);
+    }
+    else
+    {
+      if(writeDatapoints(header.datapointType, header.datapointId, values, header.valCount, changedSpans + i))
+        changedTypes |= BIT(header.datapointType);
+    }
+  }
 
-      --multiStateSubs.activeCount;
-      err = 0;
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    if(writtenTypes & BIT(type))
+      endDatapointWrite(type);
+  }
 
-      LOG_INF("removed subscription %d", i);
-      break;
+  /* The computed datapoints are evaluated once for the whole batch */
+  if(changedTypes)
+    err = evaluateComputed(pool);
+
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+  /* The whole batch counts as a single write for the notification flush */
+  if(changedTypes)
+    ++dirtyWriteCount;
+#else
+  /* Notify after the whole batch is applied so each subscriber sees a coherent state */
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    if(changedTypes & BIT(type))
+    {
+      errNotify = notifyBatchSubs(buffer, opCount, changedSpans, type, pool);
+      err = err < 0 ? err : errNotify;
     }
   }
 
   if(err < 0)
-    LOG_ERR("ERROR %d: subscription not found", err);
+    LOG_ERR("ERROR %d: unable to notify for batch", err);
+#endif
 
   return err;
 }
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_NVM
+size_t datastoreUtilGetNvmCount(DatapointType_t type)
+{
+  if(type >= DATAPOINT_TYPE_COUNT)
+    return 0;
+
+  return nvmDatapointCounts[type];
+}
 
-int datastoreUtilSetMultiStateSubPauseState(DatastoreSubCb_t callback, bool isPaused, osMemoryPoolId_t pool)
+int datastoreUtilRestoreNvm(DatapointType_t type, const Data_t values[], size_t valCount)
 {
-  int err = -ESRCH;
+  int err;
+  size_t cursor = 0;
 
-  if(!callback)
+  if(type >= DATAPOINT_TYPE_COUNT || valCount != nvmDatapointCounts[type])
   {
     err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid subscription callback", err);
+    LOG_ERR("ERROR %d: invalid persisted value count %d for datapoint type %d", err, valCount, type);
     return err;
   }
 
-  for(size_t i = 0; i < multiStateSubs.activeCount && err < 0; ++i)
-  {
-    if(multiStateSubs.entries[i].callback == callback)
-    {
-      multiStateSubs.entries[i].isPaused = isPaused;
+  beginDatapointWrite(type);
 
-      if(isPaused)
-      {
-        LOG_INF("multi-state subscription entry %d paused", i);
-        err = 0;
-      }
-      else
-      {
-        LOG_INF("multi-state subscription entry %d unpaused", i);
-        err = notifyMultiStateSub(multiStateSubs.entries + i, pool);
-        if(err < 0)
-          LOG_ERR("ERROR %d: unable to notify for multi-state entry", err);
-      }
-    }
+  for(size_t i = 0; i < datapointCounts[type] && cursor < valCount; ++i)
+  {
+    if(getDatapointFlags(type, i) & DATAPOINT_FLAG_NVM_MASK)
+      setDatapointValue(type, i, getStoredValue(type, values[cursor++]));
   }
 
-  if(err == -ESRCH)
-    LOG_WRN("ERROR %d: unable to find multi-state subscription %p", err, callback);
+  endDatapointWrite(type);
 
-  return err;
+  /* No subscription exists before the restore */
+  markComputedDirty(type, 0, datapointCounts[type]);
+  evaluateComputed(NULL);
+
+  return 0;
 }
 
-int datastoreUtilAddUintSub(DatastoreSubEntry_t *sub, osMemoryPoolId_t pool)
+uint32_t datastoreUtilGetNvmDirtyTypes(void)
 {
-  int err;
+  return nvmDirtyTypes;
+}
+
+size_t datastoreUtilSnapshotNvm(DatapointType_t type, Data_t values[])
+{
+  size_t cursor = 0;
 
-  if(uintSubs.activeCount + 1 >= uintSubs.maxCount)
+  if(type >= DATAPOINT_TYPE_COUNT)
+    return 0;
+
+  for(size_t i = 0; i < datapointCounts[type]; ++i)
   {
-    err = -ENOBUFS;
-    LOG_ERR("ERROR %d: unable to add new unsigned integer subscription, entries full", err);
-    return err;
+    if(getDatapointFlags(type, i) & DATAPOINT_FLAG_NVM_MASK)
+      values[cursor++] = getDatapointValue(type, i);
   }
 
-  memcpy(uintSubs.entries + uintSubs.activeCount, sub, sizeof(DatastoreSubEntry_t));
-  ++uintSubs.activeCount;
-
-  err = notifyUintSub(sub, pool);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to notify for new unsigned integer entry", err);
+  nvmDirtyTypes &= ~BIT(type);
 
-  return err;
+  return cursor;
 }
+#endif
 
-int datastoreUtilRemoveUintSub(DatastoreSubCb_t callback)
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+int datastoreUtilFlushNotify(int64_t now, osMemoryPoolId_t pool)
 {
-  int err = -ESRCH;
-
-  for(size_t i = 0; i < uintSubs.activeCount; ++i)
+  int err = 0;
+  int errNotify;
+  bool isDue;
+  bool isDirty;
+  struct DatastoreSubs *subs;
+  DatastoreSubEntry_t *sub;
+  DatapointSpan_t span;
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+  uint64_t dirtySubs;
+#endif
+
+  if(dirtyWriteCount == 0 && !hasPendingSubs)
+    return 0;
+
+  isDue = now - lastFlushMs >= CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS;
+#if CONFIG_ENYA_DATASTORE_NOTIFY_WRITE_THRESHOLD > 0
+  isDue = isDue || dirtyWriteCount >= CONFIG_ENYA_DATASTORE_NOTIFY_WRITE_THRESHOLD;
+#endif
+
+  if(!isDue)
+    return 0;
+
+  lastFlushMs = now;
+  dirtyWriteCount = 0;
+  hasPendingSubs = false;
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
   {
-    if(uintSubs.entries[i].callback == callback)
-    {
-      /* Shift remaining subscriptions down */
-      for(size_t j = i; j < uintSubs.activeCount - 1; ++j)
-      {
-        uintSubs.entries[j] = uintSubs.entries[j + 1];
-      }
+    subs = subscriptions[type];
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+    dirtySubs = (dirtyTypes & BIT(type)) ? getDirtySubMask(type) : 0;
+#endif
 
-      --uintSubs.activeCount;
-      err = 0;
+    for(size_t i = 0; i < subs->activeCount; ++i)
+    {
+      sub = subs->entries + i;
 
-      LOG_INF("removed subscription %d", i);
-      break;
-    }
-  }
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+      isDirty = (dirtySubs & BIT64(i)) != 0;
+#else
+      isDirty = (dirtyTypes & BIT(type)) && isSubRangeDirty(type, sub);
+#endif
 
-  if(err < 0)
-    LOG_ERR("ERROR %d: subscription not found", err);
+      /* A subscription left pending by an earlier flush gets its whole range */
+      span.datapointId = sub->datapointId;
+      span.valCount = sub->valCount;
+      if(isDirty && !sub->isPending && isDeltaSub(sub))
+        getSubDirtySpan(type, sub, &span);
 
-  return err;
-}
+      if(isDirty)
+        sub->isPending = true;
 
-int datastoreUtilSetUintSubPauseState(DatastoreSubCb_t callback, bool isPaused, osMemoryPoolId_t pool)
-{
-  int err = -ESRCH;
+      if(!sub->isPending)
+        continue;
 
-  if(!callback)
-  {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid subscription callback", err);
-    return err;
-  }
+      /* A paused subscription gets the current values when unpaused */
+      if(sub->isPaused || !isSubDeadbandExceeded(type, sub))
+      {
+        sub->isPending = false;
+        continue;
+      }
 
-  for(size_t i = 0; i < uintSubs.activeCount && err < 0; ++i)
-  {
-    if(uintSubs.entries[i].callback == callback)
-    {
-      uintSubs.entries[i].isPaused = isPaused;
+      if(now - sub->lastNotifyMs < (int64_t)sub->minIntervalMs)
+      {
+        hasPendingSubs = true;
+        continue;
+      }
 
-      if(isPaused)
+      errNotify = notifySubChange(type, sub, span.datapointId, span.valCount, pool);
+      if(errNotify == -ENOSPC)
       {
-        LOG_INF("unsigned integer subscription entry %d paused", i);
-        err = 0;
+        /* Out of buffers, retry at the next flush */
+        hasPendingSubs = true;
       }
       else
       {
-        LOG_INF("unsigned integer subscription entry %d unpaused", i);
-        err = notifyUintSub(uintSubs.entries + i, pool);
-        if(err < 0)
-          LOG_ERR("ERROR %d: unable to notify for unsigned integer entry", err);
+        markSubNotified(type, sub);
+      }
+
+      if(errNotify < 0)
+      {
+        LOG_ERR("ERROR %d: unable to notify for datapoint type %d entry %d", errNotify, type, i);
+        err = err < 0 ? err : errNotify;
       }
     }
+
+    if(dirtyTypes & BIT(type))
+      memset(dirtyBitmaps[type], 0, DIRTY_BITMAP_WORD_COUNT(datapointCounts[type]) * sizeof(uint32_t));
   }
 
-  if(err == -ESRCH)
-    LOG_WRN("ERROR %d: unable to find unsigned integer subscription %p", err, callback);
+  dirtyTypes = 0;
 
   return err;
 }
+#endif
 
-int datastoreUtilRead(DatapointType_t type, uint32_t datapointId, size_t valCount, Data_t values[])
+int datastoreUtilNotify(DatapointType_t type, uint32_t datapointId, size_t valCount, osMemoryPoolId_t pool)
 {
   int err;
-  Datapoint_t *root = datapoints[type];
-
-  if(!isDatapointIdAndValCountValid(datapointId, valCount, datapointCounts[type]))
-  {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid datapoint ID %d or value count %d", err, datapointId, valCount);
-    return err;
-  }
-
-  for(size_t i = 0; i < valCount; ++i)
-    values[i] = root[datapointId + i].value;
-
-  return 0;
-}
-
-int datastoreUtilWrite(DatapointType_t type, uint32_t datapointId, Data_t values[],
-                       size_t valCount, osMemoryPoolId_t pool)
-{
-  int err = 0;
-  bool needToNotify = false;
-  Datapoint_t *root = datapoints[type];
-
-  if(!isDatapointIdAndValCountValid(datapointId, valCount, datapointCounts[type]))
-  {
-    err = -EINVAL;
-    LOG_ERR("ERROR %d: invalid datapoint ID %d or value count %d", err, datapointId, valCount);
-  }
-  else
-  {
-    for(size_t i = 0; i < valCount; ++i)
-    {
-      needToNotify = needToNotify || values[i].uintVal != root[datapointId + i].value.uintVal;
-      root[datapointId + i].value = values[i];
-    }
-  }
 
-  osMemoryPoolFree(pool, values);
+  SRV_TRACE_BEGIN(DATASTORE_NOTIFY, type);
 
-  if(needToNotify)
+#ifdef CONFIG_ENYA_DATASTORE_SUB_INDEX
+  if(type < DATAPOINT_TYPE_COUNT)
   {
-    err = datastoreUtilNotify(type, datapointId, pool);
-    if(err)
-      LOG_ERR("ERROR %d: unable to notify", err);
+    err = notifyIndexedSubs(type, datapointId, valCount, pool);
+    SRV_TRACE_END(DATASTORE_NOTIFY, type);
+    return err;
   }
-
-  return err;
-}
-
-int datastoreUtilNotify(DatapointType_t type, uint32_t datapointId, osMemoryPoolId_t pool)
-{
-  int err;
+#endif
 
   switch(type)
   {
-    case DATAPOINT_BINARY:
-      err = notifyBinarySubs(datapointId, pool);
-    break;
-    case DATAPOINT_BUTTON:
-      err = notifyButtonSubs(datapointId, pool);
-    break;
-    case DATAPOINT_FLOAT:
-      err = notifyFloatSubs(datapointId, pool);
-    break;
-    case DATAPOINT_INT:
-      err = notifyIntSubs(datapointId, pool);
-    break;
-    case DATAPOINT_MULTI_STATE:
-      err = notifyMultiStateSubs(datapointId, pool);
-    break;
-    case DATAPOINT_UINT:
-      err = notifyUintSubs(datapointId, pool);
+#define X(Name, name, TYPE, label, valueType)                                 \
+    case DATAPOINT_##TYPE:                                                    \
+      err = notify##Name##Subs(datapointId, valCount, pool);                  \
     break;
+    DATASTORE_VALUE_TYPES
+#undef X
     default:
       err = -ENOTSUP;
       LOG_ERR("ERROR %d: unsupported datapoint type %d", err, type);
     break;
   }
 
+  SRV_TRACE_END(DATASTORE_NOTIFY, type);
+
   return err;
 }
 
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+void datastoreUtilGetNotifyStats(DatastoreStats_t *stats)
+{
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+    stats->notifyCounts[type] = (uint32_t)atomic_get(notifyCounts + type);
+
+  stats->notifyAllocFailures = (uint32_t)atomic_get(&notifyAllocFailures);
+}
+
+void datastoreUtilResetNotifyStats(void)
+{
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+    atomic_clear(notifyCounts + type);
+
+  atomic_clear(&notifyAllocFailures);
+}
+#endif
+
 /** @} */
@@ -23,6 +23,28 @@
  */
 #define DATASTORE_BUFFER_ALLOC_TIMEOUT                          (4)
 
+#ifdef CONFIG_ENYA_DATASTORE_COMPACT_STORAGE
+/**
+ * @brief   Initialize the packed datapoints to their default values.
+ *
+ * @note    The word datapoints are initialized at compile time, only the
+ *          packed binaries and buttons need this.
+ */
+void datastoreUtilInitDatapoints(void);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_COMPUTED
+/**
+ * @brief   Validate and evaluate the computed datapoints.
+ *
+ * @note    The computed datapoints are evaluated from the default values,
+ *          then each time one of their inputs changes.
+ *
+ * @return  0 if successful, -EINVAL if a computed datapoint is invalid.
+ */
+int datastoreUtilInitComputed(void);
+#endif
+
 /**
  * @brief   Allocate the array for the binary subscriptions.
  *
@@ -80,6 +102,9 @@ int datastoreUtilAllocateUintSubs(size_t maxSubCount);
 /**
  * @brief   Calculate the maximum buffer size.
  *
+ * @note    The size holds the payload header and the values of the largest
+ *          datapoint range.
+ *
  * @param[in]   datapointCounts: The datapoint count for each type.
  *
  * @return  The calculated maximum buffer size.
@@ -278,6 +303,24 @@ int datastoreUtilSetUintSubPauseState(DatastoreSubCb_t callback, bool isPaused,
  */
 int datastoreUtilRead(DatapointType_t type, uint32_t datapointId, size_t valCount, Data_t values[]);
 
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+/**
+ * @brief   Read from the datastore directly from the calling thread.
+ *
+ * @note    The read is retried while it collides with a write. The output
+ *          buffer content is undefined when -EAGAIN is returned.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   valCount: The value count.
+ * @param[out]  values: The output buffer.
+ *
+ * @return  0 if successful, -EAGAIN if the read kept colliding with writes,
+ *          the error code otherwise.
+ */
+int datastoreUtilDirectRead(DatapointType_t type, uint32_t datapointId, size_t valCount, Data_t values[]);
+#endif
+
 /**
  * @brief   Write to the datastore.
  *
@@ -292,16 +335,106 @@ int datastoreUtilRead(DatapointType_t type, uint32_t datapointId, size_t valCoun
 int datastoreUtilWrite(DatapointType_t type, uint32_t datapointId, Data_t values[],
                        size_t valCount, osMemoryPoolId_t pool);
 
+#ifdef CONFIG_ENYA_DATASTORE_BATCH
+/**
+ * @brief   Apply a batch of operations.
+ *
+ * @note    All operations are validated before any is applied. The read
+ *          values are written in place in the batch buffer.
+ *
+ * @param[in,out]   buffer: The batch buffer.
+ * @param[in]       opCount: The operation count.
+ * @param[in]       pool: The buffer pool.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreUtilApplyBatch(Data_t buffer[], size_t opCount, osMemoryPoolId_t pool);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY
+/**
+ * @brief   Flush the pending subscriber notifications when they are due.
+ *
+ * @note    The notifications are due once CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS
+ *          elapsed since the last flush or after
+ *          CONFIG_ENYA_DATASTORE_NOTIFY_WRITE_THRESHOLD changing writes. A
+ *          subscription still in its minimum interval stays pending.
+ *
+ * @param[in]   now: The current uptime [ms].
+ * @param[in]   pool: The buffer pool.
+ *
+ * @return  0 if successful, the first error code otherwise.
+ */
+int datastoreUtilFlushNotify(int64_t now, osMemoryPoolId_t pool);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_NVM
 /**
- * @brief   Notify subscribers.
+ * @brief   Get the persisted datapoint count of a type.
  *
  * @param[in]   type: The datapoint type.
- * @param[in]   datapointId: The datapoint ID.
+ *
+ * @return  The persisted datapoint count.
+ */
+size_t datastoreUtilGetNvmCount(DatapointType_t type);
+
+/**
+ * @brief   Restore the persisted datapoints of a type.
+ *
+ * @note    The values are the persisted datapoints in ID order and are
+ *          restored in a single pass.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   values: The persisted values.
+ * @param[in]   valCount: The value count, must be the persisted datapoint count.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int datastoreUtilRestoreNvm(DatapointType_t type, const Data_t values[], size_t valCount);
+
+/**
+ * @brief   Get the types having persisted datapoints changed since their last snapshot.
+ *
+ * @return  The dirty type mask.
+ */
+uint32_t datastoreUtilGetNvmDirtyTypes(void);
+
+/**
+ * @brief   Snapshot the persisted datapoints of a type and clear its dirty flag.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[out]  values: The persisted values in ID order.
+ *
+ * @return  The snapshot value count.
+ */
+size_t datastoreUtilSnapshotNvm(DatapointType_t type, Data_t values[]);
+#endif
+
+#ifdef CONFIG_ENYA_DATASTORE_STATS
+/**
+ * @brief   Get the notification statistics.
+ *
+ * @param[out]  stats: The datastore statistics receiving the notification counters.
+ */
+void datastoreUtilGetNotifyStats(DatastoreStats_t *stats);
+
+/**
+ * @brief   Reset the notification statistics.
+ */
+void datastoreUtilResetNotifyStats(void);
+#endif
+
+/**
+ * @brief   Notify the subscribers overlapping a changed datapoint range.
+ *
+ * @param[in]   type: The datapoint type.
+ * @param[in]   datapointId: The first changed datapoint ID.
+ * @param[in]   valCount: The changed datapoint count.
  * @param[in]   pool: The buffer pool.
  *
  * @return  0 if successful, the error code otherwise.
  */
-int datastoreUtilNotify(DatapointType_t type, uint32_t datapointId, osMemoryPoolId_t pool);
+int datastoreUtilNotify(DatapointType_t type, uint32_t datapointId, size_t valCount, osMemoryPoolId_t pool);
 
 #endif    /* DATASTORE_SRV_UTIL */
 
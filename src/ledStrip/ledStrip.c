@@ -13,10 +13,13 @@
  * @{
  */
 
+#include <string.h>
 #include <zephyr/logging/log.h>
 
 #include "ledStrip.h"
 #include "ledStripUtil.h"
+#include "ledStripEffect.h"
+#include "ledStripZone.h"
 #include "serviceManager.h"
 
 /* Setting module logging */
@@ -33,9 +36,20 @@ K_THREAD_STACK_DEFINE(ledStripStack, CONFIG_ENYA_LED_STRIP_STACK_SIZE);
 #define LED_STRIP_MSG_QUEUE_SIZE 5
 
 /**
- * @brief   The framerate.
+ * @brief   The refresh period whole ticks.
  */
-#define LED_STRIP_FRAME_RATE (1000 / CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ)
+#define FRAME_PERIOD_TICKS (CONFIG_SYS_CLOCK_TICKS_PER_SEC / CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ)
+
+/**
+ * @brief   The refresh period tick fraction, in 1/CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ ticks.
+ */
+#define FRAME_PERIOD_REMAINDER (CONFIG_SYS_CLOCK_TICKS_PER_SEC % CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ)
+
+/**
+ * @brief   The refresh period budget in microseconds.
+ */
+#define FRAME_PERIOD_US (1000000 / CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ)
+
 /**
  * @brief   The service message types.
  */
@@ -45,6 +59,8 @@ typedef enum
   LED_STRIP_SUSPEND_MSG,
   LED_STRIP_NEW_FRAME_MSG,
   LED_STRIP_BRIGHTNESS_MSG,
+  LED_STRIP_EFFECT_START_MSG,
+  LED_STRIP_EFFECT_STOP_MSG,
   LED_STIP_MGS_TYPE_COUNT
 } LedStipMsgType_t;
 
@@ -54,8 +70,13 @@ typedef enum
 typedef struct
 {
   LedStipMsgType_t type;
+  size_t strip;
   uint8_t brightness;
   struct led_rgb *framebuffer;
+#ifdef CONFIG_ENYA_LED_STRIP_EFFECTS
+  size_t effectSlot;
+  LedStripEffect_t effect;
+#endif
 } LedStripMessage_t;
 
 /**
@@ -63,6 +84,11 @@ typedef struct
  */
 static struct k_thread thread;
 
+/**
+ * @brief   The service manager handle of the LED strip service.
+ */
+static ServiceHandle_t serviceHandle;
+
 /**
  * @brief   The service state.
  */
@@ -78,6 +104,104 @@ K_MSGQ_DEFINE(ledStipMsgQueue, sizeof(LedStripMessage_t), LED_STRIP_MSG_QUEUE_SI
  */
 K_TIMER_DEFINE(frameTimer, NULL, NULL);
 
+/**
+ * @brief   The frame push semaphore, held by the thread while the strips are
+ *          pushed, the restart aborting it between two pushes only.
+ */
+K_SEM_DEFINE(pushSem, 1, 1);
+
+/**
+ * @brief   The next refresh deadline, in ticks.
+ */
+static int64_t frameDeadline;
+
+/**
+ * @brief   The tick fraction accumulated by the deadlines, in
+ *          1/CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ ticks.
+ */
+static uint32_t frameRemainder;
+
+#ifdef CONFIG_ENYA_LED_STRIP_STATS
+/**
+ * @brief   The frame statistics.
+ */
+static LedStripStats_t stats;
+
+/**
+ * @brief   The statistics lock.
+ */
+static struct k_spinlock statsLock;
+#endif
+
+/**
+ * @brief   Restart the frame pacing from now.
+ */
+static void resetPacing(void)
+{
+  frameDeadline  = k_uptime_ticks();
+  frameRemainder = 0;
+}
+
+/**
+ * @brief   Arm the frame timer at the next refresh deadline.
+ *
+ * @note    The deadlines are absolute and accumulate the period tick fraction,
+ *          the refresh rate holding exactly over time. A missed deadline
+ *          restarts the pacing from now instead of catching up.
+ *
+ * @return  True if the frame work overran the next deadline, false otherwise.
+ */
+static bool armNextFrame(void)
+{
+  bool isMissed;
+  int64_t now;
+
+  frameDeadline  += FRAME_PERIOD_TICKS;
+  frameRemainder += FRAME_PERIOD_REMAINDER;
+  if(frameRemainder >= CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ)
+  {
+    frameRemainder -= CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ;
+    ++frameDeadline;
+  }
+
+  now      = k_uptime_ticks();
+  isMissed = frameDeadline <= now;
+  if(isMissed)
+  {
+    resetPacing();
+    frameDeadline += FRAME_PERIOD_TICKS;
+  }
+
+  k_timer_start(&frameTimer, K_TIMEOUT_ABS_TICKS(frameDeadline), K_NO_WAIT);
+
+  return isMissed;
+}
+
+#ifdef CONFIG_ENYA_LED_STRIP_STATS
+/**
+ * @brief   Record the statistics of a frame.
+ *
+ * @param[in]   transmitCycles: The push duration in cycles.
+ * @param[in]   drainCount: The messages drained.
+ * @param[in]   isMissed: The missed deadline flag.
+ */
+static void recordFrameStats(uint32_t transmitCycles, uint32_t drainCount, bool isMissed)
+{
+  uint32_t transmitUs  = k_cyc_to_us_floor32(transmitCycles);
+  k_spinlock_key_t key = k_spin_lock(&statsLock);
+
+  ++stats.frameCount;
+  if(isMissed)
+    ++stats.missedDeadlineCount;
+  stats.transmitLastUs = transmitUs;
+  stats.transmitMaxUs  = MAX(stats.transmitMaxUs, transmitUs);
+  stats.drainLastCount = drainCount;
+  stats.drainMaxCount  = MAX(stats.drainMaxCount, drainCount);
+
+  k_spin_unlock(&statsLock, key);
+}
+#endif
+
 /**
  * @brief   LED strip updater thread.
  *
@@ -88,18 +212,25 @@ K_TIMER_DEFINE(frameTimer, NULL, NULL);
 static void run(void *p1, void *p2, void *p3)
 {
   int err;
+  bool isMissed;
+  uint32_t drainCount;
+  uint32_t transmitCycles;
   LedStripMessage_t msg;
+#ifdef CONFIG_ENYA_LED_STRIP_MAILBOX
+  struct led_rgb *frame;
+#endif
 
   ARG_UNUSED(p1);
   ARG_UNUSED(p2);
   ARG_UNUSED(p3);
 
   state = SVC_STATE_RUNNING;
-  err   = serviceManagerConfirmState(k_current_get(), state);
+  err   = serviceManagerConfirmState(serviceHandle, state);
   if(err < 0)
     LOG_ERR("ERROR %d: unable to confirm service state", err);
 
-  k_timer_start(&frameTimer, K_MSEC(LED_STRIP_FRAME_RATE), K_MSEC(LED_STRIP_FRAME_RATE));
+  resetPacing();
+  armNextFrame();
 
 #ifdef LED_STRIP_RUN_ITERATIONS
   for(size_t i = 0; i < LED_STRIP_RUN_ITERATIONS; ++i)
@@ -109,17 +240,19 @@ static void run(void *p1, void *p2, void *p3)
   {
     k_timer_status_sync(&frameTimer);
 
+    drainCount = 0;
     while(k_msgq_get(&ledStipMsgQueue, &msg, K_NO_WAIT) == 0)
     {
+      ++drainCount;
       switch(msg.type)
       {
         case LED_STRIP_NEW_FRAME_MSG:
-          ledStripUtilActivateFrame(msg.framebuffer);
+          ledStripUtilActivateFrame(msg.strip, msg.framebuffer);
           break;
         case LED_STRIP_STOP_MSG:
           state = SVC_STATE_STOPPED;
           k_timer_stop(&frameTimer);
-          err = serviceManagerConfirmState(k_current_get(), state);
+          err = serviceManagerConfirmState(serviceHandle, state);
           if(err < 0)
             LOG_ERR("ERROR %d: unable to confirme stopped state", err);
           k_thread_abort(k_current_get());
@@ -127,27 +260,59 @@ static void run(void *p1, void *p2, void *p3)
         case LED_STRIP_SUSPEND_MSG:
           state = SVC_STATE_SUSPENDED;
           k_timer_stop(&frameTimer);
-          err = serviceManagerConfirmState(k_current_get(), state);
+          err = serviceManagerConfirmState(serviceHandle, state);
           if(err < 0)
             LOG_ERR("ERROR %d: unable to confirm the suspended state", err);
           k_thread_suspend(k_current_get());
+          resetPacing();
           break;
         case LED_STRIP_BRIGHTNESS_MSG:
-          ledStripUtilSetBrightness(msg.brightness);
+          ledStripUtilSetBrightness(msg.strip, msg.brightness);
+          break;
+#ifdef CONFIG_ENYA_LED_STRIP_EFFECTS
+        case LED_STRIP_EFFECT_START_MSG:
+          ledStripEffectStart(msg.effectSlot, &msg.effect);
           break;
+        case LED_STRIP_EFFECT_STOP_MSG:
+          ledStripEffectStop(msg.effectSlot);
+          break;
+#endif
         default:
           err = -ENOTSUP;
           LOG_ERR("ERROR %d: unsupported message type %d", err, msg.type);
       }
     }
 
-    err = ledStripUtilPushFrame();
+#ifdef CONFIG_ENYA_LED_STRIP_MAILBOX
+    for(size_t strip = 0; strip < ledStripUtilGetStripCount(); ++strip)
+    {
+      frame = ledStripUtilTakeFrame(strip);
+      if(frame)
+        ledStripUtilActivateFrame(strip, frame);
+    }
+#endif
+
+    k_sem_take(&pushSem, K_FOREVER);
+    transmitCycles = k_cycle_get_32();
+    err            = ledStripUtilPushFrame();
+    transmitCycles = k_cycle_get_32() - transmitCycles;
+    k_sem_give(&pushSem);
     if(err < 0)
       LOG_ERR("ERROR %d: failed to push active frame", err);
 
-    err = serviceManagerUpdateHeartbeat(k_current_get());
+    err = serviceManagerUpdateHeartbeat(serviceHandle);
     if(err < 0)
       LOG_ERR("ERROR %d: unable to update heartbeat", err);
+
+    isMissed = armNextFrame();
+
+#ifdef CONFIG_ENYA_LED_STRIP_STATS
+    recordFrameStats(transmitCycles, drainCount, isMissed);
+#else
+    ARG_UNUSED(isMissed);
+    ARG_UNUSED(drainCount);
+    ARG_UNUSED(transmitCycles);
+#endif
   }
 }
 
@@ -204,22 +369,85 @@ static int onSuspend(void)
  */
 static int onResume(void)
 {
-  k_timer_start(&frameTimer, K_MSEC(LED_STRIP_FRAME_RATE), K_MSEC(LED_STRIP_FRAME_RATE));
+  /* The thread restarts the pacing and the frame timer once resumed */
   k_thread_resume(&thread);
 
   return 0;
 }
 
-int ledStripInit(void)
+/**
+ * @brief   Create the LED strip thread, started by the service manager.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int createThread(void)
 {
   int err;
   k_tid_t threadId;
+
+  threadId = k_thread_create(&thread, ledStripStack, CONFIG_ENYA_LED_STRIP_STACK_SIZE, run, NULL, NULL, NULL,
+                             CONFIG_ENYA_LED_STRIP_THREAD_PRIORITY, 0, K_FOREVER);
+
+  err = k_thread_name_set(threadId, STRINGIFY(LED_STRIP_LOGGER_NAME));
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to set thread name", err);
+
+  return err;
+}
+
+/**
+ * @brief   Service restart callback: re-creates the thread after missed heartbeats.
+ *
+ * @note    The thread is aborted between two pushes, the driver transfers
+ *          always completing. A push still running after a frame period is
+ *          taken as a stuck driver, the restart failing for the SoC reset.
+ *          The zone lock is a spinlock, never held across a preemption point.
+ *
+ * @note    The frame timer is stopped with the thread. The framebuffers, the
+ *          zones, the effects and the queued messages are kept, the new thread
+ *          confirming RUNNING and restarting the pacing and the frame timer.
+ *          It has the same ID, the registry entry staying valid.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int onRestart(void)
+{
+  int err;
+
+  err = k_sem_take(&pushSem, K_TICKS(FRAME_PERIOD_TICKS));
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: frame push stuck, unable to restart", err);
+    return err;
+  }
+
+  k_thread_abort(&thread);
+  k_timer_stop(&frameTimer);
+
+  err = createThread();
+  k_sem_give(&pushSem);
+  if(err < 0)
+    return err;
+
+  k_thread_start(&thread);
+
+  return 0;
+}
+
+BUILD_ASSERT(CONFIG_ENYA_LED_STRIP_SERVICE_PRIORITY != SVC_PRIORITY_CRITICAL || CONFIG_ENYA_LED_STRIP_MAX_RESTARTS == 0,
+             "a critical LED strip service keeps the SoC reset recovery");
+
+int ledStripInit(void)
+{
+  int err;
   ServiceDescriptor_t descriptior = {.priority            = CONFIG_ENYA_LED_STRIP_SERVICE_PRIORITY,
                                      .heartbeatIntervalMs = CONFIG_ENYA_LED_STRIP_HEARTBEAT_INTERVAL_MS,
                                      .start               = onStart,
                                      .stop                = onStop,
                                      .suspend             = onSuspend,
-                                     .resume              = onResume};
+                                     .resume              = onResume,
+                                     .restart             = onRestart,
+                                     .maxRestarts         = CONFIG_ENYA_LED_STRIP_MAX_RESTARTS};
 
   err = ledStripUtilInitStrip();
   if(err < 0)
@@ -229,46 +457,83 @@ int ledStripInit(void)
   if(err < 0)
     return err;
 
-  threadId = k_thread_create(&thread, ledStripStack, CONFIG_ENYA_LED_STRIP_STACK_SIZE, run, NULL, NULL, NULL,
-                             CONFIG_ENYA_LED_STRIP_THREAD_PRIORITY, 0, K_FOREVER);
-
-  err = k_thread_name_set(threadId, STRINGIFY(LED_STRIP_LOGGER_NAME));
+  err = createThread();
   if(err < 0)
-  {
-    LOG_ERR("ERROR %d: unable to set thread name", err);
     return err;
-  }
 
-  descriptior.threadId = threadId;
+  descriptior.threadId = &thread;
 
-  err = serviceManagerRegisterSrv(&descriptior);
+  err = serviceManagerRegisterSrv(&descriptior, &serviceHandle);
   if(err < 0)
     LOG_ERR("ERROR %d: unable to register service", err);
 
   return err;
 }
 
+size_t ledStripGetStripCount(void)
+{
+  return ledStripUtilGetStripCount();
+}
+
+size_t ledStripGetPixelCount(size_t strip)
+{
+  return ledStripUtilGetPixelCount(strip);
+}
+
 struct led_rgb *ledStripGetNextFramebuffer(void)
 {
-  return ledStripUtilGetNextFramebuffer();
+  return ledStripGetStripFramebuffer(0);
+}
+
+struct led_rgb *ledStripGetStripFramebuffer(size_t strip)
+{
+  return ledStripUtilGetNextFramebuffer(strip);
 }
 
 int ledStripUpdateFrame(struct led_rgb *frame)
 {
+  return ledStripUpdateStripFrame(0, frame);
+}
+
+int ledStripUpdateStripFrame(size_t strip, struct led_rgb *frame)
+{
+#ifdef CONFIG_ENYA_LED_STRIP_MAILBOX
+  return ledStripUtilPostFrame(strip, frame);
+#else
   int err;
-  LedStripMessage_t msg = {.type = LED_STRIP_NEW_FRAME_MSG, .framebuffer = frame};
+  LedStripMessage_t msg = {.type = LED_STRIP_NEW_FRAME_MSG, .strip = strip, .framebuffer = frame};
+
+  if(strip >= ledStripUtilGetStripCount())
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid strip %d", err, strip);
+    return err;
+  }
 
   err = k_msgq_put(&ledStipMsgQueue, &msg, K_NO_WAIT);
   if(err < 0)
     LOG_ERR("ERROR %d: unable to push the new frame", err);
 
   return err;
+#endif
 }
 
 int ledStripSetBrightness(uint8_t brightness)
+{
+  return ledStripSetStripBrightness(0, brightness);
+}
+
+int ledStripSetStripBrightness(size_t strip, uint8_t brightness)
 {
   int err;
-  LedStripMessage_t msg = {.type = LED_STRIP_BRIGHTNESS_MSG, .brightness = brightness};
+  LedStripMessage_t msg = {.type = LED_STRIP_BRIGHTNESS_MSG, .strip = strip, .brightness = brightness};
+
+  if(strip >= ledStripUtilGetStripCount())
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid strip %d", err, strip);
+    return err;
+  }
 
   err = k_msgq_put(&ledStipMsgQueue, &msg, K_NO_WAIT);
   if(err < 0)
@@ -277,4 +542,126 @@ int ledStripSetBrightness(uint8_t brightness)
   return err;
 }
 
+int ledStripStartEffect(size_t slot, const LedStripEffect_t *effect)
+{
+#ifdef CONFIG_ENYA_LED_STRIP_EFFECTS
+  int err;
+  LedStripMessage_t msg = {.type = LED_STRIP_EFFECT_START_MSG, .effectSlot = slot};
+
+  err = ledStripEffectValidate(slot, effect);
+  if(err < 0)
+    return err;
+
+  msg.effect = *effect;
+
+  err = k_msgq_put(&ledStipMsgQueue, &msg, K_NO_WAIT);
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to push the effect start", err);
+
+  return err;
+#else
+  ARG_UNUSED(slot);
+  ARG_UNUSED(effect);
+  return -ENOTSUP;
+#endif
+}
+
+int ledStripStopEffect(size_t slot)
+{
+#ifdef CONFIG_ENYA_LED_STRIP_EFFECTS
+  int err;
+  LedStripMessage_t msg = {.type = LED_STRIP_EFFECT_STOP_MSG, .effectSlot = slot};
+
+  err = k_msgq_put(&ledStipMsgQueue, &msg, K_NO_WAIT);
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to push the effect stop", err);
+
+  return err;
+#else
+  ARG_UNUSED(slot);
+  return -ENOTSUP;
+#endif
+}
+
+int ledStripRegisterZone(uint16_t firstPixel, uint16_t pixelCount, size_t *zoneId)
+{
+#ifdef CONFIG_ENYA_LED_STRIP_ZONES
+  return ledStripZoneRegister(firstPixel, pixelCount, zoneId);
+#else
+  ARG_UNUSED(firstPixel);
+  ARG_UNUSED(pixelCount);
+  ARG_UNUSED(zoneId);
+  return -ENOTSUP;
+#endif
+}
+
+int ledStripUnregisterZone(size_t zoneId)
+{
+#ifdef CONFIG_ENYA_LED_STRIP_ZONES
+  return ledStripZoneUnregister(zoneId);
+#else
+  ARG_UNUSED(zoneId);
+  return -ENOTSUP;
+#endif
+}
+
+int ledStripUpdateZone(size_t zoneId, size_t offset, const struct led_rgb *pixels, size_t count)
+{
+#ifdef CONFIG_ENYA_LED_STRIP_ZONES
+  return ledStripZoneUpdate(zoneId, offset, pixels, count);
+#else
+  ARG_UNUSED(zoneId);
+  ARG_UNUSED(offset);
+  ARG_UNUSED(pixels);
+  ARG_UNUSED(count);
+  return -ENOTSUP;
+#endif
+}
+
+void ledStripSetFrameFreeCallback(LedStripFrameFreeCallback_t callback)
+{
+  ledStripUtilSetFrameFreeCallback(callback);
+}
+
+int ledStripGetStats(LedStripStats_t *frameStats)
+{
+#ifdef CONFIG_ENYA_LED_STRIP_STATS
+  int err;
+  k_spinlock_key_t key;
+
+  if(!frameStats)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid statistics", err);
+    return err;
+  }
+
+  key         = k_spin_lock(&statsLock);
+  *frameStats = stats;
+  k_spin_unlock(&statsLock, key);
+
+  frameStats->framePeriodUs = FRAME_PERIOD_US;
+
+  return 0;
+#else
+  ARG_UNUSED(frameStats);
+  return -ENOTSUP;
+#endif
+}
+
+int ledStripResetStats(void)
+{
+#ifdef CONFIG_ENYA_LED_STRIP_STATS
+  k_spinlock_key_t key = k_spin_lock(&statsLock);
+
+  memset(&stats, 0, sizeof(stats));
+
+  k_spin_unlock(&statsLock, key);
+
+  return 0;
+#else
+  return -ENOTSUP;
+#endif
+}
+
 /** @} */
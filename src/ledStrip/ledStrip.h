@@ -19,6 +19,37 @@
 #include <zephyr/kernel.h>
 #include <zephyr/drivers/led_strip.h>
 
+#include "ledStripEffect.h"
+#include "ledStripZone.h"
+
+/**
+ * @brief   The framebuffer release callback type.
+ *
+ * @note    Called from the service thread, or the posting thread in mailbox
+ *          mode, each time a framebuffer returns to the pool. It must not
+ *          block; giving a semaphore the producer waits on before getting its
+ *          next framebuffer is the intended use.
+ */
+typedef void (*LedStripFrameFreeCallback_t)(void);
+
+/**
+ * @brief   The frame statistics.
+ *
+ * @note    The counts cover the refresh periods since the service start or
+ *          the last reset, the transmit duration covering the push of all
+ *          the strips.
+ */
+typedef struct
+{
+  uint32_t frameCount;                  /**< The refresh periods run. */
+  uint32_t missedDeadlineCount;         /**< The refresh periods overrunning the next deadline. */
+  uint32_t framePeriodUs;               /**< The refresh period budget. */
+  uint32_t transmitLastUs;              /**< The push duration of the last refresh. */
+  uint32_t transmitMaxUs;               /**< The longest push duration. */
+  uint32_t drainLastCount;              /**< The messages drained at the last refresh. */
+  uint32_t drainMaxCount;               /**< The most messages drained at a refresh. */
+} LedStripStats_t;
+
 /**
  * @brief   Initalize the service.
  *
@@ -27,14 +58,49 @@
 int ledStripInit(void);
 
 /**
- * @brief   Get the next framebuffer.
+ * @brief   Get the strip count.
+ *
+ * @note    The devicetree "led-strip" alias is strip 0, the primary strip,
+ *          followed by the "led-strip-1" to "led-strip-7" aliases present.
+ *
+ * @return  The strip count.
+ */
+size_t ledStripGetStripCount(void);
+
+/**
+ * @brief   Get the pixel count of a strip.
+ *
+ * @param[in]   strip: The strip.
+ *
+ * @return  The strip chain length, 0 if strip is out of range.
+ */
+size_t ledStripGetPixelCount(size_t strip);
+
+/**
+ * @brief   Get the next framebuffer of the primary strip.
  *
  * @return  The next framebuffer if successful, NULL otherwise.
  */
 struct led_rgb *ledStripGetNextFramebuffer(void);
 
 /**
- * @brief   Update frame.
+ * @brief   Get the next framebuffer of a strip.
+ *
+ * @note    Each strip has its own framebuffer pool, the framebuffer must be
+ *          submitted to the same strip.
+ *
+ * @param[in]   strip: The strip.
+ *
+ * @return  The next framebuffer if successful, NULL otherwise.
+ */
+struct led_rgb *ledStripGetStripFramebuffer(size_t strip);
+
+/**
+ * @brief   Update the frame of the primary strip.
+ *
+ * @note    With CONFIG_ENYA_LED_STRIP_MAILBOX, the frame replaces the one still
+ *          pending, which is released to the pool right away, and only the
+ *          newest frame is shown at the next refresh.
  *
  * @param[in]   frame: The frame.
  *
@@ -43,7 +109,18 @@ struct led_rgb *ledStripGetNextFramebuffer(void);
 int ledStripUpdateFrame(struct led_rgb *frame);
 
 /**
- * @brief   Set the brightness.
+ * @brief   Update the frame of a strip.
+ *
+ * @param[in]   strip: The strip.
+ * @param[in]   frame: The frame, from the strip framebuffers.
+ *
+ * @return  0 if successful, -EINVAL if strip is out of range, the error code
+ *          otherwise.
+ */
+int ledStripUpdateStripFrame(size_t strip, struct led_rgb *frame);
+
+/**
+ * @brief   Set the brightness of the primary strip.
  *
  * @param[in]   brightness: The brighness.
  *
@@ -51,6 +128,106 @@ int ledStripUpdateFrame(struct led_rgb *frame);
  */
 int ledStripSetBrightness(uint8_t brightness);
 
+/**
+ * @brief   Set the brightness of a strip.
+ *
+ * @param[in]   strip: The strip.
+ * @param[in]   brightness: The brighness.
+ *
+ * @return  0 if successful, -EINVAL if strip is out of range, the error code
+ *          otherwise.
+ */
+int ledStripSetStripBrightness(size_t strip, uint8_t brightness);
+
+/**
+ * @brief   Start an effect.
+ *
+ * @note    The effect replaces the one of the slot and is rendered by the
+ *          service thread at each refresh, over the frames submitted to
+ *          the primary strip.
+ *
+ * @param[in]   slot: The effect slot.
+ * @param[in]   effect: The effect configuration.
+ *
+ * @return  0 if successful, -ENOTSUP without CONFIG_ENYA_LED_STRIP_EFFECTS,
+ *          -EINVAL if the effect is invalid, the error code otherwise.
+ */
+int ledStripStartEffect(size_t slot, const LedStripEffect_t *effect);
+
+/**
+ * @brief   Stop an effect.
+ *
+ * @param[in]   slot: The effect slot.
+ *
+ * @return  0 if successful, -ENOTSUP without CONFIG_ENYA_LED_STRIP_EFFECTS,
+ *          the error code otherwise.
+ */
+int ledStripStopEffect(size_t slot);
+
+/**
+ * @brief   Register a zone.
+ *
+ * @note    The zone pixels are shown over the frames submitted to the
+ *          primary strip, from the next push until the zone is unregistered.
+ *
+ * @param[in]   firstPixel: The first pixel of the zone.
+ * @param[in]   pixelCount: The zone pixel count.
+ * @param[out]  zoneId: The zone ID.
+ *
+ * @return  0 if successful, -ENOTSUP without CONFIG_ENYA_LED_STRIP_ZONES,
+ *          the error code otherwise.
+ */
+int ledStripRegisterZone(uint16_t firstPixel, uint16_t pixelCount, size_t *zoneId);
+
+/**
+ * @brief   Unregister a zone.
+ *
+ * @param[in]   zoneId: The zone ID.
+ *
+ * @return  0 if successful, -ENOTSUP without CONFIG_ENYA_LED_STRIP_ZONES,
+ *          the error code otherwise.
+ */
+int ledStripUnregisterZone(size_t zoneId);
+
+/**
+ * @brief   Update the pixels of a zone.
+ *
+ * @note    The pixels are copied into the zone, shown at the next push.
+ *
+ * @param[in]   zoneId: The zone ID.
+ * @param[in]   offset: The first pixel to update, from the zone start.
+ * @param[in]   pixels: The pixels.
+ * @param[in]   count: The pixel count.
+ *
+ * @return  0 if successful, -ENOTSUP without CONFIG_ENYA_LED_STRIP_ZONES,
+ *          the error code otherwise.
+ */
+int ledStripUpdateZone(size_t zoneId, size_t offset, const struct led_rgb *pixels, size_t count);
+
+/**
+ * @brief   Set the framebuffer release callback.
+ *
+ * @param[in]   callback: The callback, NULL to clear it.
+ */
+void ledStripSetFrameFreeCallback(LedStripFrameFreeCallback_t callback);
+
+/**
+ * @brief   Get the frame statistics.
+ *
+ * @param[out]  frameStats: The frame statistics.
+ *
+ * @return  0 if successful, -ENOTSUP without CONFIG_ENYA_LED_STRIP_STATS,
+ *          -EINVAL if frameStats is NULL.
+ */
+int ledStripGetStats(LedStripStats_t *frameStats);
+
+/**
+ * @brief   Reset the frame statistics.
+ *
+ * @return  0 if successful, -ENOTSUP without CONFIG_ENYA_LED_STRIP_STATS.
+ */
+int ledStripResetStats(void);
+
 #endif /* LEDSTRIP_H */
 
 /** @} */
@@ -92,11 +92,218 @@ static int execSetBrightness(const struct shell *sh, size_t argc, char **argv)
   return 0;
 }
 
+#ifdef CONFIG_ENYA_LED_STRIP_STATS
+static int execStats(const struct shell *sh, size_t argc, char **argv)
+{
+  int err;
+  LedStripStats_t stats;
+
+  if(argc >= 2)
+  {
+    if(strcmp(argv[1], "reset") != 0)
+    {
+      shell_error(sh, "FAIL %d: unknown option '%s'", -EINVAL, argv[1]);
+      return -EINVAL;
+    }
+
+    err = ledStripResetStats();
+    if(err < 0)
+    {
+      shell_error(sh, "FAIL %d: unable to reset the statistics", err);
+      return err;
+    }
+
+    shell_info(sh, "SUCCESS: statistics reset");
+    return 0;
+  }
+
+  err = ledStripGetStats(&stats);
+  if(err < 0)
+  {
+    shell_error(sh, "FAIL %d: unable to get the statistics", err);
+    return err;
+  }
+
+  shell_print(sh, "Frames: %u, missed deadlines: %u", stats.frameCount, stats.missedDeadlineCount);
+  shell_print(sh, "Transmit time: last %u us, max %u us, budget %u us", stats.transmitLastUs,
+              stats.transmitMaxUs, stats.framePeriodUs);
+  shell_print(sh, "Drained messages: last %u, max %u", stats.drainLastCount, stats.drainMaxCount);
+
+  return 0;
+}
+#endif
+
+#ifdef CONFIG_ENYA_LED_STRIP_EFFECTS
+/**
+ * @brief   The shell effect slot, covering the whole chain.
+ */
+#define SHELL_EFFECT_SLOT 0
+
+/**
+ * @brief   Parse a color from 3 channel arguments.
+ *
+ * @param[in]   sh: The shell.
+ * @param[in]   argv: The channel arguments.
+ * @param[in]   argIdx: The index of the first channel argument.
+ * @param[out]  color: The color.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int parseColor(const struct shell *sh, char **argv, size_t argIdx, struct led_rgb *color)
+{
+  int convErr = 0;
+
+  color->r = (uint8_t)shell_strtoul(argv[argIdx], 0, &convErr);
+  if(!convErr)
+    color->g = (uint8_t)shell_strtoul(argv[argIdx + 1], 0, &convErr);
+  if(!convErr)
+    color->b = (uint8_t)shell_strtoul(argv[argIdx + 2], 0, &convErr);
+
+  if(convErr)
+    shell_error(sh, "FAIL: invalid color value");
+
+  return convErr;
+}
+
+/**
+ * @brief   Parse a period or length argument.
+ *
+ * @param[in]   sh: The shell.
+ * @param[in]   arg: The argument.
+ * @param[out]  count: The period or length.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int parseCount(const struct shell *sh, char *arg, uint16_t *count)
+{
+  int convErr = 0;
+
+  *count = (uint16_t)shell_strtoul(arg, 0, &convErr);
+  if(convErr)
+    shell_error(sh, "FAIL: invalid period or length value");
+
+  return convErr;
+}
+
+/**
+ * @brief   Start the shell effect.
+ *
+ * @param[in]   sh: The shell.
+ * @param[in]   effect: The effect configuration.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int startEffect(const struct shell *sh, LedStripEffect_t *effect)
+{
+  int err;
+
+  effect->alpha = UINT8_MAX;
+
+  err = ledStripStartEffect(SHELL_EFFECT_SLOT, effect);
+  if(err < 0)
+  {
+    shell_error(sh, "FAIL %d: unable to start effect", err);
+    return err;
+  }
+
+  shell_info(sh, "SUCCESS: effect started");
+
+  return 0;
+}
+
+static int execEffectFill(const struct shell *sh, size_t argc, char **argv)
+{
+  int err;
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_FILL};
+
+  err = parseColor(sh, argv, 1, &effect.colors[0]);
+  if(err)
+    return err;
+
+  return startEffect(sh, &effect);
+}
+
+static int execEffectGradient(const struct shell *sh, size_t argc, char **argv)
+{
+  int err;
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_GRADIENT};
+
+  err = parseColor(sh, argv, 1, &effect.colors[0]);
+  if(!err)
+    err = parseColor(sh, argv, 4, &effect.colors[1]);
+  if(!err && argc > 7)
+    err = parseCount(sh, argv[7], &effect.period);
+  if(err)
+    return err;
+
+  return startEffect(sh, &effect);
+}
+
+static int execEffectChase(const struct shell *sh, size_t argc, char **argv)
+{
+  int err;
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_CHASE};
+
+  err = parseColor(sh, argv, 1, &effect.colors[0]);
+  if(!err)
+    err = parseCount(sh, argv[4], &effect.length);
+  if(!err)
+    err = parseCount(sh, argv[5], &effect.period);
+  if(err)
+    return err;
+
+  return startEffect(sh, &effect);
+}
+
+static int execEffectFade(const struct shell *sh, size_t argc, char **argv)
+{
+  int err;
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_FADE};
+
+  err = parseColor(sh, argv, 1, &effect.colors[0]);
+  if(!err)
+    err = parseCount(sh, argv[4], &effect.period);
+  if(err)
+    return err;
+
+  return startEffect(sh, &effect);
+}
+
+static int execEffectStop(const struct shell *sh, size_t argc, char **argv)
+{
+  int err;
+
+  err = ledStripStopEffect(SHELL_EFFECT_SLOT);
+  if(err < 0)
+  {
+    shell_error(sh, "FAIL %d: unable to stop effect", err);
+    return err;
+  }
+
+  shell_info(sh, "SUCCESS: effect stopped");
+
+  return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(ledStripEffect_sub,
+                               SHELL_CMD_ARG(fill, NULL, "Fill: <r> <g> <b>", execEffectFill, 4, 0),
+                               SHELL_CMD_ARG(grad, NULL, "Gradient: <r> <g> <b> <r> <g> <b> [period]",
+                                             execEffectGradient, 7, 1),
+                               SHELL_CMD_ARG(chase, NULL, "Chase: <r> <g> <b> <length> <period>", execEffectChase, 6, 0),
+                               SHELL_CMD_ARG(fade, NULL, "Fade: <r> <g> <b> <period>", execEffectFade, 5, 0),
+                               SHELL_CMD(stop, NULL, "Stop the effect", execEffectStop), SHELL_SUBCMD_SET_END);
+#endif
+
 SHELL_STATIC_SUBCMD_SET_CREATE(ledStrip_sub, SHELL_CMD(pc, NULL, "Get the pixel count", execGetPixelCount),
                                SHELL_CMD_ARG(sf, NULL, "Set next frame", execSetFrame,
                                              1 + DT_PROP(DT_ALIAS(led_strip), chain_length) * sizeof(struct led_rgb),
                                              0),
-                               SHELL_CMD_ARG(br, NULL, "Write datapoint value(s)", execSetBrightness, 2, 0), SHELL_SUBCMD_SET_END);
+                               SHELL_CMD_ARG(br, NULL, "Write datapoint value(s)", execSetBrightness, 2, 0),
+                               SHELL_COND_CMD(CONFIG_ENYA_LED_STRIP_EFFECTS, fx, &ledStripEffect_sub,
+                                              "Effect commands", NULL),
+                               SHELL_COND_CMD_ARG(CONFIG_ENYA_LED_STRIP_STATS, stats, NULL,
+                                                  "Get the frame statistics: [reset]", execStats, 1, 1),
+                               SHELL_SUBCMD_SET_END);
 
 SHELL_CMD_REGISTER(led, &ledStrip_sub, "LED strip commands.", NULL);
 /** @} */
@@ -0,0 +1,263 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      ledStripEffect.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     LED Strip Effect Engine
+ *
+ *            LED strip effect engine implementation. The effects are only
+ *            accessed from the service thread, using integer math only.
+ *
+ * @ingroup   ledStrip
+ *
+ * @{
+ */
+
+#include <zephyr/logging/log.h>
+
+#include "ledStripEffect.h"
+#include "ledStripUtil.h"
+
+LOG_MODULE_DECLARE(LED_STRIP_LOGGER_NAME, CONFIG_ENYA_LED_STRIP_LOG_LEVEL);
+
+/**
+ * @brief   The full blending or fade level.
+ */
+#define LEVEL_MAX 255
+
+/**
+ * @brief   The effect slot.
+ */
+typedef struct
+{
+  LedStripEffect_t config;              /**< The effect configuration, segment resolved. */
+  uint32_t frameCount;                  /**< The refresh periods since the start. */
+  bool isStarted;                       /**< The effect started since the last advance flag. */
+  bool isRunning;                       /**< The slot running flag. */
+} LedStripEffectSlot_t;
+
+static const uint32_t chainLength = DT_PROP(DT_ALIAS(led_strip), chain_length);
+
+/**
+ * @brief   The effect slots.
+ */
+static LedStripEffectSlot_t slots[CONFIG_ENYA_LED_STRIP_EFFECT_SLOT_COUNT];
+
+/**
+ * @brief   The output changed flag, set on an effect stop.
+ */
+static bool isChanged = false;
+
+/**
+ * @brief   Interpolate between two channel levels.
+ *
+ * @param[in]   from: The level at 0.
+ * @param[in]   to: The level at LEVEL_MAX.
+ * @param[in]   level: The interpolation level, from 0 to LEVEL_MAX.
+ *
+ * @return  The interpolated level.
+ */
+static inline uint8_t lerpChannel(uint8_t from, uint8_t to, uint32_t level)
+{
+  return (uint8_t)(from + ((int32_t)to - from) * (int32_t)level / LEVEL_MAX);
+}
+
+/**
+ * @brief   Interpolate between two colors.
+ *
+ * @param[in]   from: The color at 0.
+ * @param[in]   to: The color at LEVEL_MAX.
+ * @param[in]   level: The interpolation level, from 0 to LEVEL_MAX.
+ *
+ * @return  The interpolated color.
+ */
+static inline struct led_rgb lerpColor(struct led_rgb from, struct led_rgb to, uint32_t level)
+{
+  struct led_rgb color = from;
+
+  color.r = lerpChannel(from.r, to.r, level);
+  color.g = lerpChannel(from.g, to.g, level);
+  color.b = lerpChannel(from.b, to.b, level);
+
+  return color;
+}
+
+/**
+ * @brief   Get the effect color of a segment pixel.
+ *
+ * @param[in]   slot: The effect slot.
+ * @param[in]   index: The pixel index in the segment.
+ * @param[in]   pixel: The pixel color under the effect.
+ *
+ * @return  The effect color.
+ */
+static struct led_rgb getEffectColor(const LedStripEffectSlot_t *slot, uint32_t index, struct led_rgb pixel)
+{
+  const LedStripEffect_t *config = &slot->config;
+  uint32_t count                 = config->pixelCount;
+  uint32_t position;
+  uint32_t level;
+
+  switch(config->type)
+  {
+    case LED_STRIP_EFFECT_GRADIENT:
+      if(count < 2)
+        return config->colors[0];
+
+      /* Back and forth over twice the segment, for a seamless shift */
+      position = index + (config->period ? slot->frameCount / config->period : 0);
+      position %= 2 * count;
+      if(position >= count)
+        position = 2 * count - 1 - position;
+      return lerpColor(config->colors[0], config->colors[1], position * LEVEL_MAX / (count - 1));
+    case LED_STRIP_EFFECT_CHASE:
+      position = (index + count - (slot->frameCount / config->period) % count) % count;
+      return position < config->length ? config->colors[0] : config->colors[1];
+    case LED_STRIP_EFFECT_FADE:
+      level = MIN(slot->frameCount, config->period) * LEVEL_MAX / config->period;
+      return lerpColor(pixel, config->colors[0], level);
+    case LED_STRIP_EFFECT_FILL:
+    default:
+      return config->colors[0];
+  }
+}
+
+/**
+ * @brief   Check if an effect steps at its current refresh period.
+ *
+ * @param[in]   slot: The effect slot.
+ *
+ * @return  True if the effect output changes, false otherwise.
+ */
+static bool isEffectStep(const LedStripEffectSlot_t *slot)
+{
+  const LedStripEffect_t *config = &slot->config;
+
+  switch(config->type)
+  {
+    case LED_STRIP_EFFECT_GRADIENT:
+    case LED_STRIP_EFFECT_CHASE:
+      return config->period && slot->frameCount % config->period == 0;
+    case LED_STRIP_EFFECT_FADE:
+      return slot->frameCount <= config->period;
+    case LED_STRIP_EFFECT_FILL:
+    default:
+      return false;
+  }
+}
+
+int ledStripEffectValidate(size_t slot, const LedStripEffect_t *effect)
+{
+  int err;
+  uint32_t pixelCount;
+
+  if(slot >= CONFIG_ENYA_LED_STRIP_EFFECT_SLOT_COUNT)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid effect slot %d", err, slot);
+    return err;
+  }
+
+  if(!effect || effect->type >= LED_STRIP_EFFECT_TYPE_COUNT || effect->firstPixel >= chainLength)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid effect", err);
+    return err;
+  }
+
+  pixelCount = effect->pixelCount ? effect->pixelCount : chainLength - effect->firstPixel;
+  if(effect->firstPixel + pixelCount > chainLength)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid effect segment", err);
+    return err;
+  }
+
+  if((effect->type == LED_STRIP_EFFECT_CHASE &&
+      (effect->period == 0 || effect->length == 0 || effect->length > pixelCount)) ||
+     (effect->type == LED_STRIP_EFFECT_FADE && effect->period == 0))
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid effect length or period", err);
+    return err;
+  }
+
+  return 0;
+}
+
+void ledStripEffectStart(size_t slot, const LedStripEffect_t *effect)
+{
+  LedStripEffectSlot_t *effectSlot = slots + slot;
+
+  effectSlot->config     = *effect;
+  effectSlot->frameCount = 0;
+  effectSlot->isStarted  = true;
+  effectSlot->isRunning  = true;
+
+  if(effectSlot->config.pixelCount == 0)
+    effectSlot->config.pixelCount = chainLength - effect->firstPixel;
+}
+
+void ledStripEffectStop(size_t slot)
+{
+  if(slot >= CONFIG_ENYA_LED_STRIP_EFFECT_SLOT_COUNT || !slots[slot].isRunning)
+    return;
+
+  slots[slot].isRunning = false;
+  isChanged             = true;
+}
+
+bool ledStripEffectAdvance(void)
+{
+  bool changed = isChanged;
+
+  isChanged = false;
+
+  for(size_t i = 0; i < CONFIG_ENYA_LED_STRIP_EFFECT_SLOT_COUNT; ++i)
+  {
+    LedStripEffectSlot_t *slot = slots + i;
+
+    if(!slot->isRunning)
+      continue;
+
+    /* A started effect is first rendered at its frame count 0 */
+    if(slot->isStarted)
+    {
+      slot->isStarted = false;
+      changed         = true;
+      continue;
+    }
+
+    /* A finished fade stops counting, holding its target color */
+    if(slot->config.type != LED_STRIP_EFFECT_FADE || slot->frameCount <= slot->config.period)
+      ++slot->frameCount;
+
+    if(isEffectStep(slot))
+      changed = true;
+  }
+
+  return changed;
+}
+
+void ledStripEffectRender(struct led_rgb *frame, size_t count)
+{
+  for(size_t i = 0; i < CONFIG_ENYA_LED_STRIP_EFFECT_SLOT_COUNT; ++i)
+  {
+    const LedStripEffectSlot_t *slot = slots + i;
+    uint32_t lastPixel;
+
+    if(!slot->isRunning || slot->config.firstPixel >= count)
+      continue;
+
+    lastPixel = MIN(slot->config.firstPixel + slot->config.pixelCount, count);
+    for(uint32_t p = slot->config.firstPixel; p < lastPixel; ++p)
+    {
+      struct led_rgb color = getEffectColor(slot, p - slot->config.firstPixel, frame[p]);
+
+      frame[p] = lerpColor(frame[p], color, slot->config.alpha);
+    }
+  }
+}
+
+/** @} */
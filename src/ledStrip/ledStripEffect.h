@@ -0,0 +1,102 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      ledStripEffect.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     LED Strip Effect Engine
+ *
+ *            LED strip effect engine API. The effects are parameterised once
+ *            and rendered by the service thread at each refresh over the
+ *            active frame, on a segment of the chain, without any frame
+ *            traffic from the producer.
+ *
+ * @ingroup   ledStrip
+ *
+ * @{
+ */
+
+#ifndef LEDSTRIPEFFECT_H
+#define LEDSTRIPEFFECT_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/led_strip.h>
+
+/**
+ * @brief   The effect types.
+ */
+typedef enum
+{
+  LED_STRIP_EFFECT_FILL = 0,            /**< Solid colors[0]. */
+  LED_STRIP_EFFECT_GRADIENT,            /**< colors[0] to colors[1], shifted one pixel every period. */
+  LED_STRIP_EFFECT_CHASE,               /**< length pixels of colors[0] on colors[1], one step every period. */
+  LED_STRIP_EFFECT_FADE,                /**< Crossfade from the active frame to colors[0] over period. */
+  LED_STRIP_EFFECT_TYPE_COUNT,
+} LedStripEffectType_t;
+
+/**
+ * @brief   The effect configuration.
+ *
+ * @note    The periods are in refresh periods. The effect output is blended
+ *          over the segment pixels by alpha, 255 replacing them. The slots are
+ *          rendered in order, a slot blending over the lower ones.
+ */
+typedef struct
+{
+  LedStripEffectType_t type;            /**< The effect type. */
+  uint16_t firstPixel;                  /**< The first pixel of the segment. */
+  uint16_t pixelCount;                  /**< The segment pixel count, 0 up to the chain end. */
+  uint8_t alpha;                        /**< The blending over the segment pixels. */
+  struct led_rgb colors[2];             /**< The effect colors. */
+  uint16_t length;                      /**< The chase lit pixel count. */
+  uint16_t period;                      /**< The step or fade period, 0 for a still gradient. */
+} LedStripEffect_t;
+
+/**
+ * @brief   Validate an effect.
+ *
+ * @param[in]   slot: The effect slot.
+ * @param[in]   effect: The effect configuration.
+ *
+ * @return  0 if valid, -EINVAL if effect is NULL, its type or segment is
+ *          invalid, its chase length or period is 0 or slot is out of range.
+ */
+int ledStripEffectValidate(size_t slot, const LedStripEffect_t *effect);
+
+/**
+ * @brief   Start an effect.
+ *
+ * @note    The effect must be validated, it replaces the effect of the slot.
+ *
+ * @param[in]   slot: The effect slot.
+ * @param[in]   effect: The effect configuration.
+ */
+void ledStripEffectStart(size_t slot, const LedStripEffect_t *effect);
+
+/**
+ * @brief   Stop an effect.
+ *
+ * @note    The segment shows the active frame again at the next refresh.
+ *
+ * @param[in]   slot: The effect slot, out of range slots being ignored.
+ */
+void ledStripEffectStop(size_t slot);
+
+/**
+ * @brief   Advance the effects of one refresh period.
+ *
+ * @return  True if the effect output changed, false otherwise.
+ */
+bool ledStripEffectAdvance(void);
+
+/**
+ * @brief   Render the effects over a frame.
+ *
+ * @param[in,out]   frame: The frame, holding the active frame pixels.
+ * @param[in]       count: The pixel count to render.
+ */
+void ledStripEffectRender(struct led_rgb *frame, size_t count);
+
+#endif /* LEDSTRIPEFFECT_H */
+
+/** @} */
@@ -16,110 +16,427 @@
 #include <zephyr/drivers/led_strip.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/portability/cmsis_os2.h>
+#include <zephyr/sys/atomic.h>
 
 #include "ledStripUtil.h"
+#include "ledStripEffect.h"
+#include "ledStripZone.h"
+#include "srvTrace.h"
 
 LOG_MODULE_DECLARE(LED_STRIP_LOGGER_NAME, CONFIG_ENYA_LED_STRIP_LOG_LEVEL);
 
-#define FRAMEBUFFER_COUNT 2
-
 #define FRAMEBUFFER_ALLOC_TIMEOUT 5
 
-static const struct device *ledStrip = DEVICE_DT_GET(DT_ALIAS(led_strip));
-static const uint32_t pixelCount = DT_PROP(DT_ALIAS(led_strip), chain_length);
+/**
+ * @brief   The refresh period count between keep-alive pushes, 0 to disable.
+ */
+#define KEEP_ALIVE_FRAME_COUNT \
+  DIV_ROUND_UP(CONFIG_ENYA_LED_STRIP_KEEP_ALIVE_MS * CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ, 1000)
 
-static osMemoryPoolId_t framebufferPool = NULL;
-static struct led_rgb *activeFrame;
-static uint8_t brightness = 255;
+/**
+ * @brief   The channel level count.
+ */
+#define LEVEL_COUNT 256
+
+/**
+ * @brief   The strip aliases, the "led-strip" alias being the primary strip.
+ */
+#define STRIP_ALIAS_LIST(fn) \
+  fn(led_strip) fn(led_strip_1) fn(led_strip_2) fn(led_strip_3) \
+  fn(led_strip_4) fn(led_strip_5) fn(led_strip_6) fn(led_strip_7)
+
+/**
+ * @brief   The primary strip, the zones and effects being composed over it.
+ */
+#define PRIMARY_STRIP 0
+
+/**
+ * @brief   Define the output frame of a strip alias, if present.
+ */
+#define OUTPUT_FRAME_DEFINE(alias)                                                                        \
+  COND_CODE_1(DT_HAS_ALIAS(alias),                                                                        \
+              (static struct led_rgb alias##OutputFrame[DT_PROP(DT_ALIAS(alias), chain_length)];), ())
+
+/**
+ * @brief   Initialize the instance of a strip alias, if present.
+ */
+#define STRIP_INSTANCE(alias)                                                                             \
+  COND_CODE_1(DT_HAS_ALIAS(alias),                                                                        \
+              ({.device      = DEVICE_DT_GET(DT_ALIAS(alias)),                                            \
+                .pixelCount  = DT_PROP(DT_ALIAS(alias), chain_length),                                    \
+                .outputFrame = alias##OutputFrame,                                                        \
+                .brightness  = 255},),                                                                    \
+              ())
+
+BUILD_ASSERT(DT_HAS_ALIAS(led_strip), "The led-strip alias is required, being the primary strip");
+
+/**
+ * @brief   The strip instance.
+ */
+typedef struct
+{
+  const struct device *device;          /**< The strip device. */
+  uint32_t pixelCount;                  /**< The strip chain length. */
+  struct led_rgb *outputFrame;          /**< The output frame, the active frame through the level table. */
+  osMemoryPoolId_t framebufferPool;     /**< The framebuffer pool. */
+  struct led_rgb *activeFrame;          /**< The active frame. */
+  atomic_ptr_t pendingFrame;            /**< The mailbox frame, the newest posted since the last refresh. */
+  uint8_t brightness;                   /**< The strip brightness. */
+  uint8_t levelLut[LEVEL_COUNT];        /**< The channel level table, gamma and brightness combined. */
+  size_t dirtyCount;                    /**< The pixel count to push, 0 when up to date. */
+  uint32_t idleFrameCount;              /**< The refresh periods since the last push. */
+} LedStripInstance_t;
+
+/**
+ * @brief   The output frames, handed to the drivers.
+ */
+STRIP_ALIAS_LIST(OUTPUT_FRAME_DEFINE)
+
+/**
+ * @brief   The strip instances, driven from the service thread.
+ */
+static LedStripInstance_t strips[] = {STRIP_ALIAS_LIST(STRIP_INSTANCE)};
+
+/**
+ * @brief   The strip count.
+ */
+#define STRIP_COUNT ARRAY_SIZE(strips)
+
+/**
+ * @brief   The framebuffer release callback.
+ */
+static LedStripFrameFreeCallback_t frameFreeCallback = NULL;
+
+#ifdef CONFIG_ENYA_LED_STRIP_GAMMA
+/**
+ * @brief   The gamma 2.2 correction table.
+ */
+static const uint8_t gammaLut[LEVEL_COUNT] = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+    1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+    3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+    6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+   12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+   20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+   30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+   42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+   56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+   73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+   91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+  113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+  137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+  163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+  192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+  223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+#endif
+
+/**
+ * @brief   Get the pixel count to push for a new frame.
+ *
+ * @note    The chain latches the pixels it receives only, the pixels past the
+ *          last changed one keep their color. The frames are compared before
+ *          the level table, the output frame only being handed to the driver.
+ *          Only the full chain is pushed without CONFIG_ENYA_LED_STRIP_DIRTY_SPAN.
+ *
+ * @param[in]   strip: The strip instance.
+ * @param[in]   prevFrame: The previously active frame, NULL if none.
+ * @param[in]   frame: The new frame.
+ *
+ * @return  The pixel count up to the last pixel changed.
+ */
+static size_t getDirtySpan(const LedStripInstance_t *strip, const struct led_rgb *prevFrame,
+                           const struct led_rgb *frame)
+{
+#ifdef CONFIG_ENYA_LED_STRIP_DIRTY_SPAN
+  size_t span = strip->pixelCount;
+
+  if(!prevFrame)
+    return strip->pixelCount;
+
+  while(span > 0 && memcmp(prevFrame + span - 1, frame + span - 1, sizeof(struct led_rgb)) == 0)
+    --span;
+
+  return span;
+#else
+  ARG_UNUSED(prevFrame);
+  ARG_UNUSED(frame);
+
+  return strip->pixelCount;
+#endif
+}
+
+/**
+ * @brief   Build the level table of the strip brightness.
+ *
+ * @param[in,out]   strip: The strip instance.
+ */
+static void buildLevelLut(LedStripInstance_t *strip)
+{
+  for(size_t i = 0; i < LEVEL_COUNT; ++i)
+  {
+#ifdef CONFIG_ENYA_LED_STRIP_GAMMA
+    strip->levelLut[i] = gammaLut[i] * strip->brightness / 255;
+#else
+    strip->levelLut[i] = i * strip->brightness / 255;
+#endif
+  }
+}
 
 /**
  * @brief   Apply global brightness.
  *
+ * @note    The frame is left untouched, its pixels being written through the
+ *          level table into the output.
+ *
+ * @param[in]   strip: The strip instance.
  * @param[in]   frame: The frame.
+ * @param[out]  output: The output pixels.
+ * @param[in]   count: The pixel count to apply.
  */
-void applyGlobalBrightness(struct led_rgb *frame)
+void applyGlobalBrightness(const LedStripInstance_t *strip, const struct led_rgb *frame,
+                           struct led_rgb *output, size_t count)
 {
-  if(!frame)
+  if(!frame || !output)
     return;
 
-  for(size_t i = 0; i < pixelCount; ++i)
+  for(size_t i = 0; i < count; ++i)
   {
-    frame[i].r = frame[i].r * brightness / 255;
-    frame[i].g = frame[i].g * brightness / 255;
-    frame[i].b = frame[i].b * brightness / 255;
+    output[i].r = strip->levelLut[frame[i].r];
+    output[i].g = strip->levelLut[frame[i].g];
+    output[i].b = strip->levelLut[frame[i].b];
   }
 }
 
-int ledStripUtilInitStrip(void)
+/**
+ * @brief   Release a framebuffer to the pool of its strip.
+ *
+ * @param[in]   strip: The strip instance.
+ * @param[in]   frame: The framebuffer.
+ */
+static void releaseFrame(LedStripInstance_t *strip, struct led_rgb *frame)
+{
+  osMemoryPoolFree(strip->framebufferPool, frame);
+
+  if(frameFreeCallback)
+    frameFreeCallback();
+}
+
+/**
+ * @brief   Push the active frame of a strip.
+ *
+ * @param[in,out]   strip: The strip instance.
+ * @param[in]       isPrimary: The primary strip flag, composing the zones and effects.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int pushStrip(LedStripInstance_t *strip, bool isPrimary)
 {
   int err;
+  const struct led_rgb *frame = strip->activeFrame;
+
+  if(!strip->activeFrame)
+    return 0;
+
+#ifdef CONFIG_ENYA_LED_STRIP_ZONES
+  if(isPrimary)
+    strip->dirtyCount = MAX(strip->dirtyCount, ledStripZoneTakeSpan());
+#endif
+
+#ifdef CONFIG_ENYA_LED_STRIP_EFFECTS
+  if(isPrimary && ledStripEffectAdvance())
+    strip->dirtyCount = strip->pixelCount;
+#endif
 
-  if(!device_is_ready(ledStrip))
+  if(strip->dirtyCount == 0)
   {
-    err = -EBUSY;
-    LOG_ERR("ERROR %d: LED strip device %s not ready", err, ledStrip->name);
+    ++strip->idleFrameCount;
+    if(KEEP_ALIVE_FRAME_COUNT == 0 || strip->idleFrameCount < KEEP_ALIVE_FRAME_COUNT)
+      return 0;
+
+    strip->dirtyCount = strip->pixelCount;
+  }
+
+#if defined(CONFIG_ENYA_LED_STRIP_ZONES) || defined(CONFIG_ENYA_LED_STRIP_EFFECTS)
+  /* The zones then effects are composed over a copy of the active frame, left untouched */
+  if(isPrimary)
+  {
+    memcpy(strip->outputFrame, strip->activeFrame, strip->dirtyCount * sizeof(struct led_rgb));
+    frame = strip->outputFrame;
+
+#ifdef CONFIG_ENYA_LED_STRIP_ZONES
+    ledStripZoneCompose(strip->outputFrame, strip->dirtyCount);
+#endif
+
+#ifdef CONFIG_ENYA_LED_STRIP_EFFECTS
+    ledStripEffectRender(strip->outputFrame, strip->dirtyCount);
+#endif
+  }
+#else
+  ARG_UNUSED(isPrimary);
+#endif
+
+  /* The driver may overwrite its pixels, they are rebuilt before each push */
+  applyGlobalBrightness(strip, frame, strip->outputFrame, strip->dirtyCount);
+
+  SRV_TRACE_BEGIN(LED_STRIP_UPDATE, strip->dirtyCount);
+  err = led_strip_update_rgb(strip->device, strip->outputFrame, strip->dirtyCount);
+  SRV_TRACE_END(LED_STRIP_UPDATE, strip->dirtyCount);
+  if(err < 0)
+  {
+    /* Kept dirty, the push is retried at the next refresh */
+    LOG_ERR("ERROR %d: unable to update LED string %s channels", err, strip->device->name);
     return err;
   }
 
+  strip->dirtyCount     = 0;
+  strip->idleFrameCount = 0;
+
+  return 0;
+}
+
+int ledStripUtilInitStrip(void)
+{
+  int err;
+
+  for(size_t i = 0; i < STRIP_COUNT; ++i)
+  {
+    if(!device_is_ready(strips[i].device))
+    {
+      err = -EBUSY;
+      LOG_ERR("ERROR %d: LED strip device %s not ready", err, strips[i].device->name);
+      return err;
+    }
+  }
+
   return 0;
 }
 
 int ledStripUtilInitFramebuffers(void)
 {
   int err;
+  LedStripInstance_t *strip;
 
-  framebufferPool = osMemoryPoolNew(2, pixelCount * sizeof(struct led_rgb), NULL);
-  if(!framebufferPool)
+  for(size_t i = 0; i < STRIP_COUNT; ++i)
   {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: uanble to allocate framebuffer pool", err);
-    return err;
+    strip = strips + i;
+
+    strip->framebufferPool = osMemoryPoolNew(CONFIG_ENYA_LED_STRIP_FRAMEBUFFER_COUNT,
+                                             strip->pixelCount * sizeof(struct led_rgb), NULL);
+    if(!strip->framebufferPool)
+    {
+      err = -ENOSPC;
+      LOG_ERR("ERROR %d: uanble to allocate framebuffer pool of strip %d", err, i);
+      return err;
+    }
+
+    strip->activeFrame = osMemoryPoolAlloc(strip->framebufferPool, FRAMEBUFFER_ALLOC_TIMEOUT);
+    if(!strip->activeFrame)
+    {
+      err = -ENOSPC;
+      LOG_ERR("ERROR %d: unable to get the first framebuffer of strip %d", err, i);
+      return err;
+    }
+
+    memset(strip->activeFrame, 0, strip->pixelCount * sizeof(struct led_rgb));
+    buildLevelLut(strip);
+    strip->dirtyCount     = strip->pixelCount;
+    strip->idleFrameCount = 0;
   }
 
-  activeFrame = osMemoryPoolAlloc(framebufferPool, FRAMEBUFFER_ALLOC_TIMEOUT);
-  if(!activeFrame)
+  return 0;
+}
+
+size_t ledStripUtilGetStripCount(void)
+{
+  return STRIP_COUNT;
+}
+
+size_t ledStripUtilGetPixelCount(size_t strip)
+{
+  return strip < STRIP_COUNT ? strips[strip].pixelCount : 0;
+}
+
+struct led_rgb *ledStripUtilGetNextFramebuffer(size_t strip)
+{
+  if(strip >= STRIP_COUNT)
+    return NULL;
+
+  return osMemoryPoolAlloc(strips[strip].framebufferPool, FRAMEBUFFER_ALLOC_TIMEOUT);
+}
+
+void ledStripUtilActivateFrame(size_t strip, struct led_rgb *frame)
+{
+  size_t span;
+  LedStripInstance_t *instance = strips + strip;
+
+  SRV_TRACE_BEGIN(LED_STRIP_ACTIVATE, strip);
+
+  /* Frames activated within the same refresh period add up their spans */
+  span = frame ? getDirtySpan(instance, instance->activeFrame, frame) : 0;
+  if(span > instance->dirtyCount)
+    instance->dirtyCount = span;
+
+  if(instance->activeFrame)
+    releaseFrame(instance, instance->activeFrame);
+  instance->activeFrame = frame;
+
+  SRV_TRACE_END(LED_STRIP_ACTIVATE, strip);
+}
+
+int ledStripUtilPostFrame(size_t strip, struct led_rgb *frame)
+{
+  int err;
+  struct led_rgb *staleFrame;
+
+  if(strip >= STRIP_COUNT || !frame)
   {
-    err = -ENOSPC;
-    LOG_ERR("ERROR %d: unable to get the first framebuffer", err);
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid frame", err);
     return err;
   }
 
-  memset(activeFrame, 0, pixelCount * sizeof(struct led_rgb));
+  /* The newest frame wins, the one it replaces was never shown */
+  staleFrame = atomic_ptr_set(&strips[strip].pendingFrame, frame);
+  if(staleFrame)
+    releaseFrame(strips + strip, staleFrame);
 
   return 0;
 }
 
-struct led_rgb *ledStripUtilGetNextFramebuffer(void)
+struct led_rgb *ledStripUtilTakeFrame(size_t strip)
 {
-  return osMemoryPoolAlloc(framebufferPool, FRAMEBUFFER_ALLOC_TIMEOUT);
+  return atomic_ptr_set(&strips[strip].pendingFrame, NULL);
 }
 
-void ledStripUtilActivateFrame(struct led_rgb *frame)
+void ledStripUtilSetFrameFreeCallback(LedStripFrameFreeCallback_t callback)
 {
-  if(activeFrame)
-    osMemoryPoolFree(framebufferPool, activeFrame);
-  activeFrame = frame;
-  applyGlobalBrightness(activeFrame);
+  frameFreeCallback = callback;
 }
 
 int ledStripUtilPushFrame(void)
 {
-  int err;
-
-  if(!activeFrame)
-    return 0;
+  int err = 0;
+  int stripErr;
 
-  err = led_strip_update_rgb(ledStrip, activeFrame, pixelCount);
-  if(err < 0)
-    LOG_ERR("ERROR %d: unable to update LED string channels", err);
+  /* The driver transfers are synchronous, the strips are pushed back to back */
+  for(size_t i = 0; i < STRIP_COUNT; ++i)
+  {
+    stripErr = pushStrip(strips + i, i == PRIMARY_STRIP);
+    if(stripErr < 0)
+      err = stripErr;
+  }
 
   return err;
 }
 
-void ledStripUtilSetBrightness(uint8_t newbrightness)
+void ledStripUtilSetBrightness(size_t strip, uint8_t newBrightness)
 {
-  brightness = newbrightness;
-  applyGlobalBrightness(activeFrame);
+  LedStripInstance_t *instance = strips + strip;
+
+  instance->brightness = newBrightness;
+  buildLevelLut(instance);
+  instance->dirtyCount = instance->pixelCount;
 }
 
 /** @} */
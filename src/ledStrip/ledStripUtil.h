@@ -24,7 +24,7 @@
 #define LED_STRIP_LOGGER_NAME ledStrip
 
 /**
- * @brief   Intialize the LED strip device.
+ * @brief   Intialize the LED strip devices.
  *
  * @return  0 if successful, the error code otherwiese.
  */
@@ -38,32 +38,89 @@ int ledStripUtilInitStrip(void);
 int ledStripUtilInitFramebuffers(void);
 
 /**
- * @brief   Get the next framebuffer.
+ * @brief   Get the strip count.
+ *
+ * @return  The strip count, the primary strip being strip 0.
+ */
+size_t ledStripUtilGetStripCount(void);
+
+/**
+ * @brief   Get the pixel count of a strip.
+ *
+ * @param[in]   strip: The strip.
+ *
+ * @return  The strip chain length, 0 if strip is out of range.
+ */
+size_t ledStripUtilGetPixelCount(size_t strip);
+
+/**
+ * @brief   Get the next framebuffer of a strip.
+ *
+ * @param[in]   strip: The strip.
  *
  * @retunr  The framebuffer handle if successful, NULL otherwise.
  */
-struct led_rgb *ledStripUtilGetNextFramebuffer(void);
+struct led_rgb *ledStripUtilGetNextFramebuffer(size_t strip);
 
 /**
  * @brief   Activate a new frame.
  *
+ * @param[in]   strip: The strip, in range.
  * @param[in]   newFrame: The new frame to activate.
  */
-void ledStripUtilActivateFrame(struct led_rgb *frame);
+void ledStripUtilActivateFrame(size_t strip, struct led_rgb *frame);
 
 /**
- * @brief   Push the active frame.
+ * @brief   Post a new frame to the mailbox.
+ *
+ * @note    The posted frame replaces the pending one, if any, which is
+ *          released to the pool right away.
  *
- * @return  0 if successful, the error code otherwise.
+ * @param[in]   strip: The strip.
+ * @param[in]   frame: The new frame.
+ *
+ * @return  0 if successful, -EINVAL if frame is NULL or strip is out of range.
+ */
+int ledStripUtilPostFrame(size_t strip, struct led_rgb *frame);
+
+/**
+ * @brief   Take the mailbox frame of a strip.
+ *
+ * @param[in]   strip: The strip, in range.
+ *
+ * @return  The newest frame posted since the last call, NULL if none.
+ */
+struct led_rgb *ledStripUtilTakeFrame(size_t strip);
+
+/**
+ * @brief   Set the framebuffer release callback.
+ *
+ * @param[in]   callback: The callback, NULL to clear it.
+ */
+void ledStripUtilSetFrameFreeCallback(LedStripFrameFreeCallback_t callback);
+
+/**
+ * @brief   Push the active frame of each strip.
+ *
+ * @note    The strips are pushed back to back, a frame being only pushed once changed by a new frame, brightness,
+ *          zone update or effect step, or every CONFIG_ENYA_LED_STRIP_KEEP_ALIVE_MS
+ *          when set. A failed push is retried at the next call, the other
+ *          strips being pushed regardless.
+ *
+ * @return  0 if successful, the error code of the last failed push otherwise.
  */
 int ledStripUtilPushFrame(void);
 
 /**
- * @brief   Set global brightness.
+ * @brief   Set the brightness of a strip.
+ *
+ * @note    Only the level table is rebuilt, the brightness being applied to
+ *          the output at the next push. The frames keep their colors.
  *
- * @param[in]   newBirghtness: The global brightness.
+ * @param[in]   strip: The strip, in range.
+ * @param[in]   newBirghtness: The strip brightness.
  */
-void ledStripUtilSetBrightness(uint8_t newBrightness);
+void ledStripUtilSetBrightness(size_t strip, uint8_t newBrightness);
 
 #endif /* LEDSTRIPUTIL_H */
 
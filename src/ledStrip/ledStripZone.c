@@ -0,0 +1,204 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      ledStripZone.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     LED Strip Zones
+ *
+ *            LED strip zone implementation. The zone pixels share a single
+ *            chain-sized buffer, updated by the owners and composed by the
+ *            service thread under the zone lock.
+ *
+ * @ingroup   ledStrip
+ *
+ * @{
+ */
+
+#include <string.h>
+#include <zephyr/logging/log.h>
+
+#include "ledStripZone.h"
+#include "ledStripUtil.h"
+
+LOG_MODULE_DECLARE(LED_STRIP_LOGGER_NAME, CONFIG_ENYA_LED_STRIP_LOG_LEVEL);
+
+/**
+ * @brief   The zone.
+ */
+typedef struct
+{
+  uint16_t firstPixel;                  /**< The first pixel of the zone. */
+  uint16_t pixelCount;                  /**< The zone pixel count. */
+  bool isRegistered;                    /**< The zone registered flag. */
+} LedStripZone_t;
+
+static const uint32_t chainLength = DT_PROP(DT_ALIAS(led_strip), chain_length);
+
+/**
+ * @brief   The zones.
+ */
+static LedStripZone_t zones[CONFIG_ENYA_LED_STRIP_ZONE_COUNT];
+
+/**
+ * @brief   The zone pixels, each zone owning its range.
+ */
+static struct led_rgb zonePixels[DT_PROP(DT_ALIAS(led_strip), chain_length)];
+
+/**
+ * @brief   The pixel count up to the last zone pixel changed.
+ */
+static size_t zoneSpan = 0;
+
+/**
+ * @brief   The zone lock, guarding the zones, their pixels and span.
+ */
+static struct k_spinlock zoneLock;
+
+/**
+ * @brief   Check if a range overlaps a registered zone.
+ *
+ * @param[in]   firstPixel: The first pixel of the range.
+ * @param[in]   pixelCount: The range pixel count.
+ *
+ * @return  True if the range overlaps a zone, false otherwise.
+ */
+static bool isOverlapping(uint16_t firstPixel, uint16_t pixelCount)
+{
+  for(size_t i = 0; i < CONFIG_ENYA_LED_STRIP_ZONE_COUNT; ++i)
+    if(zones[i].isRegistered && firstPixel < zones[i].firstPixel + zones[i].pixelCount &&
+       zones[i].firstPixel < firstPixel + pixelCount)
+      return true;
+
+  return false;
+}
+
+int ledStripZoneRegister(uint16_t firstPixel, uint16_t pixelCount, size_t *zoneId)
+{
+  int err = 0;
+  size_t id;
+  k_spinlock_key_t key;
+
+  if(!zoneId || pixelCount == 0 || firstPixel + pixelCount > chainLength)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid zone range", err);
+    return err;
+  }
+
+  key = k_spin_lock(&zoneLock);
+
+  for(id = 0; id < CONFIG_ENYA_LED_STRIP_ZONE_COUNT && zones[id].isRegistered; ++id)
+    ;
+
+  if(isOverlapping(firstPixel, pixelCount))
+  {
+    err = -EBUSY;
+  }
+  else if(id == CONFIG_ENYA_LED_STRIP_ZONE_COUNT)
+  {
+    err = -ENOSPC;
+  }
+  else
+  {
+    zones[id].firstPixel   = firstPixel;
+    zones[id].pixelCount   = pixelCount;
+    zones[id].isRegistered = true;
+    memset(zonePixels + firstPixel, 0, pixelCount * sizeof(struct led_rgb));
+    zoneSpan = MAX(zoneSpan, firstPixel + pixelCount);
+    *zoneId  = id;
+  }
+
+  k_spin_unlock(&zoneLock, key);
+
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to register the zone", err);
+
+  return err;
+}
+
+int ledStripZoneUnregister(size_t zoneId)
+{
+  int err;
+  k_spinlock_key_t key;
+
+  if(zoneId >= CONFIG_ENYA_LED_STRIP_ZONE_COUNT || !zones[zoneId].isRegistered)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid zone %d", err, zoneId);
+    return err;
+  }
+
+  key = k_spin_lock(&zoneLock);
+
+  zones[zoneId].isRegistered = false;
+  zoneSpan                   = MAX(zoneSpan, zones[zoneId].firstPixel + zones[zoneId].pixelCount);
+
+  k_spin_unlock(&zoneLock, key);
+
+  return 0;
+}
+
+int ledStripZoneUpdate(size_t zoneId, size_t offset, const struct led_rgb *pixels, size_t count)
+{
+  int err;
+  LedStripZone_t *zone;
+  k_spinlock_key_t key;
+
+  if(zoneId >= CONFIG_ENYA_LED_STRIP_ZONE_COUNT || !zones[zoneId].isRegistered)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid zone %d", err, zoneId);
+    return err;
+  }
+
+  zone = zones + zoneId;
+  if(!pixels || offset + count > zone->pixelCount)
+  {
+    err = -EINVAL;
+    LOG_ERR("ERROR %d: invalid pixels of zone %d", err, zoneId);
+    return err;
+  }
+
+  key = k_spin_lock(&zoneLock);
+
+  memcpy(zonePixels + zone->firstPixel + offset, pixels, count * sizeof(struct led_rgb));
+  zoneSpan = MAX(zoneSpan, zone->firstPixel + offset + count);
+
+  k_spin_unlock(&zoneLock, key);
+
+  return 0;
+}
+
+size_t ledStripZoneTakeSpan(void)
+{
+  size_t span;
+  k_spinlock_key_t key = k_spin_lock(&zoneLock);
+
+  span     = zoneSpan;
+  zoneSpan = 0;
+
+  k_spin_unlock(&zoneLock, key);
+
+  return span;
+}
+
+void ledStripZoneCompose(struct led_rgb *frame, size_t count)
+{
+  k_spinlock_key_t key = k_spin_lock(&zoneLock);
+
+  for(size_t i = 0; i < CONFIG_ENYA_LED_STRIP_ZONE_COUNT; ++i)
+  {
+    const LedStripZone_t *zone = zones + i;
+
+    if(!zone->isRegistered || zone->firstPixel >= count)
+      continue;
+
+    memcpy(frame + zone->firstPixel, zonePixels + zone->firstPixel,
+           MIN(zone->pixelCount, count - zone->firstPixel) * sizeof(struct led_rgb));
+  }
+
+  k_spin_unlock(&zoneLock, key);
+}
+
+/** @} */
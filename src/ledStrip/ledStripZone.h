@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      ledStripZone.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     LED Strip Zones
+ *
+ *            LED strip zone API. Each owner registers a pixel range of the
+ *            chain and updates it with small pixel copies, the zones being
+ *            composed over the active frame at each push.
+ *
+ * @ingroup   ledStrip
+ *
+ * @{
+ */
+
+#ifndef LEDSTRIPZONE_H
+#define LEDSTRIPZONE_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/led_strip.h>
+
+/**
+ * @brief   Register a zone.
+ *
+ * @note    The zone starts off, its pixels being shown over the active frame
+ *          until it is unregistered.
+ *
+ * @param[in]   firstPixel: The first pixel of the zone.
+ * @param[in]   pixelCount: The zone pixel count.
+ * @param[out]  zoneId: The zone ID.
+ *
+ * @return  0 if successful, -EINVAL if zoneId is NULL or the range is empty
+ *          or out of the chain, -EBUSY if the range overlaps a zone, -ENOSPC
+ *          if all the zones are registered.
+ */
+int ledStripZoneRegister(uint16_t firstPixel, uint16_t pixelCount, size_t *zoneId);
+
+/**
+ * @brief   Unregister a zone.
+ *
+ * @note    The active frame is shown again over the range at the next push.
+ *
+ * @param[in]   zoneId: The zone ID.
+ *
+ * @return  0 if successful, -EINVAL if the zone is not registered.
+ */
+int ledStripZoneUnregister(size_t zoneId);
+
+/**
+ * @brief   Update the pixels of a zone.
+ *
+ * @note    The pixels are copied, the caller keeping its buffer.
+ *
+ * @param[in]   zoneId: The zone ID.
+ * @param[in]   offset: The first pixel to update, from the zone start.
+ * @param[in]   pixels: The pixels.
+ * @param[in]   count: The pixel count.
+ *
+ * @return  0 if successful, -EINVAL if the zone is not registered, pixels is
+ *          NULL or the pixels overflow the zone.
+ */
+int ledStripZoneUpdate(size_t zoneId, size_t offset, const struct led_rgb *pixels, size_t count);
+
+/**
+ * @brief   Take the zone span changed since the last call.
+ *
+ * @return  The pixel count up to the last zone pixel changed, 0 if none.
+ */
+size_t ledStripZoneTakeSpan(void);
+
+/**
+ * @brief   Compose the zones over a frame.
+ *
+ * @param[in,out]   frame: The frame, holding the active frame pixels.
+ * @param[in]       count: The pixel count to compose.
+ */
+void ledStripZoneCompose(struct led_rgb *frame, size_t count);
+
+#endif /* LEDSTRIPZONE_H */
+
+/** @} */
@@ -21,6 +21,15 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#ifdef CONFIG_ENYA_SERVICE_COMMON_SHARED_PAYLOAD
+#include <zephyr/sys/atomic.h>
+
+/**
+ * @brief   The shared payload pool, defined in srvPayload.h.
+ */
+typedef struct SrvPayloadPool SrvPayloadPool_t;
+#endif
+
 /**
  * @brief   The data union for data transmission between services.
  */
@@ -38,10 +47,18 @@ typedef union
  *          It is allocated from the producer service's memory pool and passed to
  *          consumers. Consumers must free the memory back to the pool after processing
  *          using the embedded pool ID.
+ *
+ *          A shared payload is allocated from a shared payload pool instead, its
+ *          pool ID being NULL. It is handed to many consumers by reference, each
+ *          one releasing it with srvPayloadRelease().
  */
 typedef struct
 {
   osMemoryPoolId_t poolId;                          /**< Memory pool to return buffer to. */
+#ifdef CONFIG_ENYA_SERVICE_COMMON_SHARED_PAYLOAD
+  SrvPayloadPool_t *sharedPool;                     /**< Shared pool to return buffer to. */
+  atomic_t refCount;                                /**< Shared payload reference count. */
+#endif
   size_t dataLen;                                   /**< Actual data length in bytes. */
   Data_t data[];                                    /**< Flexible array of data bytes. */
 } SrvMsgPayload_t;
@@ -0,0 +1,193 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      srvPayload.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Shared Service Payloads
+ *
+ *            Shared payload implementation. The free blocks form a lock-free
+ *            stack of block indexes, pushed and popped by compare-and-swap
+ *            on a tagged head.
+ *
+ * @ingroup   service-common
+ *
+ * @{
+ */
+
+#include <zephyr/logging/log.h>
+
+#include "srvPayload.h"
+
+LOG_MODULE_REGISTER(srvPayload, CONFIG_ENYA_SERVICE_COMMON_SHARED_PAYLOAD_LOG_LEVEL);
+
+/**
+ * @brief   The free list head index mask.
+ */
+#define HEAD_INDEX_MASK                 0x0000FFFFu
+
+/**
+ * @brief   The free list head tag increment.
+ */
+#define HEAD_TAG_INC                    0x00010000u
+
+/**
+ * @brief   Build the next free list head.
+ *
+ * @param[in]   head: The current head.
+ * @param[in]   index: The next head block index.
+ *
+ * @return  The next head, with its tag incremented.
+ */
+static inline atomic_val_t nextHead(atomic_val_t head, uint16_t index)
+{
+  return (atomic_val_t)((((uint32_t)head + HEAD_TAG_INC) & ~HEAD_INDEX_MASK) | index);
+}
+
+/**
+ * @brief   Get the payload of a pool block.
+ *
+ * @param[in]   pool: The pool.
+ * @param[in]   index: The block index.
+ *
+ * @return  The block payload.
+ */
+static inline SrvMsgPayload_t *getBlock(SrvPayloadPool_t *pool, uint16_t index)
+{
+  return (SrvMsgPayload_t *)(pool->blocks + (index * pool->blockSize));
+}
+
+/**
+ * @brief   Record an allocation in the pool statistics.
+ *
+ * @param[in]   pool: The pool.
+ */
+static inline void recordAlloc(SrvPayloadPool_t *pool)
+{
+  atomic_val_t peak;
+  atomic_val_t used = atomic_inc(&pool->usedCount) + 1;
+
+  do
+  {
+    peak = atomic_get(&pool->peakUsedCount);
+  } while(used > peak && !atomic_cas(&pool->peakUsedCount, peak, used));
+}
+
+/**
+ * @brief   Push a block on the pool free list.
+ *
+ * @param[in]   pool: The pool.
+ * @param[in]   payload: The block payload.
+ */
+static void freeBlock(SrvPayloadPool_t *pool, SrvMsgPayload_t *payload)
+{
+  atomic_val_t head;
+  uint16_t index = ((uint8_t *)payload - pool->blocks) / pool->blockSize;
+
+  do
+  {
+    head = atomic_get(&pool->freeHead);
+    pool->links[index] = (uint16_t)(head & HEAD_INDEX_MASK);
+  } while(!atomic_cas(&pool->freeHead, head, nextHead(head, index)));
+
+  atomic_dec(&pool->usedCount);
+}
+
+int srvPayloadPoolInit(SrvPayloadPool_t *pool)
+{
+  if(!pool || !pool->blocks || !pool->links || pool->blockCount == 0)
+  {
+    LOG_ERR("ERROR %d: invalid payload pool", -EINVAL);
+    return -EINVAL;
+  }
+
+  for(uint16_t i = 0; i < pool->blockCount - 1; ++i)
+    pool->links[i] = i + 1;
+
+  pool->links[pool->blockCount - 1] = SRV_PAYLOAD_POOL_END;
+
+  atomic_set(&pool->freeHead, 0);
+  atomic_set(&pool->usedCount, 0);
+  atomic_set(&pool->peakUsedCount, 0);
+  atomic_set(&pool->allocFailCount, 0);
+
+  LOG_INF("created payload pool %s: %u blocks of %zu bytes", pool->name, pool->blockCount,
+          pool->blockSize);
+
+  return 0;
+}
+
+SrvMsgPayload_t *srvPayloadAlloc(SrvPayloadPool_t *pool)
+{
+  atomic_val_t head;
+  uint16_t index;
+  SrvMsgPayload_t *payload;
+
+  if(!pool)
+    return NULL;
+
+  do
+  {
+    head = atomic_get(&pool->freeHead);
+    index = (uint16_t)(head & HEAD_INDEX_MASK);
+
+    if(index == SRV_PAYLOAD_POOL_END)
+    {
+      atomic_inc(&pool->allocFailCount);
+      return NULL;
+    }
+
+    /* A stale link fails the swap, the tag having changed */
+  } while(!atomic_cas(&pool->freeHead, head, nextHead(head, pool->links[index])));
+
+  recordAlloc(pool);
+
+  payload = getBlock(pool, index);
+  payload->poolId = NULL;
+  payload->sharedPool = pool;
+  payload->dataLen = 0;
+  atomic_set(&payload->refCount, 1);
+
+  return payload;
+}
+
+void srvPayloadRetain(SrvMsgPayload_t *payload)
+{
+  if(payload && !payload->poolId)
+    atomic_inc(&payload->refCount);
+}
+
+void srvPayloadRelease(SrvMsgPayload_t *payload)
+{
+  if(!payload)
+    return;
+
+  if(payload->poolId)
+  {
+    osMemoryPoolFree(payload->poolId, payload);
+    return;
+  }
+
+  if(atomic_dec(&payload->refCount) == 1)
+    freeBlock(payload->sharedPool, payload);
+}
+
+size_t srvPayloadPoolGetDataCapacity(const SrvPayloadPool_t *pool)
+{
+  return pool->blockSize - sizeof(SrvMsgPayload_t);
+}
+
+int srvPayloadPoolGetStats(const SrvPayloadPool_t *pool, SrvPayloadPoolStats_t *stats)
+{
+  if(!pool || !stats)
+    return -EINVAL;
+
+  stats->blockCount = pool->blockCount;
+  stats->usedCount = (uint16_t)atomic_get(&pool->usedCount);
+  stats->peakUsedCount = (uint16_t)atomic_get(&pool->peakUsedCount);
+  stats->allocFailCount = (uint32_t)atomic_get(&pool->allocFailCount);
+
+  return 0;
+}
+
+/** @} */
@@ -0,0 +1,155 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      srvPayload.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Shared Service Payloads
+ *
+ *            Reference-counted service payloads, allocated from lock-free
+ *            fixed-block pools usable from ISR context. A producer allocates
+ *            a payload once and hands it to many consumers, each one taking
+ *            its own reference.
+ *
+ * @ingroup   service-common
+ *
+ * @{
+ */
+
+#ifndef SRV_PAYLOAD_H
+#define SRV_PAYLOAD_H
+
+#include <zephyr/kernel.h>
+
+#include "serviceCommon.h"
+
+/**
+ * @brief   The free list end marker, also bounding the pool block count.
+ */
+#define SRV_PAYLOAD_POOL_END            0xFFFF
+
+/**
+ * @brief   Get the block size of a payload of a data capacity.
+ *
+ * @param[in]   maxDataLen: The payload data capacity [bytes].
+ */
+#define SRV_PAYLOAD_BLOCK_SIZE(maxDataLen) \
+  ROUND_UP(sizeof(SrvMsgPayload_t) + (maxDataLen), sizeof(void *))
+
+/**
+ * @brief   The shared payload pool.
+ *
+ * @note    The free list head packs a modification tag in its upper half,
+ *          guarding the lock-free list against the ABA problem.
+ */
+struct SrvPayloadPool
+{
+  const char *name;                     /**< The pool name. */
+  uint8_t *blocks;                      /**< The pool blocks. */
+  uint16_t *links;                      /**< The free list links, one per block. */
+  size_t blockSize;                     /**< The block size [bytes]. */
+  uint16_t blockCount;                  /**< The block count. */
+  atomic_t freeHead;                    /**< The tagged free list head. */
+  atomic_t usedCount;                   /**< The allocated block count. */
+  atomic_t peakUsedCount;               /**< The allocated block count peak. */
+  atomic_t allocFailCount;              /**< The failed allocation count. */
+};
+
+/**
+ * @brief   The shared payload pool statistics.
+ */
+typedef struct
+{
+  uint16_t blockCount;                  /**< The block count. */
+  uint16_t usedCount;                   /**< The allocated block count. */
+  uint16_t peakUsedCount;               /**< The allocated block count peak. */
+  uint32_t allocFailCount;              /**< The failed allocation count. */
+} SrvPayloadPoolStats_t;
+
+/**
+ * @brief   Define a shared payload pool.
+ *
+ * @note    The pool must be initialized with srvPayloadPoolInit() before use.
+ *
+ * @param[in]   poolName: The pool variable name.
+ * @param[in]   count: The payload count.
+ * @param[in]   maxDataLen: The payload data capacity [bytes].
+ */
+#define SRV_PAYLOAD_POOL_DEFINE(poolName, count, maxDataLen)                                  \
+  BUILD_ASSERT((count) > 0 && (count) < SRV_PAYLOAD_POOL_END, "invalid payload count");      \
+  static uint8_t poolName##Blocks[(count) * SRV_PAYLOAD_BLOCK_SIZE(maxDataLen)]               \
+    __aligned(sizeof(void *));                                                                \
+  static uint16_t poolName##Links[(count)];                                                   \
+  SrvPayloadPool_t poolName = {                                                               \
+    .name = #poolName,                                                                        \
+    .blocks = poolName##Blocks,                                                               \
+    .links = poolName##Links,                                                                 \
+    .blockSize = SRV_PAYLOAD_BLOCK_SIZE(maxDataLen),                                          \
+    .blockCount = (count),                                                                    \
+  }
+
+/**
+ * @brief   Initialize a shared payload pool.
+ *
+ * @note    Not thread safe, the pool must be initialized before any
+ *          allocation.
+ *
+ * @param[in,out]   pool: The pool.
+ *
+ * @return  0 if successful, -EINVAL if pool is NULL or has no block.
+ */
+int srvPayloadPoolInit(SrvPayloadPool_t *pool);
+
+/**
+ * @brief   Allocate a shared payload.
+ *
+ * @note    The payload holds the producer reference. Safe to call from an ISR.
+ *
+ * @param[in]   pool: The pool.
+ *
+ * @return  The payload if successful, NULL if the pool is exhausted.
+ */
+SrvMsgPayload_t *srvPayloadAlloc(SrvPayloadPool_t *pool);
+
+/**
+ * @brief   Take a payload reference.
+ *
+ * @note    A payload with a pool ID is not shared and is left untouched.
+ *
+ * @param[in]   payload: The shared payload.
+ */
+void srvPayloadRetain(SrvMsgPayload_t *payload);
+
+/**
+ * @brief   Release a payload reference.
+ *
+ * @note    The last reference returns a shared payload to its pool. A
+ *          payload with a pool ID is not shared and is freed to its memory
+ *          pool right away. Safe to call from an ISR.
+ *
+ * @param[in]   payload: The payload, NULL being ignored.
+ */
+void srvPayloadRelease(SrvMsgPayload_t *payload);
+
+/**
+ * @brief   Get the payload data capacity of a pool.
+ *
+ * @param[in]   pool: The pool.
+ *
+ * @return  The payload data capacity [bytes].
+ */
+size_t srvPayloadPoolGetDataCapacity(const SrvPayloadPool_t *pool);
+
+/**
+ * @brief   Get the statistics of a pool.
+ *
+ * @param[in]   pool: The pool.
+ * @param[out]  stats: The pool statistics.
+ *
+ * @return  0 if successful, -EINVAL if an argument is NULL.
+ */
+int srvPayloadPoolGetStats(const SrvPayloadPool_t *pool, SrvPayloadPoolStats_t *stats);
+
+#endif    /* SRV_PAYLOAD_H */
+
+/** @} */
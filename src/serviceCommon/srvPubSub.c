@@ -0,0 +1,233 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      srvPubSub.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Publish/Subscribe Bus
+ *
+ *            Publish/subscribe bus implementation. The payloads are shared
+ *            payloads of the topic pool, the subscriber table being guarded by
+ *            the topic lock so a publication can not race a subscription
+ *            change.
+ *
+ * @ingroup   service-common
+ *
+ * @{
+ */
+
+#include <zephyr/logging/log.h>
+
+#include "srvPubSub.h"
+#include "srvPayload.h"
+
+LOG_MODULE_REGISTER(srvPubSub, CONFIG_ENYA_SERVICE_COMMON_PUB_SUB_LOG_LEVEL);
+
+/**
+ * @brief   Find a subscriber in the topic table.
+ *
+ * @note    The topic lock must be held.
+ *
+ * @param[in]   topic: The topic.
+ * @param[in]   sub: The subscriber.
+ *
+ * @return  The subscriber index if found, -ESRCH otherwise.
+ */
+static int findSubscriber(SrvPubSubTopic_t *topic, SrvPubSubSubscriber_t *sub)
+{
+  for(size_t i = 0; i < topic->subCount; ++i)
+  {
+    if(topic->subs[i] == sub)
+      return (int)i;
+  }
+
+  return -ESRCH;
+}
+
+/**
+ * @brief   Queue a payload to a subscriber, applying its policy when full.
+ *
+ * @note    The topic lock must be held. The subscriber reference is taken
+ *          only when the payload is queued.
+ *
+ * @param[in]   sub: The subscriber.
+ * @param[in]   payload: The payload.
+ *
+ * @return  True if queued, false if dropped.
+ */
+static bool queuePayload(SrvPubSubSubscriber_t *sub, SrvMsgPayload_t *payload)
+{
+  SrvMsgPayload_t *oldest;
+
+  srvPayloadRetain(payload);
+
+  if(k_msgq_put(sub->queue, &payload, K_NO_WAIT) == 0)
+    return true;
+
+  if(sub->policy == SRV_PUB_SUB_DROP_OLDEST && k_msgq_get(sub->queue, &oldest, K_NO_WAIT) == 0)
+  {
+    srvPayloadRelease(oldest);
+    atomic_inc(&sub->dropCount);
+
+    if(k_msgq_put(sub->queue, &payload, K_NO_WAIT) == 0)
+      return true;
+  }
+
+  srvPayloadRelease(payload);
+  atomic_inc(&sub->dropCount);
+
+  return false;
+}
+
+int srvPubSubTopicInit(SrvPubSubTopic_t *topic, const char *name, SrvPayloadPool_t *pool,
+                       SrvPubSubSubscriber_t **subs, size_t maxSubCount)
+{
+  if(!topic || !name || !pool || !subs || maxSubCount == 0)
+  {
+    LOG_ERR("ERROR %d: invalid topic configuration", -EINVAL);
+    return -EINVAL;
+  }
+
+  topic->name = name;
+  topic->pool = pool;
+  topic->subs = subs;
+  topic->maxSubCount = maxSubCount;
+  topic->subCount = 0;
+
+  return 0;
+}
+
+int srvPubSubSubscriberInit(SrvPubSubSubscriber_t *sub, struct k_msgq *queue, SrvPubSubPolicy_t policy)
+{
+  if(!sub || !queue || policy >= SRV_PUB_SUB_POLICY_COUNT || queue->msg_size != sizeof(SrvMsgPayload_t *))
+  {
+    LOG_ERR("ERROR %d: invalid subscriber configuration", -EINVAL);
+    return -EINVAL;
+  }
+
+  sub->queue = queue;
+  sub->policy = policy;
+  atomic_set(&sub->isPaused, false);
+  atomic_set(&sub->dropCount, 0);
+
+  return 0;
+}
+
+int srvPubSubSubscribe(SrvPubSubTopic_t *topic, SrvPubSubSubscriber_t *sub)
+{
+  int err = 0;
+  k_spinlock_key_t key;
+
+  if(!topic || !sub)
+    return -EINVAL;
+
+  key = k_spin_lock(&topic->lock);
+
+  if(findSubscriber(topic, sub) >= 0)
+    err = -EALREADY;
+  else if(topic->subCount >= topic->maxSubCount)
+    err = -ENOSPC;
+  else
+    topic->subs[topic->subCount++] = sub;
+
+  k_spin_unlock(&topic->lock, key);
+
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to subscribe to the topic %s", err, topic->name);
+
+  return err;
+}
+
+int srvPubSubUnsubscribe(SrvPubSubTopic_t *topic, SrvPubSubSubscriber_t *sub)
+{
+  int index;
+  SrvMsgPayload_t *payload;
+  k_spinlock_key_t key;
+
+  if(!topic || !sub)
+    return -EINVAL;
+
+  key = k_spin_lock(&topic->lock);
+
+  index = findSubscriber(topic, sub);
+  if(index >= 0)
+  {
+    /* Shift remaining subscribers down */
+    for(size_t i = index; i < topic->subCount - 1; ++i)
+      topic->subs[i] = topic->subs[i + 1];
+
+    --topic->subCount;
+  }
+
+  k_spin_unlock(&topic->lock, key);
+
+  if(index < 0)
+  {
+    LOG_ERR("ERROR %d: subscriber not found in the topic %s", index, topic->name);
+    return index;
+  }
+
+  /* No publication can reach the queue anymore */
+  while(k_msgq_get(sub->queue, &payload, K_NO_WAIT) == 0)
+    srvPayloadRelease(payload);
+
+  return 0;
+}
+
+int srvPubSubSetPaused(SrvPubSubSubscriber_t *sub, bool isPaused)
+{
+  if(!sub)
+    return -EINVAL;
+
+  atomic_set(&sub->isPaused, isPaused);
+
+  return 0;
+}
+
+SrvMsgPayload_t *srvPubSubAlloc(SrvPubSubTopic_t *topic)
+{
+  if(!topic)
+    return NULL;
+
+  return srvPayloadAlloc(topic->pool);
+}
+
+int srvPubSubPublish(SrvPubSubTopic_t *topic, SrvMsgPayload_t *payload)
+{
+  int queuedCount = 0;
+  k_spinlock_key_t key;
+
+  if(!topic || !payload)
+    return -EINVAL;
+
+  if(payload->dataLen > srvPayloadPoolGetDataCapacity(topic->pool))
+  {
+    srvPayloadRelease(payload);
+    LOG_ERR("ERROR %d: payload too large for the topic %s", -EINVAL, topic->name);
+    return -EINVAL;
+  }
+
+  key = k_spin_lock(&topic->lock);
+
+  for(size_t i = 0; i < topic->subCount; ++i)
+  {
+    if(!atomic_get(&topic->subs[i]->isPaused) && queuePayload(topic->subs[i], payload))
+      ++queuedCount;
+  }
+
+  k_spin_unlock(&topic->lock, key);
+
+  srvPayloadRelease(payload);
+
+  return queuedCount;
+}
+
+int srvPubSubReceive(SrvPubSubSubscriber_t *sub, SrvMsgPayload_t **payload, k_timeout_t timeout)
+{
+  if(!sub || !payload)
+    return -EINVAL;
+
+  return k_msgq_get(sub->queue, payload, timeout);
+}
+
+/** @} */
@@ -0,0 +1,175 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      srvPubSub.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Publish/Subscribe Bus
+ *
+ *            Zero-copy publish/subscribe bus shared by the services. A
+ *            published payload is a shared payload allocated once from its
+ *            topic pool and queued by reference to every active subscriber,
+ *            the last release returning it to the pool.
+ *
+ * @ingroup   service-common
+ *
+ * @{
+ */
+
+#ifndef SRV_PUB_SUB_H
+#define SRV_PUB_SUB_H
+
+#include <zephyr/kernel.h>
+
+#include "serviceCommon.h"
+#include "srvPayload.h"
+
+/**
+ * @brief   The subscriber full queue policies.
+ */
+typedef enum
+{
+  SRV_PUB_SUB_DROP_NEWEST = 0,          /**< Drop the published payload. */
+  SRV_PUB_SUB_DROP_OLDEST,              /**< Drop the oldest queued payload. */
+  SRV_PUB_SUB_POLICY_COUNT,
+} SrvPubSubPolicy_t;
+
+/**
+ * @brief   The subscriber.
+ *
+ * @note    The queue holds SrvMsgPayload_t pointers and is owned by the
+ *          subscriber.
+ */
+typedef struct
+{
+  struct k_msgq *queue;                 /**< The payload queue. */
+  SrvPubSubPolicy_t policy;             /**< The full queue policy. */
+  atomic_t isPaused;                    /**< The paused flag. */
+  atomic_t dropCount;                   /**< The dropped payload count. */
+} SrvPubSubSubscriber_t;
+
+/**
+ * @brief   The topic.
+ */
+typedef struct
+{
+  const char *name;                     /**< The topic name. */
+  SrvPayloadPool_t *pool;               /**< The payload pool. */
+  SrvPubSubSubscriber_t **subs;         /**< The subscriber table. */
+  size_t maxSubCount;                   /**< The subscriber table size. */
+  size_t subCount;                      /**< The subscriber count. */
+  struct k_spinlock lock;               /**< The subscriber table lock. */
+} SrvPubSubTopic_t;
+
+/**
+ * @brief   Initialize a topic.
+ *
+ * @note    The payload pool must be initialized, it can be shared by many
+ *          topics.
+ *
+ * @param[out]  topic: The topic.
+ * @param[in]   name: The topic name.
+ * @param[in]   pool: The payload pool.
+ * @param[in]   subs: The subscriber table.
+ * @param[in]   maxSubCount: The subscriber table size.
+ *
+ * @return  0 if successful, -EINVAL if an argument is NULL or 0.
+ */
+int srvPubSubTopicInit(SrvPubSubTopic_t *topic, const char *name, SrvPayloadPool_t *pool,
+                       SrvPubSubSubscriber_t **subs, size_t maxSubCount);
+
+/**
+ * @brief   Initialize a subscriber.
+ *
+ * @param[out]  sub: The subscriber.
+ * @param[in]   queue: The payload queue, of SrvMsgPayload_t pointers.
+ * @param[in]   policy: The full queue policy.
+ *
+ * @return  0 if successful, -EINVAL if an argument is invalid or the queue
+ *          message size is not a payload pointer.
+ */
+int srvPubSubSubscriberInit(SrvPubSubSubscriber_t *sub, struct k_msgq *queue, SrvPubSubPolicy_t policy);
+
+/**
+ * @brief   Subscribe to a topic.
+ *
+ * @param[in,out]   topic: The topic.
+ * @param[in]       sub: The subscriber.
+ *
+ * @return  0 if successful, -EINVAL if an argument is NULL, -EALREADY if
+ *          already subscribed, -ENOSPC if the subscriber table is full.
+ */
+int srvPubSubSubscribe(SrvPubSubTopic_t *topic, SrvPubSubSubscriber_t *sub);
+
+/**
+ * @brief   Unsubscribe from a topic.
+ *
+ * @note    The payloads left in the subscriber queue are released.
+ *
+ * @param[in,out]   topic: The topic.
+ * @param[in]       sub: The subscriber.
+ *
+ * @return  0 if successful, -EINVAL if an argument is NULL, -ESRCH if not
+ *          subscribed.
+ */
+int srvPubSubUnsubscribe(SrvPubSubTopic_t *topic, SrvPubSubSubscriber_t *sub);
+
+/**
+ * @brief   Pause or unpause a subscriber.
+ *
+ * @note    A paused subscriber keeps its queued payloads but is skipped by
+ *          the publications.
+ *
+ * @param[in]   sub: The subscriber.
+ * @param[in]   isPaused: The paused flag.
+ *
+ * @return  0 if successful, -EINVAL if sub is NULL.
+ */
+int srvPubSubSetPaused(SrvPubSubSubscriber_t *sub, bool isPaused);
+
+/**
+ * @brief   Allocate a payload of a topic.
+ *
+ * @note    The payload holds the publisher reference, handed over by
+ *          srvPubSubPublish().
+ *
+ * @param[in]   topic: The topic.
+ *
+ * @return  The payload if successful, NULL otherwise.
+ */
+SrvMsgPayload_t *srvPubSubAlloc(SrvPubSubTopic_t *topic);
+
+/**
+ * @brief   Publish a payload to the active subscribers of a topic.
+ *
+ * @note    The publisher reference is released, even on an invalid payload,
+ *          so the payload must not be used afterwards. Safe to call from an
+ *          ISR.
+ *
+ * @param[in]   topic: The topic.
+ * @param[in]   payload: The payload, allocated from the topic.
+ *
+ * @return  The subscriber count the payload was queued to if successful,
+ *          -EINVAL if an argument is NULL or dataLen exceeds the pool data
+ *          capacity.
+ */
+int srvPubSubPublish(SrvPubSubTopic_t *topic, SrvMsgPayload_t *payload);
+
+/**
+ * @brief   Receive a payload.
+ *
+ * @note    The payload must be released with srvPayloadRelease() once
+ *          processed.
+ *
+ * @param[in]   sub: The subscriber.
+ * @param[out]  payload: The payload.
+ * @param[in]   timeout: The receive timeout.
+ *
+ * @return  0 if successful, -EINVAL if an argument is NULL, the k_msgq_get()
+ *          error otherwise.
+ */
+int srvPubSubReceive(SrvPubSubSubscriber_t *sub, SrvMsgPayload_t **payload, k_timeout_t timeout);
+
+#endif    /* SRV_PUB_SUB_H */
+
+/** @} */
@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      srvTrace.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Trace Points
+ *
+ *            Compile-time optional trace points at the key stages of the
+ *            services, recorded as SystemView markers or as Zephyr tracing
+ *            named events. Disabled, they compile to nothing.
+ *
+ * @ingroup   service-common
+ *
+ * @{
+ */
+
+#ifndef SRV_TRACE_H
+#define SRV_TRACE_H
+
+#include <zephyr/kernel.h>
+
+/**
+ * @brief   The trace points.
+ *
+ * @note    The SystemView marker of a trace point is its ID plus
+ *          CONFIG_ENYA_SERVICE_COMMON_TRACE_ID_BASE, new points go last to
+ *          keep the recorded IDs stable.
+ */
+typedef enum
+{
+  SRV_TRACE_DATASTORE_ENQUEUE = 0,      /**< A datastore request queued, arg: the message type. */
+  SRV_TRACE_DATASTORE_DEQUEUE,          /**< A datastore request taken by its thread, arg: the message type. */
+  SRV_TRACE_DATASTORE_DISPATCH,         /**< A datastore request served, arg: the message type. */
+  SRV_TRACE_DATASTORE_NOTIFY,           /**< A datastore subscriber notification, arg: the datapoint type. */
+  SRV_TRACE_ADC_TRIGGER,                /**< The ADC trigger interrupt, arg: the group count. */
+  SRV_TRACE_ADC_SEQ_CALLBACK,           /**< An ADC block completion callback, arg: the group first channel. */
+  SRV_TRACE_ADC_PROCESS,                /**< The ADC data conversion, arg: the due channel mask. */
+  SRV_TRACE_ADC_NOTIFY,                 /**< The ADC subscriber notification, arg: the subscription count. */
+  SRV_TRACE_LED_STRIP_ACTIVATE,         /**< An LED strip frame activation, arg: the strip index. */
+  SRV_TRACE_LED_STRIP_UPDATE,           /**< An LED strip driver update, arg: the pushed pixel count. */
+  SRV_TRACE_SVC_MGR_SUPERVISION,        /**< A service manager supervision pass, arg: 0. */
+  SRV_TRACE_POINT_COUNT,
+} SrvTracePoint_t;
+
+/**
+ * @brief   The trace event phases, the named event first argument.
+ */
+typedef enum
+{
+  SRV_TRACE_PHASE_BEGIN = 0,            /**< The stage begins. */
+  SRV_TRACE_PHASE_END,                  /**< The stage ends. */
+  SRV_TRACE_PHASE_EVENT,                /**< A single event. */
+} SrvTracePhase_t;
+
+#if defined(CONFIG_ENYA_SERVICE_COMMON_TRACE) && defined(CONFIG_SEGGER_SYSTEMVIEW)
+#include <SEGGER_SYSVIEW.h>
+
+/* The markers only carry their ID, the name and argument are not recorded */
+#define SRV_TRACE_RECORD(point, name, phase, arg)                             \
+  do                                                                          \
+  {                                                                           \
+    ARG_UNUSED(name);                                                         \
+    ARG_UNUSED(arg);                                                          \
+    if((phase) == SRV_TRACE_PHASE_BEGIN)                                      \
+      SEGGER_SYSVIEW_MarkStart(CONFIG_ENYA_SERVICE_COMMON_TRACE_ID_BASE + (point)); \
+    else if((phase) == SRV_TRACE_PHASE_END)                                   \
+      SEGGER_SYSVIEW_MarkStop(CONFIG_ENYA_SERVICE_COMMON_TRACE_ID_BASE + (point)); \
+    else                                                                      \
+      SEGGER_SYSVIEW_Mark(CONFIG_ENYA_SERVICE_COMMON_TRACE_ID_BASE + (point)); \
+  } while(0)
+#elif defined(CONFIG_ENYA_SERVICE_COMMON_TRACE)
+#include <zephyr/tracing/tracing.h>
+
+/* The tracing backends bound the event name, the point names stay under 20 characters */
+#define SRV_TRACE_RECORD(point, name, phase, arg)                             \
+  sys_trace_named_event(name, (phase), (uint32_t)(arg))
+#endif
+
+#ifdef CONFIG_ENYA_SERVICE_COMMON_TRACE
+/**
+ * @brief   Record the beginning of a traced stage.
+ *
+ * @param[in]   point: The trace point name, without its SRV_TRACE_ prefix.
+ * @param[in]   arg: The stage argument.
+ */
+#define SRV_TRACE_BEGIN(point, arg)     SRV_TRACE_RECORD(SRV_TRACE_##point, #point, SRV_TRACE_PHASE_BEGIN, arg)
+
+/**
+ * @brief   Record the end of a traced stage.
+ *
+ * @param[in]   point: The trace point name, without its SRV_TRACE_ prefix.
+ * @param[in]   arg: The stage argument.
+ */
+#define SRV_TRACE_END(point, arg)       SRV_TRACE_RECORD(SRV_TRACE_##point, #point, SRV_TRACE_PHASE_END, arg)
+
+/**
+ * @brief   Record a single traced event.
+ *
+ * @param[in]   point: The trace point name, without its SRV_TRACE_ prefix.
+ * @param[in]   arg: The event argument.
+ */
+#define SRV_TRACE_EVENT(point, arg)     SRV_TRACE_RECORD(SRV_TRACE_##point, #point, SRV_TRACE_PHASE_EVENT, arg)
+#else
+#define SRV_TRACE_BEGIN(point, arg)     do {} while(0)
+#define SRV_TRACE_END(point, arg)       do {} while(0)
+#define SRV_TRACE_EVENT(point, arg)     do {} while(0)
+#endif
+
+#endif /* SRV_TRACE_H */
+
+/** @} */
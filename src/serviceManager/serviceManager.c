@@ -17,6 +17,13 @@
 
 #include "serviceManager.h"
 #include "serviceManagerUtil.h"
+#include "srvTrace.h"
+#ifdef CONFIG_SVC_MGR_EXECUTOR
+#include "serviceManagerExecutor.h"
+#endif
+#ifdef CONFIG_SVC_MGR_STATS
+#include "serviceManagerStats.h"
+#endif
 
 LOG_MODULE_REGISTER(serviceManager, CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL);
 
@@ -26,6 +33,11 @@ LOG_MODULE_REGISTER(serviceManager, CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL);
 #endif
 #endif
 
+/**
+ * @brief   The hardware watchdog feed period, half the watchdog timeout.
+ */
+#define SVC_MGR_WDT_FEED_PERIOD_MS (CONFIG_SVC_MGR_WDT_TIMEOUT_MS / 2)
+
 /**
  * @brief   The service manager message type.
  */
@@ -61,9 +73,20 @@ static struct k_thread serviceManagerThread;
  */
 K_MSGQ_DEFINE(serviceManagerQueue, sizeof(ServiceMgrMsg_t), CONFIG_SVC_MGR_MAX_SERVICES, 4);
 
+/**
+ * @brief   The running confirmation semaphore, waking up the services start.
+ *
+ * @note    Every running confirmation gives it, the resumes and restarts
+ *          included. The services start resets it before waiting on it.
+ */
+K_SEM_DEFINE(runningConfirmSem, 0, CONFIG_SVC_MGR_MAX_SERVICES);
+
 /**
  * @brief   The service manager monitor thread.
  *
+ * @note    The thread sleeps until the earliest of the next heartbeat
+ *          deadline, the next watchdog feed or a lifecycle request.
+ *
  * @param[in]   p1: Unused thread parameter.
  * @param[in]   p2: Unused thread parameter.
  * @param[in]   p3: Unused thread parameter.
@@ -73,6 +96,12 @@ static void run(void *p1, void *p2, void *p3)
   size_t index;
   int err;
   bool canFeedWdg;
+  int64_t now;
+  int64_t wakeupMs;
+  int64_t nextFeedMs;
+#ifdef CONFIG_SVC_MGR_STATS
+  int64_t nextStatsMs;
+#endif
   ServiceMgrMsg_t msg;
   ServiceDescriptor_t *descriptor;
 
@@ -80,13 +109,26 @@ static void run(void *p1, void *p2, void *p3)
   ARG_UNUSED(p2);
   ARG_UNUSED(p3);
 
+  nextFeedMs = k_uptime_get();
+#ifdef CONFIG_SVC_MGR_STATS
+  nextStatsMs = nextFeedMs + CONFIG_SVC_MGR_STATS_PERIOD_MS;
+#endif
+
 #ifdef CONFIG_ZTEST
   for(size_t i = 0; i < SVC_MGR_RUN_ITERATIONS; i++)
 #else
   for(;;)
 #endif
   {
-    if(k_msgq_get(&serviceManagerQueue, &msg, K_MSEC(CONFIG_SVC_MGR_LOOP_PERIOD_MS)) == 0)
+    /* Sleep until something is due or a request arrives */
+    now = k_uptime_get();
+    wakeupMs = MIN(serviceMngrUtilGetNextHeartbeatDeadline(), nextFeedMs);
+#ifdef CONFIG_SVC_MGR_STATS
+    wakeupMs = MIN(wakeupMs, nextStatsMs);
+#endif
+
+    if(k_msgq_get(&serviceManagerQueue, &msg,
+                  wakeupMs > now ? K_MSEC(wakeupMs - now) : K_NO_WAIT) == 0)
     {
       descriptor = serviceMngrUtilGetRegEntryByIndex(msg.index);
       switch(msg.type)
@@ -121,6 +163,8 @@ static void run(void *p1, void *p2, void *p3)
       }
     }
 
+    SRV_TRACE_BEGIN(SVC_MGR_SUPERVISION, 0);
+
     canFeedWdg = true;
 
     for(index = 0; (descriptor = serviceMngrUtilGetRegEntryByIndex(index)) != NULL; index++)
@@ -128,34 +172,87 @@ static void run(void *p1, void *p2, void *p3)
       err = serviceMngrUtilCheckSrvHeartbeat(index);
       if(err < 0)
       {
-        canFeedWdg = false;
         LOG_ERR("ERROR %d: service %s heartbeat timeout", err,
                 k_thread_name_get(descriptor->threadId));
+
+        /* Restart the service when its policy allows it, the SoC reset otherwise */
+        err = serviceMngrUtilRecoverService(index);
+        if(err < 0)
+        {
+          canFeedWdg = false;
+          LOG_ERR("ERROR %d: service %s not recovered, SoC reset pending", err,
+                  k_thread_name_get(descriptor->threadId));
+        }
       }
     }
 
-    if(canFeedWdg)
+    /* Feed the watchdog on its own schedule, only while all services are healthy */
+    now = k_uptime_get();
+    if(now >= nextFeedMs)
     {
-      err = serviceMngrUtilFeedHardWdg();
+      if(canFeedWdg)
+      {
+        err = serviceMngrUtilFeedHardWdg();
+        if(err < 0)
+          LOG_ERR("ERROR %d: failed to feed hardware watchdog", err);
+      }
+
+      nextFeedMs = now + SVC_MGR_WDT_FEED_PERIOD_MS;
+    }
+
+    SRV_TRACE_END(SVC_MGR_SUPERVISION, 0);
+
+#ifdef CONFIG_SVC_MGR_STATS
+    /* Sample the service statistics on their own schedule */
+    if(now >= nextStatsMs)
+    {
+      err = serviceMngrStatsSample();
       if(err < 0)
-        LOG_ERR("ERROR %d: failed to feed hardware watchdog", err);
+        LOG_ERR("ERROR %d: failed to sample the service statistics", err);
+
+      nextStatsMs = now + CONFIG_SVC_MGR_STATS_PERIOD_MS;
     }
+#endif
   }
 }
 
 /**
  * @brief   Enqueue a lifecycle request for a service.
  *
+ * @param[in]   type:   The message type (start, stop, suspend, resume).
+ * @param[in]   index:  The registry index of the target service.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int enqueueRequest(ServiceMgrMsgType_t type, size_t index)
+{
+  ServiceMgrMsg_t msg;
+  int err;
+
+  msg.type = type;
+  msg.index = index;
+
+  err = k_msgq_put(&serviceManagerQueue, &msg, K_NO_WAIT);
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: failed to enqueue state change request", err);
+    return err;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief   Enqueue a lifecycle request for a service found by thread ID.
+ *
  * @param[in]   type:     The message type (start, stop, suspend, resume).
  * @param[in]   threadId: The thread ID of the target service.
  *
  * @return  0 if successful, the error code otherwise.
  */
-static int enqueueRequest(ServiceMgrMsgType_t type, k_tid_t threadId)
+static int enqueueThreadRequest(ServiceMgrMsgType_t type, k_tid_t threadId)
 {
   int index;
-  ServiceMgrMsg_t msg;
-  int err;
 
   index = serviceMngrUtilGetIndexFromId(threadId);
   if(index < 0)
@@ -164,17 +261,26 @@ static int enqueueRequest(ServiceMgrMsgType_t type, k_tid_t threadId)
     return index;
   }
 
-  msg.type = type;
-  msg.index = (size_t)index;
+  return enqueueRequest(type, (size_t)index);
+}
 
-  err = k_msgq_put(&serviceManagerQueue, &msg, K_NO_WAIT);
-  if(err < 0)
+/**
+ * @brief   Enqueue a lifecycle request for a service found by handle.
+ *
+ * @param[in]   type:   The message type (start, stop, suspend, resume).
+ * @param[in]   handle: The handle of the target service.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int enqueueHandleRequest(ServiceMgrMsgType_t type, ServiceHandle_t handle)
+{
+  if(serviceMngrUtilGetRegEntryByIndex(handle) == NULL)
   {
-    LOG_ERR("ERROR %d: failed to enqueue state change request", err);
-    return err;
+    LOG_ERR("ERROR %d: invalid service handle %zu", -EINVAL, handle);
+    return -EINVAL;
   }
 
-  return 0;
+  return enqueueRequest(type, handle);
 }
 
 int serviceManagerInit(void)
@@ -198,6 +304,16 @@ int serviceManagerInit(void)
     return err;
   }
 
+#ifdef CONFIG_SVC_MGR_EXECUTOR
+  /* Start the shared executor, before the services register on it */
+  err = serviceManagerExecutorInit();
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: failed to initialize the shared executor", err);
+    return err;
+  }
+#endif
+
   /* Start service manager thread */
   threadId = k_thread_create(&serviceManagerThread, serviceManagerStack,
                              CONFIG_ENYA_SERVICE_MANAGER_STACK_SIZE,
@@ -211,18 +327,27 @@ int serviceManagerInit(void)
   return 0;
 }
 
-int serviceManagerRegisterSrv(const ServiceDescriptor_t *descriptor)
+int serviceManagerRegisterSrv(const ServiceDescriptor_t *descriptor, ServiceHandle_t *handle)
 {
-  int err;
+  int index;
 
-  /* Add service to registry */
-  err = serviceMngrUtilAddSrvToRegistry(descriptor);
-  if(err < 0)
+  /* Validate handle pointer */
+  if(handle == NULL)
   {
-    LOG_ERR("ERROR %d: failed to register service", err);
-    return err;
+    LOG_ERR("ERROR %d: handle is NULL", -EINVAL);
+    return -EINVAL;
+  }
+
+  /* Add service to registry, its index being the handle */
+  index = serviceMngrUtilAddSrvToRegistry(descriptor);
+  if(index < 0)
+  {
+    LOG_ERR("ERROR %d: failed to register service", index);
+    return index;
   }
 
+  *handle = (ServiceHandle_t)index;
+
   LOG_DBG("service registered successfully");
 
   return 0;
@@ -231,25 +356,69 @@ int serviceManagerRegisterSrv(const ServiceDescriptor_t *descriptor)
 int serviceManagerStartAll(void)
 {
   int err;
+  int firstErr = 0;
+  bool isProgressing;
+  uint64_t pending = 0;
+  uint64_t failed = 0;
+  size_t index;
   ServiceDescriptor_t *descriptor;
 
-  for(ServicePriority_t priority = SVC_PRIORITY_CRITICAL; priority < SVC_PRIORITY_COUNT; priority++)
+  for(index = 0; serviceMngrUtilGetRegEntryByIndex(index) != NULL; index++)
+    pending |= BIT64(index);
+
+  /* Drop the confirmations given since the last start, only the new ones wake it up */
+  k_sem_reset(&runningConfirmSem);
+
+  while(pending != 0)
   {
-    for(size_t index = 0; (descriptor = serviceMngrUtilGetRegEntryByIndex(index)) != NULL; index++)
-    {
-      if(descriptor->priority != priority)
-        continue;
+    isProgressing = false;
 
-      err = serviceMngrUtilStartService(index);
-      if(err < 0)
+    for(ServicePriority_t priority = SVC_PRIORITY_CRITICAL; priority < SVC_PRIORITY_COUNT; priority++)
+    {
+      for(index = 0; (descriptor = serviceMngrUtilGetRegEntryByIndex(index)) != NULL; index++)
       {
-        LOG_ERR("ERROR %d: failed to start service %s", err,
-                k_thread_name_get(descriptor->threadId));
-        return err;
+        if(!(pending & BIT64(index)) || descriptor->priority != priority)
+          continue;
+
+        /* Skip the dependents of a failed service, wait on the unconfirmed dependencies */
+        if(descriptor->dependencies & failed)
+          err = -ECANCELED;
+        else if(serviceMngrUtilAreSrvsRunning(descriptor->dependencies))
+          err = serviceMngrUtilStartService(index);
+        else
+          continue;
+
+        pending &= ~BIT64(index);
+        isProgressing = true;
+
+        if(err < 0)
+        {
+          failed |= BIT64(index);
+          if(firstErr == 0)
+            firstErr = err;
+
+          LOG_ERR("ERROR %d: failed to start service %s", err,
+                  k_thread_name_get(descriptor->threadId));
+        }
       }
     }
+
+    /* Only the dependents are left, wait for a running confirmation */
+    if(pending != 0 && !isProgressing &&
+       k_sem_take(&runningConfirmSem, K_MSEC(CONFIG_SVC_MGR_START_TIMEOUT_MS)) < 0)
+    {
+      for(index = 0; (descriptor = serviceMngrUtilGetRegEntryByIndex(index)) != NULL; index++)
+        if(pending & BIT64(index))
+          LOG_ERR("ERROR %d: service %s dependencies not running", -ETIMEDOUT,
+                  k_thread_name_get(descriptor->threadId));
+
+      return firstErr < 0 ? firstErr : -ETIMEDOUT;
+    }
   }
 
+  if(firstErr < 0)
+    return firstErr;
+
   LOG_INF("all services started");
 
   return 0;
@@ -257,50 +426,62 @@ int serviceManagerStartAll(void)
 
 int serviceManagerRequestStart(k_tid_t threadId)
 {
-  return enqueueRequest(SVC_MGR_MSG_START, threadId);
+  return enqueueThreadRequest(SVC_MGR_MSG_START, threadId);
 }
 
 int serviceManagerRequestStop(k_tid_t threadId)
 {
-  return enqueueRequest(SVC_MGR_MSG_STOP, threadId);
+  return enqueueThreadRequest(SVC_MGR_MSG_STOP, threadId);
 }
 
 int serviceManagerRequestSuspend(k_tid_t threadId)
 {
-  return enqueueRequest(SVC_MGR_MSG_SUSPEND, threadId);
+  return enqueueThreadRequest(SVC_MGR_MSG_SUSPEND, threadId);
 }
 
 int serviceManagerRequestResume(k_tid_t threadId)
 {
-  return enqueueRequest(SVC_MGR_MSG_RESUME, threadId);
+  return enqueueThreadRequest(SVC_MGR_MSG_RESUME, threadId);
 }
 
-int serviceManagerConfirmState(k_tid_t threadId, ServiceState_t state)
+int serviceManagerRequestStartByHandle(ServiceHandle_t handle)
 {
-  int index;
+  return enqueueHandleRequest(SVC_MGR_MSG_START, handle);
+}
 
-  index = serviceMngrUtilGetIndexFromId(threadId);
-  if(index < 0)
-  {
-    LOG_ERR("ERROR %d: failed to find service by thread ID", index);
-    return index;
-  }
+int serviceManagerRequestStopByHandle(ServiceHandle_t handle)
+{
+  return enqueueHandleRequest(SVC_MGR_MSG_STOP, handle);
+}
 
-  return serviceMngrUtilSetSrvState((size_t)index, state);
+int serviceManagerRequestSuspendByHandle(ServiceHandle_t handle)
+{
+  return enqueueHandleRequest(SVC_MGR_MSG_SUSPEND, handle);
 }
 
-int serviceManagerUpdateHeartbeat(k_tid_t threadId)
+int serviceManagerRequestResumeByHandle(ServiceHandle_t handle)
 {
-  int index;
+  return enqueueHandleRequest(SVC_MGR_MSG_RESUME, handle);
+}
 
-  index = serviceMngrUtilGetIndexFromId(threadId);
-  if(index < 0)
-  {
-    LOG_ERR("ERROR %d: failed to find service by thread ID", index);
-    return index;
-  }
+int serviceManagerConfirmState(ServiceHandle_t handle, ServiceState_t state)
+{
+  int err;
+
+  err = serviceMngrUtilSetSrvState(handle, state);
+  if(err < 0)
+    return err;
 
-  return serviceMngrUtilUpdateSrvHeartbeat(index);
+  /* Wake up the services start waiting on dependencies */
+  if(state == SVC_STATE_RUNNING)
+    k_sem_give(&runningConfirmSem);
+
+  return 0;
+}
+
+int serviceManagerUpdateHeartbeat(ServiceHandle_t handle)
+{
+  return serviceMngrUtilUpdateSrvHeartbeat(handle);
 }
 
 /** @} */
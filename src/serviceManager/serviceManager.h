@@ -42,6 +42,27 @@ typedef enum
   SVC_PRIORITY_COUNT
 } ServicePriority_t;
 
+#ifdef CONFIG_SVC_MGR_STATS
+/**
+ * @brief   Service runtime statistics.
+ *
+ * @note    The CPU load and stack usage are sampled by the service manager
+ *          every CONFIG_SVC_MGR_STATS_PERIOD_MS, the jitter and suspended time
+ *          being accounted at each heartbeat and state change.
+ */
+typedef struct
+{
+  uint64_t lastCycles;                /**< Thread execution cycles at the last sample */
+  uint16_t cpuLoad;                   /**< CPU load over the last sample period, in permille */
+  uint16_t peakCpuLoad;               /**< Peak CPU load, in permille */
+  size_t stackSize;                   /**< Thread stack size in bytes */
+  size_t stackUsed;                   /**< Stack high-water mark in bytes */
+  uint32_t maxHeartbeatJitterMs;      /**< Worst heartbeat delay past its interval */
+  int64_t suspendedSinceMs;           /**< Suspension start timestamp */
+  uint64_t suspendedMs;               /**< Time spent suspended, up to the last suspension end */
+} ServiceStats_t;
+#endif
+
 /**
  * @brief   Service descriptor structure.
  */
@@ -50,15 +71,31 @@ typedef struct
   k_tid_t threadId;                   /**< Service thread ID */
   ServicePriority_t priority;         /**< Service priority level */
   uint32_t heartbeatIntervalMs;       /**< Heartbeat interval in milliseconds */
-  int64_t lastHeartbeatMs;            /**< Last heartbeat timestamp */
+  atomic_t lastHeartbeatMs;           /**< Last heartbeat uptime (wrapping 32-bit ms) */
   uint8_t missedHeartbeats;           /**< Missed heartbeat counter */
   ServiceState_t state;               /**< Current service state */
+  uint64_t dependencies;              /**< Handles of the services to be running first, as BIT64(handle) */
+  uint8_t maxRestarts;                /**< Restarts within the recovery window before the SoC reset, 0 for the SoC reset */
+  int64_t startTimeMs;                /**< Start timestamp */
+  uint32_t startLatencyMs;            /**< Start latency, up to the running confirmation */
+  bool isRunningConfirmed;            /**< Running state confirmed by the service */
+  uint8_t restartCount;               /**< Restarts within the current recovery window */
+  int64_t firstRestartMs;             /**< First restart timestamp of the current recovery window */
+#ifdef CONFIG_SVC_MGR_STATS
+  ServiceStats_t stats;               /**< Runtime statistics */
+#endif
   int (*start)(void);                 /**< Start notification callback */
   int (*stop)(void);                  /**< Stop notification callback */
   int (*suspend)(void);               /**< Suspend notification callback */
   int (*resume)(void);                /**< Resume notification callback */
+  int (*restart)(void);               /**< Restart callback, re-creating the service thread */
 } ServiceDescriptor_t;
 
+/**
+ * @brief   Service handle, returned at registration.
+ */
+typedef size_t ServiceHandle_t;
+
 /**
  * @brief   Initialize the service manager.
  *
@@ -74,83 +111,156 @@ int serviceManagerInit(void);
  * @brief   Register a service with the service manager.
  *
  *          Adds a service to the registry for monitoring and lifecycle management.
+ *          A service with maxRestarts is restarted through its restart callback
+ *          on a heartbeat timeout, the SoC being reset once its restarts within
+ *          CONFIG_SVC_MGR_RECOVERY_WINDOW_MS are exhausted. The critical
+ *          services always escalate to the SoC reset.
+ *
+ * @note    The ADC acquisition and LED strip services restart their thread.
+ *          The datastore keeps the SoC reset, an aborted request would drop
+ *          its waiting readers and could leave a datapoint partly written.
  *
  * @param[in]   descriptor: The service descriptor to register.
+ * @param[out]  handle: The service handle, used for its heartbeats and state confirmations.
  *
  * @return  0 if successful, the error code otherwise.
  */
-int serviceManagerRegisterSrv(const ServiceDescriptor_t *descriptor);
+int serviceManagerRegisterSrv(const ServiceDescriptor_t *descriptor, ServiceHandle_t *handle);
 
 /**
- * @brief   Start all registered services in priority order.
+ * @brief   Start all registered services in priority and dependency order.
  *
  *          Iterates through priority levels from critical to application,
- *          starting each registered service in order.
+ *          starting each registered service whose dependencies confirmed their
+ *          running state, without waiting on the others. The services left
+ *          waiting on dependencies are started as the confirmations arrive. A
+ *          failed service does not stop the others, its dependents being
+ *          skipped.
  *
- * @return  0 if successful, the error code otherwise.
+ * @return  0 if successful, the first error code otherwise, -ECANCELED for a
+ *          dependency failure, -ETIMEDOUT when dependencies did not confirm
+ *          their running state within CONFIG_SVC_MGR_START_TIMEOUT_MS.
  */
 int serviceManagerStartAll(void);
 
 /**
  * @brief   Request a service to start asynchronously.
  *
+ * @note    The services sharing a thread, like the executor ones, are
+ *          rejected, use serviceManagerRequestStartByHandle() for them.
+ *
  * @param[in]   threadId: The thread ID of the target service.
  *
- * @return  0 if successful, the error code otherwise.
+ * @return  0 if successful, -EINVAL for a shared thread ID, the error code
+ *          otherwise.
  */
 int serviceManagerRequestStart(k_tid_t threadId);
 
 /**
  * @brief   Request a service to stop asynchronously.
  *
+ * @note    The services sharing a thread, like the executor ones, are
+ *          rejected, use serviceManagerRequestStopByHandle() for them.
+ *
  * @param[in]   threadId: The thread ID of the target service.
  *
- * @return  0 if successful, the error code otherwise.
+ * @return  0 if successful, -EINVAL for a shared thread ID, the error code
+ *          otherwise.
  */
 int serviceManagerRequestStop(k_tid_t threadId);
 
 /**
  * @brief   Request a service to suspend asynchronously.
  *
+ * @note    The services sharing a thread, like the executor ones, are
+ *          rejected, use serviceManagerRequestSuspendByHandle() for them.
+ *
  * @param[in]   threadId: The thread ID of the target service.
  *
- * @return  0 if successful, the error code otherwise.
+ * @return  0 if successful, -EINVAL for a shared thread ID, the error code
+ *          otherwise.
  */
 int serviceManagerRequestSuspend(k_tid_t threadId);
 
 /**
  * @brief   Request a service to resume asynchronously.
  *
+ * @note    The services sharing a thread, like the executor ones, are
+ *          rejected, use serviceManagerRequestResumeByHandle() for them.
+ *
  * @param[in]   threadId: The thread ID of the target service.
  *
- * @return  0 if successful, the error code otherwise.
+ * @return  0 if successful, -EINVAL for a shared thread ID, the error code
+ *          otherwise.
  */
 int serviceManagerRequestResume(k_tid_t threadId);
 
+/**
+ * @brief   Request a service to start asynchronously, by handle.
+ *
+ * @param[in]   handle: The handle of the target service.
+ *
+ * @return  0 if successful, -EINVAL for an unknown handle, the error code
+ *          otherwise.
+ */
+int serviceManagerRequestStartByHandle(ServiceHandle_t handle);
+
+/**
+ * @brief   Request a service to stop asynchronously, by handle.
+ *
+ * @param[in]   handle: The handle of the target service.
+ *
+ * @return  0 if successful, -EINVAL for an unknown handle, the error code
+ *          otherwise.
+ */
+int serviceManagerRequestStopByHandle(ServiceHandle_t handle);
+
+/**
+ * @brief   Request a service to suspend asynchronously, by handle.
+ *
+ * @param[in]   handle: The handle of the target service.
+ *
+ * @return  0 if successful, -EINVAL for an unknown handle, the error code
+ *          otherwise.
+ */
+int serviceManagerRequestSuspendByHandle(ServiceHandle_t handle);
+
+/**
+ * @brief   Request a service to resume asynchronously, by handle.
+ *
+ * @param[in]   handle: The handle of the target service.
+ *
+ * @return  0 if successful, -EINVAL for an unknown handle, the error code
+ *          otherwise.
+ */
+int serviceManagerRequestResumeByHandle(ServiceHandle_t handle);
+
 /**
  * @brief   Confirm a state change for a service.
  *
  *          Called by the service itself after completing a STOP or SUSPEND state
  *          change. Must be called before k_thread_suspend() for SUSPEND, and
- *          before exiting the thread loop for STOP.
+ *          before exiting the thread loop for STOP. A service other services
+ *          depend on must also confirm RUNNING once its startup completes.
  *
- * @param[in]   threadId: The thread ID of the service confirming its state.
+ * @param[in]   handle: The handle of the service confirming its state.
  * @param[in]   state: The new confirmed state.
  *
  * @return  0 if successful, the error code otherwise.
  */
-int serviceManagerConfirmState(k_tid_t threadId, ServiceState_t state);
+int serviceManagerConfirmState(ServiceHandle_t handle, ServiceState_t state);
 
 /**
  * @brief   Update the heartbeat timestamp for a service.
  *
- *          Called by a service to signal it is still alive.
+ *          Called by a service to signal it is still alive. The heartbeat is a
+ *          single atomic timestamp store, whatever the registered service count.
  *
- * @param[in]   threadId: The thread ID of the service updating its heartbeat.
+ * @param[in]   handle: The handle of the service updating its heartbeat.
  *
  * @return  0 if successful, the error code otherwise.
  */
-int serviceManagerUpdateHeartbeat(k_tid_t threadId);
+int serviceManagerUpdateHeartbeat(ServiceHandle_t handle);
 
 #endif /* SERVICE_MANAGER_H */
 
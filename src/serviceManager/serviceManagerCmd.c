@@ -51,24 +51,67 @@ static int execLs(const struct shell *shell, size_t argc, char **argv)
   size_t index = 0;
   ServiceDescriptor_t *descriptor;
 
-  shell_print(shell, "%-5s %-20s %-12s %-10s %-15s %s",
-              "Index", "Name", "Priority", "State", "Heartbeat(ms)", "Missed");
+  shell_print(shell, "%-5s %-20s %-12s %-10s %-15s %-8s %s",
+              "Index", "Name", "Priority", "State", "Heartbeat(ms)", "Missed", "Start(ms)");
 
   while((descriptor = serviceMngrUtilGetRegEntryByIndex(index)) != NULL)
   {
-    shell_print(shell, "%-5zu %-20s %-12s %-10s %-15u %u",
+    shell_print(shell, "%-5zu %-20s %-12s %-10s %-15u %-8u %u",
                 index,
                 k_thread_name_get(descriptor->threadId),
                 svcPriorityStr[descriptor->priority],
                 svcStateStr[descriptor->state],
                 descriptor->heartbeatIntervalMs,
-                descriptor->missedHeartbeats);
+                descriptor->missedHeartbeats,
+                descriptor->startLatencyMs);
     index++;
   }
 
   return 0;
 }
 
+#ifdef CONFIG_SVC_MGR_STATS
+/**
+ * @brief   Execute the stats command.
+ *
+ * @param[in]   shell: The shell handle.
+ * @param[in]   argc: The count of arguments.
+ * @param[in]   argv: The vector of arguments.
+ *
+ * @return  Always returns 0.
+ */
+static int execStats(const struct shell *shell, size_t argc, char **argv)
+{
+  size_t index = 0;
+  int64_t suspendedMs;
+  ServiceDescriptor_t *descriptor;
+
+  shell_print(shell, "%-5s %-20s %-8s %-8s %-12s %-10s %-11s %s",
+              "Index", "Name", "CPU(%)", "Peak(%)", "Stack(B)", "Used(B)", "Jitter(ms)", "Suspended(ms)");
+
+  while((descriptor = serviceMngrUtilGetRegEntryByIndex(index)) != NULL)
+  {
+    /* Include the ongoing suspension */
+    suspendedMs = (int64_t)descriptor->stats.suspendedMs;
+    if(descriptor->state == SVC_STATE_SUSPENDED)
+      suspendedMs += k_uptime_get() - descriptor->stats.suspendedSinceMs;
+
+    shell_print(shell, "%-5zu %-20s %3u.%-4u %3u.%-4u %-12zu %-10zu %-11u %lld",
+                index,
+                k_thread_name_get(descriptor->threadId),
+                descriptor->stats.cpuLoad / 10, descriptor->stats.cpuLoad % 10,
+                descriptor->stats.peakCpuLoad / 10, descriptor->stats.peakCpuLoad % 10,
+                descriptor->stats.stackSize,
+                descriptor->stats.stackUsed,
+                descriptor->stats.maxHeartbeatJitterMs,
+                (long long)suspendedMs);
+    index++;
+  }
+
+  return 0;
+}
+#endif
+
 /**
  * @brief   Execute the start command.
  *
@@ -203,6 +246,7 @@ static int execResume(const struct shell *shell, size_t argc, char **argv)
 
 SHELL_STATIC_SUBCMD_SET_CREATE(svcMgr_sub,
   SHELL_CMD(ls, NULL, "List registered services.", execLs),
+  SHELL_COND_CMD(CONFIG_SVC_MGR_STATS, stats, NULL, "Show the service runtime statistics.", execStats),
   SHELL_CMD_ARG(start, NULL, "Start a service. Usage: start <index>", execStart, 2, 0),
   SHELL_CMD_ARG(stop, NULL, "Stop a service. Usage: stop <index>", execStop, 2, 0),
   SHELL_CMD_ARG(suspend, NULL, "Suspend a service. Usage: suspend <index>", execSuspend, 2, 0),
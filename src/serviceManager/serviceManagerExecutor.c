@@ -0,0 +1,141 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      serviceManagerExecutor.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Manager Shared Executor Implementation
+ *
+ *            Shared executor implementation. Each task is a poll work waiting
+ *            on its message queue, resubmitted after each run, the work queue
+ *            running the tasks to completion one after the other.
+ *
+ * @ingroup   serviceManager
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "serviceManager.h"
+#include "serviceManagerExecutor.h"
+
+LOG_MODULE_DECLARE(serviceManager, CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL);
+
+/**
+ * @brief   The executor thread stack area.
+ */
+K_THREAD_STACK_DEFINE(executorStack, CONFIG_SVC_MGR_EXECUTOR_STACK_SIZE);
+
+/**
+ * @brief   The executor work queue.
+ */
+static struct k_work_q executorQueue;
+
+/**
+ * @brief   Submit a task, waiting on its queue up to its period.
+ *
+ * @param[in,out]   task: The task.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int submitTask(ServiceExecutorTask_t *task)
+{
+  k_poll_event_init(&task->event, K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, task->queue);
+
+  return k_work_poll_submit_to_queue(&executorQueue, &task->work, &task->event, 1,
+                                     K_MSEC(task->periodMs));
+}
+
+/**
+ * @brief   Run a task.
+ *
+ * @param[in]   work: The poll work of the task.
+ */
+static void runTask(struct k_work *work)
+{
+  int err;
+  struct k_work_poll *pollWork = CONTAINER_OF(work, struct k_work_poll, work);
+  ServiceExecutorTask_t *task = CONTAINER_OF(pollWork, ServiceExecutorTask_t, work);
+
+  if(!atomic_get(&task->isRunning))
+    return;
+
+  /* Run a bounded batch of messages, the other tasks running in between */
+  for(size_t i = 0; i < CONFIG_SVC_MGR_EXECUTOR_BATCH_SIZE && atomic_get(&task->isRunning) &&
+      k_msgq_get(task->queue, task->msg, K_NO_WAIT) == 0; ++i)
+    task->handler(task->msg);
+
+  /* A run completing is the heartbeat of the service */
+  serviceManagerUpdateHeartbeat(task->handle);
+
+  if(!atomic_get(&task->isRunning))
+    return;
+
+  err = submitTask(task);
+  if(err < 0)
+    LOG_ERR("ERROR %d: unable to resubmit the executor task", err);
+}
+
+int serviceManagerExecutorInit(void)
+{
+  struct k_work_queue_config config = {.name = "svcExecutor"};
+
+  k_work_queue_init(&executorQueue);
+  k_work_queue_start(&executorQueue, executorStack, K_THREAD_STACK_SIZEOF(executorStack),
+                     K_PRIO_PREEMPT(CONFIG_SVC_MGR_EXECUTOR_THREAD_PRIORITY), &config);
+
+  LOG_INF("shared executor initialized");
+
+  return 0;
+}
+
+k_tid_t serviceManagerExecutorGetThreadId(void)
+{
+  return k_work_queue_thread_get(&executorQueue);
+}
+
+int serviceManagerExecutorTaskInit(ServiceExecutorTask_t *task, struct k_msgq *queue, void *msg,
+                                   ServiceExecutorHandler_t handler, uint32_t periodMs)
+{
+  if(!task || !queue || !msg || !handler || periodMs == 0)
+  {
+    LOG_ERR("ERROR %d: invalid executor task", -EINVAL);
+    return -EINVAL;
+  }
+
+  k_work_poll_init(&task->work, runTask);
+  task->queue    = queue;
+  task->msg      = msg;
+  task->handler  = handler;
+  task->periodMs = periodMs;
+  atomic_set(&task->isRunning, 0);
+
+  return 0;
+}
+
+int serviceManagerExecutorTaskStart(ServiceExecutorTask_t *task)
+{
+  int err;
+
+  atomic_set(&task->isRunning, 1);
+
+  err = submitTask(task);
+  if(err < 0)
+  {
+    atomic_set(&task->isRunning, 0);
+    LOG_ERR("ERROR %d: unable to submit the executor task", err);
+  }
+
+  return err;
+}
+
+void serviceManagerExecutorTaskStop(ServiceExecutorTask_t *task)
+{
+  atomic_set(&task->isRunning, 0);
+
+  /* Not pending while running, the run then completing without resubmitting */
+  k_work_poll_cancel(&task->work);
+}
+
+/** @} */
@@ -0,0 +1,107 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      serviceManagerExecutor.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Manager Shared Executor
+ *
+ *            Shared executor API. A service hands its message queue and
+ *            handler to the executor instead of owning a thread, its messages
+ *            being run to completion by a single shared work queue thread.
+ *
+ * @ingroup   serviceManager
+ * @{
+ */
+
+#ifndef SERVICE_MANAGER_EXECUTOR_H
+#define SERVICE_MANAGER_EXECUTOR_H
+
+#include <zephyr/kernel.h>
+
+#include "serviceManager.h"
+
+/**
+ * @brief   The executor task message handler.
+ *
+ * @param[in]   msg: The message read from the task queue.
+ */
+typedef void (*ServiceExecutorHandler_t)(void *msg);
+
+/**
+ * @brief   The executor task, running the messages of a service.
+ *
+ * @note    The fields are private to the executor, except the handle which
+ *          is set by registering the service with it.
+ */
+typedef struct
+{
+  struct k_work_poll work;            /**< The poll work, triggered by the queue */
+  struct k_poll_event event;          /**< The queue data available event */
+  struct k_msgq *queue;               /**< The service message queue */
+  void *msg;                          /**< The message buffer, of the queue message size */
+  ServiceExecutorHandler_t handler;   /**< The message handler */
+  uint32_t periodMs;                  /**< The maximum period between two runs */
+  ServiceHandle_t handle;             /**< The service handle, heartbeating at each run */
+  atomic_t isRunning;                 /**< The task running flag */
+} ServiceExecutorTask_t;
+
+/**
+ * @brief   Initialize the shared executor.
+ *
+ * @note    Called by serviceManagerInit().
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int serviceManagerExecutorInit(void);
+
+/**
+ * @brief   Get the shared executor thread ID.
+ *
+ * @note    The executor services register with this thread ID, which they
+ *          share. Their lifecycle requests go through their handle.
+ *
+ * @return  The executor thread ID.
+ */
+k_tid_t serviceManagerExecutorGetThreadId(void);
+
+/**
+ * @brief   Initialize an executor task.
+ *
+ * @param[out]  task: The task.
+ * @param[in]   queue: The service message queue.
+ * @param[in]   msg: The message buffer, of the queue message size.
+ * @param[in]   handler: The message handler.
+ * @param[in]   periodMs: The maximum period between two runs, shorter than
+ *                        the service heartbeat interval.
+ *
+ * @return  0 if successful, -EINVAL if an argument is NULL or periodMs is 0.
+ */
+int serviceManagerExecutorTaskInit(ServiceExecutorTask_t *task, struct k_msgq *queue, void *msg,
+                                   ServiceExecutorHandler_t handler, uint32_t periodMs);
+
+/**
+ * @brief   Start an executor task.
+ *
+ * @note    The task runs whenever its queue holds messages, and at least
+ *          every periodMs, the service heartbeating after each run.
+ *
+ * @param[in,out]   task: The task.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+int serviceManagerExecutorTaskStart(ServiceExecutorTask_t *task);
+
+/**
+ * @brief   Stop an executor task.
+ *
+ * @note    A run in progress completes, the task then staying idle until
+ *          started again. The queued messages are kept.
+ *
+ * @param[in,out]   task: The task.
+ */
+void serviceManagerExecutorTaskStop(ServiceExecutorTask_t *task);
+
+#endif /* SERVICE_MANAGER_EXECUTOR_H */
+
+/** @} */
@@ -0,0 +1,107 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      serviceManagerStats.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Manager Statistics Implementation
+ *
+ *            Per-service runtime statistics sampling implementation. The
+ *            statistics are kept in the registry entries, sampled by the
+ *            service manager thread.
+ *
+ * @ingroup   serviceManager
+ * @{
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "serviceManager.h"
+#include "serviceManagerUtil.h"
+#include "serviceManagerStats.h"
+
+LOG_MODULE_DECLARE(serviceManager, CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL);
+
+/**
+ * @brief   The cycles executed by all the threads at the last sample.
+ */
+static uint64_t lastAllCycles = 0;
+
+/**
+ * @brief   Sample the statistics of a service.
+ *
+ * @param[in,out]   descriptor: The registry entry of the service.
+ * @param[in]       windowCycles: The cycles executed since the last sample.
+ *
+ * @return  0 if successful, the error code otherwise.
+ */
+static int sampleSrvStats(ServiceDescriptor_t *descriptor, uint64_t windowCycles)
+{
+  int err;
+  size_t unused;
+  k_thread_runtime_stats_t threadStats;
+  ServiceStats_t *stats = &descriptor->stats;
+
+  err = k_thread_runtime_stats_get(descriptor->threadId, &threadStats);
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: unable to get the runtime stats of %s", err,
+            k_thread_name_get(descriptor->threadId));
+    return err;
+  }
+
+  if(windowCycles > 0)
+  {
+    stats->cpuLoad = (uint16_t)MIN((threadStats.execution_cycles - stats->lastCycles) * 1000 /
+                                   windowCycles, 1000);
+    stats->peakCpuLoad = MAX(stats->peakCpuLoad, stats->cpuLoad);
+  }
+  stats->lastCycles = threadStats.execution_cycles;
+
+  /* The unused stack is the untouched part of its initial fill */
+  err = k_thread_stack_space_get(descriptor->threadId, &unused);
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: unable to get the stack space of %s", err,
+            k_thread_name_get(descriptor->threadId));
+    return err;
+  }
+
+  stats->stackSize = descriptor->threadId->stack_info.size;
+  stats->stackUsed = stats->stackSize - unused;
+
+  return 0;
+}
+
+int serviceMngrStatsSample(void)
+{
+  int err;
+  int srvErr;
+  size_t index;
+  uint64_t windowCycles;
+  k_thread_runtime_stats_t allStats;
+  ServiceDescriptor_t *descriptor;
+
+  err = k_thread_runtime_stats_all_get(&allStats);
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: unable to get the runtime stats", err);
+    return err;
+  }
+
+  windowCycles = allStats.execution_cycles - lastAllCycles;
+  lastAllCycles = allStats.execution_cycles;
+
+  /* A failed service does not stop the sampling of the others */
+  for(index = 0; (descriptor = serviceMngrUtilGetRegEntryByIndex(index)) != NULL; index++)
+  {
+    srvErr = sampleSrvStats(descriptor, windowCycles);
+    if(srvErr < 0 && err == 0)
+      err = srvErr;
+  }
+
+  return err;
+}
+
+/** @} */
@@ -0,0 +1,32 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      serviceManagerStats.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Manager Statistics
+ *
+ *            Per-service runtime statistics sampling, from the Zephyr thread
+ *            runtime statistics and stack analysis.
+ *
+ * @ingroup   serviceManager
+ * @{
+ */
+
+#ifndef SERVICE_MANAGER_STATS_H
+#define SERVICE_MANAGER_STATS_H
+
+/**
+ * @brief   Sample the CPU load and stack usage of the registered services.
+ *
+ * @note    The CPU load is the share of the cycles executed by each service
+ *          since the previous sample. A failed service does not stop the
+ *          sampling of the others.
+ *
+ * @return  0 if successful, the first error code otherwise.
+ */
+int serviceMngrStatsSample(void);
+
+#endif /* SERVICE_MANAGER_STATS_H */
+
+/** @} */
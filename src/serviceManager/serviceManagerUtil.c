@@ -32,6 +32,26 @@ static int wdgChannel = -1;
 static ServiceDescriptor_t serviceRegistry[CONFIG_SVC_MGR_MAX_SERVICES];
 static size_t registeredServiceCount = 0;
 
+/**
+ * @brief   Set the state of a service.
+ *
+ * @note    The time spent suspended is accounted when the statistics are enabled.
+ *
+ * @param[in,out]   entry: The registry entry of the service.
+ * @param[in]       state: The new state.
+ */
+static void setState(ServiceDescriptor_t *entry, ServiceState_t state)
+{
+#ifdef CONFIG_SVC_MGR_STATS
+  if(entry->state != SVC_STATE_SUSPENDED && state == SVC_STATE_SUSPENDED)
+    entry->stats.suspendedSinceMs = k_uptime_get();
+  else if(entry->state == SVC_STATE_SUSPENDED && state != SVC_STATE_SUSPENDED)
+    entry->stats.suspendedMs += k_uptime_get() - entry->stats.suspendedSinceMs;
+#endif
+
+  entry->state = state;
+}
+
 int serviceMngrUtilInitHardWdg(void)
 {
   int err;
@@ -113,13 +133,36 @@ int serviceMngrUtilAddSrvToRegistry(const ServiceDescriptor_t *descriptor)
     return -EINVAL;
   }
 
+  /* The critical services keep the SoC reset, the others needing a restart callback */
+  if(descriptor->maxRestarts > 0 &&
+     (descriptor->priority == SVC_PRIORITY_CRITICAL || descriptor->restart == NULL))
+  {
+    LOG_ERR("ERROR %d: invalid restart policy", -EINVAL);
+    return -EINVAL;
+  }
+
+  /* Only depending on registered services keeps the dependency graph acyclic */
+  if(descriptor->dependencies & ~(BIT64(registeredServiceCount) - 1))
+  {
+    LOG_ERR("ERROR %d: dependency on an unregistered service", -EINVAL);
+    return -EINVAL;
+  }
+
   /* Add service to registry */
   memcpy(&serviceRegistry[registeredServiceCount], descriptor, sizeof(ServiceDescriptor_t));
 
   /* Initialize runtime fields */
-  serviceRegistry[registeredServiceCount].lastHeartbeatMs = 0;
+  atomic_set(&serviceRegistry[registeredServiceCount].lastHeartbeatMs, 0);
   serviceRegistry[registeredServiceCount].missedHeartbeats = 0;
   serviceRegistry[registeredServiceCount].state = SVC_STATE_STOPPED;
+  serviceRegistry[registeredServiceCount].startTimeMs = 0;
+  serviceRegistry[registeredServiceCount].startLatencyMs = 0;
+  serviceRegistry[registeredServiceCount].isRunningConfirmed = false;
+  serviceRegistry[registeredServiceCount].restartCount = 0;
+  serviceRegistry[registeredServiceCount].firstRestartMs = 0;
+#ifdef CONFIG_SVC_MGR_STATS
+  memset(&serviceRegistry[registeredServiceCount].stats, 0, sizeof(ServiceStats_t));
+#endif
 
   registeredServiceCount++;
 
@@ -127,7 +170,7 @@ int serviceMngrUtilAddSrvToRegistry(const ServiceDescriptor_t *descriptor)
           k_thread_name_get(descriptor->threadId), descriptor->priority,
           descriptor->heartbeatIntervalMs, registeredServiceCount);
 
-  return 0;
+  return (int)(registeredServiceCount - 1);
 }
 
 ServiceDescriptor_t *serviceMngrUtilGetRegEntryByIndex(size_t index)
@@ -140,6 +183,8 @@ ServiceDescriptor_t *serviceMngrUtilGetRegEntryByIndex(size_t index)
 
 int serviceMngrUtilGetIndexFromId(k_tid_t threadId)
 {
+  int index = -ENOENT;
+
   /* Validate thread ID */
   if(threadId == NULL)
   {
@@ -152,17 +197,26 @@ int serviceMngrUtilGetIndexFromId(k_tid_t threadId)
   {
     if(serviceRegistry[i].threadId == threadId)
     {
-      return (int)i;
+      if(index >= 0)
+      {
+        LOG_ERR("ERROR %d: thread ID shared by several services", -EINVAL);
+        return -EINVAL;
+      }
+
+      index = (int)i;
     }
   }
 
-  LOG_ERR("ERROR %d: thread ID not found in registry", -ENOENT);
-  return -ENOENT;
+  if(index < 0)
+    LOG_ERR("ERROR %d: thread ID not found in registry", -ENOENT);
+
+  return index;
 }
 
 int serviceMngrUtilStartService(size_t index)
 {
   int err;
+  int64_t now;
 
   /* Validate index */
   if(index >= registeredServiceCount)
@@ -178,7 +232,9 @@ int serviceMngrUtilStartService(size_t index)
     return -EINVAL;
   }
 
-  /* Call start callback */
+  /* Call start callback, the latency running up to the running confirmation */
+  serviceRegistry[index].isRunningConfirmed = false;
+  serviceRegistry[index].startTimeMs = k_uptime_get();
   err = serviceRegistry[index].start();
   if(err < 0)
   {
@@ -186,8 +242,12 @@ int serviceMngrUtilStartService(size_t index)
     return err;
   }
 
-  /* Update service state */
-  serviceRegistry[index].state = SVC_STATE_RUNNING;
+  /* Update service state, the heartbeat interval starting now */
+  now = k_uptime_get();
+  setState(&serviceRegistry[index], SVC_STATE_RUNNING);
+  atomic_set(&serviceRegistry[index].lastHeartbeatMs, (atomic_val_t)(uint32_t)now);
+  serviceRegistry[index].missedHeartbeats = 0;
+  serviceRegistry[index].startLatencyMs = (uint32_t)(now - serviceRegistry[index].startTimeMs);
 
   LOG_INF("service started: %s", k_thread_name_get(serviceRegistry[index].threadId));
 
@@ -282,14 +342,67 @@ int serviceMngrUtilResumeService(size_t index)
     return err;
   }
 
-  /* Update service state */
-  serviceRegistry[index].state = SVC_STATE_RUNNING;
+  /* Update service state, the heartbeat interval starting now */
+  setState(&serviceRegistry[index], SVC_STATE_RUNNING);
+  atomic_set(&serviceRegistry[index].lastHeartbeatMs, (atomic_val_t)(uint32_t)k_uptime_get());
+  serviceRegistry[index].missedHeartbeats = 0;
 
   LOG_INF("service resumed: %s", k_thread_name_get(serviceRegistry[index].threadId));
 
   return 0;
 }
 
+int serviceMngrUtilRecoverService(size_t index)
+{
+  int err;
+  int64_t now;
+  ServiceDescriptor_t *entry;
+
+  /* Validate index */
+  if(index >= registeredServiceCount)
+  {
+    LOG_ERR("ERROR %d: index out of bounds", -EINVAL);
+    return -EINVAL;
+  }
+
+  entry = &serviceRegistry[index];
+  if(entry->maxRestarts == 0)
+    return -ENOTSUP;
+
+  /* The restarts are counted within the recovery window of the first one */
+  now = k_uptime_get();
+  if(entry->restartCount > 0 && now - entry->firstRestartMs >= CONFIG_SVC_MGR_RECOVERY_WINDOW_MS)
+    entry->restartCount = 0;
+
+  if(entry->restartCount >= entry->maxRestarts)
+  {
+    LOG_ERR("ERROR %d: service %s restarts exhausted", -EBUSY, k_thread_name_get(entry->threadId));
+    return -EBUSY;
+  }
+
+  if(entry->restartCount == 0)
+    entry->firstRestartMs = now;
+  entry->restartCount++;
+
+  LOG_WRN("restarting service %s (restart %d of %d)", k_thread_name_get(entry->threadId),
+          entry->restartCount, entry->maxRestarts);
+
+  /* Call restart callback */
+  err = entry->restart();
+  if(err < 0)
+  {
+    LOG_ERR("ERROR %d: service restart callback failed", err);
+    return err;
+  }
+
+  /* Update service state, the heartbeat interval starting now */
+  setState(entry, SVC_STATE_RUNNING);
+  atomic_set(&entry->lastHeartbeatMs, (atomic_val_t)(uint32_t)k_uptime_get());
+  entry->missedHeartbeats = 0;
+
+  return 0;
+}
+
 int serviceMngrUtilSetSrvState(size_t index, ServiceState_t state)
 {
   /* Validate index */
@@ -299,12 +412,22 @@ int serviceMngrUtilSetSrvState(size_t index, ServiceState_t state)
     return -EINVAL;
   }
 
-  serviceRegistry[index].state = state;
+  setState(&serviceRegistry[index], state);
+
+  /* The first running confirmation after a start ends its latency */
+  if(state == SVC_STATE_RUNNING && !serviceRegistry[index].isRunningConfirmed)
+  {
+    serviceRegistry[index].isRunningConfirmed = true;
+    serviceRegistry[index].startLatencyMs = (uint32_t)(k_uptime_get() - serviceRegistry[index].startTimeMs);
+    LOG_INF("service running: %s (start latency: %u ms)",
+            k_thread_name_get(serviceRegistry[index].threadId),
+            serviceRegistry[index].startLatencyMs);
+  }
 
   /* Reset heartbeat tracking when leaving running state */
   if(state != SVC_STATE_RUNNING)
   {
-    serviceRegistry[index].lastHeartbeatMs = k_uptime_get();
+    atomic_set(&serviceRegistry[index].lastHeartbeatMs, (atomic_val_t)(uint32_t)k_uptime_get());
     serviceRegistry[index].missedHeartbeats = 0;
   }
 
@@ -314,8 +437,28 @@ int serviceMngrUtilSetSrvState(size_t index, ServiceState_t state)
   return 0;
 }
 
+bool serviceMngrUtilAreSrvsRunning(uint64_t handles)
+{
+  for(size_t index = 0; handles != 0; index++, handles >>= 1)
+  {
+    if(!(handles & 1))
+      continue;
+
+    if(index >= registeredServiceCount || serviceRegistry[index].state != SVC_STATE_RUNNING ||
+       !serviceRegistry[index].isRunningConfirmed)
+      return false;
+  }
+
+  return true;
+}
+
 int serviceMngrUtilUpdateSrvHeartbeat(size_t index)
 {
+  uint32_t now;
+#ifdef CONFIG_SVC_MGR_STATS
+  int32_t late;
+#endif
+
   /* Validate index */
   if(index >= registeredServiceCount)
   {
@@ -323,20 +466,45 @@ int serviceMngrUtilUpdateSrvHeartbeat(size_t index)
     return -EINVAL;
   }
 
-  /* Update heartbeat timestamp and reset missed count */
-  serviceRegistry[index].lastHeartbeatMs = k_uptime_get();
-  serviceRegistry[index].missedHeartbeats = 0;
+  now = (uint32_t)k_uptime_get();
 
-  LOG_DBG("heartbeat updated (name: %s, time: %lld ms)",
-          k_thread_name_get(serviceRegistry[index].threadId),
-          serviceRegistry[index].lastHeartbeatMs);
+#ifdef CONFIG_SVC_MGR_STATS
+  /* The jitter is the heartbeat delay past its interval, wrap-safe */
+  late = (int32_t)(now - (uint32_t)atomic_get(&serviceRegistry[index].lastHeartbeatMs)) -
+         (int32_t)serviceRegistry[index].heartbeatIntervalMs;
+  if(serviceRegistry[index].state == SVC_STATE_RUNNING &&
+     late > (int32_t)serviceRegistry[index].stats.maxHeartbeatJitterMs)
+    serviceRegistry[index].stats.maxHeartbeatJitterMs = (uint32_t)late;
+#endif
+
+  /* Store the heartbeat timestamp, the missed count following at the next check */
+  atomic_set(&serviceRegistry[index].lastHeartbeatMs, (atomic_val_t)now);
 
   return 0;
 }
 
+/**
+ * @brief   Get the time elapsed since the last heartbeat of a service.
+ *
+ * @param[in]   entry: The registry entry of the service.
+ * @param[in]   now: The current uptime in milliseconds.
+ *
+ * @return  The elapsed time in milliseconds, 0 for a heartbeat newer than now.
+ */
+static uint32_t getElapsedMs(const ServiceDescriptor_t *entry, int64_t now)
+{
+  int32_t elapsed;
+
+  /* Wrap-safe difference of the 32-bit timestamps */
+  elapsed = (int32_t)((uint32_t)now - (uint32_t)atomic_get(&entry->lastHeartbeatMs));
+
+  return elapsed > 0 ? (uint32_t)elapsed : 0;
+}
+
 int serviceMngrUtilCheckSrvHeartbeat(size_t index)
 {
-  int64_t elapsed;
+  uint32_t missed;
+  uint8_t previous;
 
   /* Validate index */
   if(index >= registeredServiceCount)
@@ -349,11 +517,13 @@ int serviceMngrUtilCheckSrvHeartbeat(size_t index)
   if(serviceRegistry[index].state != SVC_STATE_RUNNING)
     return 0;
 
-  /* Check if heartbeat interval has elapsed */
-  elapsed = k_uptime_get() - serviceRegistry[index].lastHeartbeatMs;
-  if(elapsed >= serviceRegistry[index].heartbeatIntervalMs)
+  /* Count one missed heartbeat per elapsed interval, whatever the check rate */
+  missed = getElapsedMs(&serviceRegistry[index], k_uptime_get()) /
+           serviceRegistry[index].heartbeatIntervalMs;
+  previous = serviceRegistry[index].missedHeartbeats;
+  serviceRegistry[index].missedHeartbeats = (uint8_t)MIN(missed, UINT8_MAX);
+  if(serviceRegistry[index].missedHeartbeats > previous)
   {
-    serviceRegistry[index].missedHeartbeats++;
     LOG_WRN("missed heartbeat (service: %s, missed: %d)",
             k_thread_name_get(serviceRegistry[index].threadId),
             serviceRegistry[index].missedHeartbeats);
@@ -370,6 +540,29 @@ int serviceMngrUtilCheckSrvHeartbeat(size_t index)
   return serviceRegistry[index].missedHeartbeats;
 }
 
+int64_t serviceMngrUtilGetNextHeartbeatDeadline(void)
+{
+  int64_t now;
+  int64_t deadline;
+  uint32_t interval;
+  int64_t nextDeadline = INT64_MAX;
+
+  now = k_uptime_get();
+
+  for(size_t index = 0; index < registeredServiceCount; index++)
+  {
+    if(serviceRegistry[index].state != SVC_STATE_RUNNING)
+      continue;
+
+    /* The next missed heartbeat is due at the end of the current interval */
+    interval = serviceRegistry[index].heartbeatIntervalMs;
+    deadline = now + interval - getElapsedMs(&serviceRegistry[index], now) % interval;
+    nextDeadline = MIN(nextDeadline, deadline);
+  }
+
+  return nextDeadline;
+}
+
 int serviceMngrUtilFeedHardWdg(void)
 {
   int err;
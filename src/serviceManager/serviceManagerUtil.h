@@ -34,7 +34,7 @@ int serviceMngrUtilInitSrvRegistry(void);
  *
  * @param[in]   descriptor: The service descriptor to add.
  *
- * @return  0 if successful, the error code otherwise.
+ * @return  The registry index if successful, the error code otherwise.
  */
 int serviceMngrUtilAddSrvToRegistry(const ServiceDescriptor_t *descriptor);
 
@@ -50,9 +50,13 @@ ServiceDescriptor_t *serviceMngrUtilGetRegEntryByIndex(size_t index);
 /**
  * @brief   Get the registry index from a thread ID.
  *
+ * @note    A thread ID shared by several services, like the shared executor
+ *          one, does not identify a service and is rejected.
+ *
  * @param[in]   threadId: The thread ID to search for.
  *
- * @return  The index if found, error code otherwise.
+ * @return  The index if found, -EINVAL for a NULL or shared thread ID,
+ *          -ENOENT if not found.
  */
 int serviceMngrUtilGetIndexFromId(k_tid_t threadId);
 
@@ -92,6 +96,20 @@ int serviceMngrUtilSuspendService(size_t index);
  */
 int serviceMngrUtilResumeService(size_t index);
 
+/**
+ * @brief   Recover a service from a heartbeat timeout.
+ *
+ *          Restarts the service through its restart callback, up to its
+ *          maxRestarts within CONFIG_SVC_MGR_RECOVERY_WINDOW_MS.
+ *
+ * @param[in]   index: The registry index of the service.
+ *
+ * @return  0 if the service was restarted, -ENOTSUP if it escalates to the
+ *          SoC reset, -EBUSY if its restarts are exhausted, the error code
+ *          otherwise.
+ */
+int serviceMngrUtilRecoverService(size_t index);
+
 /**
  * @brief   Set the state of a service in the registry.
  *
@@ -102,8 +120,19 @@ int serviceMngrUtilResumeService(size_t index);
  */
 int serviceMngrUtilSetSrvState(size_t index, ServiceState_t state);
 
+/**
+ * @brief   Check if services confirmed their running state since their start.
+ *
+ * @param[in]   handles: The service handles, as BIT64(handle).
+ *
+ * @return  True if all the services are running and confirmed it, false otherwise.
+ */
+bool serviceMngrUtilAreSrvsRunning(uint64_t handles);
+
 /**
  * @brief   Update the heartbeat timestamp for a service.
+ *          The timestamp is stored atomically, the missed heartbeat count
+ *          being derived from it at the next check.
  *
  * @param[in]   index: The registry index of the service.
  *
@@ -113,7 +142,9 @@ int serviceMngrUtilUpdateSrvHeartbeat(size_t index);
 
 /**
  * @brief   Check if a service has missed its heartbeat interval.
- *          Increments the missed heartbeat count if the interval has elapsed.
+ *          Counts one missed heartbeat per heartbeat interval elapsed since
+ *          the last heartbeat, repeated checks within an interval not adding
+ *          to the count.
  *
  * @param[in]   index: The registry index of the service.
  *
@@ -121,6 +152,14 @@ int serviceMngrUtilUpdateSrvHeartbeat(size_t index);
  */
 int serviceMngrUtilCheckSrvHeartbeat(size_t index);
 
+/**
+ * @brief   Get the next heartbeat deadline of the running services.
+ *
+ * @return  The earliest uptime, in milliseconds, at which a running service
+ *          misses its next heartbeat, INT64_MAX if no service is running.
+ */
+int64_t serviceMngrUtilGetNextHeartbeatDeadline(void);
+
 /**
  * @brief   Feed the hardware watchdog.
  *
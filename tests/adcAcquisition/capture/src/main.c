@@ -0,0 +1,309 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     ADC Acquisition Capture Unit Tests
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock k_malloc function */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+
+/* List of fakes for easy reset */
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(k_malloc)
+
+/* Prevent adcAcquisitionUtil.h inclusion and provide needed macros */
+#define ADC_ACQUISITION_UTIL
+#define ADC_AQC_SERVICE_NAME adcAcquisition
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT 4
+
+/* Include capture header */
+#include "adcAcquisitionCapture.h"
+
+/* Setup logging before including capture implementation */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(adcAcquisition, LOG_LEVEL_DBG);
+
+/* Redefine LOG_MODULE_DECLARE to prevent redefinition when capture includes logging.h */
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+#include "adcAcquisitionCapture.c"
+
+/* The test channel count */
+#define TEST_CHAN_COUNT 2
+
+/* Fixture for tests that need an initialized capture */
+struct adc_capture_tests_fixture
+{
+  uint16_t capture_memory[CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT * TEST_CHAN_COUNT];
+};
+
+static struct adc_capture_tests_fixture testFixture;
+
+static void *capture_setup(void)
+{
+  return &testFixture;
+}
+
+static void capture_before(void *f)
+{
+  int err;
+
+  ARG_UNUSED(f);
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(testFixture.capture_memory, 0, sizeof(testFixture.capture_memory));
+  k_malloc_fake.return_val = testFixture.capture_memory;
+
+  err = adcAcqCaptureInit(TEST_CHAN_COUNT);
+  zassume_equal(err, 0, "Capture init should succeed");
+}
+
+/* Arm the capture with a trigger */
+static void armCapture(AdcCaptureTrigMode_t mode, size_t chanId, uint16_t level)
+{
+  AdcCaptureTrigger_t trigger = {.mode = mode, .chanId = chanId, .level = level};
+
+  zassert_equal(adcAcqCaptureArm(&trigger), 0, "Arming the capture should succeed");
+}
+
+/**
+ * @test adcAcqCaptureInit must return -ENOSPC when the allocation fails
+ */
+ZTEST_F(adc_capture_tests, test_init_alloc_failure)
+{
+  k_malloc_fake.return_val = NULL;
+
+  zassert_equal(adcAcqCaptureInit(TEST_CHAN_COUNT), -ENOSPC,
+                "Init should return -ENOSPC when allocation fails");
+}
+
+/**
+ * @test adcAcqCaptureInit must allocate the buffer of all capture scans
+ */
+ZTEST_F(adc_capture_tests, test_init_alloc_size)
+{
+  zassert_equal(k_malloc_fake.arg0_val,
+                CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT * TEST_CHAN_COUNT * sizeof(uint16_t),
+                "Init should allocate all the capture scans");
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_IDLE,
+                "The capture should start idle");
+}
+
+/**
+ * @test adcAcqCaptureArm must reject invalid triggers
+ */
+ZTEST_F(adc_capture_tests, test_arm_invalid_trigger)
+{
+  AdcCaptureTrigger_t badMode = {.mode = ADC_CAPTURE_TRIG_COUNT};
+  AdcCaptureTrigger_t badChan = {.mode = ADC_CAPTURE_TRIG_ABOVE, .chanId = TEST_CHAN_COUNT};
+
+  zassert_equal(adcAcqCaptureArm(NULL), -EINVAL, "NULL trigger should return -EINVAL");
+  zassert_equal(adcAcqCaptureArm(&badMode), -EINVAL, "Invalid mode should return -EINVAL");
+  zassert_equal(adcAcqCaptureArm(&badChan), -EINVAL, "Invalid channel should return -EINVAL");
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_IDLE,
+                "The capture should stay idle");
+}
+
+/**
+ * @test adcAcqCaptureArm must return -ENODEV when the capture is not
+ * initialized
+ */
+ZTEST_F(adc_capture_tests, test_arm_not_initialized)
+{
+  AdcCaptureTrigger_t trigger = {.mode = ADC_CAPTURE_TRIG_NOW};
+
+  captureBuf = NULL;
+
+  zassert_equal(adcAcqCaptureArm(&trigger), -ENODEV,
+                "Arming without buffer should return -ENODEV");
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_IDLE,
+                "The capture should stay idle");
+}
+
+/**
+ * @test adcAcqCapturePushBlock must return -EINVAL with a NULL block
+ */
+ZTEST_F(adc_capture_tests, test_push_block_null)
+{
+  zassert_equal(adcAcqCapturePushBlock(NULL, 1), -EINVAL,
+                "NULL block should return -EINVAL");
+}
+
+/**
+ * @test adcAcqCapturePushBlock must ignore the scans while idle
+ */
+ZTEST_F(adc_capture_tests, test_push_block_idle)
+{
+  const uint16_t block[] = {1, 2, 3, 4};
+
+  zassert_equal(adcAcqCapturePushBlock(block, 2), 0, "Push should succeed");
+  zassert_equal(adcAcqCaptureGetScanCount(), 0, "No scan should be captured");
+  zassert_equal(fixture->capture_memory[0], 0, "The buffer should be untouched");
+}
+
+/**
+ * @test An immediate capture must record from the first scan until full
+ */
+ZTEST_F(adc_capture_tests, test_capture_now)
+{
+  const uint16_t block[] = {1, 2, 3, 4, 5, 6};
+  const uint16_t *data;
+  size_t scanCount;
+
+  armCapture(ADC_CAPTURE_TRIG_NOW, 0, 0);
+
+  adcAcqCapturePushBlock(block, 3);
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_RUNNING,
+                "The capture should be running");
+  zassert_equal(adcAcqCaptureGetData(&data, &scanCount), -ENODATA,
+                "The data should not be available while running");
+
+  /* Only the first scan fits, the remaining ones are dropped */
+  adcAcqCapturePushBlock(block, 3);
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_DONE,
+                "The capture should be done");
+  zassert_equal(adcAcqCaptureGetScanCount(), CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT,
+                "The capture should be full");
+
+  zassert_equal(adcAcqCaptureGetData(&data, &scanCount), 0, "Getting the data should succeed");
+  zassert_equal(data, fixture->capture_memory, "The data should be the capture buffer");
+  zassert_equal(scanCount, CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT,
+                "The scan count should be the capture length");
+  zassert_equal(data[6], 1, "The fourth scan should be the first scan of the second block");
+  zassert_equal(data[7], 2, "The fourth scan should be the first scan of the second block");
+}
+
+/**
+ * @test A level trigger must start at the first scan above the level
+ */
+ZTEST_F(adc_capture_tests, test_capture_above)
+{
+  const uint16_t block[] = {900, 10, 100, 20, 1000, 30, 50, 40};
+
+  armCapture(ADC_CAPTURE_TRIG_ABOVE, 1, 25);
+
+  adcAcqCapturePushBlock(block, 4);
+
+  zassert_equal(adcAcqCaptureGetScanCount(), 2, "Two scans should be captured");
+  zassert_equal(fixture->capture_memory[0], 1000, "The capture should start at the trigger scan");
+  zassert_equal(fixture->capture_memory[1], 30, "The capture should start at the trigger scan");
+}
+
+/**
+ * @test A level trigger must start at the first scan below the level
+ */
+ZTEST_F(adc_capture_tests, test_capture_below)
+{
+  const uint16_t block[] = {900, 0, 100, 0, 1000, 0};
+
+  armCapture(ADC_CAPTURE_TRIG_BELOW, 0, 500);
+
+  adcAcqCapturePushBlock(block, 3);
+
+  zassert_equal(adcAcqCaptureGetScanCount(), 2, "Two scans should be captured");
+  zassert_equal(fixture->capture_memory[0], 100, "The capture should start at the trigger scan");
+}
+
+/**
+ * @test A rising edge trigger must wait for the level to be crossed
+ */
+ZTEST_F(adc_capture_tests, test_capture_rising)
+{
+  const uint16_t first[] = {600, 0};
+  const uint16_t second[] = {400, 0, 700, 0};
+
+  armCapture(ADC_CAPTURE_TRIG_RISING, 0, 500);
+
+  /* Already above the level, not an edge */
+  adcAcqCapturePushBlock(first, 1);
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_ARMED,
+                "The capture should still be armed");
+
+  /* The edge spans two scans of the block */
+  adcAcqCapturePushBlock(second, 2);
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_RUNNING,
+                "The capture should be running");
+  zassert_equal(adcAcqCaptureGetScanCount(), 1, "One scan should be captured");
+  zassert_equal(fixture->capture_memory[0], 700, "The capture should start at the edge");
+}
+
+/**
+ * @test A falling edge trigger must fire across blocks
+ */
+ZTEST_F(adc_capture_tests, test_capture_falling)
+{
+  const uint16_t first[] = {0, 600};
+  const uint16_t second[] = {0, 400};
+
+  armCapture(ADC_CAPTURE_TRIG_FALLING, 1, 500);
+
+  adcAcqCapturePushBlock(first, 1);
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_ARMED,
+                "The capture should still be armed");
+
+  adcAcqCapturePushBlock(second, 1);
+  zassert_equal(adcAcqCaptureGetScanCount(), 1, "One scan should be captured");
+  zassert_equal(fixture->capture_memory[1], 400, "The capture should start at the edge");
+}
+
+/**
+ * @test Arming again must discard the previous capture
+ */
+ZTEST_F(adc_capture_tests, test_rearm_discards)
+{
+  const uint16_t block[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  const uint16_t *data;
+  size_t scanCount;
+
+  armCapture(ADC_CAPTURE_TRIG_NOW, 0, 0);
+  adcAcqCapturePushBlock(block, 4);
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_DONE, "The capture should be done");
+
+  armCapture(ADC_CAPTURE_TRIG_ABOVE, 0, 1000);
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_ARMED, "The capture should be armed");
+  zassert_equal(adcAcqCaptureGetScanCount(), 0, "The previous scans should be discarded");
+  zassert_equal(adcAcqCaptureGetData(&data, &scanCount), -ENODATA,
+                "The previous data should not be available");
+}
+
+/**
+ * @test adcAcqCaptureAbort must stop the capture
+ */
+ZTEST_F(adc_capture_tests, test_abort)
+{
+  const uint16_t block[] = {1, 2};
+
+  armCapture(ADC_CAPTURE_TRIG_NOW, 0, 0);
+  adcAcqCaptureAbort();
+  adcAcqCapturePushBlock(block, 1);
+
+  zassert_equal(adcAcqCaptureGetState(), ADC_CAPTURE_IDLE, "The capture should be idle");
+  zassert_equal(adcAcqCaptureGetScanCount(), 0, "No scan should be captured");
+}
+
+/**
+ * @test adcAcqCaptureGetData must return -EINVAL with NULL outputs
+ */
+ZTEST_F(adc_capture_tests, test_get_data_null)
+{
+  const uint16_t *data;
+  size_t scanCount;
+
+  zassert_equal(adcAcqCaptureGetData(NULL, &scanCount), -EINVAL, "NULL data should return -EINVAL");
+  zassert_equal(adcAcqCaptureGetData(&data, NULL), -EINVAL, "NULL scan count should return -EINVAL");
+}
+
+ZTEST_SUITE(adc_capture_tests, NULL, capture_setup, capture_before, NULL, NULL);
@@ -14,6 +14,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdlib.h>
 
 DEFINE_FFF_GLOBALS;
 
@@ -22,6 +23,11 @@ DEFINE_FFF_GLOBALS;
 #define ADC_AQC_SERVICE_NAME adcAcquisition
 #define SHELL_H__  /* Prevent shell.h inclusion */
 
+/* Mock Kconfig options */
+#define CONFIG_ENYA_ADC_ACQUISITION_CAPTURE 1
+#define CONFIG_ENYA_ADC_ACQUISITION_CAPTURE_SCAN_COUNT 16
+#define CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING 1
+
 /* Provide needed declarations */
 struct shell;
 
@@ -36,6 +42,7 @@ enum shell_vt100_color {
 static char captured_shell_output[256];
 static int shell_info_call_count = 0;
 static int shell_error_call_count = 0;
+static int shell_print_call_count = 0;
 
 /* Mock for shell_fprintf (what shell_info and shell_error expand to) */
 void shell_fprintf(const struct shell *shell, enum shell_vt100_color color,
@@ -58,6 +65,10 @@ void shell_fprintf(const struct shell *shell, enum shell_vt100_color color,
   {
     shell_info_call_count++;
   }
+  else if(color == SHELL_NORMAL)
+  {
+    shell_print_call_count++;
+  }
 }
 
 /* Mock shell functions */
@@ -69,18 +80,57 @@ FAKE_VALUE_FUNC(size_t, adcAcqUtilGetChanCount);
 FAKE_VALUE_FUNC(int, adcAcqUtilGetRaw, size_t, uint32_t *);
 FAKE_VALUE_FUNC(int, adcAcqUtilGetVolt, size_t, float *);
 
+/* Define types from adcAcquisition.h */
+typedef struct
+{
+  int64_t elapsedMs;
+  uint32_t triggerCount;
+  uint32_t overrunCount;
+  uint32_t startErrorCount;
+  uint32_t filterErrorCount;
+  uint32_t blockCount;
+  uint32_t convTimeMinUs;
+  uint32_t convTimeMaxUs;
+  uint32_t latencyMinUs;
+  uint32_t latencyMaxUs;
+} AdcAcqStats_t;
+
+FAKE_VALUE_FUNC(int, adcAcqUtilGetStats, AdcAcqStats_t *);
+FAKE_VOID_FUNC(adcAcqUtilResetStats);
+
+/* Mock capture functions */
+#include "adcAcquisitionCapture.h"
+
+FAKE_VALUE_FUNC(int, adcAcqCaptureArm, const AdcCaptureTrigger_t *);
+FAKE_VALUE_FUNC(AdcCaptureState_t, adcAcqCaptureGetState);
+FAKE_VALUE_FUNC(size_t, adcAcqCaptureGetScanCount);
+FAKE_VALUE_FUNC(int, adcAcqCaptureGetData, const uint16_t **, size_t *);
+
+/* Mock base64 functions */
+FAKE_VALUE_FUNC(int, base64_encode, uint8_t *, size_t, size_t *, const uint8_t *, size_t);
+
 #define FFF_FAKES_LIST(FAKE) \
   FAKE(shell_strtoul) \
   FAKE(shell_help) \
   FAKE(adcAcqUtilGetChanCount) \
   FAKE(adcAcqUtilGetRaw) \
-  FAKE(adcAcqUtilGetVolt)
+  FAKE(adcAcqUtilGetVolt) \
+  FAKE(adcAcqUtilGetStats) \
+  FAKE(adcAcqUtilResetStats) \
+  FAKE(adcAcqCaptureArm) \
+  FAKE(adcAcqCaptureGetState) \
+  FAKE(adcAcqCaptureGetScanCount) \
+  FAKE(adcAcqCaptureGetData) \
+  FAKE(base64_encode)
 
 /* Define shell macros for testing */
 #define shell_info(shell, fmt, ...) shell_fprintf(shell, SHELL_INFO, fmt, ##__VA_ARGS__)
 #define shell_error(shell, fmt, ...) shell_fprintf(shell, SHELL_ERROR, fmt, ##__VA_ARGS__)
+#define shell_print(shell, fmt, ...) shell_fprintf(shell, SHELL_NORMAL, fmt, ##__VA_ARGS__)
 #define SHELL_CMD(...)
 #define SHELL_CMD_ARG(...)
+#define SHELL_COND_CMD(...)
+#define SHELL_COND_CMD_ARG(...)
 #define SHELL_SUBCMD_SET_END
 #define SHELL_STATIC_SUBCMD_SET_CREATE(...)
 #define SHELL_CMD_REGISTER(...)
@@ -110,6 +160,7 @@ static void cmd_tests_before(void *f)
   memset(captured_shell_output, 0, sizeof(captured_shell_output));
   shell_info_call_count = 0;
   shell_error_call_count = 0;
+  shell_print_call_count = 0;
 }
 
 /**
@@ -364,4 +415,364 @@ ZTEST(adc_cmd_tests, test_get_volt_util_fails)
                 "execGetVolt should return error from adcAcqUtilGetVolt");
 }
 
+/* Custom fake for adcAcqCaptureArm that records the trigger */
+static AdcCaptureTrigger_t armed_trigger;
+
+static int adcAcqCaptureArm_record(const AdcCaptureTrigger_t *trigger)
+{
+  armed_trigger = *trigger;
+  return 0;
+}
+
+/* Custom fake for shell_strtoul that returns the argument value */
+static unsigned long shell_strtoul_parse(const char *str, int base, int *err)
+{
+  ARG_UNUSED(err);
+
+  return strtoul(str, NULL, base);
+}
+
+/**
+ * @test The execCaptureArm function must return -EINVAL when the trigger
+ * mode is unknown.
+ */
+ZTEST(adc_cmd_tests, test_capture_arm_invalid_mode)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_arm", "sideways"};
+  int result;
+
+  result = execCaptureArm(shell, 2, argv);
+
+  zassert_equal(result, -EINVAL,
+                "execCaptureArm should return -EINVAL on unknown mode");
+  zassert_equal(adcAcqCaptureArm_fake.call_count, 0,
+                "adcAcqCaptureArm should not be called");
+  zassert_equal(shell_help_fake.call_count, 1,
+                "shell_help should be called once");
+}
+
+/**
+ * @test The execCaptureArm function must return -EINVAL when a level
+ * trigger is missing its channel and level.
+ */
+ZTEST(adc_cmd_tests, test_capture_arm_missing_level)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_arm", "rising", "1"};
+  int result;
+
+  result = execCaptureArm(shell, 3, argv);
+
+  zassert_equal(result, -EINVAL,
+                "execCaptureArm should return -EINVAL without the level");
+  zassert_equal(adcAcqCaptureArm_fake.call_count, 0,
+                "adcAcqCaptureArm should not be called");
+}
+
+/**
+ * @test The execCaptureArm function must return the error when the level
+ * argument is invalid.
+ */
+ZTEST(adc_cmd_tests, test_capture_arm_invalid_level_arg)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_arm", "above", "1", "invalid"};
+  unsigned long (*custom_fakes[])(const char *, int, int *) = {shell_strtoul_parse, shell_strtoul_with_error};
+  int result;
+
+  SET_CUSTOM_FAKE_SEQ(shell_strtoul, custom_fakes, 2);
+
+  result = execCaptureArm(shell, 4, argv);
+
+  zassert_equal(result, -EINVAL,
+                "execCaptureArm should return the level parsing error");
+  zassert_true(strstr(captured_shell_output, "invalid level") != NULL,
+               "shell_error output should contain error message");
+  zassert_equal(adcAcqCaptureArm_fake.call_count, 0,
+                "adcAcqCaptureArm should not be called");
+}
+
+/**
+ * @test The execCaptureArm function must arm the capture with the parsed
+ * trigger.
+ */
+ZTEST(adc_cmd_tests, test_capture_arm_success)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_arm", "falling", "2", "1024"};
+  int result;
+
+  shell_strtoul_fake.custom_fake = shell_strtoul_parse;
+  adcAcqCaptureArm_fake.custom_fake = adcAcqCaptureArm_record;
+
+  result = execCaptureArm(shell, 4, argv);
+
+  zassert_equal(result, 0,
+                "execCaptureArm should return 0 on success");
+  zassert_equal(adcAcqCaptureArm_fake.call_count, 1,
+                "adcAcqCaptureArm should be called once");
+  zassert_equal(armed_trigger.mode, ADC_CAPTURE_TRIG_FALLING,
+                "The trigger mode should be falling");
+  zassert_equal(armed_trigger.chanId, 2,
+                "The trigger channel should be 2");
+  zassert_equal(armed_trigger.level, 1024,
+                "The trigger level should be 1024");
+  zassert_true(strstr(captured_shell_output, "SUCCESS") == captured_shell_output,
+               "shell_info output should start with SUCCESS");
+}
+
+/**
+ * @test The execCaptureArm function must arm an immediate capture without
+ * channel and level.
+ */
+ZTEST(adc_cmd_tests, test_capture_arm_now)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_arm", "now"};
+  int result;
+
+  adcAcqCaptureArm_fake.custom_fake = adcAcqCaptureArm_record;
+
+  result = execCaptureArm(shell, 2, argv);
+
+  zassert_equal(result, 0,
+                "execCaptureArm should return 0 on success");
+  zassert_equal(shell_strtoul_fake.call_count, 0,
+                "shell_strtoul should not be called");
+  zassert_equal(armed_trigger.mode, ADC_CAPTURE_TRIG_NOW,
+                "The trigger mode should be now");
+}
+
+/**
+ * @test The execCaptureArm function must return the error when arming the
+ * capture fails.
+ */
+ZTEST(adc_cmd_tests, test_capture_arm_fails)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_arm", "above", "9", "100"};
+  int result;
+
+  shell_strtoul_fake.custom_fake = shell_strtoul_parse;
+  adcAcqCaptureArm_fake.return_val = -EINVAL;
+
+  result = execCaptureArm(shell, 4, argv);
+
+  zassert_equal(result, -EINVAL,
+                "execCaptureArm should return the error from adcAcqCaptureArm");
+  zassert_true(strstr(captured_shell_output, "unable to arm the capture") != NULL,
+               "shell_error output should contain error message");
+}
+
+/**
+ * @test The execCaptureStatus function must print the capture state and
+ * scan count.
+ */
+ZTEST(adc_cmd_tests, test_capture_status)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_status"};
+  int result;
+
+  adcAcqCaptureGetState_fake.return_val = ADC_CAPTURE_RUNNING;
+  adcAcqCaptureGetScanCount_fake.return_val = 5;
+
+  result = execCaptureStatus(shell, 1, argv);
+
+  zassert_equal(result, 0,
+                "execCaptureStatus should return 0");
+  zassert_true(strstr(captured_shell_output, "running") != NULL,
+               "shell_info output should contain the state");
+  zassert_true(strstr(captured_shell_output, "5 scans of 16") != NULL,
+               "shell_info output should contain the scan count");
+}
+
+/**
+ * @test The execCaptureDump function must return the error when no capture
+ * is done.
+ */
+ZTEST(adc_cmd_tests, test_capture_dump_no_data)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_dump"};
+  int result;
+
+  adcAcqCaptureGetData_fake.return_val = -ENODATA;
+
+  result = execCaptureDump(shell, 1, argv);
+
+  zassert_equal(result, -ENODATA,
+                "execCaptureDump should return -ENODATA");
+  zassert_equal(base64_encode_fake.call_count, 0,
+                "base64_encode should not be called");
+}
+
+/* The dumped test capture */
+static const uint16_t dump_test_data[2 * 16] = {0};
+
+/* Custom fake for adcAcqCaptureGetData that returns the test capture */
+static int adcAcqCaptureGetData_test(const uint16_t **data, size_t *scanCount)
+{
+  *data = dump_test_data;
+  *scanCount = 16;
+  return 0;
+}
+
+/**
+ * @test The execCaptureDump function must dump the capture in chunks.
+ */
+ZTEST(adc_cmd_tests, test_capture_dump_success)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_dump"};
+  int result;
+
+  adcAcqCaptureGetData_fake.custom_fake = adcAcqCaptureGetData_test;
+  adcAcqUtilGetChanCount_fake.return_val = 2;
+
+  result = execCaptureDump(shell, 1, argv);
+
+  /* 16 scans of 2 channels are 64 bytes, a full chunk then 16 bytes */
+  zassert_equal(result, 0,
+                "execCaptureDump should return 0 on success");
+  zassert_equal(base64_encode_fake.call_count, 2,
+                "base64_encode should be called once per chunk");
+  zassert_equal(base64_encode_fake.arg3_history[0], (const uint8_t *)dump_test_data,
+                "The first chunk should start at the capture");
+  zassert_equal(base64_encode_fake.arg4_history[0], CAPTURE_DUMP_CHUNK_LEN,
+                "The first chunk should be full");
+  zassert_equal(base64_encode_fake.arg3_history[1], (const uint8_t *)dump_test_data + CAPTURE_DUMP_CHUNK_LEN,
+                "The second chunk should follow the first one");
+  zassert_equal(base64_encode_fake.arg4_history[1], 16,
+                "The second chunk should hold the remaining bytes");
+  zassert_equal(shell_print_call_count, 2,
+                "shell_print should be called once per chunk");
+  zassert_true(strstr(captured_shell_output, "SUCCESS") == captured_shell_output,
+               "shell_info output should start with SUCCESS");
+}
+
+/**
+ * @test The execCaptureDump function must return the error when encoding
+ * fails.
+ */
+ZTEST(adc_cmd_tests, test_capture_dump_encode_fails)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"capture_dump"};
+  int result;
+
+  adcAcqCaptureGetData_fake.custom_fake = adcAcqCaptureGetData_test;
+  adcAcqUtilGetChanCount_fake.return_val = 2;
+  base64_encode_fake.return_val = -ENOMEM;
+
+  result = execCaptureDump(shell, 1, argv);
+
+  zassert_equal(result, -ENOMEM,
+                "execCaptureDump should return the encoding error");
+  zassert_equal(shell_print_call_count, 0,
+                "Nothing should be printed");
+}
+
+/* Custom fake for adcAcqUtilGetStats that fills the statistics */
+static int adcAcqUtilGetStats_test(AdcAcqStats_t *stats)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->elapsedMs = 1000;
+  stats->triggerCount = 2000;
+  stats->overrunCount = 3;
+  stats->blockCount = 1997;
+  stats->convTimeMinUs = 40;
+  stats->convTimeMaxUs = 55;
+  stats->latencyMinUs = 12;
+  stats->latencyMaxUs = 27;
+  return 0;
+}
+
+/**
+ * @test The execStats function must print the statistics.
+ */
+ZTEST(adc_cmd_tests, test_stats_success)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"stats"};
+  int result;
+
+  adcAcqUtilGetStats_fake.custom_fake = adcAcqUtilGetStats_test;
+
+  result = execStats(shell, 1, argv);
+
+  zassert_equal(result, 0,
+                "execStats should return 0 on success");
+  zassert_equal(adcAcqUtilGetStats_fake.call_count, 1,
+                "adcAcqUtilGetStats should be called once");
+  zassert_equal(shell_print_call_count, 6,
+                "shell_print should be called for each statistics line");
+  zassert_true(strstr(captured_shell_output, "min 12 us, max 27 us") != NULL,
+               "The last line should hold the latency");
+}
+
+/**
+ * @test The execStats function must return the error when the statistics
+ * cannot be read.
+ */
+ZTEST(adc_cmd_tests, test_stats_get_fails)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"stats"};
+  int result;
+
+  adcAcqUtilGetStats_fake.return_val = -EINVAL;
+
+  result = execStats(shell, 1, argv);
+
+  zassert_equal(result, -EINVAL,
+                "execStats should return the error");
+  zassert_equal(shell_error_call_count, 1,
+                "shell_error should be called once");
+  zassert_equal(shell_print_call_count, 0,
+                "Nothing should be printed");
+}
+
+/**
+ * @test The execStats function must reset the statistics with the reset
+ * option.
+ */
+ZTEST(adc_cmd_tests, test_stats_reset)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"stats", "reset"};
+  int result;
+
+  result = execStats(shell, 2, argv);
+
+  zassert_equal(result, 0,
+                "execStats should return 0 on reset");
+  zassert_equal(adcAcqUtilResetStats_fake.call_count, 1,
+                "adcAcqUtilResetStats should be called once");
+  zassert_equal(adcAcqUtilGetStats_fake.call_count, 0,
+                "adcAcqUtilGetStats should not be called");
+  zassert_true(strstr(captured_shell_output, "SUCCESS") == captured_shell_output,
+               "shell_info output should start with SUCCESS");
+}
+
+/**
+ * @test The execStats function must reject an unknown option.
+ */
+ZTEST(adc_cmd_tests, test_stats_unknown_option)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"stats", "clear"};
+  int result;
+
+  result = execStats(shell, 2, argv);
+
+  zassert_equal(result, -EINVAL,
+                "execStats should return -EINVAL on an unknown option");
+  zassert_equal(adcAcqUtilResetStats_fake.call_count, 0,
+                "adcAcqUtilResetStats should not be called");
+  zassert_equal(shell_error_call_count, 1,
+                "shell_error should be called once");
+}
+
 ZTEST_SUITE(adc_cmd_tests, NULL, cmd_tests_setup, cmd_tests_before, NULL, NULL);
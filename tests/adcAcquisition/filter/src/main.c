@@ -69,8 +69,10 @@ static void filter_with_init_before(void *f)
   ARG_UNUSED(f);
   FFF_FAKES_LIST(RESET_FAKE);
   FFF_RESET_HISTORY();
-  /* Zero the filter buffer between tests */
+  /* Zero the filter buffer between tests and restore the channel defaults */
   memset(testFixture.filter_memory, 0, sizeof(testFixture.filter_memory));
+  for(size_t i = 0; i < 4; ++i)
+    adcAcqFilterConfigChannel(i, FILTER_MAX_TAU, FILTER_MAX_ORDER);
 }
 
 static void filter_with_init_after(void *f)
@@ -166,9 +168,9 @@ ZTEST(adc_filter_init_tests, test_filter_init_correct_malloc_size)
   zassert_equal(err, 0, "Filter init should succeed");
   zassert_equal(k_malloc_fake.call_count, 1, "k_malloc should be called once");
 
-  /* Filter buffer size = chanCount * (FILTER_MAX_ORDER + 1) * sizeof(int32_t) */
-  /* = 4 * 4 * 4 = 64 bytes */
-  expected_size = 4 * 4 * sizeof(int32_t);
+  /* Filter buffer size = chanCount * (FILTER_MAX_ORDER + 3) * sizeof(int32_t) */
+  /* = 4 * 6 * 4 = 96 bytes (4 stage planes, tau and order planes) */
+  expected_size = 4 * 6 * sizeof(int32_t);
   zassert_equal(k_malloc_fake.arg0_val, expected_size,
                 "k_malloc should be called with correct size");
 }
@@ -346,6 +348,248 @@ ZTEST_F(adc_filter_with_init_tests, test_filter_push_data_independent_channels)
   zassert_equal(filtData1, 2000, "Channel 1 data should be independent");
 }
 
+/* adcAcqFilterConfigChannel tests - error cases first */
+
+/**
+ * @test The adcAcqFilterInit function must default each channel to
+ * the maximum tau and order.
+ */
+ZTEST(adc_filter_init_tests, test_filter_init_channel_defaults)
+{
+  static int32_t test_memory[64];
+  int err;
+
+  k_malloc_fake.return_val = test_memory;
+
+  err = adcAcqFilterInit(4);
+
+  zassert_equal(err, 0, "Filter init should succeed");
+  for(size_t i = 0; i < 4; ++i)
+  {
+    zassert_equal(test_memory[FILTER_IDX(FILTER_TAU_IDX, i)], FILTER_MAX_TAU,
+                  "Channel tau should default to the maximum");
+    zassert_equal(test_memory[FILTER_IDX(FILTER_ORDER_IDX, i)], FILTER_MAX_ORDER,
+                  "Channel order should default to the maximum");
+  }
+}
+
+/**
+ * @test The adcAcqFilterConfigChannel function must return -EINVAL
+ * when the channel ID is out of range.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_config_channel_invalid_channel)
+{
+  int err;
+
+  err = adcAcqFilterConfigChannel(4, 31, 3);
+  zassert_equal(err, -EINVAL, "Config of an invalid channel should return -EINVAL");
+}
+
+/**
+ * @test The adcAcqFilterConfigChannel function must return -EINVAL
+ * when the order is above the maximum order.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_config_channel_invalid_order)
+{
+  int err;
+
+  err = adcAcqFilterConfigChannel(0, 31, 4);
+  zassert_equal(err, -EINVAL, "Config with order 4 should return -EINVAL");
+}
+
+/**
+ * @test The adcAcqFilterConfigChannel function must store the clamped
+ * tau and the order of the channel.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_config_channel_stores_settings)
+{
+  struct adc_filter_with_init_tests_fixture *f;
+  int err;
+
+  f = (struct adc_filter_with_init_tests_fixture *)fixture;
+
+  err = adcAcqFilterConfigChannel(1, 0, 1);
+  zassert_equal(err, 0, "Config should succeed");
+  err = adcAcqFilterConfigChannel(2, 1000, 2);
+  zassert_equal(err, 0, "Config should succeed");
+
+  zassert_equal(f->filter_memory[FILTER_IDX(FILTER_TAU_IDX, 1)], FILTER_MIN_TAU,
+                "Tau below the range should be clamped to the minimum");
+  zassert_equal(f->filter_memory[FILTER_IDX(FILTER_ORDER_IDX, 1)], 1,
+                "Order should be stored");
+  zassert_equal(f->filter_memory[FILTER_IDX(FILTER_TAU_IDX, 2)], FILTER_MAX_TAU,
+                "Tau above the range should be clamped to the maximum");
+  zassert_equal(f->filter_memory[FILTER_IDX(FILTER_ORDER_IDX, 2)], 2,
+                "Order should be stored");
+}
+
+/**
+ * @test A channel configured with order 1 must only filter its first
+ * stage, the upper stages following the first order output.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_order_one_skips_upper_stages)
+{
+  const uint16_t block[4] = {1000, 1000, 1000, 1000};
+  int32_t first;
+  int32_t second;
+  int32_t third;
+  int32_t refThird;
+
+  adcAcqFilterConfigChannel(0, 100, 1);
+  adcAcqFilterConfigChannel(1, 100, 3);
+
+  for(size_t i = 0; i < 4; ++i)
+    adcAcqFilterPushBlock(block, 1);
+
+  adcAcqFilterGetFirstOrderData(0, &first);
+  adcAcqFilterGetSecondOrderData(0, &second);
+  adcAcqFilterGetThirdOrderData(0, &third);
+  adcAcqFilterGetThirdOrderData(1, &refThird);
+
+  zassert_true(first > 0, "First order should be filtered");
+  zassert_equal(second, first, "Second order should follow the first order");
+  zassert_equal(third, first, "Third order should follow the first order");
+  zassert_true(refThird < third, "A third order channel should respond slower");
+}
+
+/**
+ * @test A channel configured with order 0 must bypass the filter.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_order_zero_bypasses_filter)
+{
+  int32_t third;
+  int err;
+
+  adcAcqFilterConfigChannel(0, 31, 0);
+
+  err = adcAcqFilterPushData(0, 1234, 31);
+  zassert_equal(err, 0, "Push data should succeed");
+
+  adcAcqFilterGetThirdOrderData(0, &third);
+  zassert_equal(third, 1234, "A bypassed channel output should be the raw data");
+}
+
+/* adcAcqFilterPushBlock tests - error cases first */
+
+/**
+ * @test The adcAcqFilterPushBlock function must return -EINVAL
+ * when the block is NULL.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_push_block_null_pointer)
+{
+  int err;
+
+  err = adcAcqFilterPushBlock(NULL, 1);
+  zassert_equal(err, -EINVAL, "Push block with NULL pointer should return -EINVAL");
+}
+
+/**
+ * @test The adcAcqFilterPushBlock function must store the raw data
+ * of the last scan in the raw data plane, one value per channel.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_push_block_stores_raw_values)
+{
+  struct adc_filter_with_init_tests_fixture *f;
+  const uint16_t block[8] = {1, 2, 3, 4, 1000, 2000, 3000, 4000};
+  int err;
+
+  f = (struct adc_filter_with_init_tests_fixture *)fixture;
+
+  err = adcAcqFilterPushBlock(block, 2);
+  zassert_equal(err, 0, "Push block should succeed");
+
+  for(size_t i = 0; i < 4; ++i)
+    zassert_equal(f->filter_memory[i], block[4 + i] << 9,
+                  "Raw data should be stored prescaled in the raw data plane");
+}
+
+/**
+ * @test The adcAcqFilterPushBlock function must produce the same filter
+ * outputs as pushing each sample of the block one by one, tau clamped.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_push_block_matches_push_data)
+{
+  struct adc_filter_with_init_tests_fixture *f;
+  uint16_t block[4 * 16];
+  int32_t blockOut[4][3];
+  int32_t sampleOut;
+  int err;
+
+  f = (struct adc_filter_with_init_tests_fixture *)fixture;
+
+  for(size_t i = 0; i < ARRAY_SIZE(block); ++i)
+    block[i] = (uint16_t)((i * 397) % 4096);
+
+  for(size_t i = 0; i < 4; ++i)
+    adcAcqFilterConfigChannel(i, 600, 3);
+
+  err = adcAcqFilterPushBlock(block, 16);
+  zassert_equal(err, 0, "Push block should succeed");
+
+  for(size_t i = 0; i < 4; ++i)
+  {
+    adcAcqFilterGetFirstOrderData(i, &blockOut[i][0]);
+    adcAcqFilterGetSecondOrderData(i, &blockOut[i][1]);
+    adcAcqFilterGetThirdOrderData(i, &blockOut[i][2]);
+  }
+
+  /* Restart from a cleared filter state */
+  memset(f->filter_memory, 0, 4 * 4 * sizeof(int32_t));
+
+  for(size_t scan = 0; scan < 16; ++scan)
+  {
+    for(size_t i = 0; i < 4; ++i)
+      adcAcqFilterPushData(i, block[scan * 4 + i], 511);
+  }
+
+  for(size_t i = 0; i < 4; ++i)
+  {
+    adcAcqFilterGetFirstOrderData(i, &sampleOut);
+    zassert_equal(blockOut[i][0], sampleOut, "First order output should match");
+    adcAcqFilterGetSecondOrderData(i, &sampleOut);
+    zassert_equal(blockOut[i][1], sampleOut, "Second order output should match");
+    adcAcqFilterGetThirdOrderData(i, &sampleOut);
+    zassert_equal(blockOut[i][2], sampleOut, "Third order output should match");
+  }
+}
+
+/* adcAcqFilterPushRangeBlock tests - error cases first */
+
+/**
+ * @test The adcAcqFilterPushRangeBlock function must return -EINVAL
+ * when the block is NULL or the range is out of bounds.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_push_range_block_invalid)
+{
+  const uint16_t block[2] = {1, 2};
+
+  zassert_equal(adcAcqFilterPushRangeBlock(NULL, 1, 0, 2), -EINVAL,
+                "Push range block with NULL pointer should return -EINVAL");
+  zassert_equal(adcAcqFilterPushRangeBlock(block, 1, 3, 2), -EINVAL,
+                "Push range block past the channels should return -EINVAL");
+}
+
+/**
+ * @test The adcAcqFilterPushRangeBlock function must only filter the
+ * channels of its range, the block holding these channels only.
+ */
+ZTEST_F(adc_filter_with_init_tests, test_filter_push_range_block_stores_range)
+{
+  struct adc_filter_with_init_tests_fixture *f;
+  const uint16_t block[4] = {10, 20, 1000, 2000};
+  int err;
+
+  f = (struct adc_filter_with_init_tests_fixture *)fixture;
+
+  err = adcAcqFilterPushRangeBlock(block, 2, 2, 2);
+  zassert_equal(err, 0, "Push range block should succeed");
+
+  zassert_equal(f->filter_memory[0], 0, "The channels before the range should be untouched");
+  zassert_equal(f->filter_memory[1], 0, "The channels before the range should be untouched");
+  zassert_equal(f->filter_memory[2], 1000 << 9, "The range should hold its last scan");
+  zassert_equal(f->filter_memory[3], 2000 << 9, "The range should hold its last scan");
+}
+
 /* adcAcqFilterGetRawData tests - error cases first */
 
 /**
@@ -0,0 +1,450 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     ADC Acquisition Multiple Controller Tests
+ *
+ *            Unit tests for the ADC acquisition controller groups.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Forward declare needed types without including driver headers */
+struct adc_dt_spec;
+struct adc_sequence;
+struct counter_top_cfg;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Wrap device_is_ready since it's defined by Zephyr */
+#define device_is_ready device_is_ready_mock
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Prevent filter header */
+#define ADC_ACQUISITION_FILTER
+
+/* Prevent ADC acquisition main header - we'll define types manually */
+#define ADC_ACQUISITION
+
+/* Prevent ADC and counter driver headers - they conflict with mocks */
+#define ZEPHYR_INCLUDE_DRIVERS_ADC_H_
+#define ZEPHYR_INCLUDE_DRIVERS_COUNTER_H_
+#define ZEPHYR_DEVICE_H_
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(adc_is_ready_dt) \
+  FAKE(adc_channel_setup_dt) \
+  FAKE(adc_read_async) \
+  FAKE(counter_us_to_ticks) \
+  FAKE(counter_set_top_value) \
+  FAKE(counter_start) \
+  FAKE(counter_stop) \
+  FAKE(device_is_ready_mock) \
+  FAKE(k_malloc) \
+  FAKE(adcAcqFilterPushRangeBlock) \
+  FAKE(adcAcqFilterConfigChannel) \
+  FAKE(adcAcqFilterGetThirdOrderData) \
+  FAKE(osMemoryPoolNew) \
+  FAKE(osMemoryPoolAlloc) \
+  FAKE(osMemoryPoolFree)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(adcAcquisition, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Redefine LOG_ERR to avoid dereferencing invalid pointers in error messages */
+#undef LOG_ERR
+#define LOG_ERR(...) do {} while (0)
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_ADC_VREF_STM32_CCR 1
+#define CONFIG_ENYA_ADC_VREF_STABILIZATION_US 15
+
+/* Mock STM32 registers */
+typedef struct
+{
+  uint32_t CCR;
+} ADC_Common_TypeDef;
+
+static ADC_Common_TypeDef mock_adc1_common __attribute__((unused)) = {0};
+#define ADC1_COMMON (&mock_adc1_common)
+#define ADC_CCR_VREFEN (1 << 22)
+
+/* Flag to simulate VREFEN bit not being set (hardware failure) */
+static bool mock_vrefen_fails = false;
+#define READ_ADC1_COMMON_CCR() (mock_vrefen_fails ? 0 : mock_adc1_common.CCR)
+
+/* Mock VREFINT_CAL_ADDR */
+static uint16_t mock_vrefint_cal __attribute__((unused)) = 1500;
+#define VREFINT_CAL_ADDR (&mock_vrefint_cal)
+
+/* Mock soc.h */
+#define _SOC__H_
+
+/* Mock ADC controllers, two channels each */
+static const struct device mock_adc_devices[2] __attribute__((unused)) = {0};
+
+/* Mock ADC devicetree macro */
+#define ADC_DT_SPEC_GET_BY_IDX(node, idx) {.dev = &mock_adc_devices[(idx) / 2], .channel_id = (idx) % 2, .resolution = 12 - 2 * ((idx) / 2), .oversampling = (idx) / 2}
+
+/* Mock timer device and devicetree macros for adc-trigger alias */
+static const struct device mock_timer_device __attribute__((unused)) = {0};
+#undef DEVICE_DT_GET
+#define DEVICE_DT_GET(node) (&mock_timer_device)
+#undef DT_ALIAS
+#define DT_ALIAS(alias) alias
+
+/* Define types from adcAcquisition.h before including source */
+typedef struct
+{
+  uint32_t samplingRate;
+  int32_t filterTau;
+  uint32_t filterOrder;
+  uint32_t blockScanCount;
+} AdcConfig_t;
+
+typedef struct
+{
+  size_t activeSubCount;
+  size_t maxSubCount;
+  uint32_t notificationRate;
+} AdcSubConfig_t;
+
+typedef enum
+{
+  ADC_ACQ_FORMAT_VOLT = 0,
+  ADC_ACQ_FORMAT_MILLIVOLT,
+  ADC_ACQ_FORMAT_COUNT,
+} AdcDataFormat_t;
+
+typedef struct
+{
+  uint32_t chanMask;
+  uint32_t periodMs;
+  AdcDataFormat_t format;
+} AdcSubOptions_t;
+
+typedef struct
+{
+  int64_t elapsedMs;
+  uint32_t triggerCount;
+  uint32_t overrunCount;
+  uint32_t startErrorCount;
+  uint32_t filterErrorCount;
+  uint32_t blockCount;
+  uint32_t convTimeMinUs;
+  uint32_t convTimeMaxUs;
+  uint32_t latencyMinUs;
+  uint32_t latencyMaxUs;
+} AdcAcqStats_t;
+
+typedef struct SrvMsgPayload SrvMsgPayload_t;
+typedef int (*AdcSubCallback_t)(SrvMsgPayload_t *data);
+
+struct SrvMsgPayload {
+  osMemoryPoolId_t poolId;                          /**< Memory pool to return buffer to. */
+  size_t dataLen;                                   /**< Actual data length in bytes. */
+  uint8_t data[];                                   /**< Flexible array of data bytes. */
+};
+
+/* Provide minimal type definitions that adcAcquisitionUtil.c needs */
+enum adc_action {
+  ADC_ACTION_CONTINUE = 0,
+  ADC_ACTION_FINISH = 1,
+};
+
+struct adc_sequence_options {
+  uint16_t extra_samplings;
+  uint16_t interval_us;
+  enum adc_action (*callback)(const struct device *dev, const struct adc_sequence *sequence, uint16_t sampling_index);
+  void *user_data;
+};
+
+struct adc_sequence {
+  struct adc_sequence_options *options;
+  uint32_t channels;
+  void *buffer;
+  size_t buffer_size;
+  uint8_t resolution;
+  uint8_t oversampling;
+  bool calibrate;
+};
+
+struct adc_dt_spec {
+  const struct device *dev;
+  uint8_t channel_id;
+  uint8_t resolution;
+  uint8_t oversampling;
+};
+
+struct counter_top_cfg {
+  uint32_t flags;
+  uint32_t ticks;
+  void (*callback)(const struct device *dev, void *user_data);
+  void *user_data;
+};
+
+/* Mock ADC functions */
+FAKE_VALUE_FUNC(bool, adc_is_ready_dt, const struct adc_dt_spec *);
+FAKE_VALUE_FUNC(int, adc_channel_setup_dt, const struct adc_dt_spec *);
+FAKE_VALUE_FUNC(int, adc_read_async, const struct device *, const struct adc_sequence *, struct k_poll_signal *);
+
+/* Mock counter/timer functions */
+FAKE_VALUE_FUNC(uint32_t, counter_us_to_ticks, const struct device *, uint64_t);
+FAKE_VALUE_FUNC(int, counter_set_top_value, const struct device *, const struct counter_top_cfg *);
+FAKE_VALUE_FUNC(int, counter_start, const struct device *);
+FAKE_VALUE_FUNC(int, counter_stop, const struct device *);
+
+/* Mock device functions */
+FAKE_VALUE_FUNC(bool, device_is_ready_mock, const struct device *);
+
+/* Mock memory functions */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+
+/* Mock filter functions */
+FAKE_VALUE_FUNC(int, adcAcqFilterPushRangeBlock, const uint16_t *, size_t, size_t, size_t);
+FAKE_VALUE_FUNC(int, adcAcqFilterConfigChannel, size_t, int32_t, uint32_t);
+FAKE_VALUE_FUNC(int, adcAcqFilterGetThirdOrderData, size_t, int32_t *);
+
+/* Mock osMemoryPool functions */
+FAKE_VALUE_FUNC(osMemoryPoolId_t, osMemoryPoolNew, uint32_t, uint32_t, void *);
+FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
+FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+/* Override VREF readback for unit testing (mock_vrefen_fails simulation) */
+#define STM32_ADC_VREF_REG_READ READ_ADC1_COMMON_CCR()
+
+/* Include utility implementation */
+#include "adcAcquisitionUtil.c"
+
+/**
+ * @brief   The test block scan count.
+ */
+#define TEST_BLOCK_SCAN_COUNT                                   2
+
+/**
+ * @brief   The test ADC buffer, a block of each channel.
+ */
+static uint16_t testBuffer[TEST_BLOCK_SCAN_COUNT * ARRAY_SIZE(adcChannels)];
+
+/**
+ * Test setup function.
+ */
+static void *multi_tests_setup(void)
+{
+  return NULL;
+}
+
+/**
+ * Test before function.
+ */
+static void multi_tests_before(void *fixture)
+{
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  adc_is_ready_dt_fake.return_val = true;
+
+  /* Reset the controller groups */
+  memset(groups, 0, sizeof(groups));
+  groupCount = 0;
+
+  /* Reset the ADC buffer */
+  memset(testBuffer, 0, sizeof(testBuffer));
+  buffer = testBuffer;
+  chanCount = ARRAY_SIZE(adcChannels);
+
+  /* Reset config structure */
+  memset(&config, 0, sizeof(config));
+  config.samplingRate = 100;
+  config.blockScanCount = TEST_BLOCK_SCAN_COUNT;
+
+  adcAcqUtilResetStats();
+}
+
+/**
+ * @test The channels must be grouped per ADC controller.
+ */
+ZTEST(adc_multi_tests, test_configure_groups_per_controller)
+{
+  zassert_equal(configureChannels(), 0,
+                "configureChannels should succeed");
+
+  zassert_equal(adcAcqUtilGetGroupCount(), 2,
+                "One group should be opened per controller");
+
+  for(size_t i = 0; i < 2; ++i)
+  {
+    zassert_equal(groups[i].dev, &mock_adc_devices[i],
+                  "Group %d should convert on its own controller", i);
+    zassert_equal(groups[i].firstChan, 2 * i,
+                  "Group %d should start at its first channel", i);
+    zassert_equal(groups[i].chanCount, 2,
+                  "Group %d should hold the channels of its controller", i);
+    zassert_equal(groups[i].sequence.channels, 0x3,
+                  "Group %d should convert the channels of its controller", i);
+    zassert_equal(groups[i].divider, 1,
+                  "Group %d should run at the sampling rate by default", i);
+  }
+}
+
+/**
+ * @test A controller must not open a second group.
+ */
+ZTEST(adc_multi_tests, test_open_group_not_contiguous)
+{
+  /* The second channel of the first controller after the second one */
+  zassert_equal(openGroup(0), 0, "The first group should open");
+  zassert_equal(openGroup(2), 0, "The second group should open");
+
+  zassert_equal(openGroup(1), -EINVAL,
+                "A controller should not be split between groups");
+  zassert_equal(groupCount, 2, "No group should be added");
+}
+
+/**
+ * @test Each group sequence must convert into its own buffer slice.
+ */
+ZTEST(adc_multi_tests, test_setup_sequence_slices)
+{
+  configureChannels();
+  groups[1].divider = 2;
+
+  setupSequence();
+
+  zassert_equal(groups[0].sequence.buffer, testBuffer,
+                "The first group should start the buffer");
+  zassert_equal(groups[1].sequence.buffer, testBuffer + 2 * TEST_BLOCK_SCAN_COUNT,
+                "The second group should follow the first one's block");
+  zassert_equal(groups[1].sequence.buffer_size, 2 * TEST_BLOCK_SCAN_COUNT * sizeof(uint16_t),
+                "The group buffer should hold its block only");
+  zassert_equal(groups[0].sequence.resolution, 12,
+                "The first group should use its controller resolution");
+  zassert_equal(groups[1].sequence.resolution, 10,
+                "The second group should use its controller resolution");
+  zassert_equal(groups[1].sequence.oversampling, 1,
+                "The second group should use its controller oversampling");
+  zassert_equal(groups[0].options.interval_us, 100,
+                "The first group scans should be paced at the sampling rate");
+  zassert_equal(groups[1].options.interval_us, 200,
+                "The divided group scans should be paced at its own rate");
+  zassert_equal(groups[1].options.user_data, &groups[1],
+                "The group should be found back from its sequence options");
+}
+
+/**
+ * @test A trigger must start the sequence of every group.
+ */
+ZTEST(adc_multi_tests, test_trigger_starts_all_groups)
+{
+  configureChannels();
+  setupSequence();
+
+  triggerConversion(NULL, NULL);
+
+  zassert_equal(adc_read_async_fake.call_count, 2,
+                "Each group should be started");
+  zassert_equal(adc_read_async_fake.arg0_history[0], &mock_adc_devices[0],
+                "The first controller should be started");
+  zassert_equal(adc_read_async_fake.arg1_history[0], &groups[0].sequence,
+                "The first controller should convert its own sequence");
+  zassert_equal(adc_read_async_fake.arg0_history[1], &mock_adc_devices[1],
+                "The second controller should be started");
+  zassert_equal(adc_read_async_fake.arg1_history[1], &groups[1].sequence,
+                "The second controller should convert its own sequence");
+  zassert_true(groups[0].isBusy && groups[1].isBusy,
+               "Both groups should be busy");
+}
+
+/**
+ * @test A divided group must only be started at its own rate.
+ */
+ZTEST(adc_multi_tests, test_trigger_rate_divider)
+{
+  configureChannels();
+  setupSequence();
+  groups[1].divider = 2;
+
+  for(size_t i = 0; i < 4; ++i)
+  {
+    triggerConversion(NULL, NULL);
+    groups[0].isBusy = false;
+    groups[1].isBusy = false;
+  }
+
+  zassert_equal(adc_read_async_fake.call_count, 6,
+                "The divided group should be started every other trigger");
+  zassert_equal(adc_read_async_fake.arg0_history[0], &mock_adc_devices[0],
+                "The first trigger should start the first group");
+  zassert_equal(adc_read_async_fake.arg0_history[1], &mock_adc_devices[1],
+                "The first trigger should start the divided group");
+  zassert_equal(adc_read_async_fake.arg0_history[2], &mock_adc_devices[0],
+                "The second trigger should only start the first group");
+  zassert_equal(adc_read_async_fake.arg0_history[4], &mock_adc_devices[1],
+                "The third trigger should start the divided group again");
+}
+
+/**
+ * @test A busy group must count an overrun without blocking the others.
+ */
+ZTEST(adc_multi_tests, test_trigger_group_overrun)
+{
+  AdcAcqStats_t stats;
+
+  configureChannels();
+  setupSequence();
+  groups[1].isBusy = true;
+
+  triggerConversion(NULL, NULL);
+
+  zassert_equal(adc_read_async_fake.call_count, 1,
+                "Only the idle group should be started");
+  zassert_equal(adc_read_async_fake.arg0_history[0], &mock_adc_devices[0],
+                "The idle group should be started");
+
+  adcAcqUtilGetStats(&stats);
+  zassert_equal(stats.overrunCount, 1, "The busy group should count an overrun");
+  zassert_equal(stats.triggerCount, 1, "The trigger should be counted once");
+}
+
+/**
+ * @test The group block must be pushed into the filters of its channels.
+ */
+ZTEST(adc_multi_tests, test_callback_pushes_group_range)
+{
+  configureChannels();
+  setupSequence();
+  groups[1].isBusy = true;
+
+  zassert_equal(adcSeqCallback(&mock_adc_devices[1], &groups[1].sequence, 0), ADC_ACTION_CONTINUE,
+                "The callback should continue until the block is complete");
+  zassert_equal(adcSeqCallback(&mock_adc_devices[1], &groups[1].sequence, 1), ADC_ACTION_FINISH,
+                "The callback should finish after the last scan");
+
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.call_count, 1,
+                "The block should be pushed once");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg0_val, testBuffer + 2 * TEST_BLOCK_SCAN_COUNT,
+                "The group buffer slice should be pushed");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg1_val, TEST_BLOCK_SCAN_COUNT,
+                "The block scan count should be pushed");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg2_val, 2,
+                "The group first channel should be pushed");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg3_val, 2,
+                "The group channel count should be pushed");
+  zassert_false(groups[1].isBusy, "The group should be idle");
+}
+
+ZTEST_SUITE(adc_multi_tests, NULL, multi_tests_setup, multi_tests_before, NULL, NULL);
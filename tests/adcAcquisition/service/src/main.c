@@ -65,15 +65,22 @@ typedef struct
   k_tid_t threadId;
   ServicePriority_t priority;
   uint32_t heartbeatIntervalMs;
-  int64_t lastHeartbeatMs;
+  atomic_t lastHeartbeatMs;
   uint8_t missedHeartbeats;
   ServiceState_t state;
+  uint8_t maxRestarts;
   int (*start)(void);
   int (*stop)(void);
   int (*suspend)(void);
   int (*resume)(void);
+  int (*restart)(void);
 } ServiceDescriptor_t;
 
+/* Provide ServiceHandle_t definition */
+typedef size_t ServiceHandle_t;
+
+#define TEST_SERVICE_HANDLE 3
+
 /* Prevent adcAcquisition header - we define types manually */
 #define ADC_ACQUISITION
 
@@ -92,6 +99,9 @@ typedef struct
 /* Wrap k_thread_suspend to use mock */
 #define k_thread_suspend k_thread_suspend_mock
 
+/* Wrap k_thread_abort to use mock */
+#define k_thread_abort k_thread_abort_mock
+
 /* Wrap k_thread_resume to use mock */
 #define k_thread_resume k_thread_resume_mock
 
@@ -126,6 +136,8 @@ typedef struct
 {
   uint32_t samplingRate;
   int32_t filterTau;
+  uint32_t filterOrder;
+  uint32_t blockScanCount;
 } AdcConfig_t;
 
 /* Provide AdcSubConfig_t type */
@@ -136,6 +148,36 @@ typedef struct
   uint32_t notificationRate;
 } AdcSubConfig_t;
 
+/* Provide AdcDataFormat_t and AdcSubOptions_t types */
+typedef enum
+{
+  ADC_ACQ_FORMAT_VOLT = 0,
+  ADC_ACQ_FORMAT_MILLIVOLT,
+  ADC_ACQ_FORMAT_COUNT,
+} AdcDataFormat_t;
+
+typedef struct
+{
+  uint32_t chanMask;
+  uint32_t periodMs;
+  AdcDataFormat_t format;
+} AdcSubOptions_t;
+
+/* Provide AdcAcqStats_t type */
+typedef struct
+{
+  int64_t elapsedMs;
+  uint32_t triggerCount;
+  uint32_t overrunCount;
+  uint32_t startErrorCount;
+  uint32_t filterErrorCount;
+  uint32_t blockCount;
+  uint32_t convTimeMinUs;
+  uint32_t convTimeMaxUs;
+  uint32_t latencyMinUs;
+  uint32_t latencyMaxUs;
+} AdcAcqStats_t;
+
 /* Mock kernel functions */
 FAKE_VOID_FUNC(k_sleep_mock, k_timeout_t);
 FAKE_VALUE_FUNC(k_tid_t, k_thread_create_mock, struct k_thread *, k_thread_stack_t *,
@@ -144,26 +186,32 @@ FAKE_VALUE_FUNC(int, k_thread_name_set_mock, k_tid_t, const char *);
 FAKE_VOID_FUNC(k_thread_start_mock, k_tid_t);
 FAKE_VOID_FUNC(k_thread_suspend_mock, k_tid_t);
 FAKE_VOID_FUNC(k_thread_resume_mock, k_tid_t);
+FAKE_VOID_FUNC(k_thread_abort_mock, k_tid_t);
 FAKE_VALUE_FUNC(k_tid_t, k_current_get_mock);
 FAKE_VALUE_FUNC(int, k_msgq_put_mock, struct k_msgq *, const void *, k_timeout_t);
 FAKE_VALUE_FUNC(int, k_msgq_get_mock, struct k_msgq *, void *, k_timeout_t);
 
 /* Mock service manager functions */
-FAKE_VALUE_FUNC(int, serviceManagerConfirmState, k_tid_t, ServiceState_t);
-FAKE_VALUE_FUNC(int, serviceManagerUpdateHeartbeat, k_tid_t);
-FAKE_VALUE_FUNC(int, serviceManagerRegisterSrv, const ServiceDescriptor_t *);
+FAKE_VALUE_FUNC(int, serviceManagerConfirmState, ServiceHandle_t, ServiceState_t);
+FAKE_VALUE_FUNC(int, serviceManagerUpdateHeartbeat, ServiceHandle_t);
+FAKE_VALUE_FUNC(int, serviceManagerRegisterSrv, const ServiceDescriptor_t *, ServiceHandle_t *);
 
 /* Mock utility functions */
 FAKE_VALUE_FUNC(int, adcAcqUtilInitAdc, AdcConfig_t *);
 FAKE_VALUE_FUNC(int, adcAcqUtilInitSubscriptions, AdcSubConfig_t *);
 FAKE_VALUE_FUNC(int, adcAcqUtilStartTrigger);
 FAKE_VALUE_FUNC(int, adcAcqUtilStopTrigger);
-FAKE_VALUE_FUNC(int, adcAcqUtilProcessData);
+FAKE_VALUE_FUNC(uint32_t, adcAcqUtilGetDueChanMask, AdcDataFormat_t);
+FAKE_VALUE_FUNC(int, adcAcqUtilProcessData, uint32_t, uint32_t);
 FAKE_VALUE_FUNC(int, adcAcqUtilNotifySubscribers);
 FAKE_VALUE_FUNC(size_t, adcAcqUtilGetChanCount);
-FAKE_VALUE_FUNC(int, adcAcqUtilAddSubscription, AdcSubCallback_t);
+FAKE_VALUE_FUNC(int, adcAcqUtilConfigFilter);
+FAKE_VALUE_FUNC(int, adcAcqUtilAddSubscription, AdcSubCallback_t, const AdcSubOptions_t *);
 FAKE_VALUE_FUNC(int, adcAcqUtilRemoveSubscription, AdcSubCallback_t);
 FAKE_VALUE_FUNC(int, adcAcqUtilSetSubPauseState, AdcSubCallback_t, bool);
+FAKE_VOID_FUNC(adcAcqUtilReleaseData, SrvMsgPayload_t *);
+FAKE_VALUE_FUNC(int, adcAcqUtilGetStats, AdcAcqStats_t *);
+FAKE_VOID_FUNC(adcAcqUtilResetStats);
 
 /* Mock filter functions */
 FAKE_VALUE_FUNC(int, adcAcqFilterInit, size_t);
@@ -175,6 +223,7 @@ FAKE_VALUE_FUNC(int, adcAcqFilterInit, size_t);
   FAKE(k_thread_start_mock) \
   FAKE(k_thread_suspend_mock) \
   FAKE(k_thread_resume_mock) \
+  FAKE(k_thread_abort_mock) \
   FAKE(k_current_get_mock) \
   FAKE(k_msgq_put_mock) \
   FAKE(k_msgq_get_mock) \
@@ -185,12 +234,17 @@ FAKE_VALUE_FUNC(int, adcAcqFilterInit, size_t);
   FAKE(adcAcqUtilInitSubscriptions) \
   FAKE(adcAcqUtilStartTrigger) \
   FAKE(adcAcqUtilStopTrigger) \
+  FAKE(adcAcqUtilGetDueChanMask) \
   FAKE(adcAcqUtilProcessData) \
   FAKE(adcAcqUtilNotifySubscribers) \
   FAKE(adcAcqUtilGetChanCount) \
+  FAKE(adcAcqUtilConfigFilter) \
   FAKE(adcAcqUtilAddSubscription) \
   FAKE(adcAcqUtilRemoveSubscription) \
   FAKE(adcAcqUtilSetSubPauseState) \
+  FAKE(adcAcqUtilReleaseData) \
+  FAKE(adcAcqUtilGetStats) \
+  FAKE(adcAcqUtilResetStats) \
   FAKE(adcAcqFilterInit)
 
 /* Setup logging */
@@ -205,11 +259,14 @@ LOG_MODULE_REGISTER(adcAcquisition, LOG_LEVEL_DBG);
 #define CONFIG_ENYA_ADC_ACQUISITION_STACK_SIZE          1024
 #define CONFIG_ENYA_ADC_ACQUISITION_SAMPLING_RATE_US    500
 #define CONFIG_ENYA_ADC_ACQUISITION_FILTER_TAU          31
+#define CONFIG_ENYA_ADC_ACQUISITION_BLOCK_SCAN_COUNT    1
+#define CONFIG_ENYA_ADC_ACQUISITION_FILTER_ORDER        3
 #define CONFIG_ENYA_ADC_ACQUISITION_MAX_SUB_COUNT       4
 #define CONFIG_ENYA_ADC_ACQUISITION_NOTIFICATION_RATE_MS 100
 #define CONFIG_ENYA_ADC_ACQUISITION_THREAD_PRIORITY     5
 #define CONFIG_ENYA_ADC_ACQUISITION_SERVICE_PRIORITY    1
 #define CONFIG_ENYA_ADC_ACQUISITION_HEARTBEAT_INTERVAL_MS 1000
+#define CONFIG_ENYA_ADC_ACQUISITION_MAX_RESTARTS        3
 
 /* Include service implementation */
 #include "adcAcquisition.c"
@@ -229,8 +286,10 @@ static int k_msgq_put_capture(struct k_msgq *q, const void *data, k_timeout_t ti
 /* Descriptor capture helper for serviceManagerRegisterSrv */
 static ServiceDescriptor_t captured_descriptor;
 
-static int serviceManagerRegisterSrv_capture(const ServiceDescriptor_t *descriptor)
+static int serviceManagerRegisterSrv_capture(const ServiceDescriptor_t *descriptor, ServiceHandle_t *handle)
 {
+  if(handle)
+    *handle = TEST_SERVICE_HANDLE;
   if(descriptor)
     captured_descriptor = *descriptor;
   return serviceManagerRegisterSrv_fake.return_val;
@@ -278,6 +337,29 @@ static void service_tests_before(void *f)
   k_msgq_put_mock_fake.custom_fake = k_msgq_put_capture;
   memset(&captured_descriptor, 0, sizeof(captured_descriptor));
   serviceManagerRegisterSrv_fake.custom_fake = serviceManagerRegisterSrv_capture;
+  serviceHandle = TEST_SERVICE_HANDLE;
+}
+
+/**
+ * @test The run function must confirm the running state when the thread starts.
+ */
+ZTEST(adc_service_tests, test_run_confirms_running)
+{
+  /* Setup: no control message */
+  k_msgq_get_mock_fake.custom_fake = k_msgq_get_from_ctrl_queue;
+
+  /* Execute */
+  run((void *)(uintptr_t)100, NULL, NULL);
+
+  /* Verify the running confirmation, the dependent services starting on it */
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
+                "serviceManagerConfirmState should be called once");
+  zassert_equal(serviceManagerConfirmState_fake.arg0_val, TEST_SERVICE_HANDLE,
+                "serviceManagerConfirmState should be called with the service handle");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_RUNNING,
+                "serviceManagerConfirmState should be called with SVC_STATE_RUNNING");
+  zassert_equal(adcAcqUtilProcessData_fake.call_count, 2,
+                "adcAcqUtilProcessData should be called on each iteration");
 }
 
 /**
@@ -297,8 +379,10 @@ ZTEST(adc_service_tests, test_run_stop_trigger_failure)
   /* Verify stopTrigger and confirmState were still called */
   zassert_equal(adcAcqUtilStopTrigger_fake.call_count, 1,
                 "adcAcqUtilStopTrigger should be called once");
-  zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
-                "serviceManagerConfirmState should be called once");
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 2,
+                "serviceManagerConfirmState should be called twice");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_history[0], SVC_STATE_RUNNING,
+                "serviceManagerConfirmState should first be called with SVC_STATE_RUNNING");
   zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_STOPPED,
                 "serviceManagerConfirmState should be called with SVC_STATE_STOPPED");
   /* Thread returned on STOP: process/notify/heartbeat not called */
@@ -325,8 +409,10 @@ ZTEST(adc_service_tests, test_run_stop_success)
   /* Verify STOP flow */
   zassert_equal(adcAcqUtilStopTrigger_fake.call_count, 1,
                 "adcAcqUtilStopTrigger should be called once");
-  zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
-                "serviceManagerConfirmState should be called once");
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 2,
+                "serviceManagerConfirmState should be called twice");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_history[0], SVC_STATE_RUNNING,
+                "serviceManagerConfirmState should first be called with SVC_STATE_RUNNING");
   zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_STOPPED,
                 "serviceManagerConfirmState should be called with SVC_STATE_STOPPED");
   /* Thread returned on STOP: no processing after */
@@ -353,8 +439,10 @@ ZTEST(adc_service_tests, test_run_suspend_trigger_failure)
   /* Verify SUSPEND flow */
   zassert_equal(adcAcqUtilStopTrigger_fake.call_count, 1,
                 "adcAcqUtilStopTrigger should be called once");
-  zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
-                "serviceManagerConfirmState should be called once");
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 2,
+                "serviceManagerConfirmState should be called twice");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_history[0], SVC_STATE_RUNNING,
+                "serviceManagerConfirmState should first be called with SVC_STATE_RUNNING");
   zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_SUSPENDED,
                 "serviceManagerConfirmState should be called with SVC_STATE_SUSPENDED");
   zassert_equal(k_thread_suspend_mock_fake.call_count, 1,
@@ -378,8 +466,10 @@ ZTEST(adc_service_tests, test_run_suspend_success)
   /* Verify SUSPEND flow */
   zassert_equal(adcAcqUtilStopTrigger_fake.call_count, 1,
                 "adcAcqUtilStopTrigger should be called once");
-  zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
-                "serviceManagerConfirmState should be called once");
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 2,
+                "serviceManagerConfirmState should be called twice");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_history[0], SVC_STATE_RUNNING,
+                "serviceManagerConfirmState should first be called with SVC_STATE_RUNNING");
   zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_SUSPENDED,
                 "serviceManagerConfirmState should be called with SVC_STATE_SUSPENDED");
   zassert_equal(k_thread_suspend_mock_fake.call_count, 1,
@@ -402,8 +492,10 @@ ZTEST(adc_service_tests, test_run_unknown_ctrl_msg)
   /* Verify no stop/suspend actions taken */
   zassert_equal(adcAcqUtilStopTrigger_fake.call_count, 0,
                 "adcAcqUtilStopTrigger should not be called for unknown message");
-  zassert_equal(serviceManagerConfirmState_fake.call_count, 0,
-                "serviceManagerConfirmState should not be called for unknown message");
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
+                "serviceManagerConfirmState should only confirm the running state for unknown message");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_RUNNING,
+                "serviceManagerConfirmState should be called with SVC_STATE_RUNNING");
   /* Processing still happens (no early return) */
   zassert_equal(adcAcqUtilProcessData_fake.call_count, 2,
                 "adcAcqUtilProcessData should still be called for each iteration");
@@ -479,6 +571,9 @@ ZTEST(adc_service_tests, test_run_success)
 
   /* Setup: no ctrl message, all processing succeeds */
   k_msgq_get_mock_fake.custom_fake = k_msgq_get_no_message;
+  uint32_t dueMasks[] = {0x3, 0x4};
+
+  SET_RETURN_SEQ(adcAcqUtilGetDueChanMask, dueMasks, 2);
   adcAcqUtilProcessData_fake.return_val = 0;
   adcAcqUtilNotifySubscribers_fake.return_val = 0;
 
@@ -493,9 +588,19 @@ ZTEST(adc_service_tests, test_run_success)
   zassert_equal(k_msgq_get_mock_fake.arg2_history[1].ticks, expected_timeout.ticks,
                 "k_msgq_get should be called with K_MSEC(100) timeout");
 
-  /* Verify adcAcqUtilProcessData was called twice */
+  /* Verify adcAcqUtilProcessData was called twice with the due channels */
+  zassert_equal(adcAcqUtilGetDueChanMask_fake.call_count, 4,
+                "adcAcqUtilGetDueChanMask should be called once per format");
+  zassert_equal(adcAcqUtilGetDueChanMask_fake.arg0_history[0], ADC_ACQ_FORMAT_VOLT,
+                "adcAcqUtilGetDueChanMask should be called for the volt format");
+  zassert_equal(adcAcqUtilGetDueChanMask_fake.arg0_history[1], ADC_ACQ_FORMAT_MILLIVOLT,
+                "adcAcqUtilGetDueChanMask should be called for the millivolt format");
   zassert_equal(adcAcqUtilProcessData_fake.call_count, 2,
                 "adcAcqUtilProcessData should be called twice");
+  zassert_equal(adcAcqUtilProcessData_fake.arg0_history[0], 0x3,
+                "adcAcqUtilProcessData should be called with the due volt channels");
+  zassert_equal(adcAcqUtilProcessData_fake.arg1_history[0], 0x4,
+                "adcAcqUtilProcessData should be called with the due millivolt channels");
 
   /* Verify adcAcqUtilNotifySubscribers was called twice */
   zassert_equal(adcAcqUtilNotifySubscribers_fake.call_count, 2,
@@ -510,6 +615,59 @@ ZTEST(adc_service_tests, test_run_success)
                 "k_sleep should not be called");
 }
 
+/**
+ * @test The onRestart callback must re-create and start the ADC thread.
+ */
+ZTEST(adc_service_tests, test_onRestart_success)
+{
+  int result;
+
+  /* Setup */
+  k_thread_create_mock_fake.return_val = (k_tid_t)&thread;
+  k_thread_name_set_mock_fake.return_val = 0;
+
+  /* Execute */
+  result = onRestart();
+
+  /* Verify the thread is aborted, re-created under its name, then started */
+  zassert_equal(result, 0, "onRestart should return 0 on success");
+  zassert_equal(k_thread_abort_mock_fake.call_count, 1,
+                "k_thread_abort should be called once");
+  zassert_equal(k_thread_abort_mock_fake.arg0_val, &thread,
+                "k_thread_abort should be called with thread struct");
+  zassert_equal(k_thread_create_mock_fake.call_count, 1,
+                "k_thread_create should be called once");
+  zassert_equal(k_thread_create_mock_fake.arg0_val, &thread,
+                "k_thread_create should be called with thread struct");
+  zassert_str_equal(k_thread_name_set_mock_fake.arg1_val, "adcAcquisition",
+                    "k_thread_name_set should be called with service name");
+  zassert_equal(k_thread_start_mock_fake.call_count, 1,
+                "k_thread_start should be called once");
+  zassert_equal(adcAcqUtilStartTrigger_fake.call_count, 0,
+                "the running trigger should be left untouched");
+}
+
+/**
+ * @test The onRestart callback must return error when the thread name cannot be set.
+ */
+ZTEST(adc_service_tests, test_onRestart_name_failure)
+{
+  int result;
+
+  /* Setup: k_thread_name_set fails */
+  k_thread_create_mock_fake.return_val = (k_tid_t)&thread;
+  k_thread_name_set_mock_fake.return_val = -EINVAL;
+
+  /* Execute */
+  result = onRestart();
+
+  /* Verify */
+  zassert_equal(result, -EINVAL,
+                "onRestart should return error from k_thread_name_set");
+  zassert_equal(k_thread_start_mock_fake.call_count, 0,
+                "k_thread_start should not be called");
+}
+
 /**
  * @test The onStart callback must return error when adcAcqUtilStartTrigger fails.
  */
@@ -786,6 +944,38 @@ ZTEST(adc_service_tests, test_init_filter_init_failure)
                 "serviceManagerRegisterSrv should not be called");
 }
 
+/**
+ * @test The adcAcqInit function must return error when adcAcqUtilConfigFilter fails.
+ */
+ZTEST(adc_service_tests, test_init_filter_config_failure)
+{
+  int result;
+
+  /* Setup: filter init succeeds, channel filter configuration fails */
+  adcAcqUtilInitAdc_fake.return_val = 0;
+  adcAcqUtilInitSubscriptions_fake.return_val = 0;
+  adcAcqUtilGetChanCount_fake.return_val = 4;
+  adcAcqFilterInit_fake.return_val = 0;
+  adcAcqUtilConfigFilter_fake.return_val = -EINVAL;
+
+  /* Execute */
+  result = adcAcqInit();
+
+  /* Verify return value */
+  zassert_equal(result, -EINVAL,
+                "adcAcqInit should return error from adcAcqUtilConfigFilter");
+
+  /* Verify call sequence */
+  zassert_equal(adcAcqFilterInit_fake.call_count, 1,
+                "adcAcqFilterInit should be called once");
+  zassert_equal(adcAcqUtilConfigFilter_fake.call_count, 1,
+                "adcAcqUtilConfigFilter should be called once");
+  zassert_equal(k_thread_create_mock_fake.call_count, 0,
+                "k_thread_create should not be called");
+  zassert_equal(serviceManagerRegisterSrv_fake.call_count, 0,
+                "serviceManagerRegisterSrv should not be called");
+}
+
 /**
  * @test The adcAcqInit function must return error when k_thread_name_set fails.
  */
@@ -882,6 +1072,8 @@ ZTEST(adc_service_tests, test_init_success)
                 "adcAcqFilterInit should be called once");
   zassert_equal(adcAcqFilterInit_fake.arg0_val, 4,
                 "adcAcqFilterInit should be called with channel count 4");
+  zassert_equal(adcAcqUtilConfigFilter_fake.call_count, 1,
+                "adcAcqUtilConfigFilter should be called once");
 
   /* Verify k_thread_create was called with correct parameters */
   zassert_equal(k_thread_create_mock_fake.call_count, 1,
@@ -927,6 +1119,10 @@ ZTEST(adc_service_tests, test_init_success)
                 "descriptor suspend callback should be onSuspend");
   zassert_equal(captured_descriptor.resume, onResume,
                 "descriptor resume callback should be onResume");
+  zassert_equal(captured_descriptor.restart, onRestart,
+                "descriptor restart callback should be onRestart");
+  zassert_equal(captured_descriptor.maxRestarts, CONFIG_ENYA_ADC_ACQUISITION_MAX_RESTARTS,
+                "descriptor maxRestarts should match Kconfig");
 }
 
 /* Dummy callback for subscription tests */
@@ -982,6 +1178,45 @@ ZTEST(adc_service_tests, test_subscribe_success)
                 "adcAcqUtilAddSubscription should be called once");
   zassert_equal(adcAcqUtilAddSubscription_fake.arg0_val, dummyCallback,
                 "adcAcqUtilAddSubscription should be called with callback");
+  zassert_is_null(adcAcqUtilAddSubscription_fake.arg1_val,
+                  "adcAcqUtilAddSubscription should be called without options");
+}
+
+/**
+ * @test The adcAcqSubscribeWithOptions function must return -EINVAL when
+ * the options are NULL.
+ */
+ZTEST(adc_service_tests, test_subscribe_with_options_null_options)
+{
+  int result;
+
+  result = adcAcqSubscribeWithOptions(dummyCallback, NULL);
+
+  zassert_equal(result, -EINVAL,
+                "adcAcqSubscribeWithOptions should return -EINVAL for NULL options");
+  zassert_equal(adcAcqUtilAddSubscription_fake.call_count, 0,
+                "adcAcqUtilAddSubscription should not be called");
+}
+
+/**
+ * @test The adcAcqSubscribeWithOptions function must add a subscription
+ * with its options.
+ */
+ZTEST(adc_service_tests, test_subscribe_with_options_success)
+{
+  AdcSubOptions_t options = {.chanMask = 0x5, .periodMs = 500};
+  int result;
+
+  adcAcqUtilAddSubscription_fake.return_val = 0;
+
+  result = adcAcqSubscribeWithOptions(dummyCallback, &options);
+
+  zassert_equal(result, 0,
+                "adcAcqSubscribeWithOptions should return 0 on success");
+  zassert_equal(adcAcqUtilAddSubscription_fake.arg0_val, dummyCallback,
+                "adcAcqUtilAddSubscription should be called with callback");
+  zassert_equal(adcAcqUtilAddSubscription_fake.arg1_val, &options,
+                "adcAcqUtilAddSubscription should be called with the options");
 }
 
 /**
@@ -1032,6 +1267,23 @@ ZTEST(adc_service_tests, test_unsubscribe_success)
                 "adcAcqUtilRemoveSubscription should be called with callback");
 }
 
+/**
+ * @test The adcAcqReleaseData function must release the payload.
+ */
+ZTEST(adc_service_tests, test_release_data)
+{
+  SrvMsgPayload_t payload;
+
+  /* Execute */
+  adcAcqReleaseData(&payload);
+
+  /* Verify adcAcqUtilReleaseData was called with correct parameter */
+  zassert_equal(adcAcqUtilReleaseData_fake.call_count, 1,
+                "adcAcqUtilReleaseData should be called once");
+  zassert_equal(adcAcqUtilReleaseData_fake.arg0_val, &payload,
+                "adcAcqUtilReleaseData should be called with the payload");
+}
+
 /**
  * @test The adcAcqPauseSubscription function must return error when adcAcqUtilSetSubPauseState fails.
  */
@@ -1136,4 +1388,50 @@ ZTEST(adc_service_tests, test_unpause_subscription_success)
                 "adcAcqUtilSetSubPauseState should be called with false for unpause");
 }
 
+/**
+ * @test The adcAcqGetStats function must return the utility statistics.
+ */
+ZTEST(adc_service_tests, test_get_stats)
+{
+  AdcAcqStats_t stats;
+  int result;
+
+  adcAcqUtilGetStats_fake.return_val = -EINVAL;
+
+  result = adcAcqGetStats(&stats);
+
+  zassert_equal(result, -EINVAL,
+                "adcAcqGetStats should return the utility result");
+  zassert_equal(adcAcqUtilGetStats_fake.arg0_val, &stats,
+                "adcAcqUtilGetStats should be called with the statistics buffer");
+}
+
+/**
+ * @test The adcAcqResetStats function must reset the utility statistics.
+ */
+ZTEST(adc_service_tests, test_reset_stats)
+{
+  adcAcqResetStats();
+
+  zassert_equal(adcAcqUtilResetStats_fake.call_count, 1,
+                "adcAcqUtilResetStats should be called once");
+}
+
+/**
+ * @test The window functions must return -ENOTSUP without the window
+ * comparator.
+ */
+ZTEST(adc_service_tests, test_window_not_supported)
+{
+  AdcWindow_t window = {0};
+  AdcWindowZone_t zone;
+
+  zassert_equal(adcAcqSetWindow(0, &window), -ENOTSUP,
+                "adcAcqSetWindow should return -ENOTSUP");
+  zassert_equal(adcAcqClearWindow(0), -ENOTSUP,
+                "adcAcqClearWindow should return -ENOTSUP");
+  zassert_equal(adcAcqGetWindowZone(0, &zone), -ENOTSUP,
+                "adcAcqGetWindowZone should return -ENOTSUP");
+}
+
 ZTEST_SUITE(adc_service_tests, NULL, service_tests_setup, service_tests_before, NULL, NULL);
@@ -0,0 +1,519 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     ADC Acquisition Shared Payload Tests
+ *
+ *            Unit tests for the ADC acquisition shared subscription payloads.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Forward declare needed types without including driver headers */
+struct adc_dt_spec;
+struct adc_sequence;
+struct counter_top_cfg;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Wrap device_is_ready since it's defined by Zephyr */
+#define device_is_ready device_is_ready_mock
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Prevent filter header */
+#define ADC_ACQUISITION_FILTER
+
+/* Prevent ADC acquisition main header - we'll define types manually */
+#define ADC_ACQUISITION
+
+/* Prevent ADC and counter driver headers - they conflict with mocks */
+#define ZEPHYR_INCLUDE_DRIVERS_ADC_H_
+#define ZEPHYR_INCLUDE_DRIVERS_COUNTER_H_
+#define ZEPHYR_DEVICE_H_
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(adc_is_ready_dt) \
+  FAKE(adc_channel_setup_dt) \
+  FAKE(adc_read_async) \
+  FAKE(counter_us_to_ticks) \
+  FAKE(counter_set_top_value) \
+  FAKE(counter_start) \
+  FAKE(counter_stop) \
+  FAKE(device_is_ready_mock) \
+  FAKE(k_malloc) \
+  FAKE(adcAcqFilterPushRangeBlock) \
+  FAKE(adcAcqFilterConfigChannel) \
+  FAKE(adcAcqFilterGetThirdOrderData) \
+  FAKE(osMemoryPoolNew) \
+  FAKE(osMemoryPoolAlloc) \
+  FAKE(osMemoryPoolFree) \
+  FAKE(mock_subscription_callback)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(adcAcquisition, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Redefine LOG_ERR to avoid dereferencing invalid pointers in error messages */
+#undef LOG_ERR
+#define LOG_ERR(...) do {} while (0)
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_ADC_VREF_STM32_CCR 1
+#define CONFIG_ENYA_ADC_VREF_STABILIZATION_US 15
+#define CONFIG_ENYA_ADC_ACQUISITION_SHARED_PAYLOAD 1
+
+/* Mock STM32 registers */
+typedef struct
+{
+  uint32_t CCR;
+} ADC_Common_TypeDef;
+
+static ADC_Common_TypeDef mock_adc1_common __attribute__((unused)) = {0};
+#define ADC1_COMMON (&mock_adc1_common)
+#define ADC_CCR_VREFEN (1 << 22)
+
+/* Flag to simulate VREFEN bit not being set (hardware failure) */
+static bool mock_vrefen_fails = false;
+#define READ_ADC1_COMMON_CCR() (mock_vrefen_fails ? 0 : mock_adc1_common.CCR)
+
+/* Mock VREFINT_CAL_ADDR */
+static uint16_t mock_vrefint_cal __attribute__((unused)) = 1500;
+#define VREFINT_CAL_ADDR (&mock_vrefint_cal)
+
+/* Mock soc.h */
+#define _SOC__H_
+
+/* Mock ADC devicetree macro */
+#define ADC_DT_SPEC_GET_BY_IDX(node, idx) {.dev = (const struct device *)0x1000, .channel_id = idx, .resolution = 12, .oversampling = 0}
+
+/* Mock timer device and devicetree macros for adc-trigger alias */
+static const struct device mock_timer_device __attribute__((unused)) = {0};
+#undef DEVICE_DT_GET
+#define DEVICE_DT_GET(node) (&mock_timer_device)
+#undef DT_ALIAS
+#define DT_ALIAS(alias) alias
+
+/* Define types from adcAcquisition.h before including source */
+typedef struct
+{
+  uint32_t samplingRate;
+  int32_t filterTau;
+  uint32_t filterOrder;
+  uint32_t blockScanCount;
+} AdcConfig_t;
+
+typedef struct
+{
+  size_t activeSubCount;
+  size_t maxSubCount;
+  uint32_t notificationRate;
+} AdcSubConfig_t;
+
+typedef enum
+{
+  ADC_ACQ_FORMAT_VOLT = 0,
+  ADC_ACQ_FORMAT_MILLIVOLT,
+  ADC_ACQ_FORMAT_COUNT,
+} AdcDataFormat_t;
+
+typedef struct
+{
+  uint32_t chanMask;
+  uint32_t periodMs;
+  AdcDataFormat_t format;
+} AdcSubOptions_t;
+
+typedef struct
+{
+  int64_t elapsedMs;
+  uint32_t triggerCount;
+  uint32_t overrunCount;
+  uint32_t startErrorCount;
+  uint32_t filterErrorCount;
+  uint32_t blockCount;
+  uint32_t convTimeMinUs;
+  uint32_t convTimeMaxUs;
+  uint32_t latencyMinUs;
+  uint32_t latencyMaxUs;
+} AdcAcqStats_t;
+
+typedef struct SrvMsgPayload SrvMsgPayload_t;
+typedef int (*AdcSubCallback_t)(SrvMsgPayload_t *data);
+
+struct SrvMsgPayload {
+  osMemoryPoolId_t poolId;                          /**< Memory pool to return buffer to. */
+  size_t dataLen;                                   /**< Actual data length in bytes. */
+  uint8_t data[];                                   /**< Flexible array of data bytes. */
+};
+
+/* Provide minimal type definitions that adcAcquisitionUtil.c needs */
+enum adc_action {
+  ADC_ACTION_CONTINUE = 0,
+  ADC_ACTION_FINISH = 1,
+};
+
+struct adc_sequence_options {
+  uint16_t extra_samplings;
+  uint16_t interval_us;
+  enum adc_action (*callback)(const struct device *dev, const struct adc_sequence *sequence, uint16_t sampling_index);
+  void *user_data;
+};
+
+struct adc_sequence {
+  struct adc_sequence_options *options;
+  uint32_t channels;
+  void *buffer;
+  size_t buffer_size;
+  uint8_t resolution;
+  uint8_t oversampling;
+  bool calibrate;
+};
+
+struct adc_dt_spec {
+  const struct device *dev;
+  uint8_t channel_id;
+  uint8_t resolution;
+  uint8_t oversampling;
+};
+
+struct counter_top_cfg {
+  uint32_t flags;
+  uint32_t ticks;
+  void (*callback)(const struct device *dev, void *user_data);
+  void *user_data;
+};
+
+/* Mock ADC functions */
+FAKE_VALUE_FUNC(bool, adc_is_ready_dt, const struct adc_dt_spec *);
+FAKE_VALUE_FUNC(int, adc_channel_setup_dt, const struct adc_dt_spec *);
+FAKE_VALUE_FUNC(int, adc_read_async, const struct device *, const struct adc_sequence *, struct k_poll_signal *);
+
+/* Mock counter/timer functions */
+FAKE_VALUE_FUNC(uint32_t, counter_us_to_ticks, const struct device *, uint64_t);
+FAKE_VALUE_FUNC(int, counter_set_top_value, const struct device *, const struct counter_top_cfg *);
+FAKE_VALUE_FUNC(int, counter_start, const struct device *);
+FAKE_VALUE_FUNC(int, counter_stop, const struct device *);
+
+/* Mock device functions */
+FAKE_VALUE_FUNC(bool, device_is_ready_mock, const struct device *);
+
+/* Mock memory functions */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+
+/* Mock filter functions */
+FAKE_VALUE_FUNC(int, adcAcqFilterPushRangeBlock, const uint16_t *, size_t, size_t, size_t);
+FAKE_VALUE_FUNC(int, adcAcqFilterConfigChannel, size_t, int32_t, uint32_t);
+FAKE_VALUE_FUNC(int, adcAcqFilterGetThirdOrderData, size_t, int32_t *);
+
+/* Mock osMemoryPool functions */
+FAKE_VALUE_FUNC(osMemoryPoolId_t, osMemoryPoolNew, uint32_t, uint32_t, void *);
+FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
+FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+/* Mock subscription callback */
+FAKE_VALUE_FUNC(int, mock_subscription_callback, SrvMsgPayload_t *);
+
+/* Override VREF readback for unit testing (mock_vrefen_fails simulation) */
+#define STM32_ADC_VREF_REG_READ READ_ADC1_COMMON_CCR()
+
+/* Include utility implementation */
+#include "adcAcquisitionUtil.c"
+
+/**
+ * @brief   The test pool block count.
+ */
+#define TEST_POOL_BLOCK_COUNT                                   4
+
+/**
+ * @brief   The test pool block size.
+ */
+#define TEST_POOL_BLOCK_SIZE                                    64
+
+/**
+ * @brief   The test subscriptions.
+ */
+static AdcSubEntry_t testSubscriptions[3];
+
+/**
+ * @brief   The test pool blocks.
+ */
+static uint8_t testPool[TEST_POOL_BLOCK_COUNT][TEST_POOL_BLOCK_SIZE] __aligned(8);
+
+/**
+ * @brief   The test pool allocated block count.
+ */
+static size_t testPoolAllocCount;
+
+/**
+ * @brief   The test volt values.
+ */
+static float testVoltValues[2] = {1.5f, 3.0f};
+
+/**
+ * @brief   The test pool allocation, returning the next block.
+ */
+static void *osMemoryPoolAlloc_custom(osMemoryPoolId_t mp_id, uint32_t timeout)
+{
+  ARG_UNUSED(mp_id);
+  ARG_UNUSED(timeout);
+
+  if(testPoolAllocCount >= TEST_POOL_BLOCK_COUNT)
+    return NULL;
+
+  return testPool[testPoolAllocCount++];
+}
+
+/**
+ * @brief   Set a test subscription.
+ */
+static void setTestSubscription(size_t subIdx, uint32_t chanMask)
+{
+  testSubscriptions[subIdx].callback = mock_subscription_callback;
+  testSubscriptions[subIdx].isPaused = false;
+  testSubscriptions[subIdx].chanMask = chanMask;
+  testSubscriptions[subIdx].decimation = 1;
+  testSubscriptions[subIdx].countdown = 1;
+  subConfig.activeSubCount = subIdx + 1;
+}
+
+/**
+ * Test setup function.
+ */
+static void *shared_tests_setup(void)
+{
+  return NULL;
+}
+
+/**
+ * Test before function.
+ */
+static void shared_tests_before(void *fixture)
+{
+  extern size_t chanCount;
+  extern uint16_t *buffer;
+  extern AdcConfig_t config;
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  testPoolAllocCount = 0;
+  FFF_RESET_HISTORY();
+
+  /* Reset mock ADC register */
+  mock_adc1_common.CCR = 0;
+  mock_vrefen_fails = false;
+
+  /* Reset chanCount - it's a static variable in adcAcquisitionUtil.c */
+  chanCount = 0;
+
+  /* Reset the controller groups */
+  memset(groups, 0, sizeof(groups));
+  groupCount = 0;
+
+  /* Reset buffer pointer */
+  buffer = NULL;
+
+  /* Reset config structure */
+  memset(&config, 0, sizeof(config));
+  config.blockScanCount = 1;
+
+  /* Reset the subscriptions */
+  memset(testSubscriptions, 0, sizeof(testSubscriptions));
+  memset(testPool, 0, sizeof(testPool));
+  subscriptions = testSubscriptions;
+  subConfig.activeSubCount = 0;
+  subDataPool = (osMemoryPoolId_t)0x1000;
+  chanCount = 2;
+  voltValues = testVoltValues;
+
+  osMemoryPoolAlloc_fake.custom_fake = osMemoryPoolAlloc_custom;
+}
+
+/**
+ * @test The pool block must hold the shared payload header.
+ */
+ZTEST(adc_shared_tests, test_payload_block_size)
+{
+  zassert_equal(getPayloadBlockSize(),
+                sizeof(AdcPayloadHeader_t) + sizeof(SrvMsgPayload_t) + 2 * sizeof(float),
+                "The block size should include the payload header");
+}
+
+/**
+ * @test The subscribers of the same channels must share one payload.
+ */
+ZTEST(adc_shared_tests, test_notify_same_mask_shares_payload)
+{
+  SrvMsgPayload_t *payload;
+  float *values;
+
+  setTestSubscription(0, 0x3);
+  setTestSubscription(1, 0x3);
+
+  zassert_equal(adcAcqUtilNotifySubscribers(), 0,
+                "adcAcqUtilNotifySubscribers should return 0");
+
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
+                "The payload should be allocated once");
+  zassert_equal(mock_subscription_callback_fake.call_count, 2,
+                "Both subscribers should be notified");
+
+  payload = mock_subscription_callback_fake.arg0_history[0];
+  zassert_equal(mock_subscription_callback_fake.arg0_history[1], payload,
+                "Both subscribers should receive the same payload");
+  zassert_equal((uint8_t *)getPayloadHeader(payload), testPool[0],
+                "The payload should follow its header in the block");
+  zassert_is_null(payload->poolId,
+                  "A shared payload should not expose its pool");
+  zassert_equal(payload->dataLen, 2 * sizeof(float),
+                "The payload should hold both channels");
+
+  values = (float *)payload->data;
+  zassert_within(values[0], 1.5f, 0.001f, "Channel 0 should be packed first");
+  zassert_within(values[1], 3.0f, 0.001f, "Channel 1 should be packed second");
+
+  zassert_equal(atomic_get(&getPayloadHeader(payload)->refCount), 2,
+                "Only the subscriber references should remain");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "The payload should not be freed while referenced");
+}
+
+/**
+ * @test The subscribers of different channels must receive their own payload.
+ */
+ZTEST(adc_shared_tests, test_notify_different_masks)
+{
+  setTestSubscription(0, 0x3);
+  setTestSubscription(1, 0x2);
+  setTestSubscription(2, 0x3);
+
+  adcAcqUtilNotifySubscribers();
+
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 2,
+                "One payload should be allocated per channel mask");
+  zassert_equal(mock_subscription_callback_fake.arg0_history[0],
+                mock_subscription_callback_fake.arg0_history[2],
+                "The subscribers of mask 0x3 should share their payload");
+  zassert_not_equal(mock_subscription_callback_fake.arg0_history[0],
+                    mock_subscription_callback_fake.arg0_history[1],
+                    "The subscriber of mask 0x2 should have its own payload");
+  zassert_equal(mock_subscription_callback_fake.arg0_history[1]->dataLen, sizeof(float),
+                "The mask 0x2 payload should hold one channel");
+}
+
+/**
+ * @test The subscribers of the same channels in different formats must
+ * receive their own payload.
+ */
+ZTEST(adc_shared_tests, test_notify_different_formats)
+{
+  extern int32_t *milliVoltValues;
+  int32_t testMilliVoltValues[2] = {1500, 3000};
+
+  milliVoltValues = testMilliVoltValues;
+  setTestSubscription(0, 0x3);
+  setTestSubscription(1, 0x3);
+  testSubscriptions[1].format = ADC_ACQ_FORMAT_MILLIVOLT;
+
+  adcAcqUtilNotifySubscribers();
+
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 2,
+                "One payload should be allocated per format");
+  zassert_equal(((int32_t *)mock_subscription_callback_fake.arg0_history[1]->data)[1], 3000,
+                "The millivolt subscriber should receive the millivolt values");
+
+  milliVoltValues = NULL;
+}
+
+/**
+ * @test A subscriber not due must not hold a reference on the payload.
+ */
+ZTEST(adc_shared_tests, test_notify_skips_not_due)
+{
+  SrvMsgPayload_t *payload;
+
+  setTestSubscription(0, 0x3);
+  setTestSubscription(1, 0x3);
+  testSubscriptions[0].countdown = 2;
+
+  adcAcqUtilNotifySubscribers();
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Only the due subscriber should be notified");
+
+  payload = mock_subscription_callback_fake.arg0_val;
+  zassert_equal(atomic_get(&getPayloadHeader(payload)->refCount), 1,
+                "Only the due subscriber reference should remain");
+}
+
+/**
+ * @test The payload must be freed once its last reference is released.
+ */
+ZTEST(adc_shared_tests, test_release_last_reference_frees)
+{
+  SrvMsgPayload_t *payload;
+
+  setTestSubscription(0, 0x3);
+  setTestSubscription(1, 0x3);
+
+  adcAcqUtilNotifySubscribers();
+  payload = mock_subscription_callback_fake.arg0_val;
+
+  adcAcqUtilReleaseData(payload);
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "The payload should not be freed while still referenced");
+
+  adcAcqUtilReleaseData(payload);
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "The payload should be freed by its last release");
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, subDataPool,
+                "The payload should be freed to the subscription pool");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, testPool[0],
+                "The whole block should be freed");
+}
+
+/**
+ * @test A failed callback must release its reference.
+ */
+ZTEST(adc_shared_tests, test_notify_callback_failure_releases)
+{
+  setTestSubscription(0, 0x3);
+  mock_subscription_callback_fake.return_val = -EIO;
+
+  adcAcqUtilNotifySubscribers();
+
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "The payload should be freed when its only subscriber fails");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, testPool[0],
+                "The whole block should be freed");
+}
+
+/**
+ * @test A failed pool allocation must skip the subscribers of that payload.
+ */
+ZTEST(adc_shared_tests, test_notify_alloc_failure)
+{
+  setTestSubscription(0, 0x3);
+  osMemoryPoolAlloc_fake.custom_fake = NULL;
+  osMemoryPoolAlloc_fake.return_val = NULL;
+
+  zassert_equal(adcAcqUtilNotifySubscribers(), 0,
+                "adcAcqUtilNotifySubscribers should return 0 on allocation failure");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0,
+                "The subscriber should not be notified");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "Nothing should be freed");
+}
+
+ZTEST_SUITE(adc_shared_tests, NULL, shared_tests_setup, shared_tests_before, NULL, NULL);
@@ -51,12 +51,17 @@ typedef void *osMemoryPoolId_t;
   FAKE(counter_stop) \
   FAKE(device_is_ready_mock) \
   FAKE(k_malloc) \
-  FAKE(adcAcqFilterPushData) \
+  FAKE(adcAcqFilterPushRangeBlock) \
+  FAKE(adcAcqWindowCheckRange) \
+  FAKE(adcAcqFilterConfigChannel) \
   FAKE(adcAcqFilterGetThirdOrderData) \
   FAKE(osMemoryPoolNew) \
   FAKE(osMemoryPoolAlloc) \
   FAKE(osMemoryPoolFree) \
-  FAKE(mock_subscription_callback)
+  FAKE(mock_subscription_callback) \
+  FAKE(k_uptime_get_mock) \
+  FAKE(k_cycle_get_32_mock) \
+  FAKE(k_cyc_to_us_floor32_mock)
 
 /* Setup logging */
 #include <zephyr/logging/log.h>
@@ -72,6 +77,13 @@ LOG_MODULE_REGISTER(adcAcquisition, LOG_LEVEL_DBG);
 /* Mock Kconfig options */
 #define CONFIG_ENYA_ADC_VREF_STM32_CCR 1
 #define CONFIG_ENYA_ADC_VREF_STABILIZATION_US 15
+#define CONFIG_ENYA_ADC_ACQUISITION_STATS_TIMING 1
+#define CONFIG_ENYA_ADC_ACQUISITION_WINDOW 1
+
+/* Wrap the kernel time functions to use mocks */
+#define k_uptime_get k_uptime_get_mock
+#define k_cycle_get_32 k_cycle_get_32_mock
+#define k_cyc_to_us_floor32 k_cyc_to_us_floor32_mock
 
 /* Mock STM32 registers */
 typedef struct
@@ -109,14 +121,45 @@ typedef struct
 {
   uint32_t samplingRate;
   int32_t filterTau;
+  uint32_t filterOrder;
+  uint32_t blockScanCount;
 } AdcConfig_t;
 
 typedef struct
 {
   size_t activeSubCount;
   size_t maxSubCount;
+  uint32_t notificationRate;
 } AdcSubConfig_t;
 
+typedef enum
+{
+  ADC_ACQ_FORMAT_VOLT = 0,
+  ADC_ACQ_FORMAT_MILLIVOLT,
+  ADC_ACQ_FORMAT_COUNT,
+} AdcDataFormat_t;
+
+typedef struct
+{
+  uint32_t chanMask;
+  uint32_t periodMs;
+  AdcDataFormat_t format;
+} AdcSubOptions_t;
+
+typedef struct
+{
+  int64_t elapsedMs;
+  uint32_t triggerCount;
+  uint32_t overrunCount;
+  uint32_t startErrorCount;
+  uint32_t filterErrorCount;
+  uint32_t blockCount;
+  uint32_t convTimeMinUs;
+  uint32_t convTimeMaxUs;
+  uint32_t latencyMinUs;
+  uint32_t latencyMaxUs;
+} AdcAcqStats_t;
+
 typedef struct SrvMsgPayload SrvMsgPayload_t;
 typedef int (*AdcSubCallback_t)(SrvMsgPayload_t *data);
 
@@ -181,7 +224,11 @@ FAKE_VALUE_FUNC(bool, device_is_ready_mock, const struct device *);
 FAKE_VALUE_FUNC(void *, k_malloc, size_t);
 
 /* Mock filter functions */
-FAKE_VALUE_FUNC(int, adcAcqFilterPushData, size_t, int32_t, int32_t);
+FAKE_VALUE_FUNC(int, adcAcqFilterPushRangeBlock, const uint16_t *, size_t, size_t, size_t);
+
+/* Mock window functions */
+FAKE_VOID_FUNC(adcAcqWindowCheckRange, size_t, size_t);
+FAKE_VALUE_FUNC(int, adcAcqFilterConfigChannel, size_t, int32_t, uint32_t);
 FAKE_VALUE_FUNC(int, adcAcqFilterGetThirdOrderData, size_t, int32_t *);
 
 /* Mock osMemoryPool functions */
@@ -192,6 +239,11 @@ FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
 /* Mock subscription callback */
 FAKE_VALUE_FUNC(int, mock_subscription_callback, SrvMsgPayload_t *);
 
+/* Mock kernel time functions */
+FAKE_VALUE_FUNC(int64_t, k_uptime_get_mock);
+FAKE_VALUE_FUNC(uint32_t, k_cycle_get_32_mock);
+FAKE_VALUE_FUNC(uint32_t, k_cyc_to_us_floor32_mock, uint32_t);
+
 /* Override VREF readback for unit testing (mock_vrefen_fails simulation) */
 #define STM32_ADC_VREF_REG_READ READ_ADC1_COMMON_CCR()
 
@@ -212,7 +264,6 @@ static void *util_tests_setup(void)
 static void util_tests_before(void *fixture)
 {
   extern size_t chanCount;
-  extern volatile bool adcBusy;
   extern uint16_t *buffer;
   extern AdcConfig_t config;
 
@@ -226,14 +277,24 @@ static void util_tests_before(void *fixture)
   /* Reset chanCount - it's a static variable in adcAcquisitionUtil.c */
   chanCount = 0;
 
-  /* Reset adcBusy flag */
-  adcBusy = false;
+  /* Reset the controller groups to a single group */
+  memset(groups, 0, sizeof(groups));
+  groupCount = 1;
+  groups[0].dev = (const struct device *)0x1000;
+  groups[0].divider = 1;
+  groups[0].countdown = 1;
+  groups[0].sequence.options = &groups[0].options;
+  groups[0].options.user_data = groups;
 
   /* Reset buffer pointer */
   buffer = NULL;
 
   /* Reset config structure */
   memset(&config, 0, sizeof(config));
+  config.blockScanCount = 1;
+
+  /* Reset the statistics */
+  adcAcqUtilResetStats();
 }
 
 /**
@@ -288,7 +349,6 @@ ZTEST(adc_util_tests, test_configure_channels_setup_failure)
 ZTEST(adc_util_tests, test_configure_channels_success)
 {
   extern int configureChannels(void);
-  extern struct adc_sequence sequence;
   extern const struct adc_dt_spec adcChannels[];
   int result;
 
@@ -313,24 +373,23 @@ ZTEST(adc_util_tests, test_configure_channels_success)
                 "adc_channel_setup_dt first call should be with adcChannels[0]");
   zassert_equal(adc_channel_setup_dt_fake.arg0_history[1], &adcChannels[1],
                 "adc_channel_setup_dt second call should be with adcChannels[1]");
-  zassert_equal(sequence.channels, (BIT(0) | BIT(1)),
+  zassert_equal(groups[0].sequence.channels, (BIT(0) | BIT(1)),
                 "sequence.channels should be set to 0x03 (BIT(0) | BIT(1))");
 }
 
 /**
- * @test The triggerConversion function must clear adcBusy flag when
+ * @test The triggerConversion function must clear isBusy flag when
  * adc_read_async fails.
  */
 ZTEST(adc_util_tests, test_trigger_conversion_adc_read_failure)
 {
   extern void triggerConversion(const struct device *dev, void *user_data);
-  extern volatile bool adcBusy;
 
   /* Configure mock to return error from adc_read_async */
   adc_read_async_fake.return_val = -EIO;
 
-  /* Ensure adcBusy starts as false */
-  adcBusy = false;
+  /* Ensure isBusy starts as false */
+  groups[0].isBusy = false;
 
   /* Call triggerConversion - should fail */
   triggerConversion((const struct device *)0x1000, NULL);
@@ -339,9 +398,9 @@ ZTEST(adc_util_tests, test_trigger_conversion_adc_read_failure)
   zassert_equal(adc_read_async_fake.call_count, 1,
                 "adc_read_async should be called once");
 
-  /* Verify adcBusy is cleared on error */
-  zassert_false(adcBusy,
-                "adcBusy should be cleared when adc_read_async fails");
+  /* Verify isBusy is cleared on error */
+  zassert_false(groups[0].isBusy,
+                "isBusy should be cleared when adc_read_async fails");
 }
 
 /**
@@ -351,10 +410,9 @@ ZTEST(adc_util_tests, test_trigger_conversion_adc_read_failure)
 ZTEST(adc_util_tests, test_trigger_conversion_adc_busy)
 {
   extern void triggerConversion(const struct device *dev, void *user_data);
-  extern volatile bool adcBusy;
 
-  /* Set adcBusy to true to simulate ADC already busy */
-  adcBusy = true;
+  /* Set isBusy to true to simulate ADC already busy */
+  groups[0].isBusy = true;
 
   /* Call triggerConversion - should return early without calling adc_read_async */
   triggerConversion((const struct device *)0x1000, NULL);
@@ -363,9 +421,9 @@ ZTEST(adc_util_tests, test_trigger_conversion_adc_busy)
   zassert_equal(adc_read_async_fake.call_count, 0,
                 "adc_read_async should not be called when ADC is busy");
 
-  /* Verify adcBusy is still true */
-  zassert_true(adcBusy,
-               "adcBusy should remain true after skipping conversion");
+  /* Verify isBusy is still true */
+  zassert_true(groups[0].isBusy,
+               "isBusy should remain true after skipping conversion");
 }
 
 /**
@@ -375,18 +433,15 @@ ZTEST(adc_util_tests, test_trigger_conversion_adc_busy)
 ZTEST(adc_util_tests, test_trigger_conversion_success)
 {
   extern void triggerConversion(const struct device *dev, void *user_data);
-  extern volatile bool adcBusy;
-  extern const struct device *adc;
-  extern struct adc_sequence sequence;
 
   /* Set up adc device pointer (matches ADC_DT_SPEC_GET_BY_IDX mock) */
-  adc = (const struct device *)0x1000;
+  groups[0].dev = (const struct device *)0x1000;
 
   /* Configure mock to return success from adc_read_async */
   adc_read_async_fake.return_val = 0;
 
-  /* Ensure adcBusy starts as false */
-  adcBusy = false;
+  /* Ensure isBusy starts as false */
+  groups[0].isBusy = false;
 
   /* Call triggerConversion - should succeed */
   triggerConversion((const struct device *)0x1000, NULL);
@@ -394,16 +449,16 @@ ZTEST(adc_util_tests, test_trigger_conversion_success)
   /* Verify adc_read_async was called once */
   zassert_equal(adc_read_async_fake.call_count, 1,
                 "adc_read_async should be called once");
-  zassert_equal(adc_read_async_fake.arg0_val, adc,
+  zassert_equal(adc_read_async_fake.arg0_val, groups[0].dev,
                 "adc_read_async should be called with adc device");
-  zassert_equal(adc_read_async_fake.arg1_val, &sequence,
+  zassert_equal(adc_read_async_fake.arg1_val, &groups[0].sequence,
                 "adc_read_async should be called with sequence pointer");
   zassert_is_null(adc_read_async_fake.arg2_val,
                   "adc_read_async should be called with NULL signal");
 
-  /* Verify adcBusy is set to true */
-  zassert_true(adcBusy,
-               "adcBusy should be true after successful conversion start");
+  /* Verify isBusy is set to true */
+  zassert_true(groups[0].isBusy,
+               "isBusy should be true after successful conversion start");
 }
 
 /**
@@ -474,105 +529,259 @@ ZTEST(adc_util_tests, test_configure_timer_success)
 }
 
 /**
- * @test The adcSeqCallback function must clear adcBusy flag and
+ * @test The configureTimer function must set the timer period to
+ * a whole block of scans.
+ */
+ZTEST(adc_util_tests, test_configure_timer_block)
+{
+  extern int configureTimer(void);
+  extern AdcConfig_t config;
+  int result;
+
+  config.samplingRate = 100;
+  config.blockScanCount = 8;
+  device_is_ready_mock_fake.return_val = true;
+
+  result = configureTimer();
+
+  zassert_equal(result, 0,
+                "configureTimer should return 0 on success");
+  zassert_equal(counter_us_to_ticks_fake.arg1_val, 800,
+                "counter_us_to_ticks should be called with the block period");
+}
+
+/**
+ * @test The adcSeqCallback function must clear isBusy flag and
  * return ADC_ACTION_FINISH even when filter push fails.
  */
 ZTEST(adc_util_tests, test_adc_seq_callback_filter_push_failure)
 {
   extern enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex);
-  extern volatile bool adcBusy;
   extern size_t chanCount;
-  extern uint16_t *buffer;
   uint16_t test_buffer[2];
   enum adc_action result;
 
   /* Set up test state */
   chanCount = 2;
-  adcBusy = true;
+  groups[0].isBusy = true;
+  groups[0].chanCount = 2;
+  groups[0].sequence.buffer = test_buffer;
 
-  /* Initialize buffer with test data */
-  test_buffer[0] = 1234;
-  test_buffer[1] = 5678;
-  buffer = test_buffer;
-
-  /* Configure mock to return error from adcAcqFilterPushData */
-  adcAcqFilterPushData_fake.return_val = -EIO;
+  /* Configure mock to return error from adcAcqFilterPushRangeBlock */
+  adcAcqFilterPushRangeBlock_fake.return_val = -EINVAL;
 
   /* Call adcSeqCallback */
-  result = adcSeqCallback((const struct device *)0x1000, NULL, 0);
+  result = adcSeqCallback((const struct device *)0x1000, &groups[0].sequence, 0);
 
-  /* Verify filter push was called for each channel */
-  zassert_equal(adcAcqFilterPushData_fake.call_count, 2,
-                "adcAcqFilterPushData should be called twice for 2 channels");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.call_count, 1,
+                "adcAcqFilterPushRangeBlock should be called once");
 
-  /* Verify adcBusy is cleared even on error */
-  zassert_false(adcBusy,
-                "adcBusy should be cleared even when filter push fails");
+  /* Verify isBusy is cleared even on error */
+  zassert_false(groups[0].isBusy,
+                "isBusy should be cleared even when filter push fails");
 
   /* Verify function returns ADC_ACTION_FINISH */
   zassert_equal(result, ADC_ACTION_FINISH,
                 "adcSeqCallback should return ADC_ACTION_FINISH");
-
-  /* Clean up */
-  buffer = NULL;
 }
 
 /**
  * @test The adcSeqCallback function must successfully push data to
- * filters and clear adcBusy flag.
+ * filters and clear isBusy flag.
  */
 ZTEST(adc_util_tests, test_adc_seq_callback_success)
 {
   extern enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex);
-  extern volatile bool adcBusy;
   extern size_t chanCount;
-  extern uint16_t *buffer;
   extern AdcConfig_t config;
   uint16_t test_buffer[2];
   enum adc_action result;
 
   /* Set up test state */
   chanCount = 2;
-  adcBusy = true;
-  config.filterTau = 100;
-
-  /* Initialize buffer with test data */
-  test_buffer[0] = 1234;
-  test_buffer[1] = 5678;
-  buffer = test_buffer;
+  groups[0].isBusy = true;
+  groups[0].chanCount = 2;
+  groups[0].sequence.buffer = test_buffer;
 
-  /* Configure mock to return success from adcAcqFilterPushData */
-  adcAcqFilterPushData_fake.return_val = 0;
+  /* Configure mock to return success from adcAcqFilterPushRangeBlock */
+  adcAcqFilterPushRangeBlock_fake.return_val = 0;
 
   /* Call adcSeqCallback */
-  result = adcSeqCallback((const struct device *)0x1000, NULL, 0);
-
-  /* Verify filter push was called for each channel with correct parameters */
-  zassert_equal(adcAcqFilterPushData_fake.call_count, 2,
-                "adcAcqFilterPushData should be called twice for 2 channels");
-  zassert_equal(adcAcqFilterPushData_fake.arg0_history[0], 0,
-                "First call should be for channel 0");
-  zassert_equal(adcAcqFilterPushData_fake.arg1_history[0], 1234,
-                "First call should use buffer[0] value");
-  zassert_equal(adcAcqFilterPushData_fake.arg2_history[0], 100,
-                "First call should use config.filterTau");
-  zassert_equal(adcAcqFilterPushData_fake.arg0_history[1], 1,
-                "Second call should be for channel 1");
-  zassert_equal(adcAcqFilterPushData_fake.arg1_history[1], 5678,
-                "Second call should use buffer[1] value");
-  zassert_equal(adcAcqFilterPushData_fake.arg2_history[1], 100,
-                "Second call should use config.filterTau");
-
-  /* Verify adcBusy is cleared */
-  zassert_false(adcBusy,
-                "adcBusy should be cleared after successful conversion");
+  result = adcSeqCallback((const struct device *)0x1000, &groups[0].sequence, 0);
+
+  /* Verify the single scan block was pushed with correct parameters */
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.call_count, 1,
+                "adcAcqFilterPushRangeBlock should be called once");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg0_val, test_buffer,
+                "adcAcqFilterPushRangeBlock should be called with the ADC buffer");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg1_val, 1,
+                "adcAcqFilterPushRangeBlock should be called with a single scan");
+
+  /* Verify isBusy is cleared */
+  zassert_false(groups[0].isBusy,
+                "isBusy should be cleared after successful conversion");
 
   /* Verify function returns ADC_ACTION_FINISH */
   zassert_equal(result, ADC_ACTION_FINISH,
                 "adcSeqCallback should return ADC_ACTION_FINISH");
+}
 
-  /* Clean up */
-  buffer = NULL;
+/**
+ * @test The adcSeqCallback function must continue the sequence
+ * without pushing data until the block is complete.
+ */
+ZTEST(adc_util_tests, test_adc_seq_callback_block_incomplete)
+{
+  extern enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex);
+  extern size_t chanCount;
+  extern AdcConfig_t config;
+  enum adc_action result;
+
+  /* Set up test state */
+  chanCount = 2;
+  groups[0].isBusy = true;
+  config.blockScanCount = 3;
+
+  for(uint16_t i = 0; i < 2; ++i)
+  {
+    result = adcSeqCallback((const struct device *)0x1000, &groups[0].sequence, i);
+    zassert_equal(result, ADC_ACTION_CONTINUE,
+                  "adcSeqCallback should return ADC_ACTION_CONTINUE before the last scan");
+  }
+
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.call_count, 0,
+                "adcAcqFilterPushRangeBlock should not be called before the last scan");
+  zassert_true(groups[0].isBusy,
+               "isBusy should stay set until the block is complete");
+}
+
+/**
+ * @test The adcSeqCallback function must push the complete block
+ * at once and clear isBusy flag.
+ */
+ZTEST(adc_util_tests, test_adc_seq_callback_block_complete)
+{
+  extern enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex);
+  extern size_t chanCount;
+  extern AdcConfig_t config;
+  uint16_t test_buffer[6];
+  enum adc_action result;
+
+  /* Set up test state */
+  chanCount = 2;
+  groups[0].isBusy = true;
+  config.blockScanCount = 3;
+  groups[0].chanCount = 2;
+  groups[0].sequence.buffer = test_buffer;
+
+  result = adcSeqCallback((const struct device *)0x1000, &groups[0].sequence, 2);
+
+  zassert_equal(result, ADC_ACTION_FINISH,
+                "adcSeqCallback should return ADC_ACTION_FINISH after the last scan");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.call_count, 1,
+                "adcAcqFilterPushRangeBlock should be called once per block");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg0_val, test_buffer,
+                "adcAcqFilterPushRangeBlock should be called with the ADC buffer");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg1_val, 3,
+                "adcAcqFilterPushRangeBlock should be called with the block scan count");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg2_val, 0,
+                "adcAcqFilterPushRangeBlock should start at the group first channel");
+  zassert_equal(adcAcqFilterPushRangeBlock_fake.arg3_val, 2,
+                "adcAcqFilterPushRangeBlock should cover the group channels");
+  zassert_false(groups[0].isBusy,
+                "isBusy should be cleared after the block is complete");
+}
+
+/**
+ * @test The adcSeqCallback function must compare the group windows once
+ * its block is filtered.
+ */
+ZTEST(adc_util_tests, test_adc_seq_callback_window_check)
+{
+  extern enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex);
+  extern AdcConfig_t config;
+
+  config.blockScanCount = 2;
+  groups[0].chanCount = 2;
+
+  adcSeqCallback((const struct device *)0x1000, &groups[0].sequence, 0);
+  zassert_equal(adcAcqWindowCheckRange_fake.call_count, 0,
+                "The windows should not be compared before the last scan");
+
+  adcSeqCallback((const struct device *)0x1000, &groups[0].sequence, 1);
+  zassert_equal(adcAcqWindowCheckRange_fake.call_count, 1,
+                "The windows should be compared once per block");
+  zassert_equal(adcAcqWindowCheckRange_fake.arg0_val, 0,
+                "The windows should start at the group first channel");
+  zassert_equal(adcAcqWindowCheckRange_fake.arg1_val, 2,
+                "The windows should cover the group channels");
+}
+
+/**
+ * @test The adcSeqCallback function must not compare the windows of a
+ * block rejected by the filter.
+ */
+ZTEST(adc_util_tests, test_adc_seq_callback_window_filter_error)
+{
+  extern enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex);
+
+  adcAcqFilterPushRangeBlock_fake.return_val = -EINVAL;
+
+  adcSeqCallback((const struct device *)0x1000, &groups[0].sequence, 0);
+
+  zassert_equal(adcAcqWindowCheckRange_fake.call_count, 0,
+                "The windows should not be compared on filter error");
+}
+
+/**
+ * @test The adcAcqUtilConfigFilter function must configure each channel
+ * with the default tau and order when devicetree has no filter setting.
+ */
+ZTEST(adc_util_tests, test_config_filter_defaults)
+{
+  extern size_t chanCount;
+  extern AdcConfig_t config;
+  int result;
+
+  chanCount = 2;
+  config.filterTau = 42;
+  config.filterOrder = 1;
+
+  result = adcAcqUtilConfigFilter();
+
+  zassert_equal(result, 0,
+                "adcAcqUtilConfigFilter should return 0 on success");
+  zassert_equal(adcAcqFilterConfigChannel_fake.call_count, 2,
+                "adcAcqFilterConfigChannel should be called for each channel");
+  for(size_t i = 0; i < 2; ++i)
+  {
+    zassert_equal(adcAcqFilterConfigChannel_fake.arg0_history[i], i,
+                  "adcAcqFilterConfigChannel should be called in channel order");
+    zassert_equal(adcAcqFilterConfigChannel_fake.arg1_history[i], 42,
+                  "adcAcqFilterConfigChannel should use config.filterTau");
+    zassert_equal(adcAcqFilterConfigChannel_fake.arg2_history[i], 1,
+                  "adcAcqFilterConfigChannel should use config.filterOrder");
+  }
+}
+
+/**
+ * @test The adcAcqUtilConfigFilter function must return the error when
+ * a channel filter configuration fails.
+ */
+ZTEST(adc_util_tests, test_config_filter_failure)
+{
+  extern size_t chanCount;
+  int result;
+
+  chanCount = 2;
+  adcAcqFilterConfigChannel_fake.return_val = -EINVAL;
+
+  result = adcAcqUtilConfigFilter();
+
+  zassert_equal(result, -EINVAL,
+                "adcAcqUtilConfigFilter should return the configuration error");
+  zassert_equal(adcAcqFilterConfigChannel_fake.call_count, 1,
+                "adcAcqUtilConfigFilter should stop at the first failure");
 }
 
 /**
@@ -582,8 +791,6 @@ ZTEST(adc_util_tests, test_adc_seq_callback_success)
 ZTEST(adc_util_tests, test_setup_sequence)
 {
   extern void setupSequence(void);
-  extern struct adc_sequence sequence;
-  extern struct adc_sequence_options seqOptions;
   extern enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex);
   extern size_t chanCount;
   extern uint16_t *buffer;
@@ -591,6 +798,7 @@ ZTEST(adc_util_tests, test_setup_sequence)
 
   /* Set up test state */
   chanCount = 2;
+  groups[0].chanCount = 2;
   test_buffer[0] = 0;
   test_buffer[1] = 0;
   buffer = test_buffer;
@@ -599,31 +807,64 @@ ZTEST(adc_util_tests, test_setup_sequence)
   setupSequence();
 
   /* Verify sequence structure is initialized correctly */
-  zassert_equal(sequence.oversampling, 0,
+  zassert_equal(groups[0].sequence.oversampling, 0,
                 "sequence.oversampling should be 0 (read from DTS, no oversampling)");
-  zassert_equal(sequence.resolution, OVERSAMPLING_RESOLUTION,
+  zassert_equal(groups[0].sequence.resolution, OVERSAMPLING_RESOLUTION,
                 "sequence.resolution should be set to OVERSAMPLING_RESOLUTION");
-  zassert_false(sequence.calibrate,
+  zassert_false(groups[0].sequence.calibrate,
                 "sequence.calibrate should be set to false");
-  zassert_equal(sequence.options, &seqOptions,
+  zassert_equal(groups[0].sequence.options, &groups[0].options,
                 "sequence.options should point to seqOptions");
-  zassert_equal(sequence.buffer, buffer,
+  zassert_equal(groups[0].sequence.buffer, buffer,
                 "sequence.buffer should point to buffer");
-  zassert_equal(sequence.buffer_size, chanCount * sizeof(uint16_t),
+  zassert_equal(groups[0].sequence.buffer_size, chanCount * sizeof(uint16_t),
                 "sequence.buffer_size should be chanCount * sizeof(uint16_t)");
 
   /* Verify seqOptions structure is initialized correctly */
-  zassert_equal(seqOptions.extra_samplings, EXTRA_SAMPLINGS_SETTING,
-                "seqOptions.extra_samplings should be set to EXTRA_SAMPLINGS_SETTING");
-  zassert_equal(seqOptions.interval_us, CHANNEL_INTERVAL,
+  zassert_equal(groups[0].options.extra_samplings, 0,
+                "seqOptions.extra_samplings should be 0 for a single scan block");
+  zassert_equal(groups[0].options.interval_us, CHANNEL_INTERVAL,
                 "seqOptions.interval_us should be set to CHANNEL_INTERVAL");
-  zassert_equal(seqOptions.callback, adcSeqCallback,
+  zassert_equal(groups[0].options.callback, adcSeqCallback,
                 "seqOptions.callback should be set to adcSeqCallback");
 
   /* Clean up */
   buffer = NULL;
 }
 
+/**
+ * @test The setupSequence function must size the sequence for a
+ * whole block and let the driver pace the extra scans.
+ */
+ZTEST(adc_util_tests, test_setup_sequence_block)
+{
+  extern void setupSequence(void);
+  extern size_t chanCount;
+  extern uint16_t *buffer;
+  extern AdcConfig_t config;
+  uint16_t test_buffer[8];
+
+  /* Set up test state */
+  chanCount = 2;
+  groups[0].chanCount = 2;
+  config.samplingRate = 100;
+  config.blockScanCount = 4;
+  buffer = test_buffer;
+
+  /* Call setupSequence */
+  setupSequence();
+
+  zassert_equal(groups[0].sequence.buffer_size, 4 * chanCount * sizeof(uint16_t),
+                "sequence.buffer_size should hold the whole block");
+  zassert_equal(groups[0].options.extra_samplings, 3,
+                "seqOptions.extra_samplings should be blockScanCount - 1");
+  zassert_equal(groups[0].options.interval_us, 100,
+                "seqOptions.interval_us should be the sampling rate");
+
+  /* Clean up */
+  buffer = NULL;
+}
+
 /**
  * @test The calculateVdd function must correctly calculate VDD
  * when vrefVal equals the calibration value (VDD = 3.0V).
@@ -681,6 +922,27 @@ ZTEST(adc_util_tests, test_calculate_vdd_lower_voltage)
                  "VDD should be approximately 2.7V when vrefVal is 1667");
 }
 
+/**
+ * @test The adcAcqUtilInitAdc function must return -EINVAL when
+ * the block scan count is 0.
+ */
+ZTEST(adc_util_tests, test_init_adc_invalid_block_scan_count)
+{
+  AdcConfig_t adcConfig = {
+    .samplingRate = 500,
+    .filterTau = 100,
+    .blockScanCount = 0
+  };
+  int result;
+
+  result = adcAcqUtilInitAdc(&adcConfig);
+
+  zassert_equal(result, -EINVAL,
+                "adcAcqUtilInitAdc should return -EINVAL when blockScanCount is 0");
+  zassert_equal(k_malloc_fake.call_count, 0,
+                "k_malloc should not be called");
+}
+
 /**
  * @test The adcAcqUtilInitAdc function must return -ENOSPC when
  * buffer allocation fails.
@@ -689,7 +951,8 @@ ZTEST(adc_util_tests, test_init_adc_buffer_allocation_failure)
 {
   AdcConfig_t adcConfig = {
     .samplingRate = 500,
-    .filterTau = 100
+    .filterTau = 100,
+    .blockScanCount = 1
   };
   int result;
 
@@ -713,7 +976,8 @@ ZTEST(adc_util_tests, test_init_adc_volt_values_allocation_failure)
 {
   AdcConfig_t adcConfig = {
     .samplingRate = 500,
-    .filterTau = 100
+    .filterTau = 100,
+    .blockScanCount = 1
   };
   static uint16_t fake_buffer[2];
   int result;
@@ -739,7 +1003,8 @@ ZTEST(adc_util_tests, test_init_adc_configure_channels_failure)
 {
   AdcConfig_t adcConfig = {
     .samplingRate = 500,
-    .filterTau = 100
+    .filterTau = 100,
+    .blockScanCount = 1
   };
   static uint16_t fake_buffer[2];
   static float fake_volt_values[2];
@@ -771,7 +1036,8 @@ ZTEST(adc_util_tests, test_init_adc_configure_timer_failure)
 {
   AdcConfig_t adcConfig = {
     .samplingRate = 500,
-    .filterTau = 100
+    .filterTau = 100,
+    .blockScanCount = 1
   };
   static uint16_t fake_buffer[2];
   static float fake_volt_values[2];
@@ -811,7 +1077,8 @@ ZTEST(adc_util_tests, test_init_adc_enable_vrefint_failure)
 {
   AdcConfig_t adcConfig = {
     .samplingRate = 500,
-    .filterTau = 100
+    .filterTau = 100,
+    .blockScanCount = 1
   };
   static uint16_t fake_buffer[2];
   static float fake_volt_values[2];
@@ -846,10 +1113,13 @@ ZTEST(adc_util_tests, test_init_adc_success)
 {
   AdcConfig_t adcConfig = {
     .samplingRate = 500,
-    .filterTau = 100
+    .filterTau = 100,
+    .blockScanCount = 1
   };
+  extern int32_t *milliVoltValues;
+  extern uint32_t vrefCalMilliVolt;
   static uint16_t fake_buffer[2];
-  static float fake_volt_values[2];
+  static float fake_volt_values[4];
   int result;
 
   /* Configure k_malloc to succeed (return valid pointers) */
@@ -879,6 +1149,12 @@ ZTEST(adc_util_tests, test_init_adc_success)
                 "device_is_ready should be called once for timer");
   zassert_equal(counter_us_to_ticks_fake.call_count, 1,
                 "counter_us_to_ticks should be called once");
+  zassert_equal(k_malloc_fake.arg0_history[1], 2 * (sizeof(float) + sizeof(int32_t)),
+                "The volt and millivolt values should share one allocation");
+  zassert_equal((void *)milliVoltValues, (void *)(fake_volt_values + 2),
+                "The millivolt values should follow the volt values");
+  zassert_equal(vrefCalMilliVolt, 3000 * 1500,
+                "The VREFINT calibration product should be precomputed");
 }
 
 /**
@@ -1105,13 +1381,16 @@ ZTEST(adc_util_tests, test_stop_trigger_success)
  */
 ZTEST(adc_util_tests, test_process_data_vref_read_failure)
 {
+  extern size_t chanCount;
   int result;
 
   /* Configure adcAcqFilterGetThirdOrderData to return error for Vref channel */
   adcAcqFilterGetThirdOrderData_fake.return_val = -EIO;
 
+  chanCount = 2;
+
   /* Call adcAcqUtilProcessData - should fail */
-  result = adcAcqUtilProcessData();
+  result = adcAcqUtilProcessData(0x3, 0);
 
   zassert_equal(result, -EIO,
                 "adcAcqUtilProcessData should return -EIO when Vref read fails");
@@ -1127,14 +1406,17 @@ ZTEST(adc_util_tests, test_process_data_vref_read_failure)
  */
 ZTEST(adc_util_tests, test_process_data_channel_read_failure)
 {
+  extern size_t chanCount;
   int result;
   int return_vals[] = {0, -EIO};  /* Vref succeeds, first channel fails */
 
   /* Configure adcAcqFilterGetThirdOrderData to succeed for Vref, then fail */
   SET_RETURN_SEQ(adcAcqFilterGetThirdOrderData, return_vals, 2);
 
+  chanCount = 2;
+
   /* Call adcAcqUtilProcessData - should fail on channel read */
-  result = adcAcqUtilProcessData();
+  result = adcAcqUtilProcessData(0x3, 0);
 
   zassert_equal(result, -EIO,
                 "adcAcqUtilProcessData should return -EIO when channel read fails");
@@ -1162,12 +1444,28 @@ static int adcAcqFilterGetThirdOrderData_process_success(size_t chanId, int32_t
   return 0;
 }
 
+/**
+ * Custom fake for adcAcqFilterGetThirdOrderData converting both formats.
+ * Calls 0 and 2 (Vref): return 1500 -> VDD = 3.0V
+ * Call 1 (channel 0): returns 2048 -> voltage ≈ 1.5V
+ * Call 3 (channel 1): returns 4095 -> 3000 mV
+ */
+static int mixed_test_values[] = {1500, 2048, 1500, 4095};
+
+static int adcAcqFilterGetThirdOrderData_mixed(size_t chanId, int32_t *data)
+{
+  *data = mixed_test_values[process_data_call_idx];
+  process_data_call_idx++;
+  return 0;
+}
+
 /**
  * @test The adcAcqUtilProcessData function must successfully process
  * all channel data and calculate voltages when all operations succeed.
  */
 ZTEST(adc_util_tests, test_process_data_success)
 {
+  extern size_t chanCount;
   extern float *voltValues;
   float test_volt_values[2];
   int result;
@@ -1176,6 +1474,7 @@ ZTEST(adc_util_tests, test_process_data_success)
   const float expected_volt1 = (4095.0f * expected_vdd) / 4095.0f; /* = 3.0V */
 
   /* Set up voltValues array */
+  chanCount = 2;
   voltValues = test_volt_values;
 
   /* Reset custom fake call index */
@@ -1185,7 +1484,7 @@ ZTEST(adc_util_tests, test_process_data_success)
   adcAcqFilterGetThirdOrderData_fake.custom_fake = adcAcqFilterGetThirdOrderData_process_success;
 
   /* Call adcAcqUtilProcessData - should succeed */
-  result = adcAcqUtilProcessData();
+  result = adcAcqUtilProcessData(0x3, 0);
 
   zassert_equal(result, 0,
                 "adcAcqUtilProcessData should return 0 on success");
@@ -1206,6 +1505,235 @@ ZTEST(adc_util_tests, test_process_data_success)
   voltValues = NULL;
 }
 
+/**
+ * @test The adcAcqUtilProcessData function must do nothing when no
+ * channel is requested.
+ */
+ZTEST(adc_util_tests, test_process_data_empty_mask)
+{
+  extern size_t chanCount;
+  int result;
+
+  chanCount = 2;
+
+  result = adcAcqUtilProcessData(0, 0);
+
+  zassert_equal(result, 0,
+                "adcAcqUtilProcessData should return 0 for an empty mask");
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.call_count, 0,
+                "adcAcqFilterGetThirdOrderData should not be called");
+}
+
+/**
+ * @test The adcAcqUtilProcessData function must only convert the
+ * requested channels.
+ */
+ZTEST(adc_util_tests, test_process_data_masked_channels)
+{
+  extern size_t chanCount;
+  extern float *voltValues;
+  float test_volt_values[2] = {-1.0f, -1.0f};
+  int result;
+
+  chanCount = 2;
+  voltValues = test_volt_values;
+  process_data_call_idx = 0;
+  adcAcqFilterGetThirdOrderData_fake.custom_fake = adcAcqFilterGetThirdOrderData_process_success;
+
+  result = adcAcqUtilProcessData(BIT(1), 0);
+
+  zassert_equal(result, 0,
+                "adcAcqUtilProcessData should return 0 on success");
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.call_count, 2,
+                "adcAcqFilterGetThirdOrderData should be called for Vref and channel 1");
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.arg0_history[1], 1,
+                "Only channel 1 should be converted");
+  zassert_within(test_volt_values[0], -1.0f, 0.001f,
+                 "voltValues[0] should not be converted");
+
+  /* Clean up */
+  voltValues = NULL;
+}
+
+/**
+ * @test The adcAcqUtilProcessData function must convert the millivolt
+ * channels in fixed-point.
+ */
+ZTEST(adc_util_tests, test_process_data_millivolt)
+{
+  extern size_t chanCount;
+  extern int32_t *milliVoltValues;
+  extern uint32_t vrefCalMilliVolt;
+  extern int32_t scaleVref;
+  int32_t test_millivolt_values[2];
+  int result;
+
+  chanCount = 2;
+  milliVoltValues = test_millivolt_values;
+  vrefCalMilliVolt = 3000 * 1500;
+  scaleVref = 0;
+  process_data_call_idx = 0;
+  adcAcqFilterGetThirdOrderData_fake.custom_fake = adcAcqFilterGetThirdOrderData_process_success;
+
+  result = adcAcqUtilProcessData(0, 0x3);
+
+  /* VDD = 3000 mV from the Vref of 1500 */
+  zassert_equal(result, 0,
+                "adcAcqUtilProcessData should return 0 on success");
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.call_count, 3,
+                "adcAcqFilterGetThirdOrderData should be called for Vref and 2 channels");
+  zassert_equal(scaleVref, 1500,
+                "The scale should be computed for the Vref reading");
+  zassert_equal(test_millivolt_values[0], 1500,
+                "2048 should convert to 1500 mV");
+  zassert_equal(test_millivolt_values[1], 3000,
+                "4095 should convert to 3000 mV");
+
+  /* Clean up */
+  milliVoltValues = NULL;
+  scaleVref = 0;
+}
+
+/**
+ * @test The adcAcqUtilProcessData function must keep the millivolt scale
+ * while the Vref reading does not move.
+ */
+ZTEST(adc_util_tests, test_process_data_millivolt_scale_cached)
+{
+  extern size_t chanCount;
+  extern int32_t *milliVoltValues;
+  extern int32_t scaleVref;
+  extern uint32_t milliVoltScale;
+  int32_t test_millivolt_values[2];
+  int result;
+
+  chanCount = 2;
+  milliVoltValues = test_millivolt_values;
+  scaleVref = 1500;
+  milliVoltScale = BIT(MILLIVOLT_SCALE_SHIFT);   /* 1 mV per LSB */
+  process_data_call_idx = 0;
+  adcAcqFilterGetThirdOrderData_fake.custom_fake = adcAcqFilterGetThirdOrderData_process_success;
+
+  result = adcAcqUtilProcessData(0, BIT(0));
+
+  zassert_equal(result, 0,
+                "adcAcqUtilProcessData should return 0 on success");
+  zassert_equal(milliVoltScale, BIT(MILLIVOLT_SCALE_SHIFT),
+                "The scale should not be computed again");
+  zassert_equal(test_millivolt_values[0], 2048,
+                "The channel should be converted with the cached scale");
+
+  /* Clean up */
+  milliVoltValues = NULL;
+  scaleVref = 0;
+}
+
+/**
+ * @test The adcAcqUtilProcessData function must return -EIO when the
+ * Vref reading is invalid for the millivolt conversion.
+ */
+ZTEST(adc_util_tests, test_process_data_millivolt_invalid_vref)
+{
+  extern size_t chanCount;
+  int result;
+
+  chanCount = 2;
+
+  /* The fake leaves the Vref reading to 0 */
+  result = adcAcqUtilProcessData(0, 0x3);
+
+  zassert_equal(result, -EIO,
+                "adcAcqUtilProcessData should return -EIO on a null Vref reading");
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.call_count, 1,
+                "Only the Vref should be read");
+}
+
+/**
+ * @test The adcAcqUtilProcessData function must convert each mask in
+ * its own format.
+ */
+ZTEST(adc_util_tests, test_process_data_mixed_formats)
+{
+  extern size_t chanCount;
+  extern float *voltValues;
+  extern int32_t *milliVoltValues;
+  extern uint32_t vrefCalMilliVolt;
+  extern int32_t scaleVref;
+  float test_volt_values[2] = {-1.0f, -1.0f};
+  int32_t test_millivolt_values[2] = {-1, -1};
+  int result;
+
+  chanCount = 2;
+  voltValues = test_volt_values;
+  milliVoltValues = test_millivolt_values;
+  vrefCalMilliVolt = 3000 * 1500;
+  scaleVref = 0;
+  process_data_call_idx = 0;
+  adcAcqFilterGetThirdOrderData_fake.custom_fake = adcAcqFilterGetThirdOrderData_mixed;
+
+  result = adcAcqUtilProcessData(BIT(0), BIT(1));
+
+  zassert_equal(result, 0,
+                "adcAcqUtilProcessData should return 0 on success");
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.call_count, 4,
+                "The Vref should be read once per format");
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.arg0_history[1], 0,
+                "Channel 0 should be converted to volts");
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.arg0_history[3], 1,
+                "Channel 1 should be converted to millivolts");
+  zassert_within(test_volt_values[0], 1.5f, 0.01f,
+                 "Channel 0 should be converted to volts");
+  zassert_within(test_volt_values[1], -1.0f, 0.001f,
+                 "Channel 1 should not be converted to volts");
+  zassert_equal(test_millivolt_values[0], -1,
+                "Channel 0 should not be converted to millivolts");
+  zassert_equal(test_millivolt_values[1], 3000,
+                "Channel 1 should be converted to millivolts");
+
+  /* Clean up */
+  voltValues = NULL;
+  milliVoltValues = NULL;
+  scaleVref = 0;
+}
+
+/**
+ * @test The adcAcqUtilGetDueChanMask function must merge the channels
+ * of the non-paused subscriptions due at this notification.
+ */
+ZTEST(adc_util_tests, test_get_due_chan_mask)
+{
+  extern AdcSubConfig_t subConfig;
+  extern AdcSubEntry_t *subscriptions;
+  AdcSubEntry_t test_subscriptions[3];
+
+  memset(test_subscriptions, 0, sizeof(test_subscriptions));
+  test_subscriptions[0].chanMask = BIT(0);
+  test_subscriptions[0].countdown = 1;
+  test_subscriptions[1].chanMask = BIT(1);
+  test_subscriptions[1].countdown = 3;    /* Not due yet */
+  test_subscriptions[2].chanMask = BIT(2);
+  test_subscriptions[2].countdown = 1;
+  test_subscriptions[2].isPaused = true;
+  subscriptions = test_subscriptions;
+  subConfig.activeSubCount = 3;
+
+  zassert_equal(adcAcqUtilGetDueChanMask(ADC_ACQ_FORMAT_VOLT), BIT(0),
+                "Only the due non-paused subscription channels should be requested");
+
+  /* Move the second subscription to the millivolt format */
+  test_subscriptions[1].countdown = 1;
+  test_subscriptions[1].format = ADC_ACQ_FORMAT_MILLIVOLT;
+
+  zassert_equal(adcAcqUtilGetDueChanMask(ADC_ACQ_FORMAT_VOLT), BIT(0),
+                "The millivolt subscription channels should not be requested in volts");
+  zassert_equal(adcAcqUtilGetDueChanMask(ADC_ACQ_FORMAT_MILLIVOLT), BIT(1),
+                "The millivolt subscription channels should be requested in millivolts");
+
+  /* Clean up */
+  subscriptions = NULL;
+  subConfig.activeSubCount = 0;
+}
+
 /**
  * @test The adcAcqUtilNotifySubscribers function must skip callback
  * when memory pool allocation fails.
@@ -1221,6 +1749,10 @@ ZTEST(adc_util_tests, test_notify_subscribers_pool_alloc_failure)
   /* Set up one active, non-paused subscription */
   test_subscriptions[0].callback = mock_subscription_callback;
   test_subscriptions[0].isPaused = false;
+  test_subscriptions[0].chanMask = 0x3;
+  test_subscriptions[0].decimation = 1;
+  test_subscriptions[0].countdown = 1;
+  test_subscriptions[0].format = ADC_ACQ_FORMAT_VOLT;
   subscriptions = test_subscriptions;
   subConfig.activeSubCount = 1;
   subDataPool = (osMemoryPoolId_t)0x1000;
@@ -1268,6 +1800,10 @@ ZTEST(adc_util_tests, test_notify_subscribers_callback_failure)
   /* Set up one active, non-paused subscription */
   test_subscriptions[0].callback = mock_subscription_callback;
   test_subscriptions[0].isPaused = false;
+  test_subscriptions[0].chanMask = 0x3;
+  test_subscriptions[0].decimation = 1;
+  test_subscriptions[0].countdown = 1;
+  test_subscriptions[0].format = ADC_ACQ_FORMAT_VOLT;
   subscriptions = test_subscriptions;
   subConfig.activeSubCount = 1;
   subDataPool = (osMemoryPoolId_t)0x1000;
@@ -1323,6 +1859,10 @@ ZTEST(adc_util_tests, test_notify_subscribers_success)
   /* Set up one active, non-paused subscription */
   test_subscriptions[0].callback = mock_subscription_callback;
   test_subscriptions[0].isPaused = false;
+  test_subscriptions[0].chanMask = 0x3;
+  test_subscriptions[0].decimation = 1;
+  test_subscriptions[0].countdown = 1;
+  test_subscriptions[0].format = ADC_ACQ_FORMAT_VOLT;
   subscriptions = test_subscriptions;
   subConfig.activeSubCount = 1;
   subDataPool = (osMemoryPoolId_t)0x1000;
@@ -1348,6 +1888,85 @@ ZTEST(adc_util_tests, test_notify_subscribers_success)
                 "Callback should be called with allocated buffer");
   zassert_equal(osMemoryPoolFree_fake.call_count, 0,
                 "osMemoryPoolFree should not be called when callback succeeds");
+  zassert_equal(((SrvMsgPayload_t *)fake_buffer)->dataLen, 2 * sizeof(float),
+                "Payload should hold both subscribed channels");
+
+  /* Clean up */
+  subscriptions = NULL;
+  subConfig.activeSubCount = 0;
+  voltValues = NULL;
+}
+
+/**
+ * @test The adcAcqUtilReleaseData function must free the payload back to
+ * its pool.
+ */
+ZTEST(adc_util_tests, test_release_data)
+{
+  static uint8_t fake_buffer[64];
+  SrvMsgPayload_t *payload = (SrvMsgPayload_t *)fake_buffer;
+
+  payload->poolId = (osMemoryPoolId_t)0x1000;
+
+  adcAcqUtilReleaseData(payload);
+
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once");
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, (osMemoryPoolId_t)0x1000,
+                "osMemoryPoolFree should be called with the payload pool");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, fake_buffer,
+                "osMemoryPoolFree should be called with the payload");
+}
+
+/**
+ * @test The adcAcqUtilReleaseData function must ignore a NULL payload.
+ */
+ZTEST(adc_util_tests, test_release_data_null)
+{
+  adcAcqUtilReleaseData(NULL);
+
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "osMemoryPoolFree should not be called with a NULL payload");
+}
+
+/**
+ * @test The adcAcqUtilNotifySubscribers function must only notify a
+ * subscription at its output period, with its channels only.
+ */
+ZTEST(adc_util_tests, test_notify_subscribers_decimation_and_mask)
+{
+  extern AdcSubConfig_t subConfig;
+  extern AdcSubEntry_t *subscriptions;
+  extern osMemoryPoolId_t subDataPool;
+  extern size_t chanCount;
+  extern float *voltValues;
+  AdcSubEntry_t test_subscriptions[1];
+  static uint8_t fake_buffer[64];
+  SrvMsgPayload_t *payload = (SrvMsgPayload_t *)fake_buffer;
+  float test_volt_values[2] = {1.5f, 3.0f};
+
+  chanCount = 2;
+  voltValues = test_volt_values;
+
+  memset(test_subscriptions, 0, sizeof(test_subscriptions));
+  test_subscriptions[0].callback = mock_subscription_callback;
+  test_subscriptions[0].chanMask = BIT(1);
+  test_subscriptions[0].decimation = 3;
+  test_subscriptions[0].countdown = 1;
+  subscriptions = test_subscriptions;
+  subConfig.activeSubCount = 1;
+  subDataPool = (osMemoryPoolId_t)0x1000;
+  osMemoryPoolAlloc_fake.return_val = fake_buffer;
+
+  for(size_t i = 0; i < 4; ++i)
+    adcAcqUtilNotifySubscribers();
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 2,
+                "Subscription should be notified on ticks 1 and 4");
+  zassert_equal(payload->dataLen, sizeof(float),
+                "Payload should only hold the subscribed channel");
+  zassert_within(((float *)payload->data)[0], 3.0f, 0.001f,
+                 "Payload should hold the channel 1 value");
 
   /* Clean up */
   subscriptions = NULL;
@@ -1355,6 +1974,53 @@ ZTEST(adc_util_tests, test_notify_subscribers_success)
   voltValues = NULL;
 }
 
+/**
+ * @test The adcAcqUtilNotifySubscribers function must fill the millivolt
+ * subscriptions with the fixed-point values.
+ */
+ZTEST(adc_util_tests, test_notify_subscribers_millivolt)
+{
+  extern AdcSubConfig_t subConfig;
+  extern AdcSubEntry_t *subscriptions;
+  extern osMemoryPoolId_t subDataPool;
+  extern size_t chanCount;
+  extern int32_t *milliVoltValues;
+  AdcSubEntry_t test_subscriptions[1];
+  static uint8_t fake_buffer[64];
+  SrvMsgPayload_t *payload = (SrvMsgPayload_t *)fake_buffer;
+  int32_t test_millivolt_values[2] = {1500, 3000};
+
+  chanCount = 2;
+  milliVoltValues = test_millivolt_values;
+
+  memset(test_subscriptions, 0, sizeof(test_subscriptions));
+  test_subscriptions[0].callback = mock_subscription_callback;
+  test_subscriptions[0].chanMask = 0x3;
+  test_subscriptions[0].decimation = 1;
+  test_subscriptions[0].countdown = 1;
+  test_subscriptions[0].format = ADC_ACQ_FORMAT_MILLIVOLT;
+  subscriptions = test_subscriptions;
+  subConfig.activeSubCount = 1;
+  subDataPool = (osMemoryPoolId_t)0x1000;
+  osMemoryPoolAlloc_fake.return_val = fake_buffer;
+
+  adcAcqUtilNotifySubscribers();
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Subscription should be notified");
+  zassert_equal(payload->dataLen, 2 * sizeof(int32_t),
+                "Payload should hold both channels");
+  zassert_equal(((int32_t *)payload->data)[0], 1500,
+                "Payload should hold the channel 0 millivolts");
+  zassert_equal(((int32_t *)payload->data)[1], 3000,
+                "Payload should hold the channel 1 millivolts");
+
+  /* Clean up */
+  subscriptions = NULL;
+  subConfig.activeSubCount = 0;
+  milliVoltValues = NULL;
+}
+
 /**
  * @test The adcAcqUtilNotifySubscribers function must skip
  * paused subscriptions and not allocate memory or call their callbacks.
@@ -1378,8 +2044,16 @@ ZTEST(adc_util_tests, test_notify_subscribers_skips_paused)
   /* Set up two subscriptions: one paused, one active */
   test_subscriptions[0].callback = mock_subscription_callback;
   test_subscriptions[0].isPaused = true;  /* This one should be skipped */
+  test_subscriptions[0].chanMask = 0x3;
+  test_subscriptions[0].decimation = 1;
+  test_subscriptions[0].countdown = 1;
+  test_subscriptions[0].format = ADC_ACQ_FORMAT_VOLT;
   test_subscriptions[1].callback = mock_subscription_callback;
   test_subscriptions[1].isPaused = false; /* This one should be called */
+  test_subscriptions[1].chanMask = 0x3;
+  test_subscriptions[1].decimation = 1;
+  test_subscriptions[1].countdown = 1;
+  test_subscriptions[1].format = ADC_ACQ_FORMAT_VOLT;
   subscriptions = test_subscriptions;
   subConfig.activeSubCount = 2;
   subDataPool = (osMemoryPoolId_t)0x1000;
@@ -1427,7 +2101,7 @@ ZTEST(adc_util_tests, test_add_subscription_max_reached)
   subConfig.activeSubCount = 3;
 
   /* Try to add subscription - should fail because 3 + 1 >= 4 */
-  result = adcAcqUtilAddSubscription(mock_subscription_callback);
+  result = adcAcqUtilAddSubscription(mock_subscription_callback, NULL);
 
   zassert_equal(result, -ENOSPC,
                 "adcAcqUtilAddSubscription should return -ENOSPC when max reached");
@@ -1449,6 +2123,7 @@ ZTEST(adc_util_tests, test_add_subscription_max_reached)
  */
 ZTEST(adc_util_tests, test_add_subscription_success)
 {
+  extern size_t chanCount;
   extern AdcSubConfig_t subConfig;
   extern AdcSubEntry_t *subscriptions;
   AdcSubEntry_t test_subscriptions[4];
@@ -1463,7 +2138,8 @@ ZTEST(adc_util_tests, test_add_subscription_success)
   subConfig.activeSubCount = 0;
 
   /* Add subscription - should succeed */
-  result = adcAcqUtilAddSubscription(mock_subscription_callback);
+  chanCount = 2;
+  result = adcAcqUtilAddSubscription(mock_subscription_callback, NULL);
 
   zassert_equal(result, 0,
                 "adcAcqUtilAddSubscription should return 0 on success");
@@ -1473,6 +2149,12 @@ ZTEST(adc_util_tests, test_add_subscription_success)
                 "subscription callback should be stored at index 0");
   zassert_false(subscriptions[0].isPaused,
                 "subscription isPaused should be set to false");
+  zassert_equal(subscriptions[0].chanMask, 0x3,
+                "subscription should default to all the channels");
+  zassert_equal(subscriptions[0].decimation, 1,
+                "subscription should default to each notification");
+  zassert_equal(subscriptions[0].countdown, 1,
+                "subscription should be due at the next notification");
 
   /* Clean up */
   subscriptions = NULL;
@@ -1480,6 +2162,104 @@ ZTEST(adc_util_tests, test_add_subscription_success)
   subConfig.maxSubCount = 0;
 }
 
+/**
+ * @test The adcAcqUtilAddSubscription function must return -EINVAL
+ * when the channel mask holds no valid channel.
+ */
+ZTEST(adc_util_tests, test_add_subscription_invalid_mask)
+{
+  extern size_t chanCount;
+  extern AdcSubConfig_t subConfig;
+  extern AdcSubEntry_t *subscriptions;
+  AdcSubEntry_t test_subscriptions[4];
+  AdcSubOptions_t options = {.chanMask = BIT(2), .periodMs = 0};
+  int result;
+
+  chanCount = 2;
+  subscriptions = test_subscriptions;
+  subConfig.maxSubCount = 4;
+  subConfig.activeSubCount = 0;
+
+  result = adcAcqUtilAddSubscription(mock_subscription_callback, &options);
+
+  zassert_equal(result, -EINVAL,
+                "adcAcqUtilAddSubscription should return -EINVAL for an invalid mask");
+  zassert_equal(subConfig.activeSubCount, 0,
+                "activeSubCount should remain unchanged on failure");
+
+  /* Clean up */
+  subscriptions = NULL;
+  subConfig.maxSubCount = 0;
+}
+
+/**
+ * @test The adcAcqUtilAddSubscription function must return -EINVAL
+ * when the format is unknown.
+ */
+ZTEST(adc_util_tests, test_add_subscription_invalid_format)
+{
+  extern size_t chanCount;
+  extern AdcSubConfig_t subConfig;
+  extern AdcSubEntry_t *subscriptions;
+  AdcSubEntry_t test_subscriptions[4];
+  AdcSubOptions_t options = {.chanMask = BIT(0), .format = ADC_ACQ_FORMAT_COUNT};
+  int result;
+
+  chanCount = 2;
+  subscriptions = test_subscriptions;
+  subConfig.maxSubCount = 4;
+  subConfig.activeSubCount = 0;
+
+  result = adcAcqUtilAddSubscription(mock_subscription_callback, &options);
+
+  zassert_equal(result, -EINVAL,
+                "adcAcqUtilAddSubscription should return -EINVAL for an unknown format");
+  zassert_equal(subConfig.activeSubCount, 0,
+                "activeSubCount should remain unchanged on failure");
+
+  /* Clean up */
+  subscriptions = NULL;
+  subConfig.maxSubCount = 0;
+}
+
+/**
+ * @test The adcAcqUtilAddSubscription function must store the channel
+ * mask and round the output period up to notification ticks.
+ */
+ZTEST(adc_util_tests, test_add_subscription_with_options)
+{
+  extern size_t chanCount;
+  extern AdcSubConfig_t subConfig;
+  extern AdcSubEntry_t *subscriptions;
+  AdcSubEntry_t test_subscriptions[4];
+  AdcSubOptions_t options = {.chanMask = BIT(1) | BIT(5), .periodMs = 250, .format = ADC_ACQ_FORMAT_MILLIVOLT};
+  int result;
+
+  chanCount = 2;
+  memset(test_subscriptions, 0, sizeof(test_subscriptions));
+  subscriptions = test_subscriptions;
+  subConfig.maxSubCount = 4;
+  subConfig.activeSubCount = 0;
+  subConfig.notificationRate = 100;
+
+  result = adcAcqUtilAddSubscription(mock_subscription_callback, &options);
+
+  zassert_equal(result, 0,
+                "adcAcqUtilAddSubscription should return 0 on success");
+  zassert_equal(subscriptions[0].chanMask, BIT(1),
+                "subscription mask should only keep the valid channels");
+  zassert_equal(subscriptions[0].decimation, 3,
+                "250 ms should round up to 3 notifications of 100 ms");
+  zassert_equal(subscriptions[0].format, ADC_ACQ_FORMAT_MILLIVOLT,
+                "subscription should keep the requested format");
+
+  /* Clean up */
+  subscriptions = NULL;
+  subConfig.activeSubCount = 0;
+  subConfig.maxSubCount = 0;
+  subConfig.notificationRate = 0;
+}
+
 /**
  * @test The adcAcqUtilRemoveSubscription function must return -ESRCH
  * when the subscription callback is not found.
@@ -1843,29 +2623,180 @@ ZTEST(adc_util_tests, test_get_volt_null_pointer)
 ZTEST(adc_util_tests, test_get_volt_success)
 {
   extern size_t chanCount;
-  extern float *voltValues;
   float voltVal;
-  float testVoltages[2];
   int result;
 
   /* Set chanCount to 2 (simulating 2 configured channels) */
   chanCount = 2;
 
-  /* Allocate and set voltValues array */
-  testVoltages[0] = 3.3f;
-  testVoltages[1] = 1.8f;
-  voltValues = testVoltages;
+  /* Vref reads 1500 (VDD = 3.0V), channel 1 reads 4095 */
+  process_data_call_idx = 0;
+  process_data_test_values[1] = 4095;
+  adcAcqFilterGetThirdOrderData_fake.custom_fake = adcAcqFilterGetThirdOrderData_process_success;
 
   /* Get voltage value - should succeed */
-  result = adcAcqUtilGetVolt(0, &voltVal);
+  result = adcAcqUtilGetVolt(1, &voltVal);
 
   zassert_equal(result, 0,
                 "adcAcqUtilGetVolt should return 0 on success");
-  zassert_equal(voltVal, 3.3f,
-                "voltVal should be set to the value from voltValues array");
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.arg0_history[1], 1,
+                "adcAcqUtilGetVolt should convert the current channel 1 filter output");
+  zassert_within(voltVal, 3.0f, 0.01f,
+                 "voltVal should be converted from the filter output");
 
-  /* Clean up */
-  voltValues = NULL;
+  /* Restore the shared test values */
+  process_data_test_values[1] = 2048;
+}
+
+/**
+ * @test The adcAcqUtilGetVolt function must return the error when
+ * reading the Vref fails.
+ */
+ZTEST(adc_util_tests, test_get_volt_vref_failure)
+{
+  extern size_t chanCount;
+  float voltVal;
+  int result;
+
+  chanCount = 2;
+  adcAcqFilterGetThirdOrderData_fake.return_val = -EIO;
+
+  result = adcAcqUtilGetVolt(0, &voltVal);
+
+  zassert_equal(result, -EIO,
+                "adcAcqUtilGetVolt should return -EIO when Vref read fails");
+}
+
+/* Custom fake for k_cyc_to_us_floor32 counting one cycle per microsecond */
+static uint32_t k_cyc_to_us_floor32_identity(uint32_t cycles)
+{
+  return cycles;
+}
+
+/**
+ * @test The triggerConversion function must count the triggers, overruns
+ * and start errors.
+ */
+ZTEST(adc_util_tests, test_stats_trigger_counters)
+{
+  extern void triggerConversion(const struct device *dev, void *user_data);
+  AdcAcqStats_t stats;
+
+  groups[0].isBusy = true;
+  triggerConversion((const struct device *)0x1000, NULL);
+
+  groups[0].isBusy = false;
+  adc_read_async_fake.return_val = -EIO;
+  triggerConversion((const struct device *)0x1000, NULL);
+
+  zassert_equal(adcAcqUtilGetStats(&stats), 0,
+                "adcAcqUtilGetStats should succeed");
+  zassert_equal(stats.triggerCount, 2,
+                "Every trigger should be counted");
+  zassert_equal(stats.overrunCount, 1,
+                "The busy trigger should be counted as an overrun");
+  zassert_equal(stats.startErrorCount, 1,
+                "The failed start should be counted");
+  zassert_equal(stats.filterErrorCount, 0,
+                "No filter error should be counted");
+}
+
+/**
+ * @test The adcSeqCallback function must count the blocks rejected by
+ * the filter.
+ */
+ZTEST(adc_util_tests, test_stats_filter_error)
+{
+  extern enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex);
+  AdcAcqStats_t stats;
+
+  adcAcqFilterPushRangeBlock_fake.return_val = -EINVAL;
+
+  adcSeqCallback((const struct device *)0x1000, &groups[0].sequence, 0);
+
+  zassert_equal(adcAcqUtilGetStats(&stats), 0,
+                "adcAcqUtilGetStats should succeed");
+  zassert_equal(stats.filterErrorCount, 1,
+                "The rejected block should be counted");
+}
+
+/**
+ * @test The latency and conversion time must be measured from the block
+ * trigger to its first and last scan callbacks.
+ */
+ZTEST(adc_util_tests, test_stats_timing)
+{
+  extern void triggerConversion(const struct device *dev, void *user_data);
+  extern enum adc_action adcSeqCallback(const struct device *dev, const struct adc_sequence *sequence, uint16_t samplingIndex);
+  extern AdcConfig_t config;
+  uint32_t cycles[] = {1000, 1020, 1300, 5000, 5030, 5200};
+  AdcAcqStats_t stats;
+
+  SET_RETURN_SEQ(k_cycle_get_32_mock, cycles, ARRAY_SIZE(cycles));
+  k_cyc_to_us_floor32_mock_fake.custom_fake = k_cyc_to_us_floor32_identity;
+  config.blockScanCount = 3;
+
+  for(size_t i = 0; i < 2; ++i)
+  {
+    groups[0].isBusy = false;
+    triggerConversion((const struct device *)0x1000, NULL);
+
+    for(uint16_t j = 0; j < config.blockScanCount; ++j)
+      adcSeqCallback((const struct device *)0x1000, &groups[0].sequence, j);
+  }
+
+  zassert_equal(adcAcqUtilGetStats(&stats), 0,
+                "adcAcqUtilGetStats should succeed");
+  zassert_equal(stats.blockCount, 2,
+                "Both blocks should be timed");
+  zassert_equal(stats.latencyMinUs, 20,
+                "The shortest latency should be the first block one");
+  zassert_equal(stats.latencyMaxUs, 30,
+                "The longest latency should be the second block one");
+  zassert_equal(stats.convTimeMinUs, 200,
+                "The shortest conversion should be the second block one");
+  zassert_equal(stats.convTimeMaxUs, 300,
+                "The longest conversion should be the first block one");
+}
+
+/**
+ * @test The adcAcqUtilResetStats function must clear the statistics and
+ * restart their elapsed time.
+ */
+ZTEST(adc_util_tests, test_stats_reset)
+{
+  extern void triggerConversion(const struct device *dev, void *user_data);
+  AdcAcqStats_t stats;
+
+  groups[0].isBusy = true;
+  triggerConversion((const struct device *)0x1000, NULL);
+
+  k_uptime_get_mock_fake.return_val = 500;
+  adcAcqUtilResetStats();
+  k_uptime_get_mock_fake.return_val = 1500;
+
+  zassert_equal(adcAcqUtilGetStats(&stats), 0,
+                "adcAcqUtilGetStats should succeed");
+  zassert_equal(stats.elapsedMs, 1000,
+                "The elapsed time should run from the reset");
+  zassert_equal(stats.triggerCount, 0,
+                "The trigger count should be cleared");
+  zassert_equal(stats.overrunCount, 0,
+                "The overrun count should be cleared");
+  zassert_equal(stats.convTimeMinUs, 0,
+                "The minimum should read 0 without timed block");
+  zassert_equal(stats.latencyMinUs, 0,
+                "The minimum should read 0 without timed block");
+}
+
+/**
+ * @test The adcAcqUtilGetStats function must return -EINVAL with a NULL
+ * statistics buffer.
+ */
+ZTEST(adc_util_tests, test_stats_get_null)
+{
+  zassert_equal(adcAcqUtilGetStats(NULL), -EINVAL,
+                "NULL stats should return -EINVAL");
 }
 
 ZTEST_SUITE(adc_util_tests, NULL, util_tests_setup, util_tests_before, NULL, NULL);
@@ -0,0 +1,292 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     ADC Acquisition Window Comparator Unit Tests
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock k_malloc function */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+
+/* Mock filter function */
+FAKE_VALUE_FUNC(int, adcAcqFilterGetThirdOrderData, size_t, int32_t *);
+
+/* List of fakes for easy reset */
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(k_malloc) \
+  FAKE(adcAcqFilterGetThirdOrderData) \
+  FAKE(mock_window_callback)
+
+/* Prevent adcAcquisitionUtil.h and adcAcquisitionFilter.h inclusion and provide needed macros */
+#define ADC_ACQUISITION_UTIL
+#define ADC_ACQ_FILTER
+#define ADC_AQC_SERVICE_NAME adcAcquisition
+
+/* Include window header */
+#include "adcAcquisitionWindow.h"
+
+/* Mock window callback */
+FAKE_VOID_FUNC(mock_window_callback, size_t, AdcWindowZone_t, int32_t);
+
+/* Setup logging before including window implementation */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(adcAcquisition, LOG_LEVEL_DBG);
+
+/* Redefine LOG_MODULE_DECLARE to prevent redefinition when window includes logging.h */
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+#include "adcAcquisitionWindow.c"
+
+/* The test channel count */
+#define TEST_CHAN_COUNT 2
+
+/* Fixture for tests that need an initialized window comparator */
+struct adc_window_tests_fixture
+{
+  AdcWindowState_t window_memory[TEST_CHAN_COUNT];
+  int32_t values[TEST_CHAN_COUNT];
+};
+
+static struct adc_window_tests_fixture testFixture;
+
+/* Return the fixture value of a channel as its filtered data */
+static int getThirdOrderData_custom(size_t chanId, int32_t *filtData)
+{
+  *filtData = testFixture.values[chanId];
+  return 0;
+}
+
+static void *window_setup(void)
+{
+  return &testFixture;
+}
+
+static void window_before(void *f)
+{
+  int err;
+
+  ARG_UNUSED(f);
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(&testFixture, 0, sizeof(testFixture));
+  k_malloc_fake.return_val = testFixture.window_memory;
+  adcAcqFilterGetThirdOrderData_fake.custom_fake = getThirdOrderData_custom;
+
+  err = adcAcqWindowInit(TEST_CHAN_COUNT);
+  zassume_equal(err, 0, "Window init should succeed");
+}
+
+/* Set the window of a channel */
+static void setWindow(size_t chanId, int32_t low, int32_t high, int32_t hysteresis)
+{
+  AdcWindow_t window = {
+    .lowThreshold = low,
+    .highThreshold = high,
+    .hysteresis = hysteresis,
+    .callback = mock_window_callback,
+  };
+
+  zassert_equal(adcAcqWindowSet(chanId, &window), 0, "Setting the window should succeed");
+}
+
+/* Compare a channel value to its window */
+static void checkValue(size_t chanId, int32_t value)
+{
+  testFixture.values[chanId] = value;
+  adcAcqWindowCheckRange(0, TEST_CHAN_COUNT);
+}
+
+/**
+ * @test adcAcqWindowInit must return -ENOSPC when the allocation fails
+ */
+ZTEST_F(adc_window_tests, test_init_alloc_failure)
+{
+  k_malloc_fake.return_val = NULL;
+
+  zassert_equal(adcAcqWindowInit(TEST_CHAN_COUNT), -ENOSPC,
+                "Init should return -ENOSPC when allocation fails");
+}
+
+/**
+ * @test The window functions must return -ENODEV before the init
+ */
+ZTEST_F(adc_window_tests, test_not_initialized)
+{
+  AdcWindowZone_t zone;
+
+  windows = NULL;
+
+  zassert_equal(adcAcqWindowSet(0, NULL), -ENODEV, "Set should return -ENODEV");
+  zassert_equal(adcAcqWindowClear(0), -ENODEV, "Clear should return -ENODEV");
+  zassert_equal(adcAcqWindowGetZone(0, &zone), -ENODEV, "Get zone should return -ENODEV");
+}
+
+/**
+ * @test adcAcqWindowSet must reject invalid windows
+ */
+ZTEST_F(adc_window_tests, test_set_invalid_window)
+{
+  AdcWindow_t noCallback = {.lowThreshold = 100, .highThreshold = 200};
+  AdcWindow_t inverted = {.lowThreshold = 200, .highThreshold = 100,
+                          .callback = mock_window_callback};
+  AdcWindow_t negHyst = {.lowThreshold = 100, .highThreshold = 200, .hysteresis = -1,
+                         .callback = mock_window_callback};
+  AdcWindow_t valid = {.lowThreshold = 100, .highThreshold = 200,
+                       .callback = mock_window_callback};
+
+  zassert_equal(adcAcqWindowSet(0, NULL), -EINVAL, "NULL window should return -EINVAL");
+  zassert_equal(adcAcqWindowSet(0, &noCallback), -EINVAL, "No callback should return -EINVAL");
+  zassert_equal(adcAcqWindowSet(0, &inverted), -EINVAL, "Inverted thresholds should return -EINVAL");
+  zassert_equal(adcAcqWindowSet(0, &negHyst), -EINVAL, "Negative hysteresis should return -EINVAL");
+  zassert_equal(adcAcqWindowSet(TEST_CHAN_COUNT, &valid), -EINVAL,
+                "Invalid channel should return -EINVAL");
+}
+
+/**
+ * @test The channels without window must not be compared
+ */
+ZTEST_F(adc_window_tests, test_no_window)
+{
+  AdcWindowZone_t zone;
+
+  checkValue(0, 5000);
+
+  zassert_equal(adcAcqFilterGetThirdOrderData_fake.call_count, 0,
+                "The filter should not be read without window");
+  zassert_equal(mock_window_callback_fake.call_count, 0,
+                "No callback should fire without window");
+  zassert_equal(adcAcqWindowGetZone(0, &zone), -ENOENT,
+                "Get zone should return -ENOENT without window");
+}
+
+/**
+ * @test A value leaving the window must fire the callback once
+ */
+ZTEST_F(adc_window_tests, test_cross_above)
+{
+  AdcWindowZone_t zone;
+
+  setWindow(1, 1000, 2000, 50);
+
+  checkValue(1, 1500);
+  zassert_equal(mock_window_callback_fake.call_count, 0,
+                "No callback should fire inside the window");
+
+  checkValue(1, 2001);
+  checkValue(1, 2100);
+
+  zassert_equal(mock_window_callback_fake.call_count, 1,
+                "The callback should fire once on crossing");
+  zassert_equal(mock_window_callback_fake.arg0_val, 1, "The channel should be given");
+  zassert_equal(mock_window_callback_fake.arg1_val, ADC_WINDOW_ABOVE, "The zone should be above");
+  zassert_equal(mock_window_callback_fake.arg2_val, 2001, "The crossing value should be given");
+  zassert_equal(adcAcqWindowGetZone(1, &zone), 0, "Get zone should succeed");
+  zassert_equal(zone, ADC_WINDOW_ABOVE, "The channel should be above");
+}
+
+/**
+ * @test A channel out of the window must come back past the hysteresis
+ */
+ZTEST_F(adc_window_tests, test_hysteresis)
+{
+  setWindow(0, 1000, 2000, 50);
+
+  checkValue(0, 999);
+  checkValue(0, 1049);
+  zassert_equal(mock_window_callback_fake.call_count, 1,
+                "The channel should stay below within the hysteresis");
+
+  checkValue(0, 1050);
+  zassert_equal(mock_window_callback_fake.call_count, 2,
+                "The channel should reenter the window past the hysteresis");
+  zassert_equal(mock_window_callback_fake.arg1_history[1], ADC_WINDOW_INSIDE,
+                "The zone should be inside");
+
+  checkValue(0, 2001);
+  checkValue(0, 1951);
+  zassert_equal(mock_window_callback_fake.call_count, 3,
+                "The channel should stay above within the hysteresis");
+
+  checkValue(0, 1950);
+  zassert_equal(mock_window_callback_fake.call_count, 4,
+                "The channel should reenter the window past the hysteresis");
+}
+
+/**
+ * @test A channel must cross from one side to the other directly
+ */
+ZTEST_F(adc_window_tests, test_cross_both_sides)
+{
+  setWindow(0, 1000, 2000, 50);
+
+  checkValue(0, 2500);
+  checkValue(0, 500);
+
+  zassert_equal(mock_window_callback_fake.call_count, 2,
+                "The callback should fire on each crossing");
+  zassert_equal(mock_window_callback_fake.arg1_history[0], ADC_WINDOW_ABOVE,
+                "The channel should first be above");
+  zassert_equal(mock_window_callback_fake.arg1_history[1], ADC_WINDOW_BELOW,
+                "The channel should then be below");
+}
+
+/**
+ * @test A channel already out of its new window must fire at the next check
+ */
+ZTEST_F(adc_window_tests, test_set_restarts_inside)
+{
+  setWindow(0, 1000, 2000, 50);
+  checkValue(0, 500);
+
+  setWindow(0, 1000, 2000, 50);
+  checkValue(0, 500);
+
+  zassert_equal(mock_window_callback_fake.call_count, 2,
+                "The new window should fire again for a channel below it");
+}
+
+/**
+ * @test A cleared window must not be compared anymore
+ */
+ZTEST_F(adc_window_tests, test_clear)
+{
+  setWindow(0, 1000, 2000, 50);
+
+  zassert_equal(adcAcqWindowClear(TEST_CHAN_COUNT), -EINVAL,
+                "Invalid channel should return -EINVAL");
+  zassert_equal(adcAcqWindowClear(0), 0, "Clear should succeed");
+
+  checkValue(0, 500);
+
+  zassert_equal(mock_window_callback_fake.call_count, 0,
+                "No callback should fire after clear");
+}
+
+/**
+ * @test An out of bounds range must not be compared
+ */
+ZTEST_F(adc_window_tests, test_check_range_out_of_bounds)
+{
+  setWindow(1, 1000, 2000, 50);
+  testFixture.values[1] = 500;
+
+  adcAcqWindowCheckRange(1, TEST_CHAN_COUNT);
+  zassert_equal(mock_window_callback_fake.call_count, 0,
+                "An out of bounds range should be ignored");
+
+  adcAcqWindowCheckRange(1, 1);
+  zassert_equal(mock_window_callback_fake.call_count, 1,
+                "The range channel should be compared");
+}
+
+ZTEST_SUITE(adc_window_tests, NULL, window_setup, window_before, NULL, NULL);
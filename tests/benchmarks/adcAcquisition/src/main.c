@@ -0,0 +1,172 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     ADC Acquisition Benchmarks
+ *
+ *            Filter stage cost per sample of a channel, against the channel
+ *            count and the filter order.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+/* A filter push takes a few nanoseconds, many are timed by each sample */
+#define BENCH_SAMPLE_OPS                                        (16384)
+
+#include "benchmark.h"
+
+/* Prevent adcAcquisitionUtil.h inclusion and provide needed macros */
+#define ADC_ACQUISITION_UTIL
+#define ADC_AQC_SERVICE_NAME adcAcquisition
+
+/* Include filter header */
+#include "adcAcquisitionFilter.h"
+
+/* Setup logging before including filter implementation */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(adcAcquisition, LOG_LEVEL_WRN);
+
+/* Redefine LOG_MODULE_DECLARE to prevent redefinition when filter includes logging.h */
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+#include "adcAcquisitionFilter.c"
+
+/**
+ * @brief   The benchmark suite name.
+ */
+#define BENCH_SUITE                                             "adcAcquisition"
+
+/**
+ * @brief   The maximum channel count benchmarked.
+ */
+#define BENCH_MAX_CHAN_COUNT                                    (16)
+
+/**
+ * @brief   The scan count of a benchmarked block.
+ */
+#define BENCH_SCAN_COUNT                                        (16)
+
+/**
+ * @brief   The benchmarked channel counts.
+ */
+static const size_t chanCounts[] = {1, 4, BENCH_MAX_CHAN_COUNT};
+
+/**
+ * @brief   The benchmarked filter orders.
+ */
+static const uint32_t orders[] = {1, 2, FILTER_MAX_ORDER};
+
+/**
+ * @brief   The benchmark data block, a ramp over every channel.
+ */
+static uint16_t block[BENCH_SCAN_COUNT * BENCH_MAX_CHAN_COUNT];
+
+/**
+ * @brief   Initialize the filter stage for a benchmark case.
+ *
+ * @param[in]   chanCount: The channel count.
+ * @param[in]   order: The filter order of every channel.
+ */
+static void initFilter(size_t chanCount, uint32_t order)
+{
+  zassert_equal(adcAcqFilterInit(chanCount), 0, "filter init failed");
+
+  for(size_t i = 0; i < chanCount; ++i)
+    zassert_equal(adcAcqFilterConfigChannel(i, FILTER_MAX_TAU / 2, order), 0, "channel config failed");
+}
+
+/**
+ * @brief   Release the filter stage of a benchmark case.
+ */
+static void releaseFilter(void)
+{
+  k_free(filterBuf);
+  filterBuf = NULL;
+  filterCount = 0;
+}
+
+/**
+ * @brief Setup function called before all benchmarks in the suite.
+ */
+static void *bench_setup(void)
+{
+  for(size_t i = 0; i < ARRAY_SIZE(block); ++i)
+    block[i] = (uint16_t)(i * 257 % 4096);
+
+  benchInit();
+
+  return NULL;
+}
+
+/**
+ * @test The per-sample cost of adcAcqFilterPushData, one call per sample of a channel.
+ */
+ZTEST(adcAcquisitionBench, test_push_data)
+{
+  BenchResult_t result;
+  BenchStamp_t start;
+  char params[BENCH_PARAMS_SIZE];
+
+  for(size_t c = 0; c < ARRAY_SIZE(chanCounts); ++c)
+  {
+    for(size_t o = 0; o < ARRAY_SIZE(orders); ++o)
+    {
+      initFilter(chanCounts[c], orders[o]);
+      benchStart(&result, BENCH_SAMPLE_OPS);
+
+      for(uint32_t s = 0; s < BENCH_SAMPLE_COUNT; ++s)
+      {
+        start = benchNow();
+        for(uint32_t i = 0; i < BENCH_SAMPLE_OPS; ++i)
+          adcAcqFilterPushData(i % chanCounts[c], block[i % ARRAY_SIZE(block)], FILTER_MAX_TAU / 2);
+        benchRecord(&result, start, benchNow());
+      }
+
+      snprintk(params, sizeof(params), "\"chan_count\":%zu,\"order\":%u", chanCounts[c], orders[o]);
+      benchReport(BENCH_SUITE, "push_data", params, &result);
+      releaseFilter();
+    }
+  }
+}
+
+/**
+ * @test The per-sample cost of adcAcqFilterPushBlock, the DMA block path, per sample of a channel.
+ */
+ZTEST(adcAcquisitionBench, test_push_block)
+{
+  uint32_t pushCount;
+  BenchResult_t result;
+  BenchStamp_t start;
+  char params[BENCH_PARAMS_SIZE];
+
+  for(size_t c = 0; c < ARRAY_SIZE(chanCounts); ++c)
+  {
+    for(size_t o = 0; o < ARRAY_SIZE(orders); ++o)
+    {
+      /* The same sample count is pushed whatever the channel count */
+      pushCount = BENCH_SAMPLE_OPS / (BENCH_SCAN_COUNT * chanCounts[c]);
+
+      initFilter(chanCounts[c], orders[o]);
+      benchStart(&result, pushCount * BENCH_SCAN_COUNT * chanCounts[c]);
+
+      for(uint32_t s = 0; s < BENCH_SAMPLE_COUNT; ++s)
+      {
+        start = benchNow();
+        for(uint32_t i = 0; i < pushCount; ++i)
+          adcAcqFilterPushBlock(block, BENCH_SCAN_COUNT);
+        benchRecord(&result, start, benchNow());
+      }
+
+      snprintk(params, sizeof(params), "\"chan_count\":%zu,\"order\":%u", chanCounts[c], orders[o]);
+      benchReport(BENCH_SUITE, "push_block", params, &result);
+      releaseFilter();
+    }
+  }
+}
+
+ZTEST_SUITE(adcAcquisitionBench, NULL, bench_setup, NULL, NULL, NULL);
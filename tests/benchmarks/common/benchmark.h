@@ -0,0 +1,204 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      benchmark.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Benchmark Helpers
+ *
+ *            Timing and reporting helpers shared by the service benchmarks.
+ *
+ *            The samples are timed with the timing functions when
+ *            CONFIG_TIMING_FUNCTIONS is enabled, the cycle counter of the
+ *            boards. The native simulator time only advances while its CPU is
+ *            idle, so the host time is used there instead, through the native
+ *            RTC. The system timer cycles are used otherwise.
+ *
+ *            Each result is printed as a single line, "BENCH " followed by a
+ *            JSON object, collected by run-benchmarks.sh.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <stdint.h>
+
+#if defined(CONFIG_TIMING_FUNCTIONS)
+#include <zephyr/timing/timing.h>
+#elif defined(CONFIG_ARCH_POSIX)
+#include "native_rtc.h"
+#endif
+
+/**
+ * @brief   The sample count of a benchmark case.
+ */
+#ifndef BENCH_SAMPLE_COUNT
+#define BENCH_SAMPLE_COUNT                                      (16)
+#endif
+
+/**
+ * @brief   The operation count timed by a sample.
+ * @note    Large enough for the microsecond resolution of the host time.
+ */
+#ifndef BENCH_SAMPLE_OPS
+#define BENCH_SAMPLE_OPS                                        (256)
+#endif
+
+/**
+ * @brief   The benchmark clock name.
+ */
+#if defined(CONFIG_TIMING_FUNCTIONS)
+#define BENCH_CLOCK_NAME                                        "cycles"
+#elif defined(CONFIG_ARCH_POSIX)
+#define BENCH_CLOCK_NAME                                        "host"
+#else
+#define BENCH_CLOCK_NAME                                        "sys"
+#endif
+
+/**
+ * @brief   The benchmark parameters buffer size.
+ */
+#define BENCH_PARAMS_SIZE                                       (64)
+
+/**
+ * @brief   The benchmark timestamp.
+ */
+#if defined(CONFIG_TIMING_FUNCTIONS)
+typedef timing_t BenchStamp_t;
+#else
+typedef uint64_t BenchStamp_t;
+#endif
+
+/**
+ * @brief   The benchmark case result, in nanoseconds per operation.
+ */
+typedef struct
+{
+  uint32_t sampleCount;                 /**< The recorded sample count */
+  uint32_t sampleOps;                   /**< The operation count of each sample */
+  uint64_t minNs;                       /**< The fastest sample */
+  uint64_t maxNs;                       /**< The slowest sample */
+  uint64_t totalNs;                     /**< The time of every sample */
+} BenchResult_t;
+
+/**
+ * @brief   Initialize the benchmark clock.
+ */
+static inline void benchInit(void)
+{
+#if defined(CONFIG_TIMING_FUNCTIONS)
+  timing_init();
+  timing_start();
+#endif
+}
+
+/**
+ * @brief   Get the benchmark clock timestamp.
+ *
+ * @return  The timestamp.
+ */
+static inline BenchStamp_t benchNow(void)
+{
+#if defined(CONFIG_TIMING_FUNCTIONS)
+  return timing_counter_get();
+#elif defined(CONFIG_ARCH_POSIX)
+  return native_rtc_gettime_us(RTC_CLOCK_PSEUDOHOSTREALTIME);
+#else
+  return k_cycle_get_32();
+#endif
+}
+
+/**
+ * @brief   Get the time elapsed between two timestamps.
+ *
+ * @param[in]   start: The start timestamp.
+ * @param[in]   end: The end timestamp.
+ *
+ * @return  The elapsed time [ns].
+ */
+static inline uint64_t benchElapsedNs(BenchStamp_t start, BenchStamp_t end)
+{
+#if defined(CONFIG_TIMING_FUNCTIONS)
+  return timing_cycles_to_ns(timing_cycles_get(&start, &end));
+#elif defined(CONFIG_ARCH_POSIX)
+  return (end - start) * NSEC_PER_USEC;
+#else
+  /* The 32-bit cycle counter wraps, its difference does not */
+  return k_cyc_to_ns_floor64((uint32_t)end - (uint32_t)start);
+#endif
+}
+
+/**
+ * @brief   Start a benchmark case result.
+ *
+ * @param[out]  result: The case result.
+ * @param[in]   sampleOps: The operation count of each sample.
+ */
+static inline void benchStart(BenchResult_t *result, uint32_t sampleOps)
+{
+  result->sampleCount = 0;
+  result->sampleOps = sampleOps;
+  result->minNs = UINT64_MAX;
+  result->maxNs = 0;
+  result->totalNs = 0;
+}
+
+/**
+ * @brief   Record a sample of a benchmark case.
+ *
+ * @param[in,out]   result: The case result.
+ * @param[in]       start: The sample start timestamp.
+ * @param[in]       end: The sample end timestamp.
+ */
+static inline void benchRecord(BenchResult_t *result, BenchStamp_t start, BenchStamp_t end)
+{
+  uint64_t ns = benchElapsedNs(start, end);
+
+  result->minNs = MIN(result->minNs, ns);
+  result->maxNs = MAX(result->maxNs, ns);
+  result->totalNs += ns;
+  ++result->sampleCount;
+}
+
+/**
+ * @brief   Get the mean time of an operation.
+ *
+ * @param[in]   result: The case result.
+ *
+ * @return  The mean operation time [ns], 0 without sample.
+ */
+static inline uint64_t benchMeanNs(const BenchResult_t *result)
+{
+  uint64_t opCount = (uint64_t)result->sampleCount * result->sampleOps;
+
+  return opCount == 0 ? 0 : result->totalNs / opCount;
+}
+
+/**
+ * @brief   Report a benchmark case result.
+ *
+ * @note    The min, mean and max times are per operation, the throughput
+ *          being 0 when the clock resolution was too coarse to time a sample.
+ *
+ * @param[in]   suite: The benchmark suite name.
+ * @param[in]   name: The benchmark case name.
+ * @param[in]   params: The case parameters, as JSON members, NULL for none.
+ * @param[in]   result: The case result.
+ */
+static inline void benchReport(const char *suite, const char *name, const char *params,
+                               const BenchResult_t *result)
+{
+  uint64_t opCount = (uint64_t)result->sampleCount * result->sampleOps;
+  uint64_t opsPerSec = result->totalNs == 0 ? 0 : opCount * NSEC_PER_SEC / result->totalNs;
+
+  printk("BENCH {\"suite\":\"%s\",\"case\":\"%s\",%s%s\"clock\":\"%s\",\"samples\":%u,\"ops\":%u,"
+         "\"min_ns\":%llu,\"mean_ns\":%llu,\"max_ns\":%llu,\"ops_per_s\":%llu}\n",
+         suite, name, params ? params : "", params ? "," : "", BENCH_CLOCK_NAME, result->sampleCount,
+         result->sampleOps, (unsigned long long)(result->sampleCount ? result->minNs / result->sampleOps : 0),
+         (unsigned long long)benchMeanNs(result), (unsigned long long)(result->maxNs / result->sampleOps),
+         (unsigned long long)opsPerSec);
+}
+
+#endif /* BENCHMARK_H */
@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreMeta.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Metadata for the Benchmarks
+ *
+ *            Benchmark datapoint definitions, a range of unsigned integer
+ *            datapoints for the request sizes and a datapoint of each other
+ *            type.
+ */
+
+#ifndef DATASTORE_META_H
+#define DATASTORE_META_H
+
+#include <zephyr/sys/util.h>
+
+#include "datastoreTypes.h"
+
+/**
+ * @brief   The benchmarked unsigned integer datapoint count.
+ */
+#define BENCH_UINT_DATAPOINT_COUNT 64
+
+/**
+ * @brief   Define a benchmarked unsigned integer datapoint.
+ */
+#define BENCH_UINT_DATAPOINT(i, _) X(UINT_BENCH_DATAPOINT_##i, DATAPOINT_NO_FLAG_MASK, 0)
+
+/**
+ * @brief   Binary datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_BINARY_DATAPOINTS \
+  X(BINARY_BENCH_DATAPOINT, DATAPOINT_NO_FLAG_MASK, false)
+
+/**
+ * @brief   Button datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_BUTTON_DATAPOINTS \
+  X(BUTTON_BENCH_DATAPOINT, DATAPOINT_NO_FLAG_MASK, BUTTON_UNPRESSED)
+
+/**
+ * @brief   Float datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_FLOAT_DATAPOINTS \
+  X(FLOAT_BENCH_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0.0f)
+
+/**
+ * @brief   Signed integer datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_INT_DATAPOINTS \
+  X(INT_BENCH_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0)
+
+/**
+ * @brief   Multi-state datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_MULTI_STATE_DATAPOINTS \
+  X(MULTI_STATE_BENCH_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0)
+
+/**
+ * @brief   Unsigned integer datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_UINT_DATAPOINTS \
+  LISTIFY(BENCH_UINT_DATAPOINT_COUNT, BENCH_UINT_DATAPOINT, ())
+
+#endif /* DATASTORE_META_H */
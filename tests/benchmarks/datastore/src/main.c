@@ -0,0 +1,314 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Benchmarks
+ *
+ *            Read and write round trips through the datastore thread against
+ *            the request value count and the subscriber count, and the
+ *            notification fan-out cost. The datastore runs its real thread,
+ *            queues and memory pools, only the service manager being stubbed.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+/* A round trip takes a few microseconds, fewer are timed by each sample */
+#define BENCH_SAMPLE_OPS                                        (64)
+
+#include "benchmark.h"
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_LOG_LEVEL LOG_LEVEL_WRN
+#define CONFIG_ENYA_DATASTORE_MSGQ_TIMEOUT 10
+#define CONFIG_ENYA_DATASTORE_STACK_SIZE 2048
+#define CONFIG_ENYA_DATASTORE_MAX_BINARY_SUBS 0
+#define CONFIG_ENYA_DATASTORE_MAX_BUTTON_SUBS 0
+#define CONFIG_ENYA_DATASTORE_MAX_FLOAT_SUBS 0
+#define CONFIG_ENYA_DATASTORE_MAX_INT_SUBS 0
+#define CONFIG_ENYA_DATASTORE_MAX_MULTI_STATE_SUBS 0
+#define CONFIG_ENYA_DATASTORE_MAX_UINT_SUBS 9
+#define CONFIG_ENYA_DATASTORE_THREAD_PRIORITY 5
+#define CONFIG_ENYA_DATASTORE_SERVICE_PRIORITY 1
+#define CONFIG_ENYA_DATASTORE_HEARTBEAT_INTERVAL_MS 1000
+#define CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES 4
+#define CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT 2
+#define CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES 16
+#define CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_COUNT 2
+#define CONFIG_ENYA_DATASTORE_LARGE_BUFFER_COUNT 2
+#define CONFIG_ENYA_DATASTORE_NOTIFY_BUFFER_COUNT 10
+
+/* The datastore thread serves every benchmark */
+#define DATASTORE_RUN_ITERATIONS SIZE_MAX
+
+#include "datastore.c"
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+#include "datastoreUtil.c"
+
+/* The datastore runs outside of the service manager supervision */
+int serviceManagerRegisterSrv(const ServiceDescriptor_t *descriptor, ServiceHandle_t *handle)
+{
+  ARG_UNUSED(descriptor);
+
+  *handle = 0;
+
+  return 0;
+}
+
+int serviceManagerConfirmState(ServiceHandle_t handle, ServiceState_t state)
+{
+  ARG_UNUSED(handle);
+  ARG_UNUSED(state);
+
+  return 0;
+}
+
+int serviceManagerUpdateHeartbeat(ServiceHandle_t handle)
+{
+  ARG_UNUSED(handle);
+
+  return 0;
+}
+
+/**
+ * @brief   The benchmark suite name.
+ */
+#define BENCH_SUITE                                             "datastore"
+
+/**
+ * @brief   The benchmarked request value counts, from the small pool to the large one.
+ */
+static const size_t valCounts[] = {1, CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES,
+                                   CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES, BENCH_UINT_DATAPOINT_COUNT};
+
+/**
+ * @brief   The benchmarked subscriber counts.
+ */
+static const size_t subCounts[] = {0, 1, 2, 4, CONFIG_ENYA_DATASTORE_MAX_UINT_SUBS - 1};
+
+/**
+ * @brief   The benchmark response queue.
+ */
+K_MSGQ_DEFINE(benchResponse, sizeof(int), 1, 4);
+
+/**
+ * @brief   The benchmark notification count.
+ */
+static atomic_t notifyCount;
+
+/**
+ * @brief   The benchmark values.
+ */
+static uint32_t values[BENCH_UINT_DATAPOINT_COUNT];
+
+/**
+ * @brief   The benchmark subscription callback, releasing its notification.
+ *
+ * @param[in]   payload: The notification payload.
+ * @param[in]   valCount: The notified value count.
+ *
+ * @return  0.
+ */
+static int benchSubCallback(SrvMsgPayload_t *payload, size_t valCount)
+{
+  ARG_UNUSED(valCount);
+
+  atomic_inc(&notifyCount);
+  osMemoryPoolFree(payload->poolId, payload);
+
+  return 0;
+}
+
+/**
+ * @brief   Subscribe to the first benchmarked datapoint.
+ *
+ * @param[in]   subCount: The subscription count.
+ */
+static void subscribe(size_t subCount)
+{
+  DatastoreSubEntry_t sub = {.datapointId = 0, .valCount = 1, .isPaused = false, .callback = benchSubCallback};
+
+  for(size_t i = 0; i < subCount; ++i)
+    zassert_equal(datastoreSubscribeUint(&sub), 0, "subscription failed");
+}
+
+/**
+ * @brief   Unsubscribe from the first benchmarked datapoint.
+ *
+ * @param[in]   subCount: The subscription count.
+ */
+static void unsubscribe(size_t subCount)
+{
+  for(size_t i = 0; i < subCount; ++i)
+    zassert_equal(datastoreUnsubscribeUint(benchSubCallback), 0, "unsubscription failed");
+}
+
+/**
+ * @brief   Time the write round trips of a value range.
+ *
+ * @note    Every write changes the range, notifying its subscribers.
+ *
+ * @param[out]  result: The case result.
+ * @param[in]   valCount: The range value count.
+ *
+ * @return  0 if every write succeeded, a combination of the error codes otherwise.
+ */
+static int benchWrites(BenchResult_t *result, size_t valCount)
+{
+  int err = 0;
+  BenchStamp_t start;
+
+  benchStart(result, BENCH_SAMPLE_OPS);
+
+  for(uint32_t s = 0; s < BENCH_SAMPLE_COUNT; ++s)
+  {
+    start = benchNow();
+    for(uint32_t i = 0; i < BENCH_SAMPLE_OPS; ++i)
+    {
+      ++values[0];
+      err |= datastoreWriteUint(0, values, valCount, &benchResponse);
+    }
+    benchRecord(result, start, benchNow());
+  }
+
+  return err;
+}
+
+/**
+ * @brief Setup function called before all benchmarks in the suite.
+ */
+static void *bench_setup(void)
+{
+  zassert_equal(datastoreInit(), 0, "datastore init failed");
+  zassert_equal(onStart(), 0, "datastore start failed");
+
+  benchInit();
+
+  return NULL;
+}
+
+/**
+ * @brief Setup function called before each benchmark in the suite.
+ */
+static void bench_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  k_msgq_purge(&benchResponse);
+  atomic_clear(&notifyCount);
+}
+
+/**
+ * @test The read round trip against the request value count.
+ */
+ZTEST(datastoreBench, test_read)
+{
+  int err;
+  BenchResult_t result;
+  BenchStamp_t start;
+  char params[BENCH_PARAMS_SIZE];
+
+  for(size_t c = 0; c < ARRAY_SIZE(valCounts); ++c)
+  {
+    err = 0;
+    benchStart(&result, BENCH_SAMPLE_OPS);
+
+    for(uint32_t s = 0; s < BENCH_SAMPLE_COUNT; ++s)
+    {
+      start = benchNow();
+      for(uint32_t i = 0; i < BENCH_SAMPLE_OPS; ++i)
+        err |= datastoreReadUint(0, valCounts[c], &benchResponse, values);
+      benchRecord(&result, start, benchNow());
+    }
+
+    zassert_equal(err, 0, "the reads should succeed");
+
+    snprintk(params, sizeof(params), "\"val_count\":%zu", valCounts[c]);
+    benchReport(BENCH_SUITE, "read", params, &result);
+  }
+}
+
+/**
+ * @test The write round trip against the request value count, without subscriber.
+ */
+ZTEST(datastoreBench, test_write)
+{
+  BenchResult_t result;
+  char params[BENCH_PARAMS_SIZE];
+
+  for(size_t c = 0; c < ARRAY_SIZE(valCounts); ++c)
+  {
+    zassert_equal(benchWrites(&result, valCounts[c]), 0, "the writes should succeed");
+
+    snprintk(params, sizeof(params), "\"val_count\":%zu", valCounts[c]);
+    benchReport(BENCH_SUITE, "write", params, &result);
+  }
+
+  zassert_equal(atomic_get(&notifyCount), 0, "no subscriber should be notified");
+}
+
+/**
+ * @test The write round trip against the subscriber count of the written datapoint.
+ */
+ZTEST(datastoreBench, test_write_subscribers)
+{
+  BenchResult_t result;
+  char params[BENCH_PARAMS_SIZE];
+
+  for(size_t c = 0; c < ARRAY_SIZE(subCounts); ++c)
+  {
+    subscribe(subCounts[c]);
+    atomic_clear(&notifyCount);
+
+    zassert_equal(benchWrites(&result, 1), 0, "the writes should succeed");
+
+    zassert_equal(atomic_get(&notifyCount), subCounts[c] * BENCH_SAMPLE_COUNT * BENCH_SAMPLE_OPS,
+                  "every subscriber should be notified of every write");
+    unsubscribe(subCounts[c]);
+
+    snprintk(params, sizeof(params), "\"sub_count\":%zu", subCounts[c]);
+    benchReport(BENCH_SUITE, "write_subscribers", params, &result);
+  }
+}
+
+/**
+ * @test The notification fan-out of a changed datapoint against its subscriber count.
+ */
+ZTEST(datastoreBench, test_notify_fanout)
+{
+  int err = 0;
+  BenchResult_t result;
+  BenchStamp_t start;
+  char params[BENCH_PARAMS_SIZE];
+
+  for(size_t c = 0; c < ARRAY_SIZE(subCounts); ++c)
+  {
+    subscribe(subCounts[c]);
+    benchStart(&result, BENCH_SAMPLE_OPS);
+
+    /* The datastore thread is idle, waiting on its queue */
+    for(uint32_t s = 0; s < BENCH_SAMPLE_COUNT; ++s)
+    {
+      start = benchNow();
+      for(uint32_t i = 0; i < BENCH_SAMPLE_OPS; ++i)
+        err |= datastoreUtilNotify(DATAPOINT_UINT, 0, 1, DATASTORE_NOTIFY_POOL);
+      benchRecord(&result, start, benchNow());
+    }
+
+    unsubscribe(subCounts[c]);
+
+    snprintk(params, sizeof(params), "\"sub_count\":%zu", subCounts[c]);
+    benchReport(BENCH_SUITE, "notify_fanout", params, &result);
+  }
+
+  zassert_equal(err, 0, "the notifications should succeed");
+}
+
+ZTEST_SUITE(datastoreBench, NULL, bench_setup, bench_before, NULL, NULL);
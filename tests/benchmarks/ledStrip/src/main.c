@@ -0,0 +1,234 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     LED Strip Benchmarks
+ *
+ *            Frame push and activation time against the strip pixel count,
+ *            over strips of different chain lengths. The driver transfer is
+ *            stubbed, only the updater work being timed.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "benchmark.h"
+
+/* Prevent LED strip driver header - we'll define types manually */
+#define ZEPHYR_INCLUDE_DRIVERS_LED_STRIP_H_
+
+/* Prevent CMSIS OS2 header - we'll define types manually */
+#define CMSIS_OS2_H_
+
+/* Wrap the driver transfer to use the stub */
+#define led_strip_update_rgb led_strip_update_rgb_stub
+
+/* Mock CMSIS OS2 types */
+typedef void *osMemoryPoolId_t;
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_LED_STRIP 1
+#define CONFIG_ENYA_LED_STRIP_LOG_LEVEL 2
+#define CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ 50
+#define CONFIG_ENYA_LED_STRIP_KEEP_ALIVE_MS 100
+#define CONFIG_ENYA_LED_STRIP_DIRTY_SPAN 1
+#define CONFIG_ENYA_LED_STRIP_GAMMA 1
+#define CONFIG_ENYA_LED_STRIP_FRAMEBUFFER_COUNT 2
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ledStrip, LOG_LEVEL_WRN);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+struct led_rgb { uint8_t r; uint8_t g; uint8_t b; };
+
+/**
+ * @brief   The driver transfer stub.
+ */
+static int led_strip_update_rgb_stub(const struct device *dev, struct led_rgb *pixels, size_t pixelCount)
+{
+  ARG_UNUSED(dev);
+  ARG_UNUSED(pixels);
+  ARG_UNUSED(pixelCount);
+
+  return 0;
+}
+
+/* The framebuffers are the benchmark frames, the pools are never used */
+osMemoryPoolId_t osMemoryPoolNew(uint32_t blockCount, uint32_t blockSize, void *attr)
+{
+  ARG_UNUSED(blockCount);
+  ARG_UNUSED(blockSize);
+  ARG_UNUSED(attr);
+
+  return NULL;
+}
+
+void *osMemoryPoolAlloc(osMemoryPoolId_t pool, uint32_t timeout)
+{
+  ARG_UNUSED(pool);
+  ARG_UNUSED(timeout);
+
+  return NULL;
+}
+
+int osMemoryPoolFree(osMemoryPoolId_t pool, void *block)
+{
+  ARG_UNUSED(pool);
+  ARG_UNUSED(block);
+
+  return 0;
+}
+
+/* Mock LED strip devices */
+static const struct device benchStripDev = {.name = "bench_led_strip"};
+
+/* Override device tree macros, with a strip alias of each benchmarked pixel count */
+#undef DT_ALIAS
+#define DT_ALIAS(name) DT_N_ALIAS_##name
+
+#undef DT_HAS_ALIAS
+#define DT_HAS_ALIAS(name) DT_HAS_ALIAS_##name
+#define DT_HAS_ALIAS_led_strip   1
+#define DT_HAS_ALIAS_led_strip_1 1
+#define DT_HAS_ALIAS_led_strip_2 1
+#define DT_HAS_ALIAS_led_strip_3 1
+
+#undef DEVICE_DT_GET
+#define DEVICE_DT_GET(node_id) (&benchStripDev)
+
+/* Mock DT node properties for the aliases */
+#define DT_N_ALIAS_led_strip_P_chain_length          8
+#define DT_N_ALIAS_led_strip_1_P_chain_length        64
+#define DT_N_ALIAS_led_strip_2_P_chain_length        256
+#define DT_N_ALIAS_led_strip_3_P_chain_length        1024
+
+#include "ledStripUtil.c"
+
+/**
+ * @brief   The benchmark suite name.
+ */
+#define BENCH_SUITE                                             "ledStrip"
+
+/**
+ * @brief   The largest strip pixel count.
+ */
+#define BENCH_MAX_PIXEL_COUNT                                   DT_N_ALIAS_led_strip_3_P_chain_length
+
+/**
+ * @brief   The pixel count pushed by each sample, whatever the strip.
+ */
+#define BENCH_SAMPLE_PIXELS                                     (262144)
+
+/**
+ * @brief   The benchmark frames, activated in turn.
+ */
+static struct led_rgb frames[2][BENCH_MAX_PIXEL_COUNT];
+
+/**
+ * @brief Setup function called before all benchmarks in the suite.
+ */
+static void *bench_setup(void)
+{
+  for(size_t i = 0; i < BENCH_MAX_PIXEL_COUNT; ++i)
+  {
+    frames[0][i] = (struct led_rgb){.r = i, .g = i >> 1, .b = i >> 2};
+    frames[1][i] = frames[0][i];
+  }
+
+  benchInit();
+
+  return NULL;
+}
+
+/**
+ * @brief Setup function called before each benchmark in the suite.
+ */
+static void bench_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  for(size_t i = 0; i < STRIP_COUNT; ++i)
+  {
+    ledStripUtilSetBrightness(i, 128);
+    strips[i].activeFrame    = frames[0];
+    strips[i].pendingFrame   = NULL;
+    strips[i].idleFrameCount = 0;
+  }
+}
+
+/**
+ * @test The push time of a full frame, through the level table to the driver.
+ */
+ZTEST(ledStripBench, test_push_frame)
+{
+  uint32_t pushCount;
+  BenchResult_t result;
+  BenchStamp_t start;
+  LedStripInstance_t *strip;
+  char params[BENCH_PARAMS_SIZE];
+
+  for(size_t i = 0; i < STRIP_COUNT; ++i)
+  {
+    strip = strips + i;
+    pushCount = BENCH_SAMPLE_PIXELS / strip->pixelCount;
+    benchStart(&result, pushCount);
+
+    for(uint32_t s = 0; s < BENCH_SAMPLE_COUNT; ++s)
+    {
+      start = benchNow();
+      for(uint32_t p = 0; p < pushCount; ++p)
+      {
+        strip->dirtyCount = strip->pixelCount;
+        pushStrip(strip, false);
+      }
+      benchRecord(&result, start, benchNow());
+    }
+
+    zassert_equal(strip->dirtyCount, 0, "the strip should be pushed");
+
+    snprintk(params, sizeof(params), "\"pixel_count\":%u", strip->pixelCount);
+    benchReport(BENCH_SUITE, "push_frame", params, &result);
+  }
+}
+
+/**
+ * @test The activation time of an unchanged frame, the dirty span scanning the whole frame.
+ */
+ZTEST(ledStripBench, test_activate_frame)
+{
+  uint32_t activationCount;
+  BenchResult_t result;
+  BenchStamp_t start;
+  LedStripInstance_t *strip;
+  char params[BENCH_PARAMS_SIZE];
+
+  for(size_t i = 0; i < STRIP_COUNT; ++i)
+  {
+    strip = strips + i;
+    activationCount = BENCH_SAMPLE_PIXELS / strip->pixelCount;
+    strip->dirtyCount = 0;
+    benchStart(&result, activationCount);
+
+    for(uint32_t s = 0; s < BENCH_SAMPLE_COUNT; ++s)
+    {
+      start = benchNow();
+      for(uint32_t a = 0; a < activationCount; ++a)
+        ledStripUtilActivateFrame(i, frames[a & 1]);
+      benchRecord(&result, start, benchNow());
+    }
+
+    zassert_equal(strip->dirtyCount, 0, "identical frames should leave the strip clean");
+
+    snprintk(params, sizeof(params), "\"pixel_count\":%u", strip->pixelCount);
+    benchReport(BENCH_SUITE, "activate_frame", params, &result);
+  }
+}
+
+ZTEST_SUITE(ledStripBench, NULL, bench_setup, bench_before, NULL, NULL);
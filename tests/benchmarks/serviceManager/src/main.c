@@ -0,0 +1,201 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Manager Benchmarks
+ *
+ *            Supervision pass cost against the registered service count. The
+ *            watchdog driver is stubbed, only the registry work being timed.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* A supervision pass takes well under a microsecond for a few services */
+#define BENCH_SAMPLE_OPS                                        (4096)
+
+#include "benchmark.h"
+
+/* Prevent watchdog driver header - we'll define types manually */
+#define ZEPHYR_INCLUDE_DRIVERS_WATCHDOG_H_
+
+/* Wrap the watchdog driver to use the stubs */
+#define wdt_install_timeout wdt_install_timeout_stub
+#define wdt_setup wdt_setup_stub
+#define wdt_feed wdt_feed_stub
+
+/* Define watchdog types manually */
+struct wdt_timeout_cfg {
+  uint32_t flags;
+  struct {
+    uint32_t min;
+    uint32_t max;
+  } window;
+  void (*callback)(const struct device *, int);
+};
+
+/* Define watchdog constants */
+#define WDT_FLAG_RESET_SOC (1 << 0)
+#define WDT_OPT_PAUSE_HALTED_BY_DBG (1 << 0)
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_SERVICE_MANAGER 1
+#define CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL 2
+#define CONFIG_SVC_MGR_WDT_TIMEOUT_MS 5000
+#define CONFIG_SVC_MGR_MAX_SERVICES 32
+#define CONFIG_SVC_MGR_STATS 1
+#define CONFIG_SVC_MGR_RECOVERY_WINDOW_MS 60000
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(serviceManager, LOG_LEVEL_WRN);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/**
+ * @brief   The watchdog timeout install stub.
+ */
+static int wdt_install_timeout_stub(const struct device *dev, const struct wdt_timeout_cfg *cfg)
+{
+  ARG_UNUSED(dev);
+  ARG_UNUSED(cfg);
+
+  return 0;
+}
+
+/**
+ * @brief   The watchdog setup stub.
+ */
+static int wdt_setup_stub(const struct device *dev, uint8_t options)
+{
+  ARG_UNUSED(dev);
+  ARG_UNUSED(options);
+
+  return 0;
+}
+
+/**
+ * @brief   The watchdog feed stub.
+ */
+static int wdt_feed_stub(const struct device *dev, int channelId)
+{
+  ARG_UNUSED(dev);
+  ARG_UNUSED(channelId);
+
+  return 0;
+}
+
+/* Mock watchdog device */
+static const struct device benchWdgDev = {.name = "bench_watchdog"};
+
+#undef DEVICE_DT_GET
+#define DEVICE_DT_GET(node_id) (&benchWdgDev)
+
+#include "serviceManagerUtil.c"
+
+/**
+ * @brief   The benchmark suite name.
+ */
+#define BENCH_SUITE                                             "serviceManager"
+
+/**
+ * @brief   The benchmarked registered service counts.
+ */
+static const size_t serviceCounts[] = {1, 4, 8, 16, CONFIG_SVC_MGR_MAX_SERVICES};
+
+/**
+ * @brief   Register running services with a fresh heartbeat.
+ *
+ * @param[in]   serviceCount: The service count.
+ */
+static void registerServices(size_t serviceCount)
+{
+  ServiceDescriptor_t descriptor = {
+    .threadId            = k_current_get(),
+    .priority            = SVC_PRIORITY_APPLICATION,
+    .heartbeatIntervalMs = 60000,
+  };
+
+  zassert_equal(serviceMngrUtilInitSrvRegistry(), 0, "registry init failed");
+
+  for(size_t i = 0; i < serviceCount; ++i)
+  {
+    zassert_equal(serviceMngrUtilAddSrvToRegistry(&descriptor), (int)i, "service registration failed");
+    zassert_equal(serviceMngrUtilSetSrvState(i, SVC_STATE_RUNNING), 0, "service state update failed");
+    zassert_equal(serviceMngrUtilUpdateSrvHeartbeat(i), 0, "service heartbeat failed");
+  }
+}
+
+/**
+ * @brief   Run a supervision pass of the service manager thread.
+ *
+ * @note    The wakeup deadline, the heartbeat check of every service, then
+ *          the watchdog feed of a healthy system.
+ *
+ * @return  True if every service is healthy, false otherwise.
+ */
+static bool runSupervisionPass(void)
+{
+  bool canFeedWdg = true;
+
+  serviceMngrUtilGetNextHeartbeatDeadline();
+
+  for(size_t index = 0; serviceMngrUtilGetRegEntryByIndex(index) != NULL; ++index)
+  {
+    if(serviceMngrUtilCheckSrvHeartbeat(index) < 0)
+      canFeedWdg = false;
+  }
+
+  if(canFeedWdg)
+    serviceMngrUtilFeedHardWdg();
+
+  return canFeedWdg;
+}
+
+/**
+ * @brief Setup function called before all benchmarks in the suite.
+ */
+static void *bench_setup(void)
+{
+  benchInit();
+
+  return NULL;
+}
+
+/**
+ * @test The supervision pass cost against the registered service count.
+ */
+ZTEST(serviceManagerBench, test_supervision_pass)
+{
+  bool isHealthy = true;
+  BenchResult_t result;
+  BenchStamp_t start;
+  char params[BENCH_PARAMS_SIZE];
+
+  for(size_t c = 0; c < ARRAY_SIZE(serviceCounts); ++c)
+  {
+    registerServices(serviceCounts[c]);
+    benchStart(&result, BENCH_SAMPLE_OPS);
+
+    for(uint32_t s = 0; s < BENCH_SAMPLE_COUNT; ++s)
+    {
+      start = benchNow();
+      for(uint32_t i = 0; i < BENCH_SAMPLE_OPS; ++i)
+        isHealthy &= runSupervisionPass();
+      benchRecord(&result, start, benchNow());
+    }
+
+    zassert_true(isHealthy, "every service should stay healthy");
+
+    snprintk(params, sizeof(params), "\"service_count\":%zu", serviceCounts[c]);
+    benchReport(BENCH_SUITE, "supervision_pass", params, &result);
+  }
+}
+
+ZTEST_SUITE(serviceManagerBench, NULL, bench_setup, NULL, NULL, NULL);
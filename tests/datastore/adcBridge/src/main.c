@@ -0,0 +1,261 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore ADC Bridge Tests
+ *
+ *            Unit tests for the datastore ADC bridge.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_BATCH 1
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS 4
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES 8
+#define CONFIG_ENYA_DATASTORE_ADC_BRIDGE 1
+#define CONFIG_ENYA_DATASTORE_ADC_BRIDGE_PERIOD_MS 200
+
+/* The test bridge, channels 1 and 3 to the float datapoints */
+#define DATASTORE_ADC_BRIDGE_CHANNELS \
+  X(1, FLOAT_FIRST_DATAPOINT, 0.1f) \
+  X(3, FLOAT_SECOND_DATAPOINT, 0.0f)
+
+#include "datastore.h"
+#include "adcAcquisition.h"
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(datastoreBatch) \
+  FAKE(adcAcqSubscribeWithOptions) \
+  FAKE(adcAcqUnsubscribe) \
+  FAKE(adcAcqPauseSubscription) \
+  FAKE(adcAcqUnpauseSubscription) \
+  FAKE(adcAcqReleaseData)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Mock datastore functions */
+FAKE_VALUE_FUNC(int, datastoreBatch, DatastoreBatchOp_t *, size_t, struct k_msgq *);
+
+/* Mock ADC acquisition functions */
+FAKE_VALUE_FUNC(int, adcAcqSubscribeWithOptions, AdcSubCallback_t, const AdcSubOptions_t *);
+FAKE_VALUE_FUNC(int, adcAcqUnsubscribe, AdcSubCallback_t);
+FAKE_VALUE_FUNC(int, adcAcqPauseSubscription, AdcSubCallback_t);
+FAKE_VALUE_FUNC(int, adcAcqUnpauseSubscription, AdcSubCallback_t);
+FAKE_VOID_FUNC(adcAcqReleaseData, SrvMsgPayload_t *);
+
+/* Include ADC bridge implementation */
+#include "datastoreAdcBridge.c"
+
+/**
+ * The test subscribed channel count.
+ */
+#define TEST_CHAN_COUNT 2
+
+/**
+ * The captured subscription options.
+ */
+static AdcSubOptions_t capturedOptions;
+
+/**
+ * The captured batch operations and values.
+ */
+static DatastoreBatchOp_t capturedOps[CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS];
+static float capturedValues[CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS][CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES];
+
+/**
+ * The test snapshot payload.
+ */
+static struct
+{
+  SrvMsgPayload_t payload;
+  float volts[TEST_CHAN_COUNT];
+} testSnapshot;
+
+/**
+ * @brief Capture the subscription options.
+ */
+static int captureOptions(AdcSubCallback_t callback, const AdcSubOptions_t *options)
+{
+  ARG_UNUSED(callback);
+
+  capturedOptions = *options;
+
+  return 0;
+}
+
+/**
+ * @brief Capture the batch operations, the bridge buffers being on its stack.
+ */
+static int captureBatch(DatastoreBatchOp_t *ops, size_t opCount, struct k_msgq *response)
+{
+  ARG_UNUSED(response);
+
+  for(size_t i = 0; i < opCount; ++i)
+  {
+    capturedOps[i] = ops[i];
+
+    for(size_t j = 0; j < ops[i].valCount; ++j)
+      capturedValues[i][j] = ops[i].values[j].floatVal;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Notify the bridge with a snapshot of the channels 1 and 3.
+ */
+static int notifySnapshot(float chan1, float chan3)
+{
+  testSnapshot.payload.dataLen = sizeof(testSnapshot.volts);
+  testSnapshot.volts[0] = chan1;
+  testSnapshot.volts[1] = chan3;
+
+  return adcAcqSubscribeWithOptions_fake.arg0_val(&testSnapshot.payload);
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void adcBridge_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(capturedOps, 0, sizeof(capturedOps));
+  adcAcqSubscribeWithOptions_fake.custom_fake = captureOptions;
+  datastoreBatch_fake.custom_fake = captureBatch;
+
+  datastoreAdcBridgeStart();
+}
+
+/**
+ * @test datastoreAdcBridgeStart must subscribe to the mapped channels in volts.
+ */
+ZTEST(datastore_adc_bridge_tests, test_start_subscribe)
+{
+  zassert_equal(adcAcqSubscribeWithOptions_fake.call_count, 1, "The bridge should subscribe");
+  zassert_equal(capturedOptions.chanMask, BIT(1) | BIT(3), "The mapped channels should be subscribed");
+  zassert_equal(capturedOptions.periodMs, CONFIG_ENYA_DATASTORE_ADC_BRIDGE_PERIOD_MS,
+                "The bridge period should be used");
+  zassert_equal(capturedOptions.format, ADC_ACQ_FORMAT_VOLT, "The bridge should receive volts");
+
+  adcAcqSubscribeWithOptions_fake.custom_fake = NULL;
+  adcAcqSubscribeWithOptions_fake.return_val = -ENOSPC;
+
+  zassert_equal(datastoreAdcBridgeStart(), -ENOSPC, "The subscription error should be returned");
+}
+
+/**
+ * @test The first snapshot must write every mapped datapoint in a single operation.
+ */
+ZTEST(datastore_adc_bridge_tests, test_snapshot_first)
+{
+  zassert_equal(notifySnapshot(1.0f, 2.0f), 0, "The snapshot should be written");
+
+  zassert_equal(datastoreBatch_fake.call_count, 1, "A single batch should be written");
+  zassert_equal(datastoreBatch_fake.arg1_val, 1, "The consecutive datapoints should share an operation");
+  zassert_is_null(datastoreBatch_fake.arg2_val, "The batch should not wait for a response");
+  zassert_equal(capturedOps[0].opType, DATASTORE_BATCH_WRITE, "The operation should be a write");
+  zassert_equal(capturedOps[0].datapointType, DATAPOINT_FLOAT, "The operation should write floats");
+  zassert_equal(capturedOps[0].datapointId, FLOAT_FIRST_DATAPOINT, "The operation should start at the first");
+  zassert_equal(capturedOps[0].valCount, 2, "The operation should write both datapoints");
+  zassert_equal(capturedValues[0][0], 1.0f, "The channel 1 should be written");
+  zassert_equal(capturedValues[0][1], 2.0f, "The channel 3 should be written");
+  zassert_equal(adcAcqReleaseData_fake.call_count, 1, "The snapshot should be released");
+}
+
+/**
+ * @test The channels not moving beyond their deadband must not be written.
+ */
+ZTEST(datastore_adc_bridge_tests, test_snapshot_deadband)
+{
+  notifySnapshot(1.0f, 2.0f);
+
+  zassert_equal(notifySnapshot(1.05f, 2.0f), 0, "The snapshot should be filtered");
+  zassert_equal(datastoreBatch_fake.call_count, 1, "An unchanged snapshot should not be written");
+
+  notifySnapshot(1.05f, 2.01f);
+
+  zassert_equal(datastoreBatch_fake.call_count, 2, "A changed snapshot should be written");
+  zassert_equal(datastoreBatch_fake.arg1_val, 1, "Only the changed datapoint should be written");
+  zassert_equal(capturedOps[0].datapointId, FLOAT_SECOND_DATAPOINT, "The changed datapoint should be written");
+  zassert_equal(capturedOps[0].valCount, 1, "A single value should be written");
+
+  notifySnapshot(1.2f, 2.01f);
+
+  zassert_equal(datastoreBatch_fake.call_count, 3, "A move beyond the deadband should be written");
+  zassert_equal(capturedOps[0].datapointId, FLOAT_FIRST_DATAPOINT, "The moved datapoint should be written");
+  zassert_equal(capturedValues[0][0], 1.2f, "The moved value should be written");
+  zassert_equal(adcAcqReleaseData_fake.call_count, 4, "Every snapshot should be released");
+}
+
+/**
+ * @test A snapshot failing to be queued must be written again on the next one.
+ */
+ZTEST(datastore_adc_bridge_tests, test_snapshot_batchFailure)
+{
+  datastoreBatch_fake.custom_fake = NULL;
+  datastoreBatch_fake.return_val = -ENOMSG;
+
+  zassert_equal(notifySnapshot(1.0f, 2.0f), 0, "The failed snapshot should be taken, not returned to the notifier");
+  zassert_equal(adcAcqReleaseData_fake.call_count, 1, "The failed snapshot should be released once");
+
+  datastoreBatch_fake.custom_fake = captureBatch;
+  notifySnapshot(1.0f, 2.0f);
+
+  zassert_equal(datastoreBatch_fake.call_count, 2, "The dropped snapshot should be written again");
+  zassert_equal(capturedOps[0].valCount, 2, "The dropped values should be written again");
+}
+
+/**
+ * @test A snapshot not matching the subscribed channels must be rejected.
+ */
+ZTEST(datastore_adc_bridge_tests, test_snapshot_mismatch)
+{
+  testSnapshot.payload.dataLen = sizeof(float);
+
+  zassert_equal(adcAcqSubscribeWithOptions_fake.arg0_val(&testSnapshot.payload), 0,
+                "A mismatched snapshot should be taken, not returned to the notifier");
+  zassert_equal(datastoreBatch_fake.call_count, 0, "A mismatched snapshot should not be written");
+  zassert_equal(adcAcqReleaseData_fake.call_count, 1, "A mismatched snapshot should be released once");
+}
+
+/**
+ * @test The stop and pause functions must control the bridge subscription.
+ */
+ZTEST(datastore_adc_bridge_tests, test_stopAndPause)
+{
+  zassert_equal(datastoreAdcBridgeSetPaused(true), 0, "The bridge should be paused");
+  zassert_equal(adcAcqPauseSubscription_fake.arg0_val, onAdcData, "The bridge subscription should be paused");
+
+  zassert_equal(datastoreAdcBridgeSetPaused(false), 0, "The bridge should be unpaused");
+  zassert_equal(adcAcqUnpauseSubscription_fake.arg0_val, onAdcData,
+                "The bridge subscription should be unpaused");
+
+  zassert_equal(datastoreAdcBridgeStop(), 0, "The bridge should be stopped");
+  zassert_equal(adcAcqUnsubscribe_fake.arg0_val, onAdcData, "The bridge subscription should be removed");
+}
+
+ZTEST_SUITE(datastore_adc_bridge_tests, NULL, NULL, adcBridge_tests_before, NULL, NULL);
@@ -86,6 +86,63 @@ enum UintDatapoint
   UINT_DATAPOINT_COUNT,
 };
 
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE_STATS 1
+
+/* Replicate the datastore statistics types */
+#define DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT (12)
+
+typedef enum
+{
+  DATASTORE_POOL_SMALL = 0,
+  DATASTORE_POOL_MEDIUM,
+  DATASTORE_POOL_LARGE,
+  DATASTORE_POOL_NOTIFY,
+  DATASTORE_POOL_COUNT,
+} DatastorePool_t;
+
+typedef struct
+{
+  uint32_t blockSize;
+  uint32_t blockCount;
+  uint32_t usedCount;
+  uint32_t highWater;
+} DatastorePoolStats_t;
+
+typedef struct
+{
+  int64_t elapsedMs;
+  uint32_t queueHighWater;
+  uint32_t opCount;
+  uint32_t serviceTimeMaxUs;
+  uint32_t serviceTimeHist[DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT];
+  uint32_t notifyCounts[DATAPOINT_TYPE_COUNT];
+  uint32_t notifyAllocFailures;
+  uint32_t responseTimeouts;
+} DatastoreStats_t;
+
+/* Mock Kconfig batch options, small enough to split the test registry */
+#define CONFIG_ENYA_DATASTORE_BATCH 1
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS 2
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES 5
+
+/* Replicate the datastore batch types */
+typedef enum
+{
+  DATASTORE_BATCH_READ = 0,
+  DATASTORE_BATCH_WRITE,
+  DATASTORE_BATCH_OP_TYPE_COUNT,
+} DatastoreBatchOpType_t;
+
+typedef struct
+{
+  DatastoreBatchOpType_t opType;
+  DatapointType_t datapointType;
+  uint32_t datapointId;
+  size_t valCount;
+  Data_t *values;
+} DatastoreBatchOp_t;
+
 /* Captured shell output */
 #define MAX_SHELL_OUTPUT_COUNT 32
 #define MAX_SHELL_OUTPUT_LEN 256
@@ -138,6 +195,10 @@ void shell_print(const struct shell *shell, const char *fmt, ...)
 /* FFF mock declarations for datastore service */
 FAKE_VALUE_FUNC(int, datastoreRead, DatapointType_t, uint32_t, size_t, struct k_msgq *, Data_t *);
 FAKE_VALUE_FUNC(int, datastoreWrite, DatapointType_t, uint32_t, Data_t *, size_t, struct k_msgq *);
+FAKE_VALUE_FUNC(int, datastoreGetStats, DatastoreStats_t *);
+FAKE_VALUE_FUNC(int, datastoreBatch, DatastoreBatchOp_t *, size_t, struct k_msgq *);
+FAKE_VOID_FUNC(datastoreResetStats);
+FAKE_VALUE_FUNC(int, datastoreGetPoolStats, DatastorePool_t, DatastorePoolStats_t *);
 
 /* FFF mock declarations for shell functions */
 FAKE_VALUE_FUNC(unsigned long, shell_strtoul, const char *, int, int *);
@@ -157,6 +218,7 @@ FAKE_VOID_FUNC(printMultiStateLine, const struct shell *, uint32_t, const char *
 FAKE_VOID_FUNC(printUintLine, const struct shell *, uint32_t, const char *, uint32_t);
 FAKE_VOID_FUNC(toUpper, char *);
 FAKE_VALUE_FUNC(int, findDatapointByName, const char *, const DatapointEntry_t **);
+FAKE_VOID_FUNC(printDatapointValue, const struct shell *, const DatapointEntry_t *, Data_t);
 FAKE_VOID_FUNC(printBinaryValues, const struct shell *, const DatapointEntry_t *, const Data_t *, size_t);
 FAKE_VOID_FUNC(printButtonValues, const struct shell *, const DatapointEntry_t *, const Data_t *, size_t);
 FAKE_VOID_FUNC(printFloatValues, const struct shell *, const DatapointEntry_t *, const Data_t *, size_t);
@@ -173,6 +235,10 @@ FAKE_VALUE_FUNC(int, parseUintValues, char **, size_t, Data_t *);
 #define FFF_FAKES_LIST(FAKE) \
   FAKE(datastoreRead) \
   FAKE(datastoreWrite) \
+  FAKE(datastoreGetStats) \
+  FAKE(datastoreBatch) \
+  FAKE(datastoreResetStats) \
+  FAKE(datastoreGetPoolStats) \
   FAKE(shell_strtoul) \
   FAKE(shell_strtol) \
   FAKE(shell_strtobool) \
@@ -188,6 +254,7 @@ FAKE_VALUE_FUNC(int, parseUintValues, char **, size_t, Data_t *);
   FAKE(printUintLine) \
   FAKE(toUpper) \
   FAKE(findDatapointByName) \
+  FAKE(printDatapointValue) \
   FAKE(printBinaryValues) \
   FAKE(printButtonValues) \
   FAKE(printFloatValues) \
@@ -206,6 +273,7 @@ FAKE_VALUE_FUNC(int, parseUintValues, char **, size_t, Data_t *);
 #define shell_error(shell, fmt, ...) shell_fprintf(shell, SHELL_ERROR, fmt, ##__VA_ARGS__)
 #define SHELL_CMD(...)
 #define SHELL_CMD_ARG(...)
+#define SHELL_COND_CMD_ARG(...)
 #define SHELL_SUBCMD_SET_END
 #define SHELL_STATIC_SUBCMD_SET_CREATE(...)
 #define SHELL_CMD_REGISTER(...)
@@ -271,6 +339,11 @@ static const size_t testRegistrySize = BINARY_DATAPOINT_COUNT + BUTTON_DATAPOINT
                                         FLOAT_DATAPOINT_COUNT + INT_DATAPOINT_COUNT +
                                         MULTI_STATE_DATAPOINT_COUNT + UINT_DATAPOINT_COUNT;
 
+/* Test datapoint count of each type, each type being read as a single range */
+static const size_t testTypeCounts[DATAPOINT_TYPE_COUNT] = {BINARY_DATAPOINT_COUNT, BUTTON_DATAPOINT_COUNT,
+                                                            FLOAT_DATAPOINT_COUNT, INT_DATAPOINT_COUNT,
+                                                            MULTI_STATE_DATAPOINT_COUNT, UINT_DATAPOINT_COUNT};
+
 /**
  * @brief Custom fake for shell_strtoul that returns error.
  */
@@ -377,8 +450,8 @@ ZTEST(datastore_cmd_tests, test_exec_list_datastore_read_fails)
   result = execList(shell, 1, argv);
 
   zassert_equal(result, 0, "execList should return 0 even when datastoreRead fails");
-  zassert_equal(datastoreRead_fake.call_count, testRegistrySize,
-                "datastoreRead should be called for each datapoint");
+  zassert_equal(datastoreRead_fake.call_count, DATAPOINT_TYPE_COUNT,
+                "datastoreRead should be called once per datapoint type");
   zassert_equal(getDatapointRegistry_fake.call_count, 1,
                 "getDatapointRegistry should be called once");
   zassert_equal(getDatapointRegistrySize_fake.call_count, 1,
@@ -387,13 +460,13 @@ ZTEST(datastore_cmd_tests, test_exec_list_datastore_read_fails)
                 "printTableHeader should be called once");
 
   /* Verify datastoreRead was called with correct parameters for each datapoint */
-  for (size_t i = 0; i < testRegistrySize; i++)
+  for (size_t i = 0; i < DATAPOINT_TYPE_COUNT; i++)
   {
-    zassert_equal(datastoreRead_fake.arg0_history[i], testRegistry[i].type,
+    zassert_equal(datastoreRead_fake.arg0_history[i], i,
                   "datastoreRead call %zu: incorrect type", i);
-    zassert_equal(datastoreRead_fake.arg1_history[i], testRegistry[i].id,
+    zassert_equal(datastoreRead_fake.arg1_history[i], 0,
                   "datastoreRead call %zu: incorrect ID", i);
-    zassert_equal(datastoreRead_fake.arg2_history[i], 1,
+    zassert_equal(datastoreRead_fake.arg2_history[i], testTypeCounts[i],
                   "datastoreRead call %zu: incorrect value count", i);
   }
 }
@@ -455,8 +528,8 @@ ZTEST(datastore_cmd_tests, test_exec_list_success)
   result = execList(shell, 1, argv);
 
   zassert_equal(result, 0, "execList should return 0 on success");
-  zassert_equal(datastoreRead_fake.call_count, testRegistrySize,
-                "datastoreRead should be called for each datapoint");
+  zassert_equal(datastoreRead_fake.call_count, DATAPOINT_TYPE_COUNT,
+                "datastoreRead should be called once per datapoint type");
   zassert_equal(getDatapointRegistry_fake.call_count, 1,
                 "getDatapointRegistry should be called once");
   zassert_equal(getDatapointRegistrySize_fake.call_count, 1,
@@ -467,13 +540,13 @@ ZTEST(datastore_cmd_tests, test_exec_list_success)
                 "printTableHeader should be called with correct shell");
 
   /* Verify datastoreRead parameters for each call */
-  for (size_t i = 0; i < testRegistrySize; i++)
+  for (size_t i = 0; i < DATAPOINT_TYPE_COUNT; i++)
   {
-    zassert_equal(datastoreRead_fake.arg0_history[i], testRegistry[i].type,
+    zassert_equal(datastoreRead_fake.arg0_history[i], i,
                   "datastoreRead call %zu: incorrect type", i);
-    zassert_equal(datastoreRead_fake.arg1_history[i], testRegistry[i].id,
+    zassert_equal(datastoreRead_fake.arg1_history[i], 0,
                   "datastoreRead call %zu: incorrect ID", i);
-    zassert_equal(datastoreRead_fake.arg2_history[i], 1,
+    zassert_equal(datastoreRead_fake.arg2_history[i], testTypeCounts[i],
                   "datastoreRead call %zu: incorrect value count", i);
   }
 
@@ -1523,4 +1596,204 @@ ZTEST(datastore_cmd_tests, test_exec_write_uint_success)
                 "shell_error should not be called on success");
 }
 
+/* Statistics returned by the datastoreGetStats mock */
+static int datastoreGetStats_custom(DatastoreStats_t *stats)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->elapsedMs = 5000;
+  stats->queueHighWater = 4;
+  stats->opCount = 12;
+  stats->serviceTimeMaxUs = 250;
+  stats->serviceTimeHist[0] = 2;
+  stats->serviceTimeHist[3] = 10;
+  stats->notifyCounts[DATAPOINT_BINARY] = 20;
+  stats->notifyAllocFailures = 1;
+  stats->responseTimeouts = 3;
+  return 0;
+}
+
+/* Pool statistics returned by the datastoreGetPoolStats mock */
+static int datastoreGetPoolStats_custom(DatastorePool_t pool, DatastorePoolStats_t *stats)
+{
+  stats->blockSize = 64;
+  stats->blockCount = 8;
+  stats->usedCount = pool;
+  stats->highWater = 5;
+  return 0;
+}
+
+/* Find a captured shell output line */
+static bool hasShellOutput(const char *line)
+{
+  for(int i = 0; i < shell_output_index; ++i)
+  {
+    if(strcmp(captured_shell_output[i], line) == 0)
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * @test  execStats must reject an unknown option.
+ */
+ZTEST(datastore_cmd_tests, test_exec_stats_unknown_option)
+{
+  char *argv[] = {"stats", "clear"};
+  int ret;
+
+  ret = execStats(NULL, 2, argv);
+
+  zassert_equal(ret, -EINVAL, "execStats should return -EINVAL for an unknown option");
+  zassert_equal(shell_error_call_count, 1, "an error should be printed");
+  zassert_equal(datastoreResetStats_fake.call_count, 0, "the statistics should not be reset");
+  zassert_equal(datastoreGetStats_fake.call_count, 0, "the statistics should not be read");
+}
+
+/**
+ * @test  execStats must reset the statistics with the reset option.
+ */
+ZTEST(datastore_cmd_tests, test_exec_stats_reset)
+{
+  char *argv[] = {"stats", "reset"};
+  int ret;
+
+  ret = execStats(NULL, 2, argv);
+
+  zassert_equal(ret, 0, "execStats should succeed");
+  zassert_equal(datastoreResetStats_fake.call_count, 1, "the statistics should be reset");
+  zassert_equal(datastoreGetStats_fake.call_count, 0, "the statistics should not be read");
+  zassert_equal(shell_info_call_count, 1, "a success message should be printed");
+  zassert_str_equal(captured_shell_output[0], "SUCCESS: statistics reset", "wrong success message");
+}
+
+/**
+ * @test  execStats must return the error when the statistics cannot be read.
+ */
+ZTEST(datastore_cmd_tests, test_exec_stats_get_failure)
+{
+  char *argv[] = {"stats"};
+  int ret;
+
+  datastoreGetStats_fake.return_val = -EINVAL;
+
+  ret = execStats(NULL, 1, argv);
+
+  zassert_equal(ret, -EINVAL, "execStats should return the datastoreGetStats error");
+  zassert_equal(shell_error_call_count, 1, "an error should be printed");
+  zassert_equal(datastoreGetPoolStats_fake.call_count, 0, "the pool statistics should not be read");
+}
+
+/**
+ * @test  execStats must print the statistics, the notification rates and
+ *        the buffer pool usage.
+ */
+ZTEST(datastore_cmd_tests, test_exec_stats_success)
+{
+  char *argv[] = {"stats"};
+  int ret;
+
+  datastoreGetStats_fake.custom_fake = datastoreGetStats_custom;
+  datastoreGetPoolStats_fake.custom_fake = datastoreGetPoolStats_custom;
+  getTypeName_fake.return_val = "binary";
+
+  ret = execStats(NULL, 1, argv);
+
+  zassert_equal(ret, 0, "execStats should succeed");
+  zassert_equal(shell_error_call_count, 0, "no error should be printed");
+  zassert_equal(datastoreGetPoolStats_fake.call_count, DATASTORE_POOL_COUNT,
+                "every pool statistics should be read");
+  zassert_true(hasShellOutput("Statistics over 5000 ms"), "the elapsed time should be printed");
+  zassert_true(hasShellOutput("Queue high water: 4/10"), "the queue high water should be printed");
+  zassert_true(hasShellOutput("Operations: 12, max service time: 250 us"),
+               "the operation count should be printed");
+  zassert_true(hasShellOutput("  < 1 us           2"), "the first bucket should be printed");
+  zassert_true(hasShellOutput("      4 - 7     us 10"), "the bucket counts should be printed");
+  zassert_true(hasShellOutput("  binary          20 (4/s)"), "the notification rate should be printed");
+  zassert_true(hasShellOutput("Notification allocation failures: 1"),
+               "the allocation failures should be printed");
+  zassert_true(hasShellOutput("Response timeouts: 3"), "the response timeouts should be printed");
+  zassert_true(hasShellOutput("  notify 3/8 used, high water 5"), "the pool usage should be printed");
+}
+
+/* Captured batch operations */
+#define MAX_CAPTURED_BATCHES 8
+static DatastoreBatchOp_t capturedOps[MAX_CAPTURED_BATCHES][CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS];
+
+/**
+ * @brief Custom fake for datastoreBatch capturing the operations and reading each value as its index.
+ */
+static int datastoreBatch_capture(DatastoreBatchOp_t *ops, size_t opCount, struct k_msgq *response)
+{
+  ARG_UNUSED(response);
+
+  for (size_t i = 0; i < opCount; i++)
+  {
+    capturedOps[datastoreBatch_fake.call_count - 1][i] = ops[i];
+
+    for (size_t j = 0; j < ops[i].valCount; j++)
+      ops[i].values[j].uintVal = ops[i].datapointId + j;
+  }
+
+  return 0;
+}
+
+/**
+ * @test execDump must read the registry in batches bounded by the operation and value counts.
+ */
+ZTEST(datastore_cmd_tests, test_exec_dump_batches)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char arg0[] = "dump";
+  char *argv[] = {arg0};
+  int result;
+
+  getDatapointRegistry_fake.return_val = testRegistry;
+  getDatapointRegistrySize_fake.return_val = testRegistrySize;
+  datastoreBatch_fake.custom_fake = datastoreBatch_capture;
+
+  result = execDump(shell, 1, argv);
+
+  zassert_equal(result, 0, "execDump should return 0 on success");
+  zassert_equal(datastoreBatch_fake.call_count, 4, "The registry should be read in 4 batches");
+
+  /* Binary 0-3 and button 0, the value count splitting the button range */
+  zassert_equal(datastoreBatch_fake.arg1_history[0], 2, "The first batch should hold 2 operations");
+  zassert_equal(capturedOps[0][0].opType, DATASTORE_BATCH_READ, "The dump should only read");
+  zassert_equal(capturedOps[0][0].datapointType, DATAPOINT_BINARY, "The first range should be binary");
+  zassert_equal(capturedOps[0][0].valCount, BINARY_DATAPOINT_COUNT, "The binary range should be whole");
+  zassert_equal(capturedOps[0][1].datapointType, DATAPOINT_BUTTON, "The second range should be button");
+  zassert_equal(capturedOps[0][1].valCount, 1, "The button range should fill the batch values");
+
+  /* Button 1 and float 0-1, the operation count closing the batch */
+  zassert_equal(capturedOps[1][0].datapointType, DATAPOINT_BUTTON, "The split range should resume");
+  zassert_equal(capturedOps[1][0].datapointId, BUTTON_SECOND_DATAPOINT, "The split range should resume");
+  zassert_equal(capturedOps[1][1].datapointType, DATAPOINT_FLOAT, "The float range should follow");
+
+  zassert_equal(printDatapointValue_fake.call_count, testRegistrySize, "Every datapoint should be printed");
+  zassert_equal(printDatapointValue_fake.arg1_history[5], &testRegistry[5], "The entries should be printed in order");
+  zassert_equal(printDatapointValue_fake.arg2_history[5].uintVal, BUTTON_SECOND_DATAPOINT,
+                "The read value should be printed");
+  zassert_equal(shell_info_call_count, 1, "A success message should be printed");
+}
+
+/**
+ * @test execDump must stop on a batch read failure.
+ */
+ZTEST(datastore_cmd_tests, test_exec_dump_batch_fails)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char arg0[] = "dump";
+  char *argv[] = {arg0};
+
+  getDatapointRegistry_fake.return_val = testRegistry;
+  getDatapointRegistrySize_fake.return_val = testRegistrySize;
+  datastoreBatch_fake.return_val = -EAGAIN;
+
+  zassert_equal(execDump(shell, 1, argv), -EAGAIN, "execDump should return the batch error");
+  zassert_equal(datastoreBatch_fake.call_count, 1, "The dump should stop at the failed batch");
+  zassert_equal(printDatapointValue_fake.call_count, 0, "No value of the failed batch should be printed");
+  zassert_equal(shell_error_call_count, 1, "An error message should be printed");
+}
+
 ZTEST_SUITE(datastore_cmd_tests, NULL, cmd_tests_setup, cmd_tests_before, NULL, NULL);
@@ -2744,5 +2744,42 @@ ZTEST(cmdUtil_tests, test_parseButtonValue_spaces_instead_of_underscores)
   zassert_equal(result, -EINVAL, "parseButtonValue must return -EINVAL for string with spaces instead of underscores");
 }
 
+/**
+ * @test findDatapointByName must find every datapoint of the registry through the sorted index.
+ */
+ZTEST(cmdUtil_tests, test_findDatapointByName_success_all)
+{
+  const DatapointEntry_t *entry;
+  const DatapointEntry_t *registry = getDatapointRegistry();
+  size_t registry_size = getDatapointRegistrySize();
+
+  for (size_t i = 0; i < registry_size; i++)
+  {
+    entry = NULL;
+    zassert_equal(findDatapointByName(registry[i].name, &entry), 0, "findDatapointByName must find %s",
+                  registry[i].name);
+    zassert_equal(entry, &registry[i], "Entry pointer must point to the correct registry entry");
+  }
+}
+
+/**
+ * @test printDatapointValue must call shell_fprintf_normal once for each datapoint type.
+ */
+ZTEST(cmdUtil_tests, test_printDatapointValue_all_types)
+{
+  const struct shell *mock_shell = (const struct shell *)0x1234;  /* Mock shell pointer */
+  const DatapointEntry_t *registry = getDatapointRegistry();
+  size_t registry_size = getDatapointRegistrySize();
+  Data_t value = {.uintVal = 1};
+
+  for (size_t i = 0; i < registry_size; i++)
+    printDatapointValue(mock_shell, &registry[i], value);
+
+  zassert_equal(shell_fprintf_normal_fake.call_count, registry_size,
+                "printDatapointValue must call shell_fprintf_normal once per datapoint");
+  zassert_equal(shell_fprintf_normal_fake.arg0_val, mock_shell,
+                "printDatapointValue must use correct shell pointer");
+}
+
 ZTEST_SUITE(cmdUtil_tests, NULL, cmdUtil_tests_setup, cmdUtil_tests_before,
             cmdUtil_tests_after, NULL);
@@ -0,0 +1,281 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-03-30
+ * @brief     Datastore Compact Storage Tests
+ *
+ *            Unit tests for the datastore compact typed storage.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_COMPACT_STORAGE 1
+#define CONFIG_ENYA_DATASTORE_DIRECT_READ 1
+#define CONFIG_ENYA_DATASTORE_DIRECT_READ_MAX_RETRIES 3
+#define CONFIG_ENYA_DATASTORE_NVM 1
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(osMemoryPoolAlloc) \
+  FAKE(osMemoryPoolFree) \
+  FAKE(k_malloc) \
+  FAKE(k_free) \
+  FAKE(mock_subscription_callback)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Redefine LOG_ERR to avoid dereferencing invalid pointers in error messages */
+#undef LOG_ERR
+#define LOG_ERR(...) do {} while (0)
+
+/* Mock osMemoryPool functions */
+FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
+FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+/* Mock kernel functions */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+FAKE_VOID_FUNC(k_free, void *);
+
+/* Include utility implementation - this will define SrvMsgPayload_t */
+#include "datastoreUtil.c"
+
+/* Mock subscription callback - SrvMsgPayload_t is now defined */
+FAKE_VALUE_FUNC(int, mock_subscription_callback, SrvMsgPayload_t *, size_t);
+
+/**
+ * The test pool.
+ */
+#define TEST_POOL                       ((osMemoryPoolId_t)0x1000)
+
+/**
+ * The test binary subscription entries.
+ */
+static DatastoreSubEntry_t binaryEntries[2];
+
+static void compact_tests_before(void *f)
+{
+  ARG_UNUSED(f);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(binaryWords, 0xFF, sizeof(binaryWords));
+  memset(buttonWords, 0xFF, sizeof(buttonWords));
+  memset(floats, 0, sizeof(floats));
+  memset(binaryEntries, 0, sizeof(binaryEntries));
+
+  binarySubs.entries = binaryEntries;
+  binarySubs.maxCount = ARRAY_SIZE(binaryEntries);
+  binarySubs.activeCount = 0;
+
+  for(size_t i = 0; i < DATAPOINT_TYPE_COUNT; ++i)
+    atomic_set(writeSequences + i, 0);
+
+  nvmDirtyTypes = 0;
+
+  datastoreUtilInitDatapoints();
+}
+
+/**
+ * @test The packed storage must hold the binaries on one bit and the buttons
+ * on two bits.
+ */
+ZTEST(datastore_compact_tests, test_packed_storage_size)
+{
+  zassert_equal(sizeof(binaryWords), sizeof(uint32_t), "Binaries should fit in one word");
+  zassert_equal(sizeof(buttonWords), sizeof(uint32_t), "Buttons should fit in one word");
+  zassert_equal(sizeof(floats), FLOAT_DATAPOINT_COUNT * sizeof(Data_t), "Floats should not hold any flag");
+  zassert_equal(sizeof(binaryFlags), BINARY_DATAPOINT_COUNT, "Binary flags should take one byte each");
+}
+
+/**
+ * @test The packed values must not overlap their neighbours, across the word
+ * boundaries.
+ */
+ZTEST(datastore_compact_tests, test_packed_value_neighbours)
+{
+  uint32_t words[2] = {0};
+  uint32_t pairWords[2] = {0};
+
+  setPackedValue(words, 1, 31, 1);
+  setPackedValue(words, 1, 32, 1);
+  setPackedValue(pairWords, 2, 15, 3);
+  setPackedValue(pairWords, 2, 16, 2);
+
+  zassert_equal(words[0], BIT(31), "Bit 31 should end the first word");
+  zassert_equal(words[1], BIT(0), "Bit 32 should start the second word");
+  zassert_equal(getPackedValue(pairWords, 2, 15), 3, "Button 15 should end the first word");
+  zassert_equal(getPackedValue(pairWords, 2, 16), 2, "Button 16 should start the second word");
+
+  setPackedValue(pairWords, 2, 15, 0);
+
+  zassert_equal(getPackedValue(pairWords, 2, 16), 2, "Clearing a value should keep its neighbour");
+}
+
+/**
+ * @test The datastoreUtilInitDatapoints function must initialize the packed
+ * datapoints to their defaults.
+ */
+ZTEST(datastore_compact_tests, test_init_datapoints_defaults)
+{
+  Data_t values[BINARY_DATAPOINT_COUNT];
+
+  zassert_equal(datastoreUtilRead(DATAPOINT_BINARY, 0, BINARY_DATAPOINT_COUNT, values), 0, "Read should succeed");
+  zassert_equal(values[0].uintVal, 0, "First binary should default to false");
+  zassert_equal(values[1].uintVal, 1, "Second binary should default to true");
+  zassert_equal(values[2].uintVal, 0, "Third binary should default to false");
+
+  zassert_equal(datastoreUtilRead(DATAPOINT_BUTTON, 0, BUTTON_DATAPOINT_COUNT, values), 0, "Read should succeed");
+  zassert_equal(values[0].uintVal, BUTTON_UNPRESSED, "First button should default to unpressed");
+  zassert_equal(values[1].uintVal, BUTTON_UNPRESSED, "Second button should default to unpressed");
+}
+
+/**
+ * @test The datastoreUtilWrite function must store a binary on its own bit.
+ */
+ZTEST(datastore_compact_tests, test_write_binary)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+  Data_t readValues[BINARY_DATAPOINT_COUNT];
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 2, values, 1, TEST_POOL), 0, "Write should succeed");
+  zassert_equal(datastoreUtilRead(DATAPOINT_BINARY, 0, BINARY_DATAPOINT_COUNT, readValues), 0,
+                "Read should succeed");
+
+  zassert_equal(readValues[0].uintVal, 0, "First binary should not change");
+  zassert_equal(readValues[1].uintVal, 1, "Second binary should not change");
+  zassert_equal(readValues[2].uintVal, 1, "Third binary should be set");
+}
+
+/**
+ * @test The datastoreUtilWrite function must store a non zero binary as true
+ * and not see it as a change when already set.
+ */
+ZTEST(datastore_compact_tests, test_write_binary_normalized)
+{
+  Data_t values[1] = {{.uintVal = 5}};
+  Data_t readValue;
+
+  binarySubs.activeCount = 1;
+  binaryEntries[0].datapointId = 1;
+  binaryEntries[0].valCount = 1;
+  binaryEntries[0].callback = mock_subscription_callback;
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 1, values, 1, TEST_POOL), 0, "Write should succeed");
+  zassert_equal(datastoreUtilRead(DATAPOINT_BINARY, 1, 1, &readValue), 0, "Read should succeed");
+
+  zassert_equal(readValue.uintVal, 1, "Binary should be stored as true");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0, "An unchanged binary should not notify");
+}
+
+/**
+ * @test The datastoreUtilWrite function must notify the stored binary value.
+ */
+ZTEST(datastore_compact_tests, test_write_binary_notifies)
+{
+  static uint8_t payloadBuffer[64];
+  SrvMsgPayload_t *payload = (SrvMsgPayload_t *)payloadBuffer;
+  Data_t values[1] = {{.uintVal = 0}};
+
+  binarySubs.activeCount = 1;
+  binaryEntries[0].datapointId = 0;
+  binaryEntries[0].valCount = 2;
+  binaryEntries[0].callback = mock_subscription_callback;
+  osMemoryPoolAlloc_fake.return_val = payload;
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 1, values, 1, TEST_POOL), 0, "Write should succeed");
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "The subscription should be notified");
+  zassert_equal(payload->data[0].uintVal, 0, "First binary should be notified");
+  zassert_equal(payload->data[1].uintVal, 0, "Second binary should be notified cleared");
+}
+
+/**
+ * @test The datastoreUtilWrite function must store a button on its own two
+ * bits.
+ */
+ZTEST(datastore_compact_tests, test_write_button)
+{
+  Data_t values[2] = {{.uintVal = BUTTON_LONG_PRESSED}, {.uintVal = BUTTON_SHORT_PRESSED}};
+  Data_t readValues[BUTTON_DATAPOINT_COUNT];
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BUTTON, 0, values, 2, TEST_POOL), 0, "Write should succeed");
+  zassert_equal(datastoreUtilRead(DATAPOINT_BUTTON, 0, BUTTON_DATAPOINT_COUNT, readValues), 0,
+                "Read should succeed");
+
+  zassert_equal(readValues[0].uintVal, BUTTON_LONG_PRESSED, "First button should be long pressed");
+  zassert_equal(readValues[1].uintVal, BUTTON_SHORT_PRESSED, "Second button should be short pressed");
+}
+
+/**
+ * @test The datastoreUtilWrite function must store the word types unchanged.
+ */
+ZTEST(datastore_compact_tests, test_write_float)
+{
+  Data_t values[1] = {{.floatVal = 12.5f}};
+  Data_t readValue;
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_FLOAT, 1, values, 1, TEST_POOL), 0, "Write should succeed");
+  zassert_equal(datastoreUtilRead(DATAPOINT_FLOAT, 1, 1, &readValue), 0, "Read should succeed");
+
+  zassert_equal(readValue.floatVal, 12.5f, "Float should be stored unchanged");
+}
+
+/**
+ * @test The datastoreUtilDirectRead function must read the packed datapoints.
+ */
+ZTEST(datastore_compact_tests, test_direct_read_packed)
+{
+  Data_t values[BINARY_DATAPOINT_COUNT];
+
+  zassert_equal(datastoreUtilDirectRead(DATAPOINT_BINARY, 0, BINARY_DATAPOINT_COUNT, values), 0,
+                "Direct read should succeed");
+
+  zassert_equal(values[1].uintVal, 1, "Second binary should be read");
+  zassert_equal(values[2].uintVal, 0, "Third binary should be read");
+}
+
+/**
+ * @test The NVM persistence must use the const flag table of the packed
+ * datapoints.
+ */
+ZTEST(datastore_compact_tests, test_nvm_packed_datapoint)
+{
+  Data_t values[1] = {{.uintVal = 0}};
+  Data_t snapshot[1];
+  Data_t readValue;
+
+  zassert_equal(datastoreUtilGetNvmCount(DATAPOINT_BINARY), 1, "One binary should be persisted");
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 1, values, 1, TEST_POOL), 0, "Write should succeed");
+  zassert_equal(datastoreUtilGetNvmDirtyTypes(), BIT(DATAPOINT_BINARY), "Binary type should be dirty");
+
+  zassert_equal(datastoreUtilSnapshotNvm(DATAPOINT_BINARY, snapshot), 1, "One value should be snapshot");
+  zassert_equal(snapshot[0].uintVal, 0, "The persisted binary should be snapshot");
+
+  values[0].uintVal = 1;
+  zassert_equal(datastoreUtilRestoreNvm(DATAPOINT_BINARY, values, 1), 0, "Restore should succeed");
+  zassert_equal(datastoreUtilRead(DATAPOINT_BINARY, 1, 1, &readValue), 0, "Read should succeed");
+  zassert_equal(readValue.uintVal, 1, "The persisted binary should be restored");
+}
+
+ZTEST_SUITE(datastore_compact_tests, NULL, NULL, compact_tests_before, NULL, NULL);
@@ -0,0 +1,83 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      datastoreMeta.h
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Mock Datastore Metadata for Testing
+ *
+ *            Mock datapoint definitions for datastore computed datapoint tests.
+ */
+
+#ifndef DATASTORE_META_H
+#define DATASTORE_META_H
+
+#include "datastoreTypes.h"
+
+/**
+ * @brief   Binary datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_BINARY_DATAPOINTS \
+  X(BINARY_FIRST_DATAPOINT, DATAPOINT_NO_FLAG_MASK, false) \
+  X(BINARY_SECOND_DATAPOINT, DATAPOINT_FLAG_NVM_MASK, true) \
+  X(BINARY_THIRD_DATAPOINT, DATAPOINT_NO_FLAG_MASK, false)
+
+/**
+ * @brief   Button datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_BUTTON_DATAPOINTS \
+  X(BUTTON_FIRST_DATAPOINT, DATAPOINT_NO_FLAG_MASK, BUTTON_UNPRESSED) \
+  X(BUTTON_SECOND_DATAPOINT, DATAPOINT_NO_FLAG_MASK, BUTTON_UNPRESSED)
+
+/**
+ * @brief   Float datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_FLOAT_DATAPOINTS \
+  X(FLOAT_FIRST_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 2.0f) \
+  X(FLOAT_SECOND_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 3.0f) \
+  X(FLOAT_THIRD_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0.0f)
+
+/**
+ * @brief   Signed integer datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_INT_DATAPOINTS \
+  X(INT_FIRST_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0) \
+  X(INT_SECOND_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0)
+
+/**
+ * @brief   Multi-state datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_MULTI_STATE_DATAPOINTS \
+  X(MULTI_STATE_FIRST_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0) \
+  X(MULTI_STATE_SECOND_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0)
+
+/**
+ * @brief   Unsigned integer datapoint information X-macro.
+ * @note    X(datapoint ID, option flag, default value)
+ */
+#define DATASTORE_UINT_DATAPOINTS \
+  X(UINT_FIRST_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0) \
+  X(UINT_SECOND_DATAPOINT, DATAPOINT_FLAG_NVM_MASK, 0)
+
+/**
+ * @brief   The test evaluators.
+ */
+Data_t testOrEvaluator(const Data_t inputs[], size_t inputCount);
+Data_t testProductEvaluator(const Data_t inputs[], size_t inputCount);
+Data_t testCountEvaluator(const Data_t inputs[], size_t inputCount);
+
+/**
+ * @brief   Computed datapoint information X-macro.
+ * @note    X(type, datapoint ID, evaluator, input type, first input ID, input count)
+ */
+#define DATASTORE_COMPUTED_DATAPOINTS \
+  X(DATAPOINT_BINARY, BINARY_THIRD_DATAPOINT, testOrEvaluator, DATAPOINT_BINARY, BINARY_FIRST_DATAPOINT, 2) \
+  X(DATAPOINT_FLOAT, FLOAT_THIRD_DATAPOINT, testProductEvaluator, DATAPOINT_FLOAT, FLOAT_FIRST_DATAPOINT, 2) \
+  X(DATAPOINT_UINT, UINT_FIRST_DATAPOINT, testCountEvaluator, DATAPOINT_BINARY, BINARY_FIRST_DATAPOINT, 3)
+
+#endif /* DATASTORE_META_H */
@@ -0,0 +1,259 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Computed Datapoint Tests
+ *
+ *            Unit tests for the datastore computed datapoints.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_COMPUTED 1
+#define CONFIG_ENYA_DATASTORE_COMPUTED_MAX_INPUTS 4
+#define CONFIG_ENYA_DATASTORE_BATCH 1
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS 4
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES 8
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(osMemoryPoolAlloc) \
+  FAKE(osMemoryPoolFree) \
+  FAKE(k_malloc) \
+  FAKE(k_free) \
+  FAKE(mock_subscription_callback)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Mock osMemoryPool functions */
+FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
+FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+/* Mock kernel functions */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+FAKE_VOID_FUNC(k_free, void *);
+
+/* Include utility implementation - this will define SrvMsgPayload_t */
+#include "datastoreUtil.c"
+
+/* Mock subscription callback - SrvMsgPayload_t is now defined */
+FAKE_VALUE_FUNC(int, mock_subscription_callback, SrvMsgPayload_t *, size_t);
+
+/**
+ * The test pool.
+ */
+#define TEST_POOL                       ((osMemoryPoolId_t)0x1000)
+
+/**
+ * The test evaluator call counts.
+ */
+static size_t orCallCount;
+static size_t productCallCount;
+static size_t countCallCount;
+
+/**
+ * The test subscription entries.
+ */
+static DatastoreSubEntry_t floatEntries[2];
+
+/**
+ * The test notification payload buffer.
+ */
+static uint8_t payloadBuffer[256];
+
+Data_t testOrEvaluator(const Data_t inputs[], size_t inputCount)
+{
+  Data_t value = {.uintVal = 0};
+
+  ++orCallCount;
+
+  for(size_t i = 0; i < inputCount; ++i)
+    value.uintVal |= inputs[i].uintVal;
+
+  return value;
+}
+
+Data_t testProductEvaluator(const Data_t inputs[], size_t inputCount)
+{
+  Data_t value = {.floatVal = 1.0f};
+
+  ++productCallCount;
+
+  for(size_t i = 0; i < inputCount; ++i)
+    value.floatVal *= inputs[i].floatVal;
+
+  return value;
+}
+
+Data_t testCountEvaluator(const Data_t inputs[], size_t inputCount)
+{
+  Data_t value = {.uintVal = 0};
+
+  ++countCallCount;
+
+  for(size_t i = 0; i < inputCount; ++i)
+    value.uintVal += inputs[i].uintVal != 0;
+
+  return value;
+}
+
+/**
+ * Pack a batch write operation in a batch buffer.
+ */
+static void packBatchWrite(Data_t buffer[], size_t *cursor, DatapointType_t type, uint32_t datapointId,
+                           size_t valCount, Data_t values[])
+{
+  DatastoreBatchOpHeader_t header = {
+    .opType = DATASTORE_BATCH_WRITE,
+    .datapointType = type,
+    .valCount = valCount,
+    .datapointId = datapointId,
+  };
+
+  memcpy(buffer + *cursor, &header, sizeof(header));
+  *cursor += DATASTORE_BATCH_OP_HEADER_LEN;
+  memcpy(buffer + *cursor, values, valCount * sizeof(Data_t));
+  *cursor += valCount;
+}
+
+/**
+ * Test before function.
+ */
+static void computed_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(floatEntries, 0, sizeof(floatEntries));
+  floatSubs = (struct DatastoreSubs){.entries = floatEntries, .maxCount = 2, .activeCount = 0};
+
+  binaries[BINARY_FIRST_DATAPOINT].value.uintVal = 0;
+  binaries[BINARY_SECOND_DATAPOINT].value.uintVal = 1;
+  floats[FLOAT_FIRST_DATAPOINT].value.floatVal = 2.0f;
+  floats[FLOAT_SECOND_DATAPOINT].value.floatVal = 3.0f;
+
+  zassert_equal(datastoreUtilInitComputed(), 0, "The computed datapoints should be valid");
+
+  orCallCount = 0;
+  productCallCount = 0;
+  countCallCount = 0;
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+}
+
+/**
+ * @test datastoreUtilInitComputed must evaluate every computed datapoint from the default values.
+ */
+ZTEST(datastore_computed_tests, test_init_evaluate)
+{
+  zassert_equal(binaries[BINARY_THIRD_DATAPOINT].value.uintVal, 1, "The OR should be evaluated");
+  zassert_equal(floats[FLOAT_THIRD_DATAPOINT].value.floatVal, 6.0f, "The product should be evaluated");
+  zassert_equal(uints[UINT_FIRST_DATAPOINT].value.uintVal, 2, "The chained count should see the OR");
+  zassert_equal(computedDirty, 0, "No computed datapoint should stay dirty");
+}
+
+/**
+ * @test datastoreUtilWrite must evaluate the computed datapoints of a changed input.
+ */
+ZTEST(datastore_computed_tests, test_write_evaluate)
+{
+  Data_t value = {.floatVal = 4.0f};
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, &value, 1, TEST_POOL), 0,
+                "The write should succeed");
+
+  zassert_equal(floats[FLOAT_THIRD_DATAPOINT].value.floatVal, 8.0f, "The product should follow its input");
+  zassert_equal(productCallCount, 1, "The product should be evaluated once");
+  zassert_equal(orCallCount, 0, "The unrelated computed datapoints should not be evaluated");
+  zassert_equal(countCallCount, 0, "The unrelated computed datapoints should not be evaluated");
+}
+
+/**
+ * @test datastoreUtilWrite must not evaluate the computed datapoints of an unchanged input.
+ */
+ZTEST(datastore_computed_tests, test_write_unchanged)
+{
+  Data_t value = {.floatVal = 2.0f};
+
+  datastoreUtilWrite(DATAPOINT_FLOAT, FLOAT_FIRST_DATAPOINT, &value, 1, TEST_POOL);
+
+  zassert_equal(productCallCount, 0, "An unchanged input should not evaluate");
+}
+
+/**
+ * @test datastoreUtilWrite must evaluate the chained computed datapoints in declaration order.
+ */
+ZTEST(datastore_computed_tests, test_write_chain)
+{
+  Data_t values[2] = {{.uintVal = 0}, {.uintVal = 0}};
+
+  datastoreUtilWrite(DATAPOINT_BINARY, BINARY_FIRST_DATAPOINT, values, 2, TEST_POOL);
+
+  zassert_equal(binaries[BINARY_THIRD_DATAPOINT].value.uintVal, 0, "The OR should follow its inputs");
+  zassert_equal(uints[UINT_FIRST_DATAPOINT].value.uintVal, 0, "The count should follow the OR");
+  zassert_equal(orCallCount, 1, "The OR should be evaluated once");
+  zassert_equal(countCallCount, 1, "The count should be evaluated once");
+}
+
+/**
+ * @test datastoreUtilApplyBatch must evaluate a computed datapoint once for the whole batch.
+ */
+ZTEST(datastore_computed_tests, test_batch_evaluateOnce)
+{
+  Data_t buffer[16];
+  size_t cursor = 0;
+  Data_t first = {.floatVal = 5.0f};
+  Data_t second = {.floatVal = 7.0f};
+
+  packBatchWrite(buffer, &cursor, DATAPOINT_FLOAT, FLOAT_FIRST_DATAPOINT, 1, &first);
+  packBatchWrite(buffer, &cursor, DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, 1, &second);
+
+  zassert_equal(datastoreUtilApplyBatch(buffer, 2, TEST_POOL), 0, "The batch should succeed");
+
+  zassert_equal(floats[FLOAT_THIRD_DATAPOINT].value.floatVal, 35.0f, "The product should follow the batch");
+  zassert_equal(productCallCount, 1, "The product should be evaluated once for the batch");
+}
+
+/**
+ * @test datastoreUtilWrite must notify the subscribers of a changed computed datapoint.
+ */
+ZTEST(datastore_computed_tests, test_write_notify)
+{
+  Data_t value = {.floatVal = 4.0f};
+
+  floatEntries[0] = (DatastoreSubEntry_t){
+    .datapointId = FLOAT_THIRD_DATAPOINT,
+    .valCount = 1,
+    .callback = mock_subscription_callback,
+  };
+  floatSubs.activeCount = 1;
+
+  datastoreUtilWrite(DATAPOINT_FLOAT, FLOAT_FIRST_DATAPOINT, &value, 1, TEST_POOL);
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "The computed subscriber should be notified once");
+  zassert_equal(((SrvMsgPayload_t *)payloadBuffer)->data[0].floatVal, 12.0f,
+                "The computed value should be notified");
+}
+
+ZTEST_SUITE(datastore_computed_tests, NULL, NULL, computed_tests_before, NULL, NULL);
@@ -0,0 +1,341 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-03-16
+ * @brief     Datastore Delta Notification Tests
+ *
+ *            Unit tests for the datastore delta subscriber notifications.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_DELTA_NOTIFY 1
+#define CONFIG_ENYA_DATASTORE_BATCH 1
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS 4
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES 8
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(osMemoryPoolAlloc) \
+  FAKE(osMemoryPoolFree) \
+  FAKE(k_malloc) \
+  FAKE(k_free) \
+  FAKE(mock_subscription_callback)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Redefine LOG_ERR to avoid dereferencing invalid pointers in error messages */
+#undef LOG_ERR
+#define LOG_ERR(...) do {} while (0)
+
+/* Mock osMemoryPool functions */
+FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
+FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+/* Mock kernel functions */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+FAKE_VOID_FUNC(k_free, void *);
+
+/* Include utility implementation - this will define SrvMsgPayload_t */
+#include "datastoreUtil.c"
+
+/* Mock subscription callback - SrvMsgPayload_t is now defined */
+FAKE_VALUE_FUNC(int, mock_subscription_callback, SrvMsgPayload_t *, size_t);
+
+/**
+ * The test pool.
+ */
+#define TEST_POOL                       ((osMemoryPoolId_t)0x1000)
+
+/**
+ * The test subscription entries.
+ */
+static DatastoreSubEntry_t binaryEntries[4];
+static DatastoreSubEntry_t uintEntries[4];
+
+/**
+ * The test notification payload buffer.
+ */
+static uint8_t payloadBuffer[256];
+
+/**
+ * The test notification payload.
+ */
+static SrvMsgPayload_t *payload = (SrvMsgPayload_t *)payloadBuffer;
+
+/**
+ * Add a subscription entry directly to the subscription list.
+ */
+static DatastoreSubEntry_t *addTestSub(struct DatastoreSubs *subs, uint32_t datapointId, size_t valCount,
+                                       bool isDelta)
+{
+  DatastoreSubEntry_t *sub = subs->entries + subs->activeCount;
+
+  memset(sub, 0, sizeof(DatastoreSubEntry_t));
+  sub->datapointId = datapointId;
+  sub->valCount = valCount;
+  sub->isDelta = isDelta;
+  sub->callback = mock_subscription_callback;
+  ++subs->activeCount;
+
+  return sub;
+}
+
+/**
+ * Get the delta header of the test notification payload.
+ */
+static DatastoreDeltaHeader_t getPayloadHeader(void)
+{
+  DatastoreDeltaHeader_t header;
+
+  memcpy(&header, payload->data, sizeof(header));
+
+  return header;
+}
+
+/**
+ * Pack a batch write operation in a batch buffer.
+ */
+static void packBatchWrite(Data_t buffer[], size_t *cursor, DatapointType_t type, uint32_t datapointId,
+                           size_t valCount, Data_t values[])
+{
+  DatastoreBatchOpHeader_t header = {
+    .opType = DATASTORE_BATCH_WRITE,
+    .datapointType = type,
+    .valCount = valCount,
+    .datapointId = datapointId,
+  };
+
+  memcpy(buffer + *cursor, &header, sizeof(header));
+  *cursor += DATASTORE_BATCH_OP_HEADER_LEN;
+  memcpy(buffer + *cursor, values, valCount * sizeof(Data_t));
+  *cursor += valCount;
+}
+
+/**
+ * Test setup function.
+ */
+static void *delta_tests_setup(void)
+{
+  return NULL;
+}
+
+/**
+ * Test before function.
+ */
+static void delta_tests_before(void *fixture)
+{
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(binaryEntries, 0, sizeof(binaryEntries));
+  memset(uintEntries, 0, sizeof(uintEntries));
+  memset(payloadBuffer, 0, sizeof(payloadBuffer));
+
+  binarySubs = (struct DatastoreSubs){.entries = binaryEntries, .maxCount = 4, .activeCount = 0};
+  uintSubs = (struct DatastoreSubs){.entries = uintEntries, .maxCount = 4, .activeCount = 0};
+
+  for(size_t i = 0; i < BINARY_DATAPOINT_COUNT; ++i)
+    binaries[i].value.uintVal = 0;
+
+  for(size_t i = 0; i < UINT_DATAPOINT_COUNT; ++i)
+    uints[i].value.uintVal = 0;
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+}
+
+/**
+ * @test The datastoreUtilWrite function must send a delta subscription only
+ * the changed values, after a header with the changed range.
+ */
+ZTEST(datastore_delta_tests, test_write_delta_payload)
+{
+  DatastoreDeltaHeader_t header;
+  Data_t values[1] = {{.uintVal = 1}};
+
+  addTestSub(&binarySubs, 0, 3, true);
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 1, values, 1, TEST_POOL), 0, "Should return 0 on success");
+
+  header = getPayloadHeader();
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "Callback should be called once");
+  zassert_equal(mock_subscription_callback_fake.arg1_val, 1, "Value count should be the changed count");
+  zassert_equal(header.datapointId, 1, "Header should carry the first changed datapoint");
+  zassert_equal(header.valCount, 1, "Header should carry the changed count");
+  zassert_equal(payload->dataLen, (DATASTORE_DELTA_HEADER_LEN + 1) * sizeof(Data_t),
+                "Payload should only hold the header and the changed value");
+  zassert_equal(payload->data[DATASTORE_DELTA_HEADER_LEN].uintVal, 1, "Payload should hold the changed value");
+}
+
+/**
+ * @test The datastoreUtilWrite function must span a delta from the first to
+ * the last changed value of the write.
+ */
+ZTEST(datastore_delta_tests, test_write_delta_changed_span)
+{
+  DatastoreDeltaHeader_t header;
+  Data_t values[3] = {{.uintVal = 0}, {.uintVal = 1}, {.uintVal = 1}};
+
+  addTestSub(&binarySubs, 0, 3, true);
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 3, TEST_POOL), 0, "Should return 0 on success");
+
+  header = getPayloadHeader();
+  zassert_equal(header.datapointId, 1, "Unchanged leading value should not be sent");
+  zassert_equal(header.valCount, 2, "Changed span should cover the last two values");
+}
+
+/**
+ * @test The datastoreUtilWrite function must clamp a delta to the
+ * subscription range.
+ */
+ZTEST(datastore_delta_tests, test_write_delta_clamped_to_sub)
+{
+  DatastoreDeltaHeader_t header;
+  Data_t values[3] = {{.uintVal = 1}, {.uintVal = 1}, {.uintVal = 1}};
+
+  addTestSub(&binarySubs, 1, 1, true);
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 3, TEST_POOL), 0, "Should return 0 on success");
+
+  header = getPayloadHeader();
+  zassert_equal(header.datapointId, 1, "Delta should start at the subscription");
+  zassert_equal(header.valCount, 1, "Delta should stop at the subscription end");
+  zassert_equal(mock_subscription_callback_fake.arg1_val, 1, "Value count should be the clamped count");
+}
+
+/**
+ * @test The datastoreUtilWrite function must keep sending the whole range to
+ * the subscriptions not in delta mode.
+ */
+ZTEST(datastore_delta_tests, test_write_full_payload_without_delta)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+
+  addTestSub(&binarySubs, 0, 3, false);
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 2, values, 1, TEST_POOL), 0, "Should return 0 on success");
+
+  zassert_equal(mock_subscription_callback_fake.arg1_val, 3, "Value count should be the subscription count");
+  zassert_equal(payload->dataLen, 3 * sizeof(Data_t), "Payload should hold the whole range");
+  zassert_equal(payload->data[2].uintVal, 1, "Payload should hold the changed value");
+}
+
+/**
+ * @test The add subscription functions must send a delta subscription its
+ * whole range with a delta header.
+ */
+ZTEST(datastore_delta_tests, test_add_delta_sub_full_range)
+{
+  DatastoreDeltaHeader_t header;
+  DatastoreSubEntry_t sub = {
+    .datapointId = 0,
+    .valCount = 2,
+    .isDelta = true,
+    .callback = mock_subscription_callback,
+  };
+
+  uints[1].value.uintVal = 42;
+
+  zassert_equal(datastoreUtilAddUintSub(&sub, TEST_POOL), 0, "Should return 0 on success");
+
+  header = getPayloadHeader();
+  zassert_equal(header.datapointId, 0, "Header should start at the subscription");
+  zassert_equal(header.valCount, 2, "Header should cover the whole subscription");
+  zassert_equal(payload->data[DATASTORE_DELTA_HEADER_LEN + 1].uintVal, 42, "Payload should hold the values");
+}
+
+/**
+ * @test The set pause state functions must send an unpaused delta
+ * subscription its whole range with a delta header.
+ */
+ZTEST(datastore_delta_tests, test_unpause_delta_sub_full_range)
+{
+  DatastoreDeltaHeader_t header;
+  DatastoreSubEntry_t *sub;
+
+  sub = addTestSub(&binarySubs, 1, 2, true);
+  sub->isPaused = true;
+
+  zassert_equal(datastoreUtilSetBinarySubPauseState(mock_subscription_callback, false, TEST_POOL), 0,
+                "Should return 0 on success");
+
+  header = getPayloadHeader();
+  zassert_equal(header.datapointId, 1, "Header should start at the subscription");
+  zassert_equal(header.valCount, 2, "Header should cover the whole subscription");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must send a delta subscription
+ * once the span covering all its changed operations.
+ */
+ZTEST(datastore_delta_tests, test_apply_batch_delta_span)
+{
+  size_t cursor = 0;
+  Data_t buffer[16];
+  Data_t first[1] = {{.uintVal = 1}};
+  Data_t second[1] = {{.uintVal = 1}};
+  DatastoreDeltaHeader_t header;
+
+  addTestSub(&binarySubs, 0, 3, true);
+
+  packBatchWrite(buffer, &cursor, DATAPOINT_BINARY, 2, 1, second);
+  packBatchWrite(buffer, &cursor, DATAPOINT_BINARY, 0, 1, first);
+
+  zassert_equal(datastoreUtilApplyBatch(buffer, 2, TEST_POOL), 0, "Should return 0 on success");
+
+  header = getPayloadHeader();
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "Callback should be called once for the batch");
+  zassert_equal(header.datapointId, 0, "Delta should start at the first changed operation");
+  zassert_equal(header.valCount, 3, "Delta should end at the last changed operation");
+}
+
+/**
+ * @test The delta notification must return -ENOSPC when the buffer
+ * allocation fails.
+ */
+ZTEST(datastore_delta_tests, test_write_delta_alloc_failure)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+
+  addTestSub(&binarySubs, 0, 1, true);
+  osMemoryPoolAlloc_fake.return_val = NULL;
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 1, TEST_POOL), -ENOSPC,
+                "Should return -ENOSPC");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0, "Callback should not be called");
+}
+
+/**
+ * @test The datastoreUtilCalculateBufferSize function must leave room for
+ * the delta header.
+ */
+ZTEST(datastore_delta_tests, test_buffer_size_includes_delta_header)
+{
+  size_t counts[DATAPOINT_TYPE_COUNT] = {3, 1, 1, 1, 1, 1};
+
+  zassert_equal(datastoreUtilCalculateBufferSize(counts),
+                sizeof(SrvMsgPayload_t) + (3 + DATASTORE_DELTA_HEADER_LEN) * sizeof(Data_t),
+                "Buffer size should include the delta header");
+}
+
+ZTEST_SUITE(datastore_delta_tests, NULL, delta_tests_setup, delta_tests_before, NULL, NULL);
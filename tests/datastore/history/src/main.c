@@ -0,0 +1,211 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore History Tests
+ *
+ *            Unit tests for the datastore history.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_HISTORY 1
+#define CONFIG_ENYA_DATASTORE_HISTORY_DEFAULT_DEPTH 8
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Include history implementation */
+#include "datastoreHistory.c"
+
+/**
+ * @brief Record an integer value.
+ */
+static void recordInt(int32_t value, uint32_t timestampMs)
+{
+  datastoreHistoryRecord(DATAPOINT_INT, INT_FIRST_DATAPOINT, (Data_t){.intVal = value}, timestampMs);
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void history_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  datastoreHistoryInit();
+}
+
+/**
+ * @test datastoreHistoryInit must carve a ring of the flagged depth for each datapoint with history.
+ */
+ZTEST(datastore_history_tests, test_init_depths)
+{
+  zassert_equal(ARRAY_SIZE(histories), 4, "Only the flagged datapoints should have a history");
+  zassert_equal(ARRAY_SIZE(samplePool), CONFIG_ENYA_DATASTORE_HISTORY_DEFAULT_DEPTH + 4 + 4 + 3,
+                "The sample pool should hold every depth");
+  zassert_equal(getHistory(DATAPOINT_BINARY, BINARY_SECOND_DATAPOINT)->depth,
+                CONFIG_ENYA_DATASTORE_HISTORY_DEFAULT_DEPTH, "The history mask alone should use the default depth");
+  zassert_equal(getHistory(DATAPOINT_UINT, UINT_SECOND_DATAPOINT)->depth, 3, "The flagged depth should be used");
+  zassert_is_null(getHistory(DATAPOINT_FLOAT, FLOAT_FIRST_DATAPOINT), "An unflagged datapoint has no history");
+  zassert_is_null(getHistory(DATAPOINT_TYPE_COUNT, 0), "An invalid type has no history");
+  zassert_is_null(getHistory(DATAPOINT_INT, INT_DATAPOINT_COUNT), "An invalid datapoint has no history");
+}
+
+/**
+ * @test datastoreHistoryRecord must ignore the datapoints without history.
+ */
+ZTEST(datastore_history_tests, test_record_noHistory)
+{
+  DatastoreHistoryStats_t stats;
+  DatastoreHistorySample_t sample;
+
+  datastoreHistoryRecord(DATAPOINT_FLOAT, FLOAT_FIRST_DATAPOINT, (Data_t){.floatVal = 1.0f}, 10);
+
+  zassert_equal(datastoreHistoryGetStats(DATAPOINT_FLOAT, FLOAT_FIRST_DATAPOINT, &stats), -ENOENT,
+                "A datapoint without history should return -ENOENT");
+  zassert_equal(datastoreHistoryRead(DATAPOINT_FLOAT, FLOAT_FIRST_DATAPOINT, 0, UINT32_MAX, &sample, 1), -ENOENT,
+                "A datapoint without history should return -ENOENT");
+  zassert_equal(datastoreHistoryGetStats(DATAPOINT_INT, INT_FIRST_DATAPOINT, NULL), -EINVAL,
+                "A missing stats buffer should return -EINVAL");
+  zassert_equal(datastoreHistoryRead(DATAPOINT_INT, INT_FIRST_DATAPOINT, 0, UINT32_MAX, NULL, 1), -EINVAL,
+                "A missing sample buffer should return -EINVAL");
+  zassert_equal(datastoreHistoryRead(DATAPOINT_INT, INT_FIRST_DATAPOINT, 0, UINT32_MAX, &sample, 0), -EINVAL,
+                "A null sample count should return -EINVAL");
+}
+
+/**
+ * @test datastoreHistoryGetStats must return -ENODATA for an empty history.
+ */
+ZTEST(datastore_history_tests, test_stats_empty)
+{
+  DatastoreHistoryStats_t stats;
+
+  zassert_equal(datastoreHistoryGetStats(DATAPOINT_INT, INT_FIRST_DATAPOINT, &stats), -ENODATA,
+                "An empty history should return -ENODATA");
+}
+
+/**
+ * @test datastoreHistoryGetStats must follow the minimum, maximum and sum through the ring wrap.
+ */
+ZTEST(datastore_history_tests, test_stats_wrap)
+{
+  static const int32_t values[] = {5, -3, 7, 2, 1, 0, 4, 6, -8};
+  static const int32_t expMins[] = {5, -3, -3, -3, -3, 0, 0, 0, -8};
+  static const int32_t expMaxs[] = {5, 5, 7, 7, 7, 7, 4, 6, 6};
+  int64_t expSum;
+  DatastoreHistoryStats_t stats;
+
+  for(size_t i = 0; i < ARRAY_SIZE(values); ++i)
+  {
+    recordInt(values[i], i * 10);
+
+    expSum = 0;
+    for(size_t j = i >= 3 ? i - 3 : 0; j <= i; ++j)
+      expSum += values[j];
+
+    zassert_equal(datastoreHistoryGetStats(DATAPOINT_INT, INT_FIRST_DATAPOINT, &stats), 0,
+                  "The stats should be available");
+    zassert_equal(stats.count, MIN(i + 1, 4), "The count should be bounded by the depth");
+    zassert_equal(stats.min.intVal, expMins[i], "Wrong minimum after record %d", i);
+    zassert_equal(stats.max.intVal, expMaxs[i], "Wrong maximum after record %d", i);
+    zassert_equal((int64_t)stats.sum, expSum, "Wrong sum after record %d", i);
+  }
+}
+
+/**
+ * @test datastoreHistoryGetStats must compare the values following the datapoint type.
+ */
+ZTEST(datastore_history_tests, test_stats_types)
+{
+  DatastoreHistoryStats_t stats;
+
+  datastoreHistoryRecord(DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, (Data_t){.floatVal = -1.5f}, 0);
+  datastoreHistoryRecord(DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, (Data_t){.floatVal = 2.25f}, 10);
+  datastoreHistoryRecord(DATAPOINT_UINT, UINT_SECOND_DATAPOINT, (Data_t){.uintVal = UINT32_MAX}, 0);
+  datastoreHistoryRecord(DATAPOINT_UINT, UINT_SECOND_DATAPOINT, (Data_t){.uintVal = 1}, 10);
+
+  datastoreHistoryGetStats(DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, &stats);
+  zassert_equal(stats.min.floatVal, -1.5f, "The floats should compare as floats");
+  zassert_equal(stats.max.floatVal, 2.25f, "The floats should compare as floats");
+  zassert_equal(stats.sum, 0.75, "The float sum should be kept");
+
+  datastoreHistoryGetStats(DATAPOINT_UINT, UINT_SECOND_DATAPOINT, &stats);
+  zassert_equal(stats.min.uintVal, 1, "The unsigned integers should compare as unsigned");
+  zassert_equal(stats.max.uintVal, UINT32_MAX, "The unsigned integers should compare as unsigned");
+  zassert_equal(stats.sum, (double)UINT32_MAX + 1, "The unsigned sum should not overflow");
+}
+
+/**
+ * @test datastoreHistoryGetStats must keep the float sum of a ring wrapping many times.
+ */
+ZTEST(datastore_history_tests, test_stats_floatWrap)
+{
+  DatastoreHistoryStats_t stats;
+
+  for(uint32_t i = 0; i < 1001; ++i)
+    datastoreHistoryRecord(DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, (Data_t){.floatVal = 0.1f * (i % 7)}, i);
+
+  datastoreHistoryGetStats(DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, &stats);
+
+  /* The last samples are 997 % 7 = 3 through 1000 % 7 = 6 */
+  zassert_within(stats.sum, (double)(0.3f + 0.4f + 0.5f + 0.6f), 1e-6, "The float sum should not drift");
+}
+
+/**
+ * @test datastoreHistoryRead must copy the samples of the time range, oldest first.
+ */
+ZTEST(datastore_history_tests, test_read_range)
+{
+  DatastoreHistorySample_t samples[4];
+
+  for(int32_t i = 0; i < 6; ++i)
+    recordInt(i, 100 + i * 10);
+
+  zassert_equal(datastoreHistoryRead(DATAPOINT_INT, INT_FIRST_DATAPOINT, 125, 140, samples, ARRAY_SIZE(samples)), 2,
+                "Only the range samples should be copied");
+  zassert_equal(samples[0].timestampMs, 130, "The oldest sample should be first");
+  zassert_equal(samples[0].value.intVal, 3, "The sample value should be copied");
+  zassert_equal(samples[1].timestampMs, 140, "The range end should be included");
+
+  zassert_equal(datastoreHistoryRead(DATAPOINT_INT, INT_FIRST_DATAPOINT, 0, 200, samples, 3), 3,
+                "The sample count should be bounded");
+  zassert_equal(samples[0].value.intVal, 3, "The newest samples should be copied");
+  zassert_equal(samples[2].value.intVal, 5, "The newest sample should be last");
+
+  zassert_equal(datastoreHistoryRead(DATAPOINT_INT, INT_FIRST_DATAPOINT, 0, 100, samples, ARRAY_SIZE(samples)), 0,
+                "The dropped samples should not be copied");
+}
+
+/**
+ * @test datastoreHistoryRead must handle a range across the uptime wrap.
+ */
+ZTEST(datastore_history_tests, test_read_uptimeWrap)
+{
+  DatastoreHistorySample_t samples[4];
+
+  recordInt(1, UINT32_MAX - 5);
+  recordInt(2, 4);
+
+  zassert_equal(datastoreHistoryRead(DATAPOINT_INT, INT_FIRST_DATAPOINT, UINT32_MAX - 10, 10, samples,
+                                     ARRAY_SIZE(samples)), 2, "The range should span the uptime wrap");
+  zassert_equal(samples[1].value.intVal, 2, "The wrapped sample should be last");
+}
+
+ZTEST_SUITE(datastore_history_tests, NULL, NULL, history_tests_before, NULL, NULL);
@@ -0,0 +1,561 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Priority Lanes Tests
+ *
+ *            Unit tests for the datastore request lanes and control queue.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Include serviceCommon for Data_t and SrvMsgPayload_t */
+#include "serviceCommon.h"
+
+/* Enable the optional datastore APIs before the datastore header */
+#define CONFIG_ENYA_DATASTORE_DIRECT_READ 1
+#define CONFIG_ENYA_DATASTORE_BATCH 1
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS 4
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES 8
+#define CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY 1
+#define CONFIG_ENYA_DATASTORE_NVM 1
+#define CONFIG_ENYA_DATASTORE_COMPACT_STORAGE 1
+#define CONFIG_ENYA_DATASTORE_ASYNC 1
+#define CONFIG_POLL 1
+#define CONFIG_ENYA_DATASTORE_STATS 1
+#define CONFIG_ENYA_DATASTORE_PRIORITY_LANES 1
+#define CONFIG_ENYA_DATASTORE_REALTIME_MSG_COUNT 4
+#define CONFIG_ENYA_DATASTORE_BACKGROUND_MSG_COUNT 3
+#define CONFIG_ENYA_DATASTORE_BACKGROUND_PRIORITY 10
+
+/* Include datastore header for types and API */
+#include "datastore.h"
+
+/* Define config values needed by datastore.c */
+#define CONFIG_ENYA_DATASTORE_LOG_LEVEL LOG_LEVEL_DBG
+/* CONFIG_ENYA_DATASTORE_MSGQ_TIMEOUT is defined in Kconfig (default 1) */
+#define CONFIG_ENYA_DATASTORE_STACK_SIZE         512
+#define CONFIG_ENYA_DATASTORE_MAX_BINARY_SUBS    2
+#define CONFIG_ENYA_DATASTORE_MAX_BUTTON_SUBS    2
+#define CONFIG_ENYA_DATASTORE_MAX_FLOAT_SUBS     2
+#define CONFIG_ENYA_DATASTORE_MAX_INT_SUBS       2
+#define CONFIG_ENYA_DATASTORE_MAX_MULTI_STATE_SUBS 2
+#define CONFIG_ENYA_DATASTORE_MAX_UINT_SUBS      2
+#define CONFIG_ENYA_DATASTORE_THREAD_PRIORITY    5
+#define CONFIG_ENYA_DATASTORE_SERVICE_PRIORITY   1
+#define CONFIG_ENYA_DATASTORE_HEARTBEAT_INTERVAL_MS 1000
+#define CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES 4
+#define CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT 6
+#define CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES 16
+#define CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_COUNT 2
+#define CONFIG_ENYA_DATASTORE_LARGE_BUFFER_COUNT 2
+#define CONFIG_ENYA_DATASTORE_NOTIFY_BUFFER_COUNT 6
+#define DATASTORE_BUFFER_ALLOC_TIMEOUT 4
+#define DATASTORE_RUN_ITERATIONS 1
+
+/* Prevent util header from being included */
+#define DATASTORE_SRV_UTIL
+
+/* Prevent NVM header from being included */
+#define DATASTORE_SRV_NVM
+
+/* Wrap k_thread_create to use mock */
+#define k_thread_create k_thread_create_mock
+
+/* Wrap k_thread_name_set to use mock */
+#define k_thread_name_set k_thread_name_set_mock
+
+/* Wrap k_thread_start to use mock */
+#define k_thread_start k_thread_start_mock
+
+/* Wrap k_thread_resume to use mock */
+#define k_thread_resume k_thread_resume_mock
+
+/* Wrap k_thread_suspend to use mock */
+#define k_thread_suspend k_thread_suspend_mock
+
+/* Wrap k_current_get to use mock */
+#define k_current_get k_current_get_mock
+
+/* Wrap k_thread_priority_get to use mock */
+#define k_thread_priority_get k_thread_priority_get_mock
+
+/* Wrap k_is_in_isr to use mock */
+#define k_is_in_isr k_is_in_isr_mock
+
+/* Wrap k_poll to use mock */
+#define k_poll k_poll_mock
+
+/* Wrap k_uptime_get to use mock */
+#define k_uptime_get k_uptime_get_mock
+
+/* Wrap k_poll_signal_raise to use mock */
+#define k_poll_signal_raise k_poll_signal_raise_mock
+
+/* Wrap k_cycle_get_32 to use mock */
+#define k_cycle_get_32 k_cycle_get_32_mock
+
+/* Wrap k_cyc_to_us_floor32 to use mock */
+#define k_cyc_to_us_floor32 k_cyc_to_us_floor32_mock
+
+/* Mock function declarations */
+FAKE_VOID_FUNC(k_thread_start_mock, k_tid_t);
+FAKE_VOID_FUNC(k_thread_resume_mock, k_tid_t);
+FAKE_VOID_FUNC(k_thread_suspend_mock, k_tid_t);
+FAKE_VALUE_FUNC(k_tid_t, k_current_get_mock);
+FAKE_VALUE_FUNC(int, k_thread_priority_get_mock, k_tid_t);
+FAKE_VALUE_FUNC(bool, k_is_in_isr_mock);
+FAKE_VALUE_FUNC(int, k_poll_mock, struct k_poll_event *, int, k_timeout_t);
+FAKE_VALUE_FUNC(int64_t, k_uptime_get_mock);
+FAKE_VALUE_FUNC(int, k_poll_signal_raise_mock, struct k_poll_signal *, int);
+FAKE_VOID_FUNC(asyncDoneCb, int, void *);
+FAKE_VALUE_FUNC(uint32_t, k_cycle_get_32_mock);
+FAKE_VALUE_FUNC(uint32_t, k_cyc_to_us_floor32_mock, uint32_t);
+FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
+FAKE_VALUE_FUNC(osStatus_t, osMemoryPoolFree, osMemoryPoolId_t, void *);
+FAKE_VALUE_FUNC(osMemoryPoolId_t, osMemoryPoolNew, uint32_t, uint32_t, const osMemoryPoolAttr_t *);
+FAKE_VALUE_FUNC(uint32_t, osMemoryPoolGetCount, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(k_tid_t, k_thread_create_mock, struct k_thread *, k_thread_stack_t *, size_t,
+                k_thread_entry_t, void *, void *, void *, int, uint32_t, k_timeout_t);
+FAKE_VALUE_FUNC(int, k_thread_name_set_mock, k_tid_t, const char *);
+FAKE_VOID_FUNC(datastoreUtilInitDatapoints);
+FAKE_VALUE_FUNC(int, datastoreUtilAllocateBinarySubs, size_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAllocateButtonSubs, size_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAllocateFloatSubs, size_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAllocateIntSubs, size_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAllocateMultiStateSubs, size_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAllocateUintSubs, size_t);
+FAKE_VALUE_FUNC(size_t, datastoreUtilCalculateBufferSize, size_t *);
+FAKE_VALUE_FUNC(int, datastoreUtilRead, DatapointType_t, uint32_t, size_t, Data_t *);
+FAKE_VALUE_FUNC(int, datastoreUtilDirectRead, DatapointType_t, uint32_t, size_t, Data_t *);
+FAKE_VALUE_FUNC(int, datastoreUtilWrite, DatapointType_t, uint32_t, Data_t *, size_t, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilApplyBatch, Data_t *, size_t, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilFlushNotify, int64_t, osMemoryPoolId_t);
+FAKE_VOID_FUNC(datastoreUtilGetNotifyStats, DatastoreStats_t *);
+FAKE_VOID_FUNC(datastoreUtilResetNotifyStats);
+FAKE_VALUE_FUNC(int, datastoreNvmInit);
+FAKE_VALUE_FUNC(int, datastoreNvmRestore);
+FAKE_VALUE_FUNC(int, datastoreNvmProcess, int64_t);
+FAKE_VOID_FUNC(datastoreNvmRequestFlush);
+FAKE_VALUE_FUNC(int, datastoreNvmFlush, int64_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAddBinarySub, DatastoreSubEntry_t *, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilRemoveBinarySub, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUtilSetBinarySubPauseState, DatastoreSubCb_t, bool, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAddButtonSub, DatastoreSubEntry_t *, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilRemoveButtonSub, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUtilSetButtonSubPauseState, DatastoreSubCb_t, bool, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAddFloatSub, DatastoreSubEntry_t *, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilRemoveFloatSub, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUtilSetFloatSubPauseState, DatastoreSubCb_t, bool, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAddIntSub, DatastoreSubEntry_t *, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilRemoveIntSub, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUtilSetIntSubPauseState, DatastoreSubCb_t, bool, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAddMultiStateSub, DatastoreSubEntry_t *, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilRemoveMultiStateSub, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUtilSetMultiStateSubPauseState, DatastoreSubCb_t, bool, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilAddUintSub, DatastoreSubEntry_t *, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilRemoveUintSub, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUtilSetUintSubPauseState, DatastoreSubCb_t, bool, osMemoryPoolId_t);
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(k_thread_start_mock) \
+  FAKE(k_thread_resume_mock) \
+  FAKE(k_thread_suspend_mock) \
+  FAKE(k_current_get_mock) \
+  FAKE(k_thread_priority_get_mock) \
+  FAKE(k_is_in_isr_mock) \
+  FAKE(k_poll_mock) \
+  FAKE(k_uptime_get_mock) \
+  FAKE(k_poll_signal_raise_mock) \
+  FAKE(asyncDoneCb) \
+  FAKE(k_cycle_get_32_mock) \
+  FAKE(k_cyc_to_us_floor32_mock) \
+  FAKE(serviceManagerRegisterSrv) \
+  FAKE(serviceManagerConfirmState) \
+  FAKE(serviceManagerUpdateHeartbeat) \
+  FAKE(osMemoryPoolAlloc) \
+  FAKE(osMemoryPoolFree) \
+  FAKE(osMemoryPoolNew) \
+  FAKE(osMemoryPoolGetCount) \
+  FAKE(k_thread_create_mock) \
+  FAKE(k_thread_name_set_mock) \
+  FAKE(datastoreUtilInitDatapoints) \
+  FAKE(datastoreUtilAllocateBinarySubs) \
+  FAKE(datastoreUtilAllocateButtonSubs) \
+  FAKE(datastoreUtilAllocateFloatSubs) \
+  FAKE(datastoreUtilAllocateIntSubs) \
+  FAKE(datastoreUtilAllocateMultiStateSubs) \
+  FAKE(datastoreUtilAllocateUintSubs) \
+  FAKE(datastoreUtilCalculateBufferSize) \
+  FAKE(datastoreUtilRead) \
+  FAKE(datastoreUtilDirectRead) \
+  FAKE(datastoreUtilWrite) \
+  FAKE(datastoreUtilApplyBatch) \
+  FAKE(datastoreUtilFlushNotify) \
+  FAKE(datastoreUtilGetNotifyStats) \
+  FAKE(datastoreUtilResetNotifyStats) \
+  FAKE(datastoreNvmInit) \
+  FAKE(datastoreNvmRestore) \
+  FAKE(datastoreNvmProcess) \
+  FAKE(datastoreNvmRequestFlush) \
+  FAKE(datastoreNvmFlush) \
+  FAKE(datastoreUtilAddBinarySub) \
+  FAKE(datastoreUtilRemoveBinarySub) \
+  FAKE(datastoreUtilSetBinarySubPauseState) \
+  FAKE(datastoreUtilAddButtonSub) \
+  FAKE(datastoreUtilRemoveButtonSub) \
+  FAKE(datastoreUtilSetButtonSubPauseState) \
+  FAKE(datastoreUtilAddFloatSub) \
+  FAKE(datastoreUtilRemoveFloatSub) \
+  FAKE(datastoreUtilSetFloatSubPauseState) \
+  FAKE(datastoreUtilAddIntSub) \
+  FAKE(datastoreUtilRemoveIntSub) \
+  FAKE(datastoreUtilSetIntSubPauseState) \
+  FAKE(datastoreUtilAddMultiStateSub) \
+  FAKE(datastoreUtilRemoveMultiStateSub) \
+  FAKE(datastoreUtilSetMultiStateSubPauseState) \
+  FAKE(datastoreUtilAddUintSub) \
+  FAKE(datastoreUtilRemoveUintSub) \
+  FAKE(datastoreUtilSetUintSubPauseState)
+
+/* Prevent serviceManager.h from being included */
+#define SERVICE_MANAGER_H
+
+typedef enum
+{
+  SVC_STATE_STOPPED = 0,
+  SVC_STATE_RUNNING,
+  SVC_STATE_SUSPENDED,
+} ServiceState_t;
+
+typedef enum
+{
+  SVC_PRIORITY_CRITICAL = 0,
+  SVC_PRIORITY_CORE,
+  SVC_PRIORITY_APPLICATION,
+  SVC_PRIORITY_COUNT
+} ServicePriority_t;
+
+typedef struct
+{
+  k_tid_t threadId;
+  ServicePriority_t priority;
+  uint32_t heartbeatIntervalMs;
+  atomic_t lastHeartbeatMs;
+  uint8_t missedHeartbeats;
+  ServiceState_t state;
+  int (*start)(void);
+  int (*stop)(void);
+  int (*suspend)(void);
+  int (*resume)(void);
+} ServiceDescriptor_t;
+
+/* Provide ServiceHandle_t definition */
+typedef size_t ServiceHandle_t;
+
+#define TEST_SERVICE_HANDLE 3
+
+FAKE_VALUE_FUNC(int, serviceManagerRegisterSrv, const ServiceDescriptor_t *, ServiceHandle_t *);
+FAKE_VALUE_FUNC(int, serviceManagerConfirmState, ServiceHandle_t, ServiceState_t);
+FAKE_VALUE_FUNC(int, serviceManagerUpdateHeartbeat, ServiceHandle_t);
+
+/* Include the module under test */
+#include "datastore.c"
+
+/**
+ * @brief   The test thread priority of the real-time lane.
+ */
+#define TEST_REALTIME_PRIORITY          (CONFIG_ENYA_DATASTORE_BACKGROUND_PRIORITY - 1)
+
+/**
+ * @brief   The datapoint ID of the message put by the k_poll fake.
+ */
+#define TEST_POLL_DATAPOINT_ID          7
+
+/**
+ * @brief   The test request buffer size, holding a single value.
+ */
+#define TEST_REQUEST_SIZE               (sizeof(DatastoreRequestBuffer_t) + sizeof(Data_t))
+
+/**
+ * @brief   The test request buffers.
+ */
+static uint8_t __aligned(8) requestBuffers[2][TEST_REQUEST_SIZE];
+
+/**
+ * @brief   Get a test request buffer.
+ */
+#define TEST_REQUEST(index)             ((DatastoreRequestBuffer_t *)requestBuffers[index])
+
+/**
+ * @brief   Build a write message without response.
+ *
+ * @param[in]   datapointId: The datapoint ID.
+ * @param[in]   request: The request buffer.
+ *
+ * @return  The message.
+ */
+static DatastoreMsg_t buildWriteMsg(uint32_t datapointId, DatastoreRequestBuffer_t *request)
+{
+  DatastoreMsg_t msg = {.msgType = DATASTORE_WRITE, .datapointType = DATAPOINT_UINT, .datapointId = datapointId,
+                        .valCount = 1, .payload = &request->payload, .response = NULL};
+
+  return msg;
+}
+
+/**
+ * @brief   Custom fake for k_poll queueing a background request while waiting.
+ */
+static int k_poll_queue_background(struct k_poll_event *events, int num_events, k_timeout_t timeout)
+{
+  DatastoreMsg_t msg = buildWriteMsg(TEST_POLL_DATAPOINT_ID, TEST_REQUEST(0));
+
+  ARG_UNUSED(timeout);
+
+  for(int i = 0; i < num_events; ++i)
+    zassert_equal(events[i].state, K_POLL_STATE_NOT_READY, "The lane events should be reset before polling");
+
+  return k_msgq_put(&datastoreBgQueue, &msg, K_NO_WAIT);
+}
+
+static void lanes_tests_before(void *f)
+{
+  ARG_UNUSED(f);
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  serviceHandle = TEST_SERVICE_HANDLE;
+
+  /* Make direct reads collide by default so reads use the queue path */
+  datastoreUtilDirectRead_fake.return_val = -EAGAIN;
+
+  k_thread_priority_get_mock_fake.return_val = TEST_REALTIME_PRIORITY;
+  k_poll_mock_fake.return_val = -EAGAIN;
+
+  for(uint32_t i = 0; i < DATASTORE_POOL_COUNT; ++i)
+    bufferPools[i].id = (osMemoryPoolId_t)(0x1000 + i * 0x100);
+
+  memset(&datastoreStats, 0, sizeof(datastoreStats));
+  memset(requestBuffers, 0, sizeof(requestBuffers));
+
+  for(uint32_t i = 0; i < DATASTORE_LANE_COUNT; ++i)
+    k_msgq_purge(laneQueues[i]);
+}
+
+/**
+ * @test  The requests must take the lane of the calling thread priority.
+ */
+ZTEST(datastore_lanes_tests, test_request_lane_by_priority)
+{
+  Data_t value = {.uintVal = 1};
+
+  osMemoryPoolAlloc_fake.return_val = TEST_REQUEST(0);
+
+  zassert_equal(datastoreWrite(DATAPOINT_UINT, 0, &value, 1, NULL), 0, "The write should be queued");
+  zassert_equal(k_msgq_num_used_get(&datastoreQueue), 1, "A real-time thread should use the real-time lane");
+
+  k_thread_priority_get_mock_fake.return_val = CONFIG_ENYA_DATASTORE_BACKGROUND_PRIORITY;
+
+  zassert_equal(datastoreWrite(DATAPOINT_UINT, 0, &value, 1, NULL), 0, "The write should be queued");
+  zassert_equal(k_msgq_num_used_get(&datastoreBgQueue), 1, "A background thread should use the background lane");
+  zassert_equal(k_msgq_num_used_get(&datastoreQueue), 1, "The real-time lane should not change");
+}
+
+/**
+ * @test  The requests submitted from an ISR must take the real-time lane.
+ */
+ZTEST(datastore_lanes_tests, test_request_lane_isr)
+{
+  Data_t value = {.uintVal = 1};
+
+  osMemoryPoolAlloc_fake.return_val = TEST_REQUEST(0);
+  k_thread_priority_get_mock_fake.return_val = CONFIG_ENYA_DATASTORE_BACKGROUND_PRIORITY;
+  k_is_in_isr_mock_fake.return_val = true;
+
+  zassert_equal(datastoreWrite(DATAPOINT_UINT, 0, &value, 1, NULL), 0, "The write should be queued");
+  zassert_equal(k_msgq_num_used_get(&datastoreQueue), 1, "An ISR should use the real-time lane");
+  zassert_equal(k_thread_priority_get_mock_fake.call_count, 0, "An ISR has no thread priority");
+}
+
+/**
+ * @test  A full background lane must not reject the real-time requests.
+ */
+ZTEST(datastore_lanes_tests, test_request_background_full)
+{
+  Data_t value = {.uintVal = 1};
+  DatastoreMsg_t msg = buildWriteMsg(0, TEST_REQUEST(0));
+
+  for(uint32_t i = 0; i < CONFIG_ENYA_DATASTORE_BACKGROUND_MSG_COUNT; ++i)
+    zassert_equal(k_msgq_put(&datastoreBgQueue, &msg, K_NO_WAIT), 0, "Failed to fill the background lane");
+
+  osMemoryPoolAlloc_fake.return_val = TEST_REQUEST(1);
+  k_thread_priority_get_mock_fake.return_val = CONFIG_ENYA_DATASTORE_BACKGROUND_PRIORITY;
+
+  zassert_true(datastoreWrite(DATAPOINT_UINT, 0, &value, 1, NULL) < 0, "A full background lane should fail");
+
+  k_thread_priority_get_mock_fake.return_val = TEST_REALTIME_PRIORITY;
+
+  zassert_equal(datastoreWrite(DATAPOINT_UINT, 0, &value, 1, NULL), 0, "The real-time lane should accept the write");
+}
+
+/**
+ * @test  The background requests must take the background lane whatever the thread priority.
+ */
+ZTEST(datastore_lanes_tests, test_request_background_explicit)
+{
+  Data_t value = {.uintVal = 1};
+  Data_t readValue;
+  struct k_poll_signal signal;
+
+  osMemoryPoolAlloc_fake.return_val = TEST_REQUEST(0);
+
+  zassert_equal(datastoreWriteBackground(DATAPOINT_UINT, 0, &value, 1, NULL), 0, "The write should be queued");
+  zassert_equal(datastoreWriteAsyncBackground(DATAPOINT_UINT, 0, &value, 1, NULL, NULL), 0,
+                "The asynchronous write should be queued");
+  zassert_equal(datastoreReadAsyncBackground(DATAPOINT_UINT, 0, 1, &readValue, datastoreSignalDone, &signal), 0,
+                "The asynchronous read should be queued");
+
+  zassert_equal(k_msgq_num_used_get(&datastoreBgQueue), 3, "The requests should use the background lane");
+  zassert_equal(k_msgq_num_used_get(&datastoreQueue), 0, "The real-time lane should stay empty");
+  zassert_equal(k_thread_priority_get_mock_fake.call_count, 0, "The thread priority should not select the lane");
+}
+
+/**
+ * @test  The background batch must take the background lane whatever the thread priority.
+ */
+ZTEST(datastore_lanes_tests, test_batch_background_explicit)
+{
+  static uint8_t __aligned(8) batchBuffer[sizeof(DatastoreRequestBuffer_t) + 8 * sizeof(Data_t)];
+  Data_t value = {.uintVal = 1};
+  DatastoreBatchOp_t op = {.opType = DATASTORE_BATCH_WRITE, .datapointType = DATAPOINT_UINT, .datapointId = 0,
+                           .values = &value, .valCount = 1};
+
+  osMemoryPoolAlloc_fake.return_val = batchBuffer;
+
+  zassert_equal(datastoreBatchBackground(&op, 1, NULL), 0, "The batch should be queued");
+  zassert_equal(k_msgq_num_used_get(&datastoreBgQueue), 1, "The batch should use the background lane");
+  zassert_equal(k_msgq_num_used_get(&datastoreQueue), 0, "The real-time lane should stay empty");
+}
+
+/**
+ * @test  The background read must still try the direct read first.
+ */
+ZTEST(datastore_lanes_tests, test_read_background_direct)
+{
+  Data_t value;
+
+  datastoreUtilDirectRead_fake.return_val = 0;
+
+  zassert_equal(datastoreReadBackground(DATAPOINT_UINT, 0, 1, NULL, &value), 0, "The direct read should succeed");
+  zassert_equal(datastoreUtilDirectRead_fake.call_count, 1, "The direct read should be tried");
+  zassert_equal(k_msgq_num_used_get(&datastoreBgQueue), 0, "A direct read should not be queued");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0, "A direct read should not allocate a buffer");
+}
+
+/**
+ * @test  The run function must serve the real-time lane before the background lane.
+ */
+ZTEST(datastore_lanes_tests, test_run_strict_priority)
+{
+  DatastoreMsg_t msg = buildWriteMsg(1, TEST_REQUEST(0));
+
+  zassert_equal(k_msgq_put(&datastoreBgQueue, &msg, K_NO_WAIT), 0, "Failed to put the background message");
+
+  msg = buildWriteMsg(2, TEST_REQUEST(1));
+  zassert_equal(k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT), 0, "Failed to put the real-time message");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilWrite_fake.call_count, 1, "A single message should be served per iteration");
+  zassert_equal(datastoreUtilWrite_fake.arg1_val, 2, "The real-time message should be served first");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilWrite_fake.arg1_val, 1, "The background message should be served next");
+  zassert_equal(k_poll_mock_fake.call_count, 0, "A queued message should be served without polling");
+}
+
+/**
+ * @test  The stop message must take the control queue and be served before the requests.
+ */
+ZTEST(datastore_lanes_tests, test_run_control_first)
+{
+  DatastoreMsg_t msg = buildWriteMsg(0, TEST_REQUEST(0));
+
+  for(uint32_t i = 0; i < DATASTORE_MSG_COUNT; ++i)
+    zassert_equal(k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT), 0, "Failed to fill the real-time lane");
+
+  zassert_equal(onStop(), 0, "A full real-time lane should not reject the stop");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 2, "The stop should be served first");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_STOPPED, "The stop should be confirmed");
+  zassert_equal(datastoreUtilWrite_fake.call_count, 0, "No request should be served before the stop");
+}
+
+/**
+ * @test  The suspend message must take the control queue.
+ */
+ZTEST(datastore_lanes_tests, test_onSuspend_control_queue)
+{
+  DatastoreMsg_t msg = {0};
+
+  zassert_equal(onSuspend(), 0, "The suspend should be queued");
+  zassert_equal(k_msgq_get(&datastoreCtrlQueue, &msg, K_NO_WAIT), 0, "The suspend should take the control queue");
+  zassert_equal(msg.msgType, DATASTORE_SUSPEND, "The suspend message should be queued");
+  zassert_equal(k_msgq_num_used_get(&datastoreQueue), 0, "The real-time lane should stay empty");
+}
+
+/**
+ * @test  The run function must poll every lane when they are empty.
+ */
+ZTEST(datastore_lanes_tests, test_run_poll_timeout)
+{
+  run(NULL, NULL, NULL);
+
+  zassert_equal(k_poll_mock_fake.call_count, 1, "The lanes should be polled");
+  zassert_equal(k_poll_mock_fake.arg0_val, laneEvents, "The lane events should be polled");
+  zassert_equal(k_poll_mock_fake.arg1_val, DATASTORE_LANE_COUNT, "Every lane should be polled");
+  zassert_equal(datastoreUtilWrite_fake.call_count, 0, "Nothing should be served on timeout");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, 1, "The heartbeat should be updated");
+}
+
+/**
+ * @test  The run function must serve a message queued while polling.
+ */
+ZTEST(datastore_lanes_tests, test_run_poll_wakeup)
+{
+  k_poll_mock_fake.custom_fake = k_poll_queue_background;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilWrite_fake.call_count, 1, "The woken lane should be served");
+  zassert_equal(datastoreUtilWrite_fake.arg1_val, TEST_POLL_DATAPOINT_ID, "The queued message should be served");
+}
+
+/**
+ * @test  The run function must record the background lane high water apart.
+ */
+ZTEST(datastore_lanes_tests, test_run_background_high_water)
+{
+  DatastoreStats_t stats;
+  DatastoreMsg_t msg = buildWriteMsg(0, TEST_REQUEST(0));
+
+  for(uint32_t i = 0; i < 2; ++i)
+    zassert_equal(k_msgq_put(&datastoreBgQueue, &msg, K_NO_WAIT), 0, "Failed to put the background message");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreGetStats(&stats), 0, "The statistics should be available");
+  zassert_equal(stats.bgQueueHighWater, 2, "The background high water should be recorded");
+  zassert_equal(stats.queueHighWater, 0, "The real-time high water should not change");
+}
+
+ZTEST_SUITE(datastore_lanes_tests, NULL, NULL, lanes_tests_before, NULL, NULL);
@@ -0,0 +1,601 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-03-02
+ * @brief     Datastore Deferred Notification Tests
+ *
+ *            Unit tests for the datastore deferred subscriber notifications.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Wrap functions to use mocks */
+#define k_uptime_get k_uptime_get_mock
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY 1
+#define CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS 10
+#define CONFIG_ENYA_DATASTORE_NOTIFY_WRITE_THRESHOLD 4
+#define CONFIG_ENYA_DATASTORE_DELTA_NOTIFY 1
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(osMemoryPoolAlloc) \
+  FAKE(osMemoryPoolFree) \
+  FAKE(k_malloc) \
+  FAKE(k_free) \
+  FAKE(k_uptime_get_mock) \
+  FAKE(mock_subscription_callback)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Redefine LOG_ERR to avoid dereferencing invalid pointers in error messages */
+#undef LOG_ERR
+#define LOG_ERR(...) do {} while (0)
+
+/* Mock osMemoryPool functions */
+FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
+FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+/* Mock kernel functions */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+FAKE_VOID_FUNC(k_free, void *);
+FAKE_VALUE_FUNC(int64_t, k_uptime_get_mock);
+
+/* Include utility implementation - this will define SrvMsgPayload_t */
+#include "datastoreUtil.c"
+
+/* Mock subscription callback - SrvMsgPayload_t is now defined */
+FAKE_VALUE_FUNC(int, mock_subscription_callback, SrvMsgPayload_t *, size_t);
+
+/**
+ * The test pool.
+ */
+#define TEST_POOL                       ((osMemoryPoolId_t)0x1000)
+
+/**
+ * The test subscription entries.
+ */
+static DatastoreSubEntry_t binaryEntries[4];
+static DatastoreSubEntry_t floatEntries[4];
+static DatastoreSubEntry_t intEntries[4];
+
+/**
+ * The test notification payload buffer.
+ */
+static uint8_t payloadBuffer[256];
+
+/**
+ * Add a subscription entry directly to the subscription list.
+ */
+static DatastoreSubEntry_t *addTestSub(struct DatastoreSubs *subs, uint32_t datapointId, size_t valCount)
+{
+  DatastoreSubEntry_t *sub = subs->entries + subs->activeCount;
+
+  memset(sub, 0, sizeof(DatastoreSubEntry_t));
+  sub->datapointId = datapointId;
+  sub->valCount = valCount;
+  sub->callback = mock_subscription_callback;
+  ++subs->activeCount;
+
+  return sub;
+}
+
+/**
+ * Test setup function.
+ */
+static void *notify_tests_setup(void)
+{
+  return NULL;
+}
+
+/**
+ * Test before function.
+ */
+static void notify_tests_before(void *fixture)
+{
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(binaryEntries, 0, sizeof(binaryEntries));
+  memset(floatEntries, 0, sizeof(floatEntries));
+  memset(intEntries, 0, sizeof(intEntries));
+
+  binarySubs = (struct DatastoreSubs){.entries = binaryEntries, .maxCount = 4, .activeCount = 0};
+  floatSubs = (struct DatastoreSubs){.entries = floatEntries, .maxCount = 4, .activeCount = 0};
+  intSubs = (struct DatastoreSubs){.entries = intEntries, .maxCount = 4, .activeCount = 0};
+
+  for(size_t i = 0; i < BINARY_DATAPOINT_COUNT; ++i)
+    binaries[i].value.uintVal = 0;
+
+  for(size_t i = 0; i < FLOAT_DATAPOINT_COUNT; ++i)
+    floats[i].value.floatVal = 0.0f;
+
+  for(size_t i = 0; i < INT_DATAPOINT_COUNT; ++i)
+    ints[i].value.intVal = 0;
+
+  /* Reset the deferred notification state */
+  for(size_t i = 0; i < DATAPOINT_TYPE_COUNT; ++i)
+    memset(dirtyBitmaps[i], 0, DIRTY_BITMAP_WORD_COUNT(datapointCounts[i]) * sizeof(uint32_t));
+
+  dirtyTypes = 0;
+  dirtyWriteCount = 0;
+  hasPendingSubs = false;
+  lastFlushMs = 0;
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+}
+
+/**
+ * @test The datastoreUtilWrite function must only mark the changed datapoints
+ * dirty without notifying the subscribers.
+ */
+ZTEST(datastore_notify_tests, test_write_marks_changed_datapoints_dirty)
+{
+  Data_t values[3] = {{.uintVal = 1}, {.uintVal = 0}, {.uintVal = 1}};
+
+  addTestSub(&binarySubs, 0, 3);
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 3, TEST_POOL), 0,
+                "Should return 0 on success");
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 0,
+                "Callback should not be called by the write");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0,
+                "osMemoryPoolAlloc should not be called by the write");
+  zassert_equal(binaryDirty[0], BIT(0) | BIT(2),
+                "Only the changed datapoints should be marked dirty");
+  zassert_equal(dirtyTypes, BIT(DATAPOINT_BINARY), "Binary type should be marked dirty");
+  zassert_equal(dirtyWriteCount, 1, "Changing write should be counted");
+}
+
+/**
+ * @test The datastoreUtilWrite function must not count a write without change.
+ */
+ZTEST(datastore_notify_tests, test_write_no_change_keeps_clean)
+{
+  Data_t values[1] = {{.uintVal = 0}};
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 1, TEST_POOL), 0,
+                "Should return 0 on success");
+
+  zassert_equal(binaryDirty[0], 0, "No datapoint should be marked dirty");
+  zassert_equal(dirtyTypes, 0, "No type should be marked dirty");
+  zassert_equal(dirtyWriteCount, 0, "Write without change should not be counted");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must do nothing when no
+ * datapoint is dirty.
+ */
+ZTEST(datastore_notify_tests, test_flush_nothing_dirty)
+{
+  addTestSub(&binarySubs, 0, 1);
+
+  zassert_equal(datastoreUtilFlushNotify(100, TEST_POOL), 0, "Should return 0");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0, "Callback should not be called");
+  zassert_equal(lastFlushMs, 0, "Last flush time should be unchanged");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must wait for the notification
+ * period when the write threshold is not reached.
+ */
+ZTEST(datastore_notify_tests, test_flush_not_due)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+
+  addTestSub(&binarySubs, 0, 1);
+  datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 1, TEST_POOL);
+
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS - 1, TEST_POOL), 0,
+                "Should return 0");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0,
+                "Callback should not be called before the period");
+  zassert_equal(dirtyWriteCount, 1, "Dirty write count should be kept");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must notify an overlapping
+ * subscriber once with the latest values when the period elapsed.
+ */
+ZTEST(datastore_notify_tests, test_flush_period_coalesces_writes)
+{
+  SrvMsgPayload_t *payload = (SrvMsgPayload_t *)payloadBuffer;
+  Data_t first[1] = {{.uintVal = 1}};
+  Data_t second[2] = {{.uintVal = 0}, {.uintVal = 1}};
+
+  addTestSub(&binarySubs, 0, 2);
+  k_uptime_get_mock_fake.return_val = CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS;
+
+  datastoreUtilWrite(DATAPOINT_BINARY, 0, first, 1, TEST_POOL);
+  datastoreUtilWrite(DATAPOINT_BINARY, 0, second, 2, TEST_POOL);
+
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), 0,
+                "Should return 0 on success");
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Callback should be called once for both writes");
+  zassert_equal(mock_subscription_callback_fake.arg1_val, 2, "Callback should get the subscription count");
+  zassert_equal(payload->data[0].uintVal, 0, "First value should be the latest");
+  zassert_equal(payload->data[1].uintVal, 1, "Second value should be the latest");
+  zassert_equal(binaryDirty[0], 0, "Dirty bitmap should be cleared");
+  zassert_equal(dirtyTypes, 0, "Dirty types should be cleared");
+  zassert_equal(dirtyWriteCount, 0, "Dirty write count should be cleared");
+  zassert_equal(lastFlushMs, CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, "Last flush time should be updated");
+  zassert_equal(binaryEntries[0].lastNotifyMs, CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS,
+                "Last notification time should be updated");
+  zassert_false(binaryEntries[0].isPending, "Subscription should not be pending");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must flush before the period
+ * once the write threshold is reached.
+ */
+ZTEST(datastore_notify_tests, test_flush_write_threshold)
+{
+  Data_t values[1];
+
+  addTestSub(&binarySubs, 0, 1);
+
+  for(size_t i = 0; i < CONFIG_ENYA_DATASTORE_NOTIFY_WRITE_THRESHOLD; ++i)
+  {
+    values[0].uintVal = (i + 1) % 2;
+    datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 1, TEST_POOL);
+  }
+
+  zassert_equal(datastoreUtilFlushNotify(1, TEST_POOL), 0, "Should return 0 on success");
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Callback should be called once the threshold is reached");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must skip the subscriptions not
+ * overlapping a dirty datapoint and the paused subscriptions.
+ */
+ZTEST(datastore_notify_tests, test_flush_skips_clean_and_paused_subs)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+  DatastoreSubEntry_t *paused;
+
+  addTestSub(&binarySubs, 1, 2);
+  paused = addTestSub(&binarySubs, 0, 1);
+  paused->isPaused = true;
+
+  datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 1, TEST_POOL);
+
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), 0,
+                "Should return 0");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0, "Callback should not be called");
+  zassert_false(paused->isPending, "Paused subscription should not stay pending");
+  zassert_false(hasPendingSubs, "No subscription should be left pending");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must keep a subscription pending
+ * until its minimum interval elapsed.
+ */
+ZTEST(datastore_notify_tests, test_flush_min_interval_keeps_pending)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+  DatastoreSubEntry_t *sub;
+
+  sub = addTestSub(&binarySubs, 0, 1);
+  sub->minIntervalMs = 100;
+
+  datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 1, TEST_POOL);
+
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), 0,
+                "Should return 0");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0,
+                "Callback should not be called within the minimum interval");
+  zassert_true(sub->isPending, "Subscription should stay pending");
+  zassert_true(hasPendingSubs, "Pending subscriptions should be flagged");
+
+  /* No new write, the pending subscription is flushed once its interval elapsed */
+  k_uptime_get_mock_fake.return_val = 100;
+  zassert_equal(datastoreUtilFlushNotify(100, TEST_POOL), 0, "Should return 0 on success");
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Callback should be called once the interval elapsed");
+  zassert_false(sub->isPending, "Subscription should not be pending anymore");
+  zassert_false(hasPendingSubs, "No subscription should be left pending");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must send a delta subscription
+ * the span of its dirty datapoints.
+ */
+ZTEST(datastore_notify_tests, test_flush_delta_dirty_span)
+{
+  Data_t first[1] = {{.uintVal = 1}};
+  Data_t last[1] = {{.uintVal = 1}};
+  DatastoreDeltaHeader_t header;
+  DatastoreSubEntry_t *sub;
+
+  sub = addTestSub(&binarySubs, 0, 3);
+  sub->isDelta = true;
+
+  datastoreUtilWrite(DATAPOINT_BINARY, 1, first, 1, TEST_POOL);
+  datastoreUtilWrite(DATAPOINT_BINARY, 2, last, 1, TEST_POOL);
+
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), 0,
+                "Should return 0 on success");
+
+  memcpy(&header, ((SrvMsgPayload_t *)payloadBuffer)->data, sizeof(header));
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "Callback should be called once");
+  zassert_equal(header.datapointId, 1, "Delta should start at the first dirty datapoint");
+  zassert_equal(header.valCount, 2, "Delta should end at the last dirty datapoint");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must send a delta subscription
+ * left pending by its minimum interval its whole range.
+ */
+ZTEST(datastore_notify_tests, test_flush_delta_pending_full_range)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+  DatastoreDeltaHeader_t header;
+  DatastoreSubEntry_t *sub;
+
+  sub = addTestSub(&binarySubs, 0, 3);
+  sub->isDelta = true;
+  sub->minIntervalMs = 100;
+
+  datastoreUtilWrite(DATAPOINT_BINARY, 1, values, 1, TEST_POOL);
+  datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL);
+
+  zassert_equal(datastoreUtilFlushNotify(100, TEST_POOL), 0, "Should return 0 on success");
+
+  memcpy(&header, ((SrvMsgPayload_t *)payloadBuffer)->data, sizeof(header));
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "Callback should be called once");
+  zassert_equal(header.datapointId, 0, "Delta should start at the subscription");
+  zassert_equal(header.valCount, 3, "Delta should cover the whole subscription");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must not notify a float
+ * subscription when the change stays within its deadband.
+ */
+ZTEST(datastore_notify_tests, test_flush_float_deadband_not_exceeded)
+{
+  Data_t refValues[1] = {{.floatVal = 1.0f}};
+  Data_t values[1] = {{.floatVal = 1.4f}};
+  DatastoreSubEntry_t *sub;
+
+  floats[0].value.floatVal = 1.0f;
+  sub = addTestSub(&floatSubs, 0, 1);
+  sub->deadband.floatVal = 0.5f;
+  sub->refValues = refValues;
+
+  datastoreUtilWrite(DATAPOINT_FLOAT, 0, values, 1, TEST_POOL);
+
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), 0,
+                "Should return 0");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0,
+                "Callback should not be called within the deadband");
+  zassert_false(sub->isPending, "Subscription should not stay pending");
+  zassert_within(refValues[0].floatVal, 1.0f, 0.001f, "Reference value should be unchanged");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must notify a float subscription
+ * when the change exceeds its deadband and update its reference values.
+ */
+ZTEST(datastore_notify_tests, test_flush_float_deadband_exceeded)
+{
+  Data_t refValues[1] = {{.floatVal = 1.0f}};
+  Data_t values[1] = {{.floatVal = 0.4f}};
+  DatastoreSubEntry_t *sub;
+
+  floats[0].value.floatVal = 1.0f;
+  sub = addTestSub(&floatSubs, 0, 1);
+  sub->deadband.floatVal = 0.5f;
+  sub->refValues = refValues;
+
+  datastoreUtilWrite(DATAPOINT_FLOAT, 0, values, 1, TEST_POOL);
+
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), 0,
+                "Should return 0 on success");
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Callback should be called beyond the deadband");
+  zassert_within(refValues[0].floatVal, 0.4f, 0.001f, "Reference value should be updated");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must compare the signed integer
+ * deadband on the absolute change.
+ */
+ZTEST(datastore_notify_tests, test_flush_int_deadband_negative_change)
+{
+  Data_t refValues[1] = {{.intVal = 10}};
+  Data_t values[1] = {{.intVal = 6}};
+  DatastoreSubEntry_t *sub;
+
+  ints[0].value.intVal = 10;
+  sub = addTestSub(&intSubs, 0, 1);
+  sub->deadband.intVal = 3;
+  sub->refValues = refValues;
+
+  datastoreUtilWrite(DATAPOINT_INT, 0, values, 1, TEST_POOL);
+
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), 0,
+                "Should return 0 on success");
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Callback should be called for a negative change beyond the deadband");
+  zassert_equal(refValues[0].intVal, 6, "Reference value should be updated");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must keep a subscription pending
+ * and return the error when no buffer is available.
+ */
+ZTEST(datastore_notify_tests, test_flush_alloc_failure_retries)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+  DatastoreSubEntry_t *sub;
+
+  sub = addTestSub(&binarySubs, 0, 1);
+  datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 1, TEST_POOL);
+
+  osMemoryPoolAlloc_fake.return_val = NULL;
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), -ENOSPC,
+                "Should return -ENOSPC when no buffer is available");
+  zassert_true(sub->isPending, "Subscription should stay pending");
+  zassert_true(hasPendingSubs, "Pending subscriptions should be flagged");
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+  zassert_equal(datastoreUtilFlushNotify(2 * CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), 0,
+                "Should return 0 on retry");
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "Callback should be called on retry");
+  zassert_false(sub->isPending, "Subscription should not be pending anymore");
+}
+
+/**
+ * @test The datastoreUtilFlushNotify function must not retry a subscription
+ * whose callback failed.
+ */
+ZTEST(datastore_notify_tests, test_flush_callback_failure)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+  DatastoreSubEntry_t *sub;
+
+  sub = addTestSub(&binarySubs, 0, 1);
+  datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 1, TEST_POOL);
+  mock_subscription_callback_fake.return_val = -EIO;
+
+  zassert_equal(datastoreUtilFlushNotify(CONFIG_ENYA_DATASTORE_NOTIFY_PERIOD_MS, TEST_POOL), -EIO,
+                "Should return the callback error");
+  zassert_false(sub->isPending, "Subscription should not stay pending");
+  zassert_false(hasPendingSubs, "No subscription should be left pending");
+}
+
+/**
+ * @test The datastoreUtilAddFloatSub function must allocate and initialize the
+ * deadband reference values of a subscription with a deadband.
+ */
+ZTEST(datastore_notify_tests, test_add_sub_deadband_reference)
+{
+  Data_t refValues[2];
+  DatastoreSubEntry_t sub = {
+    .datapointId = 0,
+    .valCount = 2,
+    .callback = mock_subscription_callback,
+    .deadband = {.floatVal = 0.5f},
+  };
+
+  floats[0].value.floatVal = 1.5f;
+  floats[1].value.floatVal = -2.0f;
+  k_malloc_fake.return_val = refValues;
+  k_uptime_get_mock_fake.return_val = 42;
+
+  zassert_equal(datastoreUtilAddFloatSub(&sub, TEST_POOL), 0, "Should return 0 on success");
+
+  zassert_equal(k_malloc_fake.call_count, 1, "k_malloc should be called once");
+  zassert_equal(k_malloc_fake.arg0_val, 2 * sizeof(Data_t), "k_malloc should allocate the reference values");
+  zassert_equal_ptr(floatEntries[0].refValues, refValues, "Reference values should be saved");
+  zassert_within(refValues[0].floatVal, 1.5f, 0.001f, "First reference should be the current value");
+  zassert_within(refValues[1].floatVal, -2.0f, 0.001f, "Second reference should be the current value");
+  zassert_equal(floatEntries[0].lastNotifyMs, 42, "Last notification time should be initialized");
+}
+
+/**
+ * @test The datastoreUtilAddFloatSub function must not allocate reference
+ * values for a subscription without deadband.
+ */
+ZTEST(datastore_notify_tests, test_add_sub_no_deadband)
+{
+  DatastoreSubEntry_t sub = {
+    .datapointId = 0,
+    .valCount = 1,
+    .callback = mock_subscription_callback,
+  };
+
+  zassert_equal(datastoreUtilAddFloatSub(&sub, TEST_POOL), 0, "Should return 0 on success");
+
+  zassert_equal(k_malloc_fake.call_count, 0, "k_malloc should not be called");
+  zassert_is_null(floatEntries[0].refValues, "Reference values should be NULL");
+}
+
+/**
+ * @test The datastoreUtilAddFloatSub function must return -ENOMEM and not add
+ * the subscription when the reference values allocation fails.
+ */
+ZTEST(datastore_notify_tests, test_add_sub_deadband_alloc_failure)
+{
+  DatastoreSubEntry_t sub = {
+    .datapointId = 0,
+    .valCount = 1,
+    .callback = mock_subscription_callback,
+    .deadband = {.floatVal = 0.5f},
+  };
+
+  k_malloc_fake.return_val = NULL;
+
+  zassert_equal(datastoreUtilAddFloatSub(&sub, TEST_POOL), -ENOMEM,
+                "Should return -ENOMEM when the reference allocation fails");
+  zassert_equal(floatSubs.activeCount, 0, "Subscription should not be added");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0, "Callback should not be called");
+}
+
+/**
+ * @test The datastoreUtilRemoveFloatSub function must free the deadband
+ * reference values of the removed subscription.
+ */
+ZTEST(datastore_notify_tests, test_remove_sub_frees_reference)
+{
+  Data_t refValues[1];
+  DatastoreSubEntry_t *sub;
+
+  sub = addTestSub(&floatSubs, 0, 1);
+  sub->refValues = refValues;
+
+  zassert_equal(datastoreUtilRemoveFloatSub(mock_subscription_callback), 0, "Should return 0 on success");
+
+  zassert_equal(k_free_fake.call_count, 1, "k_free should be called once");
+  zassert_equal_ptr(k_free_fake.arg0_val, refValues, "k_free should free the reference values");
+}
+
+/**
+ * @test The datastoreUtilSetFloatSubPauseState function must refresh the
+ * notification state when unpausing a subscription.
+ */
+ZTEST(datastore_notify_tests, test_unpause_sub_refreshes_state)
+{
+  Data_t refValues[1] = {{.floatVal = 0.0f}};
+  DatastoreSubEntry_t *sub;
+
+  floats[0].value.floatVal = 3.0f;
+  sub = addTestSub(&floatSubs, 0, 1);
+  sub->isPaused = true;
+  sub->isPending = true;
+  sub->refValues = refValues;
+  k_uptime_get_mock_fake.return_val = 77;
+
+  zassert_equal(datastoreUtilSetFloatSubPauseState(mock_subscription_callback, false, TEST_POOL), 0,
+                "Should return 0 on success");
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "Callback should be called on unpause");
+  zassert_equal(sub->lastNotifyMs, 77, "Last notification time should be refreshed");
+  zassert_false(sub->isPending, "Subscription should not be pending");
+  zassert_within(refValues[0].floatVal, 3.0f, 0.001f, "Reference value should be refreshed");
+}
+
+ZTEST_SUITE(datastore_notify_tests, NULL, notify_tests_setup, notify_tests_before, NULL, NULL);
@@ -0,0 +1,561 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-03-23
+ * @brief     Datastore NVM Persistence Tests
+ *
+ *            Unit tests for the datastore NVM persistence write-behind journal.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Wrap functions to use mocks */
+#define k_work_submit k_work_submit_mock
+#define k_work_flush k_work_flush_mock
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_NVM 1
+#define CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS 100
+
+#include <zephyr/settings/settings.h>
+
+#include "datastoreUtil.h"
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(k_malloc) \
+  FAKE(k_work_submit_mock) \
+  FAKE(k_work_flush_mock) \
+  FAKE(settings_subsys_init) \
+  FAKE(settings_save_one) \
+  FAKE(settings_load_subtree_direct) \
+  FAKE(datastoreUtilGetNvmCount) \
+  FAKE(datastoreUtilRestoreNvm) \
+  FAKE(datastoreUtilGetNvmDirtyTypes) \
+  FAKE(datastoreUtilSnapshotNvm)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Mock kernel functions */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+FAKE_VALUE_FUNC(int, k_work_submit_mock, struct k_work *);
+FAKE_VALUE_FUNC(bool, k_work_flush_mock, struct k_work *, struct k_work_sync *);
+
+/* Mock settings functions */
+FAKE_VALUE_FUNC(int, settings_subsys_init);
+FAKE_VALUE_FUNC(int, settings_save_one, const char *, const void *, size_t);
+FAKE_VALUE_FUNC(int, settings_load_subtree_direct, const char *, settings_load_direct_cb, void *);
+
+/* Mock datastore utility functions */
+FAKE_VALUE_FUNC(size_t, datastoreUtilGetNvmCount, DatapointType_t);
+FAKE_VALUE_FUNC(int, datastoreUtilRestoreNvm, DatapointType_t, const Data_t *, size_t);
+FAKE_VALUE_FUNC(uint32_t, datastoreUtilGetNvmDirtyTypes);
+FAKE_VALUE_FUNC(size_t, datastoreUtilSnapshotNvm, DatapointType_t, Data_t *);
+
+/* Include NVM persistence implementation */
+#include "datastoreNvm.c"
+
+/**
+ * The test journal buffer.
+ */
+static Data_t testJournal[8];
+
+/**
+ * The test persisted datapoint counts, binary 2 and uint 1.
+ */
+static size_t testNvmCounts[DATAPOINT_TYPE_COUNT] = {2, 0, 0, 0, 0, 1};
+
+/**
+ * The test record read length override, negative to use the requested length.
+ */
+static ssize_t testReadLen;
+
+/**
+ * @brief   The test persisted datapoint count.
+ *
+ * @param[in]   type: The datapoint type.
+ *
+ * @return  The persisted datapoint count of the type.
+ */
+static size_t testGetNvmCount(DatapointType_t type)
+{
+  return testNvmCounts[type];
+}
+
+/**
+ * @brief   The test record read callback.
+ *
+ * @param[in]   cbArg: The record values.
+ * @param[out]  data: The read buffer.
+ * @param[in]   len: The read length.
+ *
+ * @return  The read length.
+ */
+static ssize_t testReadRecord(void *cbArg, void *data, size_t len)
+{
+  memcpy(data, cbArg, len);
+  return testReadLen < 0 ? (ssize_t)len : testReadLen;
+}
+
+/**
+ * @brief   The test failing save for the binary record.
+ *
+ * @param[in]   name: The settings key.
+ * @param[in]   value: The record values.
+ * @param[in]   valLen: The record length.
+ *
+ * @return  -EIO for the binary record, 0 otherwise.
+ */
+static int testSaveBinaryFails(const char *name, const void *value, size_t valLen)
+{
+  ARG_UNUSED(value);
+  ARG_UNUSED(valLen);
+
+  return strcmp(name, "datastore/binary") == 0 ? -EIO : 0;
+}
+
+/**
+ * @brief   The test work flush, completing the ongoing save.
+ *
+ * @param[in]   work: The work item.
+ * @param[in]   sync: The flush synchronization.
+ *
+ * @return  True if the save was ongoing.
+ */
+static bool testFlushOngoingSave(struct k_work *work, struct k_work_sync *sync)
+{
+  ARG_UNUSED(sync);
+
+  if(!atomic_get(&isFlushing))
+    return false;
+
+  /* The periodic save of the stale snapshot completes */
+  work->h(work);
+
+  /* The datapoints changed after the periodic snapshot */
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = BIT(DATAPOINT_UINT);
+
+  return true;
+}
+
+static void nvm_tests_before(void *f)
+{
+  ARG_UNUSED(f);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  journal = NULL;
+  memset(journalOffsets, 0, sizeof(journalOffsets));
+  memset(nvmCounts, 0, sizeof(nvmCounts));
+  stagedTypes = 0;
+  atomic_clear(&retryTypes);
+  atomic_clear(&isFlushing);
+  atomic_clear(&isFlushRequested);
+  lastFlushMs = 0;
+  testReadLen = -1;
+  memset(testJournal, 0, sizeof(testJournal));
+}
+
+/**
+ * @brief   Initialize the NVM persistence with the test journal.
+ */
+static void initTestJournal(void)
+{
+  datastoreUtilGetNvmCount_fake.custom_fake = testGetNvmCount;
+  k_malloc_fake.return_val = testJournal;
+
+  zassert_equal(datastoreNvmInit(), 0, "Init should succeed");
+}
+
+/**
+ * @test The datastoreNvmInit function must lay the journal out per type and
+ * initialize the settings.
+ */
+ZTEST(datastore_nvm_tests, test_init_success)
+{
+  initTestJournal();
+
+  zassert_equal(k_malloc_fake.arg0_val, 3 * sizeof(Data_t), "Journal should hold every persisted value");
+  zassert_equal(journalOffsets[DATAPOINT_BINARY], 0, "Binary should start the journal");
+  zassert_equal(journalOffsets[DATAPOINT_UINT], 2, "Uint should follow the binaries");
+  zassert_equal(settings_subsys_init_fake.call_count, 1, "Settings should be initialized");
+}
+
+/**
+ * @test The datastoreNvmInit function must skip the persistence when no
+ * datapoint is persisted.
+ */
+ZTEST(datastore_nvm_tests, test_init_no_persisted_datapoint)
+{
+  datastoreUtilGetNvmCount_fake.return_val = 0;
+
+  zassert_equal(datastoreNvmInit(), 0, "Init should succeed");
+  zassert_equal(k_malloc_fake.call_count, 0, "No journal should be allocated");
+  zassert_equal(settings_subsys_init_fake.call_count, 0, "Settings should not be initialized");
+}
+
+/**
+ * @test The datastoreNvmInit function must return -ENOMEM when the journal
+ * allocation fails.
+ */
+ZTEST(datastore_nvm_tests, test_init_alloc_failure)
+{
+  datastoreUtilGetNvmCount_fake.custom_fake = testGetNvmCount;
+  k_malloc_fake.return_val = NULL;
+
+  zassert_equal(datastoreNvmInit(), -ENOMEM, "Should return -ENOMEM");
+  zassert_equal(settings_subsys_init_fake.call_count, 0, "Settings should not be initialized");
+}
+
+/**
+ * @test The datastoreNvmInit function must return the error code when the
+ * settings initialization fails.
+ */
+ZTEST(datastore_nvm_tests, test_init_settings_failure)
+{
+  datastoreUtilGetNvmCount_fake.custom_fake = testGetNvmCount;
+  k_malloc_fake.return_val = testJournal;
+  settings_subsys_init_fake.return_val = -EIO;
+
+  zassert_equal(datastoreNvmInit(), -EIO, "Should return the settings error");
+}
+
+/**
+ * @test The datastoreNvmRestore function must load the datastore subtree.
+ */
+ZTEST(datastore_nvm_tests, test_restore_loads_subtree)
+{
+  initTestJournal();
+
+  zassert_equal(datastoreNvmRestore(), 0, "Restore should succeed");
+  zassert_equal(settings_load_subtree_direct_fake.call_count, 1, "Subtree should be loaded");
+  zassert_str_equal(settings_load_subtree_direct_fake.arg0_val, DATASTORE_NVM_SUBTREE, "Should load the datastore subtree");
+  zassert_equal(settings_load_subtree_direct_fake.arg1_val, restoreRecord, "Should restore with the record callback");
+}
+
+/**
+ * @test The datastoreNvmRestore function must do nothing without a journal.
+ */
+ZTEST(datastore_nvm_tests, test_restore_no_journal)
+{
+  zassert_equal(datastoreNvmRestore(), 0, "Restore should succeed");
+  zassert_equal(settings_load_subtree_direct_fake.call_count, 0, "Subtree should not be loaded");
+}
+
+/**
+ * @test The datastoreNvmRestore function must return the error code when the
+ * load fails.
+ */
+ZTEST(datastore_nvm_tests, test_restore_load_failure)
+{
+  initTestJournal();
+  settings_load_subtree_direct_fake.return_val = -EIO;
+
+  zassert_equal(datastoreNvmRestore(), -EIO, "Should return the load error");
+}
+
+/**
+ * @test The restoreRecord function must restore a matching record in its
+ * value type.
+ */
+ZTEST(datastore_nvm_tests, test_restore_record_success)
+{
+  Data_t record[2] = {{.uintVal = true}, {.uintVal = false}};
+
+  initTestJournal();
+
+  zassert_equal(restoreRecord("binary", sizeof(record), testReadRecord, record, NULL), 0, "Should return 0");
+  zassert_equal(datastoreUtilRestoreNvm_fake.call_count, 1, "Values should be restored");
+  zassert_equal(datastoreUtilRestoreNvm_fake.arg0_val, DATAPOINT_BINARY, "Should restore the binaries");
+  zassert_equal(datastoreUtilRestoreNvm_fake.arg2_val, 2, "Should restore every persisted binary");
+  zassert_true(testJournal[0].uintVal, "Journal should hold the record");
+}
+
+/**
+ * @test The restoreRecord function must ignore an unknown key.
+ */
+ZTEST(datastore_nvm_tests, test_restore_record_unknown_key)
+{
+  Data_t record[1] = {{.uintVal = 3}};
+
+  initTestJournal();
+
+  zassert_equal(restoreRecord("unknown", sizeof(record), testReadRecord, record, NULL), 0, "Should continue");
+  zassert_equal(datastoreUtilRestoreNvm_fake.call_count, 0, "No value should be restored");
+}
+
+/**
+ * @test The restoreRecord function must ignore a record not matching the
+ * persisted datapoint layout.
+ */
+ZTEST(datastore_nvm_tests, test_restore_record_length_mismatch)
+{
+  Data_t record[2] = {{.uintVal = 3}, {.uintVal = 4}};
+
+  initTestJournal();
+
+  zassert_equal(restoreRecord("uint", sizeof(record), testReadRecord, record, NULL), 0, "Should continue");
+  zassert_equal(datastoreUtilRestoreNvm_fake.call_count, 0, "No value should be restored");
+}
+
+/**
+ * @test The restoreRecord function must ignore a record that cannot be read.
+ */
+ZTEST(datastore_nvm_tests, test_restore_record_read_failure)
+{
+  Data_t record[1] = {{.uintVal = 3}};
+
+  initTestJournal();
+  testReadLen = 0;
+
+  zassert_equal(restoreRecord("uint", sizeof(record), testReadRecord, record, NULL), 0, "Should continue");
+  zassert_equal(datastoreUtilRestoreNvm_fake.call_count, 0, "No value should be restored");
+}
+
+/**
+ * @test The datastoreNvmProcess function must not flush before the flush
+ * period elapses.
+ */
+ZTEST(datastore_nvm_tests, test_process_period_not_elapsed)
+{
+  initTestJournal();
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = BIT(DATAPOINT_UINT);
+
+  zassert_equal(datastoreNvmProcess(CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS - 1), 0, "Should return 0");
+  zassert_equal(datastoreUtilSnapshotNvm_fake.call_count, 0, "No type should be snapshot");
+  zassert_equal(k_work_submit_mock_fake.call_count, 0, "No save should be submitted");
+}
+
+/**
+ * @test The datastoreNvmProcess function must snapshot the dirty types and
+ * submit the save once the flush period elapses.
+ */
+ZTEST(datastore_nvm_tests, test_process_period_elapsed)
+{
+  initTestJournal();
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = BIT(DATAPOINT_UINT);
+
+  zassert_equal(datastoreNvmProcess(CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS), 0, "Should return 0");
+  zassert_equal(datastoreUtilSnapshotNvm_fake.call_count, 1, "Only the dirty type should be snapshot");
+  zassert_equal(datastoreUtilSnapshotNvm_fake.arg0_val, DATAPOINT_UINT, "Uint should be snapshot");
+  zassert_equal(datastoreUtilSnapshotNvm_fake.arg1_val, testJournal + 2, "Should snapshot at the uint offset");
+  zassert_equal(stagedTypes, BIT(DATAPOINT_UINT), "Uint should be staged");
+  zassert_equal(k_work_submit_mock_fake.call_count, 1, "Save should be submitted");
+  zassert_equal(k_work_submit_mock_fake.arg0_val, &saveWork, "Should submit the save work");
+  zassert_true(atomic_get(&isFlushing), "Flush should be ongoing");
+  zassert_equal(lastFlushMs, CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS, "Flush time should be updated");
+}
+
+/**
+ * @test The datastoreNvmProcess function must not submit a save when nothing
+ * is dirty.
+ */
+ZTEST(datastore_nvm_tests, test_process_nothing_dirty)
+{
+  initTestJournal();
+
+  zassert_equal(datastoreNvmProcess(CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS), 0, "Should return 0");
+  zassert_equal(k_work_submit_mock_fake.call_count, 0, "No save should be submitted");
+  zassert_equal(lastFlushMs, 0, "Flush time should not change");
+}
+
+/**
+ * @test The datastoreNvmProcess function must flush right away when requested.
+ */
+ZTEST(datastore_nvm_tests, test_process_requested)
+{
+  initTestJournal();
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = BIT(DATAPOINT_BINARY);
+
+  datastoreNvmRequestFlush();
+
+  zassert_equal(datastoreNvmProcess(1), 0, "Should return 0");
+  zassert_equal(k_work_submit_mock_fake.call_count, 1, "Save should be submitted");
+  zassert_false(atomic_get(&isFlushRequested), "Request should be consumed");
+}
+
+/**
+ * @test The datastoreNvmProcess function must keep the request pending while
+ * a save is ongoing.
+ */
+ZTEST(datastore_nvm_tests, test_process_requested_while_flushing)
+{
+  initTestJournal();
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = BIT(DATAPOINT_BINARY);
+  atomic_set(&isFlushing, 1);
+
+  datastoreNvmRequestFlush();
+
+  zassert_equal(datastoreNvmProcess(1), 0, "Should return 0");
+  zassert_equal(datastoreUtilSnapshotNvm_fake.call_count, 0, "Journal should not be touched");
+  zassert_equal(k_work_submit_mock_fake.call_count, 0, "No save should be submitted");
+  zassert_true(atomic_get(&isFlushRequested), "Request should stay pending");
+}
+
+/**
+ * @test The datastoreNvmProcess function must include the types of a failed
+ * save in the next flush.
+ */
+ZTEST(datastore_nvm_tests, test_process_retries_failed_types)
+{
+  initTestJournal();
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = BIT(DATAPOINT_UINT);
+  atomic_set(&retryTypes, BIT(DATAPOINT_BINARY));
+
+  zassert_equal(datastoreNvmProcess(CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS), 0, "Should return 0");
+  zassert_equal(datastoreUtilSnapshotNvm_fake.call_count, 2, "Both types should be snapshot");
+  zassert_equal(stagedTypes, BIT(DATAPOINT_BINARY) | BIT(DATAPOINT_UINT), "Both types should be staged");
+  zassert_equal(atomic_get(&retryTypes), 0, "Retry types should be consumed");
+}
+
+/**
+ * @test The datastoreNvmProcess function must return the error code and keep
+ * the types for a retry when the save cannot be submitted.
+ */
+ZTEST(datastore_nvm_tests, test_process_submit_failure)
+{
+  initTestJournal();
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = BIT(DATAPOINT_UINT);
+  k_work_submit_mock_fake.return_val = -EBUSY;
+
+  zassert_equal(datastoreNvmProcess(CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS), -EBUSY, "Should return the submit error");
+  zassert_false(atomic_get(&isFlushing), "Flush should not be ongoing");
+  zassert_equal(atomic_get(&retryTypes), BIT(DATAPOINT_UINT), "Uint should be retried");
+}
+
+/**
+ * @test The datastoreNvmProcess function must do nothing without a journal.
+ */
+ZTEST(datastore_nvm_tests, test_process_no_journal)
+{
+  datastoreNvmRequestFlush();
+
+  zassert_equal(datastoreNvmProcess(CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS), 0, "Should return 0");
+  zassert_equal(datastoreUtilGetNvmDirtyTypes_fake.call_count, 0, "Dirty types should not be read");
+}
+
+/**
+ * @test The saveJournal function must save one record per staged type and
+ * end the flush.
+ */
+ZTEST(datastore_nvm_tests, test_save_journal_success)
+{
+  initTestJournal();
+  stagedTypes = BIT(DATAPOINT_BINARY) | BIT(DATAPOINT_UINT);
+  atomic_set(&isFlushing, 1);
+
+  saveJournal(&saveWork);
+
+  zassert_equal(settings_save_one_fake.call_count, 2, "Both records should be saved");
+  zassert_str_equal(settings_save_one_fake.arg0_history[0], "datastore/binary", "Should save the binary record");
+  zassert_equal(settings_save_one_fake.arg1_history[0], testJournal, "Should save the binary journal");
+  zassert_equal(settings_save_one_fake.arg2_history[0], 2 * sizeof(Data_t), "Should save every persisted binary");
+  zassert_str_equal(settings_save_one_fake.arg0_history[1], "datastore/uint", "Should save the uint record");
+  zassert_equal(settings_save_one_fake.arg1_history[1], testJournal + 2, "Should save the uint journal");
+  zassert_false(atomic_get(&isFlushing), "Flush should be done");
+  zassert_equal(atomic_get(&retryTypes), 0, "No type should be retried");
+}
+
+/**
+ * @test The saveJournal function must mark a type for retry when its record
+ * cannot be saved.
+ */
+ZTEST(datastore_nvm_tests, test_save_journal_failure)
+{
+  initTestJournal();
+  stagedTypes = BIT(DATAPOINT_BINARY) | BIT(DATAPOINT_UINT);
+  atomic_set(&isFlushing, 1);
+  settings_save_one_fake.custom_fake = testSaveBinaryFails;
+
+  saveJournal(&saveWork);
+
+  zassert_equal(settings_save_one_fake.call_count, 2, "Both records should be attempted");
+  zassert_equal(atomic_get(&retryTypes), BIT(DATAPOINT_BINARY), "Binary should be retried");
+  zassert_false(atomic_get(&isFlushing), "Flush should be done");
+}
+
+/**
+ * @test The datastoreNvmFlush function must wait for the ongoing save, then
+ * save the changes made after its snapshot before returning.
+ */
+ZTEST(datastore_nvm_tests, test_flush_while_saving)
+{
+  initTestJournal();
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = BIT(DATAPOINT_BINARY);
+
+  /* A periodic save is ongoing with the binary snapshot */
+  zassert_equal(datastoreNvmProcess(CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS), 0, "Should return 0");
+  zassert_true(atomic_get(&isFlushing), "Save should be ongoing");
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = 0;
+  k_work_flush_mock_fake.custom_fake = testFlushOngoingSave;
+  datastoreNvmRequestFlush();
+
+  zassert_equal(datastoreNvmFlush(CONFIG_ENYA_DATASTORE_NVM_FLUSH_PERIOD_MS + 1), 0, "Should return 0");
+  zassert_equal(k_work_flush_mock_fake.call_count, 1, "Should wait for the ongoing save");
+  zassert_equal(k_work_flush_mock_fake.arg0_val, &saveWork, "Should wait for the save work");
+  zassert_equal(k_work_submit_mock_fake.call_count, 1, "The flush should not be left to the work queue");
+  zassert_equal(settings_save_one_fake.call_count, 2, "Both snapshots should be saved");
+  zassert_str_equal(settings_save_one_fake.arg0_history[0], "datastore/binary", "The ongoing save should end first");
+  zassert_str_equal(settings_save_one_fake.arg0_history[1], "datastore/uint", "The later changes should be saved");
+  zassert_equal(datastoreUtilSnapshotNvm_fake.arg0_history[1], DATAPOINT_UINT, "The later changes should be snapshot");
+  zassert_false(atomic_get(&isFlushing), "Flush should be done");
+  zassert_false(atomic_get(&isFlushRequested), "No request should be left pending");
+}
+
+/**
+ * @test The datastoreNvmFlush function must save nothing without changes.
+ */
+ZTEST(datastore_nvm_tests, test_flush_nothing_dirty)
+{
+  initTestJournal();
+
+  zassert_equal(datastoreNvmFlush(1), 0, "Should return 0");
+  zassert_equal(k_work_flush_mock_fake.call_count, 1, "Should wait for an ongoing save");
+  zassert_equal(settings_save_one_fake.call_count, 0, "Nothing should be saved");
+}
+
+/**
+ * @test The datastoreNvmFlush function must return the save error and keep
+ * the failed type for a retry.
+ */
+ZTEST(datastore_nvm_tests, test_flush_save_failure)
+{
+  initTestJournal();
+  datastoreUtilGetNvmDirtyTypes_fake.return_val = BIT(DATAPOINT_BINARY) | BIT(DATAPOINT_UINT);
+  settings_save_one_fake.custom_fake = testSaveBinaryFails;
+
+  zassert_equal(datastoreNvmFlush(1), -EIO, "Should return the save error");
+  zassert_equal(atomic_get(&retryTypes), BIT(DATAPOINT_BINARY), "Binary should be retried");
+  zassert_false(atomic_get(&isFlushing), "Flush should be done");
+}
+
+/**
+ * @test The datastoreNvmFlush function must do nothing without a journal.
+ */
+ZTEST(datastore_nvm_tests, test_flush_no_journal)
+{
+  zassert_equal(datastoreNvmFlush(1), 0, "Should return 0");
+  zassert_equal(k_work_flush_mock_fake.call_count, 0, "No save should be waited for");
+  zassert_equal(datastoreUtilGetNvmDirtyTypes_fake.call_count, 0, "Dirty types should not be read");
+}
+
+ZTEST_SUITE(datastore_nvm_tests, NULL, NULL, nvm_tests_before, NULL, NULL);
@@ -0,0 +1,428 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Replication Tests
+ *
+ *            Unit tests for the datastore replication.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_DELTA_NOTIFY 1
+#define CONFIG_ENYA_DATASTORE_BATCH 1
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS 2
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES 4
+#define CONFIG_ENYA_DATASTORE_REPLICATION 1
+#define CONFIG_ENYA_DATASTORE_REPLICATION_FRAME_SIZE 16
+#define CONFIG_ENYA_DATASTORE_REPLICATION_PERIOD_MS 20
+#define CONFIG_ENYA_DATASTORE_REPLICATION_RESYNC_PERIOD_MS 1000
+
+/* The test replicated ranges */
+#define DATASTORE_REPLICATION_RANGES \
+  X(DATAPOINT_BINARY, BINARY_FIRST_DATAPOINT, 3) \
+  X(DATAPOINT_FLOAT, FLOAT_FIRST_DATAPOINT, 2) \
+  X(DATAPOINT_UINT, UINT_SECOND_DATAPOINT, 1)
+
+#include "datastore.h"
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(osMemoryPoolFree) \
+  FAKE(datastoreBatch) \
+  FAKE(datastoreSubscribeBinary) \
+  FAKE(datastoreSubscribeButton) \
+  FAKE(datastoreSubscribeFloat) \
+  FAKE(datastoreSubscribeInt) \
+  FAKE(datastoreSubscribeMultiState) \
+  FAKE(datastoreSubscribeUint) \
+  FAKE(datastoreUnsubscribeBinary) \
+  FAKE(datastoreUnsubscribeButton) \
+  FAKE(datastoreUnsubscribeFloat) \
+  FAKE(datastoreUnsubscribeInt) \
+  FAKE(datastoreUnsubscribeMultiState) \
+  FAKE(datastoreUnsubscribeUint) \
+  FAKE(mock_send)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Mock osMemoryPool functions */
+FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+/* Mock datastore functions */
+FAKE_VALUE_FUNC(int, datastoreBatch, DatastoreBatchOp_t *, size_t, struct k_msgq *);
+FAKE_VALUE_FUNC(int, datastoreSubscribeBinary, DatastoreSubEntry_t *);
+FAKE_VALUE_FUNC(int, datastoreSubscribeButton, DatastoreSubEntry_t *);
+FAKE_VALUE_FUNC(int, datastoreSubscribeFloat, DatastoreSubEntry_t *);
+FAKE_VALUE_FUNC(int, datastoreSubscribeInt, DatastoreSubEntry_t *);
+FAKE_VALUE_FUNC(int, datastoreSubscribeMultiState, DatastoreSubEntry_t *);
+FAKE_VALUE_FUNC(int, datastoreSubscribeUint, DatastoreSubEntry_t *);
+FAKE_VALUE_FUNC(int, datastoreUnsubscribeBinary, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUnsubscribeButton, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUnsubscribeFloat, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUnsubscribeInt, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUnsubscribeMultiState, DatastoreSubCb_t);
+FAKE_VALUE_FUNC(int, datastoreUnsubscribeUint, DatastoreSubCb_t);
+
+/* Mock frame send callback */
+FAKE_VALUE_FUNC(int, mock_send, void *, const uint8_t *, size_t);
+
+/* Include replication implementation */
+#include "datastoreReplication.c"
+
+/**
+ * The test send callback argument.
+ */
+#define TEST_CB_ARG                     ((void *)0x2000)
+
+/**
+ * The captured frames.
+ */
+#define MAX_CAPTURED_FRAMES 4
+static uint8_t capturedFrames[MAX_CAPTURED_FRAMES][CONFIG_ENYA_DATASTORE_REPLICATION_FRAME_SIZE];
+static size_t capturedLens[MAX_CAPTURED_FRAMES];
+
+/**
+ * The captured subscription.
+ */
+static DatastoreSubEntry_t capturedSub;
+
+/**
+ * The captured batch operations and values.
+ */
+#define MAX_CAPTURED_BATCHES 4
+static DatastoreBatchOp_t capturedOps[MAX_CAPTURED_BATCHES][CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS];
+static Data_t capturedValues[MAX_CAPTURED_BATCHES][CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES];
+
+/**
+ * The test delta payload buffer.
+ */
+static Data_t payloadBuffer[16];
+
+/**
+ * @brief Custom fake for the send callback capturing the frames.
+ */
+static int mock_send_capture(void *cbArg, const uint8_t *frame, size_t len)
+{
+  ARG_UNUSED(cbArg);
+
+  memcpy(capturedFrames[mock_send_fake.call_count - 1], frame, len);
+  capturedLens[mock_send_fake.call_count - 1] = len;
+  return 0;
+}
+
+/**
+ * @brief Custom fake for datastoreSubscribeFloat capturing the subscription.
+ */
+static int datastoreSubscribeFloat_capture(DatastoreSubEntry_t *sub)
+{
+  capturedSub = *sub;
+  return 0;
+}
+
+/**
+ * @brief Custom fake for datastoreBatch capturing the operations and their values.
+ */
+static int datastoreBatch_capture(DatastoreBatchOp_t *ops, size_t opCount, struct k_msgq *response)
+{
+  size_t valueCount = 0;
+
+  ARG_UNUSED(response);
+
+  for(size_t i = 0; i < opCount; ++i)
+  {
+    capturedOps[datastoreBatch_fake.call_count - 1][i] = ops[i];
+    memcpy(capturedValues[datastoreBatch_fake.call_count - 1] + valueCount, ops[i].values,
+           ops[i].valCount * sizeof(Data_t));
+    valueCount += ops[i].valCount;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Notify the replication of a delta.
+ */
+static void notifyDelta(DatapointType_t type, uint32_t datapointId, size_t valCount, const Data_t values[])
+{
+  SrvMsgPayload_t *payload = (SrvMsgPayload_t *)payloadBuffer;
+  DatastoreDeltaHeader_t header = {.datapointId = datapointId, .valCount = valCount};
+
+  memcpy(payload->data, &header, sizeof(header));
+  memcpy(payload->data + DATASTORE_DELTA_HEADER_LEN, values, valCount * sizeof(Data_t));
+
+  zassert_equal(deltaCallbacks[type](payload, valCount), 0, "The delta callback should succeed");
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void replication_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  mock_send_fake.custom_fake = mock_send_capture;
+  datastoreBatch_fake.custom_fake = datastoreBatch_capture;
+
+  memset(mirror, 0, sizeof(mirror));
+  memset(dirty, 0, sizeof(dirty));
+  memset(&stats, 0, sizeof(stats));
+  sendCallback = NULL;
+  sendCbArg = NULL;
+  txSequence = 0;
+  rxSequence = 0;
+  isRxSynced = false;
+  lastSendMs = 0;
+  lastResyncMs = 0;
+  atomic_clear(&isResyncRequested);
+
+  zassert_equal(datastoreReplicationStart(mock_send, TEST_CB_ARG), 0, "The replication should start");
+}
+
+/**
+ * @test datastoreReplicationStart must subscribe to each range in delta mode.
+ */
+ZTEST(datastore_replication_tests, test_start_subscribe)
+{
+  datastoreSubscribeFloat_fake.custom_fake = datastoreSubscribeFloat_capture;
+
+  zassert_equal(datastoreReplicationStart(mock_send, TEST_CB_ARG), 0, "The replication should start");
+
+  zassert_equal(datastoreSubscribeBinary_fake.call_count, 2, "Each range should be subscribed once per start");
+  zassert_equal(datastoreSubscribeButton_fake.call_count, 0, "A type without range should not be subscribed");
+  zassert_equal(capturedSub.datapointId, FLOAT_FIRST_DATAPOINT, "The range should be subscribed");
+  zassert_equal(capturedSub.valCount, 2, "The range should be subscribed");
+  zassert_true(capturedSub.isDelta, "The subscription should be in delta mode");
+  zassert_equal(capturedSub.callback, onFloatDelta, "The type callback should be used");
+  zassert_equal(rangeOffsets[2], 5, "The mirror offsets should follow the ranges");
+
+  zassert_equal(datastoreReplicationStart(NULL, NULL), -EINVAL, "A missing send callback should fail");
+}
+
+/**
+ * @test datastoreReplicationProcess must send the changed values only, once the period elapsed.
+ */
+ZTEST(datastore_replication_tests, test_process_delta)
+{
+  Data_t first = {.floatVal = 1.0f};
+  Data_t second = {.floatVal = 2.5f};
+
+  zassert_equal(datastoreReplicationProcess(100), 0, "A process without change should succeed");
+  zassert_equal(mock_send_fake.call_count, 0, "Nothing should be sent without change");
+
+  notifyDelta(DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, 1, &first);
+  zassert_equal(datastoreReplicationProcess(100), 0, "The process should succeed");
+
+  zassert_equal(mock_send_fake.call_count, 1, "A single frame should be sent");
+  zassert_equal(mock_send_fake.arg0_val, TEST_CB_ARG, "The callback argument should be passed");
+  zassert_equal(capturedLens[0], DATASTORE_REPLICATION_FRAME_HEADER_LEN + DATASTORE_REPLICATION_RECORD_HEADER_LEN + 4,
+                "The frame should hold a single value");
+  zassert_equal(capturedFrames[0][0], DATASTORE_REPLICATION_VERSION, "The frame should hold the version");
+  zassert_equal(capturedFrames[0][1], 1, "The frame should hold a single record");
+  zassert_equal(sys_get_le16(capturedFrames[0] + 2), 0, "The frame should hold the sequence number");
+  zassert_equal(capturedFrames[0][4], DATAPOINT_FLOAT, "The record should hold the type");
+  zassert_equal(capturedFrames[0][5], 1, "The record should hold the value count");
+  zassert_equal(sys_get_le16(capturedFrames[0] + 6), FLOAT_SECOND_DATAPOINT, "The record should hold the ID");
+  zassert_equal(sys_get_le32(capturedFrames[0] + 8), first.uintVal, "The value should be sent");
+
+  notifyDelta(DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, 1, &first);
+  datastoreReplicationProcess(110);
+  zassert_equal(mock_send_fake.call_count, 1, "The changes should be coalesced for the period");
+
+  notifyDelta(DATAPOINT_FLOAT, FLOAT_SECOND_DATAPOINT, 1, &second);
+  datastoreReplicationProcess(120);
+
+  zassert_equal(mock_send_fake.call_count, 2, "The coalesced changes should take a single frame");
+  zassert_equal(sys_get_le16(capturedFrames[1] + 2), 1, "The sequence number should be incremented");
+  zassert_equal(sys_get_le32(capturedFrames[1] + 8), second.uintVal, "The latest value should be sent");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 3, "The delta payloads should be freed");
+
+  datastoreReplicationProcess(200);
+  zassert_equal(mock_send_fake.call_count, 2, "A sent value should not be sent again");
+}
+
+/**
+ * @test datastoreReplicationProcess must merge a clean gap cheaper than a record header.
+ */
+ZTEST(datastore_replication_tests, test_process_gapMerge)
+{
+  Data_t value = {.uintVal = 1};
+
+  notifyDelta(DATAPOINT_BINARY, BINARY_FIRST_DATAPOINT, 1, &value);
+  notifyDelta(DATAPOINT_BINARY, BINARY_THIRD_DATAPOINT, 1, &value);
+  datastoreReplicationProcess(100);
+
+  zassert_equal(capturedFrames[0][1], 1, "The binaries should share a record");
+  zassert_equal(capturedFrames[0][5], 3, "The clean binary should be merged");
+  zassert_mem_equal(capturedFrames[0] + 8, ((uint8_t[]){1, 0, 1}), 3, "The binaries should take 1 byte");
+}
+
+/**
+ * @test datastoreReplicationProcess must split the full state in sequenced frames.
+ */
+ZTEST(datastore_replication_tests, test_process_resyncFrames)
+{
+  datastoreReplicationRequestResync();
+  zassert_equal(datastoreReplicationProcess(100), 0, "The resync should succeed");
+
+  zassert_equal(stats.resyncCount, 1, "The resync should be counted");
+  zassert_equal(mock_send_fake.call_count, 3, "The full state should take 3 frames");
+  zassert_equal(capturedFrames[0][4], DATAPOINT_BINARY, "The binaries should be first");
+  zassert_equal(capturedFrames[1][4], DATAPOINT_FLOAT, "The floats should follow");
+  zassert_equal(capturedLens[1], CONFIG_ENYA_DATASTORE_REPLICATION_FRAME_SIZE, "The floats should fill a frame");
+  zassert_equal(capturedFrames[2][4], DATAPOINT_UINT, "The range of the unsigned integers should be last");
+  zassert_equal(sys_get_le16(capturedFrames[2] + 6), UINT_SECOND_DATAPOINT, "The range ID should be sent");
+  zassert_equal(sys_get_le16(capturedFrames[2] + 2), 2, "The frames should be sequenced");
+  zassert_equal(stats.txValues, REPLICATED_VALUE_COUNT, "Every value should be sent");
+}
+
+/**
+ * @test datastoreReplicationProcess must resync periodically.
+ */
+ZTEST(datastore_replication_tests, test_process_resyncPeriod)
+{
+  datastoreReplicationProcess(999);
+  zassert_equal(mock_send_fake.call_count, 0, "The resync should wait for its period");
+
+  datastoreReplicationProcess(1000);
+  zassert_equal(mock_send_fake.call_count, 3, "The resync should send the full state");
+  zassert_equal(stats.txFrames, 3, "The frames should be counted");
+}
+
+/**
+ * @test datastoreReplicationProcess must send the values of a frame the link could not take again.
+ */
+ZTEST(datastore_replication_tests, test_process_linkBusy)
+{
+  Data_t value = {.uintVal = 7};
+
+  notifyDelta(DATAPOINT_UINT, UINT_SECOND_DATAPOINT, 1, &value);
+  mock_send_fake.custom_fake = NULL;
+  mock_send_fake.return_val = -EAGAIN;
+
+  zassert_equal(datastoreReplicationProcess(100), 0, "A busy link should not be an error");
+  zassert_true(hasDirty(), "The values should stay dirty");
+
+  mock_send_fake.custom_fake = mock_send_capture;
+  datastoreReplicationProcess(120);
+
+  zassert_equal(mock_send_fake.call_count, 2, "The frame should be sent again");
+  zassert_equal(sys_get_le16(capturedFrames[1] + 2), 0, "The sequence number should be reused");
+  zassert_equal(sys_get_le32(capturedFrames[1] + 8), 7, "The value should be sent again");
+
+  mock_send_fake.custom_fake = NULL;
+  mock_send_fake.return_val = -EIO;
+  notifyDelta(DATAPOINT_UINT, UINT_SECOND_DATAPOINT, 1, &value);
+  zassert_equal(datastoreReplicationProcess(140), -EIO, "A link error should be returned");
+}
+
+/**
+ * @test datastoreReplicationReceive must apply a frame in batches bounded by the batch limits.
+ */
+ZTEST(datastore_replication_tests, test_receive_apply)
+{
+  uint8_t frame[] = {DATASTORE_REPLICATION_VERSION, 2, 5, 0,
+                     DATAPOINT_BINARY, 3, 0, 0, 1, 0, 2,
+                     DATAPOINT_FLOAT, 2, 0, 0, 0, 0, 0x80, 0x3f, 0, 0, 0x20, 0x40};
+
+  zassert_equal(datastoreReplicationReceive(frame, sizeof(frame)), 0, "The frame should be applied");
+
+  zassert_equal(datastoreBatch_fake.call_count, 2, "The values should be split in 2 batches");
+  zassert_is_null(datastoreBatch_fake.arg2_history[0], "The batches should be write-only");
+  zassert_equal(capturedOps[0][0].opType, DATASTORE_BATCH_WRITE, "The records should be written");
+  zassert_equal(capturedOps[0][0].valCount, 3, "The binary record should be whole");
+  zassert_equal(capturedValues[0][2].uintVal, 1, "The binaries should be normalized");
+  zassert_equal(capturedOps[0][1].valCount, 1, "The float record should fill the batch");
+  zassert_equal(capturedValues[0][3].floatVal, 1.0f, "The float should be unpacked");
+  zassert_equal(capturedOps[1][0].datapointId, FLOAT_SECOND_DATAPOINT, "The float record should resume");
+  zassert_equal(capturedValues[1][0].floatVal, 2.5f, "The float should be unpacked");
+  zassert_equal(stats.rxFrames, 1, "The frame should be counted");
+}
+
+/**
+ * @test datastoreReplicationReceive must reject a malformed frame before any write.
+ */
+ZTEST(datastore_replication_tests, test_receive_malformed)
+{
+  uint8_t frame[] = {DATASTORE_REPLICATION_VERSION, 1, 0, 0, DATAPOINT_UINT, 1, 1, 0, 1, 2, 3, 4};
+
+  zassert_equal(datastoreReplicationReceive(frame, sizeof(frame) - 1), -EBADMSG, "A truncated frame should fail");
+  zassert_equal(datastoreReplicationReceive(frame, 3), -EBADMSG, "A truncated header should fail");
+
+  frame[0] = DATASTORE_REPLICATION_VERSION + 1;
+  zassert_equal(datastoreReplicationReceive(frame, sizeof(frame)), -EBADMSG, "A wrong version should fail");
+
+  frame[0] = DATASTORE_REPLICATION_VERSION;
+  frame[6] = UINT_DATAPOINT_COUNT;
+  zassert_equal(datastoreReplicationReceive(frame, sizeof(frame)), -EBADMSG, "An invalid range should fail");
+
+  frame[6] = 1;
+  frame[4] = DATAPOINT_TYPE_COUNT;
+  zassert_equal(datastoreReplicationReceive(frame, sizeof(frame)), -EBADMSG, "An invalid type should fail");
+
+  frame[1] = 0;
+  zassert_equal(datastoreReplicationReceive(frame, sizeof(frame)), -EBADMSG, "Trailing bytes should fail");
+  zassert_equal(datastoreBatch_fake.call_count, 0, "Nothing should be written");
+}
+
+/**
+ * @test datastoreReplicationReceive must count the frames missing from the sequence.
+ */
+ZTEST(datastore_replication_tests, test_receive_sequenceGap)
+{
+  uint8_t frame[] = {DATASTORE_REPLICATION_VERSION, 0, 10, 0};
+
+  datastoreReplicationReceive(frame, sizeof(frame));
+  frame[2] = 11;
+  datastoreReplicationReceive(frame, sizeof(frame));
+  zassert_equal(stats.rxLostFrames, 0, "The first frames should be in sequence");
+
+  frame[2] = 14;
+  datastoreReplicationReceive(frame, sizeof(frame));
+  zassert_equal(stats.rxLostFrames, 2, "The missing frames should be counted");
+  zassert_equal(stats.rxFrames, 3, "The frames should still be applied");
+}
+
+/**
+ * @test datastoreReplicationStop must unsubscribe every range and stop sending.
+ */
+ZTEST(datastore_replication_tests, test_stop)
+{
+  DatastoreReplicationStats_t replicationStats;
+
+  zassert_equal(datastoreReplicationStop(), 0, "The replication should stop");
+
+  zassert_equal(datastoreUnsubscribeBinary_fake.call_count, 1, "Each range should be unsubscribed");
+  zassert_equal(datastoreUnsubscribeFloat_fake.arg0_val, onFloatDelta, "The type callback should be unsubscribed");
+  zassert_equal(datastoreUnsubscribeUint_fake.call_count, 1, "Each range should be unsubscribed");
+
+  datastoreReplicationProcess(5000);
+  zassert_equal(mock_send_fake.call_count, 0, "A stopped replication should not send");
+
+  zassert_equal(datastoreReplicationGetStats(NULL), -EINVAL, "A missing stats buffer should fail");
+  zassert_equal(datastoreReplicationGetStats(&replicationStats), 0, "The stats should be available");
+}
+
+ZTEST_SUITE(datastore_replication_tests, NULL, NULL, replication_tests_before, NULL, NULL);
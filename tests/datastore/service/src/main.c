@@ -18,6 +18,18 @@ DEFINE_FFF_GLOBALS;
 /* Include serviceCommon for Data_t and SrvMsgPayload_t */
 #include "serviceCommon.h"
 
+/* Enable the optional datastore APIs before the datastore header */
+/* CONFIG_ENYA_DATASTORE_DIRECT_READ is defined in Kconfig (default y) */
+#define CONFIG_ENYA_DATASTORE_BATCH 1
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS 4
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES 8
+#define CONFIG_ENYA_DATASTORE_DEFERRED_NOTIFY 1
+#define CONFIG_ENYA_DATASTORE_NVM 1
+#define CONFIG_ENYA_DATASTORE_COMPACT_STORAGE 1
+#define CONFIG_ENYA_DATASTORE_ASYNC 1
+#define CONFIG_POLL 1
+#define CONFIG_ENYA_DATASTORE_STATS 1
+
 /* Include datastore header for types and API */
 #include "datastore.h"
 
@@ -34,12 +46,21 @@ DEFINE_FFF_GLOBALS;
 #define CONFIG_ENYA_DATASTORE_THREAD_PRIORITY    5
 #define CONFIG_ENYA_DATASTORE_SERVICE_PRIORITY   1
 #define CONFIG_ENYA_DATASTORE_HEARTBEAT_INTERVAL_MS 1000
+#define CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES 4
+#define CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT 6
+#define CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES 16
+#define CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_COUNT 2
+#define CONFIG_ENYA_DATASTORE_LARGE_BUFFER_COUNT 2
+#define CONFIG_ENYA_DATASTORE_NOTIFY_BUFFER_COUNT 6
 #define DATASTORE_BUFFER_ALLOC_TIMEOUT 4
 #define DATASTORE_RUN_ITERATIONS 1
 
 /* Prevent util header from being included */
 #define DATASTORE_SRV_UTIL
 
+/* Prevent NVM header from being included */
+#define DATASTORE_SRV_NVM
+
 /* Wrap k_thread_create to use mock */
 #define k_thread_create k_thread_create_mock
 
@@ -58,17 +79,36 @@ DEFINE_FFF_GLOBALS;
 /* Wrap k_current_get to use mock */
 #define k_current_get k_current_get_mock
 
+/* Wrap k_uptime_get to use mock */
+#define k_uptime_get k_uptime_get_mock
+
+/* Wrap k_poll_signal_raise to use mock */
+#define k_poll_signal_raise k_poll_signal_raise_mock
+
+/* Wrap k_cycle_get_32 to use mock */
+#define k_cycle_get_32 k_cycle_get_32_mock
+
+/* Wrap k_cyc_to_us_floor32 to use mock */
+#define k_cyc_to_us_floor32 k_cyc_to_us_floor32_mock
+
 /* Mock function declarations */
 FAKE_VOID_FUNC(k_thread_start_mock, k_tid_t);
 FAKE_VOID_FUNC(k_thread_resume_mock, k_tid_t);
 FAKE_VOID_FUNC(k_thread_suspend_mock, k_tid_t);
 FAKE_VALUE_FUNC(k_tid_t, k_current_get_mock);
+FAKE_VALUE_FUNC(int64_t, k_uptime_get_mock);
+FAKE_VALUE_FUNC(int, k_poll_signal_raise_mock, struct k_poll_signal *, int);
+FAKE_VOID_FUNC(asyncDoneCb, int, void *);
+FAKE_VALUE_FUNC(uint32_t, k_cycle_get_32_mock);
+FAKE_VALUE_FUNC(uint32_t, k_cyc_to_us_floor32_mock, uint32_t);
 FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
 FAKE_VALUE_FUNC(osStatus_t, osMemoryPoolFree, osMemoryPoolId_t, void *);
 FAKE_VALUE_FUNC(osMemoryPoolId_t, osMemoryPoolNew, uint32_t, uint32_t, const osMemoryPoolAttr_t *);
+FAKE_VALUE_FUNC(uint32_t, osMemoryPoolGetCount, osMemoryPoolId_t);
 FAKE_VALUE_FUNC(k_tid_t, k_thread_create_mock, struct k_thread *, k_thread_stack_t *, size_t,
                 k_thread_entry_t, void *, void *, void *, int, uint32_t, k_timeout_t);
 FAKE_VALUE_FUNC(int, k_thread_name_set_mock, k_tid_t, const char *);
+FAKE_VOID_FUNC(datastoreUtilInitDatapoints);
 FAKE_VALUE_FUNC(int, datastoreUtilAllocateBinarySubs, size_t);
 FAKE_VALUE_FUNC(int, datastoreUtilAllocateButtonSubs, size_t);
 FAKE_VALUE_FUNC(int, datastoreUtilAllocateFloatSubs, size_t);
@@ -77,7 +117,17 @@ FAKE_VALUE_FUNC(int, datastoreUtilAllocateMultiStateSubs, size_t);
 FAKE_VALUE_FUNC(int, datastoreUtilAllocateUintSubs, size_t);
 FAKE_VALUE_FUNC(size_t, datastoreUtilCalculateBufferSize, size_t *);
 FAKE_VALUE_FUNC(int, datastoreUtilRead, DatapointType_t, uint32_t, size_t, Data_t *);
+FAKE_VALUE_FUNC(int, datastoreUtilDirectRead, DatapointType_t, uint32_t, size_t, Data_t *);
 FAKE_VALUE_FUNC(int, datastoreUtilWrite, DatapointType_t, uint32_t, Data_t *, size_t, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilApplyBatch, Data_t *, size_t, osMemoryPoolId_t);
+FAKE_VALUE_FUNC(int, datastoreUtilFlushNotify, int64_t, osMemoryPoolId_t);
+FAKE_VOID_FUNC(datastoreUtilGetNotifyStats, DatastoreStats_t *);
+FAKE_VOID_FUNC(datastoreUtilResetNotifyStats);
+FAKE_VALUE_FUNC(int, datastoreNvmInit);
+FAKE_VALUE_FUNC(int, datastoreNvmRestore);
+FAKE_VALUE_FUNC(int, datastoreNvmProcess, int64_t);
+FAKE_VOID_FUNC(datastoreNvmRequestFlush);
+FAKE_VALUE_FUNC(int, datastoreNvmFlush, int64_t);
 FAKE_VALUE_FUNC(int, datastoreUtilAddBinarySub, DatastoreSubEntry_t *, osMemoryPoolId_t);
 FAKE_VALUE_FUNC(int, datastoreUtilRemoveBinarySub, DatastoreSubCb_t);
 FAKE_VALUE_FUNC(int, datastoreUtilSetBinarySubPauseState, DatastoreSubCb_t, bool, osMemoryPoolId_t);
@@ -102,14 +152,21 @@ FAKE_VALUE_FUNC(int, datastoreUtilSetUintSubPauseState, DatastoreSubCb_t, bool,
   FAKE(k_thread_resume_mock) \
   FAKE(k_thread_suspend_mock) \
   FAKE(k_current_get_mock) \
+  FAKE(k_uptime_get_mock) \
+  FAKE(k_poll_signal_raise_mock) \
+  FAKE(asyncDoneCb) \
+  FAKE(k_cycle_get_32_mock) \
+  FAKE(k_cyc_to_us_floor32_mock) \
   FAKE(serviceManagerRegisterSrv) \
   FAKE(serviceManagerConfirmState) \
   FAKE(serviceManagerUpdateHeartbeat) \
   FAKE(osMemoryPoolAlloc) \
   FAKE(osMemoryPoolFree) \
   FAKE(osMemoryPoolNew) \
+  FAKE(osMemoryPoolGetCount) \
   FAKE(k_thread_create_mock) \
   FAKE(k_thread_name_set_mock) \
+  FAKE(datastoreUtilInitDatapoints) \
   FAKE(datastoreUtilAllocateBinarySubs) \
   FAKE(datastoreUtilAllocateButtonSubs) \
   FAKE(datastoreUtilAllocateFloatSubs) \
@@ -118,7 +175,17 @@ FAKE_VALUE_FUNC(int, datastoreUtilSetUintSubPauseState, DatastoreSubCb_t, bool,
   FAKE(datastoreUtilAllocateUintSubs) \
   FAKE(datastoreUtilCalculateBufferSize) \
   FAKE(datastoreUtilRead) \
+  FAKE(datastoreUtilDirectRead) \
   FAKE(datastoreUtilWrite) \
+  FAKE(datastoreUtilApplyBatch) \
+  FAKE(datastoreUtilFlushNotify) \
+  FAKE(datastoreUtilGetNotifyStats) \
+  FAKE(datastoreUtilResetNotifyStats) \
+  FAKE(datastoreNvmInit) \
+  FAKE(datastoreNvmRestore) \
+  FAKE(datastoreNvmProcess) \
+  FAKE(datastoreNvmRequestFlush) \
+  FAKE(datastoreNvmFlush) \
   FAKE(datastoreUtilAddBinarySub) \
   FAKE(datastoreUtilRemoveBinarySub) \
   FAKE(datastoreUtilSetBinarySubPauseState) \
@@ -161,7 +228,7 @@ typedef struct
   k_tid_t threadId;
   ServicePriority_t priority;
   uint32_t heartbeatIntervalMs;
-  int64_t lastHeartbeatMs;
+  atomic_t lastHeartbeatMs;
   uint8_t missedHeartbeats;
   ServiceState_t state;
   int (*start)(void);
@@ -170,14 +237,21 @@ typedef struct
   int (*resume)(void);
 } ServiceDescriptor_t;
 
-FAKE_VALUE_FUNC(int, serviceManagerRegisterSrv, const ServiceDescriptor_t *);
-FAKE_VALUE_FUNC(int, serviceManagerConfirmState, k_tid_t, ServiceState_t);
-FAKE_VALUE_FUNC(int, serviceManagerUpdateHeartbeat, k_tid_t);
+/* Provide ServiceHandle_t definition */
+typedef size_t ServiceHandle_t;
+
+#define TEST_SERVICE_HANDLE 3
+
+FAKE_VALUE_FUNC(int, serviceManagerRegisterSrv, const ServiceDescriptor_t *, ServiceHandle_t *);
+FAKE_VALUE_FUNC(int, serviceManagerConfirmState, ServiceHandle_t, ServiceState_t);
+FAKE_VALUE_FUNC(int, serviceManagerUpdateHeartbeat, ServiceHandle_t);
 
 static ServiceDescriptor_t captured_descriptor;
 
-static int serviceManagerRegisterSrv_capture(const ServiceDescriptor_t *descriptor)
+static int serviceManagerRegisterSrv_capture(const ServiceDescriptor_t *descriptor, ServiceHandle_t *handle)
 {
+  if(handle)
+    *handle = TEST_SERVICE_HANDLE;
   captured_descriptor = *descriptor;
   return serviceManagerRegisterSrv_fake.return_val;
 }
@@ -197,6 +271,20 @@ static void datastore_tests_before(void *f)
   FFF_RESET_HISTORY();
 
   serviceManagerRegisterSrv_fake.custom_fake = serviceManagerRegisterSrv_capture;
+  serviceHandle = TEST_SERVICE_HANDLE;
+
+  /* Make direct reads collide by default so reads use the queue path */
+  datastoreUtilDirectRead_fake.return_val = -EAGAIN;
+
+  /* Give each buffer pool its own ID and clear its high water */
+  for(uint32_t i = 0; i < DATASTORE_POOL_COUNT; ++i)
+  {
+    bufferPools[i].id = (osMemoryPoolId_t)(0x1000 + i * 0x100);
+    atomic_clear(&bufferPools[i].highWater);
+  }
+
+  /* Clear the datastore statistics */
+  memset(&datastoreStats, 0, sizeof(datastoreStats));
 
   /* Purge the datastore queue to ensure clean state between tests */
   k_msgq_purge(&datastoreQueue);
@@ -225,7 +313,7 @@ ZTEST(datastore_tests, test_run_kmsgq_get_timeout)
  */
 ZTEST(datastore_tests, test_run_unsupported_msgtype)
 {
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   int ret;
 
   /* Setup message with unsupported message type */
@@ -258,8 +346,8 @@ ZTEST(datastore_tests, test_run_unsupported_msgtype)
  */
 ZTEST(datastore_tests, test_run_response_put_failure)
 {
-  DatastoreMsg_t msg;
-  SrvMsgPayload_t payload;
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
   int ret;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
@@ -280,7 +368,7 @@ ZTEST(datastore_tests, test_run_response_put_failure)
   msg.datapointType = DATAPOINT_UINT;
   msg.datapointId = 3;
   msg.valCount = 1;
-  msg.payload = &payload;
+  msg.payload = &request.payload;
   msg.response = &responseQueue;
 
   /* Put message in queue */
@@ -305,14 +393,84 @@ ZTEST(datastore_tests, test_run_response_put_failure)
   zassert_equal(ret, -ENOMSG, "Response queue should be empty after getting dummy value");
 }
 
+/**
+ * @test  The run function must apply a BATCH message and free the buffer when
+ *        there is no response queue.
+ */
+ZTEST(datastore_tests, test_run_batch_no_response)
+{
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
+  int ret;
+
+  datastoreUtilApplyBatch_fake.return_val = 0;
+
+  msg.msgType = DATASTORE_BATCH;
+  msg.valCount = 3;
+  msg.payload = &request.payload;
+  msg.response = NULL;
+  request.payload.poolId = (osMemoryPoolId_t)0x2000;
+
+  ret = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put message in queue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilApplyBatch_fake.call_count, 1,
+                "datastoreUtilApplyBatch should be called once");
+  zassert_equal(datastoreUtilApplyBatch_fake.arg0_val, request.payload.data,
+                "datastoreUtilApplyBatch should be called with the payload data");
+  zassert_equal(datastoreUtilApplyBatch_fake.arg1_val, 3,
+                "datastoreUtilApplyBatch should be called with the operation count");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once");
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, request.payload.poolId,
+                "osMemoryPoolFree should be called with the payload pool");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, &request,
+                "osMemoryPoolFree should be called with the payload");
+}
+
+/**
+ * @test  The run function must apply a BATCH message, respond with the result
+ *        and leave the buffer to the caller when there is a response queue.
+ */
+ZTEST(datastore_tests, test_run_batch_with_response)
+{
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  int response;
+  int ret;
+
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  datastoreUtilApplyBatch_fake.return_val = -EINVAL;
+
+  msg.msgType = DATASTORE_BATCH;
+  msg.valCount = 1;
+  msg.payload = &request.payload;
+  msg.response = &responseQueue;
+
+  ret = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put message in queue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "osMemoryPoolFree should not be called when the caller waits for the response");
+  ret = k_msgq_get(&responseQueue, &response, K_NO_WAIT);
+  zassert_equal(ret, 0, "A response should be sent");
+  zassert_equal(response, -EINVAL, "The response should be the batch result");
+}
+
 /**
  * @test  The run function must successfully process a READ message and call
  *        datastoreUtilRead with the correct parameters.
  */
 ZTEST(datastore_tests, test_run_read_success)
 {
-  DatastoreMsg_t msg;
-  SrvMsgPayload_t payload;
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
   int ret;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
@@ -328,7 +486,7 @@ ZTEST(datastore_tests, test_run_read_success)
   msg.datapointType = DATAPOINT_BINARY;
   msg.datapointId = 5;
   msg.valCount = 1;
-  msg.payload = &payload;
+  msg.payload = &request.payload;
   msg.response = &responseQueue;
 
   /* Put message in queue */
@@ -347,7 +505,7 @@ ZTEST(datastore_tests, test_run_read_success)
                 "datastoreUtilRead called with wrong datapoint ID");
   zassert_equal(datastoreUtilRead_fake.arg2_val, 1,
                 "datastoreUtilRead called with wrong value count");
-  zassert_equal(datastoreUtilRead_fake.arg3_val, payload.data,
+  zassert_equal(datastoreUtilRead_fake.arg3_val, request.payload.data,
                 "datastoreUtilRead called with wrong data pointer");
 
   /* Verify response was sent */
@@ -361,17 +519,16 @@ ZTEST(datastore_tests, test_run_read_success)
 
 /**
  * @test  The run function must successfully process a WRITE message, call
- *        datastoreUtilWrite with the correct parameters, and free the payload
- *        memory pool.
+ *        datastoreUtilWrite with the correct parameters, and leave the payload
+ *        to the caller waiting for the response.
  */
 ZTEST(datastore_tests, test_run_write_success)
 {
-  DatastoreMsg_t msg;
-  SrvMsgPayload_t payload;
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
   int ret;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  osMemoryPoolId_t mockPoolId = (osMemoryPoolId_t)0x12345678;
 
   /* Initialize response queue */
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
@@ -379,16 +536,12 @@ ZTEST(datastore_tests, test_run_write_success)
   /* Configure datastoreUtilWrite to succeed */
   datastoreUtilWrite_fake.return_val = 0;
 
-  /* Configure osMemoryPoolFree to succeed */
-  osMemoryPoolFree_fake.return_val = osOK;
-
   /* Setup WRITE message */
   msg.msgType = DATASTORE_WRITE;
   msg.datapointType = DATAPOINT_FLOAT;
   msg.datapointId = 10;
   msg.valCount = 2;
-  msg.payload = &payload;
-  msg.payload->poolId = mockPoolId;
+  msg.payload = &request.payload;
   msg.response = &responseQueue;
 
   /* Put message in queue */
@@ -405,26 +558,173 @@ ZTEST(datastore_tests, test_run_write_success)
                 "datastoreUtilWrite called with wrong datapoint type");
   zassert_equal(datastoreUtilWrite_fake.arg1_val, 10,
                 "datastoreUtilWrite called with wrong datapoint ID");
-  zassert_equal(datastoreUtilWrite_fake.arg2_val, payload.data,
+  zassert_equal(datastoreUtilWrite_fake.arg2_val, request.payload.data,
                 "datastoreUtilWrite called with wrong data pointer");
   zassert_equal(datastoreUtilWrite_fake.arg3_val, 2,
                 "datastoreUtilWrite called with wrong value count");
-  zassert_equal(datastoreUtilWrite_fake.arg4_val, bufferPool,
+  zassert_equal(datastoreUtilWrite_fake.arg4_val, DATASTORE_NOTIFY_POOL,
                 "datastoreUtilWrite called with wrong buffer pool");
 
-  /* Verify osMemoryPoolFree was called to free the payload */
-  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
-                "osMemoryPoolFree should be called once for WRITE operations");
-  zassert_equal(osMemoryPoolFree_fake.arg0_val, mockPoolId,
-                "osMemoryPoolFree called with wrong pool ID");
-  zassert_equal(osMemoryPoolFree_fake.arg1_val, &payload,
-                "osMemoryPoolFree called with wrong payload pointer");
+  /* Verify the payload is left to the caller */
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "osMemoryPoolFree should not be called when the caller waits for the response");
+  zassert_equal(atomic_get(&request.state), DATASTORE_REQUEST_DONE,
+                "the request should be marked done");
 
   /* Verify response was sent */
   ret = k_msgq_get(&responseQueue, &ret, K_NO_WAIT);
   zassert_equal(ret, 0, "Response should be available in response queue");
 }
 
+/**
+ * @test  The run function must free the buffer of a READ request whose caller
+ *        gave up waiting, without responding.
+ */
+ZTEST(datastore_tests, test_run_read_abandoned)
+{
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  int response;
+  int ret;
+
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  atomic_set(&request.state, DATASTORE_REQUEST_ABANDONED);
+  request.payload.poolId = (osMemoryPoolId_t)0x1000;
+
+  msg.msgType = DATASTORE_READ;
+  msg.valCount = 1;
+  msg.payload = &request.payload;
+  msg.response = &responseQueue;
+
+  ret = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put message in queue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilRead_fake.call_count, 1,
+                "datastoreUtilRead should be called once");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once for an abandoned request");
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, request.payload.poolId,
+                "osMemoryPoolFree should be called with the payload pool");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, &request,
+                "osMemoryPoolFree should be called with the request buffer");
+  ret = k_msgq_get(&responseQueue, &response, K_NO_WAIT);
+  zassert_equal(ret, -ENOMSG, "No response should be sent for an abandoned request");
+}
+
+/**
+ * @test  The run function must apply a WRITE request whose caller gave up
+ *        waiting, free its buffer and not respond.
+ */
+ZTEST(datastore_tests, test_run_write_abandoned)
+{
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  int response;
+  int ret;
+
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  atomic_set(&request.state, DATASTORE_REQUEST_ABANDONED);
+
+  msg.msgType = DATASTORE_WRITE;
+  msg.valCount = 1;
+  msg.payload = &request.payload;
+  msg.response = &responseQueue;
+
+  ret = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put message in queue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilWrite_fake.call_count, 1,
+                "datastoreUtilWrite should be called once");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once for an abandoned request");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, &request,
+                "osMemoryPoolFree should be called with the request buffer");
+  ret = k_msgq_get(&responseQueue, &response, K_NO_WAIT);
+  zassert_equal(ret, -ENOMSG, "No response should be sent for an abandoned request");
+}
+
+/**
+ * @test  The run function must read an asynchronous READ straight into the
+ *        caller buffer and call its completion callback.
+ */
+ZTEST(datastore_tests, test_run_read_async)
+{
+  DatastoreMsg_t msg = {0};
+  Data_t values[2];
+  int userData;
+  int ret;
+
+  datastoreUtilRead_fake.return_val = -EINVAL;
+
+  msg.msgType = DATASTORE_READ;
+  msg.datapointType = DATAPOINT_UINT;
+  msg.datapointId = 3;
+  msg.valCount = 2;
+  msg.values = values;
+  msg.done = asyncDoneCb;
+  msg.userData = &userData;
+
+  ret = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put message in queue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilRead_fake.call_count, 1,
+                "datastoreUtilRead should be called once");
+  zassert_equal(datastoreUtilRead_fake.arg3_val, values,
+                "datastoreUtilRead should read into the caller buffer");
+  zassert_equal(asyncDoneCb_fake.call_count, 1,
+                "the completion callback should be called once");
+  zassert_equal(asyncDoneCb_fake.arg0_val, -EINVAL,
+                "the completion callback should get the read status");
+  zassert_equal(asyncDoneCb_fake.arg1_val, &userData,
+                "the completion callback should get its user data");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "osMemoryPoolFree should not be called for an asynchronous read");
+}
+
+/**
+ * @test  The run function must free the buffer of an asynchronous WRITE and
+ *        call its completion callback.
+ */
+ZTEST(datastore_tests, test_run_write_async)
+{
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
+  int ret;
+
+  datastoreUtilWrite_fake.return_val = 0;
+
+  msg.msgType = DATASTORE_WRITE;
+  msg.valCount = 1;
+  msg.payload = &request.payload;
+  msg.done = asyncDoneCb;
+
+  ret = k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put message in queue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilWrite_fake.call_count, 1,
+                "datastoreUtilWrite should be called once");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, &request,
+                "osMemoryPoolFree should be called with the request buffer");
+  zassert_equal(asyncDoneCb_fake.call_count, 1,
+                "the completion callback should be called once");
+  zassert_equal(asyncDoneCb_fake.arg0_val, 0,
+                "the completion callback should get the write status");
+}
+
 /**
  * @test  The run function must successfully process a WRITE message without a
  *        response queue, call datastoreUtilWrite, and free the payload memory
@@ -432,8 +732,8 @@ ZTEST(datastore_tests, test_run_write_success)
  */
 ZTEST(datastore_tests, test_run_write_no_response)
 {
-  DatastoreMsg_t msg;
-  SrvMsgPayload_t payload;
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
   int ret;
   osMemoryPoolId_t mockPoolId = (osMemoryPoolId_t)0x87654321;
 
@@ -448,7 +748,7 @@ ZTEST(datastore_tests, test_run_write_no_response)
   msg.datapointType = DATAPOINT_INT;
   msg.datapointId = 7;
   msg.valCount = 1;
-  msg.payload = &payload;
+  msg.payload = &request.payload;
   msg.payload->poolId = mockPoolId;
   msg.response = NULL;  /* No response queue */
 
@@ -466,11 +766,11 @@ ZTEST(datastore_tests, test_run_write_no_response)
                 "datastoreUtilWrite called with wrong datapoint type");
   zassert_equal(datastoreUtilWrite_fake.arg1_val, 7,
                 "datastoreUtilWrite called with wrong datapoint ID");
-  zassert_equal(datastoreUtilWrite_fake.arg2_val, payload.data,
+  zassert_equal(datastoreUtilWrite_fake.arg2_val, request.payload.data,
                 "datastoreUtilWrite called with wrong data pointer");
   zassert_equal(datastoreUtilWrite_fake.arg3_val, 1,
                 "datastoreUtilWrite called with wrong value count");
-  zassert_equal(datastoreUtilWrite_fake.arg4_val, bufferPool,
+  zassert_equal(datastoreUtilWrite_fake.arg4_val, DATASTORE_NOTIFY_POOL,
                 "datastoreUtilWrite called with wrong buffer pool");
 
   /* Verify osMemoryPoolFree was called to free the payload */
@@ -478,7 +778,7 @@ ZTEST(datastore_tests, test_run_write_no_response)
                 "osMemoryPoolFree should be called once for WRITE operations");
   zassert_equal(osMemoryPoolFree_fake.arg0_val, mockPoolId,
                 "osMemoryPoolFree called with wrong pool ID");
-  zassert_equal(osMemoryPoolFree_fake.arg1_val, &payload,
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, &request,
                 "osMemoryPoolFree called with wrong payload pointer");
 
   /* No response should be sent since msg.response is NULL */
@@ -490,8 +790,8 @@ ZTEST(datastore_tests, test_run_write_no_response)
  */
 ZTEST(datastore_tests, test_run_message_updates_heartbeat)
 {
-  DatastoreMsg_t msg;
-  SrvMsgPayload_t payload;
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
   k_tid_t mockTid = (k_tid_t)0x1234;
 
   k_current_get_mock_fake.return_val = mockTid;
@@ -500,7 +800,7 @@ ZTEST(datastore_tests, test_run_message_updates_heartbeat)
   msg.datapointType = DATAPOINT_UINT;
   msg.datapointId = 1;
   msg.valCount = 1;
-  msg.payload = &payload;
+  msg.payload = &request.payload;
   msg.response = NULL;
 
   k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
@@ -508,8 +808,187 @@ ZTEST(datastore_tests, test_run_message_updates_heartbeat)
 
   zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, 1,
                 "serviceManagerUpdateHeartbeat should be called once after processing a message");
-  zassert_equal(serviceManagerUpdateHeartbeat_fake.arg0_val, mockTid,
-                "serviceManagerUpdateHeartbeat should be called with the current thread ID");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.arg0_val, TEST_SERVICE_HANDLE,
+                "serviceManagerUpdateHeartbeat should be called with the service handle");
+}
+
+/**
+ * @test  The run function must flush the deferred notifications with the
+ *        current uptime on each iteration.
+ */
+ZTEST(datastore_tests, test_run_flushes_notifications)
+{
+  k_uptime_get_mock_fake.return_val = 1234;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilFlushNotify_fake.call_count, 1,
+                "datastoreUtilFlushNotify should be called once per iteration");
+  zassert_equal(datastoreUtilFlushNotify_fake.arg0_val, 1234,
+                "datastoreUtilFlushNotify should be called with the current uptime");
+  zassert_equal(datastoreUtilFlushNotify_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilFlushNotify should be called with the notification pool");
+}
+
+/**
+ * @test  The run function must keep updating the heartbeat when the
+ *        notification flush fails.
+ */
+ZTEST(datastore_tests, test_run_flush_notifications_failure)
+{
+  datastoreUtilFlushNotify_fake.return_val = -ENOSPC;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreUtilFlushNotify_fake.call_count, 1,
+                "datastoreUtilFlushNotify should be called");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, 1,
+                "serviceManagerUpdateHeartbeat should be called after a flush failure");
+}
+
+/**
+ * @test  The run function must restore the persisted datapoints before
+ *        processing messages.
+ */
+ZTEST(datastore_tests, test_run_restores_nvm)
+{
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreNvmRestore_fake.call_count, 1,
+                "datastoreNvmRestore should be called once on start");
+}
+
+/**
+ * @brief   The NVM restore count when the running state got confirmed.
+ */
+static unsigned int restoreCountAtConfirm;
+
+/**
+ * @brief   Record the NVM restore count at the running state confirmation.
+ */
+static int serviceManagerConfirmState_recordRestore(ServiceHandle_t handle, ServiceState_t state)
+{
+  ARG_UNUSED(handle);
+
+  if(state == SVC_STATE_RUNNING)
+    restoreCountAtConfirm = datastoreNvmRestore_fake.call_count;
+
+  return 0;
+}
+
+/**
+ * @test  The run function must confirm its running state once the persisted
+ *        datapoints are restored, starting the services depending on it.
+ */
+ZTEST(datastore_tests, test_run_confirms_running_after_restore)
+{
+  restoreCountAtConfirm = 0;
+  serviceManagerConfirmState_fake.custom_fake = serviceManagerConfirmState_recordRestore;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
+                "serviceManagerConfirmState should be called once");
+  zassert_equal(serviceManagerConfirmState_fake.arg0_val, TEST_SERVICE_HANDLE,
+                "serviceManagerConfirmState should be called with the service handle");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_RUNNING,
+                "serviceManagerConfirmState should be called with SVC_STATE_RUNNING");
+  zassert_equal(restoreCountAtConfirm, 1, "The running state should be confirmed after the NVM restore");
+}
+
+/**
+ * @test  The run function must keep running when the NVM restore fails.
+ */
+ZTEST(datastore_tests, test_run_restore_nvm_failure)
+{
+  datastoreNvmRestore_fake.return_val = -EIO;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, 1,
+                "serviceManagerUpdateHeartbeat should be called after a restore failure");
+}
+
+/**
+ * @test  The run function must process the NVM journal with the current
+ *        uptime on each iteration.
+ */
+ZTEST(datastore_tests, test_run_processes_nvm)
+{
+  k_uptime_get_mock_fake.return_val = 4321;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreNvmProcess_fake.call_count, 1,
+                "datastoreNvmProcess should be called once per iteration");
+  zassert_equal(datastoreNvmProcess_fake.arg0_val, 4321,
+                "datastoreNvmProcess should be called with the current uptime");
+  zassert_equal(datastoreNvmRequestFlush_fake.call_count, 0,
+                "datastoreNvmRequestFlush should not be called without a stop or suspend");
+}
+
+/**
+ * @brief   The state confirmation count seen by the NVM journal flush.
+ */
+static unsigned int confirmCountAtNvmFlush;
+
+/**
+ * @brief   Custom fake for datastoreNvmFlush recording the state confirmations done before it.
+ */
+static int datastoreNvmFlush_recordConfirm(int64_t now)
+{
+  ARG_UNUSED(now);
+
+  confirmCountAtNvmFlush = serviceManagerConfirmState_fake.call_count;
+
+  return 0;
+}
+
+/**
+ * @test  The run function must flush the NVM journal on DATASTORE_STOP
+ *        before confirming the STOPPED state.
+ */
+ZTEST(datastore_tests, test_run_stop_flushes_nvm)
+{
+  DatastoreMsg_t msg = {0};
+
+  msg.msgType = DATASTORE_STOP;
+  k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  k_uptime_get_mock_fake.return_val = 4321;
+  datastoreNvmFlush_fake.custom_fake = datastoreNvmFlush_recordConfirm;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreNvmFlush_fake.call_count, 1,
+                "datastoreNvmFlush should be called on STOP");
+  zassert_equal(datastoreNvmFlush_fake.arg0_val, 4321,
+                "datastoreNvmFlush should be called with the current uptime");
+  zassert_equal(confirmCountAtNvmFlush, serviceManagerConfirmState_fake.call_count - 1,
+                "The journal should be flushed before the STOPPED confirmation");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_STOPPED,
+                "The STOPPED state should be confirmed last");
+}
+
+/**
+ * @test  The run function must flush the NVM journal on DATASTORE_SUSPEND
+ *        before confirming the SUSPENDED state.
+ */
+ZTEST(datastore_tests, test_run_suspend_flushes_nvm)
+{
+  DatastoreMsg_t msg = {0};
+
+  msg.msgType = DATASTORE_SUSPEND;
+  k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT);
+  datastoreNvmFlush_fake.custom_fake = datastoreNvmFlush_recordConfirm;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(datastoreNvmFlush_fake.call_count, 1,
+                "datastoreNvmFlush should be called on SUSPEND");
+  zassert_equal(confirmCountAtNvmFlush, serviceManagerConfirmState_fake.call_count - 1,
+                "The journal should be flushed before the SUSPENDED confirmation");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_SUSPENDED,
+                "The SUSPENDED state should be confirmed last");
 }
 
 /**
@@ -518,7 +997,7 @@ ZTEST(datastore_tests, test_run_message_updates_heartbeat)
  */
 ZTEST(datastore_tests, test_run_stop_confirms_state)
 {
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   k_tid_t mockTid = (k_tid_t)0x5678;
 
   msg.msgType = DATASTORE_STOP;
@@ -527,10 +1006,12 @@ ZTEST(datastore_tests, test_run_stop_confirms_state)
 
   run(NULL, NULL, NULL);
 
-  zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
-                "serviceManagerConfirmState should be called once");
-  zassert_equal(serviceManagerConfirmState_fake.arg0_val, mockTid,
-                "serviceManagerConfirmState should be called with current thread ID");
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 2,
+                "serviceManagerConfirmState should be called twice");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_history[0], SVC_STATE_RUNNING,
+                "serviceManagerConfirmState should first be called with SVC_STATE_RUNNING");
+  zassert_equal(serviceManagerConfirmState_fake.arg0_val, TEST_SERVICE_HANDLE,
+                "serviceManagerConfirmState should be called with the service handle");
   zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_STOPPED,
                 "serviceManagerConfirmState should be called with SVC_STATE_STOPPED");
   zassert_equal(k_thread_suspend_mock_fake.call_count, 0,
@@ -545,7 +1026,7 @@ ZTEST(datastore_tests, test_run_stop_confirms_state)
  */
 ZTEST(datastore_tests, test_run_suspend_confirms_state)
 {
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   k_tid_t mockTid = (k_tid_t)0x5678;
 
   msg.msgType = DATASTORE_SUSPEND;
@@ -554,10 +1035,12 @@ ZTEST(datastore_tests, test_run_suspend_confirms_state)
 
   run(NULL, NULL, NULL);
 
-  zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
-                "serviceManagerConfirmState should be called once");
-  zassert_equal(serviceManagerConfirmState_fake.arg0_val, mockTid,
-                "serviceManagerConfirmState should be called with current thread ID");
+  zassert_equal(serviceManagerConfirmState_fake.call_count, 2,
+                "serviceManagerConfirmState should be called twice");
+  zassert_equal(serviceManagerConfirmState_fake.arg1_history[0], SVC_STATE_RUNNING,
+                "serviceManagerConfirmState should first be called with SVC_STATE_RUNNING");
+  zassert_equal(serviceManagerConfirmState_fake.arg0_val, TEST_SERVICE_HANDLE,
+                "serviceManagerConfirmState should be called with the service handle");
   zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_SUSPENDED,
                 "serviceManagerConfirmState should be called with SVC_STATE_SUSPENDED");
   zassert_equal(k_thread_suspend_mock_fake.call_count, 1,
@@ -566,8 +1049,8 @@ ZTEST(datastore_tests, test_run_suspend_confirms_state)
                 "k_thread_suspend should be called with current thread ID");
   zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, 1,
                 "serviceManagerUpdateHeartbeat should be called after SUSPEND");
-  zassert_equal(serviceManagerUpdateHeartbeat_fake.arg0_val, mockTid,
-                "serviceManagerUpdateHeartbeat should be called with current thread ID");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.arg0_val, TEST_SERVICE_HANDLE,
+                "serviceManagerUpdateHeartbeat should be called with the service handle");
 }
 
 /**
@@ -609,7 +1092,7 @@ ZTEST(datastore_tests, test_onStop_msgq_put_failure)
  */
 ZTEST(datastore_tests, test_onStop_success)
 {
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   int ret;
   int err;
 
@@ -646,7 +1129,7 @@ ZTEST(datastore_tests, test_onSuspend_msgq_put_failure)
  */
 ZTEST(datastore_tests, test_onSuspend_success)
 {
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   int ret;
   int err;
 
@@ -902,12 +1385,39 @@ ZTEST(datastore_tests, test_init_uint_subs_alloc_failure)
 }
 
 /**
- * @test  The datastoreInit function must return an error when
- *        osMemoryPoolNew fails to create the buffer pool.
+ * @test  The datastoreInit function must return an error when the NVM
+ *        persistence initialization fails.
  */
-ZTEST(datastore_tests, test_init_buffer_pool_alloc_failure)
+ZTEST(datastore_tests, test_init_nvm_failure)
 {
-  size_t expectedBufferSize = 100;
+  int ret;
+
+  datastoreUtilAllocateBinarySubs_fake.return_val = 0;
+  datastoreUtilAllocateButtonSubs_fake.return_val = 0;
+  datastoreUtilAllocateFloatSubs_fake.return_val = 0;
+  datastoreUtilAllocateIntSubs_fake.return_val = 0;
+  datastoreUtilAllocateMultiStateSubs_fake.return_val = 0;
+  datastoreUtilAllocateUintSubs_fake.return_val = 0;
+  datastoreNvmInit_fake.return_val = -ENOMEM;
+
+  ret = datastoreInit();
+
+  zassert_equal(ret, -ENOMEM, "datastoreInit should return -ENOMEM when the NVM initialization fails");
+  zassert_equal(datastoreNvmInit_fake.call_count, 1,
+                "datastoreNvmInit should be called once");
+  zassert_equal(osMemoryPoolNew_fake.call_count, 0,
+                "osMemoryPoolNew should not be called when the NVM initialization fails");
+  zassert_equal(k_thread_create_mock_fake.call_count, 0,
+                "k_thread_create should not be called when the NVM initialization fails");
+}
+
+/**
+ * @test  The datastoreInit function must return an error when
+ *        osMemoryPoolNew fails to create the buffer pool.
+ */
+ZTEST(datastore_tests, test_init_buffer_pool_alloc_failure)
+{
+  size_t expectedBufferSize = 100;
   int ret;
 
   datastoreUtilAllocateBinarySubs_fake.return_val = 0;
@@ -924,14 +1434,39 @@ ZTEST(datastore_tests, test_init_buffer_pool_alloc_failure)
   zassert_equal(ret, -ENOSPC, "datastoreInit should return -ENOSPC when buffer pool allocation fails");
   zassert_equal(osMemoryPoolNew_fake.call_count, 1,
                 "osMemoryPoolNew should be called once");
-  zassert_equal(osMemoryPoolNew_fake.arg1_val, expectedBufferSize,
-                "osMemoryPoolNew should be called with correct buffer size");
+  zassert_equal(osMemoryPoolNew_fake.arg0_val, CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT,
+                "osMemoryPoolNew should be called with CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT");
+  zassert_equal(osMemoryPoolNew_fake.arg1_val, DATASTORE_BUFFER_SIZE(CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES),
+                "osMemoryPoolNew should be called with the small buffer size");
   zassert_equal(k_thread_create_mock_fake.call_count, 0,
                 "k_thread_create should not be called when buffer pool allocation fails");
   zassert_equal(k_thread_name_set_mock_fake.call_count, 0,
                 "k_thread_name_set should not be called when buffer pool allocation fails");
 }
 
+/**
+ * @test  The datastoreInit function must return an error when
+ *        osMemoryPoolNew fails to create the batch pool.
+ */
+ZTEST(datastore_tests, test_init_batch_pool_alloc_failure)
+{
+  osMemoryPoolId_t pools[DATASTORE_POOL_COUNT + 1] = {(osMemoryPoolId_t)0xABCDEF00, (osMemoryPoolId_t)0xABCDEF00,
+                                                       (osMemoryPoolId_t)0xABCDEF00, (osMemoryPoolId_t)0xABCDEF00,
+                                                       NULL};
+  int ret;
+
+  datastoreUtilCalculateBufferSize_fake.return_val = 100;
+  SET_RETURN_SEQ(osMemoryPoolNew, pools, DATASTORE_POOL_COUNT + 1);
+
+  ret = datastoreInit();
+
+  zassert_equal(ret, -ENOSPC, "datastoreInit should return -ENOSPC when batch pool allocation fails");
+  zassert_equal(osMemoryPoolNew_fake.call_count, DATASTORE_POOL_COUNT + 1,
+                "osMemoryPoolNew should be called for each buffer pool and the batch pool");
+  zassert_equal(k_thread_create_mock_fake.call_count, 0,
+                "k_thread_create should not be called when batch pool allocation fails");
+}
+
 /**
  * @test  The datastoreInit function must return an error when k_thread_name_set fails.
  */
@@ -1022,6 +1557,9 @@ ZTEST(datastore_tests, test_init_success)
 
   zassert_equal(ret, 0, "datastoreInit should return 0 on success");
 
+  zassert_equal(datastoreUtilInitDatapoints_fake.call_count, 1,
+                "datastoreUtilInitDatapoints should be called once");
+
   zassert_equal(datastoreUtilAllocateBinarySubs_fake.call_count, 1,
                 "datastoreUtilAllocateBinarySubs should be called once");
   zassert_equal(datastoreUtilAllocateBinarySubs_fake.arg0_val, CONFIG_ENYA_DATASTORE_MAX_BINARY_SUBS,
@@ -1049,12 +1587,31 @@ ZTEST(datastore_tests, test_init_success)
 
   zassert_equal(datastoreUtilCalculateBufferSize_fake.call_count, 1,
                 "datastoreUtilCalculateBufferSize should be called once");
-  zassert_equal(osMemoryPoolNew_fake.call_count, 1,
-                "osMemoryPoolNew should be called once");
-  zassert_equal(osMemoryPoolNew_fake.arg0_val, DATASTORE_BUFFER_COUNT,
-                "osMemoryPoolNew should be called with DATASTORE_BUFFER_COUNT");
-  zassert_equal(osMemoryPoolNew_fake.arg1_val, expectedBufferSize,
+  zassert_equal(osMemoryPoolNew_fake.call_count, DATASTORE_POOL_COUNT + 1,
+                "osMemoryPoolNew should be called for each buffer pool and the batch pool");
+  zassert_equal(osMemoryPoolNew_fake.arg0_history[DATASTORE_POOL_SMALL], CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT,
+                "osMemoryPoolNew should be called with CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT");
+  zassert_equal(osMemoryPoolNew_fake.arg1_history[DATASTORE_POOL_SMALL],
+                DATASTORE_BUFFER_SIZE(CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES),
+                "osMemoryPoolNew should be called with the small buffer size");
+  zassert_equal(osMemoryPoolNew_fake.arg0_history[DATASTORE_POOL_MEDIUM], CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_COUNT,
+                "osMemoryPoolNew should be called with CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_COUNT");
+  zassert_equal(osMemoryPoolNew_fake.arg1_history[DATASTORE_POOL_MEDIUM],
+                DATASTORE_BUFFER_SIZE(CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES),
+                "osMemoryPoolNew should be called with the medium buffer size");
+  zassert_equal(osMemoryPoolNew_fake.arg0_history[DATASTORE_POOL_LARGE], CONFIG_ENYA_DATASTORE_LARGE_BUFFER_COUNT,
+                "osMemoryPoolNew should be called with CONFIG_ENYA_DATASTORE_LARGE_BUFFER_COUNT");
+  zassert_equal(osMemoryPoolNew_fake.arg1_history[DATASTORE_POOL_LARGE],
+                offsetof(DatastoreRequestBuffer_t, payload) + expectedBufferSize,
+                "osMemoryPoolNew should be called with the request header and the largest payload size");
+  zassert_equal(osMemoryPoolNew_fake.arg0_history[DATASTORE_POOL_NOTIFY], CONFIG_ENYA_DATASTORE_NOTIFY_BUFFER_COUNT,
+                "osMemoryPoolNew should be called with CONFIG_ENYA_DATASTORE_NOTIFY_BUFFER_COUNT");
+  zassert_equal(osMemoryPoolNew_fake.arg1_history[DATASTORE_POOL_NOTIFY], expectedBufferSize,
                 "osMemoryPoolNew should be called with buffer size from datastoreUtilCalculateBufferSize");
+  zassert_equal(osMemoryPoolNew_fake.arg0_history[DATASTORE_POOL_COUNT], DATASTORE_BATCH_BUFFER_COUNT,
+                "osMemoryPoolNew should be called with DATASTORE_BATCH_BUFFER_COUNT");
+  zassert_equal(osMemoryPoolNew_fake.arg1_history[DATASTORE_POOL_COUNT], DATASTORE_BATCH_BUFFER_SIZE,
+                "osMemoryPoolNew should be called with DATASTORE_BATCH_BUFFER_SIZE");
 
   zassert_equal(k_thread_create_mock_fake.call_count, 1,
                 "k_thread_create should be called once");
@@ -1115,12 +1672,20 @@ ZTEST(datastore_tests, test_read_buffer_alloc_failure)
   zassert_equal(ret, -ENOSPC, "datastoreRead should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
-  zassert_equal(osMemoryPoolAlloc_fake.arg0_val, bufferPool,
-                "osMemoryPoolAlloc should be called with bufferPool");
-  zassert_equal(osMemoryPoolAlloc_fake.arg1_val, DATASTORE_BUFFER_ALLOC_TIMEOUT,
-                "osMemoryPoolAlloc should be called with DATASTORE_BUFFER_ALLOC_TIMEOUT");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_history[0], bufferPools[DATASTORE_POOL_SMALL].id,
+                "osMemoryPoolAlloc should try the small pool first");
+  zassert_equal(osMemoryPoolAlloc_fake.arg1_history[0], 0,
+                "osMemoryPoolAlloc should not wait on the small pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_history[1], bufferPools[DATASTORE_POOL_MEDIUM].id,
+                "osMemoryPoolAlloc should fall back to the medium pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg1_history[1], 0,
+                "osMemoryPoolAlloc should not wait on the medium pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_history[2], bufferPools[DATASTORE_POOL_LARGE].id,
+                "osMemoryPoolAlloc should fall back to the large pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg1_history[2], DATASTORE_BUFFER_ALLOC_TIMEOUT,
+                "osMemoryPoolAlloc should wait DATASTORE_BUFFER_ALLOC_TIMEOUT on the large pool");
 
   /* Verify no message was put in the queue */
   DatastoreMsg_t dummy;
@@ -1144,14 +1709,14 @@ ZTEST(datastore_tests, test_read_msgq_put_failure)
   Data_t values[1];
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  SrvMsgPayload_t mockPayload;
+  DatastoreRequestBuffer_t mockRequest;
   int ret;
 
   /* Initialize response queue */
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = &mockPayload;
+  osMemoryPoolAlloc_fake.return_val = &mockRequest;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -1176,9 +1741,9 @@ ZTEST(datastore_tests, test_read_msgq_put_failure)
   /* Verify osMemoryPoolFree was called to clean up the allocated buffer */
   zassert_equal(osMemoryPoolFree_fake.call_count, 1,
                 "osMemoryPoolFree should be called once to free the buffer when k_msgq_put fails");
-  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPool,
-                "osMemoryPoolFree should be called with bufferPool");
-  zassert_equal(osMemoryPoolFree_fake.arg1_val, &mockPayload,
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPools[DATASTORE_POOL_SMALL].id,
+                "osMemoryPoolFree should be called with the small pool");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, &mockRequest,
                 "osMemoryPoolFree should be called with the allocated payload");
 }
 
@@ -1194,14 +1759,14 @@ ZTEST(datastore_tests, test_read_response_timeout)
   Data_t values[1];
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  SrvMsgPayload_t mockPayload;
+  DatastoreRequestBuffer_t mockRequest;
   int ret;
 
   /* Initialize response queue (empty - no response will be sent) */
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = &mockPayload;
+  osMemoryPoolAlloc_fake.return_val = &mockRequest;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -1217,20 +1782,20 @@ ZTEST(datastore_tests, test_read_response_timeout)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_READ, "Message type should be DATASTORE_READ");
   zassert_equal(msg.datapointType, datapointType, "Message should have correct datapoint type");
   zassert_equal(msg.datapointId, datapointId, "Message should have correct datapoint ID");
 
-  /* Verify osMemoryPoolFree was called to clean up the allocated buffer */
-  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
-                "osMemoryPoolFree should be called once to free the buffer when response times out");
-  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPool,
-                "osMemoryPoolFree should be called with bufferPool");
-  zassert_equal(osMemoryPoolFree_fake.arg1_val, &mockPayload,
-                "osMemoryPoolFree should be called with the allocated payload");
+  /* Verify the buffer is left to the datastore thread */
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "osMemoryPoolFree should not be called while the datastore thread owns the buffer");
+  zassert_equal(atomic_get(&mockRequest.state), DATASTORE_REQUEST_ABANDONED,
+                "the request should be marked abandoned");
+  zassert_equal(atomic_get(&datastoreStats.responseTimeouts), 1,
+                "the response timeout should be counted");
 }
 
 /**
@@ -1245,7 +1810,7 @@ ZTEST(datastore_tests, test_read_operation_failure)
   Data_t values[3] = {{.uintVal = 0xFFFFFFFF}, {.uintVal = 0xFFFFFFFF}, {.uintVal = 0xFFFFFFFF}};  /* Initialize to detect if copied */
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  SrvMsgPayload_t mockPayload;
+  DatastoreRequestBuffer_t mockRequest;
   int ret;
   int errorStatus = -EINVAL;
 
@@ -1253,7 +1818,7 @@ ZTEST(datastore_tests, test_read_operation_failure)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = &mockPayload;
+  osMemoryPoolAlloc_fake.return_val = &mockRequest;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -1273,7 +1838,7 @@ ZTEST(datastore_tests, test_read_operation_failure)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
 
@@ -1285,9 +1850,9 @@ ZTEST(datastore_tests, test_read_operation_failure)
   /* Verify osMemoryPoolFree was called to free the buffer */
   zassert_equal(osMemoryPoolFree_fake.call_count, 1,
                 "osMemoryPoolFree should be called once to free the buffer");
-  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPool,
-                "osMemoryPoolFree should be called with bufferPool");
-  zassert_equal(osMemoryPoolFree_fake.arg1_val, &mockPayload,
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPools[DATASTORE_POOL_SMALL].id,
+                "osMemoryPoolFree should be called with the small pool");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, &mockRequest,
                 "osMemoryPoolFree should be called with the allocated payload");
 }
 
@@ -1304,8 +1869,8 @@ ZTEST(datastore_tests, test_read_success)
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
   /* Allocate buffer with space for payload header + data array */
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -1314,7 +1879,7 @@ ZTEST(datastore_tests, test_read_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -1339,7 +1904,7 @@ ZTEST(datastore_tests, test_read_success)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_READ, "Message type should be DATASTORE_READ");
@@ -1354,12 +1919,378 @@ ZTEST(datastore_tests, test_read_success)
   /* Verify osMemoryPoolFree was called to free the buffer */
   zassert_equal(osMemoryPoolFree_fake.call_count, 1,
                 "osMemoryPoolFree should be called once to free the buffer");
-  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPool,
-                "osMemoryPoolFree should be called with bufferPool");
-  zassert_equal(osMemoryPoolFree_fake.arg1_val, mockPayload,
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPools[DATASTORE_POOL_SMALL].id,
+                "osMemoryPoolFree should be called with the small pool");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, payloadBuffer,
                 "osMemoryPoolFree should be called with the allocated payload");
 }
 
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+/**
+ * @test  The datastoreRead function must return the direct read values without
+ *        going through the datastore queue when the direct read succeeds.
+ */
+ZTEST(datastore_tests, test_read_direct_success)
+{
+  Data_t values[2];
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  DatastoreMsg_t msg = {0};
+  int ret;
+
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  datastoreUtilDirectRead_fake.return_val = 0;
+
+  ret = datastoreRead(DATAPOINT_FLOAT, 2, 2, &responseQueue, values);
+
+  zassert_equal(ret, 0, "datastoreRead should return 0 on direct read success");
+  zassert_equal(datastoreUtilDirectRead_fake.call_count, 1,
+                "datastoreUtilDirectRead should be called once");
+  zassert_equal(datastoreUtilDirectRead_fake.arg0_val, DATAPOINT_FLOAT,
+                "datastoreUtilDirectRead should be called with the datapoint type");
+  zassert_equal(datastoreUtilDirectRead_fake.arg1_val, 2,
+                "datastoreUtilDirectRead should be called with the datapoint ID");
+  zassert_equal(datastoreUtilDirectRead_fake.arg2_val, 2,
+                "datastoreUtilDirectRead should be called with the value count");
+  zassert_equal(datastoreUtilDirectRead_fake.arg3_val, values,
+                "datastoreUtilDirectRead should be called with the output buffer");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0,
+                "osMemoryPoolAlloc should not be called on direct read");
+  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, -ENOMSG, "No message should be queued on direct read");
+}
+
+/**
+ * @test  The datastoreRead function must return the direct read error without
+ *        falling back to the datastore queue when the error is not -EAGAIN.
+ */
+ZTEST(datastore_tests, test_read_direct_failure)
+{
+  Data_t values[1];
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  int ret;
+
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  datastoreUtilDirectRead_fake.return_val = -EINVAL;
+
+  ret = datastoreRead(DATAPOINT_FLOAT, 100, 1, &responseQueue, values);
+
+  zassert_equal(ret, -EINVAL, "datastoreRead should return the direct read error");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0,
+                "osMemoryPoolAlloc should not be called on direct read failure");
+}
+
+/**
+ * @test  The datastoreRead function must fall back to the datastore queue when
+ *        the direct read collides with writes.
+ */
+ZTEST(datastore_tests, test_read_direct_collision_fallback)
+{
+  Data_t values[1];
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  DatastoreRequestBuffer_t mockRequest;
+  DatastoreMsg_t msg = {0};
+  int ret;
+
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  osMemoryPoolAlloc_fake.return_val = &mockRequest;
+
+  ret = datastoreRead(DATAPOINT_BINARY, 1, 1, &responseQueue, values);
+
+  zassert_equal(ret, -EAGAIN, "datastoreRead should time out waiting for the response");
+  zassert_equal(datastoreUtilDirectRead_fake.call_count, 1,
+                "datastoreUtilDirectRead should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
+                "osMemoryPoolAlloc should be called for the queue fallback");
+  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "A read message should be queued on fallback");
+  zassert_equal(msg.msgType, DATASTORE_READ, "Message type should be DATASTORE_READ");
+}
+
+/**
+ * @test  The typed read functions must accept a NULL response queue when the
+ *        direct read succeeds.
+ */
+ZTEST(datastore_tests, test_read_direct_null_response)
+{
+  float values[2];
+  DatastoreMsg_t msg = {0};
+  int ret;
+
+  datastoreUtilDirectRead_fake.return_val = 0;
+
+  ret = datastoreReadFloat(2, 2, NULL, values);
+
+  zassert_equal(ret, 0, "datastoreReadFloat should return 0 on direct read success");
+  zassert_equal(datastoreUtilDirectRead_fake.call_count, 1,
+                "datastoreUtilDirectRead should be called once");
+  zassert_equal(datastoreUtilDirectRead_fake.arg3_val, (Data_t *)values,
+                "datastoreUtilDirectRead should be called with the output buffer");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0,
+                "osMemoryPoolAlloc should not be called on direct read");
+  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, -ENOMSG, "No message should be queued on direct read");
+}
+
+/**
+ * @test  The datastoreReadOrdered function must always go through the datastore
+ *        queue, even when the direct read is enabled.
+ */
+ZTEST(datastore_tests, test_read_ordered_skips_direct_read)
+{
+  Data_t values[1];
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  DatastoreRequestBuffer_t mockRequest;
+  DatastoreMsg_t msg = {0};
+  int ret;
+
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  osMemoryPoolAlloc_fake.return_val = &mockRequest;
+  datastoreUtilDirectRead_fake.return_val = 0;
+
+  datastoreReadOrdered(DATAPOINT_UINT, 0, 1, &responseQueue, values);
+
+  zassert_equal(datastoreUtilDirectRead_fake.call_count, 0,
+                "datastoreUtilDirectRead should not be called for ordered read");
+  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "A read message should be queued for ordered read");
+}
+#endif
+
+/**
+ * @test  The datastoreBatch function must return -EINVAL when the operation
+ *        list or count is invalid.
+ */
+ZTEST(datastore_tests, test_batch_invalid_op_count)
+{
+  Data_t value = {.uintVal = 1};
+  DatastoreBatchOp_t ops[CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS + 1];
+
+  for(size_t i = 0; i < ARRAY_SIZE(ops); ++i)
+    ops[i] = (DatastoreBatchOp_t){DATASTORE_BATCH_WRITE, DATAPOINT_UINT, 0, 1, &value};
+
+  zassert_equal(datastoreBatch(NULL, 1, NULL), -EINVAL,
+                "datastoreBatch should return -EINVAL when ops is NULL");
+  zassert_equal(datastoreBatch(ops, 0, NULL), -EINVAL,
+                "datastoreBatch should return -EINVAL when the operation count is zero");
+  zassert_equal(datastoreBatch(ops, ARRAY_SIZE(ops), NULL), -EINVAL,
+                "datastoreBatch should return -EINVAL when the operation count is above the maximum");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0,
+                "osMemoryPoolAlloc should not be called for invalid batches");
+}
+
+/**
+ * @test  The datastoreBatch function must return -EINVAL when an operation is
+ *        invalid or a read operation has no response queue.
+ */
+ZTEST(datastore_tests, test_batch_invalid_op)
+{
+  Data_t value = {.uintVal = 1};
+  DatastoreBatchOp_t nullValues = {DATASTORE_BATCH_WRITE, DATAPOINT_UINT, 0, 1, NULL};
+  DatastoreBatchOp_t zeroCount = {DATASTORE_BATCH_WRITE, DATAPOINT_UINT, 0, 0, &value};
+  DatastoreBatchOp_t badType = {DATASTORE_BATCH_OP_TYPE_COUNT, DATAPOINT_UINT, 0, 1, &value};
+  DatastoreBatchOp_t readOp = {DATASTORE_BATCH_READ, DATAPOINT_UINT, 0, 1, &value};
+
+  zassert_equal(datastoreBatch(&nullValues, 1, NULL), -EINVAL,
+                "datastoreBatch should return -EINVAL when values is NULL");
+  zassert_equal(datastoreBatch(&zeroCount, 1, NULL), -EINVAL,
+                "datastoreBatch should return -EINVAL when the value count is zero");
+  zassert_equal(datastoreBatch(&badType, 1, NULL), -EINVAL,
+                "datastoreBatch should return -EINVAL when the operation type is invalid");
+  zassert_equal(datastoreBatch(&readOp, 1, NULL), -EINVAL,
+                "datastoreBatch should return -EINVAL for a read without response queue");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0,
+                "osMemoryPoolAlloc should not be called for invalid batches");
+}
+
+/**
+ * @test  The datastoreBatch function must return -E2BIG when the total value
+ *        count is above the maximum.
+ */
+ZTEST(datastore_tests, test_batch_too_many_values)
+{
+  Data_t values[CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES];
+  DatastoreBatchOp_t ops[2] = {
+    {DATASTORE_BATCH_WRITE, DATAPOINT_UINT, 0, CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES, values},
+    {DATASTORE_BATCH_WRITE, DATAPOINT_INT, 0, 1, values},
+  };
+
+  zassert_equal(datastoreBatch(ops, 2, NULL), -E2BIG,
+                "datastoreBatch should return -E2BIG when the values do not fit the batch buffer");
+}
+
+/**
+ * @test  The datastoreBatch function must return -ENOSPC when the batch buffer
+ *        allocation fails.
+ */
+ZTEST(datastore_tests, test_batch_buffer_alloc_failure)
+{
+  Data_t value = {.uintVal = 1};
+  DatastoreBatchOp_t op = {DATASTORE_BATCH_WRITE, DATAPOINT_UINT, 0, 1, &value};
+
+  osMemoryPoolAlloc_fake.return_val = NULL;
+
+  zassert_equal(datastoreBatch(&op, 1, NULL), -ENOSPC,
+                "datastoreBatch should return -ENOSPC when buffer allocation fails");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_val, batchPool,
+                "osMemoryPoolAlloc should be called with batchPool");
+}
+
+/**
+ * @test  The datastoreBatch function must free the batch buffer when the
+ *        datastore queue is full.
+ */
+ZTEST(datastore_tests, test_batch_msgq_put_failure)
+{
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + 8 * sizeof(Data_t)];
+  Data_t value = {.uintVal = 1};
+  DatastoreBatchOp_t op = {DATASTORE_BATCH_WRITE, DATAPOINT_UINT, 0, 1, &value};
+  DatastoreMsg_t dummyMsg;
+  int ret;
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+
+  for(int i = 0; i < DATASTORE_MSG_COUNT; i++)
+  {
+    ret = k_msgq_put(&datastoreQueue, &dummyMsg, K_NO_WAIT);
+    zassert_equal(ret, 0, "Failed to fill datastore queue");
+  }
+
+  ret = datastoreBatch(&op, 1, NULL);
+
+  zassert_true(ret < 0, "datastoreBatch should return error when k_msgq_put fails");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, payloadBuffer,
+                "osMemoryPoolFree should be called with the batch buffer");
+}
+
+/**
+ * @test  The datastoreBatch function must pack every operation in a single
+ *        batch message and return without waiting when there is no response queue.
+ */
+ZTEST(datastore_tests, test_batch_write_no_response)
+{
+  uint8_t __aligned(4) payloadBuffer[sizeof(DatastoreRequestBuffer_t) + 16 * sizeof(Data_t)];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  Data_t floatVals[2] = {{.floatVal = 1.5f}, {.floatVal = 2.5f}};
+  Data_t intVal = {.intVal = -4};
+  DatastoreBatchOp_t ops[2] = {
+    {DATASTORE_BATCH_WRITE, DATAPOINT_FLOAT, 1, 2, floatVals},
+    {DATASTORE_BATCH_WRITE, DATAPOINT_INT, 3, 1, &intVal},
+  };
+  DatastoreBatchOpHeader_t header;
+  DatastoreMsg_t msg = {0};
+  size_t cursor;
+  int ret;
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+
+  ret = datastoreBatch(ops, 2, NULL);
+
+  zassert_equal(ret, 0, "datastoreBatch should return 0 on success");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "osMemoryPoolFree should not be called, the datastore thread owns the buffer");
+
+  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "A single batch message should be queued");
+  zassert_equal(msg.msgType, DATASTORE_BATCH, "Message type should be DATASTORE_BATCH");
+  zassert_equal(msg.valCount, 2, "Message value count should be the operation count");
+  zassert_equal(msg.payload, mockPayload, "Message should carry the batch buffer");
+  zassert_equal(mockPayload->poolId, batchPool, "Batch buffer should belong to batchPool");
+  zassert_equal(mockPayload->dataLen, (2 * DATASTORE_BATCH_OP_HEADER_LEN + 3) * sizeof(Data_t),
+                "Batch buffer data length should cover the headers and values");
+  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, -ENOMSG, "Only one message should be queued");
+
+  memcpy(&header, mockPayload->data, sizeof(header));
+  zassert_equal(header.opType, DATASTORE_BATCH_WRITE, "First operation type should be packed");
+  zassert_equal(header.datapointType, DATAPOINT_FLOAT, "First datapoint type should be packed");
+  zassert_equal(header.datapointId, 1, "First datapoint ID should be packed");
+  zassert_equal(header.valCount, 2, "First value count should be packed");
+  cursor = DATASTORE_BATCH_OP_HEADER_LEN;
+  zassert_equal(mockPayload->data[cursor].floatVal, 1.5f, "First operation values should be packed");
+  zassert_equal(mockPayload->data[cursor + 1].floatVal, 2.5f, "First operation values should be packed");
+  cursor += 2;
+  memcpy(&header, mockPayload->data + cursor, sizeof(header));
+  zassert_equal(header.datapointType, DATAPOINT_INT, "Second datapoint type should be packed");
+  zassert_equal(header.datapointId, 3, "Second datapoint ID should be packed");
+  cursor += DATASTORE_BATCH_OP_HEADER_LEN;
+  zassert_equal(mockPayload->data[cursor].intVal, -4, "Second operation values should be packed");
+}
+
+/**
+ * @test  The datastoreBatch function must copy the read values back to the
+ *        operations once the batch succeeded and free the buffer.
+ */
+ZTEST(datastore_tests, test_batch_read_success)
+{
+  uint8_t __aligned(4) payloadBuffer[sizeof(DatastoreRequestBuffer_t) + 16 * sizeof(Data_t)];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  Data_t writeVal = {.uintVal = 3};
+  Data_t readVals[2] = {{.uintVal = 0}, {.uintVal = 0}};
+  DatastoreBatchOp_t ops[2] = {
+    {DATASTORE_BATCH_WRITE, DATAPOINT_UINT, 0, 1, &writeVal},
+    {DATASTORE_BATCH_READ, DATAPOINT_BINARY, 0, 2, readVals},
+  };
+  size_t readCursor = 2 * DATASTORE_BATCH_OP_HEADER_LEN + 1;
+  int successStatus = 0;
+  int ret;
+
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+
+  /* Pre-fill the read area and the response as the datastore thread would */
+  mockPayload->data[readCursor].uintVal = 1;
+  mockPayload->data[readCursor + 1].uintVal = 0;
+  ret = k_msgq_put(&responseQueue, &successStatus, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put success status in response queue");
+
+  ret = datastoreBatch(ops, 2, &responseQueue);
+
+  zassert_equal(ret, 0, "datastoreBatch should return 0 on success");
+  zassert_equal(readVals[0].uintVal, 1, "First read value should be copied back");
+  zassert_equal(readVals[1].uintVal, 0, "Second read value should be copied back");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, payloadBuffer,
+                "osMemoryPoolFree should be called with the batch buffer");
+}
+
+/**
+ * @test  The datastoreBatch function must return the batch error and leave the
+ *        read buffers untouched when the batch failed.
+ */
+ZTEST(datastore_tests, test_batch_operation_failure)
+{
+  uint8_t __aligned(4) payloadBuffer[sizeof(DatastoreRequestBuffer_t) + 16 * sizeof(Data_t)];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  Data_t readVal = {.uintVal = 0xFFFFFFFF};
+  DatastoreBatchOp_t op = {DATASTORE_BATCH_READ, DATAPOINT_UINT, 0, 1, &readVal};
+  int errorStatus = -EINVAL;
+  int ret;
+
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+  mockPayload->data[DATASTORE_BATCH_OP_HEADER_LEN].uintVal = 0;
+  ret = k_msgq_put(&responseQueue, &errorStatus, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put error status in response queue");
+
+  ret = datastoreBatch(&op, 1, &responseQueue);
+
+  zassert_equal(ret, -EINVAL, "datastoreBatch should return the batch error");
+  zassert_equal(readVal.uintVal, 0xFFFFFFFF, "Read buffer should not be modified on failure");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once");
+}
+
 /**
  * @test  The datastoreWrite function must return an error when buffer allocation
  *        fails (osMemoryPoolAlloc returns NULL).
@@ -1387,12 +2318,20 @@ ZTEST(datastore_tests, test_write_buffer_alloc_failure)
   zassert_equal(ret, -ENOSPC, "datastoreWrite should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
-  zassert_equal(osMemoryPoolAlloc_fake.arg0_val, bufferPool,
-                "osMemoryPoolAlloc should be called with bufferPool");
-  zassert_equal(osMemoryPoolAlloc_fake.arg1_val, DATASTORE_BUFFER_ALLOC_TIMEOUT,
-                "osMemoryPoolAlloc should be called with DATASTORE_BUFFER_ALLOC_TIMEOUT");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_history[0], bufferPools[DATASTORE_POOL_SMALL].id,
+                "osMemoryPoolAlloc should try the small pool first");
+  zassert_equal(osMemoryPoolAlloc_fake.arg1_history[0], 0,
+                "osMemoryPoolAlloc should not wait on the small pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_history[1], bufferPools[DATASTORE_POOL_MEDIUM].id,
+                "osMemoryPoolAlloc should fall back to the medium pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg1_history[1], 0,
+                "osMemoryPoolAlloc should not wait on the medium pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_history[2], bufferPools[DATASTORE_POOL_LARGE].id,
+                "osMemoryPoolAlloc should fall back to the large pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg1_history[2], DATASTORE_BUFFER_ALLOC_TIMEOUT,
+                "osMemoryPoolAlloc should wait DATASTORE_BUFFER_ALLOC_TIMEOUT on the large pool");
 
   /* Verify no message was put in the queue */
   DatastoreMsg_t dummy;
@@ -1416,15 +2355,15 @@ ZTEST(datastore_tests, test_write_msgq_put_failure)
   Data_t values[1] = {{.intVal = -42}};
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   int ret;
 
   /* Initialize response queue */
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -1449,9 +2388,9 @@ ZTEST(datastore_tests, test_write_msgq_put_failure)
   /* Verify osMemoryPoolFree was called to clean up the allocated buffer */
   zassert_equal(osMemoryPoolFree_fake.call_count, 1,
                 "osMemoryPoolFree should be called once to free the buffer when k_msgq_put fails");
-  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPool,
-                "osMemoryPoolFree should be called with bufferPool");
-  zassert_equal(osMemoryPoolFree_fake.arg1_val, mockPayload,
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPools[DATASTORE_POOL_SMALL].id,
+                "osMemoryPoolFree should be called with the small pool");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, payloadBuffer,
                 "osMemoryPoolFree should be called with the allocated payload");
 }
 
@@ -1467,15 +2406,15 @@ ZTEST(datastore_tests, test_write_response_timeout)
   Data_t values[2] = {{.floatVal = 3.14f}, {.floatVal = 2.71f}};
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   int ret;
 
   /* Initialize response queue (empty - no response will be sent) */
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -1491,188 +2430,695 @@ ZTEST(datastore_tests, test_write_response_timeout)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
+  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "Message should be in the datastore queue");
+  zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
+  zassert_equal(msg.datapointType, datapointType, "Message should have correct datapoint type");
+  zassert_equal(msg.datapointId, datapointId, "Message should have correct datapoint ID");
+  zassert_equal(msg.valCount, valCount, "Message should have correct value count");
+
+  /* Verify the buffer is left to the datastore thread */
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "osMemoryPoolFree should not be called while the datastore thread owns the buffer");
+  zassert_equal(((DatastoreRequestBuffer_t *)payloadBuffer)->state, DATASTORE_REQUEST_ABANDONED,
+                "the request should be marked abandoned");
+}
+
+/**
+ * @test  The datastoreWrite function must successfully write data when no
+ *        response is expected (response queue is NULL).
+ */
+ZTEST(datastore_tests, test_write_success_no_response)
+{
+  DatapointType_t datapointType = DATAPOINT_UINT;
+  uint32_t datapointId = 20;
+  size_t valCount = 3;
+  Data_t values[3] = {{.uintVal = 0xAAAAAAAA}, {.uintVal = 0xBBBBBBBB}, {.uintVal = 0xCCCCCCCC}};
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  Data_t *payloadData = (Data_t *)mockPayload->data;
+  int ret;
+
+  /* Configure buffer allocation to succeed */
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+
+  /* Call datastoreWrite with NULL response queue */
+  ret = datastoreWrite(datapointType, datapointId, values, valCount, NULL);
+
+  /* Verify function returned success */
+  zassert_equal(ret, 0, "datastoreWrite should return 0 on success with no response");
+
+  /* Verify osMemoryPoolAlloc was called */
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
+                "osMemoryPoolAlloc should be called once");
+
+  /* Verify message was put in the datastore queue */
+  DatastoreMsg_t msg = {0};
+  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "Message should be in the datastore queue");
+  zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
+  zassert_equal(msg.datapointType, datapointType, "Message should have correct datapoint type");
+  zassert_equal(msg.datapointId, datapointId, "Message should have correct datapoint ID");
+  zassert_equal(msg.valCount, valCount, "Message should have correct value count");
+  zassert_equal(msg.response, NULL, "Response queue should be NULL");
+
+  /* Verify data was copied to payload */
+  zassert_equal(payloadData[0].uintVal, 0xAAAAAAAA, "First value should be copied to payload");
+  zassert_equal(payloadData[1].uintVal, 0xBBBBBBBB, "Second value should be copied to payload");
+  zassert_equal(payloadData[2].uintVal, 0xCCCCCCCC, "Third value should be copied to payload");
+
+  /* Verify osMemoryPoolFree was NOT called (buffer ownership transferred to queue) */
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "osMemoryPoolFree should not be called when no response is expected");
+}
+
+/**
+ * @test  The datastoreWrite function must handle operation failure gracefully
+ *        when communication succeeds but the datastore operation returns an error.
+ */
+ZTEST(datastore_tests, test_write_operation_failure)
+{
+  DatapointType_t datapointType = DATAPOINT_INT;
+  uint32_t datapointId = 25;
+  size_t valCount = 2;
+  Data_t values[2] = {{.intVal = -100}, {.intVal = 200}};
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  Data_t *payloadData = (Data_t *)mockPayload->data;
+  int ret;
+  int errorStatus = -EINVAL;
+
+  /* Initialize response queue */
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+
+  /* Configure buffer allocation to succeed */
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+
+  /* Configure osMemoryPoolFree to succeed */
+  osMemoryPoolFree_fake.return_val = osOK;
+
+  /* Put error status in response queue (simulating operation failure) */
+  ret = k_msgq_put(&responseQueue, &errorStatus, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put error status in response queue");
+
+  /* Call datastoreWrite - communication succeeds but operation fails */
+  ret = datastoreWrite(datapointType, datapointId, values, valCount, &responseQueue);
+
+  /* Verify function returned the error status from operation */
+  zassert_equal(ret, errorStatus, "datastoreWrite should return error status from operation");
+
+  /* Verify osMemoryPoolAlloc was called */
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
+                "osMemoryPoolAlloc should be called once");
+
+  /* Verify message was put in the datastore queue */
+  DatastoreMsg_t msg = {0};
+  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
+  zassert_equal(ret, 0, "Message should be in the datastore queue");
+  zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
+  zassert_equal(msg.datapointType, datapointType, "Message should have correct datapoint type");
+  zassert_equal(msg.datapointId, datapointId, "Message should have correct datapoint ID");
+  zassert_equal(msg.valCount, valCount, "Message should have correct value count");
+
+  /* Verify data was copied to payload */
+  zassert_equal(payloadData[0].intVal, -100, "First value should be copied to payload");
+  zassert_equal(payloadData[1].intVal, 200, "Second value should be copied to payload");
+
+  /* Verify the caller freed the buffer once it got the response */
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once the response is received");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, payloadBuffer,
+                "osMemoryPoolFree should be called with the allocated buffer");
+}
+
+/**
+ * @test  The datastoreWrite function must successfully write data when a
+ *        response is expected and the operation succeeds.
+ */
+ZTEST(datastore_tests, test_write_success)
+{
+  DatapointType_t datapointType = DATAPOINT_FLOAT;
+  uint32_t datapointId = 30;
+  size_t valCount = 2;
+  Data_t values[2] = {{.floatVal = 1.23f}, {.floatVal = 4.56f}};
+  struct k_msgq responseQueue;
+  char __aligned(4) responseBuffer[sizeof(int)];
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  Data_t *payloadData = (Data_t *)mockPayload->data;
+  int ret;
+  int successStatus = 0;
+
+  /* Initialize response queue */
+  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+
+  /* Configure buffer allocation to succeed */
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+
+  /* Configure osMemoryPoolFree to succeed */
+  osMemoryPoolFree_fake.return_val = osOK;
+
+  /* Put success status in response queue */
+  ret = k_msgq_put(&responseQueue, &successStatus, K_NO_WAIT);
+  zassert_equal(ret, 0, "Failed to put success status in response queue");
+
+  /* Call datastoreWrite - should succeed */
+  ret = datastoreWrite(datapointType, datapointId, values, valCount, &responseQueue);
+
+  /* Verify function returned success */
+  zassert_equal(ret, 0, "datastoreWrite should return 0 on success");
+
+  /* Verify osMemoryPoolAlloc was called */
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
+                "osMemoryPoolAlloc should be called once");
+
+  /* Verify message was put in the datastore queue */
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
   zassert_equal(msg.datapointType, datapointType, "Message should have correct datapoint type");
   zassert_equal(msg.datapointId, datapointId, "Message should have correct datapoint ID");
   zassert_equal(msg.valCount, valCount, "Message should have correct value count");
+  zassert_equal(msg.response, &responseQueue, "Response queue should be set correctly");
+
+  /* Verify data was copied to payload */
+  zassert_within(payloadData[0].floatVal, 1.23f, 0.001f, "First value should be copied to payload");
+  zassert_within(payloadData[1].floatVal, 4.56f, 0.001f, "Second value should be copied to payload");
+
+  /* Verify the caller freed the buffer once it got the response */
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once the response is received");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, payloadBuffer,
+                "osMemoryPoolFree should be called with the allocated buffer");
+}
+
+/**
+ * @test  The datastoreWrite function must allocate the request buffer from
+ *        the medium pool when the values do not fit in a small buffer.
+ */
+ZTEST(datastore_tests, test_write_medium_buffer)
+{
+  size_t valCount = CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES + 1;
+  Data_t values[CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES + 1] = {0};
+  uint8_t payloadBuffer[DATASTORE_BUFFER_SIZE(CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES + 1)];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  int ret;
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+
+  ret = datastoreWrite(DATAPOINT_UINT, 0, values, valCount, NULL);
+
+  zassert_equal(ret, 0, "datastoreWrite should return 0 on success with no response");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
+                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_val, bufferPools[DATASTORE_POOL_MEDIUM].id,
+                "osMemoryPoolAlloc should be called with the medium pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg1_val, 0,
+                "osMemoryPoolAlloc should not wait on the medium pool");
+  zassert_equal(mockPayload->poolId, bufferPools[DATASTORE_POOL_MEDIUM].id,
+                "payload should be tagged with the medium pool");
+  zassert_equal(mockPayload->dataLen, valCount * sizeof(Data_t),
+                "payload data length should match the value count");
+}
+
+/**
+ * @test  The datastoreWrite function must allocate the request buffer from
+ *        the large pool when the values do not fit in a medium buffer.
+ */
+ZTEST(datastore_tests, test_write_large_buffer)
+{
+  size_t valCount = CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES + 1;
+  Data_t values[CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES + 1] = {0};
+  uint8_t payloadBuffer[DATASTORE_BUFFER_SIZE(CONFIG_ENYA_DATASTORE_MEDIUM_BUFFER_VALUES + 1)];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  int ret;
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+
+  ret = datastoreWrite(DATAPOINT_UINT, 0, values, valCount, NULL);
+
+  zassert_equal(ret, 0, "datastoreWrite should return 0 on success with no response");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
+                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_val, bufferPools[DATASTORE_POOL_LARGE].id,
+                "osMemoryPoolAlloc should be called with the large pool");
+  zassert_equal(osMemoryPoolAlloc_fake.arg1_val, DATASTORE_BUFFER_ALLOC_TIMEOUT,
+                "osMemoryPoolAlloc should wait DATASTORE_BUFFER_ALLOC_TIMEOUT on the large pool");
+  zassert_equal(mockPayload->poolId, bufferPools[DATASTORE_POOL_LARGE].id,
+                "payload should be tagged with the large pool");
+}
+
+/**
+ * @test  The datastoreWrite function must fall back to a larger pool when the
+ *        fitting pool is exhausted.
+ */
+ZTEST(datastore_tests, test_write_buffer_fallback)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+  uint8_t payloadBuffer[DATASTORE_BUFFER_SIZE(1)];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  void *payloads[2] = {NULL, payloadBuffer};
+  int ret;
+
+  SET_RETURN_SEQ(osMemoryPoolAlloc, payloads, 2);
+
+  ret = datastoreWrite(DATAPOINT_UINT, 0, values, 1, NULL);
+
+  zassert_equal(ret, 0, "datastoreWrite should return 0 when a larger pool has a free block");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 2,
+                "osMemoryPoolAlloc should be called twice");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_history[0], bufferPools[DATASTORE_POOL_SMALL].id,
+                "osMemoryPoolAlloc should try the small pool first");
+  zassert_equal(osMemoryPoolAlloc_fake.arg0_history[1], bufferPools[DATASTORE_POOL_MEDIUM].id,
+                "osMemoryPoolAlloc should fall back to the medium pool");
+  zassert_equal(mockPayload->poolId, bufferPools[DATASTORE_POOL_MEDIUM].id,
+                "payload should be tagged with the medium pool");
+}
+
+/**
+ * @test  The request buffer allocation must keep the highest used block count
+ *        of its pool.
+ */
+ZTEST(datastore_tests, test_write_updates_pool_high_water)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+  uint8_t payloadBuffer[DATASTORE_BUFFER_SIZE(1)];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  int ret;
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+  osMemoryPoolGetCount_fake.return_val = 3;
+
+  ret = datastoreWrite(DATAPOINT_UINT, 0, values, 1, NULL);
+  zassert_equal(ret, 0, "datastoreWrite should return 0 on success with no response");
+  zassert_equal(atomic_get(&bufferPools[DATASTORE_POOL_SMALL].highWater), 3,
+                "small pool high water should be the used block count");
+
+  k_msgq_purge(&datastoreQueue);
+  osMemoryPoolGetCount_fake.return_val = 1;
+
+  ret = datastoreWrite(DATAPOINT_UINT, 0, values, 1, NULL);
+  zassert_equal(ret, 0, "datastoreWrite should return 0 on success with no response");
+  zassert_equal(atomic_get(&bufferPools[DATASTORE_POOL_SMALL].highWater), 3,
+                "small pool high water should not decrease");
+}
+
+/**
+ * @test  The run function must sample the notification pool high water on
+ *        each iteration.
+ */
+ZTEST(datastore_tests, test_run_updates_notify_high_water)
+{
+  osMemoryPoolGetCount_fake.return_val = 2;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(osMemoryPoolGetCount_fake.arg0_val, DATASTORE_NOTIFY_POOL,
+                "osMemoryPoolGetCount should be called with the notification pool");
+  zassert_equal(atomic_get(&bufferPools[DATASTORE_POOL_NOTIFY].highWater), 2,
+                "notification pool high water should be the used block count");
+}
+
+/**
+ * @test  The datastoreGetPoolStats function must report the buffer pool
+ *        geometry, usage and high water.
+ */
+ZTEST(datastore_tests, test_get_pool_stats_success)
+{
+  DatastorePoolStats_t stats;
+  int ret;
+
+  atomic_set(&bufferPools[DATASTORE_POOL_SMALL].highWater, 5);
+  osMemoryPoolGetCount_fake.return_val = 2;
+
+  ret = datastoreGetPoolStats(DATASTORE_POOL_SMALL, &stats);
+
+  zassert_equal(ret, 0, "datastoreGetPoolStats should return 0 on success");
+  zassert_equal(osMemoryPoolGetCount_fake.arg0_val, bufferPools[DATASTORE_POOL_SMALL].id,
+                "osMemoryPoolGetCount should be called with the small pool");
+  zassert_equal(stats.blockSize, DATASTORE_BUFFER_SIZE(CONFIG_ENYA_DATASTORE_SMALL_BUFFER_VALUES),
+                "block size should be the small buffer size");
+  zassert_equal(stats.blockCount, CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT,
+                "block count should be CONFIG_ENYA_DATASTORE_SMALL_BUFFER_COUNT");
+  zassert_equal(stats.usedCount, 2, "used count should come from osMemoryPoolGetCount");
+  zassert_equal(stats.highWater, 5, "high water should be the pool high water");
+}
+
+/**
+ * @test  The datastoreGetPoolStats function must report an empty pool when the
+ *        pool is not created.
+ */
+ZTEST(datastore_tests, test_get_pool_stats_no_pool)
+{
+  DatastorePoolStats_t stats;
+  int ret;
+
+  bufferPools[DATASTORE_POOL_MEDIUM].id = NULL;
+
+  ret = datastoreGetPoolStats(DATASTORE_POOL_MEDIUM, &stats);
+
+  zassert_equal(ret, 0, "datastoreGetPoolStats should return 0 on success");
+  zassert_equal(osMemoryPoolGetCount_fake.call_count, 0,
+                "osMemoryPoolGetCount should not be called without a pool");
+  zassert_equal(stats.blockCount, 0, "block count should be 0 without a pool");
+  zassert_equal(stats.usedCount, 0, "used count should be 0 without a pool");
+}
+
+/**
+ * @test  The datastoreGetPoolStats function must return an error when the
+ *        pool is invalid or the stats pointer is NULL.
+ */
+ZTEST(datastore_tests, test_get_pool_stats_invalid)
+{
+  DatastorePoolStats_t stats;
+
+  zassert_equal(datastoreGetPoolStats(DATASTORE_POOL_COUNT, &stats), -EINVAL,
+                "datastoreGetPoolStats should return -EINVAL for an invalid pool");
+  zassert_equal(datastoreGetPoolStats(DATASTORE_POOL_SMALL, NULL), -EINVAL,
+                "datastoreGetPoolStats should return -EINVAL for a NULL stats pointer");
+}
+
+/**
+ * @test  The run function must record the request queue depth seen before
+ *        dequeuing as its high water.
+ */
+ZTEST(datastore_tests, test_run_records_queue_high_water)
+{
+  DatastoreMsg_t msg = {0};
+
+  msg.msgType = DATASTORE_MSG_TYPE_COUNT;
+
+  for(size_t i = 0; i < 3; ++i)
+    zassert_equal(k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT), 0, "Failed to put message in queue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(atomic_get(&datastoreStats.queueHighWater), 3,
+                "the queue high water should be the depth before the dequeue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(atomic_get(&datastoreStats.queueHighWater), 3,
+                "a lower queue depth must not lower the high water");
+  zassert_equal(atomic_get(&datastoreStats.opCount), 0,
+                "an unsupported message should not be timed");
+}
+
+/**
+ * @test  The run function must record the service time of a datapoint
+ *        operation in its histogram bucket and as the longest one.
+ */
+ZTEST(datastore_tests, test_run_records_service_time)
+{
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
+  uint32_t cycles[] = {1000, 1600};
+
+  SET_RETURN_SEQ(k_cycle_get_32_mock, cycles, 2);
+  k_cyc_to_us_floor32_mock_fake.return_val = 100;
+
+  msg.msgType = DATASTORE_READ;
+  msg.datapointType = DATAPOINT_UINT;
+  msg.valCount = 1;
+  msg.payload = &request.payload;
+
+  zassert_equal(k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT), 0, "Failed to put message in queue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(k_cyc_to_us_floor32_mock_fake.arg0_val, 600,
+                "the service time should be converted from the elapsed cycles");
+  zassert_equal(atomic_get(&datastoreStats.opCount), 1, "the operation should be counted");
+  zassert_equal(atomic_get(&datastoreStats.serviceTimeMaxUs), 100,
+                "the longest service time should be recorded");
+  zassert_equal(atomic_get(datastoreStats.serviceTimeHist + 7), 1,
+                "a 100 us operation should land in the 64 - 127 us bucket");
+}
+
+/**
+ * @test  The run function must record the service times out of the histogram
+ *        range in its last bucket.
+ */
+ZTEST(datastore_tests, test_run_records_long_service_time)
+{
+  DatastoreMsg_t msg = {0};
+  DatastoreRequestBuffer_t request = {0};
+
+  k_cyc_to_us_floor32_mock_fake.return_val = 50000;
+
+  msg.msgType = DATASTORE_READ;
+  msg.datapointType = DATAPOINT_UINT;
+  msg.valCount = 1;
+  msg.payload = &request.payload;
+
+  zassert_equal(k_msgq_put(&datastoreQueue, &msg, K_NO_WAIT), 0, "Failed to put message in queue");
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(atomic_get(datastoreStats.serviceTimeHist + DATASTORE_STATS_SERVICE_TIME_BUCKET_COUNT - 1), 1,
+                "a long operation should land in the last bucket");
+  zassert_equal(atomic_get(&datastoreStats.serviceTimeMaxUs), 50000,
+                "the longest service time should be recorded");
+}
+
+/**
+ * @test  The datastoreGetStats function must return an error for a NULL
+ *        statistics pointer.
+ */
+ZTEST(datastore_tests, test_get_stats_invalid)
+{
+  zassert_equal(datastoreGetStats(NULL), -EINVAL,
+                "datastoreGetStats should return -EINVAL for a NULL stats pointer");
+  zassert_equal(datastoreUtilGetNotifyStats_fake.call_count, 0,
+                "the notification statistics should not be read");
+}
+
+/**
+ * @test  The datastoreGetStats function must copy the counters gathered since
+ *        the last reset along with the notification statistics.
+ */
+ZTEST(datastore_tests, test_get_stats_success)
+{
+  DatastoreStats_t stats;
+
+  datastoreStats.resetMs = 1000;
+  atomic_set(&datastoreStats.queueHighWater, 4);
+  atomic_set(&datastoreStats.opCount, 12);
+  atomic_set(&datastoreStats.serviceTimeMaxUs, 250);
+  atomic_set(datastoreStats.serviceTimeHist + 3, 12);
+  atomic_set(&datastoreStats.responseTimeouts, 2);
+  k_uptime_get_mock_fake.return_val = 6000;
+
+  zassert_equal(datastoreGetStats(&stats), 0, "datastoreGetStats should succeed");
+
+  zassert_equal(stats.elapsedMs, 5000, "the elapsed time should be since the last reset");
+  zassert_equal(stats.queueHighWater, 4, "wrong queue high water");
+  zassert_equal(stats.opCount, 12, "wrong operation count");
+  zassert_equal(stats.serviceTimeMaxUs, 250, "wrong longest service time");
+  zassert_equal(stats.serviceTimeHist[3], 12, "wrong histogram bucket count");
+  zassert_equal(stats.serviceTimeHist[0], 0, "wrong histogram bucket count");
+  zassert_equal(stats.responseTimeouts, 2, "wrong response timeout count");
+  zassert_equal(datastoreUtilGetNotifyStats_fake.call_count, 1,
+                "the notification statistics should be read");
+  zassert_equal(datastoreUtilGetNotifyStats_fake.arg0_val, &stats,
+                "the notification statistics should be read in the caller statistics");
+}
+
+/**
+ * @test  The datastoreResetStats function must clear the counters, the
+ *        notification statistics and restart the elapsed time.
+ */
+ZTEST(datastore_tests, test_reset_stats)
+{
+  atomic_set(&datastoreStats.queueHighWater, 4);
+  atomic_set(&datastoreStats.opCount, 12);
+  atomic_set(&datastoreStats.serviceTimeMaxUs, 250);
+  atomic_set(datastoreStats.serviceTimeHist + 3, 12);
+  atomic_set(&datastoreStats.responseTimeouts, 2);
+  atomic_set(&bufferPools[DATASTORE_POOL_SMALL].highWater, 3);
+  k_uptime_get_mock_fake.return_val = 6000;
+
+  datastoreResetStats();
+
+  zassert_equal(atomic_get(&datastoreStats.queueHighWater), 0, "the queue high water should be cleared");
+  zassert_equal(atomic_get(&datastoreStats.opCount), 0, "the operation count should be cleared");
+  zassert_equal(atomic_get(&datastoreStats.serviceTimeMaxUs), 0, "the longest service time should be cleared");
+  zassert_equal(atomic_get(datastoreStats.serviceTimeHist + 3), 0, "the histogram should be cleared");
+  zassert_equal(atomic_get(&datastoreStats.responseTimeouts), 0, "the response timeouts should be cleared");
+  zassert_equal(datastoreStats.resetMs, 6000, "the reset time should be recorded");
+  zassert_equal(datastoreUtilResetNotifyStats_fake.call_count, 1,
+                "the notification statistics should be reset");
+  zassert_equal(atomic_get(&bufferPools[DATASTORE_POOL_SMALL].highWater), 3,
+                "the buffer pool high water should be left untouched");
+}
+
+/**
+ * @test  The datastoreReadAsync function must return an error when the values
+ *        buffer or the completion callback is missing.
+ */
+ZTEST(datastore_tests, test_read_async_invalid)
+{
+  Data_t values[1];
 
-  /* Verify osMemoryPoolFree was called to clean up the allocated buffer */
-  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
-                "osMemoryPoolFree should be called once to free the buffer when response times out");
-  zassert_equal(osMemoryPoolFree_fake.arg0_val, bufferPool,
-                "osMemoryPoolFree should be called with bufferPool");
-  zassert_equal(osMemoryPoolFree_fake.arg1_val, mockPayload,
-                "osMemoryPoolFree should be called with the allocated payload");
+  zassert_equal(datastoreReadAsync(DATAPOINT_UINT, 0, 1, NULL, asyncDoneCb, NULL), -EINVAL,
+                "datastoreReadAsync should return -EINVAL without a values buffer");
+  zassert_equal(datastoreReadAsync(DATAPOINT_UINT, 0, 1, values, NULL, NULL), -EINVAL,
+                "datastoreReadAsync should return -EINVAL without a completion callback");
+  zassert_equal(k_msgq_num_used_get(&datastoreQueue), 0,
+                "No message should be in the datastore queue");
 }
 
 /**
- * @test  The datastoreWrite function must successfully write data when no
- *        response is expected (response queue is NULL).
+ * @test  The datastoreReadAsync function must submit the read without a pool
+ *        buffer and return right away.
  */
-ZTEST(datastore_tests, test_write_success_no_response)
+ZTEST(datastore_tests, test_read_async_success)
 {
-  DatapointType_t datapointType = DATAPOINT_UINT;
-  uint32_t datapointId = 20;
-  size_t valCount = 3;
-  Data_t values[3] = {{.uintVal = 0xAAAAAAAA}, {.uintVal = 0xBBBBBBBB}, {.uintVal = 0xCCCCCCCC}};
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
-  Data_t *payloadData = (Data_t *)mockPayload->data;
+  Data_t values[2];
+  int userData;
+  DatastoreMsg_t msg = {0};
   int ret;
 
-  /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
-
-  /* Call datastoreWrite with NULL response queue */
-  ret = datastoreWrite(datapointType, datapointId, values, valCount, NULL);
-
-  /* Verify function returned success */
-  zassert_equal(ret, 0, "datastoreWrite should return 0 on success with no response");
+  ret = datastoreReadAsync(DATAPOINT_FLOAT, 4, 2, values, asyncDoneCb, &userData);
 
-  /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(ret, 0, "datastoreReadAsync should return 0 on success");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0,
+                "osMemoryPoolAlloc should not be called for an asynchronous read");
 
-  /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
-  zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
-  zassert_equal(msg.datapointType, datapointType, "Message should have correct datapoint type");
-  zassert_equal(msg.datapointId, datapointId, "Message should have correct datapoint ID");
-  zassert_equal(msg.valCount, valCount, "Message should have correct value count");
-  zassert_equal(msg.response, NULL, "Response queue should be NULL");
-
-  /* Verify data was copied to payload */
-  zassert_equal(payloadData[0].uintVal, 0xAAAAAAAA, "First value should be copied to payload");
-  zassert_equal(payloadData[1].uintVal, 0xBBBBBBBB, "Second value should be copied to payload");
-  zassert_equal(payloadData[2].uintVal, 0xCCCCCCCC, "Third value should be copied to payload");
-
-  /* Verify osMemoryPoolFree was NOT called (buffer ownership transferred to queue) */
-  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
-                "osMemoryPoolFree should not be called when no response is expected");
+  zassert_equal(msg.msgType, DATASTORE_READ, "Message type should be DATASTORE_READ");
+  zassert_equal(msg.datapointType, DATAPOINT_FLOAT, "Message should have correct datapoint type");
+  zassert_equal(msg.datapointId, 4, "Message should have correct datapoint ID");
+  zassert_equal(msg.valCount, 2, "Message should have correct value count");
+  zassert_is_null(msg.payload, "Message should not carry a payload");
+  zassert_is_null(msg.response, "Message should not have a response queue");
+  zassert_equal(msg.values, values, "Message should carry the caller buffer");
+  zassert_equal(msg.done, asyncDoneCb, "Message should carry the completion callback");
+  zassert_equal(msg.userData, &userData, "Message should carry the user data");
 }
 
 /**
- * @test  The datastoreWrite function must handle operation failure gracefully
- *        when communication succeeds but the datastore operation returns an error.
+ * @test  The datastoreReadAsync function must return an error when the
+ *        datastore queue is full.
  */
-ZTEST(datastore_tests, test_write_operation_failure)
+ZTEST(datastore_tests, test_read_async_msgq_put_failure)
 {
-  DatapointType_t datapointType = DATAPOINT_INT;
-  uint32_t datapointId = 25;
-  size_t valCount = 2;
-  Data_t values[2] = {{.intVal = -100}, {.intVal = 200}};
-  struct k_msgq responseQueue;
-  char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
-  Data_t *payloadData = (Data_t *)mockPayload->data;
+  Data_t values[1];
+  DatastoreMsg_t dummyMsg = {0};
   int ret;
-  int errorStatus = -EINVAL;
 
-  /* Initialize response queue */
-  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  for(int i = 0; i < DATASTORE_MSG_COUNT; i++)
+  {
+    ret = k_msgq_put(&datastoreQueue, &dummyMsg, K_NO_WAIT);
+    zassert_equal(ret, 0, "Failed to fill datastore queue");
+  }
 
-  /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  ret = datastoreReadAsync(DATAPOINT_UINT, 0, 1, values, asyncDoneCb, NULL);
 
-  /* Configure osMemoryPoolFree to succeed */
-  osMemoryPoolFree_fake.return_val = osOK;
+  zassert_true(ret < 0, "datastoreReadAsync should return error when k_msgq_put fails");
+}
 
-  /* Put error status in response queue (simulating operation failure) */
-  ret = k_msgq_put(&responseQueue, &errorStatus, K_NO_WAIT);
-  zassert_equal(ret, 0, "Failed to put error status in response queue");
+/**
+ * @test  The datastoreWriteAsync function must copy the values to a request
+ *        buffer and submit the write without waiting.
+ */
+ZTEST(datastore_tests, test_write_async_success)
+{
+  Data_t values[2] = {{.uintVal = 7}, {.uintVal = 8}};
+  uint8_t payloadBuffer[DATASTORE_BUFFER_SIZE(2)];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
+  int userData;
+  DatastoreMsg_t msg = {0};
+  int ret;
 
-  /* Call datastoreWrite - communication succeeds but operation fails */
-  ret = datastoreWrite(datapointType, datapointId, values, valCount, &responseQueue);
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
-  /* Verify function returned the error status from operation */
-  zassert_equal(ret, errorStatus, "datastoreWrite should return error status from operation");
+  ret = datastoreWriteAsync(DATAPOINT_UINT, 6, values, 2, asyncDoneCb, &userData);
 
-  /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(ret, 0, "datastoreWriteAsync should return 0 on success");
+  zassert_equal(mockPayload->data[0].uintVal, 7, "First value should be copied to payload");
+  zassert_equal(mockPayload->data[1].uintVal, 8, "Second value should be copied to payload");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "osMemoryPoolFree should not be called once the write is submitted");
 
-  /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
-  zassert_equal(msg.datapointType, datapointType, "Message should have correct datapoint type");
-  zassert_equal(msg.datapointId, datapointId, "Message should have correct datapoint ID");
-  zassert_equal(msg.valCount, valCount, "Message should have correct value count");
-
-  /* Verify data was copied to payload */
-  zassert_equal(payloadData[0].intVal, -100, "First value should be copied to payload");
-  zassert_equal(payloadData[1].intVal, 200, "Second value should be copied to payload");
-
-  /* Verify osMemoryPoolFree was NOT called (no free in datastoreWrite when response expected) */
-  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
-                "osMemoryPoolFree should not be called in datastoreWrite when operation fails with response");
+  zassert_equal(msg.datapointId, 6, "Message should have correct datapoint ID");
+  zassert_equal(msg.payload, mockPayload, "Message should carry the request payload");
+  zassert_is_null(msg.response, "Message should not have a response queue");
+  zassert_equal(msg.done, asyncDoneCb, "Message should carry the completion callback");
+  zassert_equal(msg.userData, &userData, "Message should carry the user data");
 }
 
 /**
- * @test  The datastoreWrite function must successfully write data when a
- *        response is expected and the operation succeeds.
+ * @test  The datastoreWriteAsync function must return an error when the
+ *        values are missing or no request buffer is available.
  */
-ZTEST(datastore_tests, test_write_success)
+ZTEST(datastore_tests, test_write_async_failure)
 {
-  DatapointType_t datapointType = DATAPOINT_FLOAT;
-  uint32_t datapointId = 30;
-  size_t valCount = 2;
-  Data_t values[2] = {{.floatVal = 1.23f}, {.floatVal = 4.56f}};
-  struct k_msgq responseQueue;
-  char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
-  Data_t *payloadData = (Data_t *)mockPayload->data;
-  int ret;
-  int successStatus = 0;
+  Data_t values[1] = {{.uintVal = 1}};
 
-  /* Initialize response queue */
-  k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
+  zassert_equal(datastoreWriteAsync(DATAPOINT_UINT, 0, NULL, 1, NULL, NULL), -EINVAL,
+                "datastoreWriteAsync should return -EINVAL without values");
 
-  /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = NULL;
 
-  /* Configure osMemoryPoolFree to succeed */
-  osMemoryPoolFree_fake.return_val = osOK;
+  zassert_equal(datastoreWriteAsync(DATAPOINT_UINT, 0, values, 1, NULL, NULL), -ENOSPC,
+                "datastoreWriteAsync should return -ENOSPC when buffer allocation fails");
+  zassert_equal(k_msgq_num_used_get(&datastoreQueue), 0,
+                "No message should be in the datastore queue");
+}
 
-  /* Put success status in response queue */
-  ret = k_msgq_put(&responseQueue, &successStatus, K_NO_WAIT);
-  zassert_equal(ret, 0, "Failed to put success status in response queue");
+/**
+ * @test  The datastoreWriteAsync function must free the request buffer when
+ *        the datastore queue is full.
+ */
+ZTEST(datastore_tests, test_write_async_msgq_put_failure)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+  uint8_t payloadBuffer[DATASTORE_BUFFER_SIZE(1)];
+  DatastoreMsg_t dummyMsg = {0};
+  int ret;
 
-  /* Call datastoreWrite - should succeed */
-  ret = datastoreWrite(datapointType, datapointId, values, valCount, &responseQueue);
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
-  /* Verify function returned success */
-  zassert_equal(ret, 0, "datastoreWrite should return 0 on success");
+  for(int i = 0; i < DATASTORE_MSG_COUNT; i++)
+  {
+    ret = k_msgq_put(&datastoreQueue, &dummyMsg, K_NO_WAIT);
+    zassert_equal(ret, 0, "Failed to fill datastore queue");
+  }
 
-  /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  ret = datastoreWriteAsync(DATAPOINT_UINT, 0, values, 1, NULL, NULL);
 
-  /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
-  ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
-  zassert_equal(ret, 0, "Message should be in the datastore queue");
-  zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
-  zassert_equal(msg.datapointType, datapointType, "Message should have correct datapoint type");
-  zassert_equal(msg.datapointId, datapointId, "Message should have correct datapoint ID");
-  zassert_equal(msg.valCount, valCount, "Message should have correct value count");
-  zassert_equal(msg.response, &responseQueue, "Response queue should be set correctly");
+  zassert_true(ret < 0, "datastoreWriteAsync should return error when k_msgq_put fails");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once to free the buffer");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, payloadBuffer,
+                "osMemoryPoolFree should be called with the allocated buffer");
+}
 
-  /* Verify data was copied to payload */
-  zassert_within(payloadData[0].floatVal, 1.23f, 0.001f, "First value should be copied to payload");
-  zassert_within(payloadData[1].floatVal, 4.56f, 0.001f, "Second value should be copied to payload");
+/**
+ * @test  The datastoreSignalDone function must raise the poll signal passed as
+ *        user data with the request status.
+ */
+ZTEST(datastore_tests, test_signal_done)
+{
+  struct k_poll_signal signal;
 
-  /* Verify osMemoryPoolFree was NOT called (buffer ownership transferred to queue) */
-  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
-                "osMemoryPoolFree should not be called in datastoreWrite when operation succeeds with response");
+  datastoreSignalDone(-EIO, &signal);
+
+  zassert_equal(k_poll_signal_raise_mock_fake.call_count, 1,
+                "k_poll_signal_raise should be called once");
+  zassert_equal(k_poll_signal_raise_mock_fake.arg0_val, &signal,
+                "k_poll_signal_raise should be called with the user data signal");
+  zassert_equal(k_poll_signal_raise_mock_fake.arg1_val, -EIO,
+                "k_poll_signal_raise should be called with the request status");
 }
 
 /**
@@ -1698,8 +3144,8 @@ ZTEST(datastore_tests, test_subscribe_binary_failure)
                 "datastoreUtilAddBinarySub should be called once");
   zassert_equal(datastoreUtilAddBinarySub_fake.arg0_val, &sub,
                 "datastoreUtilAddBinarySub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddBinarySub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddBinarySub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddBinarySub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddBinarySub should be called with the notification pool");
 }
 
 /**
@@ -1725,8 +3171,8 @@ ZTEST(datastore_tests, test_subscribe_binary_success)
                 "datastoreUtilAddBinarySub should be called once");
   zassert_equal(datastoreUtilAddBinarySub_fake.arg0_val, &sub,
                 "datastoreUtilAddBinarySub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddBinarySub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddBinarySub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddBinarySub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddBinarySub should be called with the notification pool");
 }
 
 /**
@@ -1804,8 +3250,8 @@ ZTEST(datastore_tests, test_pause_sub_binary_failure)
                 "datastoreUtilSetBinarySubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetBinarySubPauseState should be called with true (pause)");
-  zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetBinarySubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetBinarySubPauseState should be called with the notification pool");
 }
 
 /**
@@ -1833,8 +3279,8 @@ ZTEST(datastore_tests, test_pause_sub_binary_success)
                 "datastoreUtilSetBinarySubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetBinarySubPauseState should be called with true (pause)");
-  zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetBinarySubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetBinarySubPauseState should be called with the notification pool");
 }
 
 /**
@@ -1862,8 +3308,8 @@ ZTEST(datastore_tests, test_unpause_sub_binary_failure)
                 "datastoreUtilSetBinarySubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetBinarySubPauseState should be called with false (unpause)");
-  zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetBinarySubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetBinarySubPauseState should be called with the notification pool");
 }
 
 /**
@@ -1891,8 +3337,8 @@ ZTEST(datastore_tests, test_unpause_sub_binary_success)
                 "datastoreUtilSetBinarySubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetBinarySubPauseState should be called with false (unpause)");
-  zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetBinarySubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetBinarySubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetBinarySubPauseState should be called with the notification pool");
 }
 
 /**
@@ -1958,6 +3404,34 @@ ZTEST(datastore_tests, test_read_binary_invalid_valcount)
   zassert_equal(ret, -ENOMSG, "No message should be in the datastore queue when parameter validation fails");
 }
 
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+/**
+ * @test  The datastoreReadBinary function must accept a NULL response with the direct
+ *        read, returning -EAGAIN without queueing when it collides with writes.
+ */
+ZTEST(datastore_tests, test_read_binary_null_response_collision)
+{
+  uint32_t datapointId = 16;
+  size_t valCount = 3;
+  bool values[3];
+  int ret;
+
+  /* Call datastoreReadBinary with NULL response */
+  ret = datastoreReadBinary(datapointId, valCount, NULL, values);
+
+  /* Verify the collided direct read is left to the caller */
+  zassert_equal(ret, -EAGAIN, "datastoreReadBinary should return -EAGAIN when the direct read collides");
+
+  /* Verify no buffer allocation was attempted */
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0,
+                "osMemoryPoolAlloc should not be called without a response queue");
+
+  /* Verify no message was put in the queue */
+  DatastoreMsg_t dummy;
+  ret = k_msgq_get(&datastoreQueue, &dummy, K_NO_WAIT);
+  zassert_equal(ret, -ENOMSG, "No message should be in the datastore queue without a response queue");
+}
+#else
 /**
  * @test  The datastoreReadBinary function must return -EINVAL when response
  *        parameter is NULL.
@@ -1984,6 +3458,7 @@ ZTEST(datastore_tests, test_read_binary_invalid_response)
   ret = k_msgq_get(&datastoreQueue, &dummy, K_NO_WAIT);
   zassert_equal(ret, -ENOMSG, "No message should be in the datastore queue when parameter validation fails");
 }
+#endif
 
 /**
  * @test  The datastoreReadBinary function must return an error when the
@@ -2011,8 +3486,8 @@ ZTEST(datastore_tests, test_read_binary_operation_failure)
   zassert_equal(ret, -ENOSPC, "datastoreReadBinary should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
 
   /* Verify no message was put in the queue */
   DatastoreMsg_t dummy;
@@ -2033,8 +3508,8 @@ ZTEST(datastore_tests, test_read_binary_success)
   bool *values = (bool *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -2043,7 +3518,7 @@ ZTEST(datastore_tests, test_read_binary_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -2069,7 +3544,7 @@ ZTEST(datastore_tests, test_read_binary_success)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_READ, "Message type should be DATASTORE_READ");
@@ -2177,8 +3652,8 @@ ZTEST(datastore_tests, test_write_binary_operation_failure)
   zassert_equal(ret, -ENOSPC, "datastoreWriteBinary should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
 
   /* Verify no message was put in the queue */
   DatastoreMsg_t dummy;
@@ -2199,8 +3674,8 @@ ZTEST(datastore_tests, test_write_binary_success)
   bool *values = (bool *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -2209,7 +3684,7 @@ ZTEST(datastore_tests, test_write_binary_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -2229,7 +3704,7 @@ ZTEST(datastore_tests, test_write_binary_success)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
@@ -2243,9 +3718,9 @@ ZTEST(datastore_tests, test_write_binary_success)
   zassert_equal(payloadData[1].uintVal, 0, "Second value should be 0 (false)");
   zassert_equal(payloadData[2].uintVal, 1, "Third value should be 1 (true)");
 
-  /* Verify osMemoryPoolFree was NOT called (buffer ownership transferred to queue) */
-  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
-                "osMemoryPoolFree should not be called when response is expected");
+  /* Verify the caller freed the buffer once it got the response */
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once the response is received");
 }
 
 /**
@@ -2271,8 +3746,8 @@ ZTEST(datastore_tests, test_subscribe_button_failure)
                 "datastoreUtilAddButtonSub should be called once");
   zassert_equal(datastoreUtilAddButtonSub_fake.arg0_val, &sub,
                 "datastoreUtilAddButtonSub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddButtonSub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddButtonSub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddButtonSub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddButtonSub should be called with the notification pool");
 }
 
 /**
@@ -2298,8 +3773,8 @@ ZTEST(datastore_tests, test_subscribe_button_success)
                 "datastoreUtilAddButtonSub should be called once");
   zassert_equal(datastoreUtilAddButtonSub_fake.arg0_val, &sub,
                 "datastoreUtilAddButtonSub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddButtonSub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddButtonSub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddButtonSub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddButtonSub should be called with the notification pool");
 }
 
 /**
@@ -2377,8 +3852,8 @@ ZTEST(datastore_tests, test_pause_sub_button_failure)
                 "datastoreUtilSetButtonSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetButtonSubPauseState should be called with true (pause)");
-  zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetButtonSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetButtonSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -2406,8 +3881,8 @@ ZTEST(datastore_tests, test_pause_sub_button_success)
                 "datastoreUtilSetButtonSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetButtonSubPauseState should be called with true (pause)");
-  zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetButtonSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetButtonSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -2435,8 +3910,8 @@ ZTEST(datastore_tests, test_unpause_sub_button_failure)
                 "datastoreUtilSetButtonSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetButtonSubPauseState should be called with false (unpause)");
-  zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetButtonSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetButtonSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -2464,8 +3939,8 @@ ZTEST(datastore_tests, test_unpause_sub_button_success)
                 "datastoreUtilSetButtonSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetButtonSubPauseState should be called with false (unpause)");
-  zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetButtonSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetButtonSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetButtonSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -2531,6 +4006,34 @@ ZTEST(datastore_tests, test_read_button_invalid_valcount)
   zassert_equal(ret, -ENOMSG, "No message should be in the datastore queue when parameter validation fails");
 }
 
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+/**
+ * @test  The datastoreReadButton function must accept a NULL response with the direct
+ *        read, returning -EAGAIN without queueing when it collides with writes.
+ */
+ZTEST(datastore_tests, test_read_button_null_response_collision)
+{
+  uint32_t datapointId = 50;
+  size_t valCount = 3;
+  ButtonState_t values[3];
+  int ret;
+
+  /* Call datastoreReadButton with NULL response */
+  ret = datastoreReadButton(datapointId, valCount, NULL, values);
+
+  /* Verify the collided direct read is left to the caller */
+  zassert_equal(ret, -EAGAIN, "datastoreReadButton should return -EAGAIN when the direct read collides");
+
+  /* Verify no buffer allocation was attempted */
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 0,
+                "osMemoryPoolAlloc should not be called without a response queue");
+
+  /* Verify no message was put in the queue */
+  DatastoreMsg_t dummy;
+  ret = k_msgq_get(&datastoreQueue, &dummy, K_NO_WAIT);
+  zassert_equal(ret, -ENOMSG, "No message should be in the datastore queue without a response queue");
+}
+#else
 /**
  * @test  The datastoreReadButton function must return -EINVAL when response
  *        parameter is NULL.
@@ -2557,6 +4060,7 @@ ZTEST(datastore_tests, test_read_button_invalid_response)
   ret = k_msgq_get(&datastoreQueue, &dummy, K_NO_WAIT);
   zassert_equal(ret, -ENOMSG, "No message should be in the datastore queue when parameter validation fails");
 }
+#endif
 
 /**
  * @test  The datastoreReadButton function must return an error when the
@@ -2584,8 +4088,8 @@ ZTEST(datastore_tests, test_read_button_operation_failure)
   zassert_equal(ret, -ENOSPC, "datastoreReadButton should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
 
   /* Verify no message was put in the queue */
   DatastoreMsg_t dummy;
@@ -2606,8 +4110,8 @@ ZTEST(datastore_tests, test_read_button_success)
   ButtonState_t *values = (ButtonState_t *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -2616,7 +4120,7 @@ ZTEST(datastore_tests, test_read_button_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -2642,7 +4146,7 @@ ZTEST(datastore_tests, test_read_button_success)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_READ, "Message type should be DATASTORE_READ");
@@ -2750,8 +4254,8 @@ ZTEST(datastore_tests, test_write_button_operation_failure)
   zassert_equal(ret, -ENOSPC, "datastoreWriteButton should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
 
   /* Verify no message was put in the queue */
   DatastoreMsg_t dummy;
@@ -2772,8 +4276,8 @@ ZTEST(datastore_tests, test_write_button_success)
   ButtonState_t *values = (ButtonState_t *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -2782,7 +4286,7 @@ ZTEST(datastore_tests, test_write_button_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -2802,7 +4306,7 @@ ZTEST(datastore_tests, test_write_button_success)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
@@ -2816,9 +4320,9 @@ ZTEST(datastore_tests, test_write_button_success)
   zassert_equal(payloadData[1].uintVal, BUTTON_UNPRESSED, "Second value should be BUTTON_UNPRESSED");
   zassert_equal(payloadData[2].uintVal, BUTTON_LONG_PRESSED, "Third value should be BUTTON_LONG_PRESSED");
 
-  /* Verify osMemoryPoolFree was NOT called (buffer ownership transferred to queue) */
-  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
-                "osMemoryPoolFree should not be called when response is expected");
+  /* Verify the caller freed the buffer once it got the response */
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "osMemoryPoolFree should be called once the response is received");
 }
 
 /**
@@ -2844,8 +4348,8 @@ ZTEST(datastore_tests, test_subscribe_float_failure)
                 "datastoreUtilAddFloatSub should be called once");
   zassert_equal(datastoreUtilAddFloatSub_fake.arg0_val, &sub,
                 "datastoreUtilAddFloatSub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddFloatSub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddFloatSub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddFloatSub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddFloatSub should be called with the notification pool");
 }
 
 /**
@@ -2871,8 +4375,8 @@ ZTEST(datastore_tests, test_subscribe_float_success)
                 "datastoreUtilAddFloatSub should be called once");
   zassert_equal(datastoreUtilAddFloatSub_fake.arg0_val, &sub,
                 "datastoreUtilAddFloatSub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddFloatSub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddFloatSub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddFloatSub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddFloatSub should be called with the notification pool");
 }
 
 /**
@@ -2950,8 +4454,8 @@ ZTEST(datastore_tests, test_pause_sub_float_failure)
                 "datastoreUtilSetFloatSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetFloatSubPauseState should be called with true for pause state");
-  zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetFloatSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetFloatSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -2979,8 +4483,8 @@ ZTEST(datastore_tests, test_pause_sub_float_success)
                 "datastoreUtilSetFloatSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetFloatSubPauseState should be called with true for pause state");
-  zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetFloatSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetFloatSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -3008,8 +4512,8 @@ ZTEST(datastore_tests, test_unpause_sub_float_failure)
                 "datastoreUtilSetFloatSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetFloatSubPauseState should be called with false for unpause state");
-  zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetFloatSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetFloatSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -3037,8 +4541,8 @@ ZTEST(datastore_tests, test_unpause_sub_float_success)
                 "datastoreUtilSetFloatSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetFloatSubPauseState should be called with false for unpause state");
-  zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetFloatSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetFloatSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetFloatSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -3086,6 +4590,26 @@ ZTEST(datastore_tests, test_read_float_invalid_valcount)
   zassert_equal(ret, -EINVAL, "datastoreReadFloat should return -EINVAL when valCount is 0");
 }
 
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+/**
+ * @test  The datastoreReadFloat function must accept a NULL response with the direct
+ *        read, returning -EAGAIN without queueing when it collides with writes.
+ */
+ZTEST(datastore_tests, test_read_float_null_response_collision)
+{
+  uint32_t datapointId = 1;
+  size_t valCount = 3;
+  Data_t valueStorage[3];
+  float *values = (float *)valueStorage;
+  int ret;
+
+  /* Call datastoreReadFloat with NULL response */
+  ret = datastoreReadFloat(datapointId, valCount, NULL, values);
+
+  /* Verify the collided direct read is left to the caller */
+  zassert_equal(ret, -EAGAIN, "datastoreReadFloat should return -EAGAIN when the direct read collides");
+}
+#else
 /**
  * @test  The datastoreReadFloat function must return an error when the response
  *        parameter is NULL.
@@ -3104,6 +4628,7 @@ ZTEST(datastore_tests, test_read_float_invalid_response)
   /* Verify function returned -EINVAL */
   zassert_equal(ret, -EINVAL, "datastoreReadFloat should return -EINVAL when response is NULL");
 }
+#endif
 
 /**
  * @test  The datastoreReadFloat function must return an error when the
@@ -3132,8 +4657,8 @@ ZTEST(datastore_tests, test_read_float_operation_failure)
   zassert_equal(ret, -ENOSPC, "datastoreReadFloat should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
 }
 
 /**
@@ -3149,8 +4674,8 @@ ZTEST(datastore_tests, test_read_float_success)
   float *values = (float *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -3159,7 +4684,7 @@ ZTEST(datastore_tests, test_read_float_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -3259,8 +4784,8 @@ ZTEST(datastore_tests, test_write_float_operation_failure)
   zassert_equal(ret, -ENOSPC, "datastoreWriteFloat should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
 }
 
 /**
@@ -3276,8 +4801,8 @@ ZTEST(datastore_tests, test_write_float_success)
   float *values = (float *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -3286,7 +4811,7 @@ ZTEST(datastore_tests, test_write_float_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -3306,7 +4831,7 @@ ZTEST(datastore_tests, test_write_float_success)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
@@ -3346,8 +4871,8 @@ ZTEST(datastore_tests, test_subscribe_int_failure)
                 "datastoreUtilAddIntSub should be called once");
   zassert_equal(datastoreUtilAddIntSub_fake.arg0_val, &subEntry,
                 "datastoreUtilAddIntSub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddIntSub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddIntSub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddIntSub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddIntSub should be called with the notification pool");
 }
 
 /**
@@ -3375,8 +4900,8 @@ ZTEST(datastore_tests, test_subscribe_int_success)
                 "datastoreUtilAddIntSub should be called once");
   zassert_equal(datastoreUtilAddIntSub_fake.arg0_val, &subEntry,
                 "datastoreUtilAddIntSub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddIntSub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddIntSub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddIntSub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddIntSub should be called with the notification pool");
 }
 
 /**
@@ -3454,8 +4979,8 @@ ZTEST(datastore_tests, test_pause_sub_int_failure)
                 "datastoreUtilSetIntSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetIntSubPauseState should be called with true for pause state");
-  zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetIntSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetIntSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -3483,8 +5008,8 @@ ZTEST(datastore_tests, test_pause_sub_int_success)
                 "datastoreUtilSetIntSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetIntSubPauseState should be called with true for pause state");
-  zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetIntSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetIntSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -3512,8 +5037,8 @@ ZTEST(datastore_tests, test_unpause_sub_int_failure)
                 "datastoreUtilSetIntSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetIntSubPauseState should be called with false for unpause state");
-  zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetIntSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetIntSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -3541,8 +5066,8 @@ ZTEST(datastore_tests, test_unpause_sub_int_success)
                 "datastoreUtilSetIntSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetIntSubPauseState should be called with false for unpause state");
-  zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetIntSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetIntSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetIntSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -3590,6 +5115,26 @@ ZTEST(datastore_tests, test_read_int_invalid_valcount)
   zassert_equal(ret, -EINVAL, "datastoreReadInt should return -EINVAL when valCount is 0");
 }
 
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+/**
+ * @test  The datastoreReadInt function must accept a NULL response with the direct
+ *        read, returning -EAGAIN without queueing when it collides with writes.
+ */
+ZTEST(datastore_tests, test_read_int_null_response_collision)
+{
+  uint32_t datapointId = 1;
+  size_t valCount = 3;
+  Data_t valueStorage[3];
+  int32_t *values = (int32_t *)valueStorage;
+  int ret;
+
+  /* Call datastoreReadInt with NULL response */
+  ret = datastoreReadInt(datapointId, valCount, NULL, values);
+
+  /* Verify the collided direct read is left to the caller */
+  zassert_equal(ret, -EAGAIN, "datastoreReadInt should return -EAGAIN when the direct read collides");
+}
+#else
 /**
  * @test  The datastoreReadInt function must return an error when the response
  *        parameter is NULL.
@@ -3608,6 +5153,7 @@ ZTEST(datastore_tests, test_read_int_invalid_response)
   /* Verify function returned -EINVAL */
   zassert_equal(ret, -EINVAL, "datastoreReadInt should return -EINVAL when response is NULL");
 }
+#endif
 
 /**
  * @test  The datastoreReadInt function must return an error when the
@@ -3636,8 +5182,8 @@ ZTEST(datastore_tests, test_read_int_operation_failure)
   zassert_equal(ret, -ENOSPC, "datastoreReadInt should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
 }
 
 /**
@@ -3653,8 +5199,8 @@ ZTEST(datastore_tests, test_read_int_success)
   int32_t *values = (int32_t *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -3663,7 +5209,7 @@ ZTEST(datastore_tests, test_read_int_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -3763,8 +5309,8 @@ ZTEST(datastore_tests, test_write_int_operation_failure)
   zassert_equal(ret, -ENOSPC, "datastoreWriteInt should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
 }
 
 /**
@@ -3780,8 +5326,8 @@ ZTEST(datastore_tests, test_write_int_success)
   int32_t *values = (int32_t *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -3790,7 +5336,7 @@ ZTEST(datastore_tests, test_write_int_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -3810,7 +5356,7 @@ ZTEST(datastore_tests, test_write_int_success)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
@@ -3850,8 +5396,8 @@ ZTEST(datastore_tests, test_subscribe_multi_state_failure)
                 "datastoreUtilAddMultiStateSub should be called once");
   zassert_equal(datastoreUtilAddMultiStateSub_fake.arg0_val, &subEntry,
                 "datastoreUtilAddMultiStateSub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddMultiStateSub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddMultiStateSub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddMultiStateSub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddMultiStateSub should be called with the notification pool");
 }
 
 /**
@@ -3879,8 +5425,8 @@ ZTEST(datastore_tests, test_subscribe_multi_state_success)
                 "datastoreUtilAddMultiStateSub should be called once");
   zassert_equal(datastoreUtilAddMultiStateSub_fake.arg0_val, &subEntry,
                 "datastoreUtilAddMultiStateSub should be called with the subscription entry");
-  zassert_equal(datastoreUtilAddMultiStateSub_fake.arg1_val, bufferPool,
-                "datastoreUtilAddMultiStateSub should be called with bufferPool");
+  zassert_equal(datastoreUtilAddMultiStateSub_fake.arg1_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilAddMultiStateSub should be called with the notification pool");
 }
 
 /**
@@ -3958,8 +5504,8 @@ ZTEST(datastore_tests, test_pause_sub_multi_state_failure)
                 "datastoreUtilSetMultiStateSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetMultiStateSubPauseState should be called with true for pause state");
-  zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetMultiStateSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetMultiStateSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -3987,8 +5533,8 @@ ZTEST(datastore_tests, test_pause_sub_multi_state_success)
                 "datastoreUtilSetMultiStateSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg1_val, true,
                 "datastoreUtilSetMultiStateSubPauseState should be called with true for pause state");
-  zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetMultiStateSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetMultiStateSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -4016,8 +5562,8 @@ ZTEST(datastore_tests, test_unpause_sub_multi_state_failure)
                 "datastoreUtilSetMultiStateSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetMultiStateSubPauseState should be called with false for unpause state");
-  zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetMultiStateSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetMultiStateSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -4045,8 +5591,8 @@ ZTEST(datastore_tests, test_unpause_sub_multi_state_success)
                 "datastoreUtilSetMultiStateSubPauseState should be called with the callback");
   zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg1_val, false,
                 "datastoreUtilSetMultiStateSubPauseState should be called with false for unpause state");
-  zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg2_val, bufferPool,
-                "datastoreUtilSetMultiStateSubPauseState should be called with bufferPool");
+  zassert_equal(datastoreUtilSetMultiStateSubPauseState_fake.arg2_val, DATASTORE_NOTIFY_POOL,
+                "datastoreUtilSetMultiStateSubPauseState should be called with the notification pool");
 }
 
 /**
@@ -4094,6 +5640,26 @@ ZTEST(datastore_tests, test_read_multi_state_invalid_valcount)
   zassert_equal(ret, -EINVAL, "datastoreReadMultiState should return -EINVAL when valCount is 0");
 }
 
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+/**
+ * @test  The datastoreReadMultiState function must accept a NULL response with the direct
+ *        read, returning -EAGAIN without queueing when it collides with writes.
+ */
+ZTEST(datastore_tests, test_read_multi_state_null_response_collision)
+{
+  uint32_t datapointId = 1;
+  size_t valCount = 3;
+  Data_t valueStorage[3];
+  uint32_t *values = (uint32_t *)valueStorage;
+  int ret;
+
+  /* Call datastoreReadMultiState with NULL response */
+  ret = datastoreReadMultiState(datapointId, valCount, NULL, values);
+
+  /* Verify the collided direct read is left to the caller */
+  zassert_equal(ret, -EAGAIN, "datastoreReadMultiState should return -EAGAIN when the direct read collides");
+}
+#else
 /**
  * @test  The datastoreReadMultiState function must return an error when the response
  *        parameter is NULL.
@@ -4112,6 +5678,7 @@ ZTEST(datastore_tests, test_read_multi_state_invalid_response)
   /* Verify function returned -EINVAL */
   zassert_equal(ret, -EINVAL, "datastoreReadMultiState should return -EINVAL when response is NULL");
 }
+#endif
 
 /**
  * @test  The datastoreReadMultiState function must return an error when the
@@ -4140,8 +5707,8 @@ ZTEST(datastore_tests, test_read_multi_state_operation_failure)
   zassert_equal(ret, -ENOSPC, "datastoreReadMultiState should return -ENOSPC when buffer allocation fails");
 
   /* Verify osMemoryPoolAlloc was called */
-  zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
-                "osMemoryPoolAlloc should be called once");
+  zassert_equal(osMemoryPoolAlloc_fake.call_count, 3,
+                "osMemoryPoolAlloc should try each request pool");
 }
 
 /**
@@ -4157,8 +5724,8 @@ ZTEST(datastore_tests, test_read_multi_state_success)
   uint32_t *values = (uint32_t *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -4167,7 +5734,7 @@ ZTEST(datastore_tests, test_read_multi_state_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -4295,8 +5862,8 @@ ZTEST(datastore_tests, test_write_multi_state_success)
   uint32_t *values = (uint32_t *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -4305,7 +5872,7 @@ ZTEST(datastore_tests, test_write_multi_state_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -4325,7 +5892,7 @@ ZTEST(datastore_tests, test_write_multi_state_success)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
@@ -4585,6 +6152,26 @@ ZTEST(datastore_tests, test_read_uint_invalid_valcount)
   zassert_equal(ret, -EINVAL, "datastoreReadUint should return -EINVAL when valCount is 0");
 }
 
+#ifdef CONFIG_ENYA_DATASTORE_DIRECT_READ
+/**
+ * @test  The datastoreReadUint function must accept a NULL response with the direct
+ *        read, returning -EAGAIN without queueing when it collides with writes.
+ */
+ZTEST(datastore_tests, test_read_uint_null_response_collision)
+{
+  uint32_t datapointId = 1;
+  size_t valCount = 3;
+  Data_t valueStorage[3];
+  uint32_t *values = (uint32_t *)valueStorage;
+  int ret;
+
+  /* Call datastoreReadUint with NULL response */
+  ret = datastoreReadUint(datapointId, valCount, NULL, values);
+
+  /* Verify the collided direct read is left to the caller */
+  zassert_equal(ret, -EAGAIN, "datastoreReadUint should return -EAGAIN when the direct read collides");
+}
+#else
 /**
  * @test  The datastoreReadUint function must return an error when
  *        the response parameter is NULL.
@@ -4603,6 +6190,7 @@ ZTEST(datastore_tests, test_read_uint_invalid_response)
   /* Verify function returned -EINVAL */
   zassert_equal(ret, -EINVAL, "datastoreReadUint should return -EINVAL when response is NULL");
 }
+#endif
 
 /**
  * @test  The datastoreReadUint function must return an error when
@@ -4644,8 +6232,8 @@ ZTEST(datastore_tests, test_read_uint_success)
   uint32_t *values = (uint32_t *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -4654,7 +6242,7 @@ ZTEST(datastore_tests, test_read_uint_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -4770,8 +6358,8 @@ ZTEST(datastore_tests, test_write_uint_success)
   uint32_t *values = (uint32_t *)valueStorage;
   struct k_msgq responseQueue;
   char __aligned(4) responseBuffer[sizeof(int)];
-  uint8_t payloadBuffer[sizeof(SrvMsgPayload_t) + (valCount * sizeof(Data_t))];
-  SrvMsgPayload_t *mockPayload = (SrvMsgPayload_t *)payloadBuffer;
+  uint8_t payloadBuffer[sizeof(DatastoreRequestBuffer_t) + (valCount * sizeof(Data_t))];
+  SrvMsgPayload_t *mockPayload = &((DatastoreRequestBuffer_t *)payloadBuffer)->payload;
   Data_t *payloadData = (Data_t *)mockPayload->data;
   int ret;
   int successStatus = 0;
@@ -4780,7 +6368,7 @@ ZTEST(datastore_tests, test_write_uint_success)
   k_msgq_init(&responseQueue, responseBuffer, sizeof(int), 1);
 
   /* Configure buffer allocation to succeed */
-  osMemoryPoolAlloc_fake.return_val = mockPayload;
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
 
   /* Configure osMemoryPoolFree to succeed */
   osMemoryPoolFree_fake.return_val = osOK;
@@ -4800,7 +6388,7 @@ ZTEST(datastore_tests, test_write_uint_success)
                 "osMemoryPoolAlloc should be called once");
 
   /* Verify message was put in the datastore queue */
-  DatastoreMsg_t msg;
+  DatastoreMsg_t msg = {0};
   ret = k_msgq_get(&datastoreQueue, &msg, K_NO_WAIT);
   zassert_equal(ret, 0, "Message should be in the datastore queue");
   zassert_equal(msg.msgType, DATASTORE_WRITE, "Message type should be DATASTORE_WRITE");
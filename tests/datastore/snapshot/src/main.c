@@ -0,0 +1,341 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Datastore Snapshot Tests
+ *
+ *            Unit tests for the datastore snapshot.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_SNAPSHOT 1
+#define CONFIG_ENYA_DATASTORE_SNAPSHOT_CHUNK_VALUES 2
+
+#include "datastore.h"
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(datastoreRead) \
+  FAKE(datastoreWrite)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Mock datastore functions */
+FAKE_VALUE_FUNC(int, datastoreRead, DatapointType_t, uint32_t, size_t, struct k_msgq *, Data_t *);
+FAKE_VALUE_FUNC(int, datastoreWrite, DatapointType_t, uint32_t, Data_t *, size_t, struct k_msgq *);
+
+/* Include snapshot implementation */
+#include "datastoreSnapshot.c"
+
+/**
+ * The test response queue.
+ */
+#define TEST_RESPONSE                   ((struct k_msgq *)0x1000)
+
+/**
+ * The test snapshot length.
+ */
+#define TEST_SNAPSHOT_LEN               (DATASTORE_SNAPSHOT_HEADER_LEN + 5 + 8 * 4)
+
+/**
+ * The test datapoint storage, in type order.
+ */
+static Data_t storage[ARRAY_SIZE(datapointNames)];
+
+/**
+ * The test snapshot stream.
+ */
+static uint8_t stream[128];
+static size_t streamLen;
+static size_t streamCursor;
+
+/**
+ * @brief Custom fake for datastoreRead reading the test storage.
+ */
+static int datastoreRead_storage(DatapointType_t type, uint32_t datapointId, size_t valCount,
+                                 struct k_msgq *response, Data_t values[])
+{
+  ARG_UNUSED(response);
+
+  memcpy(values, storage + getNameOffset(type) + datapointId, valCount * sizeof(Data_t));
+  return 0;
+}
+
+/**
+ * @brief Custom fake for datastoreWrite writing the test storage.
+ */
+static int datastoreWrite_storage(DatapointType_t type, uint32_t datapointId, Data_t values[], size_t valCount,
+                                  struct k_msgq *response)
+{
+  ARG_UNUSED(response);
+
+  memcpy(storage + getNameOffset(type) + datapointId, values, valCount * sizeof(Data_t));
+  return 0;
+}
+
+/**
+ * @brief Append a snapshot chunk to the test stream.
+ */
+static int writeStream(void *cbArg, const uint8_t *data, size_t len)
+{
+  ARG_UNUSED(cbArg);
+
+  if(streamLen + len > sizeof(stream))
+    return -ENOSPC;
+
+  memcpy(stream + streamLen, data, len);
+  streamLen += len;
+  return 0;
+}
+
+/**
+ * @brief Consume a snapshot chunk from the test stream.
+ */
+static int readStream(void *cbArg, uint8_t *data, size_t len)
+{
+  ARG_UNUSED(cbArg);
+
+  if(streamCursor + len > streamLen)
+    return -ENODATA;
+
+  memcpy(data, stream + streamCursor, len);
+  streamCursor += len;
+  return 0;
+}
+
+/**
+ * @brief Fill the test storage with distinct values.
+ */
+static void fillStorage(void)
+{
+  size_t offset;
+
+  for(uint32_t type = 0; type < DATAPOINT_TYPE_COUNT; ++type)
+  {
+    offset = getNameOffset(type);
+    for(size_t i = 0; i < datapointCounts[type]; ++i)
+    {
+      switch(type)
+      {
+        case DATAPOINT_BINARY:
+          storage[offset + i].uintVal = i % 2 == 0;
+          break;
+        case DATAPOINT_BUTTON:
+          storage[offset + i].uintVal = BUTTON_SHORT_PRESSED + i;
+          break;
+        case DATAPOINT_FLOAT:
+          storage[offset + i].floatVal = -1.5f * (i + 1);
+          break;
+        case DATAPOINT_INT:
+          storage[offset + i].intVal = -100000 * (int32_t)(i + 1);
+          break;
+        default:
+          storage[offset + i].uintVal = 0xdeadbeef + i;
+          break;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Restore the type table hash of the test stream header.
+ */
+static void rehashStreamHeader(void)
+{
+  sys_put_le32(hashBytes(FNV_OFFSET_BASIS, stream + HEADER_TYPE_TABLE_OFFSET,
+                         DATASTORE_SNAPSHOT_HEADER_LEN - HEADER_TYPE_TABLE_OFFSET), stream + 8);
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void snapshot_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  datastoreRead_fake.custom_fake = datastoreRead_storage;
+  datastoreWrite_fake.custom_fake = datastoreWrite_storage;
+
+  memset(storage, 0, sizeof(storage));
+  memset(stream, 0, sizeof(stream));
+  streamLen = 0;
+  streamCursor = 0;
+}
+
+/**
+ * @test datastoreSnapshotSave must stream the header and the packed value blocks.
+ */
+ZTEST(datastore_snapshot_tests, test_save_format)
+{
+  fillStorage();
+
+  zassert_equal(datastoreSnapshotSave(writeStream, NULL, TEST_RESPONSE), 0, "The save should succeed");
+
+  zassert_equal(streamLen, TEST_SNAPSHOT_LEN, "The values should be packed");
+  zassert_equal(datastoreSnapshotGetSize(), TEST_SNAPSHOT_LEN, "The snapshot size should match the stream");
+  zassert_equal(sys_get_le32(stream), DATASTORE_SNAPSHOT_MAGIC, "The header should start with the magic");
+  zassert_equal(sys_get_le16(stream + 4), DATASTORE_SNAPSHOT_VERSION, "The header should hold the version");
+  zassert_equal(sys_get_le32(stream + 8), datastoreSnapshotGetSchemaHash(), "The header should hold the schema");
+  zassert_equal(sys_get_le32(stream + HEADER_TYPE_TABLE_OFFSET), BINARY_DATAPOINT_COUNT,
+                "The type table should hold the datapoint counts");
+
+  /* The binaries are first, then the buttons */
+  zassert_equal(stream[DATASTORE_SNAPSHOT_HEADER_LEN + 1], 0, "The binaries should take 1 byte");
+  zassert_equal(stream[DATASTORE_SNAPSHOT_HEADER_LEN + 3], BUTTON_SHORT_PRESSED, "The buttons should take 1 byte");
+  zassert_equal(sys_get_le32(stream + DATASTORE_SNAPSHOT_HEADER_LEN + 5), storage[5].uintVal,
+                "The floats should take 4 bytes");
+
+  /* The 3 binaries need 2 chunks */
+  zassert_equal(datastoreRead_fake.call_count, DATAPOINT_TYPE_COUNT + 1, "The values should be read in chunks");
+  zassert_equal(datastoreRead_fake.arg2_history[1], 1, "The last chunk should hold the remaining values");
+}
+
+/**
+ * @test datastoreSnapshotRestore must restore the values of a saved snapshot.
+ */
+ZTEST(datastore_snapshot_tests, test_restore_roundTrip)
+{
+  Data_t expected[ARRAY_SIZE(storage)];
+
+  fillStorage();
+  memcpy(expected, storage, sizeof(expected));
+  datastoreSnapshotSave(writeStream, NULL, TEST_RESPONSE);
+  memset(storage, 0, sizeof(storage));
+
+  zassert_equal(datastoreSnapshotRestore(readStream, NULL, TEST_RESPONSE), 0, "The restore should succeed");
+
+  zassert_mem_equal(storage, expected, sizeof(storage), "The values should be restored");
+  zassert_equal(streamCursor, streamLen, "The whole snapshot should be consumed");
+  zassert_equal(datastoreWrite_fake.call_count, DATAPOINT_TYPE_COUNT + 1, "The values should be written in chunks");
+}
+
+/**
+ * @test datastoreSnapshotRestore must reject a malformed snapshot before any write.
+ */
+ZTEST(datastore_snapshot_tests, test_restore_malformed)
+{
+  datastoreSnapshotSave(writeStream, NULL, TEST_RESPONSE);
+  stream[0] ^= 0xff;
+
+  zassert_equal(datastoreSnapshotRestore(readStream, NULL, TEST_RESPONSE), -EBADMSG,
+                "A wrong magic should return -EBADMSG");
+
+  stream[0] ^= 0xff;
+  stream[HEADER_TYPE_TABLE_OFFSET] ^= 0x01;
+  streamCursor = 0;
+
+  zassert_equal(datastoreSnapshotRestore(readStream, NULL, TEST_RESPONSE), -EBADMSG,
+                "A corrupted type table should return -EBADMSG");
+
+  streamLen = DATASTORE_SNAPSHOT_HEADER_LEN - 1;
+  streamCursor = 0;
+
+  zassert_equal(datastoreSnapshotRestore(readStream, NULL, TEST_RESPONSE), -ENODATA,
+                "A truncated header should return the read error");
+  zassert_equal(datastoreWrite_fake.call_count, 0, "Nothing should be written");
+}
+
+/**
+ * @test datastoreSnapshotRestore must reject a snapshot of another schema before any write.
+ */
+ZTEST(datastore_snapshot_tests, test_restore_schemaMismatch)
+{
+  datastoreSnapshotSave(writeStream, NULL, TEST_RESPONSE);
+
+  /* A renamed float datapoint */
+  sys_put_le32(hashBytes(hashTypeNames(DATAPOINT_FLOAT, 1), (const uint8_t *)"RENAMED", sizeof("RENAMED")),
+               stream + HEADER_TYPE_TABLE_OFFSET + DATAPOINT_FLOAT * 8 + 4);
+  rehashStreamHeader();
+
+  zassert_equal(datastoreSnapshotRestore(readStream, NULL, TEST_RESPONSE), -EPROTO,
+                "A renamed datapoint should return -EPROTO");
+
+  /* A removed float datapoint */
+  streamLen = 0;
+  streamCursor = 0;
+  datastoreSnapshotSave(writeStream, NULL, TEST_RESPONSE);
+  sys_put_le32(FLOAT_DATAPOINT_COUNT + 1, stream + HEADER_TYPE_TABLE_OFFSET + DATAPOINT_FLOAT * 8);
+  rehashStreamHeader();
+
+  zassert_equal(datastoreSnapshotRestore(readStream, NULL, TEST_RESPONSE), -EPROTO,
+                "A removed datapoint should return -EPROTO");
+  zassert_equal(datastoreWrite_fake.call_count, 0, "Nothing should be written");
+}
+
+/**
+ * @test datastoreSnapshotRestore must migrate a snapshot missing the appended datapoints.
+ */
+ZTEST(datastore_snapshot_tests, test_restore_migrate)
+{
+  fillStorage();
+  datastoreSnapshotSave(writeStream, NULL, TEST_RESPONSE);
+
+  /* Drop BINARY_THIRD_DATAPOINT, as if appended after the snapshot */
+  memmove(stream + DATASTORE_SNAPSHOT_HEADER_LEN + 2, stream + DATASTORE_SNAPSHOT_HEADER_LEN + 3,
+          TEST_SNAPSHOT_LEN - DATASTORE_SNAPSHOT_HEADER_LEN - 3);
+  --streamLen;
+  sys_put_le32(2, stream + HEADER_TYPE_TABLE_OFFSET);
+  sys_put_le32(hashTypeNames(DATAPOINT_BINARY, 2), stream + HEADER_TYPE_TABLE_OFFSET + 4);
+  rehashStreamHeader();
+
+  memset(storage, 0, sizeof(storage));
+  storage[BINARY_THIRD_DATAPOINT].uintVal = 1;
+
+  zassert_equal(datastoreSnapshotRestore(readStream, NULL, TEST_RESPONSE), 0, "The migration should succeed");
+
+  zassert_equal(storage[BINARY_FIRST_DATAPOINT].uintVal, 1, "The snapshot datapoints should be restored");
+  zassert_equal(storage[getNameOffset(DATAPOINT_UINT) + UINT_SECOND_DATAPOINT].uintVal, 0xdeadbeef + 1,
+                "The following types should be restored");
+  zassert_equal(storage[BINARY_THIRD_DATAPOINT].uintVal, 1, "The appended datapoint should keep its value");
+  zassert_equal(streamCursor, streamLen, "The whole snapshot should be consumed");
+}
+
+/**
+ * @test datastoreSnapshotSave and datastoreSnapshotRestore must stop on a datastore or stream error.
+ */
+ZTEST(datastore_snapshot_tests, test_errors)
+{
+  zassert_equal(datastoreSnapshotSave(NULL, NULL, TEST_RESPONSE), -EINVAL, "A missing callback should fail");
+  zassert_equal(datastoreSnapshotRestore(readStream, NULL, NULL), -EINVAL, "A missing response should fail");
+
+  datastoreRead_fake.custom_fake = NULL;
+  datastoreRead_fake.return_val = -EAGAIN;
+
+  zassert_equal(datastoreSnapshotSave(writeStream, NULL, TEST_RESPONSE), -EAGAIN, "A read error should fail");
+  zassert_equal(streamLen, DATASTORE_SNAPSHOT_HEADER_LEN, "The save should stop at the failed read");
+
+  datastoreRead_fake.custom_fake = datastoreRead_storage;
+  streamLen = 0;
+  datastoreSnapshotSave(writeStream, NULL, TEST_RESPONSE);
+  streamLen -= 1;
+
+  zassert_equal(datastoreSnapshotRestore(readStream, NULL, TEST_RESPONSE), -ENODATA,
+                "A truncated block should return the read error");
+  zassert_equal(datastoreWrite_fake.call_count, DATAPOINT_TYPE_COUNT,
+                "The restore should stop at the truncated chunk");
+}
+
+ZTEST_SUITE(datastore_snapshot_tests, NULL, NULL, snapshot_tests_before, NULL, NULL);
@@ -0,0 +1,338 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-03-09
+ * @brief     Datastore Subscription Index Tests
+ *
+ *            Unit tests for the datastore subscription index.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock osMemoryPool type */
+typedef void *osMemoryPoolId_t;
+
+/* Prevent CMSIS OS2 header */
+#define CMSIS_OS2_H_
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_SUB_INDEX 1
+#define CONFIG_ENYA_DATASTORE_BATCH 1
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS 4
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES 8
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(osMemoryPoolAlloc) \
+  FAKE(osMemoryPoolFree) \
+  FAKE(k_malloc) \
+  FAKE(k_free) \
+  FAKE(mock_subscription_callback) \
+  FAKE(mock_other_subscription_callback)
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(datastore, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Redefine LOG_ERR to avoid dereferencing invalid pointers in error messages */
+#undef LOG_ERR
+#define LOG_ERR(...) do {} while (0)
+
+/* Mock osMemoryPool functions */
+FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
+FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+/* Mock kernel functions */
+FAKE_VALUE_FUNC(void *, k_malloc, size_t);
+FAKE_VOID_FUNC(k_free, void *);
+
+/* Include utility implementation - this will define SrvMsgPayload_t */
+#include "datastoreUtil.c"
+
+/* Mock subscription callbacks - SrvMsgPayload_t is now defined */
+FAKE_VALUE_FUNC(int, mock_subscription_callback, SrvMsgPayload_t *, size_t);
+FAKE_VALUE_FUNC(int, mock_other_subscription_callback, SrvMsgPayload_t *, size_t);
+
+/**
+ * The test pool.
+ */
+#define TEST_POOL                       ((osMemoryPoolId_t)0x1000)
+
+/**
+ * The test subscription entries.
+ */
+static DatastoreSubEntry_t binaryEntries[4];
+static DatastoreSubEntry_t uintEntries[4];
+
+/**
+ * The test notification payload buffer.
+ */
+static uint8_t payloadBuffer[256];
+
+/**
+ * Add a subscription through the utility add function.
+ */
+static void addIndexedSub(DatapointType_t type, uint32_t datapointId, size_t valCount, DatastoreSubCb_t callback)
+{
+  DatastoreSubEntry_t sub = {
+    .datapointId = datapointId,
+    .valCount = valCount,
+    .isPaused = false,
+    .callback = callback,
+  };
+
+  if(type == DATAPOINT_BINARY)
+    zassert_equal(datastoreUtilAddBinarySub(&sub, TEST_POOL), 0, "Should add the binary subscription");
+  else
+    zassert_equal(datastoreUtilAddUintSub(&sub, TEST_POOL), 0, "Should add the uint subscription");
+}
+
+/**
+ * Pack a batch write operation in a batch buffer.
+ */
+static void packBatchWrite(Data_t buffer[], size_t *cursor, DatapointType_t type, uint32_t datapointId,
+                           size_t valCount, Data_t values[])
+{
+  DatastoreBatchOpHeader_t header = {
+    .opType = DATASTORE_BATCH_WRITE,
+    .datapointType = type,
+    .valCount = valCount,
+    .datapointId = datapointId,
+  };
+
+  memcpy(buffer + *cursor, &header, sizeof(header));
+  *cursor += DATASTORE_BATCH_OP_HEADER_LEN;
+  memcpy(buffer + *cursor, values, valCount * sizeof(Data_t));
+  *cursor += valCount;
+}
+
+/**
+ * Test setup function.
+ */
+static void *sub_index_tests_setup(void)
+{
+  return NULL;
+}
+
+/**
+ * Test before function.
+ */
+static void sub_index_tests_before(void *fixture)
+{
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(binaryEntries, 0, sizeof(binaryEntries));
+  memset(uintEntries, 0, sizeof(uintEntries));
+
+  binarySubs = (struct DatastoreSubs){.entries = binaryEntries, .maxCount = 4, .activeCount = 0};
+  uintSubs = (struct DatastoreSubs){.entries = uintEntries, .maxCount = 4, .activeCount = 0};
+
+  for(size_t i = 0; i < DATAPOINT_TYPE_COUNT; ++i)
+    memset(subIndexes[i], 0, datapointCounts[i] * sizeof(uint64_t));
+
+  for(size_t i = 0; i < BINARY_DATAPOINT_COUNT; ++i)
+    binaries[i].value.uintVal = 0;
+
+  for(size_t i = 0; i < UINT_DATAPOINT_COUNT; ++i)
+    uints[i].value.uintVal = 0;
+
+  osMemoryPoolAlloc_fake.return_val = payloadBuffer;
+}
+
+/**
+ * @test The add subscription functions must index the subscription slot on
+ * every datapoint of its range.
+ */
+ZTEST(datastore_sub_index_tests, test_add_sub_indexes_range)
+{
+  addIndexedSub(DATAPOINT_BINARY, 0, 2, mock_subscription_callback);
+  addIndexedSub(DATAPOINT_BINARY, 1, 2, mock_other_subscription_callback);
+
+  zassert_equal(binarySubIndex[0], BIT64(0), "Datapoint 0 should only be covered by slot 0");
+  zassert_equal(binarySubIndex[1], BIT64(0) | BIT64(1), "Datapoint 1 should be covered by both slots");
+  zassert_equal(binarySubIndex[2], BIT64(1), "Datapoint 2 should only be covered by slot 1");
+}
+
+/**
+ * @test The add subscription functions must not index the datapoints out of
+ * the datapoint range.
+ */
+ZTEST(datastore_sub_index_tests, test_add_sub_out_of_range_not_indexed)
+{
+  DatastoreSubEntry_t sub = {
+    .datapointId = UINT_DATAPOINT_COUNT - 1,
+    .valCount = 4,
+    .callback = mock_subscription_callback,
+  };
+
+  /* Only index, the initial notification would read out of range */
+  uintSubs.entries[0] = sub;
+  uintSubs.activeCount = 1;
+  indexSub(DATAPOINT_UINT, 0);
+
+  zassert_equal(uintSubIndex[UINT_DATAPOINT_COUNT - 1], BIT64(0), "Last datapoint should be indexed");
+  zassert_equal(uintSubIndex[0], 0, "First datapoint should not be indexed");
+}
+
+/**
+ * @test The add subscription functions must not index a subscription when it
+ * cannot be added.
+ */
+ZTEST(datastore_sub_index_tests, test_add_sub_full_not_indexed)
+{
+  DatastoreSubEntry_t sub = {.datapointId = 0, .valCount = 1, .callback = mock_subscription_callback};
+
+  binarySubs.maxCount = 1;
+
+  zassert_equal(datastoreUtilAddBinarySub(&sub, TEST_POOL), -ENOBUFS, "Should return -ENOBUFS");
+  zassert_equal(binarySubIndex[0], 0, "Datapoint should not be indexed");
+}
+
+/**
+ * @test The remove subscription functions must rebuild the index with the
+ * shifted subscription slots.
+ */
+ZTEST(datastore_sub_index_tests, test_remove_sub_rebuilds_index)
+{
+  addIndexedSub(DATAPOINT_BINARY, 0, 1, mock_subscription_callback);
+  addIndexedSub(DATAPOINT_BINARY, 2, 1, mock_other_subscription_callback);
+
+  zassert_equal(datastoreUtilRemoveBinarySub(mock_subscription_callback), 0, "Should remove the subscription");
+
+  zassert_equal(binarySubIndex[0], 0, "Removed subscription should not be indexed");
+  zassert_equal(binarySubIndex[2], BIT64(0), "Remaining subscription should be indexed on its new slot");
+}
+
+/**
+ * @test The datastoreUtilWrite function must only notify the subscriptions
+ * covering the written datapoint.
+ */
+ZTEST(datastore_sub_index_tests, test_write_notifies_covering_subs)
+{
+  Data_t values[1] = {{.uintVal = 1}};
+
+  addIndexedSub(DATAPOINT_BINARY, 0, 1, mock_subscription_callback);
+  addIndexedSub(DATAPOINT_BINARY, 2, 1, mock_other_subscription_callback);
+  RESET_FAKE(mock_subscription_callback);
+  RESET_FAKE(mock_other_subscription_callback);
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 2, values, 1, TEST_POOL), 0, "Should return 0 on success");
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 0, "Non covering subscription should not be notified");
+  zassert_equal(mock_other_subscription_callback_fake.call_count, 1, "Covering subscription should be notified");
+  zassert_equal(mock_other_subscription_callback_fake.arg1_val, 1, "Value count should match");
+}
+
+/**
+ * @test The datastoreUtilWrite function must skip the paused covering
+ * subscriptions.
+ */
+ZTEST(datastore_sub_index_tests, test_write_skips_paused_subs)
+{
+  Data_t values[1] = {{.uintVal = 5}};
+
+  addIndexedSub(DATAPOINT_UINT, 0, 2, mock_subscription_callback);
+  addIndexedSub(DATAPOINT_UINT, 0, 1, mock_other_subscription_callback);
+  uintSubs.entries[0].isPaused = true;
+  RESET_FAKE(mock_subscription_callback);
+  RESET_FAKE(mock_other_subscription_callback);
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_UINT, 0, values, 1, TEST_POOL), 0, "Should return 0 on success");
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 0, "Paused subscription should not be notified");
+  zassert_equal(mock_other_subscription_callback_fake.call_count, 1, "Active subscription should be notified");
+}
+
+/**
+ * @test The datastoreUtilNotify function must stop at the first notification
+ * failure.
+ */
+ZTEST(datastore_sub_index_tests, test_notify_stops_on_failure)
+{
+  addIndexedSub(DATAPOINT_BINARY, 0, 1, mock_subscription_callback);
+  addIndexedSub(DATAPOINT_BINARY, 0, 1, mock_other_subscription_callback);
+  RESET_FAKE(mock_subscription_callback);
+  RESET_FAKE(mock_other_subscription_callback);
+  mock_subscription_callback_fake.return_val = -EIO;
+
+  zassert_equal(datastoreUtilNotify(DATAPOINT_BINARY, 0, 1, TEST_POOL), -EIO, "Should return the callback error");
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "First subscription should be notified");
+  zassert_equal(mock_other_subscription_callback_fake.call_count, 0, "Next subscription should not be notified");
+}
+
+/**
+ * @test The datastoreUtilNotify function must ignore an out of range
+ * datapoint ID and reject an invalid type.
+ */
+ZTEST(datastore_sub_index_tests, test_notify_invalid_arguments)
+{
+  zassert_equal(datastoreUtilNotify(DATAPOINT_BINARY, BINARY_DATAPOINT_COUNT, 1, TEST_POOL), 0,
+                "Out of range datapoint should have no subscription");
+  zassert_equal(datastoreUtilNotify(DATAPOINT_TYPE_COUNT, 0, 1, TEST_POOL), -ENOTSUP,
+                "Invalid type should return -ENOTSUP");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must notify once each
+ * subscription covering a changed operation and skip the others.
+ */
+ZTEST(datastore_sub_index_tests, test_apply_batch_notifies_covering_subs_once)
+{
+  size_t cursor = 0;
+  Data_t buffer[16];
+  Data_t first[1] = {{.uintVal = 1}};
+  Data_t second[1] = {{.uintVal = 1}};
+
+  addIndexedSub(DATAPOINT_BINARY, 0, 2, mock_subscription_callback);
+  addIndexedSub(DATAPOINT_BINARY, 2, 1, mock_other_subscription_callback);
+  RESET_FAKE(mock_subscription_callback);
+  RESET_FAKE(mock_other_subscription_callback);
+
+  packBatchWrite(buffer, &cursor, DATAPOINT_BINARY, 0, 1, first);
+  packBatchWrite(buffer, &cursor, DATAPOINT_BINARY, 1, 1, second);
+
+  zassert_equal(datastoreUtilApplyBatch(buffer, 2, TEST_POOL), 0, "Should return 0 on success");
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Covering subscription should be notified once for the batch");
+  zassert_equal(mock_other_subscription_callback_fake.call_count, 0,
+                "Non covering subscription should not be notified");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must report the first
+ * notification failure and still notify the other covering subscriptions.
+ */
+ZTEST(datastore_sub_index_tests, test_apply_batch_notification_failure)
+{
+  size_t cursor = 0;
+  Data_t buffer[16];
+  Data_t values[2] = {{.uintVal = 1}, {.uintVal = 1}};
+
+  addIndexedSub(DATAPOINT_BINARY, 0, 1, mock_subscription_callback);
+  addIndexedSub(DATAPOINT_BINARY, 1, 1, mock_other_subscription_callback);
+  RESET_FAKE(mock_subscription_callback);
+  RESET_FAKE(mock_other_subscription_callback);
+  mock_subscription_callback_fake.return_val = -EIO;
+
+  packBatchWrite(buffer, &cursor, DATAPOINT_BINARY, 0, 2, values);
+
+  zassert_equal(datastoreUtilApplyBatch(buffer, 1, TEST_POOL), -EIO, "Should return the callback error");
+
+  zassert_equal(mock_subscription_callback_fake.call_count, 1, "First subscription should be notified");
+  zassert_equal(mock_other_subscription_callback_fake.call_count, 1, "Second subscription should be notified");
+}
+
+ZTEST_SUITE(datastore_sub_index_tests, NULL, sub_index_tests_setup, sub_index_tests_before, NULL, NULL);
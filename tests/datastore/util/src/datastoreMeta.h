@@ -20,7 +20,7 @@
  */
 #define DATASTORE_BINARY_DATAPOINTS \
   X(BINARY_FIRST_DATAPOINT, DATAPOINT_NO_FLAG_MASK, false) \
-  X(BINARY_SECOND_DATAPOINT, DATAPOINT_NO_FLAG_MASK, true) \
+  X(BINARY_SECOND_DATAPOINT, DATAPOINT_FLAG_NVM_MASK, true) \
   X(BINARY_THIRD_DATAPOINT, DATAPOINT_NO_FLAG_MASK, false)
 
 /**
@@ -61,6 +61,6 @@
  */
 #define DATASTORE_UINT_DATAPOINTS \
   X(UINT_FIRST_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0) \
-  X(UINT_SECOND_DATAPOINT, DATAPOINT_NO_FLAG_MASK, 0)
+  X(UINT_SECOND_DATAPOINT, DATAPOINT_FLAG_NVM_MASK, 0)
 
 #endif /* DATASTORE_META_H */
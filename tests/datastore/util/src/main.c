@@ -24,6 +24,13 @@ typedef void *osMemoryPoolId_t;
 
 /* Mock Kconfig options */
 #define CONFIG_ENYA_DATASTORE 1
+#define CONFIG_ENYA_DATASTORE_DIRECT_READ 1
+#define CONFIG_ENYA_DATASTORE_DIRECT_READ_MAX_RETRIES 3
+#define CONFIG_ENYA_DATASTORE_BATCH 1
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS 4
+#define CONFIG_ENYA_DATASTORE_BATCH_MAX_VALUES 8
+#define CONFIG_ENYA_DATASTORE_NVM 1
+#define CONFIG_ENYA_DATASTORE_STATS 1
 
 #define FFF_FAKES_LIST(FAKE) \
   FAKE(osMemoryPoolAlloc) \
@@ -57,6 +64,28 @@ FAKE_VOID_FUNC(k_free, void *);
 /* Mock subscription callback - SrvMsgPayload_t is now defined */
 FAKE_VALUE_FUNC(int, mock_subscription_callback, SrvMsgPayload_t *, size_t);
 
+/**
+ * Pack a batch operation in a batch buffer.
+ */
+static void packBatchOp(Data_t buffer[], size_t *cursor, DatastoreBatchOpType_t opType,
+                        DatapointType_t type, uint32_t datapointId, size_t valCount, Data_t values[])
+{
+  DatastoreBatchOpHeader_t header = {
+    .opType = opType,
+    .datapointType = type,
+    .valCount = valCount,
+    .datapointId = datapointId,
+  };
+
+  memcpy(buffer + *cursor, &header, sizeof(header));
+  *cursor += DATASTORE_BATCH_OP_HEADER_LEN;
+
+  if(values)
+    memcpy(buffer + *cursor, values, valCount * sizeof(Data_t));
+
+  *cursor += valCount;
+}
+
 /**
  * Test setup function.
  */
@@ -126,10 +155,20 @@ static void util_tests_before(void *fixture)
   uintSubs.activeCount = 0;
   uintSubs.entries = NULL;
   uintSubs.maxCount = 0;
+
+  /* Reset the write sequence counters */
+  for(size_t i = 0; i < DATAPOINT_TYPE_COUNT; ++i)
+    atomic_set(writeSequences + i, 0);
+
+  /* Reset the NVM journal dirty types */
+  nvmDirtyTypes = 0;
+
+  /* Reset the notification statistics */
+  datastoreUtilResetNotifyStats();
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must return true when
+ * @test The isBinaryRangeInSubRange function must return true when
  * datapointId equals the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=10 should be included.
@@ -145,14 +184,14 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_at_start)
   bool result;
 
   /* Test with datapointId = 10 (first datapoint in range [10, 15)) */
-  result = isBinaryDatapointInSubRange(10, &sub);
+  result = isBinaryRangeInSubRange(10, 1, &sub);
 
   zassert_true(result,
                "datapointId 10 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must return true when
+ * @test The isBinaryRangeInSubRange function must return true when
  * datapointId is in the middle of the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=12 should be included.
@@ -168,14 +207,14 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_middle)
   bool result;
 
   /* Test with datapointId = 12 (middle of range [10, 15)) */
-  result = isBinaryDatapointInSubRange(12, &sub);
+  result = isBinaryRangeInSubRange(12, 1, &sub);
 
   zassert_true(result,
                "datapointId 12 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must return true when
+ * @test The isBinaryRangeInSubRange function must return true when
  * datapointId is the last datapoint in the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=14 should be included.
@@ -191,14 +230,14 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_last)
   bool result;
 
   /* Test with datapointId = 14 (last datapoint in range [10, 15)) */
-  result = isBinaryDatapointInSubRange(14, &sub);
+  result = isBinaryRangeInSubRange(14, 1, &sub);
 
   zassert_true(result,
                "datapointId 14 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must return false when
+ * @test The isBinaryRangeInSubRange function must return false when
  * datapointId is one past the subscription ending datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=15 should NOT be included.
@@ -214,14 +253,14 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_at_end_boundary)
   bool result;
 
   /* Test with datapointId = 15 (one past end of range [10, 15)) */
-  result = isBinaryDatapointInSubRange(15, &sub);
+  result = isBinaryRangeInSubRange(15, 1, &sub);
 
   zassert_false(result,
                 "datapointId 15 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must return false when
+ * @test The isBinaryRangeInSubRange function must return false when
  * datapointId is less than the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=9 should NOT be included.
@@ -237,14 +276,14 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_before_start)
   bool result;
 
   /* Test with datapointId = 9 (before range [10, 15)) */
-  result = isBinaryDatapointInSubRange(9, &sub);
+  result = isBinaryRangeInSubRange(9, 1, &sub);
 
   zassert_false(result,
                 "datapointId 9 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must return false when
+ * @test The isBinaryRangeInSubRange function must return false when
  * datapointId is greater than the subscription ending datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=20 should NOT be included.
@@ -260,14 +299,14 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_after_end)
   bool result;
 
   /* Test with datapointId = 20 (well after range [10, 15)) */
-  result = isBinaryDatapointInSubRange(20, &sub);
+  result = isBinaryRangeInSubRange(20, 1, &sub);
 
   zassert_false(result,
                 "datapointId 20 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must handle a subscription
+ * @test The isBinaryRangeInSubRange function must handle a subscription
  * to a single datapoint correctly.
  *
  * Subscription covers [42, 43), so only datapointId=42 should be included.
@@ -283,14 +322,14 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_single_datapoint_i
   bool result;
 
   /* Test with datapointId = 42 (the only datapoint in range [42, 43)) */
-  result = isBinaryDatapointInSubRange(42, &sub);
+  result = isBinaryRangeInSubRange(42, 1, &sub);
 
   zassert_true(result,
                "datapointId 42 should be included in single datapoint subscription [42, 43)");
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must return false for
+ * @test The isBinaryRangeInSubRange function must return false for
  * datapointId outside a single datapoint subscription.
  *
  * Subscription covers [42, 43), so datapointId=43 should NOT be included.
@@ -306,14 +345,14 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_single_datapoint_n
   bool result;
 
   /* Test with datapointId = 43 (outside range [42, 43)) */
-  result = isBinaryDatapointInSubRange(43, &sub);
+  result = isBinaryRangeInSubRange(43, 1, &sub);
 
   zassert_false(result,
                 "datapointId 43 should NOT be included in single datapoint subscription [42, 43)");
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must handle datapointId 0
+ * @test The isBinaryRangeInSubRange function must handle datapointId 0
  * correctly when it's included in the subscription.
  *
  * Subscription covers [0, 10), so datapointId=0 should be included.
@@ -329,14 +368,14 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_zero_included)
   bool result;
 
   /* Test with datapointId = 0 (first datapoint in range [0, 10)) */
-  result = isBinaryDatapointInSubRange(0, &sub);
+  result = isBinaryRangeInSubRange(0, 1, &sub);
 
   zassert_true(result,
                "datapointId 0 should be included in subscription range [0, 10)");
 }
 
 /**
- * @test The isBinaryDatapointInSubRange function must handle datapointId 0
+ * @test The isBinaryRangeInSubRange function must handle datapointId 0
  * correctly when it's NOT included in the subscription.
  *
  * Subscription covers [5, 15), so datapointId=0 should NOT be included.
@@ -352,12 +391,50 @@ ZTEST(datastore_util_tests, test_is_binary_datapoint_in_range_zero_not_included)
   bool result;
 
   /* Test with datapointId = 0 (before range [5, 15)) */
-  result = isBinaryDatapointInSubRange(0, &sub);
+  result = isBinaryRangeInSubRange(0, 1, &sub);
 
   zassert_false(result,
                 "datapointId 0 should NOT be included in subscription range [5, 15)");
 }
 
+/**
+ * @test The isBinaryRangeInSubRange function must return true when a range
+ * starting before the subscription overlaps its first datapoint.
+ *
+ * Subscription covers [5, 15), so the range [2, 6) should overlap it.
+ */
+ZTEST(datastore_util_tests, test_is_binary_range_in_range_overlapping_start)
+{
+  DatastoreSubEntry_t sub = {
+    .datapointId = 5,
+    .valCount = 10,
+    .isPaused = false,
+    .callback = NULL
+  };
+
+  zassert_true(isBinaryRangeInSubRange(2, 4, &sub),
+               "Range [2, 6) should overlap subscription range [5, 15)");
+}
+
+/**
+ * @test The isBinaryRangeInSubRange function must return false when a range
+ * ends right before the subscription.
+ *
+ * Subscription covers [5, 15), so the range [2, 5) should NOT overlap it.
+ */
+ZTEST(datastore_util_tests, test_is_binary_range_in_range_ending_before_start)
+{
+  DatastoreSubEntry_t sub = {
+    .datapointId = 5,
+    .valCount = 10,
+    .isPaused = false,
+    .callback = NULL
+  };
+
+  zassert_false(isBinaryRangeInSubRange(2, 3, &sub),
+                "Range [2, 5) should NOT overlap subscription range [5, 15)");
+}
+
 /**
  * @test The notifyBinarySub function must return -ENOSPC when
  * memory pool allocation fails.
@@ -392,6 +469,10 @@ ZTEST(datastore_util_tests, test_notify_binary_sub_allocation_failure)
                 "osMemoryPoolAlloc should be called with DATASTORE_BUFFER_ALLOC_TIMEOUT");
   zassert_equal(mock_subscription_callback_fake.call_count, 0,
                 "Callback should not be called when allocation fails");
+  zassert_equal(atomic_get(&notifyAllocFailures), 1,
+                "The allocation failure should be counted");
+  zassert_equal(atomic_get(notifyCounts + DATAPOINT_BINARY), 0,
+                "The failed notification should not be counted");
 }
 
 /**
@@ -486,6 +567,8 @@ ZTEST(datastore_util_tests, test_notify_binary_sub_success)
                 "Callback should be called with the populated payload");
   zassert_equal(mock_subscription_callback_fake.arg1_val, 2,
                 "Callback should be called with valCount=2");
+  zassert_equal(atomic_get(notifyCounts + DATAPOINT_BINARY), 1,
+                "The notification should be counted");
 }
 
 /**
@@ -522,7 +605,7 @@ ZTEST(datastore_util_tests, test_notify_binary_subs_notification_failure)
   osMemoryPoolAlloc_fake.return_val = NULL;
 
   /* Call notifyBinarySubs with datapointId=5 - should fail on first matching subscription */
-  result = notifyBinarySubs(5, pool);
+  result = notifyBinarySubs(5, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "notifyBinarySubs should return -ENOSPC when allocation fails");
@@ -582,7 +665,7 @@ ZTEST(datastore_util_tests, test_notify_binary_subs_success)
   mock_subscription_callback_fake.return_val = 0;
 
   /* Call notifyBinarySubs with datapointId=5 - should notify subscriptions 0 and 3 */
-  result = notifyBinarySubs(5, pool);
+  result = notifyBinarySubs(5, 1, pool);
 
   zassert_equal(result, 0,
                 "notifyBinarySubs should return 0 on success");
@@ -593,7 +676,7 @@ ZTEST(datastore_util_tests, test_notify_binary_subs_success)
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must return true when
+ * @test The isButtonRangeInSubRange function must return true when
  * datapointId equals the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=10 should be included.
@@ -609,14 +692,14 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_at_start)
   bool result;
 
   /* Test with datapointId = 10 (first datapoint in range [10, 15)) */
-  result = isButtonDatapointInSubRange(10, &sub);
+  result = isButtonRangeInSubRange(10, 1, &sub);
 
   zassert_true(result,
                "datapointId 10 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must return true when
+ * @test The isButtonRangeInSubRange function must return true when
  * datapointId is in the middle of the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=12 should be included.
@@ -632,14 +715,14 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_middle)
   bool result;
 
   /* Test with datapointId = 12 (middle of range [10, 15)) */
-  result = isButtonDatapointInSubRange(12, &sub);
+  result = isButtonRangeInSubRange(12, 1, &sub);
 
   zassert_true(result,
                "datapointId 12 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must return true when
+ * @test The isButtonRangeInSubRange function must return true when
  * datapointId is the last datapoint in the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=14 should be included.
@@ -655,14 +738,14 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_last)
   bool result;
 
   /* Test with datapointId = 14 (last datapoint in range [10, 15)) */
-  result = isButtonDatapointInSubRange(14, &sub);
+  result = isButtonRangeInSubRange(14, 1, &sub);
 
   zassert_true(result,
                "datapointId 14 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must return false when
+ * @test The isButtonRangeInSubRange function must return false when
  * datapointId is one past the subscription ending datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=15 should NOT be included.
@@ -678,14 +761,14 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_at_end_boundary)
   bool result;
 
   /* Test with datapointId = 15 (one past end of range [10, 15)) */
-  result = isButtonDatapointInSubRange(15, &sub);
+  result = isButtonRangeInSubRange(15, 1, &sub);
 
   zassert_false(result,
                 "datapointId 15 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must return false when
+ * @test The isButtonRangeInSubRange function must return false when
  * datapointId is less than the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=9 should NOT be included.
@@ -701,14 +784,14 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_before_start)
   bool result;
 
   /* Test with datapointId = 9 (before range [10, 15)) */
-  result = isButtonDatapointInSubRange(9, &sub);
+  result = isButtonRangeInSubRange(9, 1, &sub);
 
   zassert_false(result,
                 "datapointId 9 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must return false when
+ * @test The isButtonRangeInSubRange function must return false when
  * datapointId is greater than the subscription ending datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=20 should NOT be included.
@@ -724,14 +807,14 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_after_end)
   bool result;
 
   /* Test with datapointId = 20 (well after range [10, 15)) */
-  result = isButtonDatapointInSubRange(20, &sub);
+  result = isButtonRangeInSubRange(20, 1, &sub);
 
   zassert_false(result,
                 "datapointId 20 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must handle a subscription
+ * @test The isButtonRangeInSubRange function must handle a subscription
  * to a single datapoint correctly.
  *
  * Subscription covers [42, 43), so only datapointId=42 should be included.
@@ -747,14 +830,14 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_single_datapoint_i
   bool result;
 
   /* Test with datapointId = 42 (the only datapoint in range [42, 43)) */
-  result = isButtonDatapointInSubRange(42, &sub);
+  result = isButtonRangeInSubRange(42, 1, &sub);
 
   zassert_true(result,
                "datapointId 42 should be included in single datapoint subscription [42, 43)");
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must return false for
+ * @test The isButtonRangeInSubRange function must return false for
  * datapointId outside a single datapoint subscription.
  *
  * Subscription covers [42, 43), so datapointId=43 should NOT be included.
@@ -770,14 +853,14 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_single_datapoint_n
   bool result;
 
   /* Test with datapointId = 43 (outside range [42, 43)) */
-  result = isButtonDatapointInSubRange(43, &sub);
+  result = isButtonRangeInSubRange(43, 1, &sub);
 
   zassert_false(result,
                 "datapointId 43 should NOT be included in single datapoint subscription [42, 43)");
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must handle datapointId 0
+ * @test The isButtonRangeInSubRange function must handle datapointId 0
  * correctly when it's included in the subscription.
  *
  * Subscription covers [0, 10), so datapointId=0 should be included.
@@ -793,14 +876,14 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_zero_included)
   bool result;
 
   /* Test with datapointId = 0 (first datapoint in range [0, 10)) */
-  result = isButtonDatapointInSubRange(0, &sub);
+  result = isButtonRangeInSubRange(0, 1, &sub);
 
   zassert_true(result,
                "datapointId 0 should be included in subscription range [0, 10)");
 }
 
 /**
- * @test The isButtonDatapointInSubRange function must handle datapointId 0
+ * @test The isButtonRangeInSubRange function must handle datapointId 0
  * correctly when it's NOT included in the subscription.
  *
  * Subscription covers [5, 15), so datapointId=0 should NOT be included.
@@ -816,7 +899,7 @@ ZTEST(datastore_util_tests, test_is_button_datapoint_in_range_zero_not_included)
   bool result;
 
   /* Test with datapointId = 0 (before range [5, 15)) */
-  result = isButtonDatapointInSubRange(0, &sub);
+  result = isButtonRangeInSubRange(0, 1, &sub);
 
   zassert_false(result,
                 "datapointId 0 should NOT be included in subscription range [5, 15)");
@@ -986,7 +1069,7 @@ ZTEST(datastore_util_tests, test_notify_button_subs_notification_failure)
   osMemoryPoolAlloc_fake.return_val = NULL;
 
   /* Call notifyButtonSubs with datapointId=5 - should fail on first matching subscription */
-  result = notifyButtonSubs(5, pool);
+  result = notifyButtonSubs(5, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "notifyButtonSubs should return -ENOSPC when allocation fails");
@@ -1034,7 +1117,7 @@ ZTEST(datastore_util_tests, test_notify_button_subs_success)
   osMemoryPoolAlloc_fake.return_val = &test_buffer;
 
   /* Call notifyButtonSubs with datapointId=5 - should match entry 1 only */
-  result = notifyButtonSubs(5, pool);
+  result = notifyButtonSubs(5, 1, pool);
 
   zassert_equal(result, 0,
                 "notifyButtonSubs should return 0 on success");
@@ -1066,7 +1149,7 @@ ZTEST(datastore_util_tests, test_notify_button_subs_paused_in_range)
   test_entry.callback = mock_subscription_callback;
 
   /* Call notifyButtonSubs with datapointId=7 */
-  result = notifyButtonSubs(7, pool);
+  result = notifyButtonSubs(7, 1, pool);
 
   zassert_equal(result, 0,
                 "notifyButtonSubs should return 0 when all matching subs are paused");
@@ -1077,7 +1160,7 @@ ZTEST(datastore_util_tests, test_notify_button_subs_paused_in_range)
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must return true when
+ * @test The isFloatRangeInSubRange function must return true when
  * datapointId equals the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=10 should be included.
@@ -1093,14 +1176,14 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_at_start)
   bool result;
 
   /* Test with datapointId = 10 (start of range [10, 15)) */
-  result = isFloatDatapointInSubRange(10, &sub);
+  result = isFloatRangeInSubRange(10, 1, &sub);
 
   zassert_true(result,
                "datapointId 10 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must return true when
+ * @test The isFloatRangeInSubRange function must return true when
  * datapointId is in the middle of the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=12 should be included.
@@ -1116,14 +1199,14 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_middle)
   bool result;
 
   /* Test with datapointId = 12 (middle of range [10, 15)) */
-  result = isFloatDatapointInSubRange(12, &sub);
+  result = isFloatRangeInSubRange(12, 1, &sub);
 
   zassert_true(result,
                "datapointId 12 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must return true when
+ * @test The isFloatRangeInSubRange function must return true when
  * datapointId equals the last valid datapoint ID in the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=14 (last included) should be true.
@@ -1139,14 +1222,14 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_last)
   bool result;
 
   /* Test with datapointId = 14 (last in range [10, 15)) */
-  result = isFloatDatapointInSubRange(14, &sub);
+  result = isFloatRangeInSubRange(14, 1, &sub);
 
   zassert_true(result,
                "datapointId 14 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must return false when
+ * @test The isFloatRangeInSubRange function must return false when
  * datapointId equals the subscription ending boundary (exclusive).
  *
  * Subscription covers datapoints [10, 15), so datapointId=15 should NOT be included.
@@ -1162,14 +1245,14 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_at_end_boundary)
   bool result;
 
   /* Test with datapointId = 15 (end boundary of range [10, 15), exclusive) */
-  result = isFloatDatapointInSubRange(15, &sub);
+  result = isFloatRangeInSubRange(15, 1, &sub);
 
   zassert_false(result,
                 "datapointId 15 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must return false when
+ * @test The isFloatRangeInSubRange function must return false when
  * datapointId is less than the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=9 should NOT be included.
@@ -1185,14 +1268,14 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_before_start)
   bool result;
 
   /* Test with datapointId = 9 (before range [10, 15)) */
-  result = isFloatDatapointInSubRange(9, &sub);
+  result = isFloatRangeInSubRange(9, 1, &sub);
 
   zassert_false(result,
                 "datapointId 9 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must return false when
+ * @test The isFloatRangeInSubRange function must return false when
  * datapointId is greater than the subscription ending datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=20 should NOT be included.
@@ -1208,14 +1291,14 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_after_end)
   bool result;
 
   /* Test with datapointId = 20 (well after range [10, 15)) */
-  result = isFloatDatapointInSubRange(20, &sub);
+  result = isFloatRangeInSubRange(20, 1, &sub);
 
   zassert_false(result,
                 "datapointId 20 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must handle a subscription
+ * @test The isFloatRangeInSubRange function must handle a subscription
  * with a single datapoint correctly when the datapointId matches.
  *
  * Subscription covers only datapoint [5, 6), so datapointId=5 should be included.
@@ -1231,14 +1314,14 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_single_datapoint_in
   bool result;
 
   /* Test with datapointId = 5 (single datapoint range [5, 6)) */
-  result = isFloatDatapointInSubRange(5, &sub);
+  result = isFloatRangeInSubRange(5, 1, &sub);
 
   zassert_true(result,
                "datapointId 5 should be included in single datapoint subscription [5, 6)");
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must handle a subscription
+ * @test The isFloatRangeInSubRange function must handle a subscription
  * with a single datapoint correctly when the datapointId does not match.
  *
  * Subscription covers only datapoint [5, 6), so datapointId=6 should NOT be included.
@@ -1254,14 +1337,14 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_single_datapoint_no
   bool result;
 
   /* Test with datapointId = 6 (outside single datapoint range [5, 6)) */
-  result = isFloatDatapointInSubRange(6, &sub);
+  result = isFloatRangeInSubRange(6, 1, &sub);
 
   zassert_false(result,
                 "datapointId 6 should NOT be included in single datapoint subscription [5, 6)");
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must correctly handle
+ * @test The isFloatRangeInSubRange function must correctly handle
  * datapointId 0 when it is included in the subscription range.
  *
  * Subscription covers datapoints [0, 3), so datapointId=0 should be included.
@@ -1277,14 +1360,14 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_zero_included)
   bool result;
 
   /* Test with datapointId = 0 (start of range [0, 3)) */
-  result = isFloatDatapointInSubRange(0, &sub);
+  result = isFloatRangeInSubRange(0, 1, &sub);
 
   zassert_true(result,
                "datapointId 0 should be included in subscription range [0, 3)");
 }
 
 /**
- * @test The isFloatDatapointInSubRange function must correctly handle
+ * @test The isFloatRangeInSubRange function must correctly handle
  * datapointId 0 when it is not included in the subscription range.
  *
  * Subscription covers datapoints [1, 3), so datapointId=0 should NOT be included.
@@ -1300,7 +1383,7 @@ ZTEST(datastore_util_tests, test_is_float_datapoint_in_range_zero_not_included)
   bool result;
 
   /* Test with datapointId = 0 (before range [1, 3)) */
-  result = isFloatDatapointInSubRange(0, &sub);
+  result = isFloatRangeInSubRange(0, 1, &sub);
 
   zassert_false(result,
                 "datapointId 0 should NOT be included in subscription range [1, 3)");
@@ -1450,7 +1533,7 @@ ZTEST(datastore_util_tests, test_notify_float_subs_notification_failure)
   osMemoryPoolAlloc_fake.return_val = NULL;
 
   /* Call notifyFloatSubs with datapointId=0 - should fail on first matching subscription */
-  result = notifyFloatSubs(0, pool);
+  result = notifyFloatSubs(0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "notifyFloatSubs should return -ENOSPC when allocation fails");
@@ -1501,7 +1584,7 @@ ZTEST(datastore_util_tests, test_notify_float_subs_success)
   mock_subscription_callback_fake.return_val = 0;
 
   /* Call notifyFloatSubs with datapointId=0 - should notify only subscription 0 */
-  result = notifyFloatSubs(0, pool);
+  result = notifyFloatSubs(0, 1, pool);
 
   zassert_equal(result, 0,
                 "notifyFloatSubs should return 0 on success");
@@ -1512,7 +1595,7 @@ ZTEST(datastore_util_tests, test_notify_float_subs_success)
 }
 
 /**
- * @test The isIntDatapointInSubRange function must return true when
+ * @test The isIntRangeInSubRange function must return true when
  * datapointId equals the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=10 should be included.
@@ -1528,14 +1611,14 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_at_start)
   bool result;
 
   /* Test with datapointId = 10 (start of range [10, 15)) */
-  result = isIntDatapointInSubRange(10, &sub);
+  result = isIntRangeInSubRange(10, 1, &sub);
 
   zassert_true(result,
                "datapointId 10 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isIntDatapointInSubRange function must return true when
+ * @test The isIntRangeInSubRange function must return true when
  * datapointId is in the middle of the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=12 should be included.
@@ -1551,14 +1634,14 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_middle)
   bool result;
 
   /* Test with datapointId = 12 (middle of range [10, 15)) */
-  result = isIntDatapointInSubRange(12, &sub);
+  result = isIntRangeInSubRange(12, 1, &sub);
 
   zassert_true(result,
                "datapointId 12 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isIntDatapointInSubRange function must return true when
+ * @test The isIntRangeInSubRange function must return true when
  * datapointId equals the last valid datapoint ID in the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=14 (last included) should be true.
@@ -1574,14 +1657,14 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_last)
   bool result;
 
   /* Test with datapointId = 14 (last in range [10, 15)) */
-  result = isIntDatapointInSubRange(14, &sub);
+  result = isIntRangeInSubRange(14, 1, &sub);
 
   zassert_true(result,
                "datapointId 14 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isIntDatapointInSubRange function must return false when
+ * @test The isIntRangeInSubRange function must return false when
  * datapointId equals the subscription ending boundary (exclusive).
  *
  * Subscription covers datapoints [10, 15), so datapointId=15 should NOT be included.
@@ -1597,14 +1680,14 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_at_end_boundary)
   bool result;
 
   /* Test with datapointId = 15 (end boundary of range [10, 15), exclusive) */
-  result = isIntDatapointInSubRange(15, &sub);
+  result = isIntRangeInSubRange(15, 1, &sub);
 
   zassert_false(result,
                 "datapointId 15 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isIntDatapointInSubRange function must return false when
+ * @test The isIntRangeInSubRange function must return false when
  * datapointId is less than the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=9 should NOT be included.
@@ -1620,14 +1703,14 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_before_start)
   bool result;
 
   /* Test with datapointId = 9 (before range [10, 15)) */
-  result = isIntDatapointInSubRange(9, &sub);
+  result = isIntRangeInSubRange(9, 1, &sub);
 
   zassert_false(result,
                 "datapointId 9 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isIntDatapointInSubRange function must return false when
+ * @test The isIntRangeInSubRange function must return false when
  * datapointId is greater than the subscription ending datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=20 should NOT be included.
@@ -1643,14 +1726,14 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_after_end)
   bool result;
 
   /* Test with datapointId = 20 (well after range [10, 15)) */
-  result = isIntDatapointInSubRange(20, &sub);
+  result = isIntRangeInSubRange(20, 1, &sub);
 
   zassert_false(result,
                 "datapointId 20 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isIntDatapointInSubRange function must handle a subscription
+ * @test The isIntRangeInSubRange function must handle a subscription
  * with a single datapoint correctly when the datapointId matches.
  *
  * Subscription covers only datapoint [5, 6), so datapointId=5 should be included.
@@ -1666,14 +1749,14 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_single_datapoint_incl
   bool result;
 
   /* Test with datapointId = 5 (single datapoint range [5, 6)) */
-  result = isIntDatapointInSubRange(5, &sub);
+  result = isIntRangeInSubRange(5, 1, &sub);
 
   zassert_true(result,
                "datapointId 5 should be included in single datapoint subscription [5, 6)");
 }
 
 /**
- * @test The isIntDatapointInSubRange function must handle a subscription
+ * @test The isIntRangeInSubRange function must handle a subscription
  * with a single datapoint correctly when the datapointId does not match.
  *
  * Subscription covers only datapoint [5, 6), so datapointId=6 should NOT be included.
@@ -1689,14 +1772,14 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_single_datapoint_not_
   bool result;
 
   /* Test with datapointId = 6 (outside single datapoint range [5, 6)) */
-  result = isIntDatapointInSubRange(6, &sub);
+  result = isIntRangeInSubRange(6, 1, &sub);
 
   zassert_false(result,
                 "datapointId 6 should NOT be included in single datapoint subscription [5, 6)");
 }
 
 /**
- * @test The isIntDatapointInSubRange function must correctly handle
+ * @test The isIntRangeInSubRange function must correctly handle
  * datapointId 0 when it is included in the subscription range.
  *
  * Subscription covers datapoints [0, 3), so datapointId=0 should be included.
@@ -1712,14 +1795,14 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_zero_included)
   bool result;
 
   /* Test with datapointId = 0 (start of range [0, 3)) */
-  result = isIntDatapointInSubRange(0, &sub);
+  result = isIntRangeInSubRange(0, 1, &sub);
 
   zassert_true(result,
                "datapointId 0 should be included in subscription range [0, 3)");
 }
 
 /**
- * @test The isIntDatapointInSubRange function must correctly handle
+ * @test The isIntRangeInSubRange function must correctly handle
  * datapointId 0 when it is not included in the subscription range.
  *
  * Subscription covers datapoints [1, 3), so datapointId=0 should NOT be included.
@@ -1735,7 +1818,7 @@ ZTEST(datastore_util_tests, test_is_int_datapoint_in_range_zero_not_included)
   bool result;
 
   /* Test with datapointId = 0 (before range [1, 3)) */
-  result = isIntDatapointInSubRange(0, &sub);
+  result = isIntRangeInSubRange(0, 1, &sub);
 
   zassert_false(result,
                 "datapointId 0 should NOT be included in subscription range [1, 3)");
@@ -1885,7 +1968,7 @@ ZTEST(datastore_util_tests, test_notify_int_subs_notification_failure)
   osMemoryPoolAlloc_fake.return_val = NULL;
 
   /* Call notifyIntSubs with datapointId=0 - should fail on first matching subscription */
-  result = notifyIntSubs(0, pool);
+  result = notifyIntSubs(0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "notifyIntSubs should return -ENOSPC when allocation fails");
@@ -1936,7 +2019,7 @@ ZTEST(datastore_util_tests, test_notify_int_subs_success)
   mock_subscription_callback_fake.return_val = 0;
 
   /* Call notifyIntSubs with datapointId=0 - should notify only subscription 0 */
-  result = notifyIntSubs(0, pool);
+  result = notifyIntSubs(0, 1, pool);
 
   zassert_equal(result, 0,
                 "notifyIntSubs should return 0 on success");
@@ -1947,7 +2030,7 @@ ZTEST(datastore_util_tests, test_notify_int_subs_success)
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must return true when
+ * @test The isMultiStateRangeInSubRange function must return true when
  * datapointId equals the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=10 should be included.
@@ -1963,14 +2046,14 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_at_start)
   bool result;
 
   /* Test with datapointId = 10 (start of range [10, 15)) */
-  result = isMultiStateDatapointInSubRange(10, &sub);
+  result = isMultiStateRangeInSubRange(10, 1, &sub);
 
   zassert_true(result,
                "datapointId 10 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must return true when
+ * @test The isMultiStateRangeInSubRange function must return true when
  * datapointId is in the middle of the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=12 should be included.
@@ -1986,14 +2069,14 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_middle)
   bool result;
 
   /* Test with datapointId = 12 (middle of range [10, 15)) */
-  result = isMultiStateDatapointInSubRange(12, &sub);
+  result = isMultiStateRangeInSubRange(12, 1, &sub);
 
   zassert_true(result,
                "datapointId 12 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must return true when
+ * @test The isMultiStateRangeInSubRange function must return true when
  * datapointId equals the last valid datapoint ID in the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=14 (last included) should be true.
@@ -2009,14 +2092,14 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_last)
   bool result;
 
   /* Test with datapointId = 14 (last in range [10, 15)) */
-  result = isMultiStateDatapointInSubRange(14, &sub);
+  result = isMultiStateRangeInSubRange(14, 1, &sub);
 
   zassert_true(result,
                "datapointId 14 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must return false when
+ * @test The isMultiStateRangeInSubRange function must return false when
  * datapointId equals the subscription ending boundary (exclusive).
  *
  * Subscription covers datapoints [10, 15), so datapointId=15 should NOT be included.
@@ -2032,14 +2115,14 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_at_end_bounda
   bool result;
 
   /* Test with datapointId = 15 (end boundary of range [10, 15), exclusive) */
-  result = isMultiStateDatapointInSubRange(15, &sub);
+  result = isMultiStateRangeInSubRange(15, 1, &sub);
 
   zassert_false(result,
                 "datapointId 15 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must return false when
+ * @test The isMultiStateRangeInSubRange function must return false when
  * datapointId is less than the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=9 should NOT be included.
@@ -2055,14 +2138,14 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_before_start)
   bool result;
 
   /* Test with datapointId = 9 (before range [10, 15)) */
-  result = isMultiStateDatapointInSubRange(9, &sub);
+  result = isMultiStateRangeInSubRange(9, 1, &sub);
 
   zassert_false(result,
                 "datapointId 9 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must return false when
+ * @test The isMultiStateRangeInSubRange function must return false when
  * datapointId is greater than the subscription ending datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=20 should NOT be included.
@@ -2078,14 +2161,14 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_after_end)
   bool result;
 
   /* Test with datapointId = 20 (well after range [10, 15)) */
-  result = isMultiStateDatapointInSubRange(20, &sub);
+  result = isMultiStateRangeInSubRange(20, 1, &sub);
 
   zassert_false(result,
                 "datapointId 20 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must handle a subscription
+ * @test The isMultiStateRangeInSubRange function must handle a subscription
  * with a single datapoint correctly when the datapointId matches.
  *
  * Subscription covers only datapoint [5, 6), so datapointId=5 should be included.
@@ -2101,14 +2184,14 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_single_datapo
   bool result;
 
   /* Test with datapointId = 5 (single datapoint range [5, 6)) */
-  result = isMultiStateDatapointInSubRange(5, &sub);
+  result = isMultiStateRangeInSubRange(5, 1, &sub);
 
   zassert_true(result,
                "datapointId 5 should be included in single datapoint subscription [5, 6)");
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must handle a subscription
+ * @test The isMultiStateRangeInSubRange function must handle a subscription
  * with a single datapoint correctly when the datapointId does not match.
  *
  * Subscription covers only datapoint [5, 6), so datapointId=6 should NOT be included.
@@ -2124,14 +2207,14 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_single_datapo
   bool result;
 
   /* Test with datapointId = 6 (outside single datapoint range [5, 6)) */
-  result = isMultiStateDatapointInSubRange(6, &sub);
+  result = isMultiStateRangeInSubRange(6, 1, &sub);
 
   zassert_false(result,
                 "datapointId 6 should NOT be included in single datapoint subscription [5, 6)");
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must correctly handle
+ * @test The isMultiStateRangeInSubRange function must correctly handle
  * datapointId 0 when it is included in the subscription range.
  *
  * Subscription covers datapoints [0, 3), so datapointId=0 should be included.
@@ -2147,14 +2230,14 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_zero_included
   bool result;
 
   /* Test with datapointId = 0 (start of range [0, 3)) */
-  result = isMultiStateDatapointInSubRange(0, &sub);
+  result = isMultiStateRangeInSubRange(0, 1, &sub);
 
   zassert_true(result,
                "datapointId 0 should be included in subscription range [0, 3)");
 }
 
 /**
- * @test The isMultiStateDatapointInSubRange function must correctly handle
+ * @test The isMultiStateRangeInSubRange function must correctly handle
  * datapointId 0 when it is not included in the subscription range.
  *
  * Subscription covers datapoints [1, 3), so datapointId=0 should NOT be included.
@@ -2170,7 +2253,7 @@ ZTEST(datastore_util_tests, test_is_multi_state_datapoint_in_range_zero_not_incl
   bool result;
 
   /* Test with datapointId = 0 (before range [1, 3)) */
-  result = isMultiStateDatapointInSubRange(0, &sub);
+  result = isMultiStateRangeInSubRange(0, 1, &sub);
 
   zassert_false(result,
                 "datapointId 0 should NOT be included in subscription range [1, 3)");
@@ -2320,7 +2403,7 @@ ZTEST(datastore_util_tests, test_notify_multi_state_subs_notification_failure)
   osMemoryPoolAlloc_fake.return_val = NULL;
 
   /* Call notifyMultiStateSubs with datapointId=0 - should fail on first matching subscription */
-  result = notifyMultiStateSubs(0, pool);
+  result = notifyMultiStateSubs(0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "notifyMultiStateSubs should return -ENOSPC when allocation fails");
@@ -2371,7 +2454,7 @@ ZTEST(datastore_util_tests, test_notify_multi_state_subs_success)
   mock_subscription_callback_fake.return_val = 0;
 
   /* Call notifyMultiStateSubs with datapointId=0 - should notify only subscription 0 */
-  result = notifyMultiStateSubs(0, pool);
+  result = notifyMultiStateSubs(0, 1, pool);
 
   zassert_equal(result, 0,
                 "notifyMultiStateSubs should return 0 on success");
@@ -2382,7 +2465,7 @@ ZTEST(datastore_util_tests, test_notify_multi_state_subs_success)
 }
 
 /**
- * @test The isUintDatapointInSubRange function must return true when
+ * @test The isUintRangeInSubRange function must return true when
  * datapointId equals the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=10 should be included.
@@ -2398,14 +2481,14 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_at_start)
   bool result;
 
   /* Test with datapointId = 10 (start of range [10, 15)) */
-  result = isUintDatapointInSubRange(10, &sub);
+  result = isUintRangeInSubRange(10, 1, &sub);
 
   zassert_true(result,
                "datapointId 10 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isUintDatapointInSubRange function must return true when
+ * @test The isUintRangeInSubRange function must return true when
  * datapointId is in the middle of the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=12 should be included.
@@ -2421,14 +2504,14 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_middle)
   bool result;
 
   /* Test with datapointId = 12 (middle of range [10, 15)) */
-  result = isUintDatapointInSubRange(12, &sub);
+  result = isUintRangeInSubRange(12, 1, &sub);
 
   zassert_true(result,
                "datapointId 12 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isUintDatapointInSubRange function must return true when
+ * @test The isUintRangeInSubRange function must return true when
  * datapointId equals the last valid datapoint ID in the subscription range.
  *
  * Subscription covers datapoints [10, 15), so datapointId=14 (last included) should be true.
@@ -2444,14 +2527,14 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_last)
   bool result;
 
   /* Test with datapointId = 14 (last in range [10, 15)) */
-  result = isUintDatapointInSubRange(14, &sub);
+  result = isUintRangeInSubRange(14, 1, &sub);
 
   zassert_true(result,
                "datapointId 14 should be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isUintDatapointInSubRange function must return false when
+ * @test The isUintRangeInSubRange function must return false when
  * datapointId equals the subscription ending boundary (exclusive).
  *
  * Subscription covers datapoints [10, 15), so datapointId=15 should NOT be included.
@@ -2467,14 +2550,14 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_at_end_boundary)
   bool result;
 
   /* Test with datapointId = 15 (end boundary of range [10, 15), exclusive) */
-  result = isUintDatapointInSubRange(15, &sub);
+  result = isUintRangeInSubRange(15, 1, &sub);
 
   zassert_false(result,
                 "datapointId 15 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isUintDatapointInSubRange function must return false when
+ * @test The isUintRangeInSubRange function must return false when
  * datapointId is less than the subscription starting datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=9 should NOT be included.
@@ -2490,14 +2573,14 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_before_start)
   bool result;
 
   /* Test with datapointId = 9 (before range [10, 15)) */
-  result = isUintDatapointInSubRange(9, &sub);
+  result = isUintRangeInSubRange(9, 1, &sub);
 
   zassert_false(result,
                 "datapointId 9 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isUintDatapointInSubRange function must return false when
+ * @test The isUintRangeInSubRange function must return false when
  * datapointId is greater than the subscription ending datapoint ID.
  *
  * Subscription covers datapoints [10, 15), so datapointId=20 should NOT be included.
@@ -2513,14 +2596,14 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_after_end)
   bool result;
 
   /* Test with datapointId = 20 (well after range [10, 15)) */
-  result = isUintDatapointInSubRange(20, &sub);
+  result = isUintRangeInSubRange(20, 1, &sub);
 
   zassert_false(result,
                 "datapointId 20 should NOT be included in subscription range [10, 15)");
 }
 
 /**
- * @test The isUintDatapointInSubRange function must handle a subscription
+ * @test The isUintRangeInSubRange function must handle a subscription
  * with a single datapoint correctly when the datapointId matches.
  *
  * Subscription covers only datapoint [5, 6), so datapointId=5 should be included.
@@ -2536,14 +2619,14 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_single_datapoint_inc
   bool result;
 
   /* Test with datapointId = 5 (single datapoint range [5, 6)) */
-  result = isUintDatapointInSubRange(5, &sub);
+  result = isUintRangeInSubRange(5, 1, &sub);
 
   zassert_true(result,
                "datapointId 5 should be included in single datapoint subscription [5, 6)");
 }
 
 /**
- * @test The isUintDatapointInSubRange function must handle a subscription
+ * @test The isUintRangeInSubRange function must handle a subscription
  * with a single datapoint correctly when the datapointId does not match.
  *
  * Subscription covers only datapoint [5, 6), so datapointId=6 should NOT be included.
@@ -2559,14 +2642,14 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_single_datapoint_not
   bool result;
 
   /* Test with datapointId = 6 (outside single datapoint range [5, 6)) */
-  result = isUintDatapointInSubRange(6, &sub);
+  result = isUintRangeInSubRange(6, 1, &sub);
 
   zassert_false(result,
                 "datapointId 6 should NOT be included in single datapoint subscription [5, 6)");
 }
 
 /**
- * @test The isUintDatapointInSubRange function must correctly handle
+ * @test The isUintRangeInSubRange function must correctly handle
  * datapointId 0 when it is included in the subscription range.
  *
  * Subscription covers datapoints [0, 3), so datapointId=0 should be included.
@@ -2582,14 +2665,14 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_zero_included)
   bool result;
 
   /* Test with datapointId = 0 (start of range [0, 3)) */
-  result = isUintDatapointInSubRange(0, &sub);
+  result = isUintRangeInSubRange(0, 1, &sub);
 
   zassert_true(result,
                "datapointId 0 should be included in subscription range [0, 3)");
 }
 
 /**
- * @test The isUintDatapointInSubRange function must correctly handle
+ * @test The isUintRangeInSubRange function must correctly handle
  * datapointId 0 when it is not included in the subscription range.
  *
  * Subscription covers datapoints [1, 3), so datapointId=0 should NOT be included.
@@ -2605,7 +2688,7 @@ ZTEST(datastore_util_tests, test_is_uint_datapoint_in_range_zero_not_included)
   bool result;
 
   /* Test with datapointId = 0 (before range [1, 3)) */
-  result = isUintDatapointInSubRange(0, &sub);
+  result = isUintRangeInSubRange(0, 1, &sub);
 
   zassert_false(result,
                 "datapointId 0 should NOT be included in subscription range [1, 3)");
@@ -2755,7 +2838,7 @@ ZTEST(datastore_util_tests, test_notify_uint_subs_notification_failure)
   osMemoryPoolAlloc_fake.return_val = NULL;
 
   /* Call notifyUintSubs with datapointId=0 - should fail on first matching subscription */
-  result = notifyUintSubs(0, pool);
+  result = notifyUintSubs(0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "notifyUintSubs should return -ENOSPC when allocation fails");
@@ -2806,7 +2889,7 @@ ZTEST(datastore_util_tests, test_notify_uint_subs_success)
   mock_subscription_callback_fake.return_val = 0;
 
   /* Call notifyUintSubs with datapointId=0 - should notify only subscription 0 */
-  result = notifyUintSubs(0, pool);
+  result = notifyUintSubs(0, 1, pool);
 
   zassert_equal(result, 0,
                 "notifyUintSubs should return 0 on success");
@@ -3255,8 +3338,26 @@ ZTEST(datastore_util_tests, test_allocate_uint_subs_success)
 }
 
 /**
- * @test The datastoreUtilCalculateBufferSize function must return 0 when
- * all datapoint counts are zero.
+ * @test A type without subscription must allocate no subscription entry and
+ * reject its subscriptions.
+ */
+ZTEST(datastore_util_tests, test_allocate_subs_disabled)
+{
+  DatastoreSubEntry_t sub = {0};
+
+  zassert_equal(datastoreUtilAllocateBinarySubs(0), 0,
+                "Should return 0 for disabled subscriptions");
+  zassert_equal(k_malloc_fake.call_count, 0,
+                "k_malloc should not be called");
+  zassert_is_null(binarySubs.entries,
+                  "binarySubs.entries should remain NULL");
+  zassert_equal(datastoreUtilAddBinarySub(&sub, NULL), -ENOBUFS,
+                "Should return -ENOBUFS for disabled subscriptions");
+}
+
+/**
+ * @test The datastoreUtilCalculateBufferSize function must return the
+ * payload header size when all datapoint counts are zero.
  */
 ZTEST(datastore_util_tests, test_calculate_buffer_size_all_zero)
 {
@@ -3265,8 +3366,8 @@ ZTEST(datastore_util_tests, test_calculate_buffer_size_all_zero)
 
   result = datastoreUtilCalculateBufferSize(counts);
 
-  zassert_equal(result, 0,
-                "Should return 0 when all counts are zero");
+  zassert_equal(result, sizeof(SrvMsgPayload_t),
+                "Should return the payload header size when all counts are zero");
 }
 
 /**
@@ -3280,8 +3381,8 @@ ZTEST(datastore_util_tests, test_calculate_buffer_size_first_max)
 
   result = datastoreUtilCalculateBufferSize(counts);
 
-  zassert_equal(result, 10 * sizeof(Datapoint_t),
-                "Should return max_count * sizeof(Datapoint_t)");
+  zassert_equal(result, sizeof(SrvMsgPayload_t) + 10 * sizeof(Data_t),
+                "Should return the payload header and max_count values");
 }
 
 /**
@@ -3295,8 +3396,8 @@ ZTEST(datastore_util_tests, test_calculate_buffer_size_last_max)
 
   result = datastoreUtilCalculateBufferSize(counts);
 
-  zassert_equal(result, 15 * sizeof(Datapoint_t),
-                "Should return max_count * sizeof(Datapoint_t)");
+  zassert_equal(result, sizeof(SrvMsgPayload_t) + 15 * sizeof(Data_t),
+                "Should return the payload header and max_count values");
 }
 
 /**
@@ -3310,8 +3411,8 @@ ZTEST(datastore_util_tests, test_calculate_buffer_size_middle_max)
 
   result = datastoreUtilCalculateBufferSize(counts);
 
-  zassert_equal(result, 12 * sizeof(Datapoint_t),
-                "Should return max_count * sizeof(Datapoint_t)");
+  zassert_equal(result, sizeof(SrvMsgPayload_t) + 12 * sizeof(Data_t),
+                "Should return the payload header and max_count values");
 }
 
 /**
@@ -3325,8 +3426,8 @@ ZTEST(datastore_util_tests, test_calculate_buffer_size_multiple_max)
 
   result = datastoreUtilCalculateBufferSize(counts);
 
-  zassert_equal(result, 8 * sizeof(Datapoint_t),
-                "Should return max_count * sizeof(Datapoint_t)");
+  zassert_equal(result, sizeof(SrvMsgPayload_t) + 8 * sizeof(Data_t),
+                "Should return the payload header and max_count values");
 }
 
 /**
@@ -3340,8 +3441,8 @@ ZTEST(datastore_util_tests, test_calculate_buffer_size_all_same)
 
   result = datastoreUtilCalculateBufferSize(counts);
 
-  zassert_equal(result, 7 * sizeof(Datapoint_t),
-                "Should return max_count * sizeof(Datapoint_t)");
+  zassert_equal(result, sizeof(SrvMsgPayload_t) + 7 * sizeof(Data_t),
+                "Should return the payload header and max_count values");
 }
 
 /**
@@ -3355,8 +3456,8 @@ ZTEST(datastore_util_tests, test_calculate_buffer_size_single_nonzero)
 
   result = datastoreUtilCalculateBufferSize(counts);
 
-  zassert_equal(result, 20 * sizeof(Datapoint_t),
-                "Should return max_count * sizeof(Datapoint_t)");
+  zassert_equal(result, sizeof(SrvMsgPayload_t) + 20 * sizeof(Data_t),
+                "Should return the payload header and max_count values");
 }
 
 /**
@@ -5093,6 +5194,128 @@ ZTEST(datastore_util_tests, test_read_success)
   zassert_equal(values[1].uintVal, 0, "Second value should match");
 }
 
+/**
+ * @test The datastoreUtilDirectRead function must return -EINVAL when the
+ * datapoint ID or value count is invalid.
+ */
+ZTEST(datastore_util_tests, test_direct_read_invalid_datapoint)
+{
+  Data_t values[2];
+  int result;
+
+  result = datastoreUtilDirectRead(DATAPOINT_FLOAT, 100, 1, values);
+
+  zassert_equal(result, -EINVAL,
+                "Should return -EINVAL when datapoint ID is invalid");
+}
+
+/**
+ * @test The datastoreUtilDirectRead function must return -EINVAL when the
+ * datapoint type is invalid.
+ */
+ZTEST(datastore_util_tests, test_direct_read_invalid_type)
+{
+  Data_t values[1];
+  int result;
+
+  result = datastoreUtilDirectRead(DATAPOINT_TYPE_COUNT, 0, 1, values);
+
+  zassert_equal(result, -EINVAL,
+                "Should return -EINVAL when datapoint type is invalid");
+}
+
+/**
+ * @test The datastoreUtilDirectRead function must read the datapoint values
+ * when no write is in progress.
+ */
+ZTEST(datastore_util_tests, test_direct_read_success)
+{
+  Data_t values[2];
+  int result;
+
+  floats[0].value.floatVal = 1.5f;
+  floats[1].value.floatVal = -2.5f;
+  atomic_set(writeSequences + DATAPOINT_FLOAT, 4);
+
+  result = datastoreUtilDirectRead(DATAPOINT_FLOAT, 0, 2, values);
+
+  zassert_equal(result, 0, "Should return 0 on success");
+  zassert_equal(values[0].floatVal, 1.5f, "First value should match");
+  zassert_equal(values[1].floatVal, -2.5f, "Second value should match");
+}
+
+/**
+ * @test The datastoreUtilDirectRead function must return -EAGAIN when a
+ * write is in progress for the datapoint type.
+ */
+ZTEST(datastore_util_tests, test_direct_read_write_in_progress)
+{
+  Data_t values[1];
+  int result;
+
+  /* Odd sequence: write in progress */
+  atomic_set(writeSequences + DATAPOINT_INT, 3);
+
+  result = datastoreUtilDirectRead(DATAPOINT_INT, 0, 1, values);
+
+  zassert_equal(result, -EAGAIN,
+                "Should return -EAGAIN while a write is in progress");
+}
+
+/**
+ * @test The datastoreUtilDirectRead function must not be affected by a write
+ * in progress for another datapoint type.
+ */
+ZTEST(datastore_util_tests, test_direct_read_other_type_write_in_progress)
+{
+  Data_t values[1];
+  int result;
+
+  uints[0].value.uintVal = 42;
+  atomic_set(writeSequences + DATAPOINT_INT, 1);
+
+  result = datastoreUtilDirectRead(DATAPOINT_UINT, 0, 1, values);
+
+  zassert_equal(result, 0, "Should return 0 on success");
+  zassert_equal(values[0].uintVal, 42, "Value should match");
+}
+
+/**
+ * @test The datastoreUtilWrite function must advance the write sequence of
+ * the datapoint type by two, leaving it even.
+ */
+ZTEST(datastore_util_tests, test_write_advances_write_sequence)
+{
+  Data_t values[1] = {{.uintVal = 7}};
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+  int result;
+
+  uints[0].value.uintVal = 7;
+
+  result = datastoreUtilWrite(DATAPOINT_UINT, 0, values, 1, pool);
+
+  zassert_equal(result, 0, "Should return 0 on success");
+  zassert_equal(atomic_get(writeSequences + DATAPOINT_UINT), 2,
+                "Write sequence should be advanced by two");
+  zassert_equal(atomic_get(writeSequences + DATAPOINT_BINARY), 0,
+                "Other write sequences should not change");
+}
+
+/**
+ * @test The datastoreUtilWrite function must not advance the write sequence
+ * when the datapoint ID or value count is invalid.
+ */
+ZTEST(datastore_util_tests, test_write_invalid_keeps_write_sequence)
+{
+  Data_t values[1] = {{.uintVal = 7}};
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+
+  datastoreUtilWrite(DATAPOINT_UINT, 100, values, 1, pool);
+
+  zassert_equal(atomic_get(writeSequences + DATAPOINT_UINT), 0,
+                "Write sequence should not change on invalid write");
+}
+
 /**
  * @test The datastoreUtilWrite function must return -EINVAL when the
  * datapoint ID or value count is invalid.
@@ -5249,6 +5472,307 @@ ZTEST(datastore_util_tests, test_write_success_with_notification)
                    "Callback should be called with non-NULL message");
 }
 
+/**
+ * @test The datastoreUtilWrite function must leave the value buffer to its
+ * caller, the request buffer being released by the datastore thread.
+ */
+ZTEST(datastore_util_tests, test_write_keeps_caller_values)
+{
+  static uint8_t fake_buffer[256];
+  static uint8_t fake_msg[256];
+  Data_t values[1] = {{.uintVal = 7}};
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+  int result;
+
+  /* Set up binary subscriptions */
+  k_malloc_fake.return_val = fake_buffer;
+  datastoreUtilAllocateBinarySubs(5);
+  binarySubs.activeCount = 1;
+  binarySubs.entries[0].datapointId = 0;
+  binarySubs.entries[0].valCount = 1;
+  binarySubs.entries[0].isPaused = false;
+  binarySubs.entries[0].callback = mock_subscription_callback;
+  binaries[0].value.uintVal = 0;
+  osMemoryPoolAlloc_fake.return_val = fake_msg;
+
+  result = datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 1, pool);
+
+  zassert_equal(result, 0, "Should return 0 on success");
+  for(size_t i = 0; i < osMemoryPoolFree_fake.call_count && i < FFF_ARG_HISTORY_LEN; ++i)
+    zassert_not_equal(osMemoryPoolFree_fake.arg1_history[i], values,
+                      "The caller value buffer should not be freed");
+
+  /* Invalid writes leave the buffer too */
+  RESET_FAKE(osMemoryPoolFree);
+  result = datastoreUtilWrite(DATAPOINT_BINARY, 100, values, 1, pool);
+
+  zassert_equal(result, -EINVAL, "Should return -EINVAL on an invalid datapoint ID");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "The caller value buffer should not be freed on an invalid write");
+}
+
+/**
+ * @test The datastoreUtilWrite function must notify a subscription
+ * overlapping a changed datapoint past the first written datapoint.
+ */
+ZTEST(datastore_util_tests, test_write_notifies_sub_past_first_datapoint)
+{
+  static uint8_t fake_buffer[256];
+  static uint8_t fake_msg[256];
+  Data_t values[3] = {{.uintVal = 0}, {.uintVal = 0}, {.uintVal = 1}};
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+
+  k_malloc_fake.return_val = fake_buffer;
+  datastoreUtilAllocateBinarySubs(5);
+  binarySubs.activeCount = 1;
+  binarySubs.entries[0].datapointId = 2;
+  binarySubs.entries[0].valCount = 1;
+  binarySubs.entries[0].isPaused = false;
+  binarySubs.entries[0].callback = mock_subscription_callback;
+
+  binaries[0].value.uintVal = 0;
+  binaries[1].value.uintVal = 0;
+  binaries[2].value.uintVal = 0;
+
+  osMemoryPoolAlloc_fake.return_val = fake_msg;
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 3, pool), 0,
+                "Should return 0 on success");
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Subscription on the last written datapoint should be notified");
+}
+
+/**
+ * @test The datastoreUtilWrite function must not notify a subscription only
+ * overlapping the unchanged datapoints of the write.
+ */
+ZTEST(datastore_util_tests, test_write_skips_sub_on_unchanged_datapoints)
+{
+  static uint8_t fake_buffer[256];
+  Data_t values[3] = {{.uintVal = 1}, {.uintVal = 0}, {.uintVal = 0}};
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+
+  k_malloc_fake.return_val = fake_buffer;
+  datastoreUtilAllocateBinarySubs(5);
+  binarySubs.activeCount = 1;
+  binarySubs.entries[0].datapointId = 1;
+  binarySubs.entries[0].valCount = 2;
+  binarySubs.entries[0].isPaused = false;
+  binarySubs.entries[0].callback = mock_subscription_callback;
+
+  binaries[0].value.uintVal = 0;
+  binaries[1].value.uintVal = 0;
+  binaries[2].value.uintVal = 0;
+
+  zassert_equal(datastoreUtilWrite(DATAPOINT_BINARY, 0, values, 3, pool), 0,
+                "Should return 0 on success");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0,
+                "Subscription on unchanged datapoints should not be notified");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must return -EINVAL when the
+ * operation count is zero or above the maximum.
+ */
+ZTEST(datastore_util_tests, test_apply_batch_invalid_op_count)
+{
+  Data_t buffer[32];
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+
+  zassert_equal(datastoreUtilApplyBatch(buffer, 0, pool), -EINVAL,
+                "Should return -EINVAL when operation count is zero");
+  zassert_equal(datastoreUtilApplyBatch(buffer, CONFIG_ENYA_DATASTORE_BATCH_MAX_OPS + 1, pool), -EINVAL,
+                "Should return -EINVAL when operation count is above the maximum");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must return -EINVAL and apply
+ * none of the operations when one operation is invalid.
+ */
+ZTEST(datastore_util_tests, test_apply_batch_invalid_op_applies_nothing)
+{
+  Data_t buffer[32];
+  Data_t floatVal = {.floatVal = 9.5f};
+  Data_t intVal = {.intVal = -3};
+  size_t cursor = 0;
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+  int result;
+
+  floats[0].value.floatVal = 1.0f;
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_WRITE, DATAPOINT_FLOAT, 0, 1, &floatVal);
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_WRITE, DATAPOINT_INT, 100, 1, &intVal);
+
+  result = datastoreUtilApplyBatch(buffer, 2, pool);
+
+  zassert_equal(result, -EINVAL, "Should return -EINVAL when an operation is invalid");
+  zassert_equal(floats[0].value.floatVal, 1.0f, "Valid operation should not be applied");
+  zassert_equal(atomic_get(writeSequences + DATAPOINT_FLOAT), 0,
+                "Write sequence should not change when the batch is rejected");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must return -EINVAL when an
+ * operation type is invalid.
+ */
+ZTEST(datastore_util_tests, test_apply_batch_invalid_op_type)
+{
+  Data_t buffer[32];
+  Data_t value = {.uintVal = 1};
+  size_t cursor = 0;
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_OP_TYPE_COUNT, DATAPOINT_UINT, 0, 1, &value);
+
+  zassert_equal(datastoreUtilApplyBatch(buffer, 1, pool), -EINVAL,
+                "Should return -EINVAL when the operation type is invalid");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must apply write operations and
+ * fill the read operation values in place.
+ */
+ZTEST(datastore_util_tests, test_apply_batch_read_write_success)
+{
+  Data_t buffer[32];
+  Data_t floatVal = {.floatVal = 4.25f};
+  size_t cursor = 0;
+  size_t readCursor;
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+  int result;
+
+  floats[1].value.floatVal = 0.0f;
+  ints[0].value.intVal = -7;
+  ints[1].value.intVal = 11;
+
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_WRITE, DATAPOINT_FLOAT, 1, 1, &floatVal);
+  readCursor = cursor + DATASTORE_BATCH_OP_HEADER_LEN;
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_READ, DATAPOINT_INT, 0, 2, NULL);
+
+  result = datastoreUtilApplyBatch(buffer, 2, pool);
+
+  zassert_equal(result, 0, "Should return 0 on success");
+  zassert_equal(floats[1].value.floatVal, 4.25f, "Float value should be written");
+  zassert_equal(buffer[readCursor].intVal, -7, "First read value should match");
+  zassert_equal(buffer[readCursor + 1].intVal, 11, "Second read value should match");
+  zassert_equal(atomic_get(writeSequences + DATAPOINT_FLOAT), 2,
+                "Written type sequence should be advanced by two");
+  zassert_equal(atomic_get(writeSequences + DATAPOINT_INT), 0,
+                "Read only type sequence should not change");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must notify a subscription only
+ * once when several operations of the batch change values in its range.
+ */
+ZTEST(datastore_util_tests, test_apply_batch_coalesced_notification)
+{
+  static uint8_t fake_buffer[256];
+  static uint8_t fake_msg[256];
+  Data_t buffer[32];
+  Data_t first = {.uintVal = 1};
+  Data_t third = {.uintVal = 1};
+  size_t cursor = 0;
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+  int result;
+
+  k_malloc_fake.return_val = fake_buffer;
+  datastoreUtilAllocateBinarySubs(5);
+  binarySubs.activeCount = 1;
+  binarySubs.entries[0].datapointId = 0;
+  binarySubs.entries[0].valCount = 3;
+  binarySubs.entries[0].isPaused = false;
+  binarySubs.entries[0].callback = mock_subscription_callback;
+
+  binaries[0].value.uintVal = 0;
+  binaries[2].value.uintVal = 0;
+
+  osMemoryPoolAlloc_fake.return_val = fake_msg;
+  mock_subscription_callback_fake.return_val = 0;
+
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_WRITE, DATAPOINT_BINARY, 0, 1, &first);
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_WRITE, DATAPOINT_BINARY, 2, 1, &third);
+
+  result = datastoreUtilApplyBatch(buffer, 2, pool);
+
+  zassert_equal(result, 0, "Should return 0 on success");
+  zassert_equal(mock_subscription_callback_fake.call_count, 1,
+                "Callback should be called once for the whole batch");
+  zassert_equal(mock_subscription_callback_fake.arg1_val, 3,
+                "Callback should receive the subscription value count");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must not notify when the batch
+ * writes do not change any value, or when the subscription is paused.
+ */
+ZTEST(datastore_util_tests, test_apply_batch_no_change_no_notification)
+{
+  static uint8_t fake_buffer[256];
+  Data_t buffer[32];
+  Data_t same = {.uintVal = 5};
+  Data_t changed = {.uintVal = 6};
+  size_t cursor = 0;
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+  int result;
+
+  k_malloc_fake.return_val = fake_buffer;
+  datastoreUtilAllocateUintSubs(5);
+  uintSubs.activeCount = 2;
+  uintSubs.entries[0].datapointId = 0;
+  uintSubs.entries[0].valCount = 1;
+  uintSubs.entries[0].isPaused = false;
+  uintSubs.entries[0].callback = mock_subscription_callback;
+  uintSubs.entries[1].datapointId = 1;
+  uintSubs.entries[1].valCount = 1;
+  uintSubs.entries[1].isPaused = true;
+  uintSubs.entries[1].callback = mock_subscription_callback;
+
+  uints[0].value.uintVal = 5;
+  uints[1].value.uintVal = 0;
+
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_WRITE, DATAPOINT_UINT, 0, 1, &same);
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_WRITE, DATAPOINT_UINT, 1, 1, &changed);
+
+  result = datastoreUtilApplyBatch(buffer, 2, pool);
+
+  zassert_equal(result, 0, "Should return 0 on success");
+  zassert_equal(uints[1].value.uintVal, 6, "Changed value should be written");
+  zassert_equal(mock_subscription_callback_fake.call_count, 0,
+                "Callback should not be called for unchanged or paused subscriptions");
+}
+
+/**
+ * @test The datastoreUtilApplyBatch function must return the error code when
+ * a notification fails, after applying the batch.
+ */
+ZTEST(datastore_util_tests, test_apply_batch_notification_failure)
+{
+  static uint8_t fake_buffer[256];
+  Data_t buffer[32];
+  Data_t value = {.intVal = 12};
+  size_t cursor = 0;
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+  int result;
+
+  k_malloc_fake.return_val = fake_buffer;
+  datastoreUtilAllocateIntSubs(5);
+  intSubs.activeCount = 1;
+  intSubs.entries[0].datapointId = 0;
+  intSubs.entries[0].valCount = 2;
+  intSubs.entries[0].isPaused = false;
+  intSubs.entries[0].callback = mock_subscription_callback;
+
+  ints[1].value.intVal = 0;
+  osMemoryPoolAlloc_fake.return_val = NULL;
+
+  packBatchOp(buffer, &cursor, DATASTORE_BATCH_WRITE, DATAPOINT_INT, 1, 1, &value);
+
+  result = datastoreUtilApplyBatch(buffer, 1, pool);
+
+  zassert_equal(result, -ENOSPC, "Should return -ENOSPC when the notification fails");
+  zassert_equal(ints[1].value.intVal, 12, "Value should be written before notifying");
+}
+
 /**
  * @test The datastoreUtilNotify function must return -ENOTSUP when the
  * datapoint type is invalid.
@@ -5259,7 +5783,7 @@ ZTEST(datastore_util_tests, test_notify_invalid_type)
   int result;
 
   /* Try to notify with invalid datapoint type */
-  result = datastoreUtilNotify(DATAPOINT_TYPE_COUNT, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_TYPE_COUNT, 0, 1, pool);
 
   zassert_equal(result, -ENOTSUP,
                 "Should return -ENOTSUP when datapoint type is invalid");
@@ -5285,7 +5809,7 @@ ZTEST(datastore_util_tests, test_notify_binary_subs_failure)
 
   osMemoryPoolAlloc_fake.return_val = NULL;
 
-  result = datastoreUtilNotify(DATAPOINT_BINARY, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_BINARY, 0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "Should return -ENOSPC when notifyBinarySubs fails");
@@ -5311,7 +5835,7 @@ ZTEST(datastore_util_tests, test_notify_button_subs_failure)
 
   osMemoryPoolAlloc_fake.return_val = NULL;
 
-  result = datastoreUtilNotify(DATAPOINT_BUTTON, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_BUTTON, 0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "Should return -ENOSPC when notifyButtonSubs fails");
@@ -5337,7 +5861,7 @@ ZTEST(datastore_util_tests, test_notify_float_subs_failure)
 
   osMemoryPoolAlloc_fake.return_val = NULL;
 
-  result = datastoreUtilNotify(DATAPOINT_FLOAT, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_FLOAT, 0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "Should return -ENOSPC when notifyFloatSubs fails");
@@ -5363,7 +5887,7 @@ ZTEST(datastore_util_tests, test_notify_int_subs_failure)
 
   osMemoryPoolAlloc_fake.return_val = NULL;
 
-  result = datastoreUtilNotify(DATAPOINT_INT, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_INT, 0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "Should return -ENOSPC when notifyIntSubs fails");
@@ -5389,7 +5913,7 @@ ZTEST(datastore_util_tests, test_notify_multi_state_subs_failure)
 
   osMemoryPoolAlloc_fake.return_val = NULL;
 
-  result = datastoreUtilNotify(DATAPOINT_MULTI_STATE, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_MULTI_STATE, 0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "Should return -ENOSPC when notifyMultiStateSubs fails");
@@ -5415,7 +5939,7 @@ ZTEST(datastore_util_tests, test_notify_uint_subs_failure)
 
   osMemoryPoolAlloc_fake.return_val = NULL;
 
-  result = datastoreUtilNotify(DATAPOINT_UINT, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_UINT, 0, 1, pool);
 
   zassert_equal(result, -ENOSPC,
                 "Should return -ENOSPC when notifyUintSubs fails");
@@ -5443,7 +5967,7 @@ ZTEST(datastore_util_tests, test_util_notify_binary_success)
   osMemoryPoolAlloc_fake.return_val = fake_msg;
   mock_subscription_callback_fake.return_val = 0;
 
-  result = datastoreUtilNotify(DATAPOINT_BINARY, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_BINARY, 0, 1, pool);
 
   zassert_equal(result, 0, "Should return 0 on success");
 }
@@ -5470,7 +5994,7 @@ ZTEST(datastore_util_tests, test_util_notify_button_success)
   osMemoryPoolAlloc_fake.return_val = fake_msg;
   mock_subscription_callback_fake.return_val = 0;
 
-  result = datastoreUtilNotify(DATAPOINT_BUTTON, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_BUTTON, 0, 1, pool);
 
   zassert_equal(result, 0, "Should return 0 on success");
 }
@@ -5497,7 +6021,7 @@ ZTEST(datastore_util_tests, test_util_notify_float_success)
   osMemoryPoolAlloc_fake.return_val = fake_msg;
   mock_subscription_callback_fake.return_val = 0;
 
-  result = datastoreUtilNotify(DATAPOINT_FLOAT, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_FLOAT, 0, 1, pool);
 
   zassert_equal(result, 0, "Should return 0 on success");
 }
@@ -5524,7 +6048,7 @@ ZTEST(datastore_util_tests, test_util_notify_int_success)
   osMemoryPoolAlloc_fake.return_val = fake_msg;
   mock_subscription_callback_fake.return_val = 0;
 
-  result = datastoreUtilNotify(DATAPOINT_INT, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_INT, 0, 1, pool);
 
   zassert_equal(result, 0, "Should return 0 on success");
 }
@@ -5551,7 +6075,7 @@ ZTEST(datastore_util_tests, test_util_notify_multi_state_success)
   osMemoryPoolAlloc_fake.return_val = fake_msg;
   mock_subscription_callback_fake.return_val = 0;
 
-  result = datastoreUtilNotify(DATAPOINT_MULTI_STATE, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_MULTI_STATE, 0, 1, pool);
 
   zassert_equal(result, 0, "Should return 0 on success");
 }
@@ -5578,9 +6102,167 @@ ZTEST(datastore_util_tests, test_util_notify_uint_success)
   osMemoryPoolAlloc_fake.return_val = fake_msg;
   mock_subscription_callback_fake.return_val = 0;
 
-  result = datastoreUtilNotify(DATAPOINT_UINT, 0, pool);
+  result = datastoreUtilNotify(DATAPOINT_UINT, 0, 1, pool);
+
+  zassert_equal(result, 0, "Should return 0 on success");
+}
+
+/**
+ * @test The datastoreUtilGetNvmCount function must return the persisted
+ * datapoint count of the type.
+ */
+ZTEST(datastore_util_tests, test_get_nvm_count)
+{
+  zassert_equal(datastoreUtilGetNvmCount(DATAPOINT_BINARY), 1, "Binary should have one persisted datapoint");
+  zassert_equal(datastoreUtilGetNvmCount(DATAPOINT_UINT), 1, "Uint should have one persisted datapoint");
+  zassert_equal(datastoreUtilGetNvmCount(DATAPOINT_FLOAT), 0, "Float should have no persisted datapoint");
+  zassert_equal(datastoreUtilGetNvmCount(DATAPOINT_TYPE_COUNT), 0, "Invalid type should have no persisted datapoint");
+}
+
+/**
+ * @test The datastoreUtilRestoreNvm function must return -EINVAL when the
+ * value count does not match the persisted datapoint count.
+ */
+ZTEST(datastore_util_tests, test_restore_nvm_invalid_count)
+{
+  Data_t values[2] = {{.uintVal = 11}, {.uintVal = 22}};
+  int result;
+
+  uints[0].value.uintVal = 0;
+  uints[1].value.uintVal = 0;
+
+  result = datastoreUtilRestoreNvm(DATAPOINT_UINT, values, 2);
+
+  zassert_equal(result, -EINVAL, "Should return -EINVAL for a count mismatch");
+  zassert_equal(uints[1].value.uintVal, 0, "Persisted datapoint should not change");
+  zassert_equal(atomic_get(writeSequences + DATAPOINT_UINT), 0, "Write sequence should not change");
+}
+
+/**
+ * @test The datastoreUtilRestoreNvm function must return -EINVAL for an
+ * invalid type.
+ */
+ZTEST(datastore_util_tests, test_restore_nvm_invalid_type)
+{
+  Data_t values[1] = {{.uintVal = 11}};
+
+  zassert_equal(datastoreUtilRestoreNvm(DATAPOINT_TYPE_COUNT, values, 1), -EINVAL,
+                "Should return -EINVAL for an invalid type");
+}
+
+/**
+ * @test The datastoreUtilRestoreNvm function must restore only the persisted
+ * datapoints, without marking the type dirty.
+ */
+ZTEST(datastore_util_tests, test_restore_nvm_success)
+{
+  Data_t values[1] = {{.uintVal = 42}};
+  int result;
+
+  uints[0].value.uintVal = 5;
+  uints[1].value.uintVal = 0;
+
+  result = datastoreUtilRestoreNvm(DATAPOINT_UINT, values, 1);
+
+  zassert_equal(result, 0, "Should return 0 on success");
+  zassert_equal(uints[0].value.uintVal, 5, "Non persisted datapoint should not change");
+  zassert_equal(uints[1].value.uintVal, 42, "Persisted datapoint should be restored");
+  zassert_equal(atomic_get(writeSequences + DATAPOINT_UINT), 2, "Restore should be seen as a write");
+  zassert_equal(datastoreUtilGetNvmDirtyTypes(), 0, "Restore should not mark the type dirty");
+}
+
+/**
+ * @test The datastoreUtilWrite function must mark the type dirty in the NVM
+ * journal when a persisted datapoint changes.
+ */
+ZTEST(datastore_util_tests, test_write_persisted_marks_nvm_dirty)
+{
+  Data_t values[1] = {{.uintVal = 9}};
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+  int result;
+
+  uints[1].value.uintVal = 0;
+
+  result = datastoreUtilWrite(DATAPOINT_UINT, 1, values, 1, pool);
 
   zassert_equal(result, 0, "Should return 0 on success");
+  zassert_equal(datastoreUtilGetNvmDirtyTypes(), BIT(DATAPOINT_UINT), "Uint type should be dirty");
+}
+
+/**
+ * @test The datastoreUtilWrite function must not mark the type dirty when
+ * the persisted datapoints are unchanged.
+ */
+ZTEST(datastore_util_tests, test_write_not_persisted_keeps_nvm_clean)
+{
+  Data_t values[2] = {{.uintVal = 3}, {.uintVal = 4}};
+  osMemoryPoolId_t pool = (osMemoryPoolId_t)0x1000;
+
+  uints[0].value.uintVal = 0;
+  uints[1].value.uintVal = 4;
+
+  datastoreUtilWrite(DATAPOINT_UINT, 0, values, 2, pool);
+
+  zassert_equal(datastoreUtilGetNvmDirtyTypes(), 0, "No type should be dirty");
+}
+
+/**
+ * @test The datastoreUtilSnapshotNvm function must copy the persisted values
+ * and clear the dirty type.
+ */
+ZTEST(datastore_util_tests, test_snapshot_nvm)
+{
+  Data_t values[1] = {{.uintVal = 0}};
+  size_t count;
+
+  uints[0].value.uintVal = 5;
+  uints[1].value.uintVal = 77;
+  nvmDirtyTypes = BIT(DATAPOINT_UINT) | BIT(DATAPOINT_BINARY);
+
+  count = datastoreUtilSnapshotNvm(DATAPOINT_UINT, values);
+
+  zassert_equal(count, 1, "Should copy one persisted value");
+  zassert_equal(values[0].uintVal, 77, "Should copy the persisted value");
+  zassert_equal(datastoreUtilGetNvmDirtyTypes(), BIT(DATAPOINT_BINARY), "Only the uint type should be cleared");
+}
+
+/**
+ * @test The datastoreUtilGetNotifyStats function must copy the notification
+ * count of each type and the allocation failure count.
+ */
+ZTEST(datastore_util_tests, test_get_notify_stats)
+{
+  DatastoreStats_t stats;
+
+  atomic_set(notifyCounts + DATAPOINT_FLOAT, 7);
+  atomic_set(notifyCounts + DATAPOINT_UINT, 3);
+  atomic_set(&notifyAllocFailures, 2);
+
+  datastoreUtilGetNotifyStats(&stats);
+
+  zassert_equal(stats.notifyCounts[DATAPOINT_FLOAT], 7, "Wrong float notification count");
+  zassert_equal(stats.notifyCounts[DATAPOINT_UINT], 3, "Wrong uint notification count");
+  zassert_equal(stats.notifyCounts[DATAPOINT_BINARY], 0, "Wrong binary notification count");
+  zassert_equal(stats.notifyAllocFailures, 2, "Wrong allocation failure count");
+}
+
+/**
+ * @test The datastoreUtilResetNotifyStats function must clear the notification
+ * counts and the allocation failure count.
+ */
+ZTEST(datastore_util_tests, test_reset_notify_stats)
+{
+  for(size_t i = 0; i < DATAPOINT_TYPE_COUNT; ++i)
+    atomic_set(notifyCounts + i, 5);
+
+  atomic_set(&notifyAllocFailures, 2);
+
+  datastoreUtilResetNotifyStats();
+
+  for(size_t i = 0; i < DATAPOINT_TYPE_COUNT; ++i)
+    zassert_equal(atomic_get(notifyCounts + i), 0, "The notification counts should be cleared");
+
+  zassert_equal(atomic_get(&notifyAllocFailures), 0, "The allocation failures should be cleared");
 }
 
 ZTEST_SUITE(datastore_util_tests, NULL, util_tests_setup, util_tests_before, NULL, NULL);
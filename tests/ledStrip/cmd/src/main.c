@@ -19,6 +19,8 @@ DEFINE_FFF_GLOBALS;
 
 /* Mock Kconfig options */
 #define CONFIG_ENYA_LED_STRIP             1
+#define CONFIG_ENYA_LED_STRIP_EFFECTS     1
+#define CONFIG_ENYA_LED_STRIP_STATS       1
 
 /* Prevent shell.h */
 #define SHELL_H__
@@ -38,6 +40,7 @@ enum shell_vt100_color
 static char captured_shell_output[256];
 static int shell_info_call_count  = 0;
 static int shell_error_call_count = 0;
+static int shell_print_call_count = 0;
 
 void shell_fprintf(const struct shell *sh, enum shell_vt100_color color,
                    const char *fmt, ...)
@@ -55,6 +58,8 @@ void shell_fprintf(const struct shell *sh, enum shell_vt100_color color,
     shell_error_call_count++;
   else if(color == SHELL_INFO)
     shell_info_call_count++;
+  else
+    shell_print_call_count++;
 }
 
 /* Include ledStrip.h to get struct led_rgb before mock declarations */
@@ -67,20 +72,30 @@ FAKE_VALUE_FUNC(unsigned long, shell_strtoul, const char *, int, int *);
 FAKE_VALUE_FUNC(struct led_rgb *, ledStripGetNextFramebuffer);
 FAKE_VALUE_FUNC(int, ledStripUpdateFrame, struct led_rgb *);
 FAKE_VALUE_FUNC(int, ledStripSetBrightness, uint8_t);
+FAKE_VALUE_FUNC(int, ledStripStartEffect, size_t, const LedStripEffect_t *);
+FAKE_VALUE_FUNC(int, ledStripStopEffect, size_t);
+FAKE_VALUE_FUNC(int, ledStripGetStats, LedStripStats_t *);
+FAKE_VALUE_FUNC(int, ledStripResetStats);
 
 #define FFF_FAKES_LIST(FAKE) \
   FAKE(shell_strtoul) \
   FAKE(ledStripGetNextFramebuffer) \
   FAKE(ledStripUpdateFrame) \
-  FAKE(ledStripSetBrightness)
+  FAKE(ledStripSetBrightness) \
+  FAKE(ledStripStartEffect) \
+  FAKE(ledStripStopEffect) \
+  FAKE(ledStripGetStats) \
+  FAKE(ledStripResetStats)
 
 /* Shell output macros */
 #define shell_info(sh, fmt, ...)  shell_fprintf(sh, SHELL_INFO,  fmt, ##__VA_ARGS__)
 #define shell_error(sh, fmt, ...) shell_fprintf(sh, SHELL_ERROR, fmt, ##__VA_ARGS__)
+#define shell_print(sh, fmt, ...) shell_fprintf(sh, SHELL_NORMAL, fmt, ##__VA_ARGS__)
 
 /* Null out shell registration macros */
 #define SHELL_CMD(...)
 #define SHELL_CMD_ARG(...)
+#define SHELL_COND_CMD(...)
 #define SHELL_SUBCMD_SET_END
 #define SHELL_STATIC_SUBCMD_SET_CREATE(...)
 #define SHELL_CMD_REGISTER(...)
@@ -121,6 +136,7 @@ static void cmd_tests_before(void *f)
   memset(captured_shell_output, 0, sizeof(captured_shell_output));
   shell_info_call_count  = 0;
   shell_error_call_count = 0;
+  shell_print_call_count = 0;
 }
 
 /**
@@ -318,4 +334,231 @@ ZTEST(ledStripCmd, test_execSetBrightness_success)
                "output should start with SUCCESS");
 }
 
+/* Started effect captured by the ledStripStartEffect fake */
+static LedStripEffect_t captured_effect;
+
+static int ledStripStartEffect_capture(size_t slot, const LedStripEffect_t *effect)
+{
+  ARG_UNUSED(slot);
+  captured_effect = *effect;
+  return ledStripStartEffect_fake.return_val;
+}
+
+/* Custom fake for shell_strtoul returning its argument value */
+static unsigned long shell_strtoul_parse(const char *str, int base, int *err)
+{
+  ARG_UNUSED(err);
+  return strtoul(str, NULL, base);
+}
+
+/**
+ * @test execEffectFill must return error and print FAIL when a color value is invalid.
+ */
+ZTEST(ledStripCmd, test_execEffectFill_invalidColor)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"fill", "invalid", "0", "0"};
+  int result;
+
+  shell_strtoul_fake.custom_fake = shell_strtoul_with_error;
+
+  result = execEffectFill(sh, 4, argv);
+
+  zassert_equal(result, -EINVAL, "execEffectFill should return error from shell_strtoul");
+  zassert_equal(ledStripStartEffect_fake.call_count, 0,
+                "ledStripStartEffect should not be called on invalid value");
+  zassert_equal(shell_error_call_count, 1, "shell_error should be called once");
+}
+
+/**
+ * @test execEffectFill must return error and print FAIL when starting the effect fails.
+ */
+ZTEST(ledStripCmd, test_execEffectFill_startFails)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"fill", "10", "20", "30"};
+  int result;
+
+  ledStripStartEffect_fake.return_val = -EAGAIN;
+
+  result = execEffectFill(sh, 4, argv);
+
+  zassert_equal(result, -EAGAIN, "execEffectFill should return error from ledStripStartEffect");
+  zassert_equal(shell_error_call_count, 1, "shell_error should be called once");
+  zassert_true(strstr(captured_shell_output, "FAIL") == captured_shell_output,
+               "output should start with FAIL");
+}
+
+/**
+ * @test execEffectFill must start an opaque fill of the whole strip on success.
+ */
+ZTEST(ledStripCmd, test_execEffectFill_success)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"fill", "10", "20", "30"};
+  int result;
+
+  shell_strtoul_fake.custom_fake       = shell_strtoul_parse;
+  ledStripStartEffect_fake.custom_fake = ledStripStartEffect_capture;
+
+  result = execEffectFill(sh, 4, argv);
+
+  zassert_equal(result, 0, "execEffectFill should return 0");
+  zassert_equal(ledStripStartEffect_fake.arg0_val, SHELL_EFFECT_SLOT,
+                "ledStripStartEffect should be called with the shell slot");
+  zassert_equal(captured_effect.type, LED_STRIP_EFFECT_FILL, "The effect should be a fill");
+  zassert_equal(captured_effect.pixelCount, 0, "The effect should cover the whole strip");
+  zassert_equal(captured_effect.alpha, 255, "The effect should be opaque");
+  zassert_equal(captured_effect.colors[0].r, 10, "The red channel should be parsed");
+  zassert_equal(captured_effect.colors[0].g, 20, "The green channel should be parsed");
+  zassert_equal(captured_effect.colors[0].b, 30, "The blue channel should be parsed");
+  zassert_true(strstr(captured_shell_output, "SUCCESS") == captured_shell_output,
+               "output should start with SUCCESS");
+}
+
+/**
+ * @test execEffectGradient must start a still gradient without period argument.
+ */
+ZTEST(ledStripCmd, test_execEffectGradient_noPeriod)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"grad", "1", "2", "3", "4", "5", "6"};
+  int result;
+
+  shell_strtoul_fake.custom_fake       = shell_strtoul_parse;
+  ledStripStartEffect_fake.custom_fake = ledStripStartEffect_capture;
+
+  result = execEffectGradient(sh, 7, argv);
+
+  zassert_equal(result, 0, "execEffectGradient should return 0");
+  zassert_equal(captured_effect.type, LED_STRIP_EFFECT_GRADIENT, "The effect should be a gradient");
+  zassert_equal(captured_effect.colors[1].b, 6, "The second color should be parsed");
+  zassert_equal(captured_effect.period, 0, "The gradient should be still");
+}
+
+/**
+ * @test execEffectChase must start a chase with its length and period.
+ */
+ZTEST(ledStripCmd, test_execEffectChase_success)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"chase", "255", "0", "0", "2", "5"};
+  int result;
+
+  shell_strtoul_fake.custom_fake       = shell_strtoul_parse;
+  ledStripStartEffect_fake.custom_fake = ledStripStartEffect_capture;
+
+  result = execEffectChase(sh, 6, argv);
+
+  zassert_equal(result, 0, "execEffectChase should return 0");
+  zassert_equal(captured_effect.type, LED_STRIP_EFFECT_CHASE, "The effect should be a chase");
+  zassert_equal(captured_effect.length, 2, "The chase length should be parsed");
+  zassert_equal(captured_effect.period, 5, "The chase period should be parsed");
+}
+
+/**
+ * @test execEffectFade must start a fade with its period.
+ */
+ZTEST(ledStripCmd, test_execEffectFade_success)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"fade", "0", "0", "0", "60"};
+  int result;
+
+  shell_strtoul_fake.custom_fake       = shell_strtoul_parse;
+  ledStripStartEffect_fake.custom_fake = ledStripStartEffect_capture;
+
+  result = execEffectFade(sh, 5, argv);
+
+  zassert_equal(result, 0, "execEffectFade should return 0");
+  zassert_equal(captured_effect.type, LED_STRIP_EFFECT_FADE, "The effect should be a fade");
+  zassert_equal(captured_effect.period, 60, "The fade period should be parsed");
+}
+
+/**
+ * @test execEffectStop must return error and print FAIL when stopping the effect fails.
+ */
+ZTEST(ledStripCmd, test_execEffectStop_stopFails)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"stop"};
+  int result;
+
+  ledStripStopEffect_fake.return_val = -EAGAIN;
+
+  result = execEffectStop(sh, 1, argv);
+
+  zassert_equal(result, -EAGAIN, "execEffectStop should return error from ledStripStopEffect");
+  zassert_equal(shell_error_call_count, 1, "shell_error should be called once");
+}
+
+/**
+ * @test execEffectStop must stop the shell effect and print SUCCESS on success.
+ */
+ZTEST(ledStripCmd, test_execEffectStop_success)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"stop"};
+  int result;
+
+  result = execEffectStop(sh, 1, argv);
+
+  zassert_equal(result, 0, "execEffectStop should return 0");
+  zassert_equal(ledStripStopEffect_fake.arg0_val, SHELL_EFFECT_SLOT,
+                "ledStripStopEffect should be called with the shell slot");
+  zassert_true(strstr(captured_shell_output, "SUCCESS") == captured_shell_output,
+               "output should start with SUCCESS");
+}
+
+/**
+ * @test execStats must return error and print FAIL when getting the statistics fails.
+ */
+ZTEST(ledStripCmd, test_execStats_getStatsFails)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"stats"};
+  int result;
+
+  ledStripGetStats_fake.return_val = -ENOTSUP;
+
+  result = execStats(sh, 1, argv);
+
+  zassert_equal(result, -ENOTSUP, "execStats should return error from ledStripGetStats");
+  zassert_equal(shell_error_call_count, 1, "shell_error should be called once");
+}
+
+/**
+ * @test execStats must print the frame statistics on success.
+ */
+ZTEST(ledStripCmd, test_execStats_success)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *argv[]           = {"stats"};
+  int result;
+
+  result = execStats(sh, 1, argv);
+
+  zassert_equal(result, 0, "execStats should return 0");
+  zassert_equal(ledStripGetStats_fake.call_count, 1, "ledStripGetStats should be called once");
+  zassert_equal(shell_print_call_count, 3, "The statistics should be printed");
+}
+
+/**
+ * @test execStats must reset the statistics and reject an unknown option.
+ */
+ZTEST(ledStripCmd, test_execStats_reset)
+{
+  const struct shell *sh = (const struct shell *)0x1234;
+  char *resetArgv[]      = {"stats", "reset"};
+  char *invalidArgv[]    = {"stats", "clear"};
+
+  zassert_equal(execStats(sh, 2, invalidArgv), -EINVAL, "An unknown option should return -EINVAL");
+  zassert_equal(ledStripResetStats_fake.call_count, 0, "The statistics should not be reset");
+
+  zassert_equal(execStats(sh, 2, resetArgv), 0, "execStats should return 0");
+  zassert_equal(ledStripResetStats_fake.call_count, 1, "The statistics should be reset");
+  zassert_true(strstr(captured_shell_output, "SUCCESS") == captured_shell_output,
+               "output should start with SUCCESS");
+}
+
 ZTEST_SUITE(ledStripCmd, NULL, cmd_tests_setup, cmd_tests_before, NULL, NULL);
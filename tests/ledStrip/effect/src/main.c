@@ -0,0 +1,279 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     LED Strip Effect Tests
+ *
+ *            Unit tests for the LED strip effect engine.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Prevent LED strip driver header - we'll define types manually */
+#define ZEPHYR_INCLUDE_DRIVERS_LED_STRIP_H_
+
+/* Prevent ledStripUtil header - only its logger name is needed */
+#define LEDSTRIPUTIL_H
+#define LED_STRIP_LOGGER_NAME ledStrip
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_LED_STRIP 1
+#define CONFIG_ENYA_LED_STRIP_LOG_LEVEL 3
+#define CONFIG_ENYA_LED_STRIP_EFFECTS 1
+#define CONFIG_ENYA_LED_STRIP_EFFECT_SLOT_COUNT 2
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ledStrip, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Mock LED strip pixel type */
+struct led_rgb { uint8_t r; uint8_t g; uint8_t b; };
+
+/* Override device tree macros */
+#undef DT_ALIAS
+#define DT_ALIAS(name) DT_N_NODELABEL_ws2812
+
+/* Mock DT node properties for ws2812 */
+#define DT_N_NODELABEL_ws2812_P_chain_length 8
+
+#include "ledStripEffect.c"
+
+#define TEST_PIXEL_COUNT DT_N_NODELABEL_ws2812_P_chain_length
+
+static const struct led_rgb red   = {.r = 255};
+static const struct led_rgb blue  = {.b = 255};
+static const struct led_rgb black = {0};
+
+/**
+ * @brief Fill a test frame with a single color.
+ */
+static void fillFrame(struct led_rgb *frame, struct led_rgb color)
+{
+  for(size_t i = 0; i < TEST_PIXEL_COUNT; ++i)
+    frame[i] = color;
+}
+
+/**
+ * @brief Start a validated effect.
+ */
+static void startEffect(size_t slot, const LedStripEffect_t *effect)
+{
+  zassert_equal(ledStripEffectValidate(slot, effect), 0, "The effect should be valid");
+  ledStripEffectStart(slot, effect);
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void effect_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  memset(slots, 0, sizeof(slots));
+  isChanged = false;
+}
+
+/**
+ * @test ledStripEffectValidate must reject the invalid effects.
+ */
+ZTEST(ledStripEffect, test_validate_invalid)
+{
+  LedStripEffect_t valid       = {.type = LED_STRIP_EFFECT_FILL};
+  LedStripEffect_t badType     = {.type = LED_STRIP_EFFECT_TYPE_COUNT};
+  LedStripEffect_t badFirst    = {.type = LED_STRIP_EFFECT_FILL, .firstPixel = TEST_PIXEL_COUNT};
+  LedStripEffect_t badSegment  = {.type = LED_STRIP_EFFECT_FILL, .firstPixel = 4, .pixelCount = 5};
+  LedStripEffect_t noPeriod    = {.type = LED_STRIP_EFFECT_CHASE, .length = 1};
+  LedStripEffect_t longChase   = {.type = LED_STRIP_EFFECT_CHASE, .firstPixel = 4, .length = 5, .period = 1};
+  LedStripEffect_t instantFade = {.type = LED_STRIP_EFFECT_FADE};
+
+  zassert_equal(ledStripEffectValidate(0, NULL), -EINVAL, "NULL effect should return -EINVAL");
+  zassert_equal(ledStripEffectValidate(CONFIG_ENYA_LED_STRIP_EFFECT_SLOT_COUNT, &valid), -EINVAL,
+                "Invalid slot should return -EINVAL");
+  zassert_equal(ledStripEffectValidate(0, &badType), -EINVAL, "Invalid type should return -EINVAL");
+  zassert_equal(ledStripEffectValidate(0, &badFirst), -EINVAL,
+                "Out of chain first pixel should return -EINVAL");
+  zassert_equal(ledStripEffectValidate(0, &badSegment), -EINVAL,
+                "Out of chain segment should return -EINVAL");
+  zassert_equal(ledStripEffectValidate(0, &noPeriod), -EINVAL,
+                "Chase without period should return -EINVAL");
+  zassert_equal(ledStripEffectValidate(0, &longChase), -EINVAL,
+                "Chase longer than its segment should return -EINVAL");
+  zassert_equal(ledStripEffectValidate(0, &instantFade), -EINVAL,
+                "Fade without period should return -EINVAL");
+  zassert_equal(ledStripEffectValidate(1, &valid), 0, "Valid effect should return 0");
+}
+
+/**
+ * @test A fill must only cover its segment and change the output once.
+ */
+ZTEST(ledStripEffect, test_fill_segment)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_FILL, .firstPixel = 2, .pixelCount = 3,
+                             .alpha = 255, .colors = {red}};
+
+  fillFrame(frame, blue);
+  startEffect(0, &effect);
+
+  zassert_true(slots[0].isRunning, "The effect should be running");
+  zassert_true(ledStripEffectAdvance(), "A started effect should change the output");
+  zassert_false(ledStripEffectAdvance(), "A fill should not change the output again");
+
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+
+  for(size_t i = 0; i < TEST_PIXEL_COUNT; ++i)
+  {
+    struct led_rgb expected = i >= 2 && i < 5 ? red : blue;
+
+    zassert_mem_equal(frame + i, &expected, sizeof(expected), "Pixel %d should be %s", i,
+                      i >= 2 && i < 5 ? "filled" : "untouched");
+  }
+}
+
+/**
+ * @test An effect must be blended over the frame by its alpha.
+ */
+ZTEST(ledStripEffect, test_alpha_blending)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_FILL, .alpha = 51, .colors = {red}};
+
+  fillFrame(frame, blue);
+  startEffect(0, &effect);
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+
+  zassert_equal(frame[0].r, 51, "Red should be blended at alpha");
+  zassert_equal(frame[0].b, 204, "Blue should be blended at 255 - alpha");
+  zassert_equal(frame[TEST_PIXEL_COUNT - 1].r, 51, "The whole chain should be blended");
+}
+
+/**
+ * @test A gradient must span its colors over the segment and shift every period.
+ */
+ZTEST(ledStripEffect, test_gradient_shift)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_GRADIENT, .alpha = 255, .colors = {black, red},
+                             .period = 2};
+
+  startEffect(0, &effect);
+  zassert_true(ledStripEffectAdvance(), "A started effect should change the output");
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+
+  zassert_equal(frame[0].r, 0, "The first pixel should be the first color");
+  zassert_equal(frame[3].r, 3 * 255 / 7, "The gradient should be linear");
+  zassert_equal(frame[TEST_PIXEL_COUNT - 1].r, 255, "The last pixel should be the second color");
+
+  zassert_false(ledStripEffectAdvance(), "The gradient should not shift before its period");
+  zassert_true(ledStripEffectAdvance(), "The gradient should shift at its period");
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+
+  zassert_equal(frame[0].r, 255 / 7, "The gradient should be shifted by one pixel");
+  zassert_equal(frame[TEST_PIXEL_COUNT - 1].r, 255, "The gradient should come back seamlessly");
+}
+
+/**
+ * @test A chase must move one pixel every period and wrap around its segment.
+ */
+ZTEST(ledStripEffect, test_chase_steps)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_CHASE, .alpha = 255, .colors = {red, blue},
+                             .length = 2, .period = 1};
+
+  startEffect(0, &effect);
+  ledStripEffectAdvance();
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+
+  zassert_equal(frame[0].r, 255, "The chase should start lit at the first pixel");
+  zassert_equal(frame[1].r, 255, "The chase should be lit over its length");
+  zassert_equal(frame[2].b, 255, "The pixels past the chase should be the background");
+
+  for(size_t i = 0; i < TEST_PIXEL_COUNT - 1; ++i)
+    zassert_true(ledStripEffectAdvance(), "The chase should step every period");
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+
+  zassert_equal(frame[TEST_PIXEL_COUNT - 1].r, 255, "The chase should be at the last pixel");
+  zassert_equal(frame[0].r, 255, "The chase should wrap around the segment");
+  zassert_equal(frame[1].b, 255, "The chase tail should be past the wrap");
+}
+
+/**
+ * @test A fade must crossfade from the frame to its color over its period, then hold.
+ */
+ZTEST(ledStripEffect, test_fade_holds)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_FADE, .alpha = 255, .colors = {red}, .period = 4};
+
+  startEffect(0, &effect);
+  ledStripEffectAdvance();
+  ledStripEffectAdvance();
+  ledStripEffectAdvance();
+
+  fillFrame(frame, blue);
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+  zassert_equal(frame[0].r, 127, "The fade should be halfway");
+  zassert_equal(frame[0].b, 128, "The frame should be half faded out");
+
+  ledStripEffectAdvance();
+  ledStripEffectAdvance();
+  zassert_false(ledStripEffectAdvance(), "A finished fade should not change the output");
+
+  fillFrame(frame, blue);
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+  zassert_mem_equal(frame, &red, sizeof(red), "A finished fade should hold its color");
+}
+
+/**
+ * @test A stopped effect must restore the frame at the next refresh.
+ */
+ZTEST(ledStripEffect, test_stop)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_FILL, .alpha = 255, .colors = {red}};
+
+  startEffect(0, &effect);
+  ledStripEffectAdvance();
+
+  ledStripEffectStop(CONFIG_ENYA_LED_STRIP_EFFECT_SLOT_COUNT);
+  zassert_false(ledStripEffectAdvance(), "An invalid slot stop should be ignored");
+
+  ledStripEffectStop(0);
+  zassert_false(slots[0].isRunning, "The effect should not be running");
+  zassert_true(ledStripEffectAdvance(), "A stop should change the output");
+  zassert_false(ledStripEffectAdvance(), "A stop should change the output once");
+
+  fillFrame(frame, blue);
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+  zassert_mem_equal(frame, &blue, sizeof(blue), "The frame should be untouched");
+}
+
+/**
+ * @test The slots must be rendered in order, the upper one blending over the lower one.
+ */
+ZTEST(ledStripEffect, test_slot_order)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  LedStripEffect_t lower = {.type = LED_STRIP_EFFECT_FILL, .alpha = 255, .colors = {red}};
+  LedStripEffect_t upper = {.type = LED_STRIP_EFFECT_FILL, .firstPixel = 4, .alpha = 255, .colors = {blue}};
+
+  startEffect(1, &upper);
+  startEffect(0, &lower);
+
+  fillFrame(frame, black);
+  ledStripEffectRender(frame, TEST_PIXEL_COUNT);
+
+  zassert_mem_equal(frame + 3, &red, sizeof(red), "The lower slot should be shown out of the upper one");
+  zassert_mem_equal(frame + 4, &blue, sizeof(blue), "The upper slot should be shown over the lower one");
+}
+
+ZTEST_SUITE(ledStripEffect, NULL, NULL, effect_tests_before, NULL, NULL);
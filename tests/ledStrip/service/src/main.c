@@ -67,15 +67,22 @@ typedef struct
   k_tid_t threadId;
   ServicePriority_t priority;
   uint32_t heartbeatIntervalMs;
-  int64_t lastHeartbeatMs;
+  atomic_t lastHeartbeatMs;
   uint8_t missedHeartbeats;
   ServiceState_t state;
+  uint8_t maxRestarts;
   int (*start)(void);
   int (*stop)(void);
   int (*suspend)(void);
   int (*resume)(void);
+  int (*restart)(void);
 } ServiceDescriptor_t;
 
+/* Provide ServiceHandle_t definition */
+typedef size_t ServiceHandle_t;
+
+#define TEST_SERVICE_HANDLE 3
+
 /* Wrap kernel functions to use mocks */
 #define k_thread_create         k_thread_create_mock
 #define k_thread_name_set       k_thread_name_set_mock
@@ -87,7 +94,12 @@ typedef struct
 #define k_msgq_put              k_msgq_put_mock
 #define k_msgq_get              k_msgq_get_mock
 #define k_timer_status_sync     k_timer_status_sync_mock
+#define k_timer_start           k_timer_start_mock
 #define k_timer_stop            k_timer_stop_mock
+#define k_uptime_ticks          k_uptime_ticks_mock
+#define k_cycle_get_32          k_cycle_get_32_mock
+#define k_sem_take              k_sem_take_mock
+#define k_sem_give              k_sem_give_mock
 
 /* Mock Kconfig options */
 #define CONFIG_ENYA_LED_STRIP                        1
@@ -96,8 +108,10 @@ typedef struct
 #define CONFIG_ENYA_LED_STRIP_THREAD_PRIORITY        5
 #define CONFIG_ENYA_LED_STRIP_SERVICE_PRIORITY       2
 #define CONFIG_ENYA_LED_STRIP_HEARTBEAT_INTERVAL_MS  1000
+#define CONFIG_ENYA_LED_STRIP_MAX_RESTARTS           3
 #define CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ        60
 #define CONFIG_ENYA_LED_STRIP_MSG_COUNT              4
+#define CONFIG_ENYA_LED_STRIP_STATS                  1
 
 /* Define test mode iteration count */
 #define LED_STRIP_RUN_ITERATIONS 2
@@ -117,20 +131,28 @@ FAKE_VALUE_FUNC(k_tid_t, k_current_get_mock);
 FAKE_VALUE_FUNC(int, k_msgq_put_mock, struct k_msgq *, const void *, k_timeout_t);
 FAKE_VALUE_FUNC(int, k_msgq_get_mock, struct k_msgq *, void *, k_timeout_t);
 FAKE_VALUE_FUNC(uint32_t, k_timer_status_sync_mock, struct k_timer *);
+FAKE_VOID_FUNC(k_timer_start_mock, struct k_timer *, k_timeout_t, k_timeout_t);
 FAKE_VOID_FUNC(k_timer_stop_mock, struct k_timer *);
+FAKE_VALUE_FUNC(int64_t, k_uptime_ticks_mock);
+FAKE_VALUE_FUNC(uint32_t, k_cycle_get_32_mock);
+FAKE_VALUE_FUNC(int, k_sem_take_mock, struct k_sem *, k_timeout_t);
+FAKE_VOID_FUNC(k_sem_give_mock, struct k_sem *);
 
 /* Mock serviceManager functions */
-FAKE_VALUE_FUNC(int, serviceManagerConfirmState, k_tid_t, ServiceState_t);
-FAKE_VALUE_FUNC(int, serviceManagerUpdateHeartbeat, k_tid_t);
-FAKE_VALUE_FUNC(int, serviceManagerRegisterSrv, const ServiceDescriptor_t *);
+FAKE_VALUE_FUNC(int, serviceManagerConfirmState, ServiceHandle_t, ServiceState_t);
+FAKE_VALUE_FUNC(int, serviceManagerUpdateHeartbeat, ServiceHandle_t);
+FAKE_VALUE_FUNC(int, serviceManagerRegisterSrv, const ServiceDescriptor_t *, ServiceHandle_t *);
 
 /* Mock ledStripUtil functions */
 FAKE_VALUE_FUNC(int, ledStripUtilInitStrip);
 FAKE_VALUE_FUNC(int, ledStripUtilInitFramebuffers);
-FAKE_VALUE_FUNC(struct led_rgb *, ledStripUtilGetNextFramebuffer);
-FAKE_VOID_FUNC(ledStripUtilSetBrightness, uint8_t);
-FAKE_VOID_FUNC(ledStripUtilActivateFrame, struct led_rgb *);
+FAKE_VALUE_FUNC(size_t, ledStripUtilGetStripCount);
+FAKE_VALUE_FUNC(size_t, ledStripUtilGetPixelCount, size_t);
+FAKE_VALUE_FUNC(struct led_rgb *, ledStripUtilGetNextFramebuffer, size_t);
+FAKE_VOID_FUNC(ledStripUtilSetBrightness, size_t, uint8_t);
+FAKE_VOID_FUNC(ledStripUtilActivateFrame, size_t, struct led_rgb *);
 FAKE_VALUE_FUNC(int, ledStripUtilPushFrame);
+FAKE_VOID_FUNC(ledStripUtilSetFrameFreeCallback, LedStripFrameFreeCallback_t);
 
 #define FFF_FAKES_LIST(FAKE) \
   FAKE(k_thread_create_mock) \
@@ -143,16 +165,24 @@ FAKE_VALUE_FUNC(int, ledStripUtilPushFrame);
   FAKE(k_msgq_put_mock) \
   FAKE(k_msgq_get_mock) \
   FAKE(k_timer_status_sync_mock) \
+  FAKE(k_timer_start_mock) \
   FAKE(k_timer_stop_mock) \
+  FAKE(k_uptime_ticks_mock) \
+  FAKE(k_cycle_get_32_mock) \
+  FAKE(k_sem_take_mock) \
+  FAKE(k_sem_give_mock) \
   FAKE(serviceManagerConfirmState) \
   FAKE(serviceManagerUpdateHeartbeat) \
   FAKE(serviceManagerRegisterSrv) \
   FAKE(ledStripUtilInitStrip) \
   FAKE(ledStripUtilInitFramebuffers) \
+  FAKE(ledStripUtilGetStripCount) \
+  FAKE(ledStripUtilGetPixelCount) \
   FAKE(ledStripUtilGetNextFramebuffer) \
   FAKE(ledStripUtilSetBrightness) \
   FAKE(ledStripUtilActivateFrame) \
-  FAKE(ledStripUtilPushFrame)
+  FAKE(ledStripUtilPushFrame) \
+  FAKE(ledStripUtilSetFrameFreeCallback)
 
 /* Setup logging */
 #include <zephyr/logging/log.h>
@@ -189,8 +219,10 @@ static int k_msgq_put_capture(struct k_msgq *q, const void *data, k_timeout_t ti
 }
 
 /* Descriptor capture helper for serviceManagerRegisterSrv */
-static int serviceManagerRegisterSrv_capture(const ServiceDescriptor_t *descriptor)
+static int serviceManagerRegisterSrv_capture(const ServiceDescriptor_t *descriptor, ServiceHandle_t *handle)
 {
+  if(handle)
+    *handle = TEST_SERVICE_HANDLE;
   if(descriptor)
     current_fixture->captured_descriptor = *descriptor;
   return serviceManagerRegisterSrv_fake.return_val;
@@ -237,10 +269,13 @@ static void service_tests_before(void *f)
   FFF_RESET_HISTORY();
 
   memset(current_fixture, 0, sizeof(*current_fixture));
+  ledStripResetStats();
 
   k_msgq_put_mock_fake.custom_fake = k_msgq_put_capture;
   serviceManagerRegisterSrv_fake.custom_fake = serviceManagerRegisterSrv_capture;
+  serviceHandle = TEST_SERVICE_HANDLE;
   k_msgq_get_mock_fake.custom_fake = k_msgq_get_no_message;
+  ledStripUtilGetStripCount_fake.return_val = 2;
 }
 
 /**
@@ -327,6 +362,23 @@ ZTEST_F(ledStrip, test_run_unsupportedMsgType)
                 "serviceManagerUpdateHeartbeat should still be called for each iteration");
 }
 
+/**
+ * @test The run function must hold the push semaphore while pushing each frame.
+ */
+ZTEST_F(ledStrip, test_run_holdsPushSem)
+{
+  run(NULL, NULL, NULL);
+
+  zassert_equal(k_sem_take_mock_fake.call_count, LED_STRIP_RUN_ITERATIONS,
+                "k_sem_take should be called for each push");
+  zassert_equal(k_sem_take_mock_fake.arg0_val, &pushSem,
+                "k_sem_take should be called with the push semaphore");
+  zassert_equal(k_sem_give_mock_fake.call_count, LED_STRIP_RUN_ITERATIONS,
+                "k_sem_give should be called after each push");
+  zassert_equal(k_sem_give_mock_fake.arg0_val, &pushSem,
+                "k_sem_give should be called with the push semaphore");
+}
+
 /**
  * @test The run function must log error but continue when pushing the frame fails.
  */
@@ -371,8 +423,8 @@ ZTEST_F(ledStrip, test_run_successNoMessage)
 
   zassert_equal(serviceManagerConfirmState_fake.call_count, 1,
                 "serviceManagerConfirmState should be called once at startup");
-  zassert_equal(serviceManagerConfirmState_fake.arg0_val, mockTid,
-                "serviceManagerConfirmState should be called with current thread ID");
+  zassert_equal(serviceManagerConfirmState_fake.arg0_val, TEST_SERVICE_HANDLE,
+                "serviceManagerConfirmState should be called with the service handle");
   zassert_equal(serviceManagerConfirmState_fake.arg1_val, SVC_STATE_RUNNING,
                 "serviceManagerConfirmState should be called with SVC_STATE_RUNNING");
   zassert_equal(k_timer_status_sync_mock_fake.call_count, LED_STRIP_RUN_ITERATIONS,
@@ -391,8 +443,8 @@ ZTEST_F(ledStrip, test_run_successNoMessage)
                 "ledStripUtilPushFrame should be called for each iteration");
   zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, LED_STRIP_RUN_ITERATIONS,
                 "serviceManagerUpdateHeartbeat should be called for each iteration");
-  zassert_equal(serviceManagerUpdateHeartbeat_fake.arg0_val, mockTid,
-                "serviceManagerUpdateHeartbeat should be called with current thread ID");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.arg0_val, TEST_SERVICE_HANDLE,
+                "serviceManagerUpdateHeartbeat should be called with the service handle");
 }
 
 /**
@@ -405,6 +457,7 @@ ZTEST_F(ledStrip, test_run_successNewFrame)
   k_tid_t mockTid = (k_tid_t)0x1234;
 
   fixture->test_queue_messages[0].type = LED_STRIP_NEW_FRAME_MSG;
+  fixture->test_queue_messages[0].strip = 1;
   fixture->test_queue_messages[0].framebuffer = &mockFrame;
   fixture->test_queue_msg_count = 1;
   k_msgq_get_mock_fake.custom_fake = k_msgq_get_from_run_queue;
@@ -414,7 +467,9 @@ ZTEST_F(ledStrip, test_run_successNewFrame)
 
   zassert_equal(ledStripUtilActivateFrame_fake.call_count, 1,
                 "ledStripUtilActivateFrame should be called once for the new frame message");
-  zassert_equal(ledStripUtilActivateFrame_fake.arg0_val, &mockFrame,
+  zassert_equal(ledStripUtilActivateFrame_fake.arg0_val, 1,
+                "ledStripUtilActivateFrame should be called with the strip from the message");
+  zassert_equal(ledStripUtilActivateFrame_fake.arg1_val, &mockFrame,
                 "ledStripUtilActivateFrame should be called with the frame from the message");
   zassert_equal(k_thread_abort_mock_fake.call_count, 0,
                 "k_thread_abort should not be called on a new frame message");
@@ -447,8 +502,8 @@ ZTEST_F(ledStrip, test_run_successStop)
                 "k_timer_stop should be called once on STOP");
   zassert_equal(serviceManagerConfirmState_fake.arg1_history[1], SVC_STATE_STOPPED,
                 "confirmState should be called with SVC_STATE_STOPPED");
-  zassert_equal(serviceManagerConfirmState_fake.arg0_history[1], mockTid,
-                "confirmState should be called with the current thread ID");
+  zassert_equal(serviceManagerConfirmState_fake.arg0_history[1], TEST_SERVICE_HANDLE,
+                "confirmState should be called with the service handle");
   zassert_equal(k_thread_suspend_mock_fake.call_count, 0,
                 "k_thread_suspend should not be called on a STOP message");
   zassert_equal(k_thread_abort_mock_fake.call_count, 1,
@@ -478,8 +533,8 @@ ZTEST_F(ledStrip, test_run_successSuspend)
                 "k_timer_stop should be called once on SUSPEND");
   zassert_equal(serviceManagerConfirmState_fake.arg1_history[1], SVC_STATE_SUSPENDED,
                 "confirmState should be called with SVC_STATE_SUSPENDED");
-  zassert_equal(serviceManagerConfirmState_fake.arg0_history[1], mockTid,
-                "confirmState should be called with the current thread ID");
+  zassert_equal(serviceManagerConfirmState_fake.arg0_history[1], TEST_SERVICE_HANDLE,
+                "confirmState should be called with the service handle");
   zassert_equal(k_thread_abort_mock_fake.call_count, 0,
                 "k_thread_abort should not be called on a SUSPEND message");
   zassert_equal(k_thread_suspend_mock_fake.call_count, 1,
@@ -494,6 +549,7 @@ ZTEST_F(ledStrip, test_run_successSuspend)
 ZTEST_F(ledStrip, test_run_successBrightness)
 {
   fixture->test_queue_messages[0].type       = LED_STRIP_BRIGHTNESS_MSG;
+  fixture->test_queue_messages[0].strip      = 1;
   fixture->test_queue_messages[0].brightness = 128;
   fixture->test_queue_msg_count              = 1;
   k_msgq_get_mock_fake.custom_fake           = k_msgq_get_from_run_queue;
@@ -502,7 +558,9 @@ ZTEST_F(ledStrip, test_run_successBrightness)
 
   zassert_equal(ledStripUtilSetBrightness_fake.call_count, 1,
                 "ledStripUtilSetBrightness should be called once for the brightness message");
-  zassert_equal(ledStripUtilSetBrightness_fake.arg0_val, 128,
+  zassert_equal(ledStripUtilSetBrightness_fake.arg0_val, 1,
+                "ledStripUtilSetBrightness should be called with the strip from the message");
+  zassert_equal(ledStripUtilSetBrightness_fake.arg1_val, 128,
                 "ledStripUtilSetBrightness should be called with the brightness from the message");
   zassert_equal(ledStripUtilActivateFrame_fake.call_count, 0,
                 "ledStripUtilActivateFrame should not be called on a brightness message");
@@ -614,6 +672,86 @@ ZTEST_F(ledStrip, test_onResume_success)
                 "k_thread_resume should be called with the service thread");
 }
 
+/**
+ * @test The onRestart callback must abort the service thread between two pushes, stop the frame
+ *       timer, then re-create and start the thread.
+ */
+ZTEST_F(ledStrip, test_onRestart_success)
+{
+  int result;
+
+  k_thread_create_mock_fake.return_val = (k_tid_t)&thread;
+
+  result = onRestart();
+
+  zassert_equal(result, 0, "onRestart should return 0");
+  zassert_equal(k_sem_take_mock_fake.call_count, 1,
+                "k_sem_take should be called once, waiting on the push in progress");
+  zassert_equal(k_sem_take_mock_fake.arg0_val, &pushSem,
+                "k_sem_take should be called with the push semaphore");
+  zassert_equal(k_sem_take_mock_fake.arg1_val.ticks, K_TICKS(FRAME_PERIOD_TICKS).ticks,
+                "the push in progress should be waited on up to a frame period");
+  zassert_equal(k_sem_give_mock_fake.call_count, 1,
+                "k_sem_give should be called once, for the new thread");
+  zassert_equal(k_timer_stop_mock_fake.call_count, 1,
+                "k_timer_stop should be called once");
+  zassert_equal(k_timer_stop_mock_fake.arg0_val, &frameTimer,
+                "k_timer_stop should be called with the frame timer");
+  zassert_equal(k_thread_abort_mock_fake.call_count, 1,
+                "k_thread_abort should be called once");
+  zassert_equal(k_thread_abort_mock_fake.arg0_val, &thread,
+                "k_thread_abort should be called with the service thread");
+  zassert_equal(k_thread_create_mock_fake.call_count, 1,
+                "k_thread_create should be called once");
+  zassert_equal(k_thread_create_mock_fake.arg0_val, &thread,
+                "k_thread_create should be called with the service thread");
+  zassert_equal(k_thread_name_set_mock_fake.call_count, 1,
+                "k_thread_name_set should be called once, the name being cleared by k_thread_create");
+  zassert_equal(k_thread_start_mock_fake.call_count, 1,
+                "k_thread_start should be called once");
+  zassert_equal(k_thread_start_mock_fake.arg0_val, &thread,
+                "k_thread_start should be called with the service thread");
+}
+
+/**
+ * @test The onRestart callback must return error when setting the thread name fails.
+ */
+ZTEST_F(ledStrip, test_onRestart_threadNameSetFails)
+{
+  int result;
+
+  k_thread_name_set_mock_fake.return_val = -EIO;
+
+  result = onRestart();
+
+  zassert_equal(result, -EIO, "onRestart should return error from k_thread_name_set");
+  zassert_equal(k_thread_start_mock_fake.call_count, 0,
+                "k_thread_start should not be called when setting thread name fails");
+  zassert_equal(k_sem_give_mock_fake.call_count, 1,
+                "k_sem_give should still be called when setting thread name fails");
+}
+
+/**
+ * @test The onRestart callback must return error without aborting the thread when its push does
+ *       not complete within a frame period.
+ */
+ZTEST_F(ledStrip, test_onRestart_pushStuck)
+{
+  int result;
+
+  k_sem_take_mock_fake.return_val = -EAGAIN;
+
+  result = onRestart();
+
+  zassert_equal(result, -EAGAIN, "onRestart should return error from k_sem_take");
+  zassert_equal(k_thread_abort_mock_fake.call_count, 0,
+                "k_thread_abort should not be called during a push");
+  zassert_equal(k_thread_create_mock_fake.call_count, 0,
+                "k_thread_create should not be called during a push");
+  zassert_equal(k_sem_give_mock_fake.call_count, 0,
+                "k_sem_give should not be called without the push semaphore");
+}
+
 /**
  * @test The init function must return error when initializing the strip fails.
  */
@@ -703,7 +841,7 @@ ZTEST_F(ledStrip, test_ledStripInit_registerSrvFails)
 ZTEST_F(ledStrip, test_ledStripInit_success)
 {
   int result;
-  k_tid_t mockTid = (k_tid_t)0x1234;
+  k_tid_t mockTid = (k_tid_t)&thread;
 
   k_thread_create_mock_fake.return_val = mockTid;
 
@@ -741,6 +879,10 @@ ZTEST_F(ledStrip, test_ledStripInit_success)
                 "descriptor suspend callback should be onSuspend");
   zassert_equal(fixture->captured_descriptor.resume, onResume,
                 "descriptor resume callback should be onResume");
+  zassert_equal(fixture->captured_descriptor.restart, onRestart,
+                "descriptor restart callback should be onRestart");
+  zassert_equal(fixture->captured_descriptor.maxRestarts, CONFIG_ENYA_LED_STRIP_MAX_RESTARTS,
+                "descriptor maxRestarts should match Kconfig");
 }
 
 /**
@@ -775,6 +917,23 @@ ZTEST_F(ledStrip, test_ledStripGetNextFramebuffer_success)
                 "ledStripGetNextFramebuffer should return the block from the pool");
   zassert_equal(ledStripUtilGetNextFramebuffer_fake.call_count, 1,
                 "ledStripUtilGetNextFramebuffer should be called once");
+  zassert_equal(ledStripUtilGetNextFramebuffer_fake.arg0_val, 0,
+                "ledStripUtilGetNextFramebuffer should be called for the primary strip");
+}
+
+/**
+ * @test ledStripGetStripFramebuffer must return the block from the strip pool.
+ */
+ZTEST_F(ledStrip, test_ledStripGetStripFramebuffer_success)
+{
+  struct led_rgb mockBlock;
+
+  ledStripUtilGetNextFramebuffer_fake.return_val = &mockBlock;
+
+  zassert_equal(ledStripGetStripFramebuffer(1), &mockBlock,
+                "ledStripGetStripFramebuffer should return the block from the pool");
+  zassert_equal(ledStripUtilGetNextFramebuffer_fake.arg0_val, 1,
+                "ledStripUtilGetNextFramebuffer should be called for the strip");
 }
 
 /**
@@ -810,6 +969,35 @@ ZTEST_F(ledStrip, test_ledStripUpdateFrame_success)
                 "k_msgq_put should be called once");
   zassert_equal(fixture->captured_msg.type, LED_STRIP_NEW_FRAME_MSG,
                 "k_msgq_put should be called with a NEW_FRAME message");
+  zassert_equal(fixture->captured_msg.strip, 0,
+                "k_msgq_put should be called with the primary strip");
+  zassert_equal(fixture->captured_msg.framebuffer, &mockFrame,
+                "k_msgq_put should be called with the correct frame pointer");
+}
+
+/**
+ * @test ledStripUpdateStripFrame must reject an out of range strip.
+ */
+ZTEST_F(ledStrip, test_ledStripUpdateStripFrame_invalidStrip)
+{
+  struct led_rgb mockFrame;
+
+  zassert_equal(ledStripUpdateStripFrame(2, &mockFrame), -EINVAL,
+                "ledStripUpdateStripFrame should return -EINVAL for an out of range strip");
+  zassert_equal(k_msgq_put_mock_fake.call_count, 0, "No message should be queued");
+}
+
+/**
+ * @test ledStripUpdateStripFrame must enqueue a new frame message for the strip.
+ */
+ZTEST_F(ledStrip, test_ledStripUpdateStripFrame_success)
+{
+  struct led_rgb mockFrame;
+
+  zassert_equal(ledStripUpdateStripFrame(1, &mockFrame), 0, "ledStripUpdateStripFrame should return 0");
+  zassert_equal(fixture->captured_msg.type, LED_STRIP_NEW_FRAME_MSG,
+                "k_msgq_put should be called with a NEW_FRAME message");
+  zassert_equal(fixture->captured_msg.strip, 1, "k_msgq_put should be called with the strip");
   zassert_equal(fixture->captured_msg.framebuffer, &mockFrame,
                 "k_msgq_put should be called with the correct frame pointer");
 }
@@ -849,4 +1037,142 @@ ZTEST_F(ledStrip, test_ledStripSetBrightness_success)
                 "k_msgq_put should be called with the correct brightness value");
 }
 
+/**
+ * @test ledStripSetStripBrightness must reject an out of range strip and enqueue the
+ *       brightness message of the strip otherwise.
+ */
+ZTEST_F(ledStrip, test_ledStripSetStripBrightness)
+{
+  zassert_equal(ledStripSetStripBrightness(2, 128), -EINVAL,
+                "ledStripSetStripBrightness should return -EINVAL for an out of range strip");
+  zassert_equal(k_msgq_put_mock_fake.call_count, 0, "No message should be queued");
+
+  zassert_equal(ledStripSetStripBrightness(1, 64), 0, "ledStripSetStripBrightness should return 0");
+  zassert_equal(fixture->captured_msg.type, LED_STRIP_BRIGHTNESS_MSG,
+                "k_msgq_put should be called with a BRIGHTNESS message");
+  zassert_equal(fixture->captured_msg.strip, 1, "k_msgq_put should be called with the strip");
+  zassert_equal(fixture->captured_msg.brightness, 64,
+                "k_msgq_put should be called with the correct brightness value");
+}
+
+/**
+ * @test The effect functions must return -ENOTSUP without the effect engine.
+ */
+ZTEST_F(ledStrip, test_effect_notSupported)
+{
+  LedStripEffect_t effect = {.type = LED_STRIP_EFFECT_FILL};
+
+  zassert_equal(ledStripStartEffect(0, &effect), -ENOTSUP,
+                "ledStripStartEffect should return -ENOTSUP");
+  zassert_equal(ledStripStopEffect(0), -ENOTSUP, "ledStripStopEffect should return -ENOTSUP");
+  zassert_equal(k_msgq_put_mock_fake.call_count, 0, "No message should be queued");
+}
+
+/**
+ * @test The zone functions must return -ENOTSUP without the zones.
+ */
+ZTEST_F(ledStrip, test_zone_notSupported)
+{
+  struct led_rgb pixels[2] = {0};
+  size_t zoneId;
+
+  zassert_equal(ledStripRegisterZone(0, 2, &zoneId), -ENOTSUP,
+                "ledStripRegisterZone should return -ENOTSUP");
+  zassert_equal(ledStripUnregisterZone(0), -ENOTSUP, "ledStripUnregisterZone should return -ENOTSUP");
+  zassert_equal(ledStripUpdateZone(0, 0, pixels, 2), -ENOTSUP,
+                "ledStripUpdateZone should return -ENOTSUP");
+}
+
+/* Framebuffer release callback for the callback test */
+static void frameFreeCallback(void)
+{
+}
+
+/**
+ * @test ledStripSetFrameFreeCallback must set the framebuffer release callback.
+ */
+ZTEST_F(ledStrip, test_ledStripSetFrameFreeCallback_success)
+{
+  ledStripSetFrameFreeCallback(frameFreeCallback);
+
+  zassert_equal(ledStripUtilSetFrameFreeCallback_fake.call_count, 1,
+                "ledStripUtilSetFrameFreeCallback should be called once");
+  zassert_equal(ledStripUtilSetFrameFreeCallback_fake.arg0_val, frameFreeCallback,
+                "ledStripUtilSetFrameFreeCallback should be called with the callback");
+}
+
+/**
+ * @test The refresh deadlines must accumulate the period tick fraction.
+ */
+ZTEST_F(ledStrip, test_armNextFrame_fractionalPeriod)
+{
+  resetPacing();
+
+  for(size_t i = 0; i < CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ; ++i)
+    zassert_false(armNextFrame(), "No deadline should be missed");
+
+  zassert_equal(frameDeadline, CONFIG_SYS_CLOCK_TICKS_PER_SEC,
+                "The deadlines should span exactly one second over the refresh rate");
+  zassert_equal(k_timer_start_mock_fake.call_count, CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ,
+                "The frame timer should be armed for each refresh");
+  zassert_equal(k_timer_start_mock_fake.arg1_val.ticks, CONFIG_SYS_CLOCK_TICKS_PER_SEC,
+                "The frame timer should be armed at the deadline");
+}
+
+/**
+ * @test A missed deadline must restart the pacing from now.
+ */
+ZTEST_F(ledStrip, test_armNextFrame_missedDeadline)
+{
+  resetPacing();
+  k_uptime_ticks_mock_fake.return_val = 1000;
+
+  zassert_true(armNextFrame(), "The deadline should be missed");
+  zassert_equal(frameDeadline, 1000 + FRAME_PERIOD_TICKS,
+                "The next deadline should be one period from now");
+}
+
+/* Cycle counter fake, 100 cycles elapsing between each read */
+static uint32_t k_cycle_get_32_step(void)
+{
+  return k_cycle_get_32_mock_fake.call_count * 100;
+}
+
+/**
+ * @test The run function must record the frame statistics.
+ */
+ZTEST_F(ledStrip, test_run_stats)
+{
+  LedStripStats_t stats;
+
+  fixture->test_queue_messages[0].type       = LED_STRIP_BRIGHTNESS_MSG;
+  fixture->test_queue_messages[1].type       = LED_STRIP_BRIGHTNESS_MSG;
+  fixture->test_queue_msg_count              = 2;
+  k_msgq_get_mock_fake.custom_fake           = k_msgq_get_from_run_queue;
+  k_cycle_get_32_mock_fake.custom_fake       = k_cycle_get_32_step;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(ledStripGetStats(&stats), 0, "ledStripGetStats should return 0");
+  zassert_equal(stats.frameCount, LED_STRIP_RUN_ITERATIONS, "Each refresh should be counted");
+  zassert_equal(stats.missedDeadlineCount, 0, "No deadline should be missed");
+  zassert_equal(stats.framePeriodUs, FRAME_PERIOD_US, "The budget should be the refresh period");
+  zassert_equal(stats.transmitLastUs, 100, "The push duration should be recorded");
+  zassert_equal(stats.transmitMaxUs, 100, "The longest push duration should be recorded");
+  zassert_equal(stats.drainLastCount, 0, "The last refresh should drain no message");
+  zassert_equal(stats.drainMaxCount, 2, "The first refresh should drain both messages");
+
+  zassert_equal(ledStripResetStats(), 0, "ledStripResetStats should return 0");
+  ledStripGetStats(&stats);
+  zassert_equal(stats.frameCount, 0, "The statistics should be reset");
+}
+
+/**
+ * @test ledStripGetStats must reject a NULL output.
+ */
+ZTEST_F(ledStrip, test_ledStripGetStats_null)
+{
+  zassert_equal(ledStripGetStats(NULL), -EINVAL, "ledStripGetStats should return -EINVAL");
+}
+
 ZTEST_SUITE(ledStrip, NULL, service_tests_setup, service_tests_before, NULL, NULL);
@@ -34,6 +34,12 @@ typedef void *osMemoryPoolId_t;
 #define CONFIG_ENYA_LED_STRIP 1
 #define CONFIG_ENYA_LED_STRIP_LOG_LEVEL 3
 #define CONFIG_ENYA_LED_STRIP_PIXEL_COUNT 5
+#define CONFIG_ENYA_LED_STRIP_REFRESH_RATE_HZ 50
+#define CONFIG_ENYA_LED_STRIP_KEEP_ALIVE_MS 100
+#define CONFIG_ENYA_LED_STRIP_DIRTY_SPAN 1
+#define CONFIG_ENYA_LED_STRIP_FRAMEBUFFER_COUNT 3
+#define CONFIG_ENYA_LED_STRIP_EFFECTS 1
+#define CONFIG_ENYA_LED_STRIP_ZONES 1
 
 /* FFF fakes list */
 #define FFF_FAKES_LIST(FAKE) \
@@ -41,7 +47,12 @@ typedef void *osMemoryPoolId_t;
   FAKE(led_strip_update_rgb_mock) \
   FAKE(osMemoryPoolNew) \
   FAKE(osMemoryPoolAlloc) \
-  FAKE(osMemoryPoolFree)
+  FAKE(osMemoryPoolFree) \
+  FAKE(mock_frame_free_callback) \
+  FAKE(ledStripEffectAdvance) \
+  FAKE(ledStripEffectRender) \
+  FAKE(ledStripZoneTakeSpan) \
+  FAKE(ledStripZoneCompose)
 
 /* Setup logging */
 #include <zephyr/logging/log.h>
@@ -61,21 +72,46 @@ FAKE_VALUE_FUNC(osMemoryPoolId_t, osMemoryPoolNew, uint32_t, uint32_t, void *);
 FAKE_VALUE_FUNC(void *, osMemoryPoolAlloc, osMemoryPoolId_t, uint32_t);
 FAKE_VALUE_FUNC(int, osMemoryPoolFree, osMemoryPoolId_t, void *);
 
-/* Mock LED strip device */
+/* Mock framebuffer release callback */
+FAKE_VOID_FUNC(mock_frame_free_callback);
+
+/* Mock effect engine functions */
+FAKE_VALUE_FUNC(bool, ledStripEffectAdvance);
+FAKE_VOID_FUNC(ledStripEffectRender, struct led_rgb *, size_t);
+
+/* Mock zone functions */
+FAKE_VALUE_FUNC(size_t, ledStripZoneTakeSpan);
+FAKE_VOID_FUNC(ledStripZoneCompose, struct led_rgb *, size_t);
+
+/* Mock LED strip devices */
 static const struct device mock_led_strip_dev __attribute__((unused)) = {
   .name = "mock_led_strip"
 };
 
-/* Override device tree macros */
+static const struct device mock_led_strip_1_dev __attribute__((unused)) = {
+  .name = "mock_led_strip_1"
+};
+
+/* Override device tree macros, with the led-strip and led-strip-1 aliases only */
 #undef DT_ALIAS
-#define DT_ALIAS(name) DT_N_NODELABEL_ws2812
+#define DT_ALIAS(name) DT_N_ALIAS_##name
+
+#undef DT_HAS_ALIAS
+#define DT_HAS_ALIAS(name) DT_HAS_ALIAS_##name
+#define DT_HAS_ALIAS_led_strip   1
+#define DT_HAS_ALIAS_led_strip_1 1
 
 #undef DEVICE_DT_GET
-#define DEVICE_DT_GET(node_id) (&mock_led_strip_dev)
+#define DEVICE_DT_GET(node_id) MOCK_DEVICE(node_id)
+#define MOCK_DEVICE(node_id) node_id##_DEVICE
 
-/* Mock DT node properties for ws2812 */
-#define DT_N_NODELABEL_ws2812_P_chain_length       5
-#define DT_N_NODELABEL_ws2812_P_color_mapping_LEN  3
+/* Mock DT node properties for the aliases */
+#define DT_N_ALIAS_led_strip_DEVICE                  (&mock_led_strip_dev)
+#define DT_N_ALIAS_led_strip_P_chain_length          5
+#define DT_N_ALIAS_led_strip_P_color_mapping_LEN     3
+#define DT_N_ALIAS_led_strip_1_DEVICE                (&mock_led_strip_1_dev)
+#define DT_N_ALIAS_led_strip_1_P_chain_length        3
+#define DT_N_ALIAS_led_strip_1_P_color_mapping_LEN   3
 
 #include "ledStripUtil.c"
 
@@ -92,12 +128,31 @@ static void *util_tests_setup(void)
  */
 static void util_tests_before(void *fixture)
 {
-  extern struct led_rgb *activeFrame;
-
   FFF_FAKES_LIST(RESET_FAKE);
   FFF_RESET_HISTORY();
 
-  activeFrame = NULL;
+  for(size_t i = 0; i < STRIP_COUNT; ++i)
+  {
+    ledStripUtilSetBrightness(i, 255);
+    strips[i].activeFrame    = NULL;
+    strips[i].pendingFrame   = NULL;
+    strips[i].dirtyCount     = 0;
+    strips[i].idleFrameCount = 0;
+  }
+  frameFreeCallback = NULL;
+}
+
+/**
+ * @brief Fill a test frame with a single color.
+ */
+static void fillFrame(struct led_rgb *frame, uint8_t level)
+{
+  for(size_t i = 0; i < DT_N_ALIAS_led_strip_P_chain_length; ++i)
+  {
+    frame[i].r = level;
+    frame[i].g = level;
+    frame[i].b = level;
+  }
 }
 
 /**
@@ -105,8 +160,8 @@ static void util_tests_before(void *fixture)
  */
 ZTEST(ledStripUtil, test_applyGlobalBrightness_nullFrame)
 {
-  ledStripUtilSetBrightness(128);
-  applyGlobalBrightness(NULL);
+  ledStripUtilSetBrightness(0, 128);
+  applyGlobalBrightness(strips, NULL, NULL, 5);
   /* No crash = pass */
 }
 
@@ -116,6 +171,7 @@ ZTEST(ledStripUtil, test_applyGlobalBrightness_nullFrame)
 ZTEST(ledStripUtil, test_applyGlobalBrightness_fullBrightness)
 {
   struct led_rgb frame[5];
+  struct led_rgb output[5];
 
   for(size_t i = 0; i < 5; ++i)
   {
@@ -124,14 +180,14 @@ ZTEST(ledStripUtil, test_applyGlobalBrightness_fullBrightness)
     frame[i].b = 64;
   }
 
-  ledStripUtilSetBrightness(255);
-  applyGlobalBrightness(frame);
+  ledStripUtilSetBrightness(0, 255);
+  applyGlobalBrightness(strips, frame, output, 5);
 
   for(size_t i = 0; i < 5; ++i)
   {
-    zassert_equal(frame[i].r, 255, "ch0 should be unchanged at full brightness");
-    zassert_equal(frame[i].g, 128, "ch1 should be unchanged at full brightness");
-    zassert_equal(frame[i].b, 64,  "ch2 should be unchanged at full brightness");
+    zassert_equal(output[i].r, 255, "ch0 should be unchanged at full brightness");
+    zassert_equal(output[i].g, 128, "ch1 should be unchanged at full brightness");
+    zassert_equal(output[i].b, 64,  "ch2 should be unchanged at full brightness");
   }
 }
 
@@ -141,6 +197,7 @@ ZTEST(ledStripUtil, test_applyGlobalBrightness_fullBrightness)
 ZTEST(ledStripUtil, test_applyGlobalBrightness_zeroBrightness)
 {
   struct led_rgb frame[5];
+  struct led_rgb output[5];
 
   for(size_t i = 0; i < 5; ++i)
   {
@@ -149,14 +206,14 @@ ZTEST(ledStripUtil, test_applyGlobalBrightness_zeroBrightness)
     frame[i].b = 64;
   }
 
-  ledStripUtilSetBrightness(0);
-  applyGlobalBrightness(frame);
+  ledStripUtilSetBrightness(0, 0);
+  applyGlobalBrightness(strips, frame, output, 5);
 
   for(size_t i = 0; i < 5; ++i)
   {
-    zassert_equal(frame[i].r, 0, "ch0 should be 0 at zero brightness");
-    zassert_equal(frame[i].g, 0, "ch1 should be 0 at zero brightness");
-    zassert_equal(frame[i].b, 0, "ch2 should be 0 at zero brightness");
+    zassert_equal(output[i].r, 0, "ch0 should be 0 at zero brightness");
+    zassert_equal(output[i].g, 0, "ch1 should be 0 at zero brightness");
+    zassert_equal(output[i].b, 0, "ch2 should be 0 at zero brightness");
   }
 }
 
@@ -166,6 +223,7 @@ ZTEST(ledStripUtil, test_applyGlobalBrightness_zeroBrightness)
 ZTEST(ledStripUtil, test_applyGlobalBrightness_partialBrightness)
 {
   struct led_rgb frame[5];
+  struct led_rgb output[5];
 
   for(size_t i = 0; i < 5; ++i)
   {
@@ -174,14 +232,15 @@ ZTEST(ledStripUtil, test_applyGlobalBrightness_partialBrightness)
     frame[i].b = 0;
   }
 
-  ledStripUtilSetBrightness(128);
-  applyGlobalBrightness(frame);
+  ledStripUtilSetBrightness(0, 128);
+  applyGlobalBrightness(strips, frame, output, 5);
 
   for(size_t i = 0; i < 5; ++i)
   {
-    zassert_equal(frame[i].r, 128, "ch0 should be scaled to 128 at half brightness");
-    zassert_equal(frame[i].g, 128, "ch1 should be scaled to 128 at half brightness");
-    zassert_equal(frame[i].b, 0,   "ch2 should remain 0 at half brightness");
+    zassert_equal(output[i].r, 128, "ch0 should be scaled to 128 at half brightness");
+    zassert_equal(output[i].g, 128, "ch1 should be scaled to 128 at half brightness");
+    zassert_equal(output[i].b, 0,   "ch2 should remain 0 at half brightness");
+    zassert_equal(frame[i].r, 255, "The frame should be left untouched");
   }
 }
 
@@ -213,10 +272,12 @@ ZTEST(ledStripUtil, test_initStrip_success)
   result = ledStripUtilInitStrip();
 
   zassert_equal(result, 0, "Expected success (0)");
-  zassert_equal(device_is_ready_mock_fake.call_count, 1,
-                "device_is_ready should be called once");
-  zassert_equal(device_is_ready_mock_fake.arg0_val, &mock_led_strip_dev,
-                "device_is_ready should be called with the LED strip device");
+  zassert_equal(device_is_ready_mock_fake.call_count, STRIP_COUNT,
+                "device_is_ready should be called for each strip");
+  zassert_equal(device_is_ready_mock_fake.arg0_history[0], &mock_led_strip_dev,
+                "device_is_ready should be called with the primary strip device");
+  zassert_equal(device_is_ready_mock_fake.arg0_history[1], &mock_led_strip_1_dev,
+                "device_is_ready should be called with the second strip device");
 }
 
 /**
@@ -250,13 +311,16 @@ ZTEST(ledStripUtil, test_initFramebuffers_success)
   result = ledStripUtilInitFramebuffers();
 
   zassert_equal(result, 0, "Expected success (0)");
-  zassert_equal(osMemoryPoolNew_fake.call_count, 1,
-                "osMemoryPoolNew should be called once");
-  zassert_equal(osMemoryPoolNew_fake.arg0_val, 2,
-                "Pool should have 2 blocks");
-  zassert_equal(osMemoryPoolNew_fake.arg1_val,
-                DT_N_NODELABEL_ws2812_P_chain_length * sizeof(struct led_rgb),
+  zassert_equal(osMemoryPoolNew_fake.call_count, STRIP_COUNT,
+                "osMemoryPoolNew should be called for each strip");
+  zassert_equal(osMemoryPoolNew_fake.arg0_val, CONFIG_ENYA_LED_STRIP_FRAMEBUFFER_COUNT,
+                "Pool should have the configured block count");
+  zassert_equal(osMemoryPoolNew_fake.arg1_history[0],
+                DT_N_ALIAS_led_strip_P_chain_length * sizeof(struct led_rgb),
                 "Block size should be pixel_count * sizeof(struct led_rgb)");
+  zassert_equal(osMemoryPoolNew_fake.arg1_history[1],
+                DT_N_ALIAS_led_strip_1_P_chain_length * sizeof(struct led_rgb),
+                "Each strip pool should be sized from its own chain length");
 }
 
 /**
@@ -268,7 +332,7 @@ ZTEST(ledStripUtil, test_getNextFramebuffer_allocFails)
 
   osMemoryPoolAlloc_fake.return_val = NULL;
 
-  result = ledStripUtilGetNextFramebuffer();
+  result = ledStripUtilGetNextFramebuffer(0);
 
   zassert_is_null(result, "Expected NULL when pool allocation fails");
   zassert_equal(osMemoryPoolAlloc_fake.call_count, 1,
@@ -285,7 +349,7 @@ ZTEST(ledStripUtil, test_getNextFramebuffer_success)
 
   osMemoryPoolAlloc_fake.return_val = mockBlock;
 
-  result = ledStripUtilGetNextFramebuffer();
+  result = ledStripUtilGetNextFramebuffer(0);
 
   zassert_equal(result, mockBlock,
                 "Expected the allocated block returned by osMemoryPoolAlloc");
@@ -307,10 +371,10 @@ ZTEST(ledStripUtil, test_activateFrame_success)
   osMemoryPoolNew_fake.return_val = mockPool;
   ledStripUtilInitFramebuffers();
 
-  ledStripUtilActivateFrame(oldFrame);
+  ledStripUtilActivateFrame(0, oldFrame);
   FFF_FAKES_LIST(RESET_FAKE);
 
-  ledStripUtilActivateFrame(newFrame);
+  ledStripUtilActivateFrame(0, newFrame);
 
   zassert_equal(osMemoryPoolFree_fake.call_count, 1,
                 "osMemoryPoolFree should be called once to release the previous frame");
@@ -342,7 +406,7 @@ ZTEST(ledStripUtil, test_pushFrame_updateRgbFails)
   struct led_rgb mockFrame[5];
   int result;
 
-  ledStripUtilActivateFrame(mockFrame);
+  ledStripUtilActivateFrame(0, mockFrame);
   led_strip_update_rgb_mock_fake.return_val = -EIO;
 
   result = ledStripUtilPushFrame();
@@ -361,7 +425,7 @@ ZTEST(ledStripUtil, test_pushFrame_success)
   struct led_rgb mockFrame[5];
   int result;
 
-  ledStripUtilActivateFrame(mockFrame);
+  ledStripUtilActivateFrame(0, mockFrame);
 
   result = ledStripUtilPushFrame();
 
@@ -370,9 +434,9 @@ ZTEST(ledStripUtil, test_pushFrame_success)
                 "led_strip_update_rgb should be called once");
   zassert_equal(led_strip_update_rgb_mock_fake.arg0_val, &mock_led_strip_dev,
                 "led_strip_update_rgb should be called with the LED strip device");
-  zassert_equal(led_strip_update_rgb_mock_fake.arg1_val, (struct led_rgb *)mockFrame,
-                "led_strip_update_rgb should be called with the active frame");
-  zassert_equal(led_strip_update_rgb_mock_fake.arg2_val, DT_N_NODELABEL_ws2812_P_chain_length,
+  zassert_equal(led_strip_update_rgb_mock_fake.arg1_val, led_stripOutputFrame,
+                "led_strip_update_rgb should be called with the output frame");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg2_val, DT_N_ALIAS_led_strip_P_chain_length,
                 "led_strip_update_rgb should be called with the pixel count");
 }
 
@@ -382,6 +446,7 @@ ZTEST(ledStripUtil, test_pushFrame_success)
 ZTEST(ledStripUtil, test_setBrightness_success)
 {
   struct led_rgb frame[5];
+  struct led_rgb output[5];
 
   for(size_t i = 0; i < 5; ++i)
   {
@@ -390,15 +455,436 @@ ZTEST(ledStripUtil, test_setBrightness_success)
     frame[i].b = 255;
   }
 
-  ledStripUtilSetBrightness(128);
-  applyGlobalBrightness(frame);
+  ledStripUtilSetBrightness(0, 128);
+  applyGlobalBrightness(strips, frame, output, 5);
+
+  for(size_t i = 0; i < 5; ++i)
+  {
+    zassert_equal(output[i].r, 128, "ch0 should be scaled to 128 after setting brightness to 128");
+    zassert_equal(output[i].g, 128, "ch1 should be scaled to 128 after setting brightness to 128");
+    zassert_equal(output[i].b, 128, "ch2 should be scaled to 128 after setting brightness to 128");
+  }
+}
+
+/**
+ * @test Lowering then raising the brightness must restore the pushed colors.
+ */
+ZTEST(ledStripUtil, test_setBrightness_nonDestructive)
+{
+  struct led_rgb mockFrame[5];
+
+  fillFrame(mockFrame, 200);
+  ledStripUtilActivateFrame(0, mockFrame);
+
+  ledStripUtilSetBrightness(0, 10);
+  ledStripUtilPushFrame();
+  zassert_equal(led_stripOutputFrame[0].r, 200 * 10 / 255, "The output should be dimmed");
+
+  ledStripUtilSetBrightness(0, 255);
+  ledStripUtilPushFrame();
 
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2,
+                "led_strip_update_rgb should be called for each brightness");
   for(size_t i = 0; i < 5; ++i)
   {
-    zassert_equal(frame[i].r, 128, "ch0 should be scaled to 128 after setting brightness to 128");
-    zassert_equal(frame[i].g, 128, "ch1 should be scaled to 128 after setting brightness to 128");
-    zassert_equal(frame[i].b, 128, "ch2 should be scaled to 128 after setting brightness to 128");
+    zassert_equal(led_stripOutputFrame[i].r, 200, "The full brightness colors should be restored");
+    zassert_equal(mockFrame[i].r, 200, "The frame should be left untouched");
   }
 }
 
+/**
+ * @test ledStripUtilPushFrame must only convert the pushed pixels.
+ */
+ZTEST(ledStripUtil, test_pushFrame_convertsSpanOnly)
+{
+  struct led_rgb oldFrame[5];
+  struct led_rgb newFrame[5];
+
+  fillFrame(oldFrame, 10);
+  fillFrame(newFrame, 10);
+  newFrame[0].b = 20;
+
+  ledStripUtilActivateFrame(0, oldFrame);
+  ledStripUtilPushFrame();
+  memset(led_stripOutputFrame, 0xAA, sizeof(led_stripOutputFrame));
+
+  ledStripUtilActivateFrame(0, newFrame);
+  ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.arg2_val, 1,
+                "Only the changed pixel should be pushed");
+  zassert_equal(led_stripOutputFrame[0].b, 20, "The pushed pixel should be converted");
+  zassert_equal(led_stripOutputFrame[1].b, 0xAA, "The pixels past the span should not be converted");
+}
+
+/**
+ * @test ledStripUtilPushFrame must not push an unchanged frame again.
+ */
+ZTEST(ledStripUtil, test_pushFrame_unchanged)
+{
+  struct led_rgb mockFrame[5];
+
+  fillFrame(mockFrame, 10);
+  ledStripUtilActivateFrame(0, mockFrame);
+
+  zassert_equal(ledStripUtilPushFrame(), 0, "The first push should succeed");
+  zassert_equal(ledStripUtilPushFrame(), 0, "The idle push should succeed");
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 1,
+                "led_strip_update_rgb should only be called for the new frame");
+}
+
+/**
+ * @test ledStripUtilPushFrame must retry a failed push at the next call.
+ */
+ZTEST(ledStripUtil, test_pushFrame_retryAfterFailure)
+{
+  struct led_rgb mockFrame[5];
+  int returnVals[] = {-EIO, 0};
+
+  fillFrame(mockFrame, 10);
+  ledStripUtilActivateFrame(0, mockFrame);
+  SET_RETURN_SEQ(led_strip_update_rgb_mock, returnVals, 2);
+
+  ledStripUtilPushFrame();
+  ledStripUtilPushFrame();
+  ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2,
+                "led_strip_update_rgb should be called again after the failure only");
+}
+
+/**
+ * @test ledStripUtilPushFrame must push the unchanged frame at the keep-alive period.
+ */
+ZTEST(ledStripUtil, test_pushFrame_keepAlive)
+{
+  struct led_rgb mockFrame[5];
+
+  fillFrame(mockFrame, 10);
+  ledStripUtilActivateFrame(0, mockFrame);
+  ledStripUtilPushFrame();
+
+  for(size_t i = 0; i < KEEP_ALIVE_FRAME_COUNT - 1; ++i)
+    ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 1,
+                "led_strip_update_rgb should not be called before the keep-alive period");
+
+  ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2,
+                "led_strip_update_rgb should be called at the keep-alive period");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg2_val, DT_N_ALIAS_led_strip_P_chain_length,
+                "The keep-alive should push the full chain");
+}
+
+/**
+ * @test ledStripUtilSetBrightness must push the full frame at the next refresh.
+ */
+ZTEST(ledStripUtil, test_pushFrame_brightnessChange)
+{
+  struct led_rgb mockFrame[5];
+
+  fillFrame(mockFrame, 10);
+  ledStripUtilActivateFrame(0, mockFrame);
+  ledStripUtilPushFrame();
+
+  ledStripUtilSetBrightness(0, 128);
+  ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2,
+                "led_strip_update_rgb should be called after the brightness change");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg2_val, DT_N_ALIAS_led_strip_P_chain_length,
+                "The brightness change should push the full chain");
+}
+
+/**
+ * @test ledStripUtilPushFrame must only push up to the last changed pixel.
+ */
+ZTEST(ledStripUtil, test_pushFrame_dirtySpan)
+{
+  struct led_rgb oldFrame[5];
+  struct led_rgb newFrame[5];
+  struct led_rgb sameFrame[5];
+
+  fillFrame(oldFrame, 10);
+  fillFrame(newFrame, 10);
+  newFrame[2].g = 20;
+  memcpy(sameFrame, newFrame, sizeof(sameFrame));
+
+  ledStripUtilActivateFrame(0, oldFrame);
+  ledStripUtilPushFrame();
+
+  ledStripUtilActivateFrame(0, newFrame);
+  ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2,
+                "led_strip_update_rgb should be called for the changed frame");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg2_val, 3,
+                "The push should stop at the last changed pixel");
+
+  ledStripUtilActivateFrame(0, sameFrame);
+  ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2,
+                "led_strip_update_rgb should not be called for an identical frame");
+}
+
+/**
+ * @test The dirty spans of the frames activated before a push must add up.
+ */
+ZTEST(ledStripUtil, test_pushFrame_dirtySpanAccumulates)
+{
+  struct led_rgb frames[3][5];
+
+  fillFrame(frames[0], 10);
+  fillFrame(frames[1], 10);
+  fillFrame(frames[2], 10);
+  frames[1][3].r = 20;
+  frames[2][3].r = 20;
+  frames[2][0].r = 30;
+
+  ledStripUtilActivateFrame(0, frames[0]);
+  ledStripUtilPushFrame();
+
+  ledStripUtilActivateFrame(0, frames[1]);
+  ledStripUtilActivateFrame(0, frames[2]);
+  ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.arg2_val, 4,
+                "The push should cover the pixels changed by both frames");
+}
+
+/**
+ * @test The framebuffer release callback must be called when a frame returns to the pool.
+ */
+ZTEST(ledStripUtil, test_activateFrame_freeCallback)
+{
+  struct led_rgb oldFrame[5];
+  struct led_rgb newFrame[5];
+
+  ledStripUtilActivateFrame(0, oldFrame);
+  zassert_equal(mock_frame_free_callback_fake.call_count, 0,
+                "No callback should be called without a callback set");
+
+  ledStripUtilSetFrameFreeCallback(mock_frame_free_callback);
+  ledStripUtilActivateFrame(0, newFrame);
+
+  zassert_equal(mock_frame_free_callback_fake.call_count, 1,
+                "The callback should be called once the previous frame is released");
+}
+
+/**
+ * @test ledStripUtilPostFrame must return -EINVAL for a NULL frame.
+ */
+ZTEST(ledStripUtil, test_postFrame_nullFrame)
+{
+  zassert_equal(ledStripUtilPostFrame(0, NULL), -EINVAL, "Expected -EINVAL for a NULL frame");
+  zassert_is_null(ledStripUtilTakeFrame(0), "No frame should be pending");
+}
+
+/**
+ * @test The newest posted frame must win and the stale one must be released right away.
+ */
+ZTEST(ledStripUtil, test_postFrame_newestWins)
+{
+  osMemoryPoolId_t mockPool = (osMemoryPoolId_t)0x1000;
+  struct led_rgb staleFrame[5];
+  struct led_rgb newFrame[5];
+
+  osMemoryPoolNew_fake.return_val = mockPool;
+  ledStripUtilInitFramebuffers();
+  ledStripUtilSetFrameFreeCallback(mock_frame_free_callback);
+  FFF_FAKES_LIST(RESET_FAKE);
+
+  zassert_equal(ledStripUtilPostFrame(0, staleFrame), 0, "Posting a frame should succeed");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0,
+                "No frame should be released without a pending frame");
+
+  zassert_equal(ledStripUtilPostFrame(0, newFrame), 0, "Posting a frame should succeed");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1,
+                "The stale frame should be released right away");
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, mockPool,
+                "osMemoryPoolFree should be called with the framebuffer pool");
+  zassert_equal(osMemoryPoolFree_fake.arg1_val, staleFrame,
+                "osMemoryPoolFree should be called with the stale frame");
+  zassert_equal(mock_frame_free_callback_fake.call_count, 1,
+                "The callback should be called for the stale frame");
+
+  zassert_equal(ledStripUtilTakeFrame(0), newFrame, "The newest frame should be taken");
+  zassert_is_null(ledStripUtilTakeFrame(0), "The mailbox should be empty once taken");
+}
+
+/* Effect render fake, filling the rendered pixels */
+static void ledStripEffectRender_fill(struct led_rgb *frame, size_t count)
+{
+  for(size_t i = 0; i < count; ++i)
+    frame[i].g = 0x80;
+}
+
+/**
+ * @test An effect step must push the whole chain even without a new frame.
+ */
+ZTEST(ledStripUtil, test_pushFrame_effectStep)
+{
+  struct led_rgb frame[5];
+
+  fillFrame(frame, 10);
+  ledStripUtilActivateFrame(0, frame);
+  ledStripUtilPushFrame();
+
+  ledStripEffectAdvance_fake.return_val = true;
+  ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2,
+                "An effect step should push the frame");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg2_val, 5,
+                "An effect step should push the whole chain");
+}
+
+/**
+ * @test The effects must be rendered over a copy of the active frame.
+ */
+ZTEST(ledStripUtil, test_pushFrame_effectRender)
+{
+  struct led_rgb frame[5];
+
+  fillFrame(frame, 10);
+  ledStripEffectRender_fake.custom_fake = ledStripEffectRender_fill;
+
+  ledStripUtilActivateFrame(0, frame);
+  ledStripUtilPushFrame();
+
+  zassert_equal(ledStripEffectRender_fake.call_count, 1, "The effects should be rendered");
+  zassert_equal(ledStripEffectRender_fake.arg0_val, led_stripOutputFrame,
+                "The effects should be rendered into the output frame");
+  zassert_equal(led_stripOutputFrame[0].r, 10, "The active frame should be under the effects");
+  zassert_equal(led_stripOutputFrame[0].g, 0x80, "The effects should be pushed");
+  zassert_equal(frame[0].g, 10, "The active frame should be untouched");
+}
+
+/**
+ * @test A zone update must push the chain up to the last zone pixel changed.
+ */
+ZTEST(ledStripUtil, test_pushFrame_zoneSpan)
+{
+  struct led_rgb frame[5];
+
+  fillFrame(frame, 10);
+  ledStripUtilActivateFrame(0, frame);
+  ledStripUtilPushFrame();
+
+  ledStripZoneTakeSpan_fake.return_val = 3;
+  ledStripUtilPushFrame();
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2,
+                "A zone update should push the frame");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg2_val, 3,
+                "A zone update should push up to its last pixel changed");
+  zassert_equal(ledStripZoneCompose_fake.arg0_val, led_stripOutputFrame,
+                "The zones should be composed into the output frame");
+  zassert_equal(ledStripZoneCompose_fake.arg1_val, 3,
+                "The zones should be composed over the pushed pixels");
+}
+
+/**
+ * @test The strip count and pixel counts must follow the strip aliases.
+ */
+ZTEST(ledStripUtil, test_strips_counts)
+{
+  zassert_equal(ledStripUtilGetStripCount(), 2, "Each strip alias should be a strip");
+  zassert_equal(ledStripUtilGetPixelCount(0), DT_N_ALIAS_led_strip_P_chain_length,
+                "The primary strip should have its chain length");
+  zassert_equal(ledStripUtilGetPixelCount(1), DT_N_ALIAS_led_strip_1_P_chain_length,
+                "The second strip should have its chain length");
+  zassert_equal(ledStripUtilGetPixelCount(2), 0, "An out of range strip should have no pixel");
+  zassert_is_null(ledStripUtilGetNextFramebuffer(2),
+                  "An out of range strip should have no framebuffer");
+  zassert_equal(ledStripUtilPostFrame(2, (struct led_rgb *)0x1000), -EINVAL,
+                "Posting to an out of range strip should return -EINVAL");
+}
+
+/**
+ * @test Each strip must be pushed with its own frame, pixel count and brightness.
+ */
+ZTEST(ledStripUtil, test_pushFrame_strips)
+{
+  struct led_rgb primaryFrame[5];
+  struct led_rgb secondFrame[3];
+
+  fillFrame(primaryFrame, 200);
+  for(size_t i = 0; i < 3; ++i)
+    secondFrame[i] = (struct led_rgb){.r = 200, .g = 200, .b = 200};
+
+  ledStripUtilActivateFrame(0, primaryFrame);
+  ledStripUtilActivateFrame(1, secondFrame);
+  ledStripUtilSetBrightness(1, 0);
+
+  zassert_equal(ledStripUtilPushFrame(), 0, "The push should succeed");
+
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2, "Each strip should be pushed");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg0_history[1], &mock_led_strip_1_dev,
+                "The second strip should be pushed to its device");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg1_history[1], led_strip_1OutputFrame,
+                "The second strip should be pushed from its output frame");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg2_history[1], DT_N_ALIAS_led_strip_1_P_chain_length,
+                "The second strip should be pushed with its pixel count");
+  zassert_equal(led_stripOutputFrame[0].r, 200, "The primary strip should keep its brightness");
+  zassert_equal(led_strip_1OutputFrame[0].r, 0, "The second strip should have its brightness");
+  zassert_equal(ledStripEffectRender_fake.call_count, 1,
+                "The effects should only be rendered over the primary strip");
+  zassert_equal(ledStripZoneCompose_fake.call_count, 1,
+                "The zones should only be composed over the primary strip");
+}
+
+/**
+ * @test A failed strip push must not hold back the other strips.
+ */
+ZTEST(ledStripUtil, test_pushFrame_stripFailureIsolated)
+{
+  struct led_rgb primaryFrame[5];
+  struct led_rgb secondFrame[3] = {0};
+  int returnVals[] = {-EIO, 0, 0};
+
+  fillFrame(primaryFrame, 10);
+  ledStripUtilActivateFrame(0, primaryFrame);
+  ledStripUtilActivateFrame(1, secondFrame);
+  SET_RETURN_SEQ(led_strip_update_rgb_mock, returnVals, 3);
+
+  zassert_equal(ledStripUtilPushFrame(), -EIO, "The push should return the strip error");
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 2,
+                "The second strip should be pushed despite the failure");
+
+  zassert_equal(ledStripUtilPushFrame(), 0, "The retry should succeed");
+  zassert_equal(led_strip_update_rgb_mock_fake.call_count, 3,
+                "Only the failed strip should be pushed again");
+  zassert_equal(led_strip_update_rgb_mock_fake.arg0_val, &mock_led_strip_dev,
+                "The failed strip should be retried");
+}
+
+/**
+ * @test A frame posted to a strip must be released to the pool of that strip.
+ */
+ZTEST(ledStripUtil, test_postFrame_stripPool)
+{
+  osMemoryPoolId_t pools[] = {(osMemoryPoolId_t)0x1000, (osMemoryPoolId_t)0x2000};
+  static struct led_rgb activeFrame[5];
+  struct led_rgb staleFrame[3];
+  struct led_rgb newFrame[3];
+
+  SET_RETURN_SEQ(osMemoryPoolNew, pools, 2);
+  osMemoryPoolAlloc_fake.return_val = activeFrame;
+  ledStripUtilInitFramebuffers();
+  FFF_FAKES_LIST(RESET_FAKE);
+
+  ledStripUtilPostFrame(1, staleFrame);
+  ledStripUtilPostFrame(1, newFrame);
+
+  zassert_equal(osMemoryPoolFree_fake.arg0_val, pools[1],
+                "The stale frame should be released to the strip pool");
+  zassert_is_null(ledStripUtilTakeFrame(0), "The primary strip mailbox should be empty");
+  zassert_equal(ledStripUtilTakeFrame(1), newFrame, "The strip mailbox should hold the frame");
+}
+
 ZTEST_SUITE(ledStripUtil, NULL, util_tests_setup, util_tests_before, NULL, NULL);
@@ -0,0 +1,210 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     LED Strip Zone Tests
+ *
+ *            Unit tests for the LED strip zones.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Prevent LED strip driver header - we'll define types manually */
+#define ZEPHYR_INCLUDE_DRIVERS_LED_STRIP_H_
+
+/* Prevent ledStripUtil header - only its logger name is needed */
+#define LEDSTRIPUTIL_H
+#define LED_STRIP_LOGGER_NAME ledStrip
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_LED_STRIP 1
+#define CONFIG_ENYA_LED_STRIP_LOG_LEVEL 3
+#define CONFIG_ENYA_LED_STRIP_ZONES 1
+#define CONFIG_ENYA_LED_STRIP_ZONE_COUNT 2
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ledStrip, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Mock LED strip pixel type */
+struct led_rgb { uint8_t r; uint8_t g; uint8_t b; };
+
+/* Override device tree macros */
+#undef DT_ALIAS
+#define DT_ALIAS(name) DT_N_NODELABEL_ws2812
+
+/* Mock DT node properties for ws2812 */
+#define DT_N_NODELABEL_ws2812_P_chain_length 8
+
+#include "ledStripZone.c"
+
+#define TEST_PIXEL_COUNT DT_N_NODELABEL_ws2812_P_chain_length
+
+static const struct led_rgb red  = {.r = 255};
+static const struct led_rgb blue = {.b = 255};
+
+/**
+ * @brief Fill a test frame with a single color.
+ */
+static void fillFrame(struct led_rgb *frame, struct led_rgb color)
+{
+  for(size_t i = 0; i < TEST_PIXEL_COUNT; ++i)
+    frame[i] = color;
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void zone_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  memset(zones, 0, sizeof(zones));
+  memset(zonePixels, 0, sizeof(zonePixels));
+  zoneSpan = 0;
+}
+
+/**
+ * @test ledStripZoneRegister must reject the invalid ranges.
+ */
+ZTEST(ledStripZone, test_register_invalid)
+{
+  size_t zoneId;
+
+  zassert_equal(ledStripZoneRegister(0, 2, NULL), -EINVAL, "NULL zone ID should return -EINVAL");
+  zassert_equal(ledStripZoneRegister(0, 0, &zoneId), -EINVAL, "Empty range should return -EINVAL");
+  zassert_equal(ledStripZoneRegister(6, 3, &zoneId), -EINVAL,
+                "Out of chain range should return -EINVAL");
+}
+
+/**
+ * @test ledStripZoneRegister must reject overlapping ranges and a full zone table.
+ */
+ZTEST(ledStripZone, test_register_overlapAndFull)
+{
+  size_t zoneId;
+
+  zassert_equal(ledStripZoneRegister(2, 3, &zoneId), 0, "The first zone should be registered");
+  zassert_equal(zoneId, 0, "The first zone ID should be 0");
+  zassert_equal(ledStripZoneRegister(4, 2, &zoneId), -EBUSY,
+                "An overlapping range should return -EBUSY");
+  zassert_equal(ledStripZoneRegister(5, 3, &zoneId), 0, "An adjacent zone should be registered");
+  zassert_equal(zoneId, 1, "The second zone ID should be 1");
+  zassert_equal(ledStripZoneRegister(0, 2, &zoneId), -ENOSPC,
+                "A full zone table should return -ENOSPC");
+}
+
+/**
+ * @test A registered zone must start off and mark its range changed.
+ */
+ZTEST(ledStripZone, test_register_startsOff)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  size_t zoneId;
+
+  zassert_equal(ledStripZoneRegister(2, 3, &zoneId), 0, "The zone should be registered");
+  zassert_equal(ledStripZoneTakeSpan(), 5, "The span should end at the zone end");
+  zassert_equal(ledStripZoneTakeSpan(), 0, "The span should be cleared once taken");
+
+  fillFrame(frame, blue);
+  ledStripZoneCompose(frame, TEST_PIXEL_COUNT);
+
+  zassert_equal(frame[1].b, 255, "The pixels before the zone should be untouched");
+  zassert_equal(frame[2].b, 0, "The zone pixels should be off");
+  zassert_equal(frame[4].b, 0, "The zone pixels should be off");
+  zassert_equal(frame[5].b, 255, "The pixels past the zone should be untouched");
+}
+
+/**
+ * @test ledStripZoneUpdate must reject the invalid updates.
+ */
+ZTEST(ledStripZone, test_update_invalid)
+{
+  struct led_rgb pixels[3] = {red, red, red};
+  size_t zoneId;
+
+  zassert_equal(ledStripZoneUpdate(0, 0, pixels, 1), -EINVAL,
+                "An unregistered zone should return -EINVAL");
+
+  ledStripZoneRegister(2, 3, &zoneId);
+
+  zassert_equal(ledStripZoneUpdate(CONFIG_ENYA_LED_STRIP_ZONE_COUNT, 0, pixels, 1), -EINVAL,
+                "An invalid zone should return -EINVAL");
+  zassert_equal(ledStripZoneUpdate(zoneId, 0, NULL, 1), -EINVAL, "NULL pixels should return -EINVAL");
+  zassert_equal(ledStripZoneUpdate(zoneId, 1, pixels, 3), -EINVAL,
+                "Pixels overflowing the zone should return -EINVAL");
+}
+
+/**
+ * @test A partial update must only change its pixels and span.
+ */
+ZTEST(ledStripZone, test_update_partial)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  struct led_rgb pixel = red;
+  size_t zoneId;
+
+  ledStripZoneRegister(2, 4, &zoneId);
+  ledStripZoneTakeSpan();
+
+  zassert_equal(ledStripZoneUpdate(zoneId, 1, &pixel, 1), 0, "The update should succeed");
+  zassert_equal(ledStripZoneTakeSpan(), 4, "The span should end at the updated pixel");
+
+  fillFrame(frame, blue);
+  ledStripZoneCompose(frame, TEST_PIXEL_COUNT);
+
+  zassert_equal(frame[2].r, 0, "The pixels not updated should keep their value");
+  zassert_equal(frame[3].r, 255, "The updated pixel should be composed");
+  zassert_equal(frame[6].b, 255, "The pixels past the zone should be untouched");
+}
+
+/**
+ * @test A zone must only be composed up to the pixel count.
+ */
+ZTEST(ledStripZone, test_compose_clipped)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  struct led_rgb pixels[4] = {red, red, red, red};
+  size_t zoneId;
+
+  ledStripZoneRegister(2, 4, &zoneId);
+  ledStripZoneUpdate(zoneId, 0, pixels, 4);
+
+  fillFrame(frame, blue);
+  ledStripZoneCompose(frame, 3);
+
+  zassert_equal(frame[2].r, 255, "The zone should be composed up to the count");
+  zassert_equal(frame[3].b, 255, "The zone should not be composed past the count");
+}
+
+/**
+ * @test An unregistered zone must show the frame again.
+ */
+ZTEST(ledStripZone, test_unregister)
+{
+  struct led_rgb frame[TEST_PIXEL_COUNT];
+  size_t zoneId;
+
+  zassert_equal(ledStripZoneUnregister(0), -EINVAL, "An unregistered zone should return -EINVAL");
+
+  ledStripZoneRegister(2, 3, &zoneId);
+  ledStripZoneTakeSpan();
+
+  zassert_equal(ledStripZoneUnregister(zoneId), 0, "The zone should be unregistered");
+  zassert_equal(ledStripZoneTakeSpan(), 5, "The span should end at the zone end");
+
+  fillFrame(frame, blue);
+  ledStripZoneCompose(frame, TEST_PIXEL_COUNT);
+
+  zassert_equal(frame[2].b, 255, "The frame should be shown over the range");
+}
+
+ZTEST_SUITE(ledStripZone, NULL, NULL, zone_tests_before, NULL, NULL);
@@ -0,0 +1,293 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Common Publish/Subscribe Tests
+ *
+ *            Unit tests for the service publish/subscribe bus.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_SERVICE_COMMON_SHARED_PAYLOAD 1
+#define CONFIG_ENYA_SERVICE_COMMON_SHARED_PAYLOAD_LOG_LEVEL 3
+#define CONFIG_ENYA_SERVICE_COMMON_PUB_SUB 1
+#define CONFIG_ENYA_SERVICE_COMMON_PUB_SUB_LOG_LEVEL 3
+
+#include "srvPubSub.h"
+
+/* Mock memory pool functions */
+FAKE_VALUE_FUNC(osStatus_t, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(osMemoryPoolFree)
+
+#include "srvPayload.c"
+#include "srvPubSub.c"
+
+#define TEST_SUB_COUNT      2
+#define TEST_QUEUE_SIZE     2
+#define TEST_PAYLOAD_COUNT  4
+#define TEST_DATA_LEN       8
+
+/* The test payload pool */
+SRV_PAYLOAD_POOL_DEFINE(testPool, TEST_PAYLOAD_COUNT, TEST_DATA_LEN);
+
+/* The test topic and subscribers */
+static SrvPubSubTopic_t testTopic;
+static SrvPubSubSubscriber_t *testSubTable[TEST_SUB_COUNT];
+static SrvPubSubSubscriber_t testSubs[TEST_SUB_COUNT + 1];
+static struct k_msgq testQueues[TEST_SUB_COUNT + 1];
+static char testQueueBuffers[TEST_SUB_COUNT + 1][TEST_QUEUE_SIZE * sizeof(SrvMsgPayload_t *)];
+
+/**
+ * @brief Get the allocated payload count of the test pool.
+ */
+static size_t getUsedCount(void)
+{
+  return atomic_get(&testPool.usedCount);
+}
+
+/**
+ * @brief Publish a test payload.
+ */
+static SrvMsgPayload_t *publishTestPayload(int *queuedCount)
+{
+  SrvMsgPayload_t *payload = srvPubSubAlloc(&testTopic);
+
+  payload->dataLen = TEST_DATA_LEN;
+  *queuedCount = srvPubSubPublish(&testTopic, payload);
+
+  return payload;
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void pubSub_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(&testTopic, 0, sizeof(testTopic));
+  memset(testSubTable, 0, sizeof(testSubTable));
+
+  srvPayloadPoolInit(&testPool);
+  srvPubSubTopicInit(&testTopic, "test", &testPool, testSubTable, TEST_SUB_COUNT);
+
+  for(size_t i = 0; i < TEST_SUB_COUNT + 1; ++i)
+  {
+    k_msgq_init(&testQueues[i], testQueueBuffers[i], sizeof(SrvMsgPayload_t *), TEST_QUEUE_SIZE);
+    srvPubSubSubscriberInit(&testSubs[i], &testQueues[i], SRV_PUB_SUB_DROP_NEWEST);
+  }
+}
+
+/**
+ * @test srvPubSubTopicInit must reject the invalid configurations.
+ */
+ZTEST(srvPubSub, test_topicInit_invalid)
+{
+  SrvPubSubTopic_t topic;
+
+  zassert_equal(srvPubSubTopicInit(NULL, "test", &testPool, testSubTable, 1), -EINVAL,
+                "NULL topic should return -EINVAL");
+  zassert_equal(srvPubSubTopicInit(&topic, "test", NULL, testSubTable, 1), -EINVAL,
+                "NULL pool should return -EINVAL");
+  zassert_equal(srvPubSubTopicInit(&topic, "test", &testPool, NULL, 1), -EINVAL,
+                "NULL subscriber table should return -EINVAL");
+  zassert_equal(srvPubSubTopicInit(&topic, "test", &testPool, testSubTable, 0), -EINVAL,
+                "An empty subscriber table should return -EINVAL");
+}
+
+/**
+ * @test srvPubSubSubscriberInit must reject the invalid configurations.
+ */
+ZTEST(srvPubSub, test_subscriberInit_invalid)
+{
+  SrvPubSubSubscriber_t sub;
+  struct k_msgq queue;
+  char buffer[sizeof(uint8_t)];
+
+  zassert_equal(srvPubSubSubscriberInit(NULL, &testQueues[0], SRV_PUB_SUB_DROP_NEWEST), -EINVAL,
+                "NULL subscriber should return -EINVAL");
+  zassert_equal(srvPubSubSubscriberInit(&sub, NULL, SRV_PUB_SUB_DROP_NEWEST), -EINVAL,
+                "NULL queue should return -EINVAL");
+  zassert_equal(srvPubSubSubscriberInit(&sub, &testQueues[0], SRV_PUB_SUB_POLICY_COUNT), -EINVAL,
+                "An invalid policy should return -EINVAL");
+
+  k_msgq_init(&queue, buffer, sizeof(uint8_t), 1);
+
+  zassert_equal(srvPubSubSubscriberInit(&sub, &queue, SRV_PUB_SUB_DROP_NEWEST), -EINVAL,
+                "A queue not holding payload pointers should return -EINVAL");
+}
+
+/**
+ * @test srvPubSubSubscribe must reject a duplicate subscriber and a full table.
+ */
+ZTEST(srvPubSub, test_subscribe_duplicateAndFull)
+{
+  zassert_equal(srvPubSubSubscribe(&testTopic, &testSubs[0]), 0, "The subscriber should be added");
+  zassert_equal(srvPubSubSubscribe(&testTopic, &testSubs[0]), -EALREADY,
+                "A duplicate subscriber should return -EALREADY");
+  zassert_equal(srvPubSubSubscribe(&testTopic, &testSubs[1]), 0, "The subscriber should be added");
+  zassert_equal(srvPubSubSubscribe(&testTopic, &testSubs[2]), -ENOSPC,
+                "A full subscriber table should return -ENOSPC");
+}
+
+/**
+ * @test A publication must queue the same payload to every subscriber, the
+ *       last release returning it to the pool.
+ */
+ZTEST(srvPubSub, test_publish_zeroCopyFanOut)
+{
+  int queuedCount;
+  SrvMsgPayload_t *payload;
+  SrvMsgPayload_t *received[TEST_SUB_COUNT];
+
+  srvPubSubSubscribe(&testTopic, &testSubs[0]);
+  srvPubSubSubscribe(&testTopic, &testSubs[1]);
+
+  payload = publishTestPayload(&queuedCount);
+
+  zassert_equal(queuedCount, TEST_SUB_COUNT, "The payload should be queued to every subscriber");
+  zassert_equal(getUsedCount(), 1, "The payload should be allocated once");
+
+  for(size_t i = 0; i < TEST_SUB_COUNT; ++i)
+  {
+    zassert_equal(srvPubSubReceive(&testSubs[i], &received[i], K_NO_WAIT), 0,
+                  "The payload should be received");
+    zassert_equal_ptr(received[i], payload, "The subscribers should share the payload");
+  }
+
+  srvPayloadRelease(received[0]);
+  zassert_equal(getUsedCount(), 1, "A referenced payload should not be freed");
+
+  srvPayloadRelease(received[1]);
+  zassert_equal(getUsedCount(), 0, "The last release should free the payload");
+}
+
+/**
+ * @test A publication without any active subscriber must free the payload.
+ */
+ZTEST(srvPubSub, test_publish_paused)
+{
+  int queuedCount;
+
+  srvPubSubSubscribe(&testTopic, &testSubs[0]);
+  srvPubSubSetPaused(&testSubs[0], true);
+
+  publishTestPayload(&queuedCount);
+
+  zassert_equal(queuedCount, 0, "A paused subscriber should be skipped");
+  zassert_equal(k_msgq_num_used_get(&testQueues[0]), 0, "Nothing should be queued");
+  zassert_equal(getUsedCount(), 0, "An unreferenced payload should be freed");
+
+  srvPubSubSetPaused(&testSubs[0], false);
+  publishTestPayload(&queuedCount);
+
+  zassert_equal(queuedCount, 1, "An unpaused subscriber should get the payloads");
+}
+
+/**
+ * @test A drop-newest subscriber with a full queue must keep its queued payloads.
+ */
+ZTEST(srvPubSub, test_publish_dropNewest)
+{
+  int queuedCount;
+  SrvMsgPayload_t *first;
+  SrvMsgPayload_t *received;
+
+  srvPubSubSubscribe(&testTopic, &testSubs[0]);
+
+  first = publishTestPayload(&queuedCount);
+  publishTestPayload(&queuedCount);
+  publishTestPayload(&queuedCount);
+
+  zassert_equal(queuedCount, 0, "The newest payload should be dropped");
+  zassert_equal(atomic_get(&testSubs[0].dropCount), 1, "The drop should be counted");
+  zassert_equal(getUsedCount(), TEST_QUEUE_SIZE, "The dropped payload should be freed");
+
+  srvPubSubReceive(&testSubs[0], &received, K_NO_WAIT);
+  zassert_equal_ptr(received, first, "The oldest payload should be kept");
+}
+
+/**
+ * @test A drop-oldest subscriber with a full queue must replace its oldest payload.
+ */
+ZTEST(srvPubSub, test_publish_dropOldest)
+{
+  int queuedCount;
+  SrvMsgPayload_t *last;
+  SrvMsgPayload_t *received;
+
+  testSubs[0].policy = SRV_PUB_SUB_DROP_OLDEST;
+  srvPubSubSubscribe(&testTopic, &testSubs[0]);
+
+  SrvMsgPayload_t *second;
+
+  publishTestPayload(&queuedCount);
+  second = publishTestPayload(&queuedCount);
+  last = publishTestPayload(&queuedCount);
+
+  zassert_equal(queuedCount, 1, "The newest payload should be queued");
+  zassert_equal(atomic_get(&testSubs[0].dropCount), 1, "The drop should be counted");
+  zassert_equal(getUsedCount(), TEST_QUEUE_SIZE, "The dropped payload should be freed");
+
+  srvPubSubReceive(&testSubs[0], &received, K_NO_WAIT);
+  zassert_equal_ptr(received, second, "The oldest payload should be dropped");
+  srvPubSubReceive(&testSubs[0], &received, K_NO_WAIT);
+  zassert_equal_ptr(received, last, "The newest payload should be last");
+}
+
+/**
+ * @test A payload larger than the topic capacity must be rejected and freed.
+ */
+ZTEST(srvPubSub, test_publish_tooLarge)
+{
+  SrvMsgPayload_t *payload;
+
+  srvPubSubSubscribe(&testTopic, &testSubs[0]);
+
+  payload = srvPubSubAlloc(&testTopic);
+  payload->dataLen = TEST_DATA_LEN + 1;
+
+  zassert_equal(srvPubSubPublish(&testTopic, payload), -EINVAL, "Expected -EINVAL");
+  zassert_equal(k_msgq_num_used_get(&testQueues[0]), 0, "Nothing should be queued");
+  zassert_equal(getUsedCount(), 0, "The rejected payload should be freed");
+}
+
+/**
+ * @test srvPubSubUnsubscribe must release the queued payloads.
+ */
+ZTEST(srvPubSub, test_unsubscribe)
+{
+  int queuedCount;
+
+  zassert_equal(srvPubSubUnsubscribe(&testTopic, &testSubs[0]), -ESRCH,
+                "An unknown subscriber should return -ESRCH");
+
+  srvPubSubSubscribe(&testTopic, &testSubs[0]);
+  srvPubSubSubscribe(&testTopic, &testSubs[1]);
+  publishTestPayload(&queuedCount);
+
+  zassert_equal(srvPubSubUnsubscribe(&testTopic, &testSubs[0]), 0, "The subscriber should be removed");
+  zassert_equal(k_msgq_num_used_get(&testQueues[0]), 0, "The queued payloads should be released");
+  zassert_equal(getUsedCount(), 1, "A payload still referenced should be kept");
+  zassert_equal_ptr(testTopic.subs[0], &testSubs[1], "The remaining subscribers should be shifted");
+
+  publishTestPayload(&queuedCount);
+  zassert_equal(queuedCount, 1, "A removed subscriber should not get the payloads");
+}
+
+ZTEST_SUITE(srvPubSub, NULL, NULL, pubSub_tests_before, NULL, NULL);
@@ -0,0 +1,189 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Common Shared Payload Tests
+ *
+ *            Unit tests for the shared service payloads.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_SERVICE_COMMON_SHARED_PAYLOAD 1
+#define CONFIG_ENYA_SERVICE_COMMON_SHARED_PAYLOAD_LOG_LEVEL 3
+
+#include "srvPayload.h"
+
+/* Mock memory pool functions */
+FAKE_VALUE_FUNC(osStatus_t, osMemoryPoolFree, osMemoryPoolId_t, void *);
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(osMemoryPoolFree)
+
+#include "srvPayload.c"
+
+#define TEST_PAYLOAD_COUNT  3
+#define TEST_DATA_LEN       5
+
+/* The test payload pool */
+SRV_PAYLOAD_POOL_DEFINE(testPool, TEST_PAYLOAD_COUNT, TEST_DATA_LEN);
+
+/**
+ * @brief Get the statistics of the test pool.
+ */
+static SrvPayloadPoolStats_t getTestStats(void)
+{
+  SrvPayloadPoolStats_t stats;
+
+  srvPayloadPoolGetStats(&testPool, &stats);
+
+  return stats;
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void sharedPayload_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  srvPayloadPoolInit(&testPool);
+}
+
+/**
+ * @test srvPayloadPoolInit must reject an invalid pool.
+ */
+ZTEST(srvPayload, test_poolInit_invalid)
+{
+  SrvPayloadPool_t pool = {0};
+
+  zassert_equal(srvPayloadPoolInit(NULL), -EINVAL, "NULL pool should return -EINVAL");
+  zassert_equal(srvPayloadPoolInit(&pool), -EINVAL, "A pool without block should return -EINVAL");
+}
+
+/**
+ * @test The pool blocks must hold an aligned payload of the data capacity.
+ */
+ZTEST(srvPayload, test_poolDefine_blockSize)
+{
+  zassert_equal(testPool.blockSize % sizeof(void *), 0, "The blocks should be aligned");
+  zassert_true(srvPayloadPoolGetDataCapacity(&testPool) >= TEST_DATA_LEN,
+               "The blocks should hold the data capacity");
+  zassert_true(srvPayloadPoolGetDataCapacity(&testPool) < TEST_DATA_LEN + sizeof(void *),
+               "The blocks should only be padded for alignment");
+}
+
+/**
+ * @test srvPayloadAlloc must return distinct shared payloads holding the producer reference.
+ */
+ZTEST(srvPayload, test_alloc)
+{
+  SrvMsgPayload_t *first = srvPayloadAlloc(&testPool);
+  SrvMsgPayload_t *second = srvPayloadAlloc(&testPool);
+
+  zassert_not_null(first, "The payload should be allocated");
+  zassert_not_null(second, "The payload should be allocated");
+  zassert_not_equal(first, second, "The payloads should be distinct");
+  zassert_is_null(first->poolId, "A shared payload should have no pool ID");
+  zassert_equal_ptr(first->sharedPool, &testPool, "The payload should know its pool");
+  zassert_equal(atomic_get(&first->refCount), 1, "The payload should hold the producer reference");
+  zassert_equal(first->dataLen, 0, "The payload should be empty");
+  zassert_equal(getTestStats().usedCount, 2, "The occupancy should be counted");
+}
+
+/**
+ * @test An exhausted pool must fail the allocations and count them.
+ */
+ZTEST(srvPayload, test_alloc_exhausted)
+{
+  SrvPayloadPoolStats_t stats;
+
+  for(size_t i = 0; i < TEST_PAYLOAD_COUNT; ++i)
+    zassert_not_null(srvPayloadAlloc(&testPool), "The payload should be allocated");
+
+  zassert_is_null(srvPayloadAlloc(&testPool), "An exhausted pool should return NULL");
+  zassert_is_null(srvPayloadAlloc(&testPool), "An exhausted pool should return NULL");
+
+  stats = getTestStats();
+  zassert_equal(stats.blockCount, TEST_PAYLOAD_COUNT, "The block count should be reported");
+  zassert_equal(stats.usedCount, TEST_PAYLOAD_COUNT, "The whole pool should be in use");
+  zassert_equal(stats.allocFailCount, 2, "The failed allocations should be counted");
+}
+
+/**
+ * @test The last payload reference must return the payload to its pool for reuse.
+ */
+ZTEST(srvPayload, test_retainRelease)
+{
+  SrvMsgPayload_t *payload = srvPayloadAlloc(&testPool);
+
+  srvPayloadRetain(payload);
+  srvPayloadRetain(payload);
+
+  srvPayloadRelease(payload);
+  srvPayloadRelease(payload);
+  zassert_equal(getTestStats().usedCount, 1, "A referenced payload should not be freed");
+
+  srvPayloadRelease(payload);
+  zassert_equal(getTestStats().usedCount, 0, "The last release should free the payload");
+  zassert_equal(osMemoryPoolFree_fake.call_count, 0, "A shared payload should not use a memory pool");
+  zassert_equal_ptr(srvPayloadAlloc(&testPool), payload, "The freed block should be reused first");
+}
+
+/**
+ * @test The peak occupancy must be kept after the payloads are released.
+ */
+ZTEST(srvPayload, test_stats_peak)
+{
+  SrvMsgPayload_t *payloads[TEST_PAYLOAD_COUNT];
+  SrvPayloadPoolStats_t stats;
+
+  for(size_t i = 0; i < TEST_PAYLOAD_COUNT; ++i)
+    payloads[i] = srvPayloadAlloc(&testPool);
+
+  for(size_t i = 0; i < TEST_PAYLOAD_COUNT; ++i)
+    srvPayloadRelease(payloads[i]);
+
+  srvPayloadRelease(srvPayloadAlloc(&testPool));
+
+  stats = getTestStats();
+  zassert_equal(stats.usedCount, 0, "Every payload should be freed");
+  zassert_equal(stats.peakUsedCount, TEST_PAYLOAD_COUNT, "The peak occupancy should be kept");
+  zassert_equal(srvPayloadPoolGetStats(NULL, &stats), -EINVAL, "NULL pool should return -EINVAL");
+  zassert_equal(srvPayloadPoolGetStats(&testPool, NULL), -EINVAL, "NULL stats should return -EINVAL");
+}
+
+/**
+ * @test A payload with a pool ID must be freed to its memory pool right away.
+ */
+ZTEST(srvPayload, test_release_unshared)
+{
+  static int testMemoryPool;
+  SrvMsgPayload_t payload = {.poolId = &testMemoryPool, .refCount = 1};
+
+  srvPayloadRetain(&payload);
+  zassert_equal(atomic_get(&payload.refCount), 1, "An unshared payload should not be retained");
+
+  srvPayloadRelease(&payload);
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1, "An unshared payload should be freed");
+  zassert_equal_ptr(osMemoryPoolFree_fake.arg0_val, &testMemoryPool,
+                    "The payload should return to its memory pool");
+  zassert_equal_ptr(osMemoryPoolFree_fake.arg1_val, &payload, "The payload should be freed");
+
+  srvPayloadRelease(NULL);
+  zassert_equal(osMemoryPoolFree_fake.call_count, 1, "NULL payload should be ignored");
+}
+
+ZTEST_SUITE(srvPayload, NULL, NULL, sharedPayload_tests_before, NULL, NULL);
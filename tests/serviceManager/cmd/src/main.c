@@ -64,6 +64,7 @@ void shell_fprintf(const struct shell *shell, enum shell_vt100_color color,
 #define CONFIG_ENYA_SERVICE_MANAGER_SHELL 1
 #define CONFIG_ENYA_SERVICE_MANAGER 1
 #define CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL 3
+#define CONFIG_SVC_MGR_STATS 1
 
 /* Include serviceManager.h for type definitions */
 #include "serviceManager.h"
@@ -82,12 +83,15 @@ FAKE_VALUE_FUNC(int, serviceMngrUtilResumeService, size_t);
 /* Mock kernel functions */
 #define k_thread_name_get k_thread_name_get_mock
 FAKE_VALUE_FUNC(const char *, k_thread_name_get_mock, k_tid_t);
+#define k_uptime_get k_uptime_get_mock
+FAKE_VALUE_FUNC(int64_t, k_uptime_get_mock);
 
 /* Define shell macros for testing */
 #define shell_print(sh, fmt, ...) shell_fprintf(sh, SHELL_NORMAL, fmt, ##__VA_ARGS__)
 #define shell_error(sh, fmt, ...) shell_fprintf(sh, SHELL_ERROR, fmt, ##__VA_ARGS__)
 #define SHELL_CMD(...)
 #define SHELL_CMD_ARG(...)
+#define SHELL_COND_CMD(...)
 #define SHELL_SUBCMD_SET_END
 #define SHELL_STATIC_SUBCMD_SET_CREATE(...)
 #define SHELL_CMD_REGISTER(...)
@@ -107,7 +111,8 @@ LOG_MODULE_REGISTER(serviceManager, LOG_LEVEL_DBG);
   FAKE(serviceMngrUtilStopService) \
   FAKE(serviceMngrUtilSuspendService) \
   FAKE(serviceMngrUtilResumeService) \
-  FAKE(k_thread_name_get_mock)
+  FAKE(k_thread_name_get_mock) \
+  FAKE(k_uptime_get_mock)
 
 /* Include command implementation */
 #include "serviceManagerCmd.c"
@@ -194,6 +199,8 @@ ZTEST(serviceMngrCmd, test_ls_emptyRegistry)
                "header should contain 'Name'");
   zassert_true(strstr(captured_shell_outputs[0], "State") != NULL,
                "header should contain 'State'");
+  zassert_true(strstr(captured_shell_outputs[0], "Start(ms)") != NULL,
+               "header should contain 'Start(ms)'");
 }
 
 /**
@@ -234,6 +241,70 @@ ZTEST(serviceMngrCmd, test_ls_withServices)
                "third service line should contain state 'suspended'");
 }
 
+/**
+ * @test The execStats function must print the statistics of all registered services.
+ */
+ZTEST(serviceMngrCmd, test_stats_withServices)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"stats"};
+  int result;
+
+  ls_test_descriptors[0].stats.cpuLoad = 125;
+  ls_test_descriptors[0].stats.peakCpuLoad = 300;
+  ls_test_descriptors[0].stats.stackSize = 2048;
+  ls_test_descriptors[0].stats.stackUsed = 812;
+  ls_test_descriptors[0].stats.maxHeartbeatJitterMs = 17;
+  ls_test_descriptors[0].stats.suspendedMs = 400;
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withServices;
+  k_thread_name_get_mock_fake.return_val = "test_service";
+
+  result = execStats(shell, 1, argv);
+
+  zassert_equal(result, 0, "execStats should return 0");
+  zassert_equal(shell_print_call_count, 4,
+                "shell_print should be called 4 times (1 header + 3 services)");
+  zassert_true(strstr(captured_shell_outputs[0], "CPU(%)") != NULL,
+               "header should contain 'CPU(%)'");
+  zassert_true(strstr(captured_shell_outputs[1], " 12.5 ") != NULL,
+               "first service line should contain the CPU load");
+  zassert_true(strstr(captured_shell_outputs[1], " 30.0 ") != NULL,
+               "first service line should contain the peak CPU load");
+  zassert_true(strstr(captured_shell_outputs[1], "2048") != NULL,
+               "first service line should contain the stack size");
+  zassert_true(strstr(captured_shell_outputs[1], "812") != NULL,
+               "first service line should contain the used stack");
+  zassert_true(strstr(captured_shell_outputs[1], "17") != NULL,
+               "first service line should contain the heartbeat jitter");
+  zassert_true(strstr(captured_shell_outputs[1], "400") != NULL,
+               "first service line should contain the suspended time");
+  zassert_equal(k_uptime_get_mock_fake.call_count, 1,
+                "k_uptime_get should only be called for the suspended service");
+}
+
+/**
+ * @test The execStats function must include the ongoing suspension.
+ */
+ZTEST(serviceMngrCmd, test_stats_ongoingSuspension)
+{
+  const struct shell *shell = (const struct shell *)0x1234;
+  char *argv[] = {"stats"};
+
+  /* Service 2 is suspended since 1000 ms, after 250 ms of a previous suspension */
+  ls_test_descriptors[2].stats.suspendedMs = 250;
+  ls_test_descriptors[2].stats.suspendedSinceMs = 1000;
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withServices;
+  k_thread_name_get_mock_fake.return_val = "test_service";
+  k_uptime_get_mock_fake.return_val = 4000;
+
+  execStats(shell, 1, argv);
+
+  zassert_true(strstr(captured_shell_outputs[3], "3250") != NULL,
+               "suspended service line should include the ongoing suspension");
+}
+
 /* Custom fake for shell_strtoul that sets the error parameter */
 static unsigned long shell_strtoul_with_error(const char *str, int base, int *err)
 {
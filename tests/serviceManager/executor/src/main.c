@@ -0,0 +1,260 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Manager Executor Tests
+ *
+ *            Unit tests for the service manager shared executor.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Wrap functions to use mocks */
+#define k_work_queue_init k_work_queue_init_mock
+#define k_work_queue_start k_work_queue_start_mock
+#define k_work_queue_thread_get k_work_queue_thread_get_mock
+#define k_work_poll_init k_work_poll_init_mock
+#define k_work_poll_submit_to_queue k_work_poll_submit_to_queue_mock
+#define k_work_poll_cancel k_work_poll_cancel_mock
+#define k_poll_event_init k_poll_event_init_mock
+#define k_msgq_get k_msgq_get_mock
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_SERVICE_MANAGER 1
+#define CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL 3
+#define CONFIG_SVC_MGR_EXECUTOR 1
+#define CONFIG_SVC_MGR_EXECUTOR_STACK_SIZE 1024
+#define CONFIG_SVC_MGR_EXECUTOR_THREAD_PRIORITY 5
+#define CONFIG_SVC_MGR_EXECUTOR_BATCH_SIZE 2
+
+#include "serviceManager.h"
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(serviceManager, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Mock service manager functions */
+FAKE_VALUE_FUNC(int, serviceManagerUpdateHeartbeat, ServiceHandle_t);
+
+/* Mock kernel functions */
+FAKE_VOID_FUNC(k_work_queue_init_mock, struct k_work_q *);
+FAKE_VOID_FUNC(k_work_queue_start_mock, struct k_work_q *, k_thread_stack_t *, size_t, int,
+               const struct k_work_queue_config *);
+FAKE_VALUE_FUNC(k_tid_t, k_work_queue_thread_get_mock, struct k_work_q *);
+FAKE_VOID_FUNC(k_work_poll_init_mock, struct k_work_poll *, k_work_handler_t);
+FAKE_VALUE_FUNC(int, k_work_poll_submit_to_queue_mock, struct k_work_q *, struct k_work_poll *,
+                struct k_poll_event *, int, k_timeout_t);
+FAKE_VALUE_FUNC(int, k_work_poll_cancel_mock, struct k_work_poll *);
+FAKE_VOID_FUNC(k_poll_event_init_mock, struct k_poll_event *, uint32_t, int, void *);
+FAKE_VALUE_FUNC(int, k_msgq_get_mock, struct k_msgq *, void *, k_timeout_t);
+
+/* Mock message handler */
+FAKE_VOID_FUNC(testHandler, void *);
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(serviceManagerUpdateHeartbeat) \
+  FAKE(k_work_queue_init_mock) \
+  FAKE(k_work_queue_start_mock) \
+  FAKE(k_work_queue_thread_get_mock) \
+  FAKE(k_work_poll_init_mock) \
+  FAKE(k_work_poll_submit_to_queue_mock) \
+  FAKE(k_work_poll_cancel_mock) \
+  FAKE(k_poll_event_init_mock) \
+  FAKE(k_msgq_get_mock) \
+  FAKE(testHandler)
+
+#include "serviceManagerExecutor.c"
+
+#define TEST_SERVICE_HANDLE 3
+#define TEST_PERIOD_MS      500
+
+static struct k_msgq testQueue;
+static uint32_t testMsg;
+static ServiceExecutorTask_t testTask;
+
+/* The messages left in the test queue */
+static size_t queuedMsgs;
+
+/* Custom fake: reads the queued messages */
+static int msgqGet(struct k_msgq *queue, void *msg, k_timeout_t timeout)
+{
+  ARG_UNUSED(queue);
+  ARG_UNUSED(timeout);
+
+  if(queuedMsgs == 0)
+    return -ENOMSG;
+
+  *(uint32_t *)msg = queuedMsgs--;
+  return 0;
+}
+
+/* Custom fake: a handler stopping its task */
+static void stoppingHandler(void *msg)
+{
+  ARG_UNUSED(msg);
+
+  serviceManagerExecutorTaskStop(&testTask);
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void executor_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(&testTask, 0, sizeof(testTask));
+  queuedMsgs = 0;
+  k_msgq_get_mock_fake.custom_fake = msgqGet;
+
+  serviceManagerExecutorTaskInit(&testTask, &testQueue, &testMsg, testHandler, TEST_PERIOD_MS);
+  testTask.handle = TEST_SERVICE_HANDLE;
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  k_msgq_get_mock_fake.custom_fake = msgqGet;
+}
+
+/**
+ * @test serviceManagerExecutorInit must start the executor work queue.
+ */
+ZTEST(serviceMngrExecutor, test_init)
+{
+  zassert_equal(serviceManagerExecutorInit(), 0, "Expected success (0)");
+  zassert_equal(k_work_queue_init_mock_fake.call_count, 1, "The work queue should be initialized");
+  zassert_equal(k_work_queue_start_mock_fake.call_count, 1, "The work queue should be started");
+  zassert_equal(k_work_queue_start_mock_fake.arg3_val,
+                K_PRIO_PREEMPT(CONFIG_SVC_MGR_EXECUTOR_THREAD_PRIORITY),
+                "The work queue should run at the executor priority");
+}
+
+/**
+ * @test serviceManagerExecutorTaskInit must reject the invalid arguments.
+ */
+ZTEST(serviceMngrExecutor, test_taskInit_invalid)
+{
+  ServiceExecutorTask_t task;
+
+  zassert_equal(serviceManagerExecutorTaskInit(NULL, &testQueue, &testMsg, testHandler, 1), -EINVAL,
+                "NULL task should return -EINVAL");
+  zassert_equal(serviceManagerExecutorTaskInit(&task, NULL, &testMsg, testHandler, 1), -EINVAL,
+                "NULL queue should return -EINVAL");
+  zassert_equal(serviceManagerExecutorTaskInit(&task, &testQueue, NULL, testHandler, 1), -EINVAL,
+                "NULL message buffer should return -EINVAL");
+  zassert_equal(serviceManagerExecutorTaskInit(&task, &testQueue, &testMsg, NULL, 1), -EINVAL,
+                "NULL handler should return -EINVAL");
+  zassert_equal(serviceManagerExecutorTaskInit(&task, &testQueue, &testMsg, testHandler, 0), -EINVAL,
+                "A zero period should return -EINVAL");
+}
+
+/**
+ * @test serviceManagerExecutorTaskStart must wait on the task queue up to its period.
+ */
+ZTEST(serviceMngrExecutor, test_taskStart)
+{
+  zassert_equal(serviceManagerExecutorTaskStart(&testTask), 0, "Expected success (0)");
+  zassert_equal(k_poll_event_init_mock_fake.arg1_val, K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+                "The task should wait on its queue data");
+  zassert_equal(k_poll_event_init_mock_fake.arg3_val, &testQueue, "The task should wait on its queue");
+  zassert_equal(k_work_poll_submit_to_queue_mock_fake.arg0_val, &executorQueue,
+                "The task should be submitted to the executor");
+  zassert_equal(k_work_poll_submit_to_queue_mock_fake.arg4_val.ticks, K_MSEC(TEST_PERIOD_MS).ticks,
+                "The task should wait up to its period");
+}
+
+/**
+ * @test serviceManagerExecutorTaskStart must return error when the submission fails.
+ */
+ZTEST(serviceMngrExecutor, test_taskStart_submitFails)
+{
+  k_work_poll_submit_to_queue_mock_fake.return_val = -EBUSY;
+
+  zassert_equal(serviceManagerExecutorTaskStart(&testTask), -EBUSY, "Expected -EBUSY");
+  zassert_false(atomic_get(&testTask.isRunning), "The task should not be running");
+}
+
+/**
+ * @test A run must handle a bounded batch of messages, heartbeat and resubmit the task.
+ */
+ZTEST(serviceMngrExecutor, test_run_batch)
+{
+  serviceManagerExecutorTaskStart(&testTask);
+  queuedMsgs = 3;
+
+  runTask(&testTask.work.work);
+
+  zassert_equal(testHandler_fake.call_count, CONFIG_SVC_MGR_EXECUTOR_BATCH_SIZE,
+                "A batch of messages should be handled");
+  zassert_equal(testHandler_fake.arg0_val, &testMsg, "The handler should get the message buffer");
+  zassert_equal(queuedMsgs, 1, "The messages past the batch should be left queued");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, 1, "The run should heartbeat");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.arg0_val, TEST_SERVICE_HANDLE,
+                "The run should heartbeat for the task service");
+  zassert_equal(k_work_poll_submit_to_queue_mock_fake.call_count, 2, "The task should be resubmitted");
+}
+
+/**
+ * @test A run on the period timeout must heartbeat without any message.
+ */
+ZTEST(serviceMngrExecutor, test_run_timeout)
+{
+  serviceManagerExecutorTaskStart(&testTask);
+
+  runTask(&testTask.work.work);
+
+  zassert_equal(testHandler_fake.call_count, 0, "No message should be handled");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, 1, "The run should heartbeat");
+  zassert_equal(k_work_poll_submit_to_queue_mock_fake.call_count, 2, "The task should be resubmitted");
+}
+
+/**
+ * @test A stopped task must not run nor be resubmitted.
+ */
+ZTEST(serviceMngrExecutor, test_run_stopped)
+{
+  serviceManagerExecutorTaskStart(&testTask);
+  serviceManagerExecutorTaskStop(&testTask);
+  queuedMsgs = 1;
+
+  zassert_equal(k_work_poll_cancel_mock_fake.call_count, 1, "The pending task should be canceled");
+
+  runTask(&testTask.work.work);
+
+  zassert_equal(testHandler_fake.call_count, 0, "No message should be handled");
+  zassert_equal(queuedMsgs, 1, "The queued messages should be kept");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, 0, "A stopped task should not heartbeat");
+  zassert_equal(k_work_poll_submit_to_queue_mock_fake.call_count, 1,
+                "A stopped task should not be resubmitted");
+}
+
+/**
+ * @test A handler stopping its task must end the run without resubmitting.
+ */
+ZTEST(serviceMngrExecutor, test_run_stopFromHandler)
+{
+  testTask.handler = stoppingHandler;
+  serviceManagerExecutorTaskStart(&testTask);
+  queuedMsgs = 2;
+
+  runTask(&testTask.work.work);
+
+  zassert_equal(queuedMsgs, 1, "The messages after the stop should be left queued");
+  zassert_equal(serviceManagerUpdateHeartbeat_fake.call_count, 1, "The completed run should heartbeat");
+  zassert_equal(k_work_poll_submit_to_queue_mock_fake.call_count, 1,
+                "A stopped task should not be resubmitted");
+}
+
+ZTEST_SUITE(serviceMngrExecutor, NULL, NULL, executor_tests_before, NULL, NULL);
@@ -24,7 +24,8 @@ DEFINE_FFF_GLOBALS;
 /* Mock Kconfig options */
 #define CONFIG_ENYA_SERVICE_MANAGER 1
 #define CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL 3
-#define CONFIG_SVC_MGR_LOOP_PERIOD_MS 100
+#define CONFIG_SVC_MGR_WDT_TIMEOUT_MS 5000
+#define CONFIG_SVC_MGR_START_TIMEOUT_MS 10000
 #define CONFIG_ENYA_SERVICE_MANAGER_STACK_SIZE 2048
 #define CONFIG_SVC_MGR_MAX_SERVICES 16
 #define CONFIG_ENYA_SERVICE_MANAGER_THREAD_PRIORITY 1
@@ -41,10 +42,13 @@ FAKE_VALUE_FUNC(int, serviceMngrUtilStartService, size_t);
 FAKE_VALUE_FUNC(int, serviceMngrUtilUpdateSrvHeartbeat, size_t);
 FAKE_VALUE_FUNC(ServiceDescriptor_t *, serviceMngrUtilGetRegEntryByIndex, size_t);
 FAKE_VALUE_FUNC(int, serviceMngrUtilCheckSrvHeartbeat, size_t);
+FAKE_VALUE_FUNC(int64_t, serviceMngrUtilGetNextHeartbeatDeadline);
+FAKE_VALUE_FUNC(bool, serviceMngrUtilAreSrvsRunning, uint64_t);
 FAKE_VALUE_FUNC(int, serviceMngrUtilFeedHardWdg);
 FAKE_VALUE_FUNC(int, serviceMngrUtilStopService, size_t);
 FAKE_VALUE_FUNC(int, serviceMngrUtilSuspendService, size_t);
 FAKE_VALUE_FUNC(int, serviceMngrUtilResumeService, size_t);
+FAKE_VALUE_FUNC(int, serviceMngrUtilRecoverService, size_t);
 FAKE_VALUE_FUNC(int, serviceMngrUtilSetSrvState, size_t, ServiceState_t);
 
 /* Mock kernel functions */
@@ -53,12 +57,20 @@ FAKE_VALUE_FUNC(int, serviceMngrUtilSetSrvState, size_t, ServiceState_t);
 #define k_thread_name_get k_thread_name_get_mock
 #define k_msgq_put k_msgq_put_mock
 #define k_msgq_get k_msgq_get_mock
+#define k_uptime_get k_uptime_get_mock
+#define k_sem_take k_sem_take_mock
+#define k_sem_give k_sem_give_mock
+#define k_sem_reset k_sem_reset_mock
 FAKE_VALUE_FUNC(k_tid_t, k_thread_create_mock, struct k_thread *, k_thread_stack_t *,
                 size_t, k_thread_entry_t, void *, void *, void *, int, uint32_t, k_timeout_t);
 FAKE_VALUE_FUNC(int, k_thread_name_set_mock, k_tid_t, const char *);
 FAKE_VALUE_FUNC(const char *, k_thread_name_get_mock, k_tid_t);
 FAKE_VALUE_FUNC(int, k_msgq_put_mock, struct k_msgq *, const void *, k_timeout_t);
 FAKE_VALUE_FUNC(int, k_msgq_get_mock, struct k_msgq *, void *, k_timeout_t);
+FAKE_VALUE_FUNC(int64_t, k_uptime_get_mock);
+FAKE_VALUE_FUNC(int, k_sem_take_mock, struct k_sem *, k_timeout_t);
+FAKE_VOID_FUNC(k_sem_give_mock, struct k_sem *);
+FAKE_VOID_FUNC(k_sem_reset_mock, struct k_sem *);
 
 /* FFF fakes list */
 #define FFF_FAKES_LIST(FAKE) \
@@ -70,16 +82,23 @@ FAKE_VALUE_FUNC(int, k_msgq_get_mock, struct k_msgq *, void *, k_timeout_t);
   FAKE(serviceMngrUtilUpdateSrvHeartbeat) \
   FAKE(serviceMngrUtilGetRegEntryByIndex) \
   FAKE(serviceMngrUtilCheckSrvHeartbeat) \
+  FAKE(serviceMngrUtilGetNextHeartbeatDeadline) \
+  FAKE(serviceMngrUtilAreSrvsRunning) \
   FAKE(serviceMngrUtilFeedHardWdg) \
   FAKE(serviceMngrUtilStopService) \
   FAKE(serviceMngrUtilSuspendService) \
   FAKE(serviceMngrUtilResumeService) \
+  FAKE(serviceMngrUtilRecoverService) \
   FAKE(serviceMngrUtilSetSrvState) \
   FAKE(k_thread_create_mock) \
   FAKE(k_thread_name_set_mock) \
   FAKE(k_thread_name_get_mock) \
   FAKE(k_msgq_put_mock) \
-  FAKE(k_msgq_get_mock)
+  FAKE(k_msgq_get_mock) \
+  FAKE(k_uptime_get_mock) \
+  FAKE(k_sem_take_mock) \
+  FAKE(k_sem_give_mock) \
+  FAKE(k_sem_reset_mock)
 
 #include "serviceManager.c"
 
@@ -88,10 +107,13 @@ static ServiceMgrMsg_t test_queue_messages[4];
 static size_t test_queue_msg_count = 0;
 static size_t test_queue_msg_read = 0;
 
+static k_timeout_t test_queue_timeout;
+
 static int k_msgq_get_from_test_queue(struct k_msgq *q, void *data, k_timeout_t timeout)
 {
   ARG_UNUSED(q);
-  ARG_UNUSED(timeout);
+
+  test_queue_timeout = timeout;
 
   if(test_queue_msg_read < test_queue_msg_count)
   {
@@ -101,6 +123,17 @@ static int k_msgq_get_from_test_queue(struct k_msgq *q, void *data, k_timeout_t
   return -EAGAIN;
 }
 
+static ServiceMgrMsg_t capturedMsg;
+
+static int k_msgq_put_capture(struct k_msgq *q, const void *data, k_timeout_t timeout)
+{
+  ARG_UNUSED(q);
+  ARG_UNUSED(timeout);
+
+  memcpy(&capturedMsg, data, sizeof(ServiceMgrMsg_t));
+  return 0;
+}
+
 /**
  * @brief Setup function called before all tests in the suite.
  */
@@ -122,7 +155,17 @@ static void service_tests_before(void *fixture)
   memset(test_queue_messages, 0, sizeof(test_queue_messages));
   test_queue_msg_count = 0;
   test_queue_msg_read = 0;
+  test_queue_timeout = K_FOREVER;
   k_msgq_get_mock_fake.custom_fake = k_msgq_get_from_test_queue;
+
+  /* No heartbeat due by default */
+  serviceMngrUtilGetNextHeartbeatDeadline_fake.return_val = INT64_MAX;
+
+  /* Dependencies running by default */
+  serviceMngrUtilAreSrvsRunning_fake.return_val = true;
+
+  /* SoC reset recovery policy by default */
+  serviceMngrUtilRecoverService_fake.return_val = -ENOTSUP;
 }
 
 /* Test descriptors for run tests */
@@ -185,12 +228,39 @@ ZTEST(serviceManager, test_run_heartbeatTimeout)
                 "serviceMngrUtilCheckSrvHeartbeat should be called for each service");
   zassert_equal(serviceMngrUtilCheckSrvHeartbeat_fake.arg0_val, 1,
                 "serviceMngrUtilCheckSrvHeartbeat last call should use index 1");
-  zassert_equal(k_thread_name_get_mock_fake.call_count, 2,
-                "k_thread_name_get should be called for each timed-out service");
+  zassert_equal(serviceMngrUtilRecoverService_fake.call_count, 2,
+                "serviceMngrUtilRecoverService should be called for each timed-out service");
+  zassert_equal(k_thread_name_get_mock_fake.call_count, 4,
+                "k_thread_name_get should be called twice for each timed-out service not recovered");
   zassert_equal(serviceMngrUtilFeedHardWdg_fake.call_count, 0,
                 "serviceMngrUtilFeedHardWdg should not be called on heartbeat timeout");
 }
 
+/**
+ * @test The serviceManagerRun function must feed the watchdog when the timed-out services are recovered.
+ */
+ZTEST(serviceManager, test_run_heartbeatTimeoutRecovered)
+{
+  int checkResults[] = {-ETIMEDOUT, 0};
+
+  run_test_descriptors[0].threadId = (k_tid_t)0x1000;
+  run_test_descriptors[1].threadId = (k_tid_t)0x2000;
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withTwoServices;
+  SET_RETURN_SEQ(serviceMngrUtilCheckSrvHeartbeat, checkResults, ARRAY_SIZE(checkResults));
+  serviceMngrUtilRecoverService_fake.return_val = 0;
+  k_thread_name_get_mock_fake.return_val = "test_service";
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(serviceMngrUtilRecoverService_fake.call_count, 1,
+                "serviceMngrUtilRecoverService should only be called for the timed-out service");
+  zassert_equal(serviceMngrUtilRecoverService_fake.arg0_val, 0,
+                "serviceMngrUtilRecoverService should use the timed-out service index");
+  zassert_equal(serviceMngrUtilFeedHardWdg_fake.call_count, 1,
+                "serviceMngrUtilFeedHardWdg should be called once the service is recovered");
+}
+
 /**
  * @test The serviceManagerRun function must feed the watchdog when all services are healthy.
  */
@@ -215,6 +285,56 @@ ZTEST(serviceManager, test_run_allHealthy)
                 "serviceMngrUtilFeedHardWdg should be called once");
 }
 
+/**
+ * @test The run function must sleep until the next watchdog feed when no heartbeat is due earlier.
+ */
+ZTEST(serviceManager, test_run_sleepUntilFeed)
+{
+  /* Feed due at 1000 (thread start), now 500 */
+  int64_t uptimes[] = {1000, 500, 500};
+
+  SET_RETURN_SEQ(k_uptime_get_mock, uptimes, ARRAY_SIZE(uptimes));
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(test_queue_timeout.ticks, K_MSEC(500).ticks,
+                "run should sleep until the next watchdog feed");
+  zassert_equal(serviceMngrUtilFeedHardWdg_fake.call_count, 0,
+                "serviceMngrUtilFeedHardWdg should not be called before the feed is due");
+}
+
+/**
+ * @test The run function must sleep until the next heartbeat deadline when it is due first.
+ */
+ZTEST(serviceManager, test_run_sleepUntilHeartbeatDeadline)
+{
+  int64_t uptimes[] = {1000, 500, 500};
+
+  SET_RETURN_SEQ(k_uptime_get_mock, uptimes, ARRAY_SIZE(uptimes));
+  serviceMngrUtilGetNextHeartbeatDeadline_fake.return_val = 700;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(test_queue_timeout.ticks, K_MSEC(200).ticks,
+                "run should sleep until the next heartbeat deadline");
+}
+
+/**
+ * @test The run function must not sleep when a heartbeat deadline has already passed.
+ */
+ZTEST(serviceManager, test_run_deadlinePassed)
+{
+  int64_t uptimes[] = {5000, 3000, 3000};
+
+  SET_RETURN_SEQ(k_uptime_get_mock, uptimes, ARRAY_SIZE(uptimes));
+  serviceMngrUtilGetNextHeartbeatDeadline_fake.return_val = 2000;
+
+  run(NULL, NULL, NULL);
+
+  zassert_equal(test_queue_timeout.ticks, K_NO_WAIT.ticks,
+                "run should not sleep past a passed heartbeat deadline");
+}
+
 /**
  * @test The run function must continue when processing a start message fails.
  */
@@ -463,12 +583,30 @@ ZTEST(serviceManager, test_init_success)
                 "k_thread_name_set should be called with 'serviceManager'");
 }
 
+/**
+ * @test The serviceManagerRegisterSrv function must return error when the handle pointer is NULL.
+ */
+ZTEST(serviceManager, test_registerSrv_nullHandle)
+{
+  int result;
+  ServiceDescriptor_t descriptor;
+
+  /* Execute */
+  result = serviceManagerRegisterSrv(&descriptor, NULL);
+
+  /* Verify */
+  zassert_equal(result, -EINVAL, "Expected -EINVAL when the handle is NULL");
+  zassert_equal(serviceMngrUtilAddSrvToRegistry_fake.call_count, 0,
+                "serviceMngrUtilAddSrvToRegistry should not be called");
+}
+
 /**
  * @test The serviceManagerRegisterSrv function must return error when registration fails.
  */
 ZTEST(serviceManager, test_registerSrv_fails)
 {
   int result;
+  ServiceHandle_t handle = 7;
   ServiceDescriptor_t descriptor;
 
   /* Setup: registration fails */
@@ -481,7 +619,7 @@ ZTEST(serviceManager, test_registerSrv_fails)
   descriptor.missedHeartbeats = 0;
 
   /* Execute */
-  result = serviceManagerRegisterSrv(&descriptor);
+  result = serviceManagerRegisterSrv(&descriptor, &handle);
 
   /* Verify */
   zassert_equal(result, -EINVAL, "Expected -EINVAL when registration fails");
@@ -489,18 +627,20 @@ ZTEST(serviceManager, test_registerSrv_fails)
                 "serviceMngrUtilAddSrvToRegistry should be called once");
   zassert_equal(serviceMngrUtilAddSrvToRegistry_fake.arg0_val, &descriptor,
                 "serviceMngrUtilAddSrvToRegistry should be called with descriptor");
+  zassert_equal(handle, 7, "The handle should be left untouched on failure");
 }
 
 /**
- * @test The serviceManagerRegisterSrv function must successfully register service.
+ * @test The serviceManagerRegisterSrv function must successfully register service and return its handle.
  */
 ZTEST(serviceManager, test_registerSrv_success)
 {
   int result;
+  ServiceHandle_t handle = 0;
   ServiceDescriptor_t descriptor;
 
-  /* Setup: registration succeeds */
-  serviceMngrUtilAddSrvToRegistry_fake.return_val = 0;
+  /* Setup: registration succeeds at index 4 */
+  serviceMngrUtilAddSrvToRegistry_fake.return_val = 4;
 
   /* Setup descriptor */
   descriptor.threadId = (k_tid_t)0x1000;
@@ -509,7 +649,7 @@ ZTEST(serviceManager, test_registerSrv_success)
   descriptor.missedHeartbeats = 0;
 
   /* Execute */
-  result = serviceManagerRegisterSrv(&descriptor);
+  result = serviceManagerRegisterSrv(&descriptor, &handle);
 
   /* Verify */
   zassert_equal(result, 0, "Expected success (0)");
@@ -517,6 +657,7 @@ ZTEST(serviceManager, test_registerSrv_success)
                 "serviceMngrUtilAddSrvToRegistry should be called once");
   zassert_equal(serviceMngrUtilAddSrvToRegistry_fake.arg0_val, &descriptor,
                 "serviceMngrUtilAddSrvToRegistry should be called with descriptor");
+  zassert_equal(handle, 4, "The handle should be the registry index");
 }
 
 /* Test descriptors for startAll tests */
@@ -537,6 +678,7 @@ ZTEST(serviceManager, test_startAll_startFails)
 {
   int result;
 
+  memset(startAll_test_descriptors, 0, sizeof(startAll_test_descriptors));
   startAll_test_descriptors[0].threadId = (k_tid_t)0x1000;
   startAll_test_descriptors[0].priority = SVC_PRIORITY_CRITICAL;
 
@@ -548,10 +690,228 @@ ZTEST(serviceManager, test_startAll_startFails)
 
   zassert_equal(result, -EINVAL,
                 "serviceManagerStartAll should return error when a service fails to start");
-  zassert_equal(serviceMngrUtilStartService_fake.call_count, 1,
-                "serviceMngrUtilStartService should be called once before failing");
-  zassert_equal(k_thread_name_get_mock_fake.call_count, 1,
-                "k_thread_name_get should be called once for the failed service");
+  zassert_equal(serviceMngrUtilStartService_fake.call_count, 3,
+                "serviceMngrUtilStartService should still be called for the independent services");
+  zassert_equal(k_thread_name_get_mock_fake.call_count, 3,
+                "k_thread_name_get should be called once per failed service");
+}
+
+/**
+ * @test The serviceManagerStartAll function must start the independent services after a failure.
+ */
+ZTEST(serviceManager, test_startAll_continuesAfterFailure)
+{
+  int result;
+  int startResults[] = {-EIO, 0, 0};
+
+  memset(startAll_test_descriptors, 0, sizeof(startAll_test_descriptors));
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withMixedPriorities;
+  SET_RETURN_SEQ(serviceMngrUtilStartService, startResults, ARRAY_SIZE(startResults));
+  k_thread_name_get_mock_fake.return_val = "test_service";
+
+  result = serviceManagerStartAll();
+
+  zassert_equal(result, -EIO, "serviceManagerStartAll should return the first error");
+  zassert_equal(serviceMngrUtilStartService_fake.call_count, 3,
+                "serviceMngrUtilStartService should be called once per service");
+}
+
+/**
+ * @test The serviceManagerStartAll function must skip the dependents of a failed service.
+ */
+ZTEST(serviceManager, test_startAll_dependencyFailed)
+{
+  int result;
+
+  /* Service 1 depends on service 0, which fails */
+  memset(startAll_test_descriptors, 0, sizeof(startAll_test_descriptors));
+  startAll_test_descriptors[1].dependencies = BIT64(0);
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withMixedPriorities;
+  serviceMngrUtilStartService_fake.return_val = -EIO;
+  k_thread_name_get_mock_fake.return_val = "test_service";
+
+  result = serviceManagerStartAll();
+
+  zassert_equal(result, -EIO, "serviceManagerStartAll should return the first error");
+  zassert_equal(serviceMngrUtilStartService_fake.call_count, 2,
+                "serviceMngrUtilStartService should not be called for the dependent");
+  zassert_equal(serviceMngrUtilStartService_fake.arg0_history[0], 0,
+                "the dependency should be started first");
+  zassert_equal(serviceMngrUtilStartService_fake.arg0_history[1], 2,
+                "the independent service should be started");
+}
+
+/* Custom fake: dependencies are running once a confirmation was waited on */
+static bool areSrvsRunning_afterConfirm(uint64_t handles)
+{
+  return handles == 0 || k_sem_take_mock_fake.call_count > 0;
+}
+
+/**
+ * @test The serviceManagerStartAll function must wait on a running confirmation only for the dependents.
+ */
+ZTEST(serviceManager, test_startAll_waitsOnDependency)
+{
+  int result;
+
+  /* Service 0 depends on service 1, services 1 and 2 are independent */
+  memset(startAll_test_descriptors, 0, sizeof(startAll_test_descriptors));
+  startAll_test_descriptors[0].dependencies = BIT64(1);
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withMixedPriorities;
+  serviceMngrUtilAreSrvsRunning_fake.custom_fake = areSrvsRunning_afterConfirm;
+  serviceMngrUtilStartService_fake.return_val = 0;
+
+  result = serviceManagerStartAll();
+
+  zassert_equal(result, 0, "serviceManagerStartAll should return 0 on success");
+  zassert_equal(serviceMngrUtilStartService_fake.call_count, 3,
+                "serviceMngrUtilStartService should be called once per service");
+  zassert_equal(serviceMngrUtilStartService_fake.arg0_history[0], 1,
+                "the first independent service should be started first");
+  zassert_equal(serviceMngrUtilStartService_fake.arg0_history[1], 2,
+                "the second independent service should be started without waiting");
+  zassert_equal(serviceMngrUtilStartService_fake.arg0_history[2], 0,
+                "the dependent should be started after the confirmation");
+  zassert_equal(k_sem_take_mock_fake.call_count, 1,
+                "a single running confirmation should be waited on");
+  zassert_equal(k_sem_take_mock_fake.arg1_val.ticks, K_MSEC(CONFIG_SVC_MGR_START_TIMEOUT_MS).ticks,
+                "the confirmation should be waited on up to the start timeout");
+}
+
+/* The registry state of the services, as confirmed */
+static ServiceState_t startAll_test_states[3];
+
+/* Custom fake: records the confirmed state of a service */
+static int setSrvState_record(size_t index, ServiceState_t state)
+{
+  startAll_test_states[index] = state;
+  return 0;
+}
+
+/* Custom fake: the services are running once they confirmed it */
+static bool areSrvsRunning_fromStates(uint64_t handles)
+{
+  for(size_t i = 0; i < ARRAY_SIZE(startAll_test_states); ++i)
+  {
+    if((handles & BIT64(i)) && startAll_test_states[i] != SVC_STATE_RUNNING)
+      return false;
+  }
+
+  return true;
+}
+
+/* Custom fake: the datastore thread confirms running once its NVM restore is done */
+static int semTake_datastoreRestored(struct k_sem *sem, k_timeout_t timeout)
+{
+  ARG_UNUSED(sem);
+  ARG_UNUSED(timeout);
+
+  return serviceManagerConfirmState(0, SVC_STATE_RUNNING);
+}
+
+/**
+ * @test The serviceManagerStartAll function must start a service depending on the datastore once
+ *       the datastore confirmed running, after its NVM restore.
+ */
+ZTEST(serviceManager, test_startAll_waitsOnDatastoreRestore)
+{
+  int result;
+
+  /* Service 0 is the datastore, service 1 depends on it, service 2 is independent */
+  memset(startAll_test_descriptors, 0, sizeof(startAll_test_descriptors));
+  memset(startAll_test_states, 0, sizeof(startAll_test_states));
+  startAll_test_descriptors[0].priority = SVC_PRIORITY_CORE;
+  startAll_test_descriptors[1].priority = SVC_PRIORITY_APPLICATION;
+  startAll_test_descriptors[1].dependencies = BIT64(0);
+  startAll_test_descriptors[2].priority = SVC_PRIORITY_APPLICATION;
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withMixedPriorities;
+  serviceMngrUtilSetSrvState_fake.custom_fake = setSrvState_record;
+  serviceMngrUtilAreSrvsRunning_fake.custom_fake = areSrvsRunning_fromStates;
+  k_sem_take_mock_fake.custom_fake = semTake_datastoreRestored;
+
+  result = serviceManagerStartAll();
+
+  zassert_equal(result, 0, "serviceManagerStartAll should return 0 once the datastore confirmed running");
+  zassert_equal(serviceMngrUtilStartService_fake.call_count, 3,
+                "serviceMngrUtilStartService should be called once per service");
+  zassert_equal(serviceMngrUtilStartService_fake.arg0_history[0], 0, "the datastore should be started first");
+  zassert_equal(serviceMngrUtilStartService_fake.arg0_history[1], 2,
+                "the independent service should be started without waiting");
+  zassert_equal(serviceMngrUtilStartService_fake.arg0_history[2], 1,
+                "the dependent should be started after the datastore confirmation");
+  zassert_equal(k_sem_take_mock_fake.call_count, 1, "the datastore confirmation should be waited on");
+  zassert_equal(k_sem_give_mock_fake.call_count, 1, "the datastore confirmation should wake up the start");
+}
+
+/* The semaphore resets done before the first service start */
+static unsigned int startAll_test_resetsBeforeStart;
+
+/* Custom fake: records the semaphore resets done before the first start */
+static int startService_recordReset(size_t index)
+{
+  ARG_UNUSED(index);
+
+  if(serviceMngrUtilStartService_fake.call_count == 1)
+    startAll_test_resetsBeforeStart = k_sem_reset_mock_fake.call_count;
+
+  return 0;
+}
+
+/**
+ * @test The serviceManagerStartAll function must drop the running confirmations given before it,
+ *       by an earlier resume or restart, before starting the services.
+ */
+ZTEST(serviceManager, test_startAll_dropsStaleConfirmations)
+{
+  int result;
+
+  memset(startAll_test_descriptors, 0, sizeof(startAll_test_descriptors));
+  startAll_test_descriptors[2].dependencies = BIT64(0);
+  startAll_test_resetsBeforeStart = 0;
+
+  /* A resumed service confirmed running before the start */
+  zassert_equal(serviceManagerConfirmState(1, SVC_STATE_RUNNING), 0, "the confirmation should succeed");
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withMixedPriorities;
+  serviceMngrUtilAreSrvsRunning_fake.custom_fake = areSrvsRunning_afterConfirm;
+  serviceMngrUtilStartService_fake.custom_fake = startService_recordReset;
+
+  result = serviceManagerStartAll();
+
+  zassert_equal(result, 0, "serviceManagerStartAll should return 0 on success");
+  zassert_equal(k_sem_reset_mock_fake.call_count, 1, "the confirmations should be reset once");
+  zassert_equal(k_sem_reset_mock_fake.arg0_val, &runningConfirmSem,
+                "the running confirmation semaphore should be reset");
+  zassert_equal(startAll_test_resetsBeforeStart, 1,
+                "the confirmations should be reset before the first service start");
+}
+
+/**
+ * @test The serviceManagerStartAll function must return error when a dependency never confirms running.
+ */
+ZTEST(serviceManager, test_startAll_dependencyTimeout)
+{
+  int result;
+
+  memset(startAll_test_descriptors, 0, sizeof(startAll_test_descriptors));
+  startAll_test_descriptors[2].dependencies = BIT64(0);
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withMixedPriorities;
+  serviceMngrUtilAreSrvsRunning_fake.custom_fake = areSrvsRunning_afterConfirm;
+  serviceMngrUtilStartService_fake.return_val = 0;
+  k_sem_take_mock_fake.return_val = -EAGAIN;
+  k_thread_name_get_mock_fake.return_val = "test_service";
+
+  result = serviceManagerStartAll();
+
+  zassert_equal(result, -ETIMEDOUT,
+                "serviceManagerStartAll should return -ETIMEDOUT when a dependency does not confirm");
+  zassert_equal(serviceMngrUtilStartService_fake.call_count, 2,
+                "serviceMngrUtilStartService should not be called for the waiting dependent");
 }
 
 /**
@@ -562,6 +922,7 @@ ZTEST(serviceManager, test_startAll_success)
   int result;
 
   /* Setup descriptors with mixed priorities: APPLICATION, CRITICAL, CORE */
+  memset(startAll_test_descriptors, 0, sizeof(startAll_test_descriptors));
   startAll_test_descriptors[0].threadId = (k_tid_t)0x1000;
   startAll_test_descriptors[0].priority = SVC_PRIORITY_APPLICATION;
   startAll_test_descriptors[1].threadId = (k_tid_t)0x2000;
@@ -760,26 +1121,132 @@ ZTEST(serviceManager, test_requestResume_success)
 }
 
 /**
- * @test The serviceManagerConfirmState function must return error when the thread ID is not found.
+ * @test The serviceManagerRequestStartByHandle function must return error when the handle is unknown.
  */
-ZTEST(serviceManager, test_confirmState_threadNotFound)
+ZTEST(serviceManager, test_requestStartByHandle_invalidHandle)
 {
-  int result;
+  serviceMngrUtilGetRegEntryByIndex_fake.return_val = NULL;
 
-  /* Setup: thread ID not found */
-  serviceMngrUtilGetIndexFromId_fake.return_val = -ENOENT;
+  zassert_equal(serviceManagerRequestStartByHandle(3), -EINVAL,
+                "Expected -EINVAL when the handle is unknown");
+  zassert_equal(k_msgq_put_mock_fake.call_count, 0,
+                "k_msgq_put should not be called");
+}
 
-  /* Execute */
-  result = serviceManagerConfirmState((k_tid_t)0x1000, SVC_STATE_STOPPED);
+/**
+ * @test The serviceManagerRequestStartByHandle function must return error when the queue is full.
+ */
+ZTEST(serviceManager, test_requestStartByHandle_queueFull)
+{
+  ServiceDescriptor_t descriptor = {0};
 
-  /* Verify */
-  zassert_equal(result, -ENOENT, "Expected -ENOENT when thread ID not found");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 1,
-                "serviceMngrUtilGetIndexFromId should be called once");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.arg0_val, (k_tid_t)0x1000,
-                "serviceMngrUtilGetIndexFromId should be called with the thread ID");
-  zassert_equal(serviceMngrUtilSetSrvState_fake.call_count, 0,
-                "serviceMngrUtilSetSrvState should not be called when thread not found");
+  serviceMngrUtilGetRegEntryByIndex_fake.return_val = &descriptor;
+  k_msgq_put_mock_fake.return_val = -ENOMEM;
+
+  zassert_equal(serviceManagerRequestStartByHandle(3), -ENOMEM,
+                "Expected -ENOMEM when queue is full");
+  zassert_equal(k_msgq_put_mock_fake.call_count, 1,
+                "k_msgq_put should be called once");
+}
+
+/**
+ * @test The serviceManagerRequestStartByHandle function must enqueue a start message for the handle,
+ *       without looking up a thread ID.
+ */
+ZTEST(serviceManager, test_requestStartByHandle_success)
+{
+  ServiceDescriptor_t descriptor = {0};
+
+  serviceMngrUtilGetRegEntryByIndex_fake.return_val = &descriptor;
+  k_msgq_put_mock_fake.custom_fake = k_msgq_put_capture;
+
+  zassert_equal(serviceManagerRequestStartByHandle(3), 0,
+                "Expected success");
+  zassert_equal(serviceMngrUtilGetRegEntryByIndex_fake.arg0_val, 3,
+                "serviceMngrUtilGetRegEntryByIndex should be called with the handle");
+  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 0,
+                "serviceMngrUtilGetIndexFromId should not be called");
+  zassert_equal(k_msgq_put_mock_fake.call_count, 1,
+                "k_msgq_put should be called once");
+  zassert_equal(capturedMsg.type, SVC_MGR_MSG_START,
+                "The message should be a start request");
+  zassert_equal(capturedMsg.index, 3,
+                "The message should target the handle");
+}
+
+/**
+ * @test The serviceManagerRequestStopByHandle function must enqueue a stop message for the handle,
+ *       without looking up a thread ID.
+ */
+ZTEST(serviceManager, test_requestStopByHandle_success)
+{
+  ServiceDescriptor_t descriptor = {0};
+
+  serviceMngrUtilGetRegEntryByIndex_fake.return_val = &descriptor;
+  k_msgq_put_mock_fake.custom_fake = k_msgq_put_capture;
+
+  zassert_equal(serviceManagerRequestStopByHandle(3), 0,
+                "Expected success");
+  zassert_equal(serviceMngrUtilGetRegEntryByIndex_fake.arg0_val, 3,
+                "serviceMngrUtilGetRegEntryByIndex should be called with the handle");
+  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 0,
+                "serviceMngrUtilGetIndexFromId should not be called");
+  zassert_equal(k_msgq_put_mock_fake.call_count, 1,
+                "k_msgq_put should be called once");
+  zassert_equal(capturedMsg.type, SVC_MGR_MSG_STOP,
+                "The message should be a stop request");
+  zassert_equal(capturedMsg.index, 3,
+                "The message should target the handle");
+}
+
+/**
+ * @test The serviceManagerRequestSuspendByHandle function must enqueue a suspend message for the handle,
+ *       without looking up a thread ID.
+ */
+ZTEST(serviceManager, test_requestSuspendByHandle_success)
+{
+  ServiceDescriptor_t descriptor = {0};
+
+  serviceMngrUtilGetRegEntryByIndex_fake.return_val = &descriptor;
+  k_msgq_put_mock_fake.custom_fake = k_msgq_put_capture;
+
+  zassert_equal(serviceManagerRequestSuspendByHandle(3), 0,
+                "Expected success");
+  zassert_equal(serviceMngrUtilGetRegEntryByIndex_fake.arg0_val, 3,
+                "serviceMngrUtilGetRegEntryByIndex should be called with the handle");
+  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 0,
+                "serviceMngrUtilGetIndexFromId should not be called");
+  zassert_equal(k_msgq_put_mock_fake.call_count, 1,
+                "k_msgq_put should be called once");
+  zassert_equal(capturedMsg.type, SVC_MGR_MSG_SUSPEND,
+                "The message should be a suspend request");
+  zassert_equal(capturedMsg.index, 3,
+                "The message should target the handle");
+}
+
+/**
+ * @test The serviceManagerRequestResumeByHandle function must enqueue a resume message for the handle,
+ *       without looking up a thread ID.
+ */
+ZTEST(serviceManager, test_requestResumeByHandle_success)
+{
+  ServiceDescriptor_t descriptor = {0};
+
+  serviceMngrUtilGetRegEntryByIndex_fake.return_val = &descriptor;
+  k_msgq_put_mock_fake.custom_fake = k_msgq_put_capture;
+
+  zassert_equal(serviceManagerRequestResumeByHandle(3), 0,
+                "Expected success");
+  zassert_equal(serviceMngrUtilGetRegEntryByIndex_fake.arg0_val, 3,
+                "serviceMngrUtilGetRegEntryByIndex should be called with the handle");
+  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 0,
+                "serviceMngrUtilGetIndexFromId should not be called");
+  zassert_equal(k_msgq_put_mock_fake.call_count, 1,
+                "k_msgq_put should be called once");
+  zassert_equal(capturedMsg.type, SVC_MGR_MSG_RESUME,
+                "The message should be a resume request");
+  zassert_equal(capturedMsg.index, 3,
+                "The message should target the handle");
 }
 
 /**
@@ -789,70 +1256,59 @@ ZTEST(serviceManager, test_confirmState_setStateFails)
 {
   int result;
 
-  /* Setup: thread found, set state fails */
-  serviceMngrUtilGetIndexFromId_fake.return_val = 3;
+  /* Setup: set state fails */
   serviceMngrUtilSetSrvState_fake.return_val = -EINVAL;
 
   /* Execute */
-  result = serviceManagerConfirmState((k_tid_t)0x1000, SVC_STATE_STOPPED);
+  result = serviceManagerConfirmState(3, SVC_STATE_STOPPED);
 
   /* Verify */
   zassert_equal(result, -EINVAL, "Expected -EINVAL when set state fails");
   zassert_equal(serviceMngrUtilSetSrvState_fake.call_count, 1,
                 "serviceMngrUtilSetSrvState should be called once");
   zassert_equal(serviceMngrUtilSetSrvState_fake.arg0_val, 3,
-                "serviceMngrUtilSetSrvState should be called with the index");
+                "serviceMngrUtilSetSrvState should be called with the handle");
   zassert_equal(serviceMngrUtilSetSrvState_fake.arg1_val, SVC_STATE_STOPPED,
                 "serviceMngrUtilSetSrvState should be called with the state");
 }
 
 /**
- * @test The serviceManagerConfirmState function must successfully confirm state change.
+ * @test The serviceManagerConfirmState function must successfully confirm state change without a registry lookup.
  */
 ZTEST(serviceManager, test_confirmState_success)
 {
   int result;
 
-  /* Setup: thread found, set state succeeds */
-  serviceMngrUtilGetIndexFromId_fake.return_val = 3;
+  /* Setup: set state succeeds */
   serviceMngrUtilSetSrvState_fake.return_val = 0;
 
   /* Execute */
-  result = serviceManagerConfirmState((k_tid_t)0x1000, SVC_STATE_SUSPENDED);
+  result = serviceManagerConfirmState(3, SVC_STATE_SUSPENDED);
 
   /* Verify */
   zassert_equal(result, 0, "Expected success (0)");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 1,
-                "serviceMngrUtilGetIndexFromId should be called once");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.arg0_val, (k_tid_t)0x1000,
-                "serviceMngrUtilGetIndexFromId should be called with the thread ID");
+  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 0,
+                "serviceMngrUtilGetIndexFromId should not be called");
   zassert_equal(serviceMngrUtilSetSrvState_fake.call_count, 1,
                 "serviceMngrUtilSetSrvState should be called once");
   zassert_equal(serviceMngrUtilSetSrvState_fake.arg0_val, 3,
-                "serviceMngrUtilSetSrvState should be called with the index");
+                "serviceMngrUtilSetSrvState should be called with the handle");
   zassert_equal(serviceMngrUtilSetSrvState_fake.arg1_val, SVC_STATE_SUSPENDED,
                 "serviceMngrUtilSetSrvState should be called with the state");
 }
 
 /**
- * @test The serviceManagerUpdateHeartbeat function must return error when the thread ID is not found.
+ * @test The serviceManagerConfirmState function must wake up the services start on a running confirmation.
  */
-ZTEST(serviceManager, test_updateHeartbeat_threadNotFound)
+ZTEST(serviceManager, test_confirmState_runningWakesStart)
 {
-  int result;
-
-  serviceMngrUtilGetIndexFromId_fake.return_val = -EINVAL;
-
-  result = serviceManagerUpdateHeartbeat((k_tid_t)0x1000);
+  zassert_equal(serviceManagerConfirmState(3, SVC_STATE_RUNNING), 0, "Expected success (0)");
+  zassert_equal(k_sem_give_mock_fake.call_count, 1,
+                "the running confirmation semaphore should be given");
 
-  zassert_equal(result, -EINVAL,
-                "Expected -EINVAL when thread ID is not found");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 1,
-                "serviceMngrUtilGetIndexFromId should be called once");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.arg0_val, (k_tid_t)0x1000,
-                "serviceMngrUtilGetIndexFromId should be called with the thread ID");
-  zassert_equal(serviceMngrUtilUpdateSrvHeartbeat_fake.call_count, 0,
-                "serviceMngrUtilUpdateSrvHeartbeat should not be called");
+  zassert_equal(serviceManagerConfirmState(3, SVC_STATE_STOPPED), 0, "Expected success (0)");
+  zassert_equal(k_sem_give_mock_fake.call_count, 1,
+                "the running confirmation semaphore should only be given for RUNNING");
 }
 
 /**
@@ -862,45 +1318,37 @@ ZTEST(serviceManager, test_updateHeartbeat_updateFails)
 {
   int result;
 
-  serviceMngrUtilGetIndexFromId_fake.return_val = 2;
   serviceMngrUtilUpdateSrvHeartbeat_fake.return_val = -EINVAL;
 
-  result = serviceManagerUpdateHeartbeat((k_tid_t)0x1000);
+  result = serviceManagerUpdateHeartbeat(2);
 
   zassert_equal(result, -EINVAL,
                 "Expected -EINVAL when heartbeat update fails");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 1,
-                "serviceMngrUtilGetIndexFromId should be called once");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.arg0_val, (k_tid_t)0x1000,
-                "serviceMngrUtilGetIndexFromId should be called with the thread ID");
   zassert_equal(serviceMngrUtilUpdateSrvHeartbeat_fake.call_count, 1,
                 "serviceMngrUtilUpdateSrvHeartbeat should be called once");
   zassert_equal(serviceMngrUtilUpdateSrvHeartbeat_fake.arg0_val, 2,
-                "serviceMngrUtilUpdateSrvHeartbeat should be called with index 2");
+                "serviceMngrUtilUpdateSrvHeartbeat should be called with the handle");
 }
 
 /**
- * @test The serviceManagerUpdateHeartbeat function must successfully update the heartbeat.
+ * @test The serviceManagerUpdateHeartbeat function must successfully update the heartbeat without a registry lookup.
  */
 ZTEST(serviceManager, test_updateHeartbeat_success)
 {
   int result;
 
-  serviceMngrUtilGetIndexFromId_fake.return_val = 2;
   serviceMngrUtilUpdateSrvHeartbeat_fake.return_val = 0;
 
-  result = serviceManagerUpdateHeartbeat((k_tid_t)0x1000);
+  result = serviceManagerUpdateHeartbeat(2);
 
   zassert_equal(result, 0,
                 "Expected success (0)");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 1,
-                "serviceMngrUtilGetIndexFromId should be called once");
-  zassert_equal(serviceMngrUtilGetIndexFromId_fake.arg0_val, (k_tid_t)0x1000,
-                "serviceMngrUtilGetIndexFromId should be called with the thread ID");
+  zassert_equal(serviceMngrUtilGetIndexFromId_fake.call_count, 0,
+                "serviceMngrUtilGetIndexFromId should not be called");
   zassert_equal(serviceMngrUtilUpdateSrvHeartbeat_fake.call_count, 1,
                 "serviceMngrUtilUpdateSrvHeartbeat should be called once");
   zassert_equal(serviceMngrUtilUpdateSrvHeartbeat_fake.arg0_val, 2,
-                "serviceMngrUtilUpdateSrvHeartbeat should be called with index 2");
+                "serviceMngrUtilUpdateSrvHeartbeat should be called with the handle");
 }
 
 ZTEST_SUITE(serviceManager, NULL, service_tests_setup, service_tests_before, NULL, NULL);
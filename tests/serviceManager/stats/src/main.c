@@ -0,0 +1,214 @@
+/**
+ * Copyright (C) 2026 by Electronya
+ *
+ * @file      main.c
+ * @author    jbacon
+ * @date      2026-10-14
+ * @brief     Service Manager Stats Tests
+ *
+ *            Unit tests for the service manager statistics sampling.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <string.h>
+
+DEFINE_FFF_GLOBALS;
+
+/* Prevent serviceManagerUtil.h inclusion - we'll mock the functions */
+#define SERVICE_MANAGER_UTIL_H
+
+/* Wrap functions to use mocks */
+#define k_thread_runtime_stats_get k_thread_runtime_stats_get_mock
+#define k_thread_runtime_stats_all_get k_thread_runtime_stats_all_get_mock
+#define k_thread_stack_space_get k_thread_stack_space_get_mock
+#define k_thread_name_get k_thread_name_get_mock
+
+/* Mock Kconfig options */
+#define CONFIG_ENYA_SERVICE_MANAGER 1
+#define CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL 3
+#define CONFIG_SVC_MGR_STATS 1
+
+#include "serviceManager.h"
+
+/* Setup logging */
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(serviceManager, LOG_LEVEL_DBG);
+
+#undef LOG_MODULE_DECLARE
+#define LOG_MODULE_DECLARE(...)
+
+/* Mock utility functions */
+FAKE_VALUE_FUNC(ServiceDescriptor_t *, serviceMngrUtilGetRegEntryByIndex, size_t);
+
+/* Mock kernel functions */
+FAKE_VALUE_FUNC(int, k_thread_runtime_stats_get_mock, k_tid_t, k_thread_runtime_stats_t *);
+FAKE_VALUE_FUNC(int, k_thread_runtime_stats_all_get_mock, k_thread_runtime_stats_t *);
+FAKE_VALUE_FUNC(int, k_thread_stack_space_get_mock, const struct k_thread *, size_t *);
+FAKE_VALUE_FUNC(const char *, k_thread_name_get_mock, k_tid_t);
+
+#define FFF_FAKES_LIST(FAKE) \
+  FAKE(serviceMngrUtilGetRegEntryByIndex) \
+  FAKE(k_thread_runtime_stats_get_mock) \
+  FAKE(k_thread_runtime_stats_all_get_mock) \
+  FAKE(k_thread_stack_space_get_mock) \
+  FAKE(k_thread_name_get_mock)
+
+#include "serviceManagerStats.c"
+
+#define TEST_SERVICE_COUNT 2
+
+/* Test threads and descriptors */
+static struct k_thread testThreads[TEST_SERVICE_COUNT];
+static ServiceDescriptor_t testDescriptors[TEST_SERVICE_COUNT];
+
+/* The sampled cycles, per thread and for all the threads */
+static uint64_t threadCycles[TEST_SERVICE_COUNT];
+static uint64_t allCycles;
+
+/* The unused stack, per thread */
+static size_t unusedStack[TEST_SERVICE_COUNT];
+
+/* Custom fake: returns the test descriptors */
+static ServiceDescriptor_t *getRegEntry_withServices(size_t index)
+{
+  if(index < TEST_SERVICE_COUNT)
+    return &testDescriptors[index];
+  return NULL;
+}
+
+/* Custom fake: returns the cycles of the test thread */
+static int threadStatsGet(k_tid_t threadId, k_thread_runtime_stats_t *stats)
+{
+  stats->execution_cycles = threadCycles[threadId - testThreads];
+  return 0;
+}
+
+/* Custom fake: returns the cycles of all the threads */
+static int allStatsGet(k_thread_runtime_stats_t *stats)
+{
+  stats->execution_cycles = allCycles;
+  return 0;
+}
+
+/* Custom fake: returns the unused stack of the test thread */
+static int stackSpaceGet(const struct k_thread *thread, size_t *unused)
+{
+  *unused = unusedStack[thread - testThreads];
+  return 0;
+}
+
+/**
+ * @brief Setup function called before each test in the suite.
+ */
+static void stats_tests_before(void *fixture)
+{
+  ARG_UNUSED(fixture);
+
+  FFF_FAKES_LIST(RESET_FAKE);
+  FFF_RESET_HISTORY();
+
+  memset(testThreads, 0, sizeof(testThreads));
+  memset(testDescriptors, 0, sizeof(testDescriptors));
+  memset(threadCycles, 0, sizeof(threadCycles));
+  memset(unusedStack, 0, sizeof(unusedStack));
+  allCycles = 0;
+  lastAllCycles = 0;
+
+  for(size_t i = 0; i < TEST_SERVICE_COUNT; ++i)
+  {
+    testThreads[i].stack_info.size = 1024;
+    testDescriptors[i].threadId = &testThreads[i];
+  }
+
+  serviceMngrUtilGetRegEntryByIndex_fake.custom_fake = getRegEntry_withServices;
+  k_thread_runtime_stats_get_mock_fake.custom_fake = threadStatsGet;
+  k_thread_runtime_stats_all_get_mock_fake.custom_fake = allStatsGet;
+  k_thread_stack_space_get_mock_fake.custom_fake = stackSpaceGet;
+  k_thread_name_get_mock_fake.return_val = "test_service";
+}
+
+/**
+ * @test The CPU load must be the share of the cycles executed since the previous sample.
+ */
+ZTEST(serviceMngrStats, test_sample_cpuLoad)
+{
+  threadCycles[0] = 250;
+  threadCycles[1] = 50;
+  allCycles = 1000;
+
+  zassert_equal(serviceMngrStatsSample(), 0, "Expected success (0)");
+  zassert_equal(testDescriptors[0].stats.cpuLoad, 250, "The first service load should be 25.0%");
+  zassert_equal(testDescriptors[1].stats.cpuLoad, 50, "The second service load should be 5.0%");
+
+  /* Second window: 100 of 2000 cycles, the peak being kept */
+  threadCycles[0] = 350;
+  allCycles = 3000;
+
+  zassert_equal(serviceMngrStatsSample(), 0, "Expected success (0)");
+  zassert_equal(testDescriptors[0].stats.cpuLoad, 50, "The load should cover the last window only");
+  zassert_equal(testDescriptors[0].stats.peakCpuLoad, 250, "The peak load should be kept");
+  zassert_equal(testDescriptors[1].stats.cpuLoad, 0, "An idle service load should be 0");
+}
+
+/**
+ * @test An empty sample window must keep the CPU load.
+ */
+ZTEST(serviceMngrStats, test_sample_emptyWindow)
+{
+  threadCycles[0] = 100;
+  allCycles = 1000;
+  serviceMngrStatsSample();
+
+  zassert_equal(serviceMngrStatsSample(), 0, "Expected success (0)");
+  zassert_equal(testDescriptors[0].stats.cpuLoad, 100, "The load should be kept");
+}
+
+/**
+ * @test The stack usage must be the stack size less its unused part.
+ */
+ZTEST(serviceMngrStats, test_sample_stackUsage)
+{
+  unusedStack[0] = 600;
+  unusedStack[1] = 1024;
+
+  zassert_equal(serviceMngrStatsSample(), 0, "Expected success (0)");
+  zassert_equal(testDescriptors[0].stats.stackSize, 1024, "The stack size should be sampled");
+  zassert_equal(testDescriptors[0].stats.stackUsed, 424, "The used stack should be sampled");
+  zassert_equal(testDescriptors[1].stats.stackUsed, 0, "An untouched stack should be unused");
+}
+
+/**
+ * @test The sampling must return error when the runtime stats are unavailable.
+ */
+ZTEST(serviceMngrStats, test_sample_allStatsFails)
+{
+  k_thread_runtime_stats_all_get_mock_fake.custom_fake = NULL;
+  k_thread_runtime_stats_all_get_mock_fake.return_val = -EINVAL;
+
+  zassert_equal(serviceMngrStatsSample(), -EINVAL, "Expected -EINVAL");
+  zassert_equal(k_thread_runtime_stats_get_mock_fake.call_count, 0,
+                "No service should be sampled");
+}
+
+/**
+ * @test A failed service must not stop the sampling of the others.
+ */
+ZTEST(serviceMngrStats, test_sample_serviceFails)
+{
+  int stackResults[] = {-ENOTSUP, 0};
+
+  unusedStack[1] = 24;
+  k_thread_stack_space_get_mock_fake.custom_fake = NULL;
+  SET_RETURN_SEQ(k_thread_stack_space_get_mock, stackResults, ARRAY_SIZE(stackResults));
+
+  zassert_equal(serviceMngrStatsSample(), -ENOTSUP, "Expected the first error");
+  zassert_equal(k_thread_stack_space_get_mock_fake.call_count, TEST_SERVICE_COUNT,
+                "Every service should be sampled");
+  zassert_equal(testDescriptors[1].stats.stackSize, 1024,
+                "The next service should still be sampled");
+}
+
+ZTEST_SUITE(serviceMngrStats, NULL, NULL, stats_tests_before, NULL, NULL);
@@ -48,6 +48,8 @@ struct wdt_timeout_cfg {
 #define CONFIG_ENYA_SERVICE_MANAGER_LOG_LEVEL 3
 #define CONFIG_SVC_MGR_WDT_TIMEOUT_MS 5000
 #define CONFIG_SVC_MGR_MAX_SERVICES 16
+#define CONFIG_SVC_MGR_STATS 1
+#define CONFIG_SVC_MGR_RECOVERY_WINDOW_MS 60000
 #define SVC_MGR_MAX_MISSED_HEARTBEATS 3
 
 /* FFF fakes list */
@@ -61,7 +63,8 @@ struct wdt_timeout_cfg {
   FAKE(mock_start_callback) \
   FAKE(mock_stop_callback) \
   FAKE(mock_suspend_callback) \
-  FAKE(mock_resume_callback)
+  FAKE(mock_resume_callback) \
+  FAKE(mock_restart_callback)
 
 /* Setup logging */
 #include <zephyr/logging/log.h>
@@ -85,6 +88,7 @@ FAKE_VALUE_FUNC(int, mock_start_callback);
 FAKE_VALUE_FUNC(int, mock_stop_callback);
 FAKE_VALUE_FUNC(int, mock_suspend_callback);
 FAKE_VALUE_FUNC(int, mock_resume_callback);
+FAKE_VALUE_FUNC(int, mock_restart_callback);
 
 /* Storage for captured watchdog timeout config */
 static struct wdt_timeout_cfg captured_wdt_cfg;
@@ -313,7 +317,7 @@ ZTEST(serviceMngrUtil, test_addSrvToRegistry_registryFull)
   registeredServiceCount = 0;
   for (size_t i = 0; i < CONFIG_SVC_MGR_MAX_SERVICES; i++) {
     result = serviceMngrUtilAddSrvToRegistry(&descriptor);
-    zassert_equal(result, 0, "Should succeed adding service %zu", i);
+    zassert_equal(result, (int)i, "Should succeed adding service %zu at index %zu", i, i);
   }
 
   /* Try to add one more (should fail) */
@@ -412,8 +416,8 @@ ZTEST(serviceMngrUtil, test_addSrvToRegistry_success)
   /* Execute */
   result = serviceMngrUtilAddSrvToRegistry(&descriptor);
 
-  /* Verify result */
-  zassert_equal(result, 0, "Expected success (0)");
+  /* Verify result is the registry index */
+  zassert_equal(result, 0, "Expected the registry index (0)");
 
   /* Verify descriptor was copied correctly */
   zassert_equal(serviceRegistry[0].threadId, (k_tid_t)0x1000,
@@ -516,6 +520,23 @@ ZTEST(serviceMngrUtil, test_getIndexFromId_success)
   zassert_equal(result, 7, "Expected index 7 for thread ID 0x7000");
 }
 
+/**
+ * @test The serviceMngrUtilGetIndexFromId function must return error when the thread ID is shared
+ *       by several services.
+ */
+ZTEST(serviceMngrUtil, test_getIndexFromId_sharedThreadId)
+{
+  int result;
+
+  /* Register index 5 on the thread of index 7, like the executor services */
+  serviceRegistry[5].threadId = (k_tid_t)0x7000;
+
+  result = serviceMngrUtilGetIndexFromId((k_tid_t)0x7000);
+
+  /* Verify */
+  zassert_equal(result, -EINVAL, "Expected -EINVAL for a shared thread ID");
+}
+
 /**
  * @test The serviceMngrUtilStartService function must return error when index is out of bounds.
  */
@@ -574,6 +595,8 @@ ZTEST(serviceMngrUtil, test_startService_success)
 
   /* Setup mock to succeed */
   mock_start_callback_fake.return_val = 0;
+  serviceRegistry[5].missedHeartbeats = 2;
+  k_uptime_get_mock_fake.return_val = 6000;
 
   /* Execute */
   result = serviceMngrUtilStartService(5);
@@ -582,8 +605,12 @@ ZTEST(serviceMngrUtil, test_startService_success)
   zassert_equal(result, 0, "Expected success (0)");
   zassert_equal(mock_start_callback_fake.call_count, 1, "Start callback should be called once");
 
-  /* Verify service state was updated */
+  /* Verify service state was updated and a fresh heartbeat interval opened */
   zassert_equal(serviceRegistry[5].state, SVC_STATE_RUNNING, "Service state should be RUNNING");
+  zassert_equal(serviceRegistry[5].lastHeartbeatMs, 6000,
+                "lastHeartbeatMs should be reset to current uptime on start");
+  zassert_equal(serviceRegistry[5].missedHeartbeats, 0,
+                "missedHeartbeats should be reset on start");
 }
 
 /**
@@ -822,8 +849,8 @@ ZTEST(serviceMngrUtil, test_setSrvState_running)
   zassert_equal(serviceRegistry[5].state, SVC_STATE_RUNNING, "Service state should be RUNNING");
   zassert_equal(serviceRegistry[5].missedHeartbeats, 2,
                 "Missed heartbeats should not be reset when transitioning to RUNNING");
-  zassert_equal(k_uptime_get_mock_fake.call_count, 0,
-                "k_uptime_get should not be called when transitioning to RUNNING");
+  zassert_equal(atomic_get(&serviceRegistry[5].lastHeartbeatMs), 1000,
+                "Last heartbeat should not be reset when transitioning to RUNNING");
 }
 
 /**
@@ -883,13 +910,14 @@ ZTEST(serviceMngrUtil, test_updateSrvHeartbeat_indexOutOfBounds)
 }
 
 /**
- * @test The serviceMngrUtilUpdateSrvHeartbeat function must successfully update heartbeat timestamp and reset missed count.
+ * @test The serviceMngrUtilUpdateSrvHeartbeat function must successfully update heartbeat timestamp, the missed count clearing at the next check.
  */
 ZTEST(serviceMngrUtil, test_updateSrvHeartbeat_success)
 {
   int result;
 
   /* Set pre-existing missed heartbeats */
+  serviceRegistry[5].state = SVC_STATE_RUNNING;
   serviceRegistry[5].missedHeartbeats = 3;
   k_uptime_get_mock_fake.return_val = 5000;
 
@@ -899,11 +927,13 @@ ZTEST(serviceMngrUtil, test_updateSrvHeartbeat_success)
   /* Verify result */
   zassert_equal(result, 0, "Expected success (0)");
 
-  /* Verify heartbeat fields were updated */
+  /* Verify heartbeat timestamp was updated */
   zassert_equal(serviceRegistry[5].lastHeartbeatMs, 5000,
                 "Last heartbeat should be updated to current uptime");
-  zassert_equal(serviceRegistry[5].missedHeartbeats, 0,
-                "Missed heartbeats should be reset to 0");
+
+  /* Verify the next check clears the missed count */
+  zassert_equal(serviceMngrUtilCheckSrvHeartbeat(5), 0,
+                "Missed heartbeats should be cleared at the next check");
 }
 
 /**
@@ -1040,11 +1070,11 @@ ZTEST(serviceMngrUtil, test_checkSrvHeartbeat_timeout)
 {
   int result;
 
-  /* Pre-set missed heartbeats at max (3), one more will trigger timeout */
+  /* Pre-set missed heartbeats at max (3), elapsed=8000 -> 4 intervals will trigger timeout */
   serviceRegistry[5].state = SVC_STATE_RUNNING;
   serviceRegistry[5].missedHeartbeats = SVC_MGR_MAX_MISSED_HEARTBEATS;
   serviceRegistry[5].lastHeartbeatMs = 2000;
-  k_uptime_get_mock_fake.return_val = 5000;
+  k_uptime_get_mock_fake.return_val = 10000;
   k_thread_name_get_mock_fake.return_val = "test_service";
 
   /* Execute */
@@ -1054,4 +1084,309 @@ ZTEST(serviceMngrUtil, test_checkSrvHeartbeat_timeout)
   zassert_equal(result, -ETIMEDOUT, "Expected -ETIMEDOUT when missed heartbeats exceed maximum");
 }
 
+/**
+ * @test The serviceMngrUtilCheckSrvHeartbeat function must count one missed heartbeat per elapsed interval.
+ */
+ZTEST(serviceMngrUtil, test_checkSrvHeartbeat_oneMissPerInterval)
+{
+  int result;
+
+  /* lastHeartbeatMs=2000, interval=2000, now=5000 -> 1 interval elapsed */
+  serviceRegistry[5].state = SVC_STATE_RUNNING;
+  serviceRegistry[5].lastHeartbeatMs = 2000;
+  k_uptime_get_mock_fake.return_val = 5000;
+  k_thread_name_get_mock_fake.return_val = "test_service";
+
+  serviceMngrUtilCheckSrvHeartbeat(5);
+  result = serviceMngrUtilCheckSrvHeartbeat(5);
+
+  /* Verify repeated checks within the interval do not add misses */
+  zassert_equal(result, 1, "Expected missed count 1 on repeated checks within the interval");
+
+  /* now=8000 -> 3 intervals elapsed */
+  k_uptime_get_mock_fake.return_val = 8000;
+  result = serviceMngrUtilCheckSrvHeartbeat(5);
+
+  zassert_equal(result, 3, "Expected missed count 3 after 3 elapsed intervals");
+}
+
+/**
+ * @test The serviceMngrUtilGetNextHeartbeatDeadline function must return INT64_MAX when no service is running.
+ */
+ZTEST(serviceMngrUtil, test_getNextHeartbeatDeadline_noneRunning)
+{
+  zassert_equal(serviceMngrUtilGetNextHeartbeatDeadline(), INT64_MAX,
+                "Expected INT64_MAX when no service is running");
+}
+
+/**
+ * @test The serviceMngrUtilGetNextHeartbeatDeadline function must return the earliest running service deadline.
+ */
+ZTEST(serviceMngrUtil, test_getNextHeartbeatDeadline_earliest)
+{
+  /* now=5000 */
+  k_uptime_get_mock_fake.return_val = 5000;
+
+  /* Service 0: elapsed=800, interval=500 -> 5000 + 500 - 300 = 5200 */
+  serviceRegistry[0].state = SVC_STATE_RUNNING;
+  serviceRegistry[0].lastHeartbeatMs = 4200;
+
+  /* Service 5: elapsed=5000, interval=2000 -> 5000 + 2000 - 1000 = 6000 */
+  serviceRegistry[5].state = SVC_STATE_RUNNING;
+  serviceRegistry[5].lastHeartbeatMs = 0;
+
+  /* Service 7 is suspended and not monitored */
+  serviceRegistry[7].state = SVC_STATE_SUSPENDED;
+  serviceRegistry[7].lastHeartbeatMs = 0;
+
+  zassert_equal(serviceMngrUtilGetNextHeartbeatDeadline(), 5200,
+                "Expected the earliest running service deadline");
+}
+
+/**
+ * @test The serviceMngrUtilCheckSrvHeartbeat function must handle the 32-bit heartbeat timestamp wrapping.
+ */
+ZTEST(serviceMngrUtil, test_checkSrvHeartbeat_timestampWrap)
+{
+  int result;
+
+  /* lastHeartbeatMs=0xFFFFF000 (wrapped), now=2^32 + 1000 -> elapsed=5096 */
+  serviceRegistry[5].state = SVC_STATE_RUNNING;
+  serviceRegistry[5].lastHeartbeatMs = (atomic_t)0xFFFFF000;
+  k_uptime_get_mock_fake.return_val = 0x100000000LL + 1000;
+  k_thread_name_get_mock_fake.return_val = "test_service";
+
+  result = serviceMngrUtilCheckSrvHeartbeat(5);
+
+  zassert_equal(result, 2, "Expected missed count 2 across the timestamp wrap");
+}
+
+/**
+ * @test The serviceMngrUtilAddSrvToRegistry function must return error when depending on an unregistered service.
+ */
+ZTEST(serviceMngrUtil, test_addSrvToRegistry_unregisteredDependency)
+{
+  int result;
+  ServiceDescriptor_t descriptor = {0};
+
+  descriptor.threadId = (k_tid_t)0x9000;
+  descriptor.priority = SVC_PRIORITY_CORE;
+  descriptor.heartbeatIntervalMs = 1000;
+
+  /* Setup has count = 8, handle 8 is not registered */
+  registeredServiceCount = 8;
+  descriptor.dependencies = BIT64(8);
+
+  result = serviceMngrUtilAddSrvToRegistry(&descriptor);
+
+  zassert_equal(result, -EINVAL, "Expected -EINVAL for a dependency on an unregistered service");
+
+  /* A dependency on a registered service is accepted */
+  descriptor.dependencies = BIT64(7);
+
+  result = serviceMngrUtilAddSrvToRegistry(&descriptor);
+
+  zassert_equal(result, 8, "Expected the registry index (8)");
+}
+
+/**
+ * @test The serviceMngrUtilAreSrvsRunning function must require the running state confirmation.
+ */
+ZTEST(serviceMngrUtil, test_areSrvsRunning)
+{
+  zassert_true(serviceMngrUtilAreSrvsRunning(0), "No dependency should be running");
+
+  serviceRegistry[0].state = SVC_STATE_RUNNING;
+  serviceRegistry[5].state = SVC_STATE_RUNNING;
+  serviceRegistry[0].isRunningConfirmed = true;
+
+  zassert_true(serviceMngrUtilAreSrvsRunning(BIT64(0)), "A confirmed service should be running");
+  zassert_false(serviceMngrUtilAreSrvsRunning(BIT64(0) | BIT64(5)),
+                "An unconfirmed service should not be running");
+
+  serviceRegistry[5].isRunningConfirmed = true;
+  serviceRegistry[5].state = SVC_STATE_SUSPENDED;
+
+  zassert_false(serviceMngrUtilAreSrvsRunning(BIT64(5)), "A suspended service should not be running");
+  zassert_false(serviceMngrUtilAreSrvsRunning(BIT64(9)), "An unregistered service should not be running");
+}
+
+/**
+ * @test The start latency must run from the start callback up to the running confirmation.
+ */
+ZTEST(serviceMngrUtil, test_startLatency)
+{
+  int64_t uptimes[] = {1000, 1005, 1250, 9000};
+
+  mock_start_callback_fake.return_val = 0;
+  SET_RETURN_SEQ(k_uptime_get_mock, uptimes, ARRAY_SIZE(uptimes));
+
+  zassert_equal(serviceMngrUtilStartService(5), 0, "Expected success (0)");
+  zassert_equal(serviceRegistry[5].startLatencyMs, 5,
+                "The latency should be the start callback duration until confirmed");
+  zassert_false(serviceRegistry[5].isRunningConfirmed, "The running state should not be confirmed yet");
+
+  zassert_equal(serviceMngrUtilSetSrvState(5, SVC_STATE_RUNNING), 0, "Expected success (0)");
+
+  zassert_true(serviceRegistry[5].isRunningConfirmed, "The running state should be confirmed");
+  zassert_equal(serviceRegistry[5].startLatencyMs, 250,
+                "The latency should run up to the running confirmation");
+
+  /* A later confirmation keeps the start latency */
+  serviceMngrUtilSetSrvState(5, SVC_STATE_RUNNING);
+
+  zassert_equal(serviceRegistry[5].startLatencyMs, 250, "The start latency should be kept");
+}
+
+/**
+ * @test The heartbeat jitter must be the worst heartbeat delay past its interval.
+ */
+ZTEST(serviceMngrUtil, test_heartbeatJitter)
+{
+  /* Interval of 2000 ms, heartbeats at 2030 then 3930 and 6100 ms */
+  int64_t uptimes[] = {2030, 3930, 6100};
+
+  serviceRegistry[5].state = SVC_STATE_RUNNING;
+  SET_RETURN_SEQ(k_uptime_get_mock, uptimes, ARRAY_SIZE(uptimes));
+
+  serviceMngrUtilUpdateSrvHeartbeat(5);
+  zassert_equal(serviceRegistry[5].stats.maxHeartbeatJitterMs, 30, "The jitter should be 30 ms");
+
+  serviceMngrUtilUpdateSrvHeartbeat(5);
+  zassert_equal(serviceRegistry[5].stats.maxHeartbeatJitterMs, 30,
+                "An early heartbeat should keep the worst jitter");
+
+  serviceMngrUtilUpdateSrvHeartbeat(5);
+  zassert_equal(serviceRegistry[5].stats.maxHeartbeatJitterMs, 170, "The worst jitter should be 170 ms");
+
+  /* A heartbeat outside of the running state is not accounted */
+  serviceRegistry[5].state = SVC_STATE_STOPPED;
+  k_uptime_get_mock_fake.return_val = 60000;
+  SET_RETURN_SEQ(k_uptime_get_mock, NULL, 0);
+
+  serviceMngrUtilUpdateSrvHeartbeat(5);
+  zassert_equal(serviceRegistry[5].stats.maxHeartbeatJitterMs, 170,
+                "A heartbeat of a stopped service should not be accounted");
+}
+
+/**
+ * @test The time spent suspended must be accounted up to the suspension end.
+ */
+ZTEST(serviceMngrUtil, test_suspendedTime)
+{
+  mock_resume_callback_fake.return_val = 0;
+  serviceRegistry[5].state = SVC_STATE_RUNNING;
+
+  /* Suspended from 1000 to 1500 ms, resumed by the manager */
+  k_uptime_get_mock_fake.return_val = 1000;
+  serviceMngrUtilSetSrvState(5, SVC_STATE_SUSPENDED);
+  k_uptime_get_mock_fake.return_val = 1500;
+  serviceMngrUtilSetSrvState(5, SVC_STATE_SUSPENDED);
+
+  zassert_equal(serviceRegistry[5].stats.suspendedSinceMs, 1000,
+                "A repeated suspension should keep its start");
+
+  zassert_equal(serviceMngrUtilResumeService(5), 0, "Expected success (0)");
+  zassert_equal(serviceRegistry[5].stats.suspendedMs, 500, "The suspension should be accounted");
+
+  /* Suspended from 4000 to 4250 ms, stopped by the service */
+  k_uptime_get_mock_fake.return_val = 4000;
+  serviceMngrUtilSetSrvState(5, SVC_STATE_SUSPENDED);
+  k_uptime_get_mock_fake.return_val = 4250;
+  serviceMngrUtilSetSrvState(5, SVC_STATE_STOPPED);
+
+  zassert_equal(serviceRegistry[5].stats.suspendedMs, 750, "The suspensions should be summed");
+}
+
+/**
+ * @test The serviceMngrUtilAddSrvToRegistry function must return error for an invalid restart policy.
+ */
+ZTEST(serviceMngrUtil, test_addSrvToRegistry_invalidRestartPolicy)
+{
+  ServiceDescriptor_t descriptor = {0};
+
+  descriptor.threadId = (k_tid_t)0x9000;
+  descriptor.heartbeatIntervalMs = 1000;
+  descriptor.maxRestarts = 2;
+  registeredServiceCount = 0;
+
+  /* No restart callback */
+  descriptor.priority = SVC_PRIORITY_CORE;
+  zassert_equal(serviceMngrUtilAddSrvToRegistry(&descriptor), -EINVAL,
+                "Expected -EINVAL for restarts without a restart callback");
+
+  /* Critical service */
+  descriptor.restart = mock_restart_callback;
+  descriptor.priority = SVC_PRIORITY_CRITICAL;
+  zassert_equal(serviceMngrUtilAddSrvToRegistry(&descriptor), -EINVAL,
+                "Expected -EINVAL for restarts of a critical service");
+
+  descriptor.priority = SVC_PRIORITY_CORE;
+  zassert_equal(serviceMngrUtilAddSrvToRegistry(&descriptor), 0, "Expected the registry index (0)");
+}
+
+/**
+ * @test The serviceMngrUtilRecoverService function must escalate for an invalid index or the SoC reset policy.
+ */
+ZTEST(serviceMngrUtil, test_recoverService_notRestartable)
+{
+  zassert_equal(serviceMngrUtilRecoverService(8), -EINVAL, "Expected -EINVAL for index out of bounds");
+  zassert_equal(serviceMngrUtilRecoverService(5), -ENOTSUP, "Expected -ENOTSUP for the SoC reset policy");
+}
+
+/**
+ * @test The serviceMngrUtilRecoverService function must restart the service with a fresh heartbeat interval.
+ */
+ZTEST(serviceMngrUtil, test_recoverService_success)
+{
+  serviceRegistry[5].maxRestarts = 2;
+  serviceRegistry[5].restart = mock_restart_callback;
+  serviceRegistry[5].state = SVC_STATE_RUNNING;
+  serviceRegistry[5].missedHeartbeats = 4;
+  k_uptime_get_mock_fake.return_val = 10000;
+
+  zassert_equal(serviceMngrUtilRecoverService(5), 0, "Expected success (0)");
+  zassert_equal(mock_restart_callback_fake.call_count, 1, "The restart callback should be called");
+  zassert_equal(serviceRegistry[5].restartCount, 1, "The restart should be counted");
+  zassert_equal(serviceRegistry[5].missedHeartbeats, 0, "Missed heartbeats should be reset");
+  zassert_equal(serviceMngrUtilCheckSrvHeartbeat(5), 0, "The heartbeat interval should start over");
+}
+
+/**
+ * @test The serviceMngrUtilRecoverService function must escalate once the restarts within the window are exhausted.
+ */
+ZTEST(serviceMngrUtil, test_recoverService_exhausted)
+{
+  serviceRegistry[5].maxRestarts = 2;
+  serviceRegistry[5].restart = mock_restart_callback;
+
+  k_uptime_get_mock_fake.return_val = 10000;
+  zassert_equal(serviceMngrUtilRecoverService(5), 0, "The first restart should succeed");
+  k_uptime_get_mock_fake.return_val = 30000;
+  zassert_equal(serviceMngrUtilRecoverService(5), 0, "The second restart should succeed");
+  k_uptime_get_mock_fake.return_val = 69999;
+  zassert_equal(serviceMngrUtilRecoverService(5), -EBUSY, "The restarts should be exhausted");
+  zassert_equal(mock_restart_callback_fake.call_count, 2, "The restart callback should not be called");
+
+  /* A new window starts once the window of the first restart elapsed */
+  k_uptime_get_mock_fake.return_val = 70000;
+  zassert_equal(serviceMngrUtilRecoverService(5), 0, "A restart should succeed in a new window");
+  zassert_equal(serviceRegistry[5].restartCount, 1, "The new window should count one restart");
+  zassert_equal(serviceRegistry[5].firstRestartMs, 70000, "The new window should start now");
+}
+
+/**
+ * @test The serviceMngrUtilRecoverService function must return error when the restart callback fails.
+ */
+ZTEST(serviceMngrUtil, test_recoverService_restartFails)
+{
+  serviceRegistry[5].maxRestarts = 1;
+  serviceRegistry[5].restart = mock_restart_callback;
+  serviceRegistry[5].state = SVC_STATE_SUSPENDED;
+  mock_restart_callback_fake.return_val = -EIO;
+
+  zassert_equal(serviceMngrUtilRecoverService(5), -EIO, "Expected the restart error");
+  zassert_equal(serviceRegistry[5].state, SVC_STATE_SUSPENDED, "The state should be kept");
+}
+
 ZTEST_SUITE(serviceMngrUtil, NULL, util_tests_setup, util_tests_before, NULL, NULL);